@@ -81,6 +81,9 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.system_ecef_pos_sd_m = configuration->property(role + ".kf_system_ecef_pos_sd_m", 2.0);
     pvt_output_parameters.system_ecef_vel_sd_ms = configuration->property(role + ".kf_system_ecef_vel_sd_ms", 0.5);
 
+    // Vector Tracking Loop (VTL) settings: send Doppler predictions to the tracking channels
+    pvt_output_parameters.enable_vtl = configuration->property(role + ".enable_vtl", pvt_output_parameters.enable_vtl);
+
     // NMEA Printer settings
     pvt_output_parameters.flag_nmea_tty_port = configuration->property(role + ".flag_nmea_tty_port", false);
     pvt_output_parameters.nmea_dump_filename = configuration->property(role + ".nmea_dump_filename", default_nmea_dump_filename);
@@ -102,6 +105,9 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
         {
             pvt_output_parameters.rinex_name = FLAGS_RINEX_name;
         }
+    pvt_output_parameters.rinex_rotation = configuration->property(role + ".rinex_rotation", std::string("none"));
+    pvt_output_parameters.rinex_compact = configuration->property(role + ".rinex_compact", false);
+    pvt_output_parameters.rinex_compression = configuration->property(role + ".rinex_compression", std::string("none"));
 
     // RTCM Printer settings
     pvt_output_parameters.flag_rtcm_tty_port = configuration->property(role + ".flag_rtcm_tty_port", false);
@@ -898,6 +904,11 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     // Use unhealthy satellites
     pvt_output_parameters.use_unhealthy_sats = configuration->property(role + ".use_unhealthy_sats", pvt_output_parameters.use_unhealthy_sats);
 
+    // Output products (RINEX, RTCM, NMEA, KML, GPX, GeoJSON, AN) written from a dedicated thread
+    pvt_output_parameters.async_output = configuration->property(role + ".async_output", pvt_output_parameters.async_output);
+    pvt_output_parameters.output_queue_size = configuration->property(role + ".output_queue_size", pvt_output_parameters.output_queue_size);
+    pvt_output_parameters.output_overflow_policy = configuration->property(role + ".output_overflow_policy", pvt_output_parameters.output_overflow_policy);
+
     // make PVT object
     pvt_ = rtklib_make_pvt_gs(in_streams_, pvt_output_parameters, rtk);
     DLOG(INFO) << "pvt(" << pvt_->unique_id() << ")";
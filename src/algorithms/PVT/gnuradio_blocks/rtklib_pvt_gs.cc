@@ -15,6 +15,16 @@
  */
 
 #include "rtklib_pvt_gs.h"
+#include "Beidou_B1I.h"
+#include "Beidou_B3I.h"
+#include "GLONASS_L1_L2_CA.h"
+#include "GPS_L1_CA.h"
+#include "GPS_L2C.h"
+#include "GPS_L5.h"
+#include "Galileo_E1.h"
+#include "Galileo_E5a.h"
+#include "Galileo_E5b.h"
+#include "Galileo_E6.h"
 #include "MATH_CONSTANTS.h"
 #include "an_packet_printer.h"
 #include "beidou_dnav_almanac.h"
@@ -53,6 +63,7 @@
 #include "monitor_pvt_udp_sink.h"
 #include "nmea_printer.h"
 #include "pvt_conf.h"
+#include "pvt_output_pipeline.h"
 #include "rinex_printer.h"
 #include "rtcm_printer.h"
 #include "rtklib_rtkcmn.h"
@@ -68,6 +79,7 @@
 #include <gnuradio/io_signature.h>      // for io_signature
 #include <pmt/pmt_sugar.h>              // for mp
 #include <algorithm>                    // for sort, unique
+#include <array>                        // for array
 #include <cerrno>                       // for errno
 #include <cstring>                      // for strerror
 #include <exception>                    // for exception
@@ -179,12 +191,24 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
       d_an_printer_enabled(conf_.an_output_enabled),
       d_log_timetag(conf_.log_source_timetag),
       d_use_has_corrections(conf_.use_has_corrections),
-      d_use_unhealthy_sats(conf_.use_unhealthy_sats)
+      d_use_unhealthy_sats(conf_.use_unhealthy_sats),
+      d_enable_vtl(conf_.enable_vtl)
 {
     // Send feedback message to observables block with the receiver clock offset
     this->message_port_register_out(pmt::mp("pvt_to_observables"));
-    // Experimental: VLT commands from PVT to tracking channels
+    // Vector Tracking Loop (VTL) commands from PVT to tracking channels
     this->message_port_register_out(pmt::mp("pvt_to_trk"));
+    d_vtl_code_chip_rate_cps["1C"] = GPS_L1_CA_CODE_RATE_CPS;
+    d_vtl_code_chip_rate_cps["2S"] = GPS_L2_M_CODE_RATE_CPS;
+    d_vtl_code_chip_rate_cps["L5"] = GPS_L5I_CODE_RATE_CPS;
+    d_vtl_code_chip_rate_cps["1B"] = GALILEO_E1_CODE_CHIP_RATE_CPS;
+    d_vtl_code_chip_rate_cps["5X"] = GALILEO_E5A_CODE_CHIP_RATE_CPS;
+    d_vtl_code_chip_rate_cps["7X"] = GALILEO_E5B_CODE_CHIP_RATE_CPS;
+    d_vtl_code_chip_rate_cps["E6"] = GALILEO_E6_B_CODE_CHIP_RATE_CPS;
+    d_vtl_code_chip_rate_cps["1G"] = GLONASS_L1_CA_CODE_RATE_CPS;
+    d_vtl_code_chip_rate_cps["2G"] = GLONASS_L2_CA_CODE_RATE_CPS;
+    d_vtl_code_chip_rate_cps["B1"] = BEIDOU_B1I_CODE_RATE_CPS;
+    d_vtl_code_chip_rate_cps["B3"] = BEIDOU_B3I_CODE_RATE_CPS;
     // Send PVT status to gnss_flowgraph
     this->message_port_register_out(pmt::mp("status"));
 
@@ -389,7 +413,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     // initialize RINEX printer
     if (d_rinex_output_enabled)
         {
-            d_rp = std::make_unique<Rinex_Printer>(d_rinex_version, conf_.rinex_output_path, conf_.rinex_name);
+            d_rp = std::make_unique<Rinex_Printer>(d_rinex_version, conf_.rinex_output_path, conf_.rinex_name, conf_.rinex_rotation, conf_.rinex_compact, conf_.rinex_compression);
             d_rp->set_pre_2009_file(conf_.pre_2009_file);
         }
     else
@@ -554,6 +578,15 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     // set the RTKLIB trace (debug) level
     tracelevel(conf_.rtk_trace_level);
 
+    // Output products, written by a dedicated thread from copies of the user
+    // PVT solver, so that slow files or serial ports do not stall this block
+    d_output_pipeline = std::make_unique<Pvt_Output_Pipeline>(std::make_unique<Rtklib_Solver>(rtk, conf_, "", d_type_of_rx, false, false),
+        conf_.async_output,
+        conf_.output_queue_size,
+        pvt_overflow_policy_from_string(conf_.output_overflow_policy));
+    set_output_sinks();
+    d_output_nav_changed = true;
+
     // timetag
     if (d_log_timetag)
         {
@@ -569,6 +602,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
                 }
         }
 
+    d_counters = Block_Instrumentation::instance().register_block(this->name());
     d_start = std::chrono::system_clock::now();
 }
 
@@ -576,6 +610,15 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
 rtklib_pvt_gs::~rtklib_pvt_gs()
 {
     DLOG(INFO) << "PVT block destructor called.";
+    try
+        {
+            d_output_pipeline->stop();
+            d_output_pipeline->log_stats();
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Error stopping the PVT output thread: " << e.what();
+        }
     if (d_sysv_msqid != -1)
         {
             msgctl(d_sysv_msqid, IPC_RMID, nullptr);
@@ -1143,6 +1186,7 @@ rtklib_pvt_gs::~rtklib_pvt_gs()
 
 void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
 {
+    d_output_nav_changed = true;  // the next output epoch takes a new copy of the navigation data
     try
         {
             const size_t msg_type_hash_code = pmt::any_ref(msg).type().hash_code();
@@ -1164,7 +1208,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                             d_eph_udp_sink_ptr->write_gps_ephemeris(gps_eph);
                         }
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled)
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->gps_ephemeris_map.find(gps_eph->PRN) == d_internal_pvt_solver->gps_ephemeris_map.cend())
@@ -1183,7 +1227,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Gps_Ephemeris> new_eph;
                                     new_eph[gps_eph->PRN] = *gps_eph;
-                                    d_rp->log_rinex_nav_gps_nav(d_type_of_rx, new_eph);
+                                    submit_output_task([this, new_map = std::move(new_eph)]() {
+                                        if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                            {
+                                                d_rp->log_rinex_nav_gps_nav(d_type_of_rx, new_map);
+                                            }
+                                    });
                                 }
                         }
                     d_internal_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
@@ -1232,7 +1281,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                     // ### GPS CNAV message ###
                     const auto gps_cnav_ephemeris = wht::any_cast<std::shared_ptr<Gps_CNAV_Ephemeris>>(pmt::any_ref(msg));
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled)
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->gps_cnav_ephemeris_map.find(gps_cnav_ephemeris->PRN) == d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
@@ -1251,7 +1300,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Gps_CNAV_Ephemeris> new_cnav_eph;
                                     new_cnav_eph[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
-                                    d_rp->log_rinex_nav_gps_cnav(d_type_of_rx, new_cnav_eph);
+                                    submit_output_task([this, new_map = std::move(new_cnav_eph)]() {
+                                        if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                            {
+                                                d_rp->log_rinex_nav_gps_cnav(d_type_of_rx, new_map);
+                                            }
+                                    });
                                 }
                         }
                     d_internal_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
@@ -1324,7 +1378,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                             d_eph_udp_sink_ptr->write_galileo_ephemeris(galileo_eph);
                         }
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled)
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->galileo_ephemeris_map.find(galileo_eph->PRN) == d_internal_pvt_solver->galileo_ephemeris_map.cend())
@@ -1343,7 +1397,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Galileo_Ephemeris> new_gal_eph;
                                     new_gal_eph[galileo_eph->PRN] = *galileo_eph;
-                                    d_rp->log_rinex_nav_gal_nav(d_type_of_rx, new_gal_eph);
+                                    submit_output_task([this, new_map = std::move(new_gal_eph)]() {
+                                        if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                            {
+                                                d_rp->log_rinex_nav_gal_nav(d_type_of_rx, new_map);
+                                            }
+                                    });
                                 }
                         }
                     d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
@@ -1447,7 +1506,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                << " and Ephemeris IOD in UTC = " << glonass_gnav_eph->compute_GLONASS_time(glonass_gnav_eph->d_t_b)
                                << " from SV = " << glonass_gnav_eph->i_satellite_slot_number;
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled)
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(glonass_gnav_eph->PRN) == d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
@@ -1466,7 +1525,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Glonass_Gnav_Ephemeris> new_glo_eph;
                                     new_glo_eph[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
-                                    d_rp->log_rinex_nav_glo_gnav(d_type_of_rx, new_glo_eph);
+                                    submit_output_task([this, new_map = std::move(new_glo_eph)]() {
+                                        if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                            {
+                                                d_rp->log_rinex_nav_glo_gnav(d_type_of_rx, new_map);
+                                            }
+                                    });
                                 }
                         }
                     d_internal_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
@@ -1510,7 +1574,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                << "inserted with Toe=" << bds_dnav_eph->toe << " and BDS Week="
                                << bds_dnav_eph->WN;
                     // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                    if (d_rinex_output_enabled)
                         {
                             bool new_annotation = false;
                             if (d_internal_pvt_solver->beidou_dnav_ephemeris_map.find(bds_dnav_eph->PRN) == d_internal_pvt_solver->beidou_dnav_ephemeris_map.cend())
@@ -1529,7 +1593,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     // New record!
                                     std::map<int32_t, Beidou_Dnav_Ephemeris> new_bds_eph;
                                     new_bds_eph[bds_dnav_eph->PRN] = *bds_dnav_eph;
-                                    d_rp->log_rinex_nav_bds_dnav(d_type_of_rx, new_bds_eph);
+                                    submit_output_task([this, new_map = std::move(new_bds_eph)]() {
+                                        if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                            {
+                                                d_rp->log_rinex_nav_bds_dnav(d_type_of_rx, new_map);
+                                            }
+                                    });
                                 }
                         }
                     d_internal_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
@@ -1618,7 +1687,7 @@ void rtklib_pvt_gs::msg_handler_has_data(const pmt::pmt_t& msg)
                         }
                     if (d_rtcm_printer && has_data->tow <= 604800)
                         {
-                            d_rtcm_printer->Print_IGM_Messages(*has_data.get());
+                            submit_output_task([this, has_data]() { d_rtcm_printer->Print_IGM_Messages(*has_data); });
                         }
                 }
         }
@@ -1682,6 +1751,7 @@ void rtklib_pvt_gs::clear_ephemeris()
             d_user_pvt_solver->beidou_dnav_ephemeris_map.clear();
             d_user_pvt_solver->beidou_dnav_almanac_map.clear();
         }
+    d_output_nav_changed = true;
 }
 
 
@@ -1929,9 +1999,173 @@ void rtklib_pvt_gs::update_HAS_corrections()
 }
 
 
+void rtklib_pvt_gs::send_vtl_tracking_cmds()
+{
+    // Predict the carrier Doppler, Doppler rate and code frequency of each tracked
+    // signal from the current PVT solution, and send them to the tracking channels.
+    // Each command carries the sample counter of the observable it refers to, so
+    // the tracking blocks can propagate it to their own time.
+    for (const auto& obs : d_gnss_observables_map)
+        {
+            if (!obs.second.Flag_valid_pseudorange)
+                {
+                    continue;
+                }
+            const std::string sig_(obs.second.Signal, 2);
+            const auto code_rate_it = d_vtl_code_chip_rate_cps.find(sig_);
+            if (code_rate_it == d_vtl_code_chip_rate_cps.cend())
+                {
+                    continue;
+                }
+            double carrier_doppler_hz = 0.0;
+            double carrier_doppler_rate_hz_s = 0.0;
+            double carrier_freq_hz = 0.0;
+            if (d_user_pvt_solver->get_vtl_prediction(obs.second, carrier_doppler_hz, carrier_doppler_rate_hz_s, carrier_freq_hz))
+                {
+                    const std::shared_ptr<TrackingCmd> trk_cmd = std::make_shared<TrackingCmd>();
+                    trk_cmd->enable_carrier_nco_cmd = true;
+                    trk_cmd->enable_code_nco_cmd = true;
+                    trk_cmd->carrier_freq_hz = carrier_doppler_hz;
+                    trk_cmd->carrier_freq_rate_hz_s = carrier_doppler_rate_hz_s;
+                    trk_cmd->code_freq_chips = code_rate_it->second * (1.0 + carrier_doppler_hz / carrier_freq_hz);
+                    trk_cmd->sample_counter = obs.second.Tracking_sample_counter;
+                    trk_cmd->channel_id = obs.second.Channel_ID;
+                    trk_cmd->PRN = obs.second.PRN;
+                    this->message_port_pub(pmt::mp("pvt_to_trk"), pmt::make_any(trk_cmd));
+                    DLOG(INFO) << "VTL command sent to channel " << obs.second.Channel_ID
+                               << ": Doppler " << carrier_doppler_hz << " [Hz], Doppler rate "
+                               << carrier_doppler_rate_hz_s << " [Hz/s], measured Doppler "
+                               << obs.second.Carrier_Doppler_hz << " [Hz]";
+                }
+        }
+}
+
+
+void rtklib_pvt_gs::set_output_sinks()
+{
+    // KML, GPX and GeoJSON read the DOPs, which are only kept by the snapshot
+    if (d_kml_output_enabled)
+        {
+            d_output_pipeline->set_sink(PVT_SINK_KML, [this](const Rtklib_Solver& /*solver*/, const Pvt_Output_Epoch& epoch) {
+                d_kml_dump->print_position(&epoch.solution);
+            });
+        }
+    if (d_gpx_output_enabled)
+        {
+            d_output_pipeline->set_sink(PVT_SINK_GPX, [this](const Rtklib_Solver& /*solver*/, const Pvt_Output_Epoch& epoch) {
+                d_gpx_dump->print_position(&epoch.solution);
+            });
+        }
+    if (d_geojson_output_enabled)
+        {
+            d_output_pipeline->set_sink(PVT_SINK_GEOJSON, [this](const Rtklib_Solver& /*solver*/, const Pvt_Output_Epoch& epoch) {
+                d_geojson_printer->print_position(&epoch.solution);
+            });
+        }
+    if (d_nmea_output_file_enabled)
+        {
+            d_output_pipeline->set_sink(PVT_SINK_NMEA, [this](const Rtklib_Solver& solver, const Pvt_Output_Epoch& /*epoch*/) {
+                d_nmea_printer->Print_Nmea_Line(&solver);
+            });
+        }
+    if (d_rinex_output_enabled)
+        {
+            d_output_pipeline->set_sink(PVT_SINK_RINEX, [this](const Rtklib_Solver& solver, const Pvt_Output_Epoch& epoch) {
+                d_rp->print_rinex_annotation(&solver, epoch.observables, epoch.rx_time, d_type_of_rx, epoch.rinex_obs);
+            });
+        }
+    if (d_rtcm_enabled)
+        {
+            d_output_pipeline->set_sink(PVT_SINK_RTCM, [this](const Rtklib_Solver& solver, const Pvt_Output_Epoch& epoch) {
+                d_rtcm_printer->Print_Rtcm_Messages(&solver,
+                    epoch.observables,
+                    epoch.rx_time,
+                    d_type_of_rx,
+                    d_rtcm_MSM_rate_ms,
+                    d_rtcm_MT1019_rate_ms,
+                    d_rtcm_MT1020_rate_ms,
+                    d_rtcm_MT1045_rate_ms,
+                    d_rtcm_MT1077_rate_ms,
+                    d_rtcm_MT1097_rate_ms,
+                    epoch.rtcm_msm,
+                    epoch.rtcm_1019,
+                    epoch.rtcm_1020,
+                    epoch.rtcm_1045,
+                    d_enable_rx_clock_correction);
+            });
+        }
+    if (d_an_printer_enabled)
+        {
+            d_output_pipeline->set_sink(PVT_SINK_AN, [this](const Rtklib_Solver& solver, const Pvt_Output_Epoch& epoch) {
+                d_an_printer->print_packet(&solver, epoch.observables);
+            });
+        }
+}
+
+
+void rtklib_pvt_gs::submit_output_task(std::function<void()> task)
+{
+    auto output_epoch = std::make_shared<Pvt_Output_Epoch>();
+    output_epoch->tasks.push_back(std::move(task));
+    d_output_pipeline->submit(std::move(output_epoch));
+}
+
+
+void rtklib_pvt_gs::submit_output_epoch(std::shared_ptr<Pvt_Output_Epoch> epoch)
+{
+    if (d_output_nav_changed || !d_output_nav_data)
+        {
+            d_output_nav_data = std::make_shared<const Pvt_Output_Nav_Data>(*d_user_pvt_solver);
+            d_output_nav_changed = false;
+        }
+    epoch->solution = Pvt_Output_Solution(*d_user_pvt_solver);
+    epoch->pvt_sol = d_user_pvt_solver->pvt_sol;
+    if (epoch->sinks & (1U << PVT_SINK_NMEA))
+        {
+            epoch->pvt_ssat = std::make_shared<const std::array<ssat_t, MAXSAT>>(d_user_pvt_solver->pvt_ssat);
+        }
+    epoch->nav_data = d_output_nav_data;
+    epoch->observables = d_gnss_observables_map;
+    epoch->rx_time = d_rx_time;
+    d_output_pipeline->submit(std::move(epoch));
+}
+
+
+template <typename Eph>
+void rtklib_pvt_gs::submit_rtcm_lock_time(char system, const Eph& eph, const Gnss_Synchro& gnss_synchro)
+{
+    // Rtcm::lock_time() only stores the first time a signal is seen, so later
+    // calls for the same signal are not sent to the writer thread
+    const std::string key = system + std::string(gnss_synchro.Signal, 2) + std::to_string(gnss_synchro.PRN);
+    if (!d_rtcm_lock_time_signals.insert(key).second)
+        {
+            return;
+        }
+    submit_output_task([this, eph, gnss_synchro]() {
+        try
+            {
+                d_rtcm_printer->lock_time(eph, gnss_synchro.RX_time, gnss_synchro);
+            }
+        catch (const boost::exception& ex)
+            {
+                std::cout << "RTCM boost exception: " << boost::diagnostic_information(ex) << '\n';
+                LOG(ERROR) << "RTCM boost exception: " << boost::diagnostic_information(ex);
+            }
+        catch (const std::exception& ex)
+            {
+                std::cout << "RTCM std exception: " << ex.what() << '\n';
+                LOG(ERROR) << "RTCM std exception: " << ex.what();
+            }
+    });
+}
+
+
 int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items __attribute__((unused)))
 {
+    Block_Work_Timer work_timer(d_counters.get(), noutput_items);
+    work_timer.set_items(noutput_items);
+
     // *************** time tags ****************
     if (d_enable_rx_clock_correction == false)  // todo: currently only works if clock correction is disabled
         {
@@ -1970,6 +2204,7 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
             bool flag_write_RTCM_1045_output = false;
             bool flag_write_RTCM_MSM_output = false;
             bool flag_write_RINEX_obs_output = false;
+            uint32_t output_sinks = 0;  // Pvt_Output_Sink bits due in this epoch
             d_local_counter_ms += static_cast<uint64_t>(d_observable_interval_ms);
 
             d_gnss_observables_map.clear();
@@ -2043,46 +2278,22 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
 
                             if (d_rtcm_enabled)
                                 {
-                                    try
+                                    // keep track of locking time
+                                    if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
                                         {
-                                            if (d_internal_pvt_solver->gps_ephemeris_map.empty() == false)
-                                                {
-                                                    if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
-                                                }
-                                            if (d_internal_pvt_solver->galileo_ephemeris_map.empty() == false)
-                                                {
-                                                    if (tmp_eph_iter_gal != d_internal_pvt_solver->galileo_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->galileo_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
-                                                }
-                                            if (d_internal_pvt_solver->gps_cnav_ephemeris_map.empty() == false)
-                                                {
-                                                    if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_cnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
-                                                }
-                                            if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.empty() == false)
-                                                {
-                                                    if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
-                                                }
+                                            submit_rtcm_lock_time('G', tmp_eph_iter_gps->second, in[i][epoch]);
                                         }
-                                    catch (const boost::exception& ex)
+                                    if (tmp_eph_iter_gal != d_internal_pvt_solver->galileo_ephemeris_map.cend())
                                         {
-                                            std::cout << "RTCM boost exception: " << boost::diagnostic_information(ex) << '\n';
-                                            LOG(ERROR) << "RTCM boost exception: " << boost::diagnostic_information(ex);
+                                            submit_rtcm_lock_time('E', tmp_eph_iter_gal->second, in[i][epoch]);
                                         }
-                                    catch (const std::exception& ex)
+                                    if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
                                         {
-                                            std::cout << "RTCM std exception: " << ex.what() << '\n';
-                                            LOG(ERROR) << "RTCM std exception: " << ex.what();
+                                            submit_rtcm_lock_time('L', tmp_eph_iter_cnav->second, in[i][epoch]);
+                                        }
+                                    if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
+                                        {
+                                            submit_rtcm_lock_time('R', tmp_eph_iter_glo_gnav->second, in[i][epoch]);
                                         }
                                 }
                         }
@@ -2225,12 +2436,13 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
 
                     if (flag_pvt_valid == true)
                         {
-                            // experimental VTL tests
-                            // send tracking command
-                            //                            const std::shared_ptr<TrackingCmd> trk_cmd_test = std::make_shared<TrackingCmd>(TrackingCmd());
-                            //                            trk_cmd_test->carrier_freq_hz = 12345.4;
-                            //                            trk_cmd_test->sample_counter = d_gnss_observables_map.begin()->second.Tracking_sample_counter;
-                            //                            this->message_port_pub(pmt::mp("pvt_to_trk"), pmt::make_any(trk_cmd_test));
+                            Block_Instrumentation::instance().record_sample_to_pvt(d_gnss_observables_map.cbegin()->second.Tracking_sample_counter);
+
+                            // send Vector Tracking Loop (VTL) commands to the tracking channels
+                            if (d_enable_vtl)
+                                {
+                                    send_vtl_tracking_cmds();
+                                }
 
                             // initialize (if needed) the accumulated phase offset and apply it to the active channels
                             // required to report accumulated phase cycles comparable to pseudoranges
@@ -2332,51 +2544,37 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                         {
                                             if (current_RX_time_ms % d_kml_rate_ms == 0)
                                                 {
-                                                    d_kml_dump->print_position(d_user_pvt_solver.get());
+                                                    output_sinks |= 1U << PVT_SINK_KML;
                                                 }
                                         }
                                     if (d_gpx_output_enabled)
                                         {
                                             if (current_RX_time_ms % d_gpx_rate_ms == 0)
                                                 {
-                                                    d_gpx_dump->print_position(d_user_pvt_solver.get());
+                                                    output_sinks |= 1U << PVT_SINK_GPX;
                                                 }
                                         }
                                     if (d_geojson_output_enabled)
                                         {
                                             if (current_RX_time_ms % d_geojson_rate_ms == 0)
                                                 {
-                                                    d_geojson_printer->print_position(d_user_pvt_solver.get());
+                                                    output_sinks |= 1U << PVT_SINK_GEOJSON;
                                                 }
                                         }
                                     if (d_nmea_output_file_enabled)
                                         {
                                             if (current_RX_time_ms % d_nmea_rate_ms == 0)
                                                 {
-                                                    d_nmea_printer->Print_Nmea_Line(d_user_pvt_solver.get());
+                                                    output_sinks |= 1U << PVT_SINK_NMEA;
                                                 }
                                         }
                                     if (d_rinex_output_enabled)
                                         {
-                                            d_rp->print_rinex_annotation(d_user_pvt_solver.get(), d_gnss_observables_map, d_rx_time, d_type_of_rx, flag_write_RINEX_obs_output);
+                                            output_sinks |= 1U << PVT_SINK_RINEX;
                                         }
                                     if (d_rtcm_enabled)
                                         {
-                                            d_rtcm_printer->Print_Rtcm_Messages(d_user_pvt_solver.get(),
-                                                d_gnss_observables_map,
-                                                d_rx_time,
-                                                d_type_of_rx,
-                                                d_rtcm_MSM_rate_ms,
-                                                d_rtcm_MT1019_rate_ms,
-                                                d_rtcm_MT1020_rate_ms,
-                                                d_rtcm_MT1045_rate_ms,
-                                                d_rtcm_MT1077_rate_ms,
-                                                d_rtcm_MT1097_rate_ms,
-                                                flag_write_RTCM_MSM_output,
-                                                flag_write_RTCM_1019_output,
-                                                flag_write_RTCM_1020_output,
-                                                flag_write_RTCM_1045_output,
-                                                d_enable_rx_clock_correction);
+                                            output_sinks |= 1U << PVT_SINK_RTCM;
                                         }
                                 }
                         }
@@ -2453,9 +2651,22 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                 {
                     if (d_local_counter_ms % static_cast<uint64_t>(d_an_rate_ms) == 0)
                         {
-                            d_an_printer->print_packet(d_user_pvt_solver.get(), d_gnss_observables_map);
+                            output_sinks |= 1U << PVT_SINK_AN;
                         }
                 }
+
+            // ############ 3. HAND THE OUTPUT PRODUCTS OVER TO THE WRITER THREAD ####
+            if (output_sinks != 0)
+                {
+                    auto output_epoch = std::make_shared<Pvt_Output_Epoch>();
+                    output_epoch->sinks = output_sinks;
+                    output_epoch->rinex_obs = flag_write_RINEX_obs_output;
+                    output_epoch->rtcm_msm = flag_write_RTCM_MSM_output;
+                    output_epoch->rtcm_1019 = flag_write_RTCM_1019_output;
+                    output_epoch->rtcm_1020 = flag_write_RTCM_1020_output;
+                    output_epoch->rtcm_1045 = flag_write_RTCM_1045_output;
+                    submit_output_epoch(std::move(output_epoch));
+                }
         }
 
     return noutput_items;
@@ -17,6 +17,7 @@
 #ifndef GNSS_SDR_RTKLIB_PVT_GS_H
 #define GNSS_SDR_RTKLIB_PVT_GS_H
 
+#include "block_instrumentation.h"
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"
@@ -31,9 +32,11 @@
 #include <cstdint>                // for int32_t
 #include <ctime>                  // for time_t
 #include <fstream>                // for std::fstream
+#include <functional>             // for std::function
 #include <map>                    // for map
 #include <memory>                 // for shared_ptr, unique_ptr
 #include <queue>                  // for std::queue
+#include <set>                    // for std::set
 #include <string>                 // for string
 #include <sys/types.h>            // for key_t
 #include <vector>                 // for vector
@@ -60,12 +63,15 @@ class Monitor_Pvt_Udp_Sink;
 class Monitor_Ephemeris_Udp_Sink;
 class Nmea_Printer;
 class Pvt_Conf;
+class Pvt_Output_Nav_Data;
+class Pvt_Output_Pipeline;
 class Rinex_Printer;
 class Rtcm_Printer;
 class An_Packet_Printer;
 class Has_Simple_Printer;
 class Rtklib_Solver;
 class rtklib_pvt_gs;
+struct Pvt_Output_Epoch;
 
 using rtklib_pvt_gs_sptr = gnss_shared_ptr<rtklib_pvt_gs>;
 
@@ -151,6 +157,17 @@ private:
 
     void update_HAS_corrections();
 
+    void send_vtl_tracking_cmds();
+
+    void set_output_sinks();
+
+    void submit_output_task(std::function<void()> task);
+
+    void submit_output_epoch(std::shared_ptr<Pvt_Output_Epoch> epoch);
+
+    template <typename Eph>
+    void submit_rtcm_lock_time(char system, const Eph& eph, const Gnss_Synchro& gnss_synchro);
+
     std::map<int, Gnss_Synchro> interpolate_observables(const std::map<int, Gnss_Synchro>& observables_map_t0,
         const std::map<int, Gnss_Synchro>& observables_map_t1,
         double rx_time_s);
@@ -176,6 +193,7 @@ private:
 
     std::shared_ptr<Rtklib_Solver> d_internal_pvt_solver;
     std::shared_ptr<Rtklib_Solver> d_user_pvt_solver;
+    std::shared_ptr<Block_Counters> d_counters;
 
     std::unique_ptr<Rinex_Printer> d_rp;
     std::unique_ptr<Kml_Printer> d_kml_dump;
@@ -187,6 +205,8 @@ private:
     std::unique_ptr<Monitor_Ephemeris_Udp_Sink> d_eph_udp_sink_ptr;
     std::unique_ptr<Has_Simple_Printer> d_has_simple_printer;
     std::unique_ptr<An_Packet_Printer> d_an_printer;
+    std::unique_ptr<Pvt_Output_Pipeline> d_output_pipeline;  // must be declared after the printers it writes to
+    std::shared_ptr<const Pvt_Output_Nav_Data> d_output_nav_data;
 
     std::chrono::time_point<std::chrono::system_clock> d_start;
     std::chrono::time_point<std::chrono::system_clock> d_end;
@@ -202,8 +222,12 @@ private:
     std::map<int, Gnss_Synchro> d_gnss_observables_map_t0;
     std::map<int, Gnss_Synchro> d_gnss_observables_map_t1;
 
+    std::map<std::string, double> d_vtl_code_chip_rate_cps;  // nominal code chip rate, indexed by signal
+
     std::queue<GnssTime> d_TimeChannelTagTimestamps;
 
+    std::set<std::string> d_rtcm_lock_time_signals;  // signals already passed to Rtcm_Printer::lock_time()
+
     boost::posix_time::time_duration d_utc_diff_time;
     std::unique_ptr<Geohash> d_geohash;
 
@@ -278,6 +302,8 @@ private:
     bool d_log_timetag;
     bool d_use_has_corrections;
     bool d_use_unhealthy_sats;
+    bool d_enable_vtl;
+    bool d_output_nav_changed;
 };
 
 
@@ -33,6 +33,8 @@ public:
     std::map<int, int> rtcm_msg_rate_ms;
 
     std::string rinex_name = std::string("-");
+    std::string rinex_rotation = std::string("none");
+    std::string rinex_compression = std::string("none");
     std::string dump_filename;
     std::string nmea_dump_filename;
     std::string nmea_dump_devname;
@@ -50,9 +52,11 @@ public:
     std::string udp_addresses;
     std::string udp_eph_addresses;
     std::string log_source_timetag_file;
+    std::string output_overflow_policy = std::string("block");
 
     uint32_t type_of_receiver = 0;
     uint32_t observable_interval_ms = 20;
+    uint32_t output_queue_size = 64;
 
     int32_t output_rate_ms = 0;
     int32_t display_rate_ms = 0;
@@ -76,6 +80,7 @@ public:
     bool flag_rtcm_tty_port = false;
     bool output_enabled = true;
     bool rinex_output_enabled = true;
+    bool rinex_compact = false;
     bool gpx_output_enabled = true;
     bool geojson_output_enabled = true;
     bool nmea_output_file_enabled = true;
@@ -95,6 +100,7 @@ public:
     bool use_e6_for_pvt = true;
     bool use_has_corrections = true;
     bool use_unhealthy_sats = false;
+    bool async_output = true;
 
     // PVT KF parameters
     bool enable_pvt_kf = false;
@@ -102,6 +108,9 @@ public:
     double measures_ecef_vel_sd_ms = 0.1;
     double system_ecef_pos_sd_m = 0.01;
     double system_ecef_vel_sd_ms = 0.001;
+
+    // Vector Tracking Loop (VTL) parameters
+    bool enable_vtl = false;
 };
 
 
@@ -0,0 +1,391 @@
+/*!
+ * \file pvt_output_pipeline.cc
+ * \brief Implementation of a class that writes the PVT output products (RINEX,
+ * RTCM, NMEA, KML, GPX, GeoJSON and AN packets) from a dedicated thread
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_output_pipeline.h"
+#include <glog/logging.h>
+#include <algorithm>  // for std::max, std::min
+#include <exception>  // for std::exception
+#include <iterator>   // for std::make_move_iterator
+#include <utility>    // for std::move
+
+
+Pvt_Overflow_Policy pvt_overflow_policy_from_string(const std::string& policy)
+{
+    if (policy == "drop_oldest")
+        {
+            return Pvt_Overflow_Policy::drop_oldest;
+        }
+    if (policy == "coalesce")
+        {
+            return Pvt_Overflow_Policy::coalesce;
+        }
+    if (policy != "block")
+        {
+            LOG(WARNING) << "Unknown PVT output overflow policy " << policy << ", using block";
+        }
+    return Pvt_Overflow_Policy::block;
+}
+
+
+std::string pvt_output_sink_name(Pvt_Output_Sink sink)
+{
+    switch (sink)
+        {
+        case PVT_SINK_RINEX:
+            return "RINEX";
+        case PVT_SINK_RTCM:
+            return "RTCM";
+        case PVT_SINK_NMEA:
+            return "NMEA";
+        case PVT_SINK_KML:
+            return "KML";
+        case PVT_SINK_GPX:
+            return "GPX";
+        case PVT_SINK_GEOJSON:
+            return "GeoJSON";
+        case PVT_SINK_AN:
+            return "AN";
+        default:
+            return "Unknown";
+        }
+}
+
+
+Pvt_Output_Solution::Pvt_Output_Solution(const Pvt_Solution& solution)
+    : Pvt_Solution(solution),
+      d_hdop(solution.get_hdop()),
+      d_vdop(solution.get_vdop()),
+      d_pdop(solution.get_pdop()),
+      d_gdop(solution.get_gdop())
+{
+}
+
+
+Pvt_Output_Nav_Data::Pvt_Output_Nav_Data(const Rtklib_Solver& solver)
+    : d_galileo_ephemeris_map(solver.galileo_ephemeris_map),
+      d_gps_ephemeris_map(solver.gps_ephemeris_map),
+      d_gps_cnav_ephemeris_map(solver.gps_cnav_ephemeris_map),
+      d_glonass_gnav_ephemeris_map(solver.glonass_gnav_ephemeris_map),
+      d_beidou_dnav_ephemeris_map(solver.beidou_dnav_ephemeris_map),
+      d_galileo_almanac_map(solver.galileo_almanac_map),
+      d_gps_almanac_map(solver.gps_almanac_map),
+      d_beidou_dnav_almanac_map(solver.beidou_dnav_almanac_map),
+      d_galileo_utc_model(solver.galileo_utc_model),
+      d_galileo_iono(solver.galileo_iono),
+      d_gps_utc_model(solver.gps_utc_model),
+      d_gps_iono(solver.gps_iono),
+      d_gps_cnav_iono(solver.gps_cnav_iono),
+      d_gps_cnav_utc_model(solver.gps_cnav_utc_model),
+      d_glonass_gnav_utc_model(solver.glonass_gnav_utc_model),
+      d_glonass_gnav_almanac(solver.glonass_gnav_almanac),
+      d_beidou_dnav_utc_model(solver.beidou_dnav_utc_model),
+      d_beidou_dnav_iono(solver.beidou_dnav_iono)
+{
+}
+
+
+void Pvt_Output_Nav_Data::copy_to(Rtklib_Solver& solver) const
+{
+    solver.galileo_ephemeris_map = d_galileo_ephemeris_map;
+    solver.gps_ephemeris_map = d_gps_ephemeris_map;
+    solver.gps_cnav_ephemeris_map = d_gps_cnav_ephemeris_map;
+    solver.glonass_gnav_ephemeris_map = d_glonass_gnav_ephemeris_map;
+    solver.beidou_dnav_ephemeris_map = d_beidou_dnav_ephemeris_map;
+    solver.galileo_almanac_map = d_galileo_almanac_map;
+    solver.gps_almanac_map = d_gps_almanac_map;
+    solver.beidou_dnav_almanac_map = d_beidou_dnav_almanac_map;
+    solver.galileo_utc_model = d_galileo_utc_model;
+    solver.galileo_iono = d_galileo_iono;
+    solver.gps_utc_model = d_gps_utc_model;
+    solver.gps_iono = d_gps_iono;
+    solver.gps_cnav_iono = d_gps_cnav_iono;
+    solver.gps_cnav_utc_model = d_gps_cnav_utc_model;
+    solver.glonass_gnav_utc_model = d_glonass_gnav_utc_model;
+    solver.glonass_gnav_almanac = d_glonass_gnav_almanac;
+    solver.beidou_dnav_utc_model = d_beidou_dnav_utc_model;
+    solver.beidou_dnav_iono = d_beidou_dnav_iono;
+}
+
+
+namespace
+{
+// Moves the tasks of an older epoch in front of the tasks of a newer one
+void prepend_tasks(Pvt_Output_Epoch& older, Pvt_Output_Epoch& newer)
+{
+    older.tasks.insert(older.tasks.end(), std::make_move_iterator(newer.tasks.begin()), std::make_move_iterator(newer.tasks.end()));
+    newer.tasks = std::move(older.tasks);
+    older.tasks.clear();
+}
+
+
+// Moves the tasks and outputs of an older epoch into a newer one
+void merge_into(Pvt_Output_Epoch& older, Pvt_Output_Epoch& newer)
+{
+    prepend_tasks(older, newer);
+    if ((newer.sinks & (1U << PVT_SINK_NMEA)) == 0 && (older.sinks & (1U << PVT_SINK_NMEA)) != 0)
+        {
+            // the satellite status was only copied into the older epoch
+            newer.pvt_ssat = std::move(older.pvt_ssat);
+        }
+    newer.sinks |= older.sinks;
+    newer.rinex_obs = newer.rinex_obs || older.rinex_obs;
+    newer.rtcm_msm = newer.rtcm_msm || older.rtcm_msm;
+    newer.rtcm_1019 = newer.rtcm_1019 || older.rtcm_1019;
+    newer.rtcm_1020 = newer.rtcm_1020 || older.rtcm_1020;
+    newer.rtcm_1045 = newer.rtcm_1045 || older.rtcm_1045;
+    newer.created = std::min(newer.created, older.created);
+}
+}  // namespace
+
+
+Pvt_Output_Pipeline::Pvt_Output_Pipeline(std::unique_ptr<Rtklib_Solver> solver,
+    bool asynchronous,
+    size_t capacity,
+    Pvt_Overflow_Policy policy)
+    : d_solver(std::move(solver)),
+      d_queue(std::max<size_t>(capacity, 2)),
+      d_policy(policy),
+      d_asynchronous(asynchronous)
+{
+    if (d_asynchronous)
+        {
+            d_thread = std::thread(&Pvt_Output_Pipeline::run, this);
+        }
+}
+
+
+Pvt_Output_Pipeline::~Pvt_Output_Pipeline()
+{
+    stop();
+}
+
+
+void Pvt_Output_Pipeline::set_sink(Pvt_Output_Sink id, Sink sink)
+{
+    d_sinks[id] = std::move(sink);
+}
+
+
+void Pvt_Output_Pipeline::submit(std::shared_ptr<Pvt_Output_Epoch> epoch)
+{
+    if (d_stopped || !epoch)
+        {
+            return;
+        }
+    if (!d_asynchronous)
+        {
+            write(*epoch);
+            return;
+        }
+
+    if (epoch->sinks == 0)
+        {
+            // Tasks are never dropped. If a coalesced epoch is waiting for
+            // room, they travel with it.
+            if (d_pending)
+                {
+                    d_pending->tasks.insert(d_pending->tasks.end(), std::make_move_iterator(epoch->tasks.begin()), std::make_move_iterator(epoch->tasks.end()));
+                    if (d_queue.try_push(d_pending))
+                        {
+                            d_pending = nullptr;
+                        }
+                    return;
+                }
+            d_queue.push(epoch);
+            return;
+        }
+
+    switch (d_policy)
+        {
+        case Pvt_Overflow_Policy::drop_oldest:
+            while (!d_queue.try_push(epoch))
+                {
+                    std::shared_ptr<Pvt_Output_Epoch> oldest;
+                    if (d_queue.try_pop(oldest) && oldest)
+                        {
+                            // its outputs are lost, but its tasks still run
+                            prepend_tasks(*oldest, *epoch);
+                            if (oldest->sinks != 0)
+                                {
+                                    d_dropped.fetch_add(1, std::memory_order_relaxed);
+                                }
+                        }
+                }
+            break;
+        case Pvt_Overflow_Policy::coalesce:
+            if (d_pending)
+                {
+                    merge_into(*d_pending, *epoch);
+                    d_pending = nullptr;
+                    d_coalesced.fetch_add(1, std::memory_order_relaxed);
+                }
+            if (!d_queue.try_push(epoch))
+                {
+                    d_pending = std::move(epoch);
+                }
+            break;
+        case Pvt_Overflow_Policy::block:
+        default:
+            if (!d_queue.try_push(epoch))
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    while (!d_queue.try_push(epoch))
+                        {
+                            std::this_thread::sleep_for(std::chrono::microseconds(200));
+                        }
+                    d_blocked_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                }
+        }
+}
+
+
+void Pvt_Output_Pipeline::stop()
+{
+    if (d_stopped)
+        {
+            return;
+        }
+    d_stopped = true;
+    if (d_asynchronous)
+        {
+            if (d_pending)
+                {
+                    d_queue.push(d_pending);
+                    d_pending = nullptr;
+                }
+            d_queue.push(nullptr);
+            if (d_thread.joinable())
+                {
+                    d_thread.join();
+                }
+        }
+}
+
+
+Pvt_Sink_Stats Pvt_Output_Pipeline::sink_stats(Pvt_Output_Sink id) const
+{
+    std::lock_guard<std::mutex> lock(d_counters_mutex);
+    const Sink_Counters& counters = d_counters[id];
+    Pvt_Sink_Stats stats;
+    stats.epochs = counters.epochs;
+    if (counters.epochs > 0)
+        {
+            stats.mean_latency_ms = counters.total_latency_ms / static_cast<double>(counters.epochs);
+            stats.mean_write_ms = counters.total_write_ms / static_cast<double>(counters.epochs);
+        }
+    stats.max_latency_ms = counters.max_latency_ms;
+    stats.max_write_ms = counters.max_write_ms;
+    return stats;
+}
+
+
+void Pvt_Output_Pipeline::log_stats() const
+{
+    for (uint32_t id = 0; id < PVT_OUTPUT_SINKS; id++)
+        {
+            const Pvt_Sink_Stats stats = sink_stats(static_cast<Pvt_Output_Sink>(id));
+            if (stats.epochs > 0)
+                {
+                    LOG(INFO) << "PVT " << pvt_output_sink_name(static_cast<Pvt_Output_Sink>(id)) << " output: "
+                              << stats.epochs << " epochs, latency mean " << stats.mean_latency_ms
+                              << " ms, max " << stats.max_latency_ms << " ms, write time mean "
+                              << stats.mean_write_ms << " ms, max " << stats.max_write_ms << " ms";
+                }
+        }
+    if (d_asynchronous)
+        {
+            LOG(INFO) << "PVT output queue: " << dropped_epochs() << " epochs dropped, "
+                      << coalesced_epochs() << " epochs coalesced, " << blocked_ms() << " ms blocked";
+        }
+}
+
+
+void Pvt_Output_Pipeline::run()
+{
+    std::shared_ptr<Pvt_Output_Epoch> epoch;
+    while (true)
+        {
+            if (!d_queue.timed_wait_and_pop(epoch, 100))
+                {
+                    continue;
+                }
+            if (!epoch)
+                {
+                    break;
+                }
+            write(*epoch);
+            epoch = nullptr;
+        }
+}
+
+
+void Pvt_Output_Pipeline::write(const Pvt_Output_Epoch& epoch)
+{
+    for (const auto& task : epoch.tasks)
+        {
+            try
+                {
+                    task();
+                }
+            catch (const std::exception& ex)
+                {
+                    LOG(WARNING) << "PVT output task failed: " << ex.what();
+                }
+        }
+    if (epoch.sinks == 0)
+        {
+            return;
+        }
+
+    if (epoch.nav_data && epoch.nav_data != d_applied_nav_data)
+        {
+            epoch.nav_data->copy_to(*d_solver);
+            d_applied_nav_data = epoch.nav_data;
+        }
+    static_cast<Pvt_Solution&>(*d_solver) = epoch.solution;
+    d_solver->pvt_sol = epoch.pvt_sol;
+    if (epoch.pvt_ssat)
+        {
+            d_solver->pvt_ssat = *epoch.pvt_ssat;
+        }
+
+    for (uint32_t id = 0; id < PVT_OUTPUT_SINKS; id++)
+        {
+            if ((epoch.sinks & (1U << id)) == 0 || !d_sinks[id])
+                {
+                    continue;
+                }
+            const auto start = std::chrono::steady_clock::now();
+            try
+                {
+                    d_sinks[id](*d_solver, epoch);
+                }
+            catch (const std::exception& ex)
+                {
+                    LOG(WARNING) << "PVT " << pvt_output_sink_name(static_cast<Pvt_Output_Sink>(id)) << " output failed: " << ex.what();
+                }
+            const auto end = std::chrono::steady_clock::now();
+            const double write_ms = std::chrono::duration<double, std::milli>(end - start).count();
+            const double latency_ms = std::chrono::duration<double, std::milli>(end - epoch.created).count();
+            std::lock_guard<std::mutex> lock(d_counters_mutex);
+            Sink_Counters& counters = d_counters[id];
+            counters.epochs++;
+            counters.total_latency_ms += latency_ms;
+            counters.max_latency_ms = std::max(counters.max_latency_ms, latency_ms);
+            counters.total_write_ms += write_ms;
+            counters.max_write_ms = std::max(counters.max_write_ms, write_ms);
+        }
+}
@@ -0,0 +1,246 @@
+/*!
+ * \file pvt_output_pipeline.h
+ * \brief Interface of a class that writes the PVT output products (RINEX,
+ * RTCM, NMEA, KML, GPX, GeoJSON and AN packets) from a dedicated thread
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_OUTPUT_PIPELINE_H
+#define GNSS_SDR_PVT_OUTPUT_PIPELINE_H
+
+#include "concurrent_queue.h"
+#include "gnss_synchro.h"
+#include "pvt_solution.h"
+#include "rtklib.h"
+#include "rtklib_solver.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief What to do with a new epoch when the queue of the writer thread is
+ * full
+ */
+enum class Pvt_Overflow_Policy
+{
+    drop_oldest,  //!< Discard the oldest queued epoch
+    block,        //!< Wait until the writer thread makes room, nothing is lost
+    coalesce      //!< Merge the epochs that do not fit into one, with the latest solution and all the outputs due in any of them
+};
+
+Pvt_Overflow_Policy pvt_overflow_policy_from_string(const std::string& policy);  //!< "drop_oldest", "block" or "coalesce"
+
+
+/*!
+ * \brief Output products of the PVT block
+ */
+enum Pvt_Output_Sink : uint32_t
+{
+    PVT_SINK_RINEX = 0,
+    PVT_SINK_RTCM,
+    PVT_SINK_NMEA,
+    PVT_SINK_KML,
+    PVT_SINK_GPX,
+    PVT_SINK_GEOJSON,
+    PVT_SINK_AN,
+    PVT_OUTPUT_SINKS
+};
+
+std::string pvt_output_sink_name(Pvt_Output_Sink sink);
+
+
+/*!
+ * \brief Copy of the position, velocity, time and DOPs of a solution
+ */
+class Pvt_Output_Solution final : public Pvt_Solution
+{
+public:
+    Pvt_Output_Solution() = default;
+    explicit Pvt_Output_Solution(const Pvt_Solution& solution);
+
+    inline double get_hdop() const override { return d_hdop; }
+    inline double get_vdop() const override { return d_vdop; }
+    inline double get_pdop() const override { return d_pdop; }
+    inline double get_gdop() const override { return d_gdop; }
+
+private:
+    double d_hdop{0.0};
+    double d_vdop{0.0};
+    double d_pdop{0.0};
+    double d_gdop{0.0};
+};
+
+
+/*!
+ * \brief Copy of the navigation data of a solver (ephemeris, almanacs, iono
+ * and UTC models), as read by the RINEX and RTCM printers
+ */
+class Pvt_Output_Nav_Data
+{
+public:
+    explicit Pvt_Output_Nav_Data(const Rtklib_Solver& solver);
+    void copy_to(Rtklib_Solver& solver) const;
+
+private:
+    std::map<int, Galileo_Ephemeris> d_galileo_ephemeris_map;
+    std::map<int, Gps_Ephemeris> d_gps_ephemeris_map;
+    std::map<int, Gps_CNAV_Ephemeris> d_gps_cnav_ephemeris_map;
+    std::map<int, Glonass_Gnav_Ephemeris> d_glonass_gnav_ephemeris_map;
+    std::map<int, Beidou_Dnav_Ephemeris> d_beidou_dnav_ephemeris_map;
+    std::map<int, Galileo_Almanac> d_galileo_almanac_map;
+    std::map<int, Gps_Almanac> d_gps_almanac_map;
+    std::map<int, Beidou_Dnav_Almanac> d_beidou_dnav_almanac_map;
+    Galileo_Utc_Model d_galileo_utc_model;
+    Galileo_Iono d_galileo_iono;
+    Gps_Utc_Model d_gps_utc_model;
+    Gps_Iono d_gps_iono;
+    Gps_CNAV_Iono d_gps_cnav_iono;
+    Gps_CNAV_Utc_Model d_gps_cnav_utc_model;
+    Glonass_Gnav_Utc_Model d_glonass_gnav_utc_model;
+    Glonass_Gnav_Almanac d_glonass_gnav_almanac;
+    Beidou_Dnav_Utc_Model d_beidou_dnav_utc_model;
+    Beidou_Dnav_Iono d_beidou_dnav_iono;
+};
+
+
+/*!
+ * \brief Snapshot of everything the output sinks need from one epoch. Once
+ * submitted, it is only read by the writer thread.
+ */
+struct Pvt_Output_Epoch
+{
+    Pvt_Output_Solution solution;
+    sol_t pvt_sol{};
+    std::shared_ptr<const std::array<ssat_t, MAXSAT>> pvt_ssat;  // only if the NMEA sink is due
+    std::shared_ptr<const Pvt_Output_Nav_Data> nav_data;         // nullptr if the epoch only carries tasks
+    std::map<int, Gnss_Synchro> observables;
+    std::vector<std::function<void()>> tasks;  // run before the sinks, in order (e.g. logging a new ephemeris)
+    std::chrono::steady_clock::time_point created{std::chrono::steady_clock::now()};
+    double rx_time{0.0};
+    uint32_t sinks{0};  // bit mask of the sinks due in this epoch
+    bool rinex_obs{false};
+    bool rtcm_msm{false};
+    bool rtcm_1019{false};
+    bool rtcm_1020{false};
+    bool rtcm_1045{false};
+};
+
+
+/*!
+ * \brief Time from the snapshot to the end of the write, and time spent in
+ * the sink itself, of the epochs written by a sink
+ */
+struct Pvt_Sink_Stats
+{
+    uint64_t epochs{0};
+    double mean_latency_ms{0.0};
+    double max_latency_ms{0.0};
+    double mean_write_ms{0.0};
+    double max_write_ms{0.0};
+};
+
+
+/*!
+ * \brief Hands the epochs of the PVT block over to a writer thread that runs
+ * the output sinks, so that a slow disk or serial port does not stall the
+ * GNU Radio scheduler thread.
+ *
+ * Epochs go through a bounded queue. The writer thread copies each snapshot
+ * into its own Rtklib_Solver, which the sinks read instead of the solver of
+ * the PVT block. In synchronous mode, submit() writes the epoch before
+ * returning, on the caller's thread.
+ */
+class Pvt_Output_Pipeline
+{
+public:
+    using Sink = std::function<void(const Rtklib_Solver& solver, const Pvt_Output_Epoch& epoch)>;
+
+    /*!
+     * \param[in] solver Solver that the sinks read, not used anywhere else
+     * \param[in] asynchronous If false, the sinks are run by submit()
+     * \param[in] capacity Number of epochs that can wait for the writer thread
+     * \param[in] policy What to do with a new epoch when the queue is full
+     */
+    Pvt_Output_Pipeline(std::unique_ptr<Rtklib_Solver> solver,
+        bool asynchronous,
+        size_t capacity,
+        Pvt_Overflow_Policy policy);
+
+    ~Pvt_Output_Pipeline();
+
+    Pvt_Output_Pipeline(const Pvt_Output_Pipeline&) = delete;
+    Pvt_Output_Pipeline& operator=(const Pvt_Output_Pipeline&) = delete;
+
+    void set_sink(Pvt_Output_Sink id, Sink sink);  //!< Must be called before the first submit()
+
+    void submit(std::shared_ptr<Pvt_Output_Epoch> epoch);  //!< Hands an epoch over to the writer thread
+
+    void stop();  //!< Writes the pending epochs and stops the writer thread
+
+    void log_stats() const;  //!< Logs the statistics of each sink and of the queue
+
+    Pvt_Sink_Stats sink_stats(Pvt_Output_Sink id) const;
+    inline uint64_t dropped_epochs() const { return d_dropped.load(std::memory_order_relaxed); }      //!< Epochs discarded by the drop_oldest policy
+    inline uint64_t coalesced_epochs() const { return d_coalesced.load(std::memory_order_relaxed); }  //!< Epochs merged into a later one by the coalesce policy
+    inline double blocked_ms() const { return d_blocked_ms; }                                         //!< Time that submit() waited for room in the queue. Not thread-safe, read it from the thread that calls submit().
+    inline bool asynchronous() const { return d_asynchronous; }
+
+private:
+    struct Sink_Counters
+    {
+        uint64_t epochs{0};
+        double total_latency_ms{0.0};
+        double max_latency_ms{0.0};
+        double total_write_ms{0.0};
+        double max_write_ms{0.0};
+    };
+
+    void run();
+    void write(const Pvt_Output_Epoch& epoch);
+
+    std::unique_ptr<Rtklib_Solver> d_solver;
+    std::array<Sink, PVT_OUTPUT_SINKS> d_sinks{};
+    std::array<Sink_Counters, PVT_OUTPUT_SINKS> d_counters{};
+    mutable std::mutex d_counters_mutex;
+
+    Concurrent_Queue<std::shared_ptr<Pvt_Output_Epoch>> d_queue;
+    std::shared_ptr<Pvt_Output_Epoch> d_pending;  // coalesced epoch waiting for room in the queue
+    std::shared_ptr<const Pvt_Output_Nav_Data> d_applied_nav_data;
+    std::thread d_thread;
+
+    std::atomic<uint64_t> d_dropped{0};
+    std::atomic<uint64_t> d_coalesced{0};
+    double d_blocked_ms{0.0};
+    Pvt_Overflow_Policy d_policy;
+    bool d_asynchronous;
+    bool d_stopped{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_OUTPUT_PIPELINE_H
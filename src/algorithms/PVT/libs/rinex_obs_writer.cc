@@ -0,0 +1,653 @@
+/*!
+ * \file rinex_obs_writer.cc
+ * \brief Implementation of a writer of RINEX observation records in Compact
+ * RINEX (Hatanaka) format, optionally compressed with gzip on the fly
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rinex_obs_writer.h"
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include <glog/logging.h>
+#include <algorithm>  // for std::min, std::max
+#include <cstdlib>    // for atoi
+#include <ctime>      // for time, gmtime_r, strftime
+#include <fcntl.h>    // for open()
+#include <iterator>   // for istreambuf_iterator
+#include <unistd.h>   // for pwrite(), close()
+
+#if HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace
+{
+constexpr int32_t MAX_ORDER = 3;                  // order of the differences of the data fields
+constexpr std::size_t EPOCH_COLUMNS = 41;         // columns of a RINEX 3 epoch record before the clock offset
+constexpr std::size_t FIELD_WIDTH = 16;           // F14.3 value, LLI and SSI
+constexpr std::size_t GZIP_HEADER_SIZE = 10;      // gzip member header without optional fields
+constexpr std::size_t STORED_BLOCK_SIZE = 65535;  // maximum length of a stored deflate block
+constexpr std::size_t DEFLATE_CHUNK = 65536;
+
+
+inline std::size_t trimmed_size(const char* text, std::size_t size)
+{
+    while ((size > 0) && (text[size - 1] == ' ' || text[size - 1] == '\r'))
+        {
+            size--;
+        }
+    return size;
+}
+
+
+inline void rtrim(std::string& text, std::size_t from)
+{
+    text.resize(from + trimmed_size(text.data() + from, text.size() - from));
+}
+
+
+void append_int(std::string& out, int64_t value)
+{
+    char digits[24];
+    char* p = digits + sizeof(digits);
+    uint64_t magnitude = value < 0 ? (~static_cast<uint64_t>(value) + 1) : static_cast<uint64_t>(value);
+    do
+        {
+            *--p = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        }
+    while (magnitude != 0);
+    if (value < 0)
+        {
+            *--p = '-';
+        }
+    out.append(p, digits + sizeof(digits));
+}
+
+
+// Reads a number written in fixed notation with at most the given number of
+// decimals, as an integer in units of the last decimal. Returns false if the
+// field is blank or not a number.
+bool parse_fixed(const char* text, std::size_t size, int32_t decimals, int64_t& value)
+{
+    std::size_t i = 0;
+    while ((i < size) && (text[i] == ' '))
+        {
+            i++;
+        }
+    bool negative = false;
+    if ((i < size) && (text[i] == '-'))
+        {
+            negative = true;
+            i++;
+        }
+    int64_t mantissa = 0;
+    int32_t digits = 0;
+    int32_t fraction = -1;  // digits after the decimal point, -1 if there is no point
+    for (; (i < size) && (text[i] != ' '); i++)
+        {
+            if ((text[i] == '.') && (fraction < 0))
+                {
+                    fraction = 0;
+                }
+            else if ((text[i] >= '0') && (text[i] <= '9') && (digits < 18))
+                {
+                    mantissa = mantissa * 10 + (text[i] - '0');
+                    digits++;
+                    if (fraction >= 0)
+                        {
+                            fraction++;
+                        }
+                }
+            else
+                {
+                    return false;
+                }
+        }
+    for (; i < size; i++)
+        {
+            if (text[i] != ' ')
+                {
+                    return false;
+                }
+        }
+    if ((digits == 0) || (fraction > decimals))
+        {
+            return false;
+        }
+    for (int32_t k = std::max(fraction, 0); k < decimals; k++)
+        {
+            mantissa *= 10;
+        }
+    value = negative ? -mantissa : mantissa;
+    return true;
+}
+
+
+inline uint32_t sat_key(const char* id)
+{
+    return (static_cast<uint32_t>(static_cast<unsigned char>(id[0])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(id[1])) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(id[2]));
+}
+
+
+inline void put_le32(std::string& out, uint32_t value)
+{
+    for (int32_t i = 0; i < 4; i++)
+        {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+}
+}  // namespace
+
+
+void Crinex_Encoder::header(std::string& out, const std::string& program)
+{
+    std::string line("3.0");
+    line.resize(20, ' ');
+    line += "COMPACT RINEX FORMAT";
+    line.resize(60, ' ');
+    line += "CRINEX VERS   / TYPE\n";
+    out += line;
+
+    std::array<char, 20> date{};
+    const std::time_t now = std::time(nullptr);
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+    std::strftime(date.data(), date.size(), "%d-%b-%y %H:%M", &utc);
+    line = program.substr(0, 40);
+    line.resize(40, ' ');
+    line += date.data();
+    line.resize(60, ' ');
+    line += "CRINEX PROG / DATE  \n";
+    out += line;
+}
+
+
+void Crinex_Encoder::set_obs_types(const std::string& header)
+{
+    d_obs_types.fill(0);
+    std::size_t start = 0;
+    while (start < header.size())
+        {
+            std::size_t end = header.find('\n', start);
+            if (end == std::string::npos)
+                {
+                    end = header.size();
+                }
+            // Continuation lines leave the satellite system blank
+            if ((end - start >= 79) && (header.compare(start + 60, 19, "SYS / # / OBS TYPES") == 0) && (header[start] != ' '))
+                {
+                    const auto system = static_cast<unsigned char>(header[start]);
+                    if (system < d_obs_types.size())
+                        {
+                            d_obs_types[system] = std::atoi(header.substr(start + 3, 3).c_str());
+                        }
+                }
+            start = end + 1;
+        }
+}
+
+
+void Crinex_Encoder::reset()
+{
+    d_sats.clear();
+    d_previous_epoch.clear();
+    d_clock = Arc();
+    d_epoch_count = 0;
+    d_pending_sats = 0;
+    d_pending_events = 0;
+}
+
+
+void Crinex_Encoder::encode(const char* text, std::size_t size, std::string& out)
+{
+    d_lines.clear();
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < size; i++)
+        {
+            if (text[i] == '\n')
+                {
+                    d_lines.emplace_back(start, i - start);
+                    start = i + 1;
+                }
+        }
+    if (start < size)
+        {
+            d_lines.emplace_back(start, size - start);
+        }
+
+    for (std::size_t l = 0; l < d_lines.size(); l++)
+        {
+            const char* line = text + d_lines[l].first;
+            const std::size_t length = trimmed_size(line, d_lines[l].second);
+            if (d_pending_events > 0)
+                {
+                    out.append(line, length);
+                    out += '\n';
+                    d_pending_events--;
+                }
+            else if ((length > 0) && (line[0] == '>'))
+                {
+                    // Satellites of the epoch, from the records that follow it
+                    const int32_t n_sats = (length >= 35) ? std::atoi(std::string(line + 32, 3).c_str()) : 0;
+                    d_pending_sats = 0;
+                    d_epoch.assign(line, std::min(length, EPOCH_COLUMNS));
+                    d_epoch.resize(EPOCH_COLUMNS, ' ');
+                    if ((length > 31) && (line[31] > '1'))
+                        {
+                            // Special event: copied as it is, and the next epoch is written in full
+                            out.append(line, length);
+                            out += '\n';
+                            d_pending_events = n_sats;
+                            d_previous_epoch.clear();
+                            continue;
+                        }
+                    for (std::size_t s = l + 1; (s < d_lines.size()) && (d_pending_sats < n_sats); s++, d_pending_sats++)
+                        {
+                            d_epoch.append(text + d_lines[s].first, std::min<std::size_t>(d_lines[s].second, 3));
+                        }
+                    Crinex_Encoder::encode_epoch(line, length, out);
+                }
+            else if (d_pending_sats > 0)
+                {
+                    Crinex_Encoder::encode_sat(line, length, out);
+                    d_pending_sats--;
+                }
+            else if (length > 0)
+                {
+                    DLOG(WARNING) << "Unexpected RINEX observation record: " << std::string(line, length);
+                }
+        }
+}
+
+
+void Crinex_Encoder::encode_epoch(const char* line, std::size_t size, std::string& out)
+{
+    d_epoch_count++;
+    const std::size_t start = out.size();
+    if (d_previous_epoch.empty())
+        {
+            out += d_epoch;
+        }
+    else
+        {
+            Crinex_Encoder::text_diff(d_previous_epoch, d_epoch, out);
+        }
+    rtrim(out, start);
+    out += '\n';
+    d_previous_epoch.swap(d_epoch);
+
+    // Receiver clock offset, in units of 1e-12 s
+    int64_t clock = 0;
+    if ((size > EPOCH_COLUMNS) && parse_fixed(line + EPOCH_COLUMNS, std::min<std::size_t>(size - EPOCH_COLUMNS, 15), 12, clock))
+        {
+            Crinex_Encoder::encode_value(d_clock, clock, out);
+        }
+    else
+        {
+            d_clock.order = -1;
+        }
+    out += '\n';
+}
+
+
+void Crinex_Encoder::encode_sat(const char* line, std::size_t size, std::string& out)
+{
+    if (size < 3)
+        {
+            out += '\n';
+            return;
+        }
+    Sat_State& sat = d_sats[sat_key(line)];
+    if (sat.epoch + 1 != d_epoch_count)
+        {
+            // Not in the previous epoch, all the arcs start again
+            for (auto& arc : sat.arcs)
+                {
+                    arc.order = -1;
+                }
+            sat.flags.clear();
+        }
+    sat.epoch = d_epoch_count;
+
+    // Fields missing at the end of the record are still separated by spaces
+    const auto system = static_cast<unsigned char>(line[0]);
+    const std::size_t n_types = (system < d_obs_types.size()) ? static_cast<std::size_t>(d_obs_types[system]) : 0;
+    const std::size_t n_fields = std::max((size - 3 + FIELD_WIDTH - 1) / FIELD_WIDTH, n_types);
+    if (sat.arcs.size() < n_fields)
+        {
+            sat.arcs.resize(n_fields);
+        }
+    for (std::size_t i = n_fields; i < sat.arcs.size(); i++)
+        {
+            sat.arcs[i].order = -1;
+        }
+
+    const std::size_t start = out.size();
+    d_flags.clear();
+    for (std::size_t i = 0; i < n_fields; i++)
+        {
+            const std::size_t column = 3 + i * FIELD_WIDTH;
+            if (i > 0)
+                {
+                    out += ' ';
+                }
+            int64_t value = 0;
+            if ((column < size) && parse_fixed(line + column, std::min<std::size_t>(size - column, FIELD_WIDTH - 2), 3, value))
+                {
+                    Crinex_Encoder::encode_value(sat.arcs[i], value, out);
+                }
+            else
+                {
+                    sat.arcs[i].order = -1;
+                }
+            d_flags += (column + 14 < size) ? line[column + 14] : ' ';
+            d_flags += (column + 15 < size) ? line[column + 15] : ' ';
+        }
+    out += ' ';
+    Crinex_Encoder::text_diff(sat.flags, d_flags, out);
+    sat.flags = d_flags;
+    rtrim(out, start);
+    out += '\n';
+}
+
+
+void Crinex_Encoder::encode_value(Arc& arc, int64_t value, std::string& out)
+{
+    if (arc.order < 0)
+        {
+            append_int(out, MAX_ORDER);
+            out += '&';
+            append_int(out, value);
+            arc.y = {value, 0, 0};
+            arc.order = 0;
+            return;
+        }
+    const int32_t order = std::min(arc.order + 1, MAX_ORDER);
+    const int64_t d1 = value - arc.y[0];
+    const int64_t d2 = d1 - arc.y[1];
+    const int64_t d3 = d2 - arc.y[2];
+    append_int(out, order == 1 ? d1 : (order == 2 ? d2 : d3));
+    arc.y = {value, d1, d2};
+    arc.order = order;
+}
+
+
+void Crinex_Encoder::text_diff(const std::string& previous, const std::string& current, std::string& out)
+{
+    const std::size_t size = std::max(previous.size(), current.size());
+    for (std::size_t i = 0; i < size; i++)
+        {
+            const char c = (i < current.size()) ? current[i] : ' ';
+            const char p = (i < previous.size()) ? previous[i] : ' ';
+            if (c == p)
+                {
+                    out += ' ';
+                }
+            else if (c == ' ')
+                {
+                    out += '&';
+                }
+            else
+                {
+                    out += c;
+                }
+        }
+}
+
+
+struct Rinex_Obs_Writer::Zlib_Stream
+{
+#if HAS_ZLIB
+    z_stream strm{};
+#endif
+};
+
+
+Rinex_Obs_Writer::Epoch_Buffer::int_type Rinex_Obs_Writer::Epoch_Buffer::overflow(int_type c)
+{
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            d_text.push_back(traits_type::to_char_type(c));
+        }
+    return traits_type::not_eof(c);
+}
+
+
+std::streamsize Rinex_Obs_Writer::Epoch_Buffer::xsputn(const char* s, std::streamsize n)
+{
+    d_text.append(s, static_cast<std::size_t>(n));
+    return n;
+}
+
+
+Rinex_Obs_Writer::Rinex_Obs_Writer(bool compact, bool gzip)
+    : d_epoch_stream(&d_epoch_buffer),
+      d_compact(compact),
+      d_gzip(gzip)
+{
+    if (d_gzip && !Rinex_Obs_Writer::gzip_available())
+        {
+            LOG(WARNING) << "GNSS-SDR was built without zlib, RINEX observation files will not be compressed";
+            d_gzip = false;
+        }
+    if (d_gzip)
+        {
+            d_deflated.resize(DEFLATE_CHUNK);
+        }
+}
+
+
+Rinex_Obs_Writer::~Rinex_Obs_Writer()
+{
+#if HAS_ZLIB
+    if (d_zstream)
+        {
+            deflateEnd(&d_zstream->strm);
+        }
+#endif
+}
+
+
+bool Rinex_Obs_Writer::gzip_available()
+{
+#if HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+void Rinex_Obs_Writer::start_file(std::fstream& file, const std::string& program)
+{
+#if HAS_ZLIB
+    if (d_zstream)
+        {
+            deflateEnd(&d_zstream->strm);
+        }
+#endif
+    d_zstream.reset();
+    d_encoder.reset();
+    d_epoch_buffer.text().clear();
+    d_header_offset = 0;
+    d_header_size = 0;
+    d_header_in_place = true;
+    d_start_size = 0;
+    if (d_compact)
+        {
+            d_encoded.clear();
+            Crinex_Encoder::header(d_encoded, program);
+            file << d_encoded;
+            d_start_size = static_cast<std::streamoff>(d_encoded.size());
+        }
+}
+
+
+void Rinex_Obs_Writer::end_header(std::fstream& file, const std::string& filename)
+{
+    // Only the header has been written so far
+    file.flush();
+    file.clear();
+    file.seekg(0);
+    const std::string header((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.clear();
+    file.seekp(0, std::ios_base::end);
+    d_encoder.set_obs_types(header);
+    if (!d_gzip)
+        {
+            return;
+        }
+#if HAS_ZLIB
+    // Wrap the header into stored (not compressed) deflate blocks
+
+    std::string member{'\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\xff'};
+    std::size_t pos = 0;
+    do
+        {
+            const std::size_t length = std::min(header.size() - pos, STORED_BLOCK_SIZE);
+            member += (pos + length == header.size()) ? '\x01' : '\x00';
+            member += static_cast<char>(length & 0xFF);
+            member += static_cast<char>(length >> 8);
+            member += static_cast<char>(~length & 0xFF);
+            member += static_cast<char>((~length >> 8) & 0xFF);
+            member.append(header, pos, length);
+            pos += length;
+        }
+    while (pos < header.size());
+    put_le32(member, static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef*>(header.data()), static_cast<uInt>(header.size()))));
+    put_le32(member, static_cast<uint32_t>(header.size()));
+
+    file.close();
+    file.open(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+    file << member;
+    file.close();
+    file.open(filename, std::ios::out | std::ios::in | std::ios::app | std::ios::binary);
+    file.seekp(0, std::ios_base::end);
+
+    d_header_offset = static_cast<std::streamoff>(GZIP_HEADER_SIZE + 5);
+    d_header_size = header.size();
+    d_header_in_place = header.size() <= STORED_BLOCK_SIZE;
+    if (!d_header_in_place)
+        {
+            LOG(WARNING) << "The header of " << filename << " is too long to be updated in place";
+        }
+#else
+    if (filename.empty())
+        {
+        }  // Avoid compiler warning
+#endif
+}
+
+
+void Rinex_Obs_Writer::write_epochs(std::fstream& file)
+{
+    std::string& text = d_epoch_buffer.text();
+    if (text.empty())
+        {
+            return;
+        }
+    const char* data = text.data();
+    std::size_t size = text.size();
+    if (d_compact)
+        {
+            d_encoded.clear();
+            d_encoder.encode(text.data(), text.size(), d_encoded);
+            data = d_encoded.data();
+            size = d_encoded.size();
+        }
+    if (d_gzip)
+        {
+            Rinex_Obs_Writer::deflate_records(file, data, size, false);
+        }
+    else
+        {
+            file.write(data, static_cast<std::streamsize>(size));
+        }
+    text.clear();
+}
+
+
+void Rinex_Obs_Writer::end_file(std::fstream& file)
+{
+    Rinex_Obs_Writer::write_epochs(file);
+    if (d_zstream)
+        {
+            Rinex_Obs_Writer::deflate_records(file, nullptr, 0, true);
+        }
+}
+
+
+bool Rinex_Obs_Writer::update_header(const std::string& filename, const std::string& header) const
+{
+    if (!d_gzip)
+        {
+            return true;
+        }
+#if HAS_ZLIB
+    if (!d_header_in_place || (d_header_offset == 0) || (header.size() != d_header_size))
+        {
+            return false;
+        }
+    std::string buffer(header);
+    put_le32(buffer, static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef*>(header.data()), static_cast<uInt>(header.size()))));
+    const int fd = ::open(filename.c_str(), O_WRONLY);
+    if (fd < 0)
+        {
+            return false;
+        }
+    const ssize_t written = ::pwrite(fd, buffer.data(), buffer.size(), d_header_offset);
+    ::close(fd);
+    return written == static_cast<ssize_t>(buffer.size());
+#else
+    return filename.empty() && header.empty();
+#endif
+}
+
+
+void Rinex_Obs_Writer::deflate_records(std::fstream& file, const char* data, std::size_t size, bool finish)
+{
+#if HAS_ZLIB
+    if (!d_zstream)
+        {
+            d_zstream = std::make_unique<Zlib_Stream>();
+            // windowBits + 16 writes a gzip wrapper around the deflate stream
+            if (deflateInit2(&d_zstream->strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                {
+                    LOG(ERROR) << "Could not start the compression of the RINEX observation records";
+                    d_zstream.reset();
+                    return;
+                }
+        }
+    z_stream& strm = d_zstream->strm;
+    strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    strm.avail_in = static_cast<uInt>(size);
+    do
+        {
+            strm.next_out = d_deflated.data();
+            strm.avail_out = static_cast<uInt>(d_deflated.size());
+            deflate(&strm, finish ? Z_FINISH : Z_NO_FLUSH);
+            file.write(reinterpret_cast<const char*>(d_deflated.data()), static_cast<std::streamsize>(d_deflated.size() - strm.avail_out));
+        }
+    while (strm.avail_out == 0);
+    if (finish)
+        {
+            deflateEnd(&strm);
+            d_zstream.reset();
+        }
+#else
+    if (file.is_open() && data && size && finish)
+        {
+        }  // Avoid compiler warning
+#endif
+}
@@ -0,0 +1,190 @@
+/*!
+ * \file rinex_obs_writer.h
+ * \brief Interface of a writer of RINEX observation records in Compact RINEX
+ * (Hatanaka) format, optionally compressed with gzip on the fly
+ * See Y. Hatanaka, A Compression Format and Tools for GNSS Observation Data,
+ * Bulletin of the Geographical Survey Institute, vol. 55, 2008.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RINEX_OBS_WRITER_H
+#define GNSS_SDR_RINEX_OBS_WRITER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Converts RINEX 3 observation records into Compact RINEX 3.0
+ * records, as RNX2CRX does.
+ *
+ * Each data field is written as the third-order difference of its values in
+ * units of the last decimal (the first epochs of an arc use lower orders, and
+ * the first value is written as "3&value"), the epoch record and the LLI/SSI
+ * flags are written as text differences with the previous epoch. The state
+ * of every satellite is kept between calls, and no memory is allocated once
+ * the buffers have grown to the size of an epoch.
+ */
+class Crinex_Encoder
+{
+public:
+    Crinex_Encoder() = default;
+
+    /*!
+     * \brief Appends the CRINEX VERS / TYPE and CRINEX PROG / DATE records
+     * that go before the RINEX header
+     */
+    static void header(std::string& out, const std::string& program);
+
+    /*!
+     * \brief Reads the number of observation types of each system from the
+     * SYS / # / OBS TYPES records of the RINEX header
+     */
+    void set_obs_types(const std::string& header);
+
+    /*!
+     * \brief Encodes complete RINEX 3 observation records (epoch records
+     * followed by their satellite records) and appends them to out
+     */
+    void encode(const char* text, std::size_t size, std::string& out);
+
+    /*!
+     * \brief Starts the next epoch record and all the data arcs again, as
+     * done at the beginning of a file
+     */
+    void reset();
+
+private:
+    struct Arc
+    {
+        std::array<int64_t, 3> y{};  // last value and its first and second differences
+        int32_t order{-1};           // -1 if the arc is not started
+    };
+
+    struct Sat_State
+    {
+        std::vector<Arc> arcs;
+        std::string flags;
+        uint64_t epoch{0};
+    };
+
+    void encode_epoch(const char* line, std::size_t size, std::string& out);
+    void encode_sat(const char* line, std::size_t size, std::string& out);
+    static void encode_value(Arc& arc, int64_t value, std::string& out);
+
+    static void text_diff(const std::string& previous, const std::string& current, std::string& out);
+
+    std::map<uint32_t, Sat_State> d_sats;
+    std::array<int32_t, 128> d_obs_types{};  // number of observation types of each system
+    std::vector<std::pair<std::size_t, std::size_t>> d_lines;  // start and length of each line of the input
+    std::string d_epoch;
+    std::string d_previous_epoch;
+    std::string d_flags;
+    Arc d_clock;
+    uint64_t d_epoch_count{0};
+    int32_t d_pending_sats{0};    // satellite records of the current epoch not seen yet
+    int32_t d_pending_events{0};  // records of a special event, copied as they are
+};
+
+
+/*!
+ * \brief Buffers the observation records of each epoch and writes them to the
+ * observation file, in Compact RINEX and/or gzip format.
+ *
+ * The records are formatted into a reusable buffer through epoch_stream(),
+ * and converted and appended to the file by write_epochs(). With gzip, the
+ * header is stored uncompressed in a gzip member of its own, so that it can
+ * still be updated in place, and the records are deflated into a second
+ * member that is completed when the file is closed. Any gzip reader
+ * decompresses both members as a single file.
+ */
+class Rinex_Obs_Writer
+{
+public:
+    Rinex_Obs_Writer(bool compact, bool gzip);
+    ~Rinex_Obs_Writer();
+
+    Rinex_Obs_Writer(const Rinex_Obs_Writer&) = delete;
+    Rinex_Obs_Writer& operator=(const Rinex_Obs_Writer&) = delete;
+
+    static bool gzip_available();  //!< False if GNSS-SDR was built without zlib
+
+    inline bool compact() const { return d_compact; }
+    inline bool gzip() const { return d_gzip; }
+
+    inline std::ostream& epoch_stream() { return d_epoch_stream; }  //!< Where the records of an epoch are formatted
+
+    void start_file(std::fstream& file, const std::string& program);  //!< Writes the records that go before the RINEX header
+    void end_header(std::fstream& file, const std::string& filename);  //!< Reads the observation types and puts the header into its gzip member
+    void write_epochs(std::fstream& file);                              //!< Writes the records buffered by epoch_stream()
+    void end_file(std::fstream& file);                                  //!< Completes the gzip member of the records
+
+    /*!
+     * \brief Tells the writer that the header starting at header_offset()
+     * was overwritten in place, so that its gzip checksum is updated.
+     * Returns false if the header cannot be changed in place.
+     */
+    bool update_header(const std::string& filename, const std::string& header) const;
+
+    inline std::streamoff header_offset() const { return d_header_offset; }  //!< Position of the header text in the file
+    inline std::streamoff start_size() const { return d_start_size; }        //!< Bytes written by start_file()
+
+private:
+    class Epoch_Buffer : public std::streambuf
+    {
+    public:
+        inline std::string& text() { return d_text; }
+
+    protected:
+        int_type overflow(int_type c) override;
+        std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+    private:
+        std::string d_text;
+    };
+
+    struct Zlib_Stream;
+
+    void deflate_records(std::fstream& file, const char* data, std::size_t size, bool finish);
+
+    Crinex_Encoder d_encoder;
+    Epoch_Buffer d_epoch_buffer;
+    std::ostream d_epoch_stream;
+    std::string d_encoded;
+    std::vector<unsigned char> d_deflated;
+    std::unique_ptr<Zlib_Stream> d_zstream;  // deflate stream of the records, nullptr if not started
+    std::streamoff d_header_offset{0};
+    std::streamoff d_start_size{0};
+    std::size_t d_header_size{0};
+    bool d_compact;
+    bool d_gzip;
+    bool d_header_in_place{true};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RINEX_OBS_WRITER_H
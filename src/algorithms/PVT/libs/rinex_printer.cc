@@ -38,6 +38,7 @@
 #include "gps_iono.h"
 #include "gps_navigation_message.h"
 #include "gps_utc_model.h"
+#include "rinex_obs_writer.h"
 #include "rtklib_solver.h"
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/local_time/local_time.hpp>
@@ -47,22 +48,39 @@
 #include <array>
 #include <cmath>  // for floor
 #include <exception>
+#include <fcntl.h>   // for open()
 #include <iostream>  // for cout
 #include <iterator>
 #include <ostream>
 #include <set>
-#include <unistd.h>  // for getlogin_r()
+#include <unistd.h>  // for getlogin_r(), pwrite()
 #include <utility>
 #include <vector>
 
+namespace
+{
+// Blank COMMENT lines written before END OF HEADER in the observation files,
+// so that the LEAP SECONDS and TIME OF LAST OBS records can be added in place
+const std::string RESERVED_HEADER_LINE = std::string(60, ' ') + "COMMENT" + std::string(13, ' ');
+constexpr int32_t RESERVED_HEADER_LINES = 2;
+}  // namespace
+
 
 Rinex_Printer::Rinex_Printer(int32_t conf_version,
     const std::string& base_path,
-    const std::string& base_name) : d_fake_cnav_iode(1),
-                                    d_numberTypesObservations(4),
-                                    d_rinex_header_updated(false),
-                                    d_rinex_header_written(false),
-                                    d_pre_2009_file(false)
+    const std::string& base_name,
+    const std::string& rotation,
+    bool compact,
+    const std::string& compression) : d_base_name(base_name),
+                                      d_fake_cnav_iode(1),
+                                      d_first_obs_rx_time(0.0),
+                                      d_last_obs_rx_time(0.0),
+                                      d_rotation_s(0),
+                                      d_numberTypesObservations(4),
+                                      d_rinex_header_updated(false),
+                                      d_rinex_header_written(false),
+                                      d_obs_logged(false),
+                                      d_pre_2009_file(false)
 
 {
     observationCode["GPS_L1_CA"] = "1C";          // "1C" GPS L1 C/A
@@ -170,17 +188,90 @@ Rinex_Printer::Rinex_Printer(int32_t conf_version,
         {
             std::cout << "RINEX files will be stored at " << base_rinex_path << '\n';
         }
+    d_base_path = base_rinex_path;
+
+    if (rotation == "hourly")
+        {
+            d_rotation_s = 3600;
+        }
+    else if (rotation == "daily")
+        {
+            d_rotation_s = 86400;
+        }
+    else if (rotation != "none")
+        {
+            LOG(WARNING) << "Unknown RINEX rotation " << rotation << ", files will not be rotated";
+        }
+
+    if (conf_version == 2)
+        {
+            d_version = 2;
+            d_stringVersion = "2.11";
+        }
+    else
+        {
+            d_version = 3;
+            d_stringVersion = "3.02";
+        }
+
+    const bool gzip = (compression == "gzip");
+    if (!gzip && (compression != "none"))
+        {
+            LOG(WARNING) << "Unknown RINEX compression " << compression << ", files will not be compressed";
+        }
+    if (compact && (d_version == 2))
+        {
+            LOG(WARNING) << "Compact RINEX is only available for RINEX 3 observation files";
+            compact = false;
+        }
+    if (compact || gzip)
+        {
+            d_obs_writer = std::make_unique<Rinex_Obs_Writer>(compact, gzip);
+        }
+
+    Rinex_Printer::open_files(base_name);
+}
+
+
+Rinex_Printer::~Rinex_Printer()
+{
+    DLOG(INFO) << "RINEX printer destructor called.";
+    try
+        {
+            Rinex_Printer::close_files();
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+        }
+}
+
+
+void Rinex_Printer::open_files(const std::string& base_name, const boost::posix_time::ptime& start_time)
+{
+    navfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GPS_NAV", base_name, start_time);
+    obsfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_OBS", base_name, start_time);
+    sbsfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_SBAS", base_name, start_time);
+    navGalfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GAL_NAV", base_name, start_time);
+    navMixfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_MIXED_NAV", base_name, start_time);
+    navGlofilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GLO_NAV", base_name, start_time);
+    navBdsfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_BDS_NAV", base_name, start_time);
 
-    navfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GPS_NAV", base_name);
-    obsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_OBS", base_name);
-    sbsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_SBAS", base_name);
-    navGalfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GAL_NAV", base_name);
-    navMixfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_MIXED_NAV", base_name);
-    navGlofilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GLO_NAV", base_name);
-    navBdsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_BDS_NAV", base_name);
+    if (d_obs_writer)
+        {
+            // Hatanaka-compressed observation files end in "D" instead of "O"
+            if (d_obs_writer->compact())
+                {
+                    obsfilename.back() = 'D';
+                }
+            if (d_obs_writer->gzip())
+                {
+                    obsfilename += ".gz";
+                }
+        }
 
     Rinex_Printer::navFile.open(navfilename, std::ios::out | std::ios::in | std::ios::app);
-    Rinex_Printer::obsFile.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
+    Rinex_Printer::obsFile.open(obsfilename, std::ios::out | std::ios::in | std::ios::app | std::ios::binary);
     Rinex_Printer::sbsFile.open(sbsfilename, std::ios::out | std::ios::app);
     Rinex_Printer::navGalFile.open(navGalfilename, std::ios::out | std::ios::in | std::ios::app);
     Rinex_Printer::navMixFile.open(navMixfilename, std::ios::out | std::ios::in | std::ios::app);
@@ -193,23 +284,26 @@ Rinex_Printer::Rinex_Printer(int32_t conf_version,
         {
             std::cout << "RINEX files cannot be saved. Wrong permissions?\n";
         }
-
-    if (conf_version == 2)
-        {
-            d_version = 2;
-            d_stringVersion = "2.11";
-        }
-    else
+    if (d_obs_writer)
         {
-            d_version = 3;
-            d_stringVersion = "3.02";
+            d_obs_writer->start_file(obsFile, std::string("GNSS-SDR ") + GNSS_SDR_VERSION);
         }
 }
 
 
-Rinex_Printer::~Rinex_Printer()
+void Rinex_Printer::close_files()
 {
-    DLOG(INFO) << "RINEX printer destructor called.";
+    std::streamoff obs_start_size = 0;
+    if (obsFile.is_open())
+        {
+            Rinex_Printer::finalize_obs_header();
+            if (d_obs_writer)
+                {
+                    d_obs_writer->end_file(obsFile);
+                    obs_start_size = d_obs_writer->start_size();
+                }
+        }
+
     // close RINEX files
     const auto posn = navFile.tellp();
     const auto poso = obsFile.tellp();
@@ -219,19 +313,13 @@ Rinex_Printer::~Rinex_Printer()
     const auto posnr = navGloFile.tellp();
     const auto posnc = navBdsFile.tellp();
 
-    try
-        {
-            Rinex_Printer::navFile.close();
-            Rinex_Printer::obsFile.close();
-            Rinex_Printer::sbsFile.close();
-            Rinex_Printer::navGalFile.close();
-            Rinex_Printer::navGloFile.close();
-            Rinex_Printer::navBdsFile.close();
-        }
-    catch (const std::exception& e)
-        {
-            std::cerr << e.what() << '\n';
-        }
+    Rinex_Printer::navFile.close();
+    Rinex_Printer::obsFile.close();
+    Rinex_Printer::sbsFile.close();
+    Rinex_Printer::navGalFile.close();
+    Rinex_Printer::navMixFile.close();
+    Rinex_Printer::navGloFile.close();
+    Rinex_Printer::navBdsFile.close();
 
     // If nothing written, erase the files.
     if (posn == 0)
@@ -242,7 +330,7 @@ Rinex_Printer::~Rinex_Printer()
                     LOG(INFO) << "Error deleting temporary file";
                 }
         }
-    if (poso == 0)
+    if (poso == obs_start_size)
         {
             errorlib::error_code ec;
             if (!fs::remove(fs::path(obsfilename), ec))
@@ -300,6 +388,15 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
     std::map<int, Gps_CNAV_Ephemeris>::const_iterator gps_cnav_ephemeris_iter;
     std::map<int, Glonass_Gnav_Ephemeris>::const_iterator glonass_gnav_ephemeris_iter;
     std::map<int, Beidou_Dnav_Ephemeris>::const_iterator beidou_dnav_ephemeris_iter;
+    if (d_rinex_header_written && d_rotation_s > 0 && !d_first_obs_time.is_not_a_date_time())
+        {
+            const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+            const int64_t period = (Rinex_Printer::get_obs_time(rx_time) - epoch).total_seconds() / d_rotation_s;
+            if (period != (d_first_obs_time - epoch).total_seconds() / d_rotation_s)
+                {
+                    Rinex_Printer::rotate_files(rx_time);
+                }
+        }
     if (!d_rinex_header_written)  // & we have utc data in nav message!
         {
             galileo_ephemeris_iter = pvt_solver->galileo_ephemeris_map.cbegin();
@@ -834,6 +931,14 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                 default:
                     break;
                 }
+            if (d_rinex_header_written)
+                {
+                    if (d_obs_writer)
+                        {
+                            d_obs_writer->end_header(obsFile, obsfilename);
+                        }
+                    Rinex_Printer::set_first_obs_time(rx_time);
+                }
         }
     if (d_rinex_header_written)  // The header is already written, we can now log the navigation message data
         {
@@ -846,12 +951,17 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
             // Log observables into the RINEX file
             if (flag_write_RINEX_obs_output)
                 {
+                    d_last_obs_rx_time = rx_time;
+                    d_obs_logged = true;
+                    // With Compact RINEX or gzip, the records are formatted into a buffer and converted afterwards
+                    std::ostream& obs_out = d_obs_writer ? d_obs_writer->epoch_stream() : obsFile;
+
                     switch (type_of_rx)
                         {
                         case 1:  // GPS L1 C/A only
                             if (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -864,7 +974,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 3:  // GPS L5
                             if (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->gps_cnav_utc_model.A0 != 0))
                                 {
@@ -876,7 +986,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 4:  // Galileo E1B only
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -888,7 +998,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 5:  // Galileo E5a only
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -900,7 +1010,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 6:  // Galileo E5b only
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "7X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "7X");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -912,7 +1022,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 7:  // GPS L1 C/A + GPS L2C
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) && (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -924,7 +1034,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 8:  // L1+L5
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) && (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated && ((pvt_solver->gps_cnav_utc_model.A0 != 0) || (pvt_solver->gps_utc_model.A0 != 0)))
                                         {
                                             if (pvt_solver->gps_cnav_utc_model.A0 != 0)
@@ -944,7 +1054,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 9:  // GPS L1 C/A + Galileo E1B
                             if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) && (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -956,7 +1066,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 13:  // L5+E5a
                             if ((gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()) && (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->gps_cnav_utc_model.A0 != 0) && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -968,7 +1078,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 14:  // Galileo E1B + Galileo E5a
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -980,7 +1090,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 15:  // Galileo E1B + Galileo E5b
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -992,7 +1102,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 19:  // Galileo E5a + Galileo E5b
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X 7X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X 7X");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1004,7 +1114,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 23:  // GLONASS L1 C/A only
                             if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C");
+                                    log_rinex_obs(obs_out, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->glonass_gnav_utc_model.d_tau_c != 0))
                                 {
@@ -1016,7 +1126,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 24:  // GLONASS L2 C/A only
                             if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "2C");
+                                    log_rinex_obs(obs_out, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "2C");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->glonass_gnav_utc_model.d_tau_c != 0))
                                 {
@@ -1028,7 +1138,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 25:  // GLONASS L1 C/A + GLONASS L2 C/A
                             if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C 2C");
+                                    log_rinex_obs(obs_out, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C 2C");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->glonass_gnav_utc_model.d_tau_c != 0))
                                 {
@@ -1040,7 +1150,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 26:  // GPS L1 C/A + GLONASS L1 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) && (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -1052,7 +1162,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 27:  // Galileo E1B + GLONASS L1 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) && (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1064,7 +1174,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 28:  // GPS L2C + GLONASS L1 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) && (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->gps_cnav_utc_model.A0 != 0))
                                 {
@@ -1076,7 +1186,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 29:  // GPS L1 C/A + GLONASS L2 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) && (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -1088,7 +1198,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 30:  // Galileo E1B + GLONASS L2 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) && (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1100,7 +1210,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 31:  // GPS L2C + GLONASS L2 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) && (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->gps_cnav_utc_model.A0 != 0))
                                 {
@@ -1112,7 +1222,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 32:  // L1+E1+L5+E5a
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) && (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()) && (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated && ((pvt_solver->gps_cnav_utc_model.A0 != 0) || (pvt_solver->gps_utc_model.A0 != 0)) && (pvt_solver->galileo_utc_model.A0 != 0))
                                         {
                                             if (pvt_solver->gps_cnav_utc_model.A0 != 0)
@@ -1132,7 +1242,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 33:  // L1+E1+E5a
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) && (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0) && (pvt_solver->galileo_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -1144,7 +1254,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 100:  // Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "E6");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "E6");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1156,7 +1266,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 101:  // Galileo E1B + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B E6");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B E6");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1168,7 +1278,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 102:  // Galileo E5a + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X E6");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X E6");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1180,7 +1290,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 103:  // Galileo E5b + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "7X E6");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "7X E6");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1192,7 +1302,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 104:  // Galileo E1B + Galileo E5a + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X E6");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X E6");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1204,7 +1314,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 105:  // Galileo E1B + Galileo E5b + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X E6");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X E6");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
@@ -1216,7 +1326,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 106:  // GPS L1 C/A + Galileo E1B + Galileo E6B
                             if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) && (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0))
                                         {
                                             update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -1231,7 +1341,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                                     if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                         {
                                             // we have Galileo ephemeris, maybe from assistance
-                                            log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                            log_rinex_obs(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                             if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0))
                                                 {
                                                     update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -1242,7 +1352,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                                     else
                                         {
                                             // we do not have galileo ephemeris, print only GPS data
-                                            log_rinex_obs(obsFile, gps_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                            log_rinex_obs(obs_out, gps_ephemeris_iter->second, rx_time, gnss_observables_map);
                                             if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0))
                                                 {
                                                     update_obs_header(obsFile, pvt_solver->gps_utc_model);
@@ -1257,7 +1367,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                                 (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and
                                 (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, true);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, true);
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0) && (pvt_solver->galileo_utc_model.A0 != 0) && (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
@@ -1269,7 +1379,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 500:  // BDS B1I only
                             if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B1");
+                                    log_rinex_obs(obs_out, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B1");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->beidou_dnav_utc_model.A0_UTC != 0))
                                 {
@@ -1281,7 +1391,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 600:  // BDS B3I only
                             if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B3");
+                                    log_rinex_obs(obs_out, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B3");
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->beidou_dnav_utc_model.A0_UTC != 0))
                                 {
@@ -1294,7 +1404,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and
                                 (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map, true);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map, true);
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0) && (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
@@ -1308,7 +1418,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                                 (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and
                                 (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, true);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, true);
                                 }
                             if (!d_rinex_header_updated && (pvt_solver->gps_utc_model.A0 != 0) && (pvt_solver->galileo_utc_model.A0 != 0) && (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
@@ -1320,6 +1430,10 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         default:
                             break;
                         }
+                    if (d_obs_writer)
+                        {
+                            d_obs_writer->write_epochs(obsFile);
+                        }
                 }
         }
 }
@@ -1565,10 +1679,11 @@ void Rinex_Printer::lengthCheck(const std::string& line) const
 }
 
 
-std::string Rinex_Printer::createFilename(const std::string& type, const std::string& base_name) const
+std::string Rinex_Printer::createFilename(const std::string& type, const std::string& base_name, const boost::posix_time::ptime& start_time) const
 {
     const std::string stationName = "GSDR";  // 4-character station name designator
-    const boost::gregorian::date today = boost::gregorian::day_clock::local_day();
+    const boost::posix_time::ptime pt = start_time.is_not_a_date_time() ? boost::posix_time::second_clock::local_time() : start_time;
+    const boost::gregorian::date today = pt.date();
     const int32_t dayOfTheYear = today.day_of_year();
     std::stringstream strm0;
     if (dayOfTheYear < 100)
@@ -1595,7 +1710,6 @@ std::string Rinex_Printer::createFilename(const std::string& type, const std::st
     fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_SUMMARY", "S"));    // S - Summary file (used e.g., by IGS, not a standard!).
     fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_BDS_NAV", "F"));    // G - GLONASS navigation file.
 
-    const boost::posix_time::ptime pt = boost::posix_time::second_clock::local_time();
     const tm pt_tm = boost::posix_time::to_tm(pt);
     const int32_t local_hour = pt_tm.tm_hour;
     std::stringstream strm;
@@ -3790,155 +3904,266 @@ void Rinex_Printer::rinex_sbs_header(std::fstream& out) const
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
+std::vector<std::string> Rinex_Printer::read_header(std::fstream& out) const
 {
-    if (glonass_gnav_almanac.i_satellite_freq_channel)
+    std::vector<std::string> header;
+    std::string line_str;
+
+    out.flush();
+    out.clear();
+    out.seekg(Rinex_Printer::header_offset(out));
+    while (std::getline(out, line_str))
         {
-        }  // Avoid compiler warning
-    std::vector<std::string> data;
-    std::string line_aux;
+            header.push_back(line_str);
+            if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    break;
+                }
+        }
+    out.clear();
+    return header;
+}
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
 
-    bool no_more_finds = false;
-    std::string line_str;
+std::streamoff Rinex_Printer::header_offset(const std::fstream& out) const
+{
+    if (d_obs_writer && (&out == &obsFile))
+        {
+            return d_obs_writer->header_offset();
+        }
+    return 0;
+}
+
 
-    while (!out.eof())
+void Rinex_Printer::write_header(std::fstream& out, const std::string& filename, const std::vector<std::string>& old_header, std::vector<std::string> header) const
+{
+    if (old_header.empty() || (old_header.back().find("END OF HEADER", 59) == std::string::npos))
         {
-            std::getline(out, line_str);
+            LOG(WARNING) << "Could not find the end of the header of " << filename;
+            return;
+        }
+    const auto header_size = [](const std::vector<std::string>& lines) {
+        size_t size = 0;
+        for (const auto& line : lines)
+            {
+                size += line.size() + 1;
+            }
+        return size;
+    };
+    const size_t old_size = header_size(old_header);
+    size_t size = header_size(header);
 
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
+    // Use up or give back reserved lines, so that the header keeps its size
+    auto reserved = std::find(header.begin(), header.end(), RESERVED_HEADER_LINE);
+    while ((size > old_size) && (reserved != header.end()))
+        {
+            header.erase(reserved);
+            size -= RESERVED_HEADER_LINE.size() + 1;
+            reserved = std::find(header.begin(), header.end(), RESERVED_HEADER_LINE);
+        }
+    while (size + RESERVED_HEADER_LINE.size() + 1 <= old_size)
+        {
+            header.insert(header.end() - 1, RESERVED_HEADER_LINE);
+            size += RESERVED_HEADER_LINE.size() + 1;
+        }
 
-                    if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+    std::string buffer;
+    buffer.reserve(size);
+    for (const auto& line : header)
+        {
+            buffer += line;
+            buffer += '\n';
+        }
+
+    out.flush();
+    out.clear();
+    if (Rinex_Printer::header_offset(out) != 0)
+        {
+            // The header is in a gzip member of its own, it can only be updated in place
+            if ((size != old_size) || !d_obs_writer->update_header(filename, buffer))
+                {
+                    LOG(WARNING) << "Could not update the header of " << filename << " in place";
+                }
+            out.seekp(0, std::ios_base::end);
+            return;
+        }
+    if (size == old_size)
+        {
+            // Records are always appended to the end of the file, so the
+            // header can be overwritten through another descriptor
+            const int fd = ::open(filename.c_str(), O_WRONLY);
+            if (fd >= 0)
+                {
+                    const ssize_t written = ::pwrite(fd, buffer.data(), buffer.size(), 0);
+                    ::close(fd);
+                    if (written == static_cast<ssize_t>(buffer.size()))
                         {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
+                            out.seekp(0, std::ios_base::end);
+                            return;
                         }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                }
+            LOG(WARNING) << "Could not update the header of " << filename << " in place";
+        }
+
+    // No room left in the header, rewrite the whole file
+    out.seekg(static_cast<std::streamoff>(old_size));
+    const std::string records((std::istreambuf_iterator<char>(out)), std::istreambuf_iterator<char>());
+    out.close();
+    out.open(filename, std::ios::out | std::ios::trunc);
+    out << buffer << records;
+    out.close();
+    out.open(filename, std::ios::out | std::ios::in | std::ios::app);
+    out.seekp(0, std::ios_base::end);
+}
+
+
+void Rinex_Printer::reserve_header_lines(std::fstream& out) const
+{
+    for (int32_t i = 0; i < RESERVED_HEADER_LINES; i++)
+        {
+            out << RESERVED_HEADER_LINE << '\n';
+        }
+}
+
+
+void Rinex_Printer::set_first_obs_time(double rx_time)
+{
+    d_first_obs_rx_time = rx_time;
+    d_first_obs_time = boost::posix_time::not_a_date_time;
+    for (const auto& line_str : Rinex_Printer::read_header(obsFile))
+        {
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
+                {
+                    try
                         {
-                            data.push_back(line_str);
-                            no_more_finds = true;
+                            const boost::gregorian::date day(std::stoi(line_str.substr(0, 6)), std::stoi(line_str.substr(6, 6)), std::stoi(line_str.substr(12, 6)));
+                            const double seconds = std::stod(line_str.substr(30, 13));
+                            d_first_obs_time = boost::posix_time::ptime(day, boost::posix_time::hours(std::stoi(line_str.substr(18, 6))) +
+                                                                                 boost::posix_time::minutes(std::stoi(line_str.substr(24, 6))) +
+                                                                                 boost::posix_time::microseconds(std::llround(seconds * 1e6)));
+                            d_obs_time_system = line_str.substr(43, 8);
                         }
-                    else
+                    catch (const std::exception& e)
                         {
-                            data.push_back(line_str);
+                            LOG(WARNING) << "Could not read the TIME OF FIRST OBS record: " << e.what();
                         }
                 }
-            else
+        }
+    obsFile.seekp(0, std::ios_base::end);
+}
+
+
+boost::posix_time::ptime Rinex_Printer::get_obs_time(double rx_time) const
+{
+    double elapsed = rx_time - d_first_obs_rx_time;
+    if (elapsed < -302400.0)
+        {
+            elapsed += 604800.0;  // week rollover
+        }
+    return d_first_obs_time + boost::posix_time::microseconds(std::llround(elapsed * 1e6));
+}
+
+
+void Rinex_Printer::finalize_obs_header()
+{
+    if (!d_rinex_header_written || !d_obs_logged || d_first_obs_time.is_not_a_date_time())
+        {
+            return;
+        }
+
+    // -------- TIME OF LAST OBS
+    const boost::posix_time::ptime p_last_time = Rinex_Printer::get_obs_time(d_last_obs_rx_time);
+    const std::string timestring = boost::posix_time::to_iso_string(p_last_time);
+    const std::string year(timestring, 0, 4);
+    const std::string month(timestring, 4, 2);
+    const std::string day(timestring, 6, 2);
+    const std::string hour(timestring, 9, 2);
+    const std::string minutes(timestring, 11, 2);
+    const boost::posix_time::time_duration time_of_day = p_last_time.time_of_day();
+    const double seconds = time_of_day.seconds() + static_cast<double>(time_of_day.fractional_seconds()) / static_cast<double>(boost::posix_time::time_duration::ticks_per_second());
+    std::string line;
+    line += Rinex_Printer::rightJustify(year, 6);
+    line += Rinex_Printer::rightJustify(month, 6);
+    line += Rinex_Printer::rightJustify(day, 6);
+    line += Rinex_Printer::rightJustify(hour, 6);
+    line += Rinex_Printer::rightJustify(minutes, 6);
+    line += Rinex_Printer::rightJustify(asString(seconds, 7), 13);
+    line += d_obs_time_system;
+    line += std::string(9, ' ');
+    line += Rinex_Printer::leftJustify("TIME OF LAST OBS", 20);
+    Rinex_Printer::lengthCheck(line);
+
+    const std::vector<std::string> header = Rinex_Printer::read_header(obsFile);
+    std::vector<std::string> data;
+    for (const auto& line_str : header)
+        {
+            if (line_str.find("TIME OF LAST OBS", 59) == std::string::npos)
                 {
                     data.push_back(line_str);
                 }
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
+                {
+                    data.push_back(line);
+                }
         }
+    Rinex_Printer::write_header(obsFile, obsfilename, header, data);
+}
 
-    out.close();
-    out.open(navGlofilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+
+void Rinex_Printer::rotate_files(double rx_time)
+{
+    const boost::posix_time::ptime start_time = Rinex_Printer::get_obs_time(rx_time);
+    Rinex_Printer::close_files();
+
+    std::string base_name = d_base_name;
+    if (base_name != "-")
         {
-            out << data[i] << '\n';
+            // Tell apart the files of each hour or day
+            base_name += "_" + boost::posix_time::to_iso_string(start_time).substr(0, d_rotation_s < 86400 ? 11 : 8);
         }
-    out.close();
-    out.open(navGlofilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC info.\n";
+    Rinex_Printer::open_files(base_name, start_time);
+    d_rinex_header_written = false;
+    d_rinex_header_updated = false;
+    d_obs_logged = false;
+    LOG(INFO) << "RINEX files rotated, new observation file " << obsfilename;
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& utc_model) const
+void Rinex_Printer::update_nav_header(std::fstream& out, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
 {
+    if (glonass_gnav_almanac.i_satellite_freq_channel)
+        {
+        }  // Avoid compiler warning
+
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    for (const auto& line_str : header)
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
                 {
-                    line_aux.clear();
-
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_0G, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_1G, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t_0G), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_0G), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
                 }
             else
                 {
@@ -3946,327 +4171,152 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& gal
                 }
         }
 
-    out.close();
-    out.open(navGalfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
+    Rinex_Printer::write_header(out, navGlofilename, header, data);
+    std::cout << "The RINEX Navigation file header has been updated with UTC info.\n";
+}
+
+
+void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& utc_model) const
+{
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
+    std::vector<std::string> data;
+    std::string line_aux;
+
+    for (const auto& line_str : header)
+        {
+            line_aux.clear();
+
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_0G, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_1G, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t_0G), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_0G), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else
+                {
+                    data.push_back(line_str);
+                }
         }
-    out.close();
-    out.open(navGalfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+
+    Rinex_Printer::write_header(out, navGalfilename, header, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
 
 void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Utc_Model& utc_model, const Gps_Iono& iono, const Gps_Ephemeris& eph) const
 {
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    for (const auto& line_str : header)
+        {
+            line_aux.clear();
 
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (d_version == 2)
-                        {
-                            if (line_str.find("ION ALPHA", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(2, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("ION ALPHA", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("ION BETA", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(2, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("ION BETA", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("DELTA-UTC", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(3, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 18, 2), 19);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 18, 2), 19);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 9);
-                                    if (d_pre_2009_file == false)
-                                        {
-                                            if (eph.WN < 512)
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 9);  // valid from 2019 to 2029
-                                                }
-                                            else
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 9);  // valid from 2009 to 2019
-                                                }
-                                        }
-                                    else
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256), 9);
-                                        }
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("DELTA-UTC: A0,A1,T,W", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                                {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
-
-                    if (d_version == 3)
-                        {
-                            if (line_str.find("GPSA", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPSA");
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                                    line_aux += std::string(7, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("GPSB", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPSB");
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                                    line_aux += std::string(7, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("GPUT", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPUT");
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                                    if (d_pre_2009_file == false)
-                                        {
-                                            if (eph.WN < 512)
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
-                                                }
-                                            else
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
-                                                }
-                                        }
-                                    else
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
-                                        }
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                                {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
-}
-
-
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono) const
-{
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            if (d_version == 2)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
+                    if (line_str.find("ION ALPHA", 59) != std::string::npos)
                         {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
+                            line_aux += std::string(2, ' ');
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                            line_aux += std::string(10, ' ');
+                            line_aux += Rinex_Printer::leftJustify("ION ALPHA", 20);
                             data.push_back(line_aux);
                         }
-                    else if (line_str.find("GPSB", 0) != std::string::npos)
+                    else if (line_str.find("ION BETA", 59) != std::string::npos)
                         {
-                            line_aux += std::string("GPSB");
-                            line_aux += std::string(1, ' ');
+                            line_aux += std::string(2, ' ');
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                            line_aux += std::string(10, ' ');
+                            line_aux += Rinex_Printer::leftJustify("ION BETA", 20);
                             data.push_back(line_aux);
                         }
-                    else if (line_str.find("GPUT", 0) != std::string::npos)
+                    else if (line_str.find("DELTA-UTC", 59) != std::string::npos)
                         {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                            line_aux += std::string(3, ' ');
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 18, 2), 19);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 18, 2), 19);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 9);
+                            if (d_pre_2009_file == false)
+                                {
+                                    if (eph.WN < 512)
+                                        {
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 9);  // valid from 2019 to 2029
+                                        }
+                                    else
+                                        {
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 9);  // valid from 2009 to 2019
+                                        }
+                                }
+                            else
+                                {
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256), 9);
+                                }
+                            line_aux += std::string(1, ' ');
+                            line_aux += Rinex_Printer::leftJustify("DELTA-UTC: A0,A1,T,W", 20);
                             data.push_back(line_aux);
                         }
                     else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
                         {
                             line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
+                            line_aux += std::string(54, ' ');
                             line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
                             data.push_back(line_aux);
                         }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
                     else
                         {
                             data.push_back(line_str);
                         }
                 }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
-}
-
-
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model) const
-{
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            if (d_version == 3)
                 {
-                    line_aux.clear();
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPSA", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                    if (line_str.find("GPSA", 0) != std::string::npos)
                         {
                             line_aux += std::string("GPSA");
                             line_aux += std::string(1, ' ');
@@ -4278,7 +4328,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
                             data.push_back(line_aux);
                         }
-                    else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                    else if (line_str.find("GPSB", 0) != std::string::npos)
                         {
                             line_aux += std::string("GPSB");
                             line_aux += std::string(1, ' ');
@@ -4290,36 +4340,27 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
                             data.push_back(line_aux);
                         }
-
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
                     else if (line_str.find("GPUT", 0) != std::string::npos)
                         {
                             line_aux += std::string("GPUT");
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
                             line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
+                            if (d_pre_2009_file == false)
+                                {
+                                    if (eph.WN < 512)
+                                        {
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
+                                        }
+                                    else
+                                        {
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
+                                        }
+                                }
+                            else
+                                {
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
+                                }
                             line_aux += std::string(10, ' ');
                             line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
                             data.push_back(line_aux);
@@ -4334,158 +4375,72 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
                             data.push_back(line_aux);
                         }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
                     else
                         {
                             data.push_back(line_str);
                         }
                 }
-            else
-                {
-                    data.push_back(line_str);
-                }
         }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+
+    Rinex_Printer::write_header(out, navfilename, header, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Gps_Ephemeris& eph, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model) const
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono) const
 {
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPSB");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
-                            if (d_pre_2009_file == false)
-                                {
-                                    if (eph.WN < 512)
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
-                                        }
-                                    else
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
-                                        }
-                                }
-                            else
-                                {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
-                                }
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+    for (const auto& line_str : header)
+        {
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("GPSB", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("GPUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
                 }
             else
                 {
@@ -4493,121 +4448,215 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_ion
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::write_header(out, navfilename, header, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Gps_Ephemeris& eph, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model) const
 {
-    if (glonass_gnav_almanac.i_satellite_freq_channel)
-        {
-        }  // Avoid compiler warning
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    for (const auto& line_str : header)
+        {
+            line_aux.clear();
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPSA", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("GPUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else
+                {
+                    data.push_back(line_str);
+                }
+        }
 
-    bool no_more_finds = false;
-    std::string line_str;
+    Rinex_Printer::write_header(out, navfilename, header, data);
+    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
+}
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
 
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Gps_Ephemeris& eph, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model) const
+{
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
+    std::vector<std::string> data;
+    std::string line_aux;
 
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
-                            if (d_pre_2009_file == false)
+    for (const auto& line_str : header)
+        {
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
+                    if (d_pre_2009_file == false)
+                        {
+                            if (eph.WN < 512)
                                 {
-                                    if (eph.WN < 512)
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
-                                        }
-                                    else
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
-                                        }
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
                                 }
                             else
                                 {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256), 5);
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
                                 }
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
                         }
                     else
                         {
-                            data.push_back(line_str);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
                         }
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
                 }
             else
                 {
@@ -4615,107 +4664,93 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_ion
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::write_header(out, navMixfilename, header, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Iono& gps_iono, const Gps_CNAV_Utc_Model& gps_utc_model, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Gps_Ephemeris& eph, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
 {
     if (glonass_gnav_almanac.i_satellite_freq_channel)
         {
         }  // Avoid compiler warning
+
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    for (const auto& line_str : header)
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (line_str.find("GPSA", 0) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
+                    if (d_pre_2009_file == false)
                         {
-                            data.push_back(line_str);
-                            no_more_finds = true;
+                            if (eph.WN < 512)
+                                {
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
+                                }
+                            else
+                                {
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
+                                }
                         }
                     else
                         {
-                            data.push_back(line_str);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256), 5);
                         }
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
                 }
             else
                 {
@@ -4723,16 +4758,87 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Iono& gp
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    Rinex_Printer::write_header(out, navMixfilename, header, data);
+    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
+}
+
+
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Iono& gps_iono, const Gps_CNAV_Utc_Model& gps_utc_model, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
+{
+    if (glonass_gnav_almanac.i_satellite_freq_channel)
         {
-            out << data[i] << '\n';
+        }  // Avoid compiler warning
+
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
+    std::vector<std::string> data;
+    std::string line_aux;
+
+    for (const auto& line_str : header)
+        {
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else
+                {
+                    data.push_back(line_str);
+                }
         }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+
+    Rinex_Printer::write_header(out, navMixfilename, header, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -4746,78 +4852,59 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& gal
     if (galileo_utc_model.A_0G > 0.0)
         {
         }
+
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+    for (const auto& line_str : header)
+        {
+            line_aux.clear();
+
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
                 }
             else
                 {
@@ -4825,92 +4912,63 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& gal
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::write_header(out, navMixfilename, header, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
 
 void Rinex_Printer::update_nav_header(std::fstream& out, const Beidou_Dnav_Utc_Model& utc_model, const Beidou_Dnav_Iono& iono) const
 {
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (line_str.find("BDSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("BDSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("BDSB", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("BDSB");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("BDUT", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("BDUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0_UTC, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1_UTC, 15, 2), 16);
-                            line_aux += std::string(22, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+    for (const auto& line_str : header)
+        {
+            line_aux.clear();
+
+            if (line_str.find("BDSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("BDSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("BDSB", 0) != std::string::npos)
+                {
+                    line_aux += std::string("BDSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("BDUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("BDUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0_UTC, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1_UTC, 15, 2), 16);
+                    line_aux += std::string(22, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
                 }
             else
                 {
@@ -4918,16 +4976,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Beidou_Dnav_Utc_M
                 }
         }
 
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::write_header(out, navfilename, header, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -6410,6 +6459,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Glonass_Gnav_Ephem
             out << line << '\n';
         }
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- END OF HEADER
     line.clear();
     line += std::string(60, ' ');
@@ -6786,6 +6838,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
             out << line << '\n';
         }
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -7125,6 +7180,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -7483,6 +7541,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -7759,6 +7820,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8018,6 +8082,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8304,6 +8371,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8693,6 +8763,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9052,6 +9125,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9357,6 +9433,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9689,6 +9768,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9932,6 +10014,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Beidou_Dnav_Epheme
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- Room for records added later
+    Rinex_Printer::reserve_header_lines(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9952,105 +10037,32 @@ void Rinex_Printer::update_obs_header(std::fstream& out __attribute__((unused)),
 
 void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_Utc_Model& utc_model) const
 {
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    for (const auto& line_str : header)
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (d_version == 2)
                 {
-                    line_aux.clear();
-
-                    if (d_version == 2)
+                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)  // TIME OF FIRST OBS last header annotation might change in the future
                         {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)  // TIME OF FIRST OBS last header annotation might change in the future
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
+                            data.push_back(line_str);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                            line_aux += std::string(54, ' ');
+                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                            data.push_back(line_aux);
                         }
-
-                    if (d_version == 3)
+                    else
                         {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
+                            data.push_back(line_str);
                         }
                 }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
-}
-
-
-void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model) const
-{
-    std::vector<std::string> data;
-    std::string line_aux;
 
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            if (d_version == 3)
                 {
-                    line_aux.clear();
                     if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
                         {
                             data.push_back(line_str);
@@ -10062,74 +10074,67 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
                             data.push_back(line_aux);
                         }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
                     else
                         {
                             data.push_back(line_str);
                         }
                 }
+        }
+
+    Rinex_Printer::write_header(out, obsfilename, header, data);
+}
+
+
+void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model) const
+{
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
+    std::vector<std::string> data;
+    std::string line_aux;
+
+    for (const auto& line_str : header)
+        {
+            line_aux.clear();
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
             else
                 {
                     data.push_back(line_str);
                 }
         }
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    Rinex_Printer::write_header(out, obsfilename, header, data);
 }
 
 
 void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model& galileo_utc_model) const
 {
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    for (const auto& line_str : header)
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
                 }
             else
                 {
@@ -10137,58 +10142,30 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model
                 }
         }
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    Rinex_Printer::write_header(out, obsfilename, header, data);
 }
 
 
 void Rinex_Printer::update_obs_header(std::fstream& out, const Beidou_Dnav_Utc_Model& utc_model) const
 {
+    const std::vector<std::string> header = Rinex_Printer::read_header(out);
     std::vector<std::string> data;
     std::string line_aux;
 
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    for (const auto& line_str : header)
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
                 }
             else
                 {
@@ -10196,20 +10173,11 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Beidou_Dnav_Utc_M
                 }
         }
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    Rinex_Printer::write_header(out, obsfilename, header, data);
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& glonass_bands) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Glonass_Gnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& glonass_bands) const
 {
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
@@ -10474,7 +10442,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -10842,7 +10810,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_CNAV_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -11111,7 +11079,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& galileo_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double galileo_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Galileo_Ephemeris& galileo_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double galileo_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -11375,7 +11343,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
@@ -11636,7 +11604,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_CNAV_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
@@ -11767,7 +11735,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, const Gps_CNAV_Ephemeris& eph_cnav, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& eph, const Gps_CNAV_Ephemeris& eph_cnav, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
 {
     if (eph_cnav.i_0 > 0.0)
         {
@@ -12007,7 +11975,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& galileo_bands) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Galileo_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& galileo_bands) const
 {
     // RINEX observations timestamps are Galileo timestamps.
     // See https://gage.upc.edu/sites/default/files/gLAB/HTML/Observation_Rinex_v3.01.html
@@ -12253,7 +12221,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& gps_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -12555,7 +12523,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_CNAV_Ephemeris& eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -12875,7 +12843,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Gps_CNAV_Ephemeris& gps_cnav_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& gps_eph, const Gps_CNAV_Ephemeris& gps_cnav_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -13227,7 +13195,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Beidou_Dnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& bds_bands) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Beidou_Dnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& bds_bands) const
 {
     std::string line;
 
@@ -44,6 +44,8 @@
 #include <fstream>        // for fstream
 #include <iomanip>        // for setprecision
 #include <map>            // for map
+#include <memory>         // for unique_ptr
+#include <ostream>        // for ostream
 #include <sstream>        // for stringstream
 #include <string>         // for string
 #include <unordered_map>  // for unordered_map
@@ -73,6 +75,7 @@ class Gps_Ephemeris;
 class Gps_Iono;
 class Gps_Navigation_Message;
 class Gps_Utc_Model;
+class Rinex_Obs_Writer;
 class Rtklib_Solver;
 
 
@@ -85,13 +88,22 @@ class Rinex_Printer
 public:
     /*!
      * \brief Constructor. Creates GNSS Navigation and Observables RINEX files.
+     * If rotation is "hourly" or "daily", the files are closed and a new set
+     * is started, with its own headers, when the observation time enters a
+     * new hour or day. If compact is true, RINEX 3 observation files are
+     * written in Compact RINEX (Hatanaka) format, and if compression is
+     * "gzip", they are compressed while they are written.
      */
     explicit Rinex_Printer(int version = 0,
         const std::string& base_path = ".",
-        const std::string& base_name = "-");
+        const std::string& base_name = "-",
+        const std::string& rotation = "none",
+        bool compact = false,
+        const std::string& compression = "none");
 
     /*!
-     * \brief Destructor. Removes created files if empty.
+     * \brief Destructor. Writes the TIME OF LAST OBS record, completes the
+     * compressed observation file and removes created files if empty.
      */
     ~Rinex_Printer();
 
@@ -365,7 +377,7 @@ private:
     /*
      * Writes GPS L1 observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables) const;
@@ -373,7 +385,7 @@ private:
     /*
      * Writes GPS L2 observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_CNAV_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables) const;
@@ -381,7 +393,7 @@ private:
     /*
      * Writes dual frequency GPS L1 and L2 observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& eph,
         const Gps_CNAV_Ephemeris& eph_cnav,
         double obs_time,
@@ -392,7 +404,7 @@ private:
      * Writes Galileo observables into the RINEX file.
      * Example: galileo_bands("1B"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Galileo_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
@@ -401,7 +413,7 @@ private:
     /*
      * Writes Mixed GPS / Galileo observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Galileo_Ephemeris& galileo_eph,
         double gps_obs_time,
@@ -410,7 +422,7 @@ private:
     /*
      * Writes Mixed GPS / Galileo observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_CNAV_Ephemeris& eph,
         const Galileo_Ephemeris& galileo_eph,
         double gps_obs_time,
@@ -419,7 +431,7 @@ private:
     /*
      * Writes Mixed GPS / Galileo observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Gps_CNAV_Ephemeris& gps_cnav_eph,
         const Galileo_Ephemeris& galileo_eph,
@@ -431,7 +443,7 @@ private:
      * Writes GLONASS GNAV observables into the RINEX file.
      * Example: glonass_bands("1C"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Glonass_Gnav_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
@@ -440,7 +452,7 @@ private:
     /*
      * Writes Mixed GPS L1 C/A - GLONASS observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double gps_obs_time,
@@ -449,7 +461,7 @@ private:
     /*
      * Writes Mixed GPS L2C - GLONASS observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_CNAV_Ephemeris& gps_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double gps_obs_time,
@@ -458,7 +470,7 @@ private:
     /*
      * Writes Mixed Galileo/GLONASS observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Galileo_Ephemeris& galileo_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double galileo_obs_time,
@@ -467,7 +479,7 @@ private:
     /*
      * Writes BDS B1I observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Beidou_Dnav_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
@@ -786,6 +798,57 @@ private:
     void update_obs_header(std::fstream& out,
         const Beidou_Dnav_Utc_Model& utc_model) const;
 
+    /*
+     * Reads the header lines of a RINEX file, up to END OF HEADER
+     */
+    std::vector<std::string> read_header(std::fstream& out) const;
+
+    /*
+     * Position of the header text in a RINEX file, not 0 if the observation
+     * file is compressed with gzip
+     */
+    std::streamoff header_offset(const std::fstream& out) const;
+
+    /*
+     * Replaces old_header by header. If both take the same number of bytes,
+     * once the reserved COMMENT lines are used up or given back, the header is
+     * overwritten in place and the records are left untouched. Otherwise, the
+     * whole file is rewritten, unless it is compressed with gzip.
+     */
+    void write_header(std::fstream& out,
+        const std::string& filename,
+        const std::vector<std::string>& old_header,
+        std::vector<std::string> header) const;
+
+    /*
+     * Writes the blank COMMENT lines that leave room in the observation header
+     * for the LEAP SECONDS and TIME OF LAST OBS records
+     */
+    void reserve_header_lines(std::fstream& out) const;
+
+    /*
+     * Reads back the TIME OF FIRST OBS record of a new observation file
+     */
+    void set_first_obs_time(double rx_time);
+
+    /*
+     * Observation time of rx_time, from the TIME OF FIRST OBS record
+     */
+    boost::posix_time::ptime get_obs_time(double rx_time) const;
+
+    /*
+     * Adds the TIME OF LAST OBS record to the observation header
+     */
+    void finalize_obs_header();
+
+    void open_files(const std::string& base_name, const boost::posix_time::ptime& start_time = boost::posix_time::not_a_date_time);
+    void close_files();  // Finalizes the observation header, closes the files and removes them if empty
+
+    /*
+     * Closes the current files and opens a new set, named after the time of rx_time
+     */
+    void rotate_files(double rx_time);
+
     /*
      * Generation of RINEX signal strength indicators
      */
@@ -806,8 +869,9 @@ private:
      * "RINEX_FILE_TYPE_GEO_NAV" - SBAS Payload navigation message file.
      * "RINEX_FILE_TYPE_SBAS" - SBAS broadcast data file.
      * "RINEX_FILE_TYPE_CLK" - Clock file.
+     * The name is taken from start_time if given, and from the local time otherwise.
      */
-    std::string createFilename(const std::string& type, const std::string& base_name) const;
+    std::string createFilename(const std::string& type, const std::string& base_name, const boost::posix_time::ptime& start_time = boost::posix_time::not_a_date_time) const;
 
     /*
      * Generates the data for the PGM / RUN BY / DATE line
@@ -997,6 +1061,8 @@ private:
     std::map<std::string, std::string> observationType;  // PSEUDORANGE, CARRIER_PHASE, DOPPLER, SIGNAL_STRENGTH
     std::map<std::string, std::string> observationCode;  // GNSS observation descriptors
 
+    std::unique_ptr<Rinex_Obs_Writer> d_obs_writer;  // Compact RINEX and/or gzip output of the observation file, nullptr for plain RINEX
+
     std::fstream obsFile;     // Output file stream for RINEX observation file
     std::fstream navFile;     // Output file stream for RINEX navigation data file
     std::fstream sbsFile;     // Output file stream for RINEX SBAS raw data file
@@ -1015,12 +1081,21 @@ private:
     std::vector<std::string> output_navfilename;  // Name of output RINEX navigation file(s)
 
     std::string d_stringVersion;  // RINEX version (2.10/2.11 or 3.01/3.02)
+    std::string d_base_path;      // Folder of the RINEX files
+    std::string d_base_name;      // Base name of the RINEX files, "-" for the standard naming convention
+    std::string d_obs_time_system;
+
+    boost::posix_time::ptime d_first_obs_time;  // TIME OF FIRST OBS of the current observation file
 
     double d_fake_cnav_iode;
+    double d_first_obs_rx_time;
+    double d_last_obs_rx_time;
+    int64_t d_rotation_s;           // Length of a file in seconds, 0 if files are not rotated
     int d_version;                  // RINEX version (2 for 2.10/2.11 and 3 for 3.01)
     int d_numberTypesObservations;  // Number of available types of observable in the system. Should be public?
     bool d_rinex_header_updated;
     bool d_rinex_header_written;
+    bool d_obs_logged;
     bool d_pre_2009_file;
 };
 
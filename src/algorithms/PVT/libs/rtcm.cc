@@ -36,8 +36,6 @@
 
 Rtcm::Rtcm(uint16_t port) : RTCM_port(port), server_is_running(false)
 {
-    preamble = std::bitset<8>("11010011");
-    reserved_field = std::bitset<6>("000000");
     rtcm_message_queue = std::make_shared<Concurrent_Queue<std::string>>();
     boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), RTCM_port);
     servers.emplace_back(io_context, endpoint);
@@ -122,23 +120,14 @@ bool Rtcm::is_server_running() const
 //
 // *****************************************************************************************************
 
-std::string Rtcm::add_CRC(const std::string& message_without_crc) const
+std::string Rtcm::publish_frame(const Rtcm_Bit_Writer& frame)
 {
-    // ******  Computes Qualcomm CRC-24Q ******
-    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM;
-    // 1) Converts the string to a vector of uint8_t:
-    boost::dynamic_bitset<uint8_t> frame_bits(message_without_crc);
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
-
-    // 2) Computes CRC
-    CRC_RTCM.process_bytes(bytes.data(), bytes.size());
-    const auto crc_frame = std::bitset<24>(CRC_RTCM.checksum());
-
-    // 3) Builds the complete message
-    const std::string complete_message = message_without_crc + crc_frame.to_string();
-    return bin_to_binary_data(complete_message);
+    std::string msg = frame.to_string();
+    if (server_is_running)
+        {
+            rtcm_message_queue->push(msg);
+        }
+    return msg;
 }
 
 
@@ -396,22 +385,6 @@ int64_t Rtcm::hex_to_int(const std::string& s) const
 }
 
 
-std::string Rtcm::build_message(const std::string& data) const
-{
-    const uint32_t msg_length_bits = data.length();
-    const uint32_t msg_length_bytes = std::ceil(static_cast<float>(msg_length_bits) / 8.0);
-    const auto message_length = std::bitset<10>(msg_length_bytes);
-    const uint32_t zeros_to_fill = 8 * msg_length_bytes - msg_length_bits;
-    const std::string b(zeros_to_fill, '0');
-    const std::string msg_content = data + b;
-    const std::string msg_without_crc = preamble.to_string() +
-                                        reserved_field.to_string() +
-                                        message_length.to_string() +
-                                        msg_content;
-    return Rtcm::add_CRC(msg_without_crc);
-}
-
-
 // *****************************************************************************************************
 //
 //   MESSAGES AS DEFINED AT RTCM STANDARD 10403.2
@@ -425,7 +398,7 @@ std::string Rtcm::build_message(const std::string& data) const
 //
 // ********************************************************
 
-std::bitset<64> Rtcm::get_MT1001_4_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
+void Rtcm::put_MT1001_4_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id, uint32_t smooth_int, bool sync_flag, bool divergence_free)
 {
     const uint32_t reference_station_id = ref_id;  // Max: 4095
@@ -441,20 +414,17 @@ std::bitset<64> Rtcm::get_MT1001_4_header(uint32_t msg_number, double obs_time,
     Rtcm::set_DF007(divergence_free_smoothing_indicator);
     Rtcm::set_DF008(smoothing_interval);
 
-    const std::string header = DF002.to_string() +
-                               DF003.to_string() +
-                               DF004.to_string() +
-                               DF005.to_string() +
-                               DF006.to_string() +
-                               DF007.to_string() +
-                               DF008.to_string();
-
-    std::bitset<64> header_msg(header);
-    return header_msg;
+    d_frame.put(DF002);
+    d_frame.put(DF003);
+    d_frame.put(DF004);
+    d_frame.put(DF005);
+    d_frame.put(DF006);
+    d_frame.put(DF007);
+    d_frame.put(DF008);
 }
 
 
-std::bitset<58> Rtcm::get_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::put_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchro);
@@ -463,18 +433,21 @@ std::bitset<58> Rtcm::get_MT1001_sat_content(const Gps_Ephemeris& eph, double ob
     Rtcm::set_DF012(gnss_synchro);
     Rtcm::set_DF013(eph, obs_time, gnss_synchro);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string();
-
-    std::bitset<58> content_msg(content);
-    return content_msg;
+    d_frame.put(DF009);
+    d_frame.put(DF010);
+    d_frame.put(DF011);
+    d_frame.put(DF012);
+    d_frame.put(DF013);
 }
 
 
 std::string Rtcm::print_MT1001(const Gps_Ephemeris& gps_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1001(gps_eph, obs_time, observables, station_id));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1001(const Gps_Ephemeris& gps_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
 {
     const auto ref_id = static_cast<uint32_t>(station_id);
     uint32_t smooth_int = 0;
@@ -497,23 +470,18 @@ std::string Rtcm::print_MT1001(const Gps_Ephemeris& gps_eph, double obs_time, co
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1001, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    d_frame.start_frame();
+    Rtcm::put_MT1001_4_header(1001, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (observables_iter = observablesL1.cbegin();
          observables_iter != observablesL1.cend();
          observables_iter++)
         {
-            const std::bitset<58> content = Rtcm::get_MT1001_sat_content(gps_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::put_MT1001_sat_content(gps_eph, obs_time, observables_iter->second);
         }
 
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
@@ -524,6 +492,12 @@ std::string Rtcm::print_MT1001(const Gps_Ephemeris& gps_eph, double obs_time, co
 // ********************************************************
 
 std::string Rtcm::print_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1002(gps_eph, obs_time, observables, station_id));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
 {
     const auto ref_id = static_cast<uint32_t>(station_id);
     uint32_t smooth_int = 0;
@@ -546,27 +520,22 @@ std::string Rtcm::print_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, co
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1002, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    d_frame.start_frame();
+    Rtcm::put_MT1001_4_header(1002, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (observables_iter = observablesL1.cbegin();
          observables_iter != observablesL1.cend();
          observables_iter++)
         {
-            const std::bitset<74> content = Rtcm::get_MT1002_sat_content(gps_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::put_MT1002_sat_content(gps_eph, obs_time, observables_iter->second);
         }
 
-    const std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::bitset<74> Rtcm::get_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::put_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchro);
@@ -575,16 +544,13 @@ std::bitset<74> Rtcm::get_MT1002_sat_content(const Gps_Ephemeris& eph, double ob
     Rtcm::set_DF012(gnss_synchro);
     Rtcm::set_DF013(eph, obs_time, gnss_synchro);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string() +
-                                DF014.to_string() +
-                                DF015.to_string();
-
-    std::bitset<74> content_msg(content);
-    return content_msg;
+    d_frame.put(DF009);
+    d_frame.put(DF010);
+    d_frame.put(DF011);
+    d_frame.put(DF012);
+    d_frame.put(DF013);
+    d_frame.put(DF014);
+    d_frame.put(DF015);
 }
 
 
@@ -595,6 +561,12 @@ std::bitset<74> Rtcm::get_MT1002_sat_content(const Gps_Ephemeris& eph, double ob
 // ********************************************************
 
 std::string Rtcm::print_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1003(ephL1, ephL2, obs_time, observables, station_id));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
 {
     const auto ref_id = static_cast<uint32_t>(station_id);
     uint32_t smooth_int = 0;
@@ -649,27 +621,22 @@ std::string Rtcm::print_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1003, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    d_frame.start_frame();
+    Rtcm::put_MT1001_4_header(1003, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (common_observables_iter = common_observables.cbegin();
          common_observables_iter != common_observables.cend();
          common_observables_iter++)
         {
-            std::bitset<101> content = Rtcm::get_MT1003_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::put_MT1003_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
         }
 
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::bitset<101> Rtcm::get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::put_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchroL1);
@@ -682,18 +649,15 @@ std::bitset<101> Rtcm::get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const
     Rtcm::set_DF018(gnss_synchroL1, gnss_synchroL2);
     Rtcm::set_DF019(ephL2, obs_time, gnss_synchroL2);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string() +
-                                DF016_.to_string() +
-                                DF017.to_string() +
-                                DF018.to_string() +
-                                DF019.to_string();
-
-    std::bitset<101> content_msg(content);
-    return content_msg;
+    d_frame.put(DF009);
+    d_frame.put(DF010);
+    d_frame.put(DF011);
+    d_frame.put(DF012);
+    d_frame.put(DF013);
+    d_frame.put(DF016_);
+    d_frame.put(DF017);
+    d_frame.put(DF018);
+    d_frame.put(DF019);
 }
 
 
@@ -704,6 +668,12 @@ std::bitset<101> Rtcm::get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const
 // ******************************************************************
 
 std::string Rtcm::print_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1004(ephL1, ephL2, obs_time, observables, station_id));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
 {
     const auto ref_id = static_cast<uint32_t>(station_id);
     uint32_t smooth_int = 0;
@@ -758,27 +728,22 @@ std::string Rtcm::print_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1004, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    d_frame.start_frame();
+    Rtcm::put_MT1001_4_header(1004, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (common_observables_iter = common_observables.cbegin();
          common_observables_iter != common_observables.cend();
          common_observables_iter++)
         {
-            std::bitset<125> content = Rtcm::get_MT1004_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::put_MT1004_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
         }
 
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::bitset<125> Rtcm::get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::put_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchroL1);
@@ -794,21 +759,18 @@ std::bitset<125> Rtcm::get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const
     Rtcm::set_DF019(ephL2, obs_time, gnss_synchroL2);
     Rtcm::set_DF020(gnss_synchroL2);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string() +
-                                DF014.to_string() +
-                                DF015.to_string() +
-                                DF016_.to_string() +
-                                DF017.to_string() +
-                                DF018.to_string() +
-                                DF019.to_string() +
-                                DF020.to_string();
-
-    std::bitset<125> content_msg(content);
-    return content_msg;
+    d_frame.put(DF009);
+    d_frame.put(DF010);
+    d_frame.put(DF011);
+    d_frame.put(DF012);
+    d_frame.put(DF013);
+    d_frame.put(DF014);
+    d_frame.put(DF015);
+    d_frame.put(DF016_);
+    d_frame.put(DF017);
+    d_frame.put(DF018);
+    d_frame.put(DF019);
+    d_frame.put(DF020);
 }
 
 
@@ -828,7 +790,7 @@ std::bitset<125> Rtcm::get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const
    Expected output: D3 00 13 3E D7 D3 02 02 98 0E DE EF 34 B4 BD 62
                     AC 09 41 98 6F 33 36 0B 98
  */
-std::bitset<152> Rtcm::get_MT1005_test()
+void Rtcm::put_MT1005_test()
 {
     const uint32_t mt1005 = 1005;
     const uint32_t reference_station_id = 2003;  // Max: 4095
@@ -852,26 +814,29 @@ std::bitset<152> Rtcm::get_MT1005_test()
     DF364 = std::bitset<2>("00");  // Quarter Cycle Indicator
     Rtcm::set_DF027(ECEF_Z);
 
-    const std::string message = DF002.to_string() +
-                                DF003.to_string() +
-                                DF021.to_string() +
-                                DF022.to_string() +
-                                DF023.to_string() +
-                                DF024.to_string() +
-                                DF141.to_string() +
-                                DF025.to_string() +
-                                DF142.to_string() +
-                                DF001_.to_string() +
-                                DF026.to_string() +
-                                DF364.to_string() +
-                                DF027.to_string();
-
-    std::bitset<152> test_msg(message);
-    return test_msg;
+    d_frame.put(DF002);
+    d_frame.put(DF003);
+    d_frame.put(DF021);
+    d_frame.put(DF022);
+    d_frame.put(DF023);
+    d_frame.put(DF024);
+    d_frame.put(DF141);
+    d_frame.put(DF025);
+    d_frame.put(DF142);
+    d_frame.put(DF001_);
+    d_frame.put(DF026);
+    d_frame.put(DF364);
+    d_frame.put(DF027);
 }
 
 
 std::string Rtcm::print_MT1005(uint32_t ref_id, double ecef_x, double ecef_y, double ecef_z, bool gps, bool glonass, bool galileo, bool non_physical, bool single_oscillator, uint32_t quarter_cycle_indicator)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1005(ref_id, ecef_x, ecef_y, ecef_z, gps, glonass, galileo, non_physical, single_oscillator, quarter_cycle_indicator));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1005(uint32_t ref_id, double ecef_x, double ecef_y, double ecef_z, bool gps, bool glonass, bool galileo, bool non_physical, bool single_oscillator, uint32_t quarter_cycle_indicator)
 {
     const uint32_t msg_number = 1005;
     std::bitset<1> DF001_;
@@ -890,26 +855,23 @@ std::string Rtcm::print_MT1005(uint32_t ref_id, double ecef_x, double ecef_y, do
     DF364 = std::bitset<2>(quarter_cycle_indicator);
     Rtcm::set_DF027(ecef_z);
 
-    const std::string data = DF002.to_string() +
-                             DF003.to_string() +
-                             DF021.to_string() +
-                             DF022.to_string() +
-                             DF023.to_string() +
-                             DF024.to_string() +
-                             DF141.to_string() +
-                             DF025.to_string() +
-                             DF142.to_string() +
-                             DF001_.to_string() +
-                             DF026.to_string() +
-                             DF364.to_string() +
-                             DF027.to_string();
-
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.start_frame();
+    d_frame.put(DF002);
+    d_frame.put(DF003);
+    d_frame.put(DF021);
+    d_frame.put(DF022);
+    d_frame.put(DF023);
+    d_frame.put(DF024);
+    d_frame.put(DF141);
+    d_frame.put(DF025);
+    d_frame.put(DF142);
+    d_frame.put(DF001_);
+    d_frame.put(DF026);
+    d_frame.put(DF364);
+    d_frame.put(DF027);
+
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
@@ -981,8 +943,10 @@ int32_t Rtcm::read_MT1005(const std::string& message, uint32_t& ref_id, double&
 
 std::string Rtcm::print_MT1005_test()
 {
-    std::bitset<152> mt1005 = get_MT1005_test();
-    return Rtcm::build_message(mt1005.to_string());
+    d_frame.start_frame();
+    Rtcm::put_MT1005_test();
+    d_frame.finish_frame();
+    return d_frame.to_string();
 }
 
 // ********************************************************
@@ -992,6 +956,12 @@ std::string Rtcm::print_MT1005_test()
 // ********************************************************
 
 std::string Rtcm::print_MT1006(uint32_t ref_id, double ecef_x, double ecef_y, double ecef_z, bool gps, bool glonass, bool galileo, bool non_physical, bool single_oscillator, uint32_t quarter_cycle_indicator, double height)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1006(ref_id, ecef_x, ecef_y, ecef_z, gps, glonass, galileo, non_physical, single_oscillator, quarter_cycle_indicator, height));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1006(uint32_t ref_id, double ecef_x, double ecef_y, double ecef_z, bool gps, bool glonass, bool galileo, bool non_physical, bool single_oscillator, uint32_t quarter_cycle_indicator, double height)
 {
     const uint32_t msg_number = 1006;
     std::bitset<1> DF001_;
@@ -1011,27 +981,24 @@ std::string Rtcm::print_MT1006(uint32_t ref_id, double ecef_x, double ecef_y, do
     Rtcm::set_DF027(ecef_z);
     Rtcm::set_DF028(height);
 
-    const std::string data = DF002.to_string() +
-                             DF003.to_string() +
-                             DF021.to_string() +
-                             DF022.to_string() +
-                             DF023.to_string() +
-                             DF024.to_string() +
-                             DF141.to_string() +
-                             DF025.to_string() +
-                             DF142.to_string() +
-                             DF001_.to_string() +
-                             DF026.to_string() +
-                             DF364.to_string() +
-                             DF027.to_string() +
-                             DF028.to_string();
-
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.start_frame();
+    d_frame.put(DF002);
+    d_frame.put(DF003);
+    d_frame.put(DF021);
+    d_frame.put(DF022);
+    d_frame.put(DF023);
+    d_frame.put(DF024);
+    d_frame.put(DF141);
+    d_frame.put(DF025);
+    d_frame.put(DF142);
+    d_frame.put(DF001_);
+    d_frame.put(DF026);
+    d_frame.put(DF364);
+    d_frame.put(DF027);
+    d_frame.put(DF028);
+
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
@@ -1041,6 +1008,12 @@ std::string Rtcm::print_MT1006(uint32_t ref_id, double ecef_x, double ecef_y, do
 //
 // ********************************************************
 std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descriptor, uint32_t antenna_setup_id, const std::string& antenna_serial_number)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1008(ref_id, antenna_descriptor, antenna_setup_id, antenna_serial_number));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1008(uint32_t ref_id, const std::string& antenna_descriptor, uint32_t antenna_setup_id, const std::string& antenna_serial_number)
 {
     const uint32_t msg_number = 1008;
     auto DF002_ = std::bitset<12>(msg_number);
@@ -1054,13 +1027,6 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
         }
     DF029 = std::bitset<8>(len);
 
-    std::string DF030_str_;
-    for (char c : ant_descriptor)
-        {
-            const auto character = std::bitset<8>(c);
-            DF030_str_ += character.to_string();
-        }
-
     Rtcm::set_DF031(antenna_setup_id);
 
     std::string ant_sn(antenna_serial_number);
@@ -1072,27 +1038,23 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
         }
     DF032 = std::bitset<8>(len2);
 
-    std::string DF033_str_;
-    for (char c : ant_sn)
+    d_frame.start_frame();
+    d_frame.put(DF002_);
+    d_frame.put(DF003);
+    d_frame.put(DF029);
+    for (char c : ant_descriptor)
         {
-            const auto character = std::bitset<8>(c);
-            DF033_str_ += character.to_string();
+            d_frame.put(std::bitset<8>(c));  // DF030
         }
-
-    const std::string data = DF002_.to_string() +
-                             DF003.to_string() +
-                             DF029.to_string() +
-                             DF030_str_ +
-                             DF031.to_string() +
-                             DF032.to_string() +
-                             DF033_str_;
-
-    std::string msg = build_message(data);
-    if (server_is_running)
+    d_frame.put(DF031);
+    d_frame.put(DF032);
+    for (char c : ant_sn)
         {
-            rtcm_message_queue->push(msg);
+            d_frame.put(std::bitset<8>(c));  // DF033
         }
-    return msg;
+
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
@@ -1101,7 +1063,7 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
 //   MESSAGE TYPE 1009 (GLONASS L1 Basic RTK Observables)
 //
 // ********************************************************
-std::bitset<61> Rtcm::get_MT1009_12_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
+void Rtcm::put_MT1009_12_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id, uint32_t smooth_int, bool sync_flag, bool divergence_free)
 {
     const uint32_t reference_station_id = ref_id;  // Max: 4095
@@ -1117,20 +1079,17 @@ std::bitset<61> Rtcm::get_MT1009_12_header(uint32_t msg_number, double obs_time,
     Rtcm::set_DF036(divergence_free_smoothing_indicator);
     Rtcm::set_DF037(smoothing_interval);
 
-    const std::string header = DF002.to_string() +
-                               DF003.to_string() +
-                               DF034.to_string() +
-                               DF005.to_string() +
-                               DF035.to_string() +
-                               DF036.to_string() +
-                               DF037.to_string();
-
-    std::bitset<61> header_msg(header);
-    return header_msg;
+    d_frame.put(DF002);
+    d_frame.put(DF003);
+    d_frame.put(DF034);
+    d_frame.put(DF005);
+    d_frame.put(DF035);
+    d_frame.put(DF036);
+    d_frame.put(DF037);
 }
 
 
-std::bitset<64> Rtcm::get_MT1009_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::put_MT1009_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchro);
@@ -1140,19 +1099,22 @@ std::bitset<64> Rtcm::get_MT1009_sat_content(const Glonass_Gnav_Ephemeris& eph,
     Rtcm::set_DF042(gnss_synchro);
     Rtcm::set_DF043(eph, obs_time, gnss_synchro);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string();
-
-    std::bitset<64> content_msg(content);
-    return content_msg;
+    d_frame.put(DF038);
+    d_frame.put(DF039);
+    d_frame.put(DF040);
+    d_frame.put(DF041);
+    d_frame.put(DF042);
+    d_frame.put(DF043);
 }
 
 
 std::string Rtcm::print_MT1009(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1009(glonass_gnav_eph, obs_time, observables, station_id));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1009(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
 {
     const auto ref_id = static_cast<uint32_t>(station_id);
     uint32_t smooth_int = 0;
@@ -1175,23 +1137,18 @@ std::string Rtcm::print_MT1009(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1009, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    d_frame.start_frame();
+    Rtcm::put_MT1009_12_header(1009, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (observables_iter = observablesL1.begin();
          observables_iter != observablesL1.end();
          observables_iter++)
         {
-            const std::bitset<64> content = Rtcm::get_MT1009_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::put_MT1009_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
         }
 
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
@@ -1202,6 +1159,12 @@ std::string Rtcm::print_MT1009(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
 // ********************************************************
 
 std::string Rtcm::print_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1010(glonass_gnav_eph, obs_time, observables, station_id));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
 {
     const auto ref_id = static_cast<uint32_t>(station_id);
     uint32_t smooth_int = 0;
@@ -1224,27 +1187,22 @@ std::string Rtcm::print_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1010, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    d_frame.start_frame();
+    Rtcm::put_MT1009_12_header(1010, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (observables_iter = observablesL1.begin();
          observables_iter != observablesL1.end();
          observables_iter++)
         {
-            const std::bitset<79> content = Rtcm::get_MT1010_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::put_MT1010_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
         }
 
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::bitset<79> Rtcm::get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::put_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchro);
@@ -1256,17 +1214,14 @@ std::bitset<79> Rtcm::get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph,
     Rtcm::set_DF044(gnss_synchro);
     Rtcm::set_DF045(gnss_synchro);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string() +
-                                DF044.to_string() +
-                                DF045.to_string();
-
-    std::bitset<79> content_msg(content);
-    return content_msg;
+    d_frame.put(DF038);
+    d_frame.put(DF039);
+    d_frame.put(DF040);
+    d_frame.put(DF041);
+    d_frame.put(DF042);
+    d_frame.put(DF043);
+    d_frame.put(DF044);
+    d_frame.put(DF045);
 }
 
 
@@ -1277,6 +1232,12 @@ std::bitset<79> Rtcm::get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph,
 // ********************************************************
 
 std::string Rtcm::print_MT1011(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1011(ephL1, ephL2, obs_time, observables, station_id));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1011(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
 {
     const auto ref_id = static_cast<uint32_t>(station_id);
     uint32_t smooth_int = 0;
@@ -1331,27 +1292,22 @@ std::string Rtcm::print_MT1011(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1011, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    d_frame.start_frame();
+    Rtcm::put_MT1009_12_header(1011, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (common_observables_iter = common_observables.begin();
          common_observables_iter != common_observables.end();
          common_observables_iter++)
         {
-            const std::bitset<107> content = Rtcm::get_MT1011_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::put_MT1011_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
         }
 
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::bitset<107> Rtcm::get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::put_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchroL1);
@@ -1365,19 +1321,16 @@ std::bitset<107> Rtcm::get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL
     Rtcm::set_DF048(gnss_synchroL1, gnss_synchroL2);
     Rtcm::set_DF049(ephL2, obs_time, gnss_synchroL2);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string() +
-                                DF046_.to_string() +
-                                DF047.to_string() +
-                                DF048.to_string() +
-                                DF049.to_string();
-
-    std::bitset<107> content_msg(content);
-    return content_msg;
+    d_frame.put(DF038);
+    d_frame.put(DF039);
+    d_frame.put(DF040);
+    d_frame.put(DF041);
+    d_frame.put(DF042);
+    d_frame.put(DF043);
+    d_frame.put(DF046_);
+    d_frame.put(DF047);
+    d_frame.put(DF048);
+    d_frame.put(DF049);
 }
 
 
@@ -1388,6 +1341,12 @@ std::bitset<107> Rtcm::get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL
 // ******************************************************************
 
 std::string Rtcm::print_MT1012(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1012(ephL1, ephL2, obs_time, observables, station_id));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1012(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id)
 {
     const auto ref_id = static_cast<uint32_t>(station_id);
     uint32_t smooth_int = 0;
@@ -1442,27 +1401,22 @@ std::string Rtcm::print_MT1012(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1012, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    d_frame.start_frame();
+    Rtcm::put_MT1009_12_header(1012, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (common_observables_iter = common_observables.begin();
          common_observables_iter != common_observables.end();
          common_observables_iter++)
         {
-            const std::bitset<130> content = Rtcm::get_MT1012_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::put_MT1012_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
         }
 
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::bitset<130> Rtcm::get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::put_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchroL1);
@@ -1479,22 +1433,19 @@ std::bitset<130> Rtcm::get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL
     Rtcm::set_DF049(ephL2, obs_time, gnss_synchroL2);
     Rtcm::set_DF050(gnss_synchroL2);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string() +
-                                DF044.to_string() +
-                                DF045.to_string() +
-                                DF046_.to_string() +
-                                DF047.to_string() +
-                                DF048.to_string() +
-                                DF049.to_string() +
-                                DF050.to_string();
-
-    std::bitset<130> content_msg(content);
-    return content_msg;
+    d_frame.put(DF038);
+    d_frame.put(DF039);
+    d_frame.put(DF040);
+    d_frame.put(DF041);
+    d_frame.put(DF042);
+    d_frame.put(DF043);
+    d_frame.put(DF044);
+    d_frame.put(DF045);
+    d_frame.put(DF046_);
+    d_frame.put(DF047);
+    d_frame.put(DF048);
+    d_frame.put(DF049);
+    d_frame.put(DF050);
 }
 
 
@@ -1505,6 +1456,12 @@ std::bitset<130> Rtcm::get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL
 // ********************************************************
 
 std::string Rtcm::print_MT1019(const Gps_Ephemeris& gps_eph)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1019(gps_eph));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1019(const Gps_Ephemeris& gps_eph)
 {
     const uint32_t msg_number = 1019;
 
@@ -1540,49 +1497,46 @@ std::string Rtcm::print_MT1019(const Gps_Ephemeris& gps_eph)
     Rtcm::set_DF103(gps_eph);
     Rtcm::set_DF137(gps_eph);
 
-    const std::string data = DF002.to_string() +
-                             DF009.to_string() +
-                             DF076.to_string() +
-                             DF077.to_string() +
-                             DF078.to_string() +
-                             DF079.to_string() +
-                             DF071.to_string() +
-                             DF081.to_string() +
-                             DF082.to_string() +
-                             DF083.to_string() +
-                             DF084.to_string() +
-                             DF085.to_string() +
-                             DF086.to_string() +
-                             DF087.to_string() +
-                             DF088.to_string() +
-                             DF089.to_string() +
-                             DF090.to_string() +
-                             DF091.to_string() +
-                             DF092.to_string() +
-                             DF093.to_string() +
-                             DF094.to_string() +
-                             DF095.to_string() +
-                             DF096.to_string() +
-                             DF097.to_string() +
-                             DF098.to_string() +
-                             DF099.to_string() +
-                             DF100.to_string() +
-                             DF101.to_string() +
-                             DF102.to_string() +
-                             DF103.to_string() +
-                             DF137.to_string();
-
-    if (data.length() != 488)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << data.length() << ")";
-        }
-
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.start_frame();
+    d_frame.put(DF002);
+    d_frame.put(DF009);
+    d_frame.put(DF076);
+    d_frame.put(DF077);
+    d_frame.put(DF078);
+    d_frame.put(DF079);
+    d_frame.put(DF071);
+    d_frame.put(DF081);
+    d_frame.put(DF082);
+    d_frame.put(DF083);
+    d_frame.put(DF084);
+    d_frame.put(DF085);
+    d_frame.put(DF086);
+    d_frame.put(DF087);
+    d_frame.put(DF088);
+    d_frame.put(DF089);
+    d_frame.put(DF090);
+    d_frame.put(DF091);
+    d_frame.put(DF092);
+    d_frame.put(DF093);
+    d_frame.put(DF094);
+    d_frame.put(DF095);
+    d_frame.put(DF096);
+    d_frame.put(DF097);
+    d_frame.put(DF098);
+    d_frame.put(DF099);
+    d_frame.put(DF100);
+    d_frame.put(DF101);
+    d_frame.put(DF102);
+    d_frame.put(DF103);
+    d_frame.put(DF137);
+
+    if (d_frame.bit_position() != 488)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << d_frame.bit_position() << ")";
+        }
+
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
@@ -1722,6 +1676,12 @@ int32_t Rtcm::read_MT1019(const std::string& message, Gps_Ephemeris& gps_eph) co
 // ********************************************************
 
 std::string Rtcm::print_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1020(glonass_gnav_eph, glonass_gnav_utc_model));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model)
 {
     const uint32_t msg_number = 1020;
     const uint32_t glonass_gnav_alm_health = 0;
@@ -1765,55 +1725,52 @@ std::string Rtcm::print_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, c
     Rtcm::set_DF135(glonass_gnav_utc_model);
     Rtcm::set_DF136(glonass_gnav_eph);
 
-    const std::string data = DF002.to_string() +
-                             DF038.to_string() +
-                             DF040.to_string() +
-                             DF104.to_string() +
-                             DF105.to_string() +
-                             DF106.to_string() +
-                             DF107.to_string() +
-                             DF108.to_string() +
-                             DF109.to_string() +
-                             DF110.to_string() +
-                             DF111.to_string() +
-                             DF112.to_string() +
-                             DF113.to_string() +
-                             DF114.to_string() +
-                             DF115.to_string() +
-                             DF116.to_string() +
-                             DF117.to_string() +
-                             DF118.to_string() +
-                             DF119.to_string() +
-                             DF120.to_string() +
-                             DF121.to_string() +
-                             DF122.to_string() +
-                             DF123.to_string() +
-                             DF124.to_string() +
-                             DF125.to_string() +
-                             DF126.to_string() +
-                             DF127.to_string() +
-                             DF128.to_string() +
-                             DF129.to_string() +
-                             DF130.to_string() +
-                             DF131.to_string() +
-                             DF132.to_string() +
-                             DF133.to_string() +
-                             DF134.to_string() +
-                             DF135.to_string() +
-                             DF136.to_string() +
-                             std::bitset<7>().to_string();  // Reserved bits
-
-    if (data.length() != 360)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << data.length() << ")";
-        }
-
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.start_frame();
+    d_frame.put(DF002);
+    d_frame.put(DF038);
+    d_frame.put(DF040);
+    d_frame.put(DF104);
+    d_frame.put(DF105);
+    d_frame.put(DF106);
+    d_frame.put(DF107);
+    d_frame.put(DF108);
+    d_frame.put(DF109);
+    d_frame.put(DF110);
+    d_frame.put(DF111);
+    d_frame.put(DF112);
+    d_frame.put(DF113);
+    d_frame.put(DF114);
+    d_frame.put(DF115);
+    d_frame.put(DF116);
+    d_frame.put(DF117);
+    d_frame.put(DF118);
+    d_frame.put(DF119);
+    d_frame.put(DF120);
+    d_frame.put(DF121);
+    d_frame.put(DF122);
+    d_frame.put(DF123);
+    d_frame.put(DF124);
+    d_frame.put(DF125);
+    d_frame.put(DF126);
+    d_frame.put(DF127);
+    d_frame.put(DF128);
+    d_frame.put(DF129);
+    d_frame.put(DF130);
+    d_frame.put(DF131);
+    d_frame.put(DF132);
+    d_frame.put(DF133);
+    d_frame.put(DF134);
+    d_frame.put(DF135);
+    d_frame.put(DF136);
+    d_frame.put(std::bitset<7>());  // Reserved bits
+
+    if (d_frame.bit_position() != 360)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << d_frame.bit_position() << ")";
+        }
+
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
@@ -1985,6 +1942,12 @@ int32_t Rtcm::read_MT1020(const std::string& message, Glonass_Gnav_Ephemeris& gl
 // ********************************************************
 
 std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, double obs_time, const std::string& message)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1029(ref_id, gps_eph, obs_time, message));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, double obs_time, const std::string& message)
 {
     const uint32_t msg_number = 1029;
 
@@ -1995,7 +1958,6 @@ std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, do
 
     uint32_t i = 0;
     bool first = true;
-    std::string text_binary;
     for (char c : message)
         {
             if (isgraph(c) || c == ' ')
@@ -2015,27 +1977,25 @@ std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, do
                             first = false;
                         }
                 }
-            const auto character = std::bitset<8>(c);
-            text_binary += character.to_string();
         }
 
     const auto DF138_ = std::bitset<7>(i);
     const auto DF139_ = std::bitset<8>(message.length());
 
-    const std::string data = DF002.to_string() +
-                             DF003.to_string() +
-                             DF051.to_string() +
-                             DF052.to_string() +
-                             DF138_.to_string() +
-                             DF139_.to_string() +
-                             text_binary;
-
-    std::string msg = build_message(data);
-    if (server_is_running)
+    d_frame.start_frame();
+    d_frame.put(DF002);
+    d_frame.put(DF003);
+    d_frame.put(DF051);
+    d_frame.put(DF052);
+    d_frame.put(DF138_);
+    d_frame.put(DF139_);
+    for (char c : message)
         {
-            rtcm_message_queue->push(msg);
+            d_frame.put(std::bitset<8>(c));  // DF140
         }
-    return msg;
+
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
@@ -2046,6 +2006,12 @@ std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, do
 // ********************************************************
 
 std::string Rtcm::print_MT1045(const Galileo_Ephemeris& gal_eph)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MT1045(gal_eph));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MT1045(const Galileo_Ephemeris& gal_eph)
 {
     const uint32_t msg_number = 1045;
 
@@ -2079,47 +2045,44 @@ std::string Rtcm::print_MT1045(const Galileo_Ephemeris& gal_eph)
     const uint32_t seven_zero = 0;
     const auto DF001_ = std::bitset<7>(seven_zero);
 
-    const std::string data = DF002.to_string() +
-                             DF252.to_string() +
-                             DF289.to_string() +
-                             DF290.to_string() +
-                             DF291.to_string() +
-                             DF292.to_string() +
-                             DF293.to_string() +
-                             DF294.to_string() +
-                             DF295.to_string() +
-                             DF296.to_string() +
-                             DF297.to_string() +
-                             DF298.to_string() +
-                             DF299.to_string() +
-                             DF300.to_string() +
-                             DF301.to_string() +
-                             DF302.to_string() +
-                             DF303.to_string() +
-                             DF304.to_string() +
-                             DF305.to_string() +
-                             DF306.to_string() +
-                             DF307.to_string() +
-                             DF308.to_string() +
-                             DF309.to_string() +
-                             DF310.to_string() +
-                             DF311.to_string() +
-                             DF312.to_string() +
-                             DF314.to_string() +
-                             DF315.to_string() +
-                             DF001_.to_string();
-
-    if (data.length() != 496)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << data.length() << ")";
-        }
-
-    std::string msg = build_message(data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(msg);
-        }
-    return msg;
+    d_frame.start_frame();
+    d_frame.put(DF002);
+    d_frame.put(DF252);
+    d_frame.put(DF289);
+    d_frame.put(DF290);
+    d_frame.put(DF291);
+    d_frame.put(DF292);
+    d_frame.put(DF293);
+    d_frame.put(DF294);
+    d_frame.put(DF295);
+    d_frame.put(DF296);
+    d_frame.put(DF297);
+    d_frame.put(DF298);
+    d_frame.put(DF299);
+    d_frame.put(DF300);
+    d_frame.put(DF301);
+    d_frame.put(DF302);
+    d_frame.put(DF303);
+    d_frame.put(DF304);
+    d_frame.put(DF305);
+    d_frame.put(DF306);
+    d_frame.put(DF307);
+    d_frame.put(DF308);
+    d_frame.put(DF309);
+    d_frame.put(DF310);
+    d_frame.put(DF311);
+    d_frame.put(DF312);
+    d_frame.put(DF314);
+    d_frame.put(DF315);
+    d_frame.put(DF001_);
+
+    if (d_frame.bit_position() != 496)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << d_frame.bit_position() << ")";
+        }
+
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
@@ -2260,6 +2223,23 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
     int32_t smooth_int,
     bool divergence_free,
     bool more_messages)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MSM_1(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, ref_id, clock_steering_indicator, external_clock_indicator, smooth_int, divergence_free, more_messages));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MSM_1(const Gps_Ephemeris& gps_eph,
+    const Gps_CNAV_Ephemeris& gps_cnav_eph,
+    const Galileo_Ephemeris& gal_eph,
+    const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+    double obs_time,
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    uint32_t ref_id,
+    uint32_t clock_steering_indicator,
+    uint32_t external_clock_indicator,
+    int32_t smooth_int,
+    bool divergence_free,
+    bool more_messages)
 {
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
@@ -2288,7 +2268,8 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
             msg_number = 1071;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    d_frame.start_frame();
+    Rtcm::put_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2298,22 +2279,16 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
-
-    const std::string signal_data = Rtcm::get_MSM_1_content_signal_data(observables);
-
-    std::string message = build_message(header + sat_data + signal_data);
+    Rtcm::put_MSM_1_content_sat_data(observables);
 
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(message);
-        }
+    Rtcm::put_MSM_1_content_signal_data(observables);
 
-    return message;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::string Rtcm::get_MSM_header(uint32_t msg_number,
+void Rtcm::put_MSM_header(uint32_t msg_number,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id,
@@ -2340,39 +2315,37 @@ std::string Rtcm::get_MSM_header(uint32_t msg_number,
     Rtcm::set_DF394(observables);
     Rtcm::set_DF395(observables);
 
-    std::string header = DF002.to_string() + DF003.to_string();
+    d_frame.put(DF002);
+    d_frame.put(DF003);
     // GNSS Epoch Time Specific to each constellation
     if ((sys == "R"))
         {
             // GLONASS Epoch Time
             Rtcm::set_DF034(obs_time);
-            header += DF034.to_string();
+            d_frame.put(DF034);
         }
     else
         {
             // GPS, Galileo Epoch Time
             Rtcm::set_DF004(obs_time);
-            header += DF004.to_string();
+            d_frame.put(DF004);
         }
 
-    header = header + DF393.to_string() +
-             DF409.to_string() +
-             DF001_.to_string() +
-             DF411.to_string() +
-             DF417.to_string() +
-             DF412.to_string() +
-             DF418.to_string() +
-             DF394.to_string() +
-             DF395.to_string() +
-             Rtcm::set_DF396(observables);
-
-    return header;
+    d_frame.put(DF393);
+    d_frame.put(DF409);
+    d_frame.put(DF001_);
+    d_frame.put(DF411);
+    d_frame.put(DF417);
+    d_frame.put(DF412);
+    d_frame.put(DF418);
+    d_frame.put(DF394);
+    d_frame.put(DF395);
+    Rtcm::put_DF396(observables);
 }
 
 
-std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::put_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
 
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
@@ -2403,16 +2376,13 @@ std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchr
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            sat_data += DF398.to_string();
+            d_frame.put(DF398);
         }
-
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::put_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2433,10 +2403,8 @@ std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Syn
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
-            signal_data += DF400.to_string();
+            d_frame.put(DF400);
         }
-
-    return signal_data;
 }
 
 
@@ -2458,6 +2426,23 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
     int32_t smooth_int,
     bool divergence_free,
     bool more_messages)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MSM_2(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, ref_id, clock_steering_indicator, external_clock_indicator, smooth_int, divergence_free, more_messages));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MSM_2(const Gps_Ephemeris& gps_eph,
+    const Gps_CNAV_Ephemeris& gps_cnav_eph,
+    const Galileo_Ephemeris& gal_eph,
+    const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+    double obs_time,
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    uint32_t ref_id,
+    uint32_t clock_steering_indicator,
+    uint32_t external_clock_indicator,
+    int32_t smooth_int,
+    bool divergence_free,
+    bool more_messages)
 {
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
@@ -2486,7 +2471,8 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
             msg_number = 1072;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    d_frame.start_frame();
+    Rtcm::put_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2496,31 +2482,22 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
-
-    const std::string signal_data = Rtcm::get_MSM_2_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_1_content_sat_data(observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(message);
-        }
+    Rtcm::put_MSM_2_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    return message;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2539,18 +2516,21 @@ std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written as a block of one field per cell
+    const uint64_t first_data_type = d_frame.bit_position();
+    const uint64_t second_data_type = first_data_type + Ncells * DF401.size();
+    const uint64_t third_data_type = second_data_type + Ncells * DF402.size();
+    d_frame.skip_bits(Ncells * (DF401.size() + DF402.size() + DF420.size()));
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF401.to_string();
-            second_data_type += DF402.to_string();
-            third_data_type += DF420.to_string();
+            d_frame.put_at(first_data_type + cell * DF401.size(), DF401);
+            d_frame.put_at(second_data_type + cell * DF402.size(), DF402);
+            d_frame.put_at(third_data_type + cell * DF420.size(), DF420);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type;
-    return signal_data;
 }
 
 
@@ -2572,6 +2552,23 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
     int32_t smooth_int,
     bool divergence_free,
     bool more_messages)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MSM_3(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, ref_id, clock_steering_indicator, external_clock_indicator, smooth_int, divergence_free, more_messages));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MSM_3(const Gps_Ephemeris& gps_eph,
+    const Gps_CNAV_Ephemeris& gps_cnav_eph,
+    const Galileo_Ephemeris& gal_eph,
+    const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+    double obs_time,
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    uint32_t ref_id,
+    uint32_t clock_steering_indicator,
+    uint32_t external_clock_indicator,
+    int32_t smooth_int,
+    bool divergence_free,
+    bool more_messages)
 {
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
@@ -2600,7 +2597,8 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
             msg_number = 1073;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    d_frame.start_frame();
+    Rtcm::put_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2610,32 +2608,22 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
-
-    const std::string signal_data = Rtcm::get_MSM_3_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_1_content_sat_data(observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(message);
-        }
+    Rtcm::put_MSM_3_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    return message;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2654,20 +2642,24 @@ std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written as a block of one field per cell
+    const uint64_t first_data_type = d_frame.bit_position();
+    const uint64_t second_data_type = first_data_type + Ncells * DF400.size();
+    const uint64_t third_data_type = second_data_type + Ncells * DF401.size();
+    const uint64_t fourth_data_type = third_data_type + Ncells * DF402.size();
+    d_frame.skip_bits(Ncells * (DF400.size() + DF401.size() + DF402.size() + DF420.size()));
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
+            d_frame.put_at(first_data_type + cell * DF400.size(), DF400);
+            d_frame.put_at(second_data_type + cell * DF401.size(), DF401);
+            d_frame.put_at(third_data_type + cell * DF402.size(), DF402);
+            d_frame.put_at(fourth_data_type + cell * DF420.size(), DF420);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return signal_data;
 }
 
 
@@ -2689,6 +2681,23 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
     int32_t smooth_int,
     bool divergence_free,
     bool more_messages)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MSM_4(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, ref_id, clock_steering_indicator, external_clock_indicator, smooth_int, divergence_free, more_messages));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MSM_4(const Gps_Ephemeris& gps_eph,
+    const Gps_CNAV_Ephemeris& gps_cnav_eph,
+    const Galileo_Ephemeris& gal_eph,
+    const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+    double obs_time,
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    uint32_t ref_id,
+    uint32_t clock_steering_indicator,
+    uint32_t external_clock_indicator,
+    int32_t smooth_int,
+    bool divergence_free,
+    bool more_messages)
 {
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
@@ -2717,7 +2726,8 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
             msg_number = 1074;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    d_frame.start_frame();
+    Rtcm::put_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2727,25 +2737,17 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::put_MSM_4_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_4_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_4_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(message);
-        }
-
-    return message;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::put_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
 
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
@@ -2772,31 +2774,28 @@ std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchr
 
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(observables_vector);
 
+    // Each data type is written as a block of one field per satellite
+    const uint64_t first_data_type = d_frame.bit_position();
+    const uint64_t second_data_type = first_data_type + num_satellites * DF397.size();
+    d_frame.skip_bits(num_satellites * (DF397.size() + DF398.size()));
+
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            first_data_type += DF397.to_string();
-            second_data_type += DF398.to_string();
+            d_frame.put_at(first_data_type + nsat * DF397.size(), DF397);
+            d_frame.put_at(second_data_type + nsat * DF398.size(), DF398);
         }
-    sat_data = first_data_type + second_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2815,6 +2814,14 @@ std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written as a block of one field per cell
+    const uint64_t first_data_type = d_frame.bit_position();
+    const uint64_t second_data_type = first_data_type + Ncells * DF400.size();
+    const uint64_t third_data_type = second_data_type + Ncells * DF401.size();
+    const uint64_t fourth_data_type = third_data_type + Ncells * DF402.size();
+    const uint64_t fifth_data_type = fourth_data_type + Ncells * DF420.size();
+    d_frame.skip_bits(Ncells * (DF400.size() + DF401.size() + DF402.size() + DF420.size() + DF403.size()));
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
@@ -2822,15 +2829,12 @@ std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
+            d_frame.put_at(first_data_type + cell * DF400.size(), DF400);
+            d_frame.put_at(second_data_type + cell * DF401.size(), DF401);
+            d_frame.put_at(third_data_type + cell * DF402.size(), DF402);
+            d_frame.put_at(fourth_data_type + cell * DF420.size(), DF420);
+            d_frame.put_at(fifth_data_type + cell * DF403.size(), DF403);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
 }
 
 
@@ -2852,6 +2856,23 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
     int32_t smooth_int,
     bool divergence_free,
     bool more_messages)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MSM_5(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, ref_id, clock_steering_indicator, external_clock_indicator, smooth_int, divergence_free, more_messages));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MSM_5(const Gps_Ephemeris& gps_eph,
+    const Gps_CNAV_Ephemeris& gps_cnav_eph,
+    const Galileo_Ephemeris& gal_eph,
+    const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+    double obs_time,
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    uint32_t ref_id,
+    uint32_t clock_steering_indicator,
+    uint32_t external_clock_indicator,
+    int32_t smooth_int,
+    bool divergence_free,
+    bool more_messages)
 {
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
@@ -2880,7 +2901,8 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
             msg_number = 1075;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    d_frame.start_frame();
+    Rtcm::put_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2890,27 +2912,17 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::put_MSM_5_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_5_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_5_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(message);
-        }
-
-    return message;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::put_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
 
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
@@ -2937,36 +2949,35 @@ std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchr
 
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(observables_vector);
 
+    const auto reserved = std::bitset<4>("0000");
+
+    // Each data type is written as a block of one field per satellite
+    const uint64_t first_data_type = d_frame.bit_position();
+    const uint64_t second_data_type = first_data_type + num_satellites * DF397.size();
+    const uint64_t third_data_type = second_data_type + num_satellites * reserved.size();
+    const uint64_t fourth_data_type = third_data_type + num_satellites * DF398.size();
+    d_frame.skip_bits(num_satellites * (DF397.size() + reserved.size() + DF398.size() + DF399.size()));
+
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF399(ordered_by_PRN_pos.at(nsat).second);
-            auto reserved = std::bitset<4>("0000");
-            first_data_type += DF397.to_string();
-            second_data_type += reserved.to_string();
-            third_data_type += DF398.to_string();
-            fourth_data_type += DF399.to_string();
+            d_frame.put_at(first_data_type + nsat * DF397.size(), DF397);
+            d_frame.put_at(second_data_type + nsat * reserved.size(), reserved);
+            d_frame.put_at(third_data_type + nsat * DF398.size(), DF398);
+            d_frame.put_at(fourth_data_type + nsat * DF399.size(), DF399);
         }
-    sat_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2985,6 +2996,15 @@ std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written as a block of one field per cell
+    const uint64_t first_data_type = d_frame.bit_position();
+    const uint64_t second_data_type = first_data_type + Ncells * DF400.size();
+    const uint64_t third_data_type = second_data_type + Ncells * DF401.size();
+    const uint64_t fourth_data_type = third_data_type + Ncells * DF402.size();
+    const uint64_t fifth_data_type = fourth_data_type + Ncells * DF420.size();
+    const uint64_t sixth_data_type = fifth_data_type + Ncells * DF403.size();
+    d_frame.skip_bits(Ncells * (DF400.size() + DF401.size() + DF402.size() + DF420.size() + DF403.size() + DF404.size()));
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
@@ -2993,16 +3013,13 @@ std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
-            sixth_data_type += DF404.to_string();
+            d_frame.put_at(first_data_type + cell * DF400.size(), DF400);
+            d_frame.put_at(second_data_type + cell * DF401.size(), DF401);
+            d_frame.put_at(third_data_type + cell * DF402.size(), DF402);
+            d_frame.put_at(fourth_data_type + cell * DF420.size(), DF420);
+            d_frame.put_at(fifth_data_type + cell * DF403.size(), DF403);
+            d_frame.put_at(sixth_data_type + cell * DF404.size(), DF404);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
 }
 
 
@@ -3024,6 +3041,23 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
     int32_t smooth_int,
     bool divergence_free,
     bool more_messages)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MSM_6(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, ref_id, clock_steering_indicator, external_clock_indicator, smooth_int, divergence_free, more_messages));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MSM_6(const Gps_Ephemeris& gps_eph,
+    const Gps_CNAV_Ephemeris& gps_cnav_eph,
+    const Galileo_Ephemeris& gal_eph,
+    const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+    double obs_time,
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    uint32_t ref_id,
+    uint32_t clock_steering_indicator,
+    uint32_t external_clock_indicator,
+    int32_t smooth_int,
+    bool divergence_free,
+    bool more_messages)
 {
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
@@ -3052,7 +3086,8 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    d_frame.start_frame();
+    Rtcm::put_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3062,33 +3097,22 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::put_MSM_4_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_6_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_6_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(message);
-        }
-
-    return message;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -3107,6 +3131,14 @@ std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written as a block of one field per cell
+    const uint64_t first_data_type = d_frame.bit_position();
+    const uint64_t second_data_type = first_data_type + Ncells * DF405.size();
+    const uint64_t third_data_type = second_data_type + Ncells * DF406.size();
+    const uint64_t fourth_data_type = third_data_type + Ncells * DF407.size();
+    const uint64_t fifth_data_type = fourth_data_type + Ncells * DF420.size();
+    d_frame.skip_bits(Ncells * (DF405.size() + DF406.size() + DF407.size() + DF420.size() + DF408.size()));
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF405(ordered_by_PRN_pos.at(cell).second);
@@ -3114,15 +3146,12 @@ std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF407(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
+            d_frame.put_at(first_data_type + cell * DF405.size(), DF405);
+            d_frame.put_at(second_data_type + cell * DF406.size(), DF406);
+            d_frame.put_at(third_data_type + cell * DF407.size(), DF407);
+            d_frame.put_at(fourth_data_type + cell * DF420.size(), DF420);
+            d_frame.put_at(fifth_data_type + cell * DF408.size(), DF408);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
 }
 
 
@@ -3144,6 +3173,23 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
     int32_t smooth_int,
     bool divergence_free,
     bool more_messages)
+{
+    return Rtcm::publish_frame(Rtcm::encode_MSM_7(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables, ref_id, clock_steering_indicator, external_clock_indicator, smooth_int, divergence_free, more_messages));
+}
+
+
+const Rtcm_Bit_Writer& Rtcm::encode_MSM_7(const Gps_Ephemeris& gps_eph,
+    const Gps_CNAV_Ephemeris& gps_cnav_eph,
+    const Galileo_Ephemeris& gal_eph,
+    const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+    double obs_time,
+    const std::map<int32_t, Gnss_Synchro>& observables,
+    uint32_t ref_id,
+    uint32_t clock_steering_indicator,
+    uint32_t external_clock_indicator,
+    int32_t smooth_int,
+    bool divergence_free,
+    bool more_messages)
 {
     uint32_t msg_number = 0;
     if (gps_eph.PRN != 0)
@@ -3172,7 +3218,8 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    d_frame.start_frame();
+    Rtcm::put_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3182,34 +3229,22 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::put_MSM_5_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_7_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::put_MSM_7_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
-    if (server_is_running)
-        {
-            rtcm_message_queue->push(message);
-        }
-
-    return message;
+    d_frame.finish_frame();
+    return d_frame;
 }
 
 
-std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::put_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -3228,6 +3263,15 @@ std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written as a block of one field per cell
+    const uint64_t first_data_type = d_frame.bit_position();
+    const uint64_t second_data_type = first_data_type + Ncells * DF405.size();
+    const uint64_t third_data_type = second_data_type + Ncells * DF406.size();
+    const uint64_t fourth_data_type = third_data_type + Ncells * DF407.size();
+    const uint64_t fifth_data_type = fourth_data_type + Ncells * DF420.size();
+    const uint64_t sixth_data_type = fifth_data_type + Ncells * DF408.size();
+    d_frame.skip_bits(Ncells * (DF405.size() + DF406.size() + DF407.size() + DF420.size() + DF408.size() + DF404.size()));
+
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF405(ordered_by_PRN_pos.at(cell).second);
@@ -3236,16 +3280,13 @@ std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
-            sixth_data_type += DF404.to_string();
+            d_frame.put_at(first_data_type + cell * DF405.size(), DF405);
+            d_frame.put_at(second_data_type + cell * DF406.size(), DF406);
+            d_frame.put_at(third_data_type + cell * DF407.size(), DF407);
+            d_frame.put_at(fourth_data_type + cell * DF420.size(), DF420);
+            d_frame.put_at(fifth_data_type + cell * DF408.size(), DF408);
+            d_frame.put_at(sixth_data_type + cell * DF404.size(), DF404);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
 }
 
 // SSR
@@ -3335,19 +3376,22 @@ std::vector<std::string> Rtcm::print_IGM01(const Galileo_HAS_data& has_data)
                 {
                     ssr_multiple_msg_indicator = false;  // last message of a sequence
                 }
-            const std::string header = Rtcm::get_IGM01_header(has_data, sys, ssr_multiple_msg_indicator);
-            const std::string sat_data = Rtcm::get_IGM01_content_sat(has_data, sys);
-            std::string message = build_message(header + sat_data);
-            if (server_is_running)
-                {
-                    rtcm_message_queue->push(message);
-                }
-            msgs.push_back(message);
+            msgs.push_back(Rtcm::publish_frame(Rtcm::encode_IGM01(has_data, sys, ssr_multiple_msg_indicator)));
         }
     return msgs;
 }
 
 
+const Rtcm_Bit_Writer& Rtcm::encode_IGM01(const Galileo_HAS_data& has_data, uint8_t nsys_index, bool ssr_multiple_msg_indicator)
+{
+    d_frame.start_frame();
+    Rtcm::put_IGM01_header(has_data, nsys_index, ssr_multiple_msg_indicator);
+    Rtcm::put_IGM01_content_sat(has_data, nsys_index);
+    d_frame.finish_frame();
+    return d_frame;
+}
+
+
 std::vector<std::string> Rtcm::print_IGM02(const Galileo_HAS_data& has_data)
 {
     std::vector<std::string> msgs;
@@ -3359,19 +3403,22 @@ std::vector<std::string> Rtcm::print_IGM02(const Galileo_HAS_data& has_data)
                 {
                     ssr_multiple_msg_indicator = false;  // last message of a sequence
                 }
-            const std::string header = Rtcm::get_IGM02_header(has_data, sys, ssr_multiple_msg_indicator);
-            const std::string sat_data = Rtcm::get_IGM02_content_sat(has_data, sys);
-            std::string message = build_message(header + sat_data);
-            if (server_is_running)
-                {
-                    rtcm_message_queue->push(message);
-                }
-            msgs.push_back(message);
+            msgs.push_back(Rtcm::publish_frame(Rtcm::encode_IGM02(has_data, sys, ssr_multiple_msg_indicator)));
         }
     return msgs;
 }
 
 
+const Rtcm_Bit_Writer& Rtcm::encode_IGM02(const Galileo_HAS_data& has_data, uint8_t nsys_index, bool ssr_multiple_msg_indicator)
+{
+    d_frame.start_frame();
+    Rtcm::put_IGM02_header(has_data, nsys_index, ssr_multiple_msg_indicator);
+    Rtcm::put_IGM02_content_sat(has_data, nsys_index);
+    d_frame.finish_frame();
+    return d_frame;
+}
+
+
 std::vector<std::string> Rtcm::print_IGM03(const Galileo_HAS_data& has_data)
 {
     std::vector<std::string> msgs;
@@ -3383,19 +3430,22 @@ std::vector<std::string> Rtcm::print_IGM03(const Galileo_HAS_data& has_data)
                 {
                     ssr_multiple_msg_indicator = false;  // last message of a sequence
                 }
-            const std::string header = Rtcm::get_IGM03_header(has_data, sys, ssr_multiple_msg_indicator);
-            const std::string sat_data = Rtcm::get_IGM03_content_sat(has_data, sys);
-            std::string message = build_message(header + sat_data);
-            if (server_is_running)
-                {
-                    rtcm_message_queue->push(message);
-                }
-            msgs.push_back(message);
+            msgs.push_back(Rtcm::publish_frame(Rtcm::encode_IGM03(has_data, sys, ssr_multiple_msg_indicator)));
         }
     return msgs;
 }
 
 
+const Rtcm_Bit_Writer& Rtcm::encode_IGM03(const Galileo_HAS_data& has_data, uint8_t nsys_index, bool ssr_multiple_msg_indicator)
+{
+    d_frame.start_frame();
+    Rtcm::put_IGM03_header(has_data, nsys_index, ssr_multiple_msg_indicator);
+    Rtcm::put_IGM03_content_sat(has_data, nsys_index);
+    d_frame.finish_frame();
+    return d_frame;
+}
+
+
 std::vector<std::string> Rtcm::print_IGM05(const Galileo_HAS_data& has_data)
 {
     std::vector<std::string> msgs;
@@ -3407,26 +3457,32 @@ std::vector<std::string> Rtcm::print_IGM05(const Galileo_HAS_data& has_data)
                 {
                     ssr_multiple_msg_indicator = false;  // last message of a sequence
                 }
-            const std::string header = Rtcm::get_IGM05_header(has_data, sys, ssr_multiple_msg_indicator);
-            const std::string sat_data = Rtcm::get_IGM05_content_sat(has_data, sys);
-            if (!sat_data.empty())
+            const Rtcm_Bit_Writer& frame = Rtcm::encode_IGM05(has_data, sys, ssr_multiple_msg_indicator);
+            if (frame.size() > 0)
                 {
-                    std::string message = build_message(header + sat_data);
-                    if (server_is_running)
-                        {
-                            rtcm_message_queue->push(message);
-                        }
-                    msgs.push_back(message);
+                    msgs.push_back(Rtcm::publish_frame(frame));
                 }
         }
     return msgs;
 }
 
 
-std::string Rtcm::get_IGM01_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator)
+const Rtcm_Bit_Writer& Rtcm::encode_IGM05(const Galileo_HAS_data& has_data, uint8_t nsys_index, bool ssr_multiple_msg_indicator)
 {
-    std::string header;
+    d_frame.start_frame();
+    Rtcm::put_IGM05_header(has_data, nsys_index, ssr_multiple_msg_indicator);
+    const uint64_t header_length = d_frame.bit_position();
+    Rtcm::put_IGM05_content_sat(has_data, nsys_index);
+    if (d_frame.bit_position() > header_length)
+        {
+            d_frame.finish_frame();  // otherwise, there are no biases to send and size() is 0
+        }
+    return d_frame;
+}
+
 
+void Rtcm::put_IGM01_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator)
+{
     uint32_t tow = has_data.tow;
     uint16_t ssr_provider_id = 0;                    // ?
     uint8_t igm_version = 0;                         // ?
@@ -3461,18 +3517,22 @@ std::string Rtcm::get_IGM01_header(const Galileo_HAS_data& has_data, uint8_t nsy
     Rtcm::set_IDF006(regional_indicator);
     Rtcm::set_IDF010(Nsat);
 
-    header += DF002.to_string() + IDF001.to_string() + IDF002.to_string() +
-              IDF003.to_string() + IDF004.to_string() + IDF005.to_string() +
-              IDF007.to_string() + IDF008.to_string() + IDF009.to_string() +
-              IDF006.to_string() + IDF010.to_string();
-    return header;
+    d_frame.put(DF002);
+    d_frame.put(IDF001);
+    d_frame.put(IDF002);
+    d_frame.put(IDF003);
+    d_frame.put(IDF004);
+    d_frame.put(IDF005);
+    d_frame.put(IDF007);
+    d_frame.put(IDF008);
+    d_frame.put(IDF009);
+    d_frame.put(IDF006);
+    d_frame.put(IDF010);
 }
 
 
-std::string Rtcm::get_IGM01_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index)
+void Rtcm::put_IGM01_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index)
 {
-    std::string content;
-
     std::vector<int> prn = has_data.get_PRNs_in_mask(nsys_index);
     std::vector<uint16_t> gnss_iod = has_data.get_gnss_iod(nsys_index);
     std::vector<float> delta_orbit_radial_m = has_data.get_delta_radial_m(nsys_index);
@@ -3491,19 +3551,20 @@ std::string Rtcm::get_IGM01_content_sat(const Galileo_HAS_data& has_data, uint8_
             Rtcm::set_IDF017(0.0);  // dot_orbit_delta_in_track_m_s
             Rtcm::set_IDF018(0.0);  // dot_orbit_delta_cross_track_m_s
 
-            content += IDF011.to_string() + IDF012.to_string() + IDF013.to_string() +
-                       IDF014.to_string() + IDF016.to_string() + IDF015.to_string() +
-                       IDF017.to_string() + IDF018.to_string();
+            d_frame.put(IDF011);
+            d_frame.put(IDF012);
+            d_frame.put(IDF013);
+            d_frame.put(IDF014);
+            d_frame.put(IDF016);
+            d_frame.put(IDF015);
+            d_frame.put(IDF017);
+            d_frame.put(IDF018);
         }
-
-    return content;
 }
 
 
-std::string Rtcm::get_IGM02_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator)
+void Rtcm::put_IGM02_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator)
 {
-    std::string header;
-
     uint32_t tow = has_data.tow;
     uint16_t ssr_provider_id = 0;                    // ?
     uint8_t igm_version = 0;                         // ?
@@ -3536,18 +3597,21 @@ std::string Rtcm::get_IGM02_header(const Galileo_HAS_data& has_data, uint8_t nsy
     Rtcm::set_IDF009(ssr_solution_id);
     Rtcm::set_IDF010(Nsat);
 
-    header += DF002.to_string() + IDF001.to_string() + IDF002.to_string() +
-              IDF003.to_string() + IDF004.to_string() + IDF005.to_string() +
-              IDF007.to_string() + IDF008.to_string() + IDF009.to_string() +
-              IDF010.to_string();
-    return header;
+    d_frame.put(DF002);
+    d_frame.put(IDF001);
+    d_frame.put(IDF002);
+    d_frame.put(IDF003);
+    d_frame.put(IDF004);
+    d_frame.put(IDF005);
+    d_frame.put(IDF007);
+    d_frame.put(IDF008);
+    d_frame.put(IDF009);
+    d_frame.put(IDF010);
 }
 
 
-std::string Rtcm::get_IGM02_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index)
+void Rtcm::put_IGM02_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index)
 {
-    std::string content;
-
     const uint8_t num_sats_in_this_system = has_data.get_num_satellites()[nsys_index];
 
     std::vector<int> prn = has_data.get_PRNs_in_mask(nsys_index);
@@ -3563,18 +3627,16 @@ std::string Rtcm::get_IGM02_content_sat(const Galileo_HAS_data& has_data, uint8_
             Rtcm::set_IDF020(delta_clock_c1[sat]);
             Rtcm::set_IDF021(delta_clock_c2[sat]);
 
-            content += IDF011.to_string() + IDF019.to_string() + IDF020.to_string() +
-                       IDF021.to_string();
+            d_frame.put(IDF011);
+            d_frame.put(IDF019);
+            d_frame.put(IDF020);
+            d_frame.put(IDF021);
         }
-
-    return content;
 }
 
 
-std::string Rtcm::get_IGM03_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator)
+void Rtcm::put_IGM03_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator)
 {
-    std::string header;
-
     uint32_t tow = has_data.tow;
     uint16_t ssr_provider_id = 0;                    // ?
     uint8_t igm_version = 0;                         // ?
@@ -3609,18 +3671,22 @@ std::string Rtcm::get_IGM03_header(const Galileo_HAS_data& has_data, uint8_t nsy
     Rtcm::set_IDF006(regional_indicator);
     Rtcm::set_IDF010(Nsat);
 
-    header += DF002.to_string() + IDF001.to_string() + IDF002.to_string() +
-              IDF003.to_string() + IDF004.to_string() + IDF005.to_string() +
-              IDF007.to_string() + IDF008.to_string() + IDF009.to_string() +
-              IDF006.to_string() + IDF010.to_string();
-    return header;
+    d_frame.put(DF002);
+    d_frame.put(IDF001);
+    d_frame.put(IDF002);
+    d_frame.put(IDF003);
+    d_frame.put(IDF004);
+    d_frame.put(IDF005);
+    d_frame.put(IDF007);
+    d_frame.put(IDF008);
+    d_frame.put(IDF009);
+    d_frame.put(IDF006);
+    d_frame.put(IDF010);
 }
 
 
-std::string Rtcm::get_IGM03_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index)
+void Rtcm::put_IGM03_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index)
 {
-    std::string content;
-
     const uint8_t num_sats_in_this_system = has_data.get_num_satellites()[nsys_index];
 
     std::vector<int> prn = has_data.get_PRNs_in_mask(nsys_index);
@@ -3646,20 +3712,23 @@ std::string Rtcm::get_IGM03_content_sat(const Galileo_HAS_data& has_data, uint8_
             Rtcm::set_IDF020(delta_clock_c1[sat]);
             Rtcm::set_IDF021(delta_clock_c2[sat]);
 
-            content += IDF011.to_string() + IDF012.to_string() + IDF013.to_string() +
-                       IDF014.to_string() + IDF015.to_string() + IDF016.to_string() +
-                       IDF017.to_string() + IDF018.to_string() + DF019.to_string() +
-                       IDF020.to_string() + IDF021.to_string();
+            d_frame.put(IDF011);
+            d_frame.put(IDF012);
+            d_frame.put(IDF013);
+            d_frame.put(IDF014);
+            d_frame.put(IDF015);
+            d_frame.put(IDF016);
+            d_frame.put(IDF017);
+            d_frame.put(IDF018);
+            d_frame.put(DF019);
+            d_frame.put(IDF020);
+            d_frame.put(IDF021);
         }
-
-    return content;
 }
 
 
-std::string Rtcm::get_IGM05_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator)
+void Rtcm::put_IGM05_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator)
 {
-    std::string header;
-
     uint32_t tow = has_data.tow;
     uint16_t ssr_provider_id = 0;                    // ?
     uint8_t igm_version = 0;                         // ?
@@ -3692,18 +3761,21 @@ std::string Rtcm::get_IGM05_header(const Galileo_HAS_data& has_data, uint8_t nsy
     Rtcm::set_IDF009(ssr_solution_id);
     Rtcm::set_IDF010(Nsat);
 
-    header += DF002.to_string() + IDF001.to_string() + IDF002.to_string() +
-              IDF003.to_string() + IDF004.to_string() + IDF005.to_string() +
-              IDF007.to_string() + IDF008.to_string() + IDF009.to_string() +
-              IDF010.to_string();
-    return header;
+    d_frame.put(DF002);
+    d_frame.put(IDF001);
+    d_frame.put(IDF002);
+    d_frame.put(IDF003);
+    d_frame.put(IDF004);
+    d_frame.put(IDF005);
+    d_frame.put(IDF007);
+    d_frame.put(IDF008);
+    d_frame.put(IDF009);
+    d_frame.put(IDF010);
 }
 
 
-std::string Rtcm::get_IGM05_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index)
+void Rtcm::put_IGM05_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index)
 {
-    std::string content;
-
     const uint8_t num_sats_in_this_system = has_data.get_num_satellites()[nsys_index];
     std::vector<int> prn = has_data.get_PRNs_in_mask(nsys_index);
     std::vector<std::vector<float>> code_bias_m = has_data.get_code_bias_m();
@@ -3837,7 +3909,8 @@ std::string Rtcm::get_IGM05_content_sat(const Galileo_HAS_data& has_data, uint8_
                     Rtcm::set_IDF011(static_cast<uint8_t>(prn[sat]));
                     Rtcm::set_IDF023(valid_num_bias_processed);
 
-                    content += IDF011.to_string() + IDF023.to_string();
+                    d_frame.put(IDF011);
+                    d_frame.put(IDF023);
 
                     uint8_t num_sats_in_previous_systems = 0;
                     for (uint8_t nsys = 0; nsys < nsys_index; nsys++)
@@ -3852,13 +3925,12 @@ std::string Rtcm::get_IGM05_content_sat(const Galileo_HAS_data& has_data, uint8_
                                 {
                                     Rtcm::set_IDF024(gnss_signal_tracking_mode_id_v[code]);
                                     Rtcm::set_IDF025(code_bias_m[sat_index][code]);
-                                    content += DF024.to_string() + IDF025.to_string();
+                                    d_frame.put(DF024);
+                                    d_frame.put(IDF025);
                                 }
                         }
                 }
         }
-
-    return content;
 }
 
 
@@ -5751,9 +5823,8 @@ int32_t Rtcm::set_DF395(const std::map<int32_t, Gnss_Synchro>& gnss_synchro)
 }
 
 
-std::string Rtcm::set_DF396(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::put_DF396(const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string DF396;
     std::map<int32_t, Gnss_Synchro>::const_iterator observables_iter;
     Rtcm::set_DF394(observables);
     Rtcm::set_DF395(observables);
@@ -5762,8 +5833,7 @@ std::string Rtcm::set_DF396(const std::map<int32_t, Gnss_Synchro>& observables)
 
     if ((num_signals == 0) || (num_satellites == 0))
         {
-            std::string s("");
-            return s;
+            return;
         }
     std::vector<std::vector<bool>> matrix(num_signals, std::vector<bool>());
 
@@ -5868,24 +5938,13 @@ std::string Rtcm::set_DF396(const std::map<int32_t, Gnss_Synchro>& observables)
         }
 
     // write the matrix column-wise
-    DF396.clear();
     for (uint32_t col = 0; col < num_satellites; col++)
         {
             for (uint32_t row = 0; row < num_signals; row++)
                 {
-                    std::string ss;
-                    if (matrix[row].at(col))
-                        {
-                            ss = "1";
-                        }
-                    else
-                        {
-                            ss = "0";
-                        }
-                    DF396 += ss;
+                    d_frame.put_bits(matrix[row].at(col) ? 1 : 0, 1);
                 }
         }
-    return DF396;
 }
 
 
@@ -27,6 +27,7 @@
 #include "gnss_synchro.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_ephemeris.h"
+#include "rtcm_bit_writer.h"
 #include <boost/asio.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <glog/logging.h>
@@ -358,6 +359,122 @@ public:
      */
     std::vector<std::string> print_IGM05(const Galileo_HAS_data& has_data);
 
+    /*!
+     * \brief Encode the same messages as the print_* methods into a byte buffer
+     * owned by this object, without building intermediate strings and without
+     * sending them to the TCP/IP server. The returned frame, including the
+     * CRC-24Q parity, is valid until the next call to an encode_* or print_*
+     * method. The print_* methods are thin wrappers around these ones.
+     */
+    const Rtcm_Bit_Writer& encode_MT1001(const Gps_Ephemeris& gps_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id);
+    const Rtcm_Bit_Writer& encode_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id);
+    const Rtcm_Bit_Writer& encode_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id);
+    const Rtcm_Bit_Writer& encode_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id);
+    const Rtcm_Bit_Writer& encode_MT1005(uint32_t ref_id, double ecef_x, double ecef_y, double ecef_z, bool gps, bool glonass, bool galileo, bool non_physical, bool single_oscillator, uint32_t quarter_cycle_indicator);
+    const Rtcm_Bit_Writer& encode_MT1006(uint32_t ref_id, double ecef_x, double ecef_y, double ecef_z, bool gps, bool glonass, bool galileo, bool non_physical, bool single_oscillator, uint32_t quarter_cycle_indicator, double height);
+    const Rtcm_Bit_Writer& encode_MT1008(uint32_t ref_id, const std::string& antenna_descriptor, uint32_t antenna_setup_id, const std::string& antenna_serial_number);
+    const Rtcm_Bit_Writer& encode_MT1009(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id);
+    const Rtcm_Bit_Writer& encode_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id);
+    const Rtcm_Bit_Writer& encode_MT1011(const Glonass_Gnav_Ephemeris& glonass_gnav_ephL1, const Glonass_Gnav_Ephemeris& glonass_gnav_ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id);
+    const Rtcm_Bit_Writer& encode_MT1012(const Glonass_Gnav_Ephemeris& glonass_gnav_ephL1, const Glonass_Gnav_Ephemeris& glonass_gnav_ephL2, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, uint16_t station_id);
+    const Rtcm_Bit_Writer& encode_MT1019(const Gps_Ephemeris& gps_eph);
+    const Rtcm_Bit_Writer& encode_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model);
+    const Rtcm_Bit_Writer& encode_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, double obs_time, const std::string& message);
+    const Rtcm_Bit_Writer& encode_MT1045(const Galileo_Ephemeris& gal_eph);
+    const Rtcm_Bit_Writer& encode_MSM_1(const Gps_Ephemeris& gps_eph,
+        const Gps_CNAV_Ephemeris& gps_cnav_eph,
+        const Galileo_Ephemeris& gal_eph,
+        const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+        double obs_time,
+        const std::map<int32_t, Gnss_Synchro>& observables,
+        uint32_t ref_id,
+        uint32_t clock_steering_indicator,
+        uint32_t external_clock_indicator,
+        int32_t smooth_int,
+        bool divergence_free,
+        bool more_messages);
+    const Rtcm_Bit_Writer& encode_MSM_2(const Gps_Ephemeris& gps_eph,
+        const Gps_CNAV_Ephemeris& gps_cnav_eph,
+        const Galileo_Ephemeris& gal_eph,
+        const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+        double obs_time,
+        const std::map<int32_t, Gnss_Synchro>& observables,
+        uint32_t ref_id,
+        uint32_t clock_steering_indicator,
+        uint32_t external_clock_indicator,
+        int32_t smooth_int,
+        bool divergence_free,
+        bool more_messages);
+    const Rtcm_Bit_Writer& encode_MSM_3(const Gps_Ephemeris& gps_eph,
+        const Gps_CNAV_Ephemeris& gps_cnav_eph,
+        const Galileo_Ephemeris& gal_eph,
+        const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+        double obs_time,
+        const std::map<int32_t, Gnss_Synchro>& observables,
+        uint32_t ref_id,
+        uint32_t clock_steering_indicator,
+        uint32_t external_clock_indicator,
+        int32_t smooth_int,
+        bool divergence_free,
+        bool more_messages);
+    const Rtcm_Bit_Writer& encode_MSM_4(const Gps_Ephemeris& gps_eph,
+        const Gps_CNAV_Ephemeris& gps_cnav_eph,
+        const Galileo_Ephemeris& gal_eph,
+        const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+        double obs_time,
+        const std::map<int32_t, Gnss_Synchro>& observables,
+        uint32_t ref_id,
+        uint32_t clock_steering_indicator,
+        uint32_t external_clock_indicator,
+        int32_t smooth_int,
+        bool divergence_free,
+        bool more_messages);
+    const Rtcm_Bit_Writer& encode_MSM_5(const Gps_Ephemeris& gps_eph,
+        const Gps_CNAV_Ephemeris& gps_cnav_eph,
+        const Galileo_Ephemeris& gal_eph,
+        const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+        double obs_time,
+        const std::map<int32_t, Gnss_Synchro>& observables,
+        uint32_t ref_id,
+        uint32_t clock_steering_indicator,
+        uint32_t external_clock_indicator,
+        int32_t smooth_int,
+        bool divergence_free,
+        bool more_messages);
+    const Rtcm_Bit_Writer& encode_MSM_6(const Gps_Ephemeris& gps_eph,
+        const Gps_CNAV_Ephemeris& gps_cnav_eph,
+        const Galileo_Ephemeris& gal_eph,
+        const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+        double obs_time,
+        const std::map<int32_t, Gnss_Synchro>& observables,
+        uint32_t ref_id,
+        uint32_t clock_steering_indicator,
+        uint32_t external_clock_indicator,
+        int32_t smooth_int,
+        bool divergence_free,
+        bool more_messages);
+    const Rtcm_Bit_Writer& encode_MSM_7(const Gps_Ephemeris& gps_eph,
+        const Gps_CNAV_Ephemeris& gps_cnav_eph,
+        const Galileo_Ephemeris& gal_eph,
+        const Glonass_Gnav_Ephemeris& glo_gnav_eph,
+        double obs_time,
+        const std::map<int32_t, Gnss_Synchro>& observables,
+        uint32_t ref_id,
+        uint32_t clock_steering_indicator,
+        uint32_t external_clock_indicator,
+        int32_t smooth_int,
+        bool divergence_free,
+        bool more_messages);
+
+    /*!
+     * \brief Encode the IGM message of the nsys_index-th system in has_data.
+     * For IGM05, size() of the returned frame is 0 if there are no biases to send.
+     */
+    const Rtcm_Bit_Writer& encode_IGM01(const Galileo_HAS_data& has_data, uint8_t nsys_index, bool ssr_multiple_msg_indicator);
+    const Rtcm_Bit_Writer& encode_IGM02(const Galileo_HAS_data& has_data, uint8_t nsys_index, bool ssr_multiple_msg_indicator);
+    const Rtcm_Bit_Writer& encode_IGM03(const Galileo_HAS_data& has_data, uint8_t nsys_index, bool ssr_multiple_msg_indicator);
+    const Rtcm_Bit_Writer& encode_IGM05(const Galileo_HAS_data& has_data, uint8_t nsys_index, bool ssr_multiple_msg_indicator);
+
     uint32_t lock_time(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);       //!< Returns the time period in which GPS L1 signals have been continually tracked.
     uint32_t lock_time(const Gps_CNAV_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);  //!< Returns the time period in which GPS L2 signals have been continually tracked.
     uint32_t lock_time(const Galileo_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);   //!< Returns the time period in which Galileo signals have been continually tracked.
@@ -397,7 +514,7 @@ private:
     //
     // Generation of messages content
     //
-    std::bitset<64> get_MT1001_4_header(uint32_t msg_number,
+    void put_MT1001_4_header(uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -405,12 +522,12 @@ private:
         bool sync_flag,
         bool divergence_free);
 
-    std::bitset<58> get_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
-    std::bitset<74> get_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
-    std::bitset<101> get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
-    std::bitset<125> get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void put_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void put_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void put_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void put_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
 
-    std::bitset<152> get_MT1005_test();
+    void put_MT1005_test();
 
     /*!
      * \brief Generates contents of message header for types 1009, 1010, 1011 and 1012. GLONASS RTK Message
@@ -421,9 +538,8 @@ private:
      * \param ref_id
      * \param smooth_int
      * \param divergence_free
-     * \return Returns the message header content as set of bits
      */
-    std::bitset<61> get_MT1009_12_header(uint32_t msg_number,
+    void put_MT1009_12_header(uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -432,27 +548,25 @@ private:
         bool divergence_free);
 
     /*!
-     * \brief Get the contents of the satellite specific portion of a type 1009 Message (GLONASS Basic RTK, L1 Only)
+     * \brief Writes the contents of the satellite specific portion of a type 1009 Message (GLONASS Basic RTK, L1 Only)
      * \details Contents generated for each satellite. See table 3.5-11
      * \note Code added as part of GSoC 2017 program
      * \param ephGNAV Ephemeris for GLONASS GNAV in L1 satellites
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchro Information generated by channels while processing the satellite
-     * \return Returns the message content as set of bits
      */
-    std::bitset<64> get_MT1009_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void put_MT1009_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
     /*!
-     * \brief Get the contents of the satellite specific portion of a type 1010 Message (GLONASS Extended RTK, L1 Only)
+     * \brief Writes the contents of the satellite specific portion of a type 1010 Message (GLONASS Extended RTK, L1 Only)
      * \details Contents generated for each satellite. See table 3.5-12
      * \note Code added as part of GSoC 2017 program
      * \param ephGNAV Ephemeris for GLONASS GNAV in L1 satellites
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchro Information generated by channels while processing the satellite
-     * \return Returns the message content as set of bits
      */
-    std::bitset<79> get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void put_MT1010_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
     /*!
-     * \brief Get the contents of the satellite specific portion of a type 1011 Message (GLONASS Basic RTK, L1 & L2)
+     * \brief Writes the contents of the satellite specific portion of a type 1011 Message (GLONASS Basic RTK, L1 & L2)
      * \details Contents generated for each satellite. See table 3.5-13
      * \note Code added as part of GSoC 2017 program
      * \param ephGNAVL1 Ephemeris for GLONASS GNAV in L1 satellites
@@ -460,11 +574,10 @@ private:
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchroL1 Information generated by channels while processing the GLONASS GNAV L1 satellite
      * \param gnss_synchroL2 Information generated by channels while processing the GLONASS GNAV L2 satellite
-     * \return Returns the message content as set of bits
      */
-    std::bitset<107> get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void put_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
     /*!
-     * \brief Get the contents of the satellite specific portion of a type 1012 Message (GLONASS Extended RTK, L1 & L2)
+     * \brief Writes the contents of the satellite specific portion of a type 1012 Message (GLONASS Extended RTK, L1 & L2)
      * \details Contents generated for each satellite. See table 3.5-14
      * \note Code added as part of GSoC 2017 program
      * \param ephGNAVL1 Ephemeris for GLONASS GNAV in L1 satellites
@@ -472,11 +585,10 @@ private:
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchroL1 Information generated by channels while processing the GLONASS GNAV L1 satellite
      * \param gnss_synchroL2 Information generated by channels while processing the GLONASS GNAV L2 satellite
-     * \return Returns the message content as set of bits
      */
-    std::bitset<130> get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void put_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
 
-    std::string get_MSM_header(uint32_t msg_number,
+    void put_MSM_header(uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -486,26 +598,26 @@ private:
         bool divergence_free,
         bool more_messages);
 
-    std::string get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-
-    std::string get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-
-    std::string get_IGM01_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator);
-    std::string get_IGM01_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index);
-    std::string get_IGM02_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator);
-    std::string get_IGM02_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index);
-    std::string get_IGM03_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator);
-    std::string get_IGM03_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index);
-    std::string get_IGM05_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator);
-    std::string get_IGM05_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index);
+    void put_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+
+    void put_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+
+    void put_IGM01_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator);
+    void put_IGM01_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index);
+    void put_IGM02_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator);
+    void put_IGM02_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index);
+    void put_IGM03_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator);
+    void put_IGM03_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index);
+    void put_IGM05_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator);
+    void put_IGM05_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index);
 
     //
     // Utilities
@@ -999,10 +1111,8 @@ private:
     //
     // Transport Layer
     //
-    std::bitset<8> preamble;
-    std::bitset<6> reserved_field;
-    std::string add_CRC(const std::string& m) const;
-    std::string build_message(const std::string& data) const;  // adds 0s to complete a byte and adds the CRC
+    Rtcm_Bit_Writer d_frame;
+    std::string publish_frame(const Rtcm_Bit_Writer& frame);  // returns the frame as a string and sends it to the server, if running
 
     //
     // Data Fields
@@ -1455,7 +1565,7 @@ private:
     std::bitset<32> DF395;
     int32_t set_DF395(const std::map<int32_t, Gnss_Synchro>& gnss_synchro);
 
-    std::string set_DF396(const std::map<int32_t, Gnss_Synchro>& observables);
+    void put_DF396(const std::map<int32_t, Gnss_Synchro>& observables);
 
     std::bitset<8> DF397;
     int32_t set_DF397(const Gnss_Synchro& gnss_synchro);
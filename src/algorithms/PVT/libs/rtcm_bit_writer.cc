@@ -0,0 +1,144 @@
+/*!
+ * \file rtcm_bit_writer.cc
+ * \brief Implementation of a class that packs RTCM 3 frames bit by bit into
+ * a preallocated byte buffer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtcm_bit_writer.h"
+#include <algorithm>  // for std::fill, std::min
+#include <array>
+
+
+namespace
+{
+constexpr uint32_t CRC24Q_POLY = 0x1864CFBU;
+constexpr uint8_t RTCM_PREAMBLE = 0xD3;
+
+
+std::array<uint32_t, 256> make_crc24q_table()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i << 16;
+            for (int bit = 0; bit < 8; bit++)
+                {
+                    crc <<= 1;
+                    if (crc & 0x1000000U)
+                        {
+                            crc ^= CRC24Q_POLY;
+                        }
+                }
+            table[i] = crc & 0xFFFFFFU;
+        }
+    return table;
+}
+}  // namespace
+
+
+Rtcm_Bit_Writer::Rtcm_Bit_Writer()
+    : d_buffer(MAX_FRAME_BYTES, 0),
+      d_bit_pos(HEADER_BITS),
+      d_frame_size(0)
+{
+}
+
+
+void Rtcm_Bit_Writer::start_frame()
+{
+    std::fill(d_buffer.begin(), d_buffer.begin() + HEADER_BITS / 8, 0);
+    d_bit_pos = HEADER_BITS;
+    d_frame_size = 0;
+}
+
+
+void Rtcm_Bit_Writer::reserve_bits(uint64_t n)
+{
+    // Bytes are zeroed the first time they are touched in the current frame
+    const size_t used_bytes = (d_bit_pos + 7) / 8;
+    const size_t needed_bytes = (d_bit_pos + n + 7) / 8;
+    if (needed_bytes + CRC_BYTES > d_buffer.size())
+        {
+            d_buffer.resize(needed_bytes + CRC_BYTES);
+        }
+    if (needed_bytes > used_bytes)
+        {
+            std::fill(d_buffer.begin() + used_bytes, d_buffer.begin() + needed_bytes, 0);
+        }
+}
+
+
+void Rtcm_Bit_Writer::put_bits(uint64_t value, uint32_t n)
+{
+    reserve_bits(n);
+    const uint64_t position = d_bit_pos;
+    d_bit_pos += n;
+    put_bits_at(position - HEADER_BITS, value, n);
+}
+
+
+void Rtcm_Bit_Writer::skip_bits(uint64_t n)
+{
+    reserve_bits(n);
+    d_bit_pos += n;
+}
+
+
+void Rtcm_Bit_Writer::put_bits_at(uint64_t bit_position, uint64_t value, uint32_t n)
+{
+    uint64_t position = bit_position + HEADER_BITS;
+    while (n > 0)
+        {
+            const uint32_t bit_offset = position & 7U;
+            const uint32_t free_bits = 8 - bit_offset;
+            const uint32_t take = std::min(free_bits, n);
+            const auto chunk = static_cast<uint8_t>((value >> (n - take)) & ((1U << take) - 1U));
+            d_buffer[position >> 3] |= static_cast<uint8_t>(chunk << (free_bits - take));
+            position += take;
+            n -= take;
+        }
+}
+
+
+void Rtcm_Bit_Writer::finish_frame()
+{
+    const size_t frame_bytes = (d_bit_pos + 7) / 8;  // already zero-padded
+    const size_t message_bytes = frame_bytes - HEADER_BITS / 8;
+    d_buffer[0] = RTCM_PREAMBLE;
+    d_buffer[1] = static_cast<uint8_t>((message_bytes >> 8) & 0x03U);  // 6 reserved bits + 2 MSBs of length
+    d_buffer[2] = static_cast<uint8_t>(message_bytes & 0xFFU);
+
+    const uint32_t crc = crc24q(d_buffer.data(), frame_bytes);
+    d_buffer[frame_bytes] = static_cast<uint8_t>(crc >> 16);
+    d_buffer[frame_bytes + 1] = static_cast<uint8_t>(crc >> 8);
+    d_buffer[frame_bytes + 2] = static_cast<uint8_t>(crc);
+    d_frame_size = frame_bytes + CRC_BYTES;
+}
+
+
+std::string Rtcm_Bit_Writer::to_string() const
+{
+    return std::string(reinterpret_cast<const char*>(d_buffer.data()), d_frame_size);
+}
+
+
+uint32_t Rtcm_Bit_Writer::crc24q(const uint8_t* data, size_t length)
+{
+    static const std::array<uint32_t, 256> table = make_crc24q_table();
+    uint32_t crc = 0;
+    for (size_t i = 0; i < length; i++)
+        {
+            crc = ((crc << 8) & 0xFFFFFFU) ^ table[((crc >> 16) ^ data[i]) & 0xFFU];
+        }
+    return crc;
+}
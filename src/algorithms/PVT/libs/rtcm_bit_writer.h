@@ -0,0 +1,156 @@
+/*!
+ * \file rtcm_bit_writer.h
+ * \brief Interface of a class that packs RTCM 3 frames bit by bit into a
+ * preallocated byte buffer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_RTCM_BIT_WRITER_H
+#define GNSS_SDR_RTCM_BIT_WRITER_H
+
+#include <bitset>
+#include <cstddef>  // for size_t
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Packs the fields of a RTCM 3 message MSB first into a byte buffer,
+ * and then wraps them into a transport layer frame:
+ *
+ *   +----------+--------+-----------+--------------------+----------+
+ *   | preamble | 000000 |  length   |    data message    |  parity  |
+ *   +----------+--------+-----------+--------------------+----------+
+ *   |<-- 8 --->|<- 6 -->|<-- 10 --->|<--- length x 8 --->|<-- 24 -->|
+ *   +----------+--------+-----------+--------------------+----------+
+ *
+ * The buffer is reused from frame to frame, so no memory is allocated once
+ * it has grown to the size of the longest frame.
+ */
+class Rtcm_Bit_Writer
+{
+public:
+    /*!
+     * \brief Constructor. The buffer is preallocated for a frame of maximum
+     * length (1023 bytes of data message).
+     */
+    Rtcm_Bit_Writer();
+
+    /*!
+     * \brief Discards the current contents and starts a new frame
+     */
+    void start_frame();
+
+    /*!
+     * \brief Appends the n least significant bits of value, MSB first.
+     * n must be lower or equal than 64.
+     */
+    void put_bits(uint64_t value, uint32_t n);
+
+    /*!
+     * \brief Appends a data field
+     */
+    template <size_t N>
+    void put(const std::bitset<N>& field)
+    {
+        static_assert(N <= 64, "RTCM data fields are up to 64 bits long");
+        put_bits(field.to_ullong(), N);
+    }
+
+    /*!
+     * \brief Appends n zeros. The space can be filled afterwards with
+     * put_bits_at(), which allows to write data blocks that are interleaved
+     * field by field in a single pass over the satellites or cells.
+     */
+    void skip_bits(uint64_t n);
+
+    /*!
+     * \brief Writes the n least significant bits of value, MSB first, at
+     * the given position of the data message. The bits must have been
+     * reserved with skip_bits().
+     */
+    void put_bits_at(uint64_t bit_position, uint64_t value, uint32_t n);
+
+    /*!
+     * \brief Writes a data field at the given position of the data message
+     */
+    template <size_t N>
+    void put_at(uint64_t bit_position, const std::bitset<N>& field)
+    {
+        static_assert(N <= 64, "RTCM data fields are up to 64 bits long");
+        put_bits_at(bit_position, field.to_ullong(), N);
+    }
+
+    /*!
+     * \brief Number of bits written in the data message of the current frame
+     */
+    inline uint64_t bit_position() const
+    {
+        return d_bit_pos - HEADER_BITS;
+    }
+
+    /*!
+     * \brief Pads the data message with zeros up to a byte boundary, writes
+     * the transport layer header and appends the CRC-24Q parity. The length
+     * field only keeps the 10 LSBs of the number of bytes of the message.
+     */
+    void finish_frame();
+
+    /*!
+     * \brief Pointer to the frame bytes, valid after finish_frame()
+     */
+    inline const uint8_t* data() const
+    {
+        return d_buffer.data();
+    }
+
+    /*!
+     * \brief Number of bytes of the frame, valid after finish_frame()
+     */
+    inline size_t size() const
+    {
+        return d_frame_size;
+    }
+
+    /*!
+     * \brief Returns the frame as a string of binary data
+     */
+    std::string to_string() const;
+
+    /*!
+     * \brief Qualcomm CRC-24Q of a block of bytes
+     */
+    static uint32_t crc24q(const uint8_t* data, size_t length);
+
+private:
+    static constexpr uint64_t HEADER_BITS = 24;
+    static constexpr size_t CRC_BYTES = 3;
+    static constexpr size_t MAX_FRAME_BYTES = 3 + 1023 + CRC_BYTES;
+
+    void reserve_bits(uint64_t n);
+
+    std::vector<uint8_t> d_buffer;
+    uint64_t d_bit_pos;
+    size_t d_frame_size;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RTCM_BIT_WRITER_H
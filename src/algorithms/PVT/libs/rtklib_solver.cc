@@ -33,6 +33,8 @@
 #include "rtklib_solver.h"
 #include "Beidou_DNAV.h"
 #include "gnss_sdr_filesystem.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solution.h"
 #include <glog/logging.h>
@@ -49,7 +51,9 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
     const std::string &dump_filename,
     uint32_t type_of_rx,
     bool flag_dump_to_file,
-    bool flag_dump_to_mat) : d_dump_filename(dump_filename),
+    bool flag_dump_to_mat) : d_eph_data(MAXOBS),
+                             d_geph_data(MAXOBS),
+                             d_dump_filename(dump_filename),
                              d_rtk(rtk),
                              d_conf(conf),
                              d_type_of_rx(type_of_rx),
@@ -62,17 +66,17 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
     d_rtklib_freq_index[1] = 1;
     d_rtklib_freq_index[2] = 2;
 
-    d_rtklib_band_index["1G"] = 0;
-    d_rtklib_band_index["1C"] = 0;
-    d_rtklib_band_index["1B"] = 0;
-    d_rtklib_band_index["B1"] = 0;
-    d_rtklib_band_index["B3"] = 2;
-    d_rtklib_band_index["2G"] = 1;
-    d_rtklib_band_index["2S"] = 1;
-    d_rtklib_band_index["7X"] = 2;
-    d_rtklib_band_index["5X"] = 2;
-    d_rtklib_band_index["L5"] = 2;
-    d_rtklib_band_index["E6"] = 0;
+    d_rtklib_band_index[SIG_GLO_1G] = 0;
+    d_rtklib_band_index[SIG_GPS_1C] = 0;
+    d_rtklib_band_index[SIG_GAL_1B] = 0;
+    d_rtklib_band_index[SIG_BDS_B1] = 0;
+    d_rtklib_band_index[SIG_BDS_B3] = 2;
+    d_rtklib_band_index[SIG_GLO_2G] = 1;
+    d_rtklib_band_index[SIG_GPS_2S] = 1;
+    d_rtklib_band_index[SIG_GAL_7X] = 2;
+    d_rtklib_band_index[SIG_GAL_5X] = 2;
+    d_rtklib_band_index[SIG_GPS_L5] = 2;
+    d_rtklib_band_index[SIG_GAL_E6] = 0;
 
     switch (d_type_of_rx)
         {
@@ -89,12 +93,12 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
             d_rtklib_freq_index[2] = 4;
             break;
         case 19:  // Galileo E5a + Galileo E5b
-            d_rtklib_band_index["5X"] = 0;
+            d_rtklib_band_index[SIG_GAL_5X] = 0;
             d_rtklib_freq_index[0] = 2;
             d_rtklib_freq_index[2] = 4;
             break;
         case 20:  // GPS L5 + Galileo E5b
-            d_rtklib_band_index["L5"] = 0;
+            d_rtklib_band_index[SIG_GPS_L5] = 0;
             d_rtklib_freq_index[0] = 2;
             d_rtklib_freq_index[2] = 4;
             break;
@@ -102,34 +106,34 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
             d_rtklib_freq_index[0] = 3;
             break;
         case 101:  // E1 + E6B
-            d_rtklib_band_index["E6"] = 1;
+            d_rtklib_band_index[SIG_GAL_E6] = 1;
             d_rtklib_freq_index[1] = 3;
             break;
         case 102:  // E5a + E6B
-            d_rtklib_band_index["E6"] = 1;
+            d_rtklib_band_index[SIG_GAL_E6] = 1;
             d_rtklib_freq_index[1] = 3;
             break;
         case 103:  // E5b + E6B
-            d_rtklib_band_index["E6"] = 1;
+            d_rtklib_band_index[SIG_GAL_E6] = 1;
             d_rtklib_freq_index[1] = 3;
             d_rtklib_freq_index[2] = 4;
             break;
         case 104:  // Galileo E1B + Galileo E5a + Galileo E6B
-            d_rtklib_band_index["E6"] = 1;
+            d_rtklib_band_index[SIG_GAL_E6] = 1;
             d_rtklib_freq_index[1] = 3;
             break;
         case 105:  // Galileo E1B + Galileo E5b + Galileo E6B
             d_rtklib_freq_index[2] = 4;
-            d_rtklib_band_index["E6"] = 1;
+            d_rtklib_band_index[SIG_GAL_E6] = 1;
             d_rtklib_freq_index[1] = 3;
             break;
         case 106:  // GPS L1 C/A + Galileo E1B + Galileo E6B
         case 107:  // GPS L1 C/A + Galileo E6B
-            d_rtklib_band_index["E6"] = 1;
+            d_rtklib_band_index[SIG_GAL_E6] = 1;
             d_rtklib_freq_index[1] = 3;
             break;
         case 108:  // GPS L1 C/A + Galileo E1B + GPS L5 + Galileo E5a + Galileo E6B
-            d_rtklib_band_index["E6"] = 2;
+            d_rtklib_band_index[SIG_GAL_E6] = 2;
             d_rtklib_freq_index[2] = 3;
             break;
         }
@@ -702,6 +706,11 @@ void Rtklib_Solver::store_has_data(const Galileo_HAS_data &new_has_data)
                         }
                 }
         }
+    // Force the conversion of the ephemeris with the new orbit and clock corrections
+    if (new_has_data.header.orbit_correction_flag or new_has_data.header.clock_fullset_flag)
+        {
+            d_has_generation++;
+        }
 }
 
 
@@ -732,6 +741,7 @@ void Rtklib_Solver::check_has_orbit_clock_validity(const std::map<int, Gnss_Sync
                                         {
                                             // Delete outdated data
                                             it_sys->second.erase(prn);
+                                            d_has_generation++;
                                         }
                                 }
                         }
@@ -746,6 +756,7 @@ void Rtklib_Solver::check_has_orbit_clock_validity(const std::map<int, Gnss_Sync
                                         {
                                             // Delete outdated data
                                             it_sys_clock->second.erase(prn);
+                                            d_has_generation++;
                                         }
                                 }
                         }
@@ -763,6 +774,7 @@ void Rtklib_Solver::check_has_orbit_clock_validity(const std::map<int, Gnss_Sync
                                         {
                                             // Delete outdated data
                                             it_sys->second.erase(prn);
+                                            d_has_generation++;
                                         }
                                 }
                         }
@@ -777,6 +789,7 @@ void Rtklib_Solver::check_has_orbit_clock_validity(const std::map<int, Gnss_Sync
                                         {
                                             // Delete outdated data
                                             it_sys_clock->second.erase(prn);
+                                            d_has_generation++;
                                         }
                                 }
                         }
@@ -802,7 +815,7 @@ void Rtklib_Solver::get_has_biases(const std::map<int, Gnss_Synchro> &obs_map)
                 {
                     uint32_t obs_tow = it.second.interp_TOW_ms / 1000.0;
                     int prn = static_cast<int>(it.second.PRN);
-                    std::string sig(it.second.Signal, 2);
+                    const Rtklib_Signal sig = get_signal(it.second);
                     if (it.second.System == 'E')
                         {
                             auto it_sys_clock = d_has_clock_corrections_store_map.find("Galileo");
@@ -811,28 +824,28 @@ void Rtklib_Solver::get_has_biases(const std::map<int, Gnss_Synchro> &obs_map)
                                     auto it_map_corr = it_sys_clock->second.find(prn);
                                     if (it_map_corr != it_sys_clock->second.end())
                                         {
-                                            if (sig == "1B")
+                                            if (sig == SIG_GAL_1B)
                                                 {
                                                     for (const auto &has_signal : e1b_signals)
                                                         {
                                                             this->get_current_has_obs_correction(has_signal, obs_tow, prn);
                                                         }
                                                 }
-                                            else if (sig == "E6")
+                                            else if (sig == SIG_GAL_E6)
                                                 {
                                                     for (const auto &has_signal : e6_signals)
                                                         {
                                                             this->get_current_has_obs_correction(has_signal, obs_tow, prn);
                                                         }
                                                 }
-                                            else if (sig == "5X")
+                                            else if (sig == SIG_GAL_5X)
                                                 {
                                                     for (const auto &has_signal : e5_signals)
                                                         {
                                                             this->get_current_has_obs_correction(has_signal, obs_tow, prn);
                                                         }
                                                 }
-                                            else if (sig == "7X")
+                                            else if (sig == SIG_GAL_7X)
                                                 {
                                                     for (const auto &has_signal : e7_signals)
                                                         {
@@ -850,21 +863,21 @@ void Rtklib_Solver::get_has_biases(const std::map<int, Gnss_Synchro> &obs_map)
                                     auto it_map_corr = it_sys_clock->second.find(prn);
                                     if (it_map_corr != it_sys_clock->second.end())
                                         {
-                                            if (sig == "1C")
+                                            if (sig == SIG_GPS_1C)
                                                 {
                                                     for (const auto &has_signal : g1c_signals)
                                                         {
                                                             this->get_current_has_obs_correction(has_signal, obs_tow, prn);
                                                         }
                                                 }
-                                            else if (sig == "2S")
+                                            else if (sig == SIG_GPS_2S)
                                                 {
                                                     for (const auto &has_signal : g2s_signals)
                                                         {
                                                             this->get_current_has_obs_correction(has_signal, obs_tow, prn);
                                                         }
                                                 }
-                                            else if (sig == "L5")
+                                            else if (sig == SIG_GPS_L5)
                                                 {
                                                     for (const auto &has_signal : g5_signals)
                                                         {
@@ -902,6 +915,164 @@ void Rtklib_Solver::get_current_has_obs_correction(const std::string &signal, ui
 }
 
 
+namespace
+{
+constexpr uint16_t signal_chars(char first, char second)
+{
+    return static_cast<uint16_t>((static_cast<uint16_t>(static_cast<uint8_t>(first)) << 8U) | static_cast<uint8_t>(second));
+}
+}  // namespace
+
+
+Rtklib_Solver::Rtklib_Signal Rtklib_Solver::get_signal(const Gnss_Synchro &gnss_synchro)
+{
+    switch (signal_chars(gnss_synchro.Signal[0], gnss_synchro.Signal[1]))
+        {
+        case signal_chars('1', 'C'):
+            return SIG_GPS_1C;
+        case signal_chars('2', 'S'):
+            return SIG_GPS_2S;
+        case signal_chars('L', '5'):
+            return SIG_GPS_L5;
+        case signal_chars('1', 'B'):
+            return SIG_GAL_1B;
+        case signal_chars('5', 'X'):
+            return SIG_GAL_5X;
+        case signal_chars('7', 'X'):
+            return SIG_GAL_7X;
+        case signal_chars('E', '6'):
+            return SIG_GAL_E6;
+        case signal_chars('1', 'G'):
+            return SIG_GLO_1G;
+        case signal_chars('2', 'G'):
+            return SIG_GLO_2G;
+        case signal_chars('B', '1'):
+            return SIG_BDS_B1;
+        case signal_chars('B', '3'):
+            return SIG_BDS_B3;
+        default:
+            return SIG_UNKNOWN;
+        }
+}
+
+
+template <typename Rtklib_Eph, typename Converter>
+const Rtklib_Eph &Rtklib_Solver::get_cached_eph(std::map<int, Rtklib_Eph_Cache_Entry<Rtklib_Eph>> &cache,
+    int prn,
+    const Eph_Source_Id &source_id,
+    Converter convert)
+{
+    auto &entry = cache[prn];
+    if (!entry.valid or entry.has_generation != d_has_generation or entry.source_id != source_id)
+        {
+            entry.rtklib_eph = convert();
+            entry.source_id = source_id;
+            entry.has_generation = d_has_generation;
+            entry.valid = true;
+        }
+    return entry.rtklib_eph;
+}
+
+
+const eph_t &Rtklib_Solver::get_rtklib_eph(const Galileo_Ephemeris &gal_eph, bool apply_has)
+{
+    const Eph_Source_Id source_id{static_cast<double>(gal_eph.IOD_ephemeris),
+        static_cast<double>(gal_eph.IOD_nav),
+        static_cast<double>(gal_eph.toe),
+        static_cast<double>(gal_eph.toc),
+        static_cast<double>(gal_eph.tow),
+        static_cast<double>(gal_eph.WN),
+        static_cast<double>(gal_eph.SISA),
+        static_cast<double>(gal_eph.E1B_HS),
+        static_cast<double>(gal_eph.E5a_HS),
+        static_cast<double>(gal_eph.E5b_HS),
+        gal_eph.E1B_DVS ? 1.0 : 0.0,
+        gal_eph.E5a_DVS ? 1.0 : 0.0,
+        gal_eph.E5b_DVS ? 1.0 : 0.0};
+    if (!apply_has)
+        {
+            return get_cached_eph(d_gal_eph_cache, static_cast<int>(gal_eph.PRN), source_id,
+                [&gal_eph]() { return eph_to_rtklib(gal_eph); });
+        }
+    return get_cached_eph(d_gal_has_eph_cache, static_cast<int>(gal_eph.PRN), source_id,
+        [this, &gal_eph]() {
+            const std::string gal_str("Galileo");
+            return eph_to_rtklib(gal_eph,
+                this->d_has_orbit_corrections_store_map[gal_str],
+                this->d_has_clock_corrections_store_map[gal_str]);
+        });
+}
+
+
+const eph_t &Rtklib_Solver::get_rtklib_eph(const Gps_Ephemeris &gps_eph)
+{
+    const bool pre_2009 = this->is_pre_2009();
+    const Eph_Source_Id source_id{static_cast<double>(gps_eph.IODE_SF2),
+        static_cast<double>(gps_eph.IODE_SF3),
+        static_cast<double>(gps_eph.IODC),
+        static_cast<double>(gps_eph.toe),
+        static_cast<double>(gps_eph.toc),
+        static_cast<double>(gps_eph.tow),
+        static_cast<double>(gps_eph.WN),
+        pre_2009 ? 1.0 : 0.0,
+        static_cast<double>(gps_eph.SV_health),
+        static_cast<double>(gps_eph.SV_accuracy)};
+    return get_cached_eph(d_gps_eph_cache, static_cast<int>(gps_eph.PRN), source_id,
+        [this, &gps_eph, pre_2009]() {
+            const std::string gps_str("GPS");
+            return eph_to_rtklib(gps_eph,
+                this->d_has_orbit_corrections_store_map[gps_str],
+                this->d_has_clock_corrections_store_map[gps_str],
+                pre_2009);
+        });
+}
+
+
+const eph_t &Rtklib_Solver::get_rtklib_eph(const Gps_CNAV_Ephemeris &gps_cnav_eph)
+{
+    const Eph_Source_Id source_id{static_cast<double>(gps_cnav_eph.toe1),
+        static_cast<double>(gps_cnav_eph.toe2),
+        static_cast<double>(gps_cnav_eph.toc),
+        static_cast<double>(gps_cnav_eph.tow),
+        static_cast<double>(gps_cnav_eph.WN),
+        static_cast<double>(gps_cnav_eph.signal_health),
+        static_cast<double>(gps_cnav_eph.URA)};
+    return get_cached_eph(d_gps_cnav_eph_cache, static_cast<int>(gps_cnav_eph.PRN), source_id,
+        [&gps_cnav_eph]() { return eph_to_rtklib(gps_cnav_eph); });
+}
+
+
+const eph_t &Rtklib_Solver::get_rtklib_eph(const Beidou_Dnav_Ephemeris &bei_eph)
+{
+    const Eph_Source_Id source_id{bei_eph.AODE,
+        bei_eph.AODC,
+        static_cast<double>(bei_eph.toe),
+        static_cast<double>(bei_eph.toc),
+        static_cast<double>(bei_eph.tow),
+        static_cast<double>(bei_eph.WN),
+        static_cast<double>(bei_eph.SV_health),
+        static_cast<double>(bei_eph.SV_accuracy)};
+    return get_cached_eph(d_bds_eph_cache, static_cast<int>(bei_eph.PRN), source_id,
+        [&bei_eph]() { return eph_to_rtklib(bei_eph); });
+}
+
+
+const geph_t &Rtklib_Solver::get_rtklib_eph(const Glonass_Gnav_Ephemeris &glonass_gnav_eph)
+{
+    // the conversion also depends on the GLONASS UTC model
+    const Eph_Source_Id source_id{glonass_gnav_eph.d_t_b,
+        glonass_gnav_eph.d_t_k,
+        static_cast<double>(glonass_gnav_eph.d_WN),
+        glonass_gnav_utc_model.d_tau_c,
+        glonass_gnav_utc_model.d_tau_gps,
+        glonass_gnav_eph.d_B_n,
+        glonass_gnav_eph.d_l3rd_n ? 1.0 : 0.0,
+        glonass_gnav_eph.d_l5th_n ? 1.0 : 0.0,
+        glonass_gnav_eph.d_F_T};
+    return get_cached_eph(d_glo_geph_cache, static_cast<int>(glonass_gnav_eph.PRN), source_id,
+        [this, &glonass_gnav_eph]() { return eph_to_rtklib(glonass_gnav_eph, this->glonass_gnav_utc_model); });
+}
+
 bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_map, double kf_update_interval_s)
 {
     std::map<int, Gnss_Synchro>::const_iterator gnss_observables_iter;
@@ -911,8 +1082,6 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     std::map<int, Glonass_Gnav_Ephemeris>::const_iterator glonass_gnav_ephemeris_iter;
     std::map<int, Beidou_Dnav_Ephemeris>::const_iterator beidou_ephemeris_iter;
 
-    const Glonass_Gnav_Utc_Model &gnav_utc = this->glonass_gnav_utc_model;
-
     // ********************************************************************************
     // ****** PREPARE THE DATA (SV EPHEMERIS AND OBSERVATIONS) ************************
     // ********************************************************************************
@@ -920,8 +1089,8 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     int glo_valid_obs = 0;  // GLONASS L1/L2 valid observations counter
 
     d_obs_data.fill({});
-    std::vector<eph_t> eph_data(MAXOBS);
-    std::vector<geph_t> geph_data(MAXOBS);
+    std::fill(d_eph_data.begin(), d_eph_data.end(), eph_t{});
+    std::fill(d_geph_data.begin(), d_geph_data.end(), geph_t{});
 
     // Workaround for NAV/CNAV clash problem
     bool gps_dual_band = false;
@@ -936,12 +1105,12 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 {
                 case 'G':
                     {
-                        const std::string sig_(gnss_observables_iter->second.Signal, 2);
-                        if (sig_ == "1C")
+                        const Rtklib_Signal sig_ = get_signal(gnss_observables_iter->second);
+                        if (sig_ == SIG_GPS_1C)
                             {
                                 band1 = true;
                             }
-                        if (sig_ == "2S")
+                        if (sig_ == SIG_GPS_2S)
                             {
                                 band2 = true;
                             }
@@ -965,19 +1134,16 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 {
                 case 'E':
                     {
-                        const std::string gal_str("Galileo");
-                        const std::string sig_(gnss_observables_iter->second.Signal, 2);
+                        const Rtklib_Signal sig_ = get_signal(gnss_observables_iter->second);
                         // Galileo E1
-                        if (sig_ == "1B")
+                        if (sig_ == SIG_GAL_1B)
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second,
-                                            this->d_has_orbit_corrections_store_map[gal_str],
-                                            this->d_has_clock_corrections_store_map[gal_str]);
+                                        d_eph_data[valid_obs] = get_rtklib_eph(galileo_ephemeris_iter->second, true);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -994,7 +1160,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                             }
 
                         // Galileo E5
-                        if ((sig_ == "5X") || (sig_ == "7X"))
+                        if ((sig_ == SIG_GAL_5X) || (sig_ == SIG_GAL_7X))
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
@@ -1003,7 +1169,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_E1_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
+                                                if (d_eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
                                                     {
                                                         d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
@@ -1018,9 +1184,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert Galileo E5 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second,
-                                                    this->d_has_orbit_corrections_store_map[gal_str],
-                                                    this->d_has_clock_corrections_store_map[gal_str]);
+                                                d_eph_data[valid_obs] = get_rtklib_eph(galileo_ephemeris_iter->second, true);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -1039,7 +1203,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
                                     }
                             }
-                        if (sig_ == "E6" && d_conf.use_e6_for_pvt)
+                        if (sig_ == SIG_GAL_E6 && d_conf.use_e6_for_pvt)
                             {
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
@@ -1047,7 +1211,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_E1_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
+                                                if (d_eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
                                                     {
                                                         d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
@@ -1062,9 +1226,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert Galileo E6 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second,
-                                                    this->d_has_orbit_corrections_store_map[gal_str],
-                                                    this->d_has_clock_corrections_store_map[gal_str]);
+                                                d_eph_data[valid_obs] = get_rtklib_eph(galileo_ephemeris_iter->second, true);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -1083,7 +1245,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
                                     }
                             }
-                        if (sig_ == "E6")
+                        if (sig_ == SIG_GAL_E6)
                             {
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
@@ -1091,7 +1253,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_E1_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
+                                                if (d_eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
                                                     {
                                                         d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
@@ -1105,7 +1267,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert Galileo E6 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = get_rtklib_eph(galileo_ephemeris_iter->second, false);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -1130,18 +1292,14 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     {
                         // GPS L1
                         // 1 GPS - find the ephemeris for the current GPS SV observation. The SV PRN ID is the map key
-                        const std::string gps_str("GPS");
-                        const std::string sig_(gnss_observables_iter->second.Signal, 2);
-                        if (sig_ == "1C")
+                        const Rtklib_Signal sig_ = get_signal(gnss_observables_iter->second);
+                        if (sig_ == SIG_GPS_1C)
                             {
                                 gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (gps_ephemeris_iter != gps_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(gps_ephemeris_iter->second,
-                                            this->d_has_orbit_corrections_store_map[gps_str],
-                                            this->d_has_clock_corrections_store_map[gps_str],
-                                            this->is_pre_2009());
+                                        d_eph_data[valid_obs] = get_rtklib_eph(gps_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -1158,7 +1316,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // GPS L2 (todo: solve NAV/CNAV clash)
-                        if ((sig_ == "2S") and (gps_dual_band == false))
+                        if ((sig_ == SIG_GPS_2S) and (gps_dual_band == false))
                             {
                                 gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
@@ -1172,12 +1330,12 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 // (more precise!), and attach the L2 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (d_eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                                d_eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
                                                                 d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                                     gnss_observables_iter->second,
-                                                                    eph_data[i].week,
+                                                                    d_eph_data[i].week,
                                                                     d_rtklib_band_index[sig_]);
                                                                 break;
                                                             }
@@ -1188,7 +1346,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L2 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = get_rtklib_eph(gps_cnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -1207,7 +1365,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // GPS L5
-                        if (sig_ == "L5")
+                        if (sig_ == SIG_GPS_L5)
                             {
                                 gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
@@ -1220,9 +1378,9 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 // (more precise!), and attach the L5 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (d_eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                                d_eph_data[i] = get_rtklib_eph(gps_cnav_ephemeris_iter->second);
                                                                 d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i],
                                                                     gnss_observables_iter->second,
                                                                     gps_cnav_ephemeris_iter->second.WN,
@@ -1235,7 +1393,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L5 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = get_rtklib_eph(gps_cnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -1258,16 +1416,16 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     }
                 case 'R':  // TODO This should be using rtk lib nomenclature
                     {
-                        const std::string sig_(gnss_observables_iter->second.Signal);
+                        const Rtklib_Signal sig_ = get_signal(gnss_observables_iter->second);
                         // GLONASS GNAV L1
-                        if (sig_ == "1G")
+                        if (sig_ == SIG_GLO_1G)
                             {
                                 // 1 Glo - find the ephemeris for the current GLONASS SV observation. The SV Slot Number (PRN ID) is the map key
                                 glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (glonass_gnav_ephemeris_iter != glonass_gnav_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                        d_geph_data[glo_valid_obs] = get_rtklib_eph(glonass_gnav_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -1282,7 +1440,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // GLONASS GNAV L2
-                        if (sig_ == "2G")
+                        if (sig_ == SIG_GLO_2G)
                             {
                                 // 1 GLONASS - find the ephemeris for the current GLONASS SV observation. The SV PRN ID is the map key
                                 glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
@@ -1291,7 +1449,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_L1_obs = false;
                                         for (int i = 0; i < glo_valid_obs; i++)
                                             {
-                                                if (geph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
+                                                if (d_geph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
                                                     {
                                                         d_obs_data[i + valid_obs] = insert_obs_to_rtklib(d_obs_data[i + valid_obs],
                                                             gnss_observables_iter->second,
@@ -1305,7 +1463,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert GLONASS GNAV L2 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                                d_geph_data[glo_valid_obs] = get_rtklib_eph(glonass_gnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 obsd_t newobs{};
                                                 d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -1326,14 +1484,14 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     {
                         // BEIDOU B1I
                         //  - find the ephemeris for the current BEIDOU SV observation. The SV PRN ID is the map key
-                        const std::string sig_(gnss_observables_iter->second.Signal);
-                        if (sig_ == "B1")
+                        const Rtklib_Signal sig_ = get_signal(gnss_observables_iter->second);
+                        if (sig_ == SIG_BDS_B1)
                             {
                                 beidou_ephemeris_iter = beidou_dnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                        d_eph_data[valid_obs] = get_rtklib_eph(beidou_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -1348,7 +1506,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // BeiDou B3
-                        if (sig_ == "B3")
+                        if (sig_ == SIG_BDS_B3)
                             {
                                 beidou_ephemeris_iter = beidou_dnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend())
@@ -1356,7 +1514,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_B1I_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS)))
+                                                if (d_eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS)))
                                                     {
                                                         d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
@@ -1370,7 +1528,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert BeiDou B3I obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = get_rtklib_eph(beidou_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -1406,8 +1564,8 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
         {
             int result = 0;
             d_nav_data = {};
-            d_nav_data.eph = eph_data.data();
-            d_nav_data.geph = geph_data.data();
+            d_nav_data.eph = d_eph_data.data();
+            d_nav_data.geph = d_geph_data.data();
             d_nav_data.n = valid_obs;
             d_nav_data.ng = glo_valid_obs;
             if (gps_iono.valid)
@@ -1499,7 +1657,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         }
                 }
 
-            result = rtkpos(&d_rtk, d_obs_data.data(), valid_obs + glo_valid_obs, &d_nav_data);
+            {
+                Rtklib_Arena_Scope arena_scope(d_arena);  // released when rtkpos() returns
+                result = rtkpos(&d_rtk, d_obs_data.data(), valid_obs + glo_valid_obs, &d_nav_data);
+            }
 
             if (result == 0)
                 {
@@ -1804,3 +1965,136 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
         }
     return this->is_valid_position();
 }
+
+
+bool Rtklib_Solver::get_range_rate(const nav_t *nav, int sateph, const gtime_t &rx_time, const double *rr, int sat, double &range_rate_m_s, double &sat_clk_drift)
+{
+    std::array<double, 6> rs{};
+    std::array<double, 2> dts{};
+    std::array<double, 3> e{};
+    double var = 0.0;
+    int svh = 0;
+
+    // satellite position at signal transmission time (two iterations are enough for the light time)
+    gtime_t tx_time = rx_time;
+    double range_m = 0.0;
+    for (int iter = 0; iter < 2; iter++)
+        {
+            if (!satpos(tx_time, tx_time, sat, sateph, nav, rs.data(), dts.data(), &var, &svh))
+                {
+                    return false;
+                }
+            range_m = geodist(rs.data(), rr, e.data());
+            if (range_m <= 0.0)
+                {
+                    return false;
+                }
+            tx_time = timeadd(rx_time, -range_m / SPEED_OF_LIGHT_M_S);
+        }
+
+    // range rate with earth rotation correction (see estvel in rtklib_pntpos.cc)
+    const std::array<double, 3> vs = {rs[3] - rr[3], rs[4] - rr[4], rs[5] - rr[5]};
+    range_rate_m_s = dot(vs.data(), e.data(), 3) + GNSS_OMEGA_EARTH_DOT / SPEED_OF_LIGHT_M_S * (rs[4] * rr[0] + rs[1] * rr[3] - rs[3] * rr[1] - rs[0] * rr[4]);
+    sat_clk_drift = dts[1];
+    return true;
+}
+
+
+bool Rtklib_Solver::get_vtl_prediction(const Gnss_Synchro &gnss_synchro,
+    double &carrier_doppler_hz,
+    double &carrier_doppler_rate_hz_s,
+    double &carrier_freq_hz) const
+{
+    if (!this->is_valid_position())
+        {
+            return false;
+        }
+
+    int sat = 0;
+    switch (gnss_synchro.System)
+        {
+        case 'G':
+            sat = satno(SYS_GPS, static_cast<int>(gnss_synchro.PRN));
+            break;
+        case 'E':
+            sat = satno(SYS_GAL, static_cast<int>(gnss_synchro.PRN));
+            break;
+        case 'R':
+            sat = satno(SYS_GLO, static_cast<int>(gnss_synchro.PRN));
+            break;
+        case 'C':
+            sat = satno(SYS_BDS, static_cast<int>(gnss_synchro.PRN));
+            break;
+        default:
+            return false;
+        }
+    if (sat <= 0)
+        {
+            return false;
+        }
+
+    const Rtklib_Signal sig_ = get_signal(gnss_synchro);
+    if (sig_ == SIG_UNKNOWN)
+        {
+            return false;
+        }
+    const double lam = d_nav_data.lam[sat - 1][d_rtklib_band_index[sig_]];
+    if (lam <= 0.0)
+        {
+            return false;
+        }
+
+    if (!predict_carrier_doppler(&d_nav_data, d_rtk.opt.sateph, pvt_sol, sat, lam, carrier_doppler_hz, carrier_doppler_rate_hz_s))
+        {
+            return false;
+        }
+    carrier_freq_hz = SPEED_OF_LIGHT_M_S / lam;
+    return true;
+}
+
+
+bool Rtklib_Solver::predict_carrier_doppler(const nav_t *nav,
+    int sateph,
+    const sol_t &sol,
+    int sat,
+    double lam,
+    double &carrier_doppler_hz,
+    double &carrier_doppler_rate_hz_s)
+{
+    // receiver state at the last solution: {x, y, z, vx, vy, vz} [m, m/s]
+    // and receiver clock drift [m/s]
+    std::array<double, 6> rr{};
+    for (int i = 0; i < 6; i++)
+        {
+            rr[i] = sol.rr[i];
+        }
+    const double rx_clk_drift_m_s = sol.dtr[5];
+
+    double range_rate_m_s = 0.0;
+    double sat_clk_drift = 0.0;
+    if (!get_range_rate(nav, sateph, sol.time, rr.data(), sat, range_rate_m_s, sat_clk_drift))
+        {
+            return false;
+        }
+    // same model as resdop in rtklib_pntpos.cc: -lam * D = rate + drift_rx - c * drift_sat
+    carrier_doppler_hz = -(range_rate_m_s + rx_clk_drift_m_s - SPEED_OF_LIGHT_M_S * sat_clk_drift) / lam;
+
+    // Doppler rate by finite differences, propagating the receiver with constant velocity
+    const double dt_s = 1.0;
+    for (int i = 0; i < 3; i++)
+        {
+            rr[i] += rr[i + 3] * dt_s;
+        }
+    double range_rate_next_m_s = 0.0;
+    double sat_clk_drift_next = 0.0;
+    if (get_range_rate(nav, sateph, timeadd(sol.time, dt_s), rr.data(), sat, range_rate_next_m_s, sat_clk_drift_next))
+        {
+            const double carrier_doppler_next_hz = -(range_rate_next_m_s + rx_clk_drift_m_s - SPEED_OF_LIGHT_M_S * sat_clk_drift_next) / lam;
+            carrier_doppler_rate_hz_s = (carrier_doppler_next_hz - carrier_doppler_hz) / dt_s;
+        }
+    else
+        {
+            carrier_doppler_rate_hz_s = 0.0;
+        }
+    return true;
+}
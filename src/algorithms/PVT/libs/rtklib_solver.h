@@ -60,6 +60,7 @@
 #include "pvt_kf.h"
 #include "pvt_solution.h"
 #include "rtklib.h"
+#include "rtklib_arena.h"
 #include "rtklib_conversions.h"
 #include <array>
 #include <cstdint>
@@ -67,6 +68,7 @@
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 /** \addtogroup PVT
  * \{ */
@@ -100,6 +102,42 @@ public:
     void store_has_data(const Galileo_HAS_data& new_has_data);
     void update_has_corrections(const std::map<int, Gnss_Synchro>& obs_map);
 
+    /*!
+     * \brief Predicts the carrier Doppler [Hz], its rate [Hz/s] and the
+     * carrier frequency [Hz] of the signal in gnss_synchro from the last valid
+     * PVT solution and the broadcast ephemeris (Vector Tracking Loop aiding).
+     */
+    bool get_vtl_prediction(const Gnss_Synchro& gnss_synchro,
+        double& carrier_doppler_hz,
+        double& carrier_doppler_rate_hz_s,
+        double& carrier_freq_hz) const;
+
+    /*!
+     * \brief Predicts the carrier Doppler [Hz] and its rate [Hz/s] of the
+     * satellite sat, with carrier wavelength lam [m], for a receiver with the
+     * time, position, velocity and clock drift of sol, using the ephemeris in
+     * nav. Used by get_vtl_prediction.
+     */
+    static bool predict_carrier_doppler(const nav_t* nav,
+        int sateph,
+        const sol_t& sol,
+        int sat,
+        double lam,
+        double& carrier_doppler_hz,
+        double& carrier_doppler_rate_hz_s);
+
+    /*!
+     * \brief Returns the RTKLIB conversion of an ephemeris. Conversions are
+     * cached per PRN, and they are only redone when the issue of data,
+     * reference times, week, health or accuracy of the ephemeris change, or
+     * when new HAS corrections are stored.
+     */
+    const eph_t& get_rtklib_eph(const Galileo_Ephemeris& gal_eph, bool apply_has);
+    const eph_t& get_rtklib_eph(const Gps_Ephemeris& gps_eph);
+    const eph_t& get_rtklib_eph(const Gps_CNAV_Ephemeris& gps_cnav_eph);
+    const eph_t& get_rtklib_eph(const Beidou_Dnav_Ephemeris& bei_eph);
+    const geph_t& get_rtklib_eph(const Glonass_Gnav_Ephemeris& glonass_gnav_eph);
+
     sol_t pvt_sol{};
     std::array<ssat_t, MAXSAT> pvt_ssat{};
 
@@ -128,16 +166,70 @@ public:
     std::map<int, Beidou_Dnav_Almanac> beidou_dnav_almanac_map;
 
 private:
+    // Signals handled by get_PVT, used as index of d_rtklib_band_index
+    enum Rtklib_Signal : uint8_t
+    {
+        SIG_UNKNOWN = 0,
+        SIG_GPS_1C,
+        SIG_GPS_2S,
+        SIG_GPS_L5,
+        SIG_GAL_1B,
+        SIG_GAL_5X,
+        SIG_GAL_7X,
+        SIG_GAL_E6,
+        SIG_GLO_1G,
+        SIG_GLO_2G,
+        SIG_BDS_B1,
+        SIG_BDS_B3,
+        SIG_COUNT
+    };
+
+    // Fields of a GNSS-SDR ephemeris that identify it: issue of data,
+    // reference times, week, health and accuracy
+    using Eph_Source_Id = std::array<double, 13>;
+
+    // RTKLIB ephemeris converted from a GNSS-SDR ephemeris, and the
+    // identity of the source
+    template <typename Rtklib_Eph>
+    struct Rtklib_Eph_Cache_Entry
+    {
+        Rtklib_Eph rtklib_eph{};
+        Eph_Source_Id source_id{};
+        uint64_t has_generation{};
+        bool valid{false};
+    };
+
+    template <typename Rtklib_Eph, typename Converter>
+    const Rtklib_Eph& get_cached_eph(std::map<int, Rtklib_Eph_Cache_Entry<Rtklib_Eph>>& cache,
+        int prn,
+        const Eph_Source_Id& source_id,
+        Converter convert);
+
+    static Rtklib_Signal get_signal(const Gnss_Synchro& gnss_synchro);
+
     bool save_matfile() const;
+    static bool get_range_rate(const nav_t* nav, int sateph, const gtime_t& rx_time, const double* rr, int sat, double& range_rate_m_s, double& sat_clk_drift);
 
     void check_has_orbit_clock_validity(const std::map<int, Gnss_Synchro>& obs_map);
     void get_has_biases(const std::map<int, Gnss_Synchro>& obs_map);
     void get_current_has_obs_correction(const std::string& signal, uint32_t tow_obs, int prn);
 
     std::array<obsd_t, MAXOBS> d_obs_data{};
+    std::vector<eph_t> d_eph_data;    // kept alive after get_PVT since d_nav_data points to it
+    std::vector<geph_t> d_geph_data;  // kept alive after get_PVT since d_nav_data points to it
     std::array<double, 4> d_dop{};
     std::map<int, int> d_rtklib_freq_index;
-    std::map<std::string, int> d_rtklib_band_index;
+    std::array<int, SIG_COUNT> d_rtklib_band_index{};
+
+    // Ephemeris conversions, keyed by PRN. Entries are refreshed when the
+    // source ephemeris changes or when d_has_generation is increased
+    std::map<int, Rtklib_Eph_Cache_Entry<eph_t>> d_gal_eph_cache;
+    std::map<int, Rtklib_Eph_Cache_Entry<eph_t>> d_gal_has_eph_cache;
+    std::map<int, Rtklib_Eph_Cache_Entry<eph_t>> d_gps_eph_cache;
+    std::map<int, Rtklib_Eph_Cache_Entry<eph_t>> d_gps_cnav_eph_cache;
+    std::map<int, Rtklib_Eph_Cache_Entry<eph_t>> d_bds_eph_cache;
+    std::map<int, Rtklib_Eph_Cache_Entry<geph_t>> d_glo_geph_cache;
+    uint64_t d_has_generation{0};  // increased whenever the HAS orbit or clock corrections change
 
     std::map<std::string, std::map<int, HAS_orbit_corrections>> d_has_orbit_corrections_store_map;  // first key is system, second key is PRN
     std::map<std::string, std::map<int, HAS_clock_corrections>> d_has_clock_corrections_store_map;  // first key is system, second key is PRN
@@ -151,6 +243,7 @@ private:
     std::ofstream d_dump_file;
     rtk_t d_rtk{};
     nav_t d_nav_data{};
+    Rtklib_Arena d_arena;  // scratch memory for the matrices of rtkpos(), reused in every epoch
     Monitor_Pvt d_monitor_pvt{};
     Pvt_Conf d_conf;
     Pvt_Kf d_pvt_kf;
@@ -0,0 +1,638 @@
+/*!
+ * \file segment_stitcher.cc
+ * \brief Implementation of a class that joins the RINEX and NMEA outputs of
+ * receivers that processed consecutive, overlapping time segments of the
+ * same capture.
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include "segment_stitcher.h"
+#include <glog/logging.h>
+#include <algorithm>  // for std::lower_bound, std::minmax_element
+#include <array>
+#include <cmath>      // for std::abs, std::round
+#include <cstdio>     // for snprintf
+#include <cstdlib>    // for strtod
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <utility>
+
+
+namespace
+{
+constexpr std::size_t MIN_COMMON_EPOCHS = 3;  // to accept a carrier phase handover
+constexpr std::size_t SAT_ID_WIDTH = 3;
+constexpr std::size_t OBS_FIELD_WIDTH = 16;  // F14.3, LLI and SSI
+constexpr std::size_t OBS_VALUE_WIDTH = 14;
+
+
+struct Obs_Epoch
+{
+    double time{0.0};  // seconds since an arbitrary origin
+    std::string line;
+    std::vector<std::string> records;  // satellite observations or, for special events, header lines
+    bool event{false};
+};
+
+
+struct Rinex_Obs_File
+{
+    std::vector<std::string> header;
+    std::map<char, std::vector<std::string>> obs_types;
+    std::vector<Obs_Epoch> epochs;
+};
+
+
+int64_t days_from_civil(int64_t y, int64_t m, int64_t d)
+{
+    y -= m <= 2 ? 1 : 0;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const int64_t yoe = y - era * 400;
+    const int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+
+void strip_carriage_return(std::string& line)
+{
+    if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+}
+
+
+std::string header_label(const std::string& line)
+{
+    if (line.size() <= 60)
+        {
+            return {};
+        }
+    std::string label = line.substr(60);
+    label.erase(label.find_last_not_of(' ') + 1);
+    return label;
+}
+
+
+bool is_rinex_3(const std::vector<std::string>& header)
+{
+    for (const auto& line : header)
+        {
+            if (header_label(line) == "RINEX VERSION / TYPE")
+                {
+                    return std::strtod(line.substr(0, 9).c_str(), nullptr) >= 3.0;
+                }
+        }
+    return false;
+}
+
+
+bool parse_epoch_time(const std::string& line, double& time)
+{
+    if (line.size() < 29)
+        {
+            return false;
+        }
+    try
+        {
+            const int64_t year = std::stoi(line.substr(2, 4));
+            const int64_t month = std::stoi(line.substr(7, 2));
+            const int64_t day = std::stoi(line.substr(10, 2));
+            const int64_t hour = std::stoi(line.substr(13, 2));
+            const int64_t minute = std::stoi(line.substr(16, 2));
+            const double seconds = std::stod(line.substr(18, 11));
+            time = static_cast<double>(days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60) + seconds;
+        }
+    catch (const std::exception&)
+        {
+            return false;
+        }
+    return true;
+}
+
+
+bool read_rinex_obs(const std::string& filename, Rinex_Obs_File& file)
+{
+    std::ifstream in(filename);
+    if (!in.is_open())
+        {
+            LOG(WARNING) << "Cannot open RINEX observation file " << filename;
+            return false;
+        }
+    std::string line;
+    bool end_of_header = false;
+    char system = ' ';
+    std::size_t pending_types = 0;
+    while (!end_of_header && std::getline(in, line))
+        {
+            strip_carriage_return(line);
+            file.header.push_back(line);
+            const std::string label = header_label(line);
+            if (label == "SYS / # / OBS TYPES")
+                {
+                    if (line[0] != ' ')
+                        {
+                            system = line[0];
+                            pending_types = std::strtoul(line.substr(3, 3).c_str(), nullptr, 10);
+                        }
+                    for (std::size_t pos = 7; pos + 3 <= 60 && pending_types > 0; pos += 4)
+                        {
+                            const std::string type = line.substr(pos, 3);
+                            if (type[0] != ' ')
+                                {
+                                    file.obs_types[system].push_back(type);
+                                    pending_types--;
+                                }
+                        }
+                }
+            end_of_header = label == "END OF HEADER";
+        }
+    if (!end_of_header || !is_rinex_3(file.header))
+        {
+            LOG(WARNING) << "File " << filename << " is not a RINEX 3 observation file";
+            return false;
+        }
+
+    double last_time = 0.0;
+    while (std::getline(in, line))
+        {
+            strip_carriage_return(line);
+            if (line.empty())
+                {
+                    continue;
+                }
+            if (line[0] != '>' || line.size() < 35)
+                {
+                    LOG(WARNING) << "Unexpected line in " << filename << ": " << line;
+                    continue;
+                }
+            Obs_Epoch epoch;
+            epoch.line = line;
+            epoch.event = line[31] > '1';
+            if (epoch.event || !parse_epoch_time(line, epoch.time))
+                {
+                    epoch.time = last_time;
+                }
+            last_time = epoch.time;
+            const auto num_records = std::strtoul(line.substr(32, 3).c_str(), nullptr, 10);
+            for (unsigned long i = 0; i < num_records && std::getline(in, line); i++)
+                {
+                    strip_carriage_return(line);
+                    epoch.records.push_back(line);
+                }
+            file.epochs.push_back(std::move(epoch));
+        }
+    return true;
+}
+
+
+bool read_obs_value(const std::string& record, std::size_t field, double& value)
+{
+    const std::size_t pos = SAT_ID_WIDTH + field * OBS_FIELD_WIDTH;
+    if (record.size() <= pos)
+        {
+            return false;
+        }
+    const std::string text = record.substr(pos, OBS_VALUE_WIDTH);
+    if (text.find_first_not_of(' ') == std::string::npos)
+        {
+            return false;
+        }
+    value = std::strtod(text.c_str(), nullptr);
+    return true;
+}
+
+
+void write_obs_value(std::string& record, std::size_t field, double value)
+{
+    const std::size_t pos = SAT_ID_WIDTH + field * OBS_FIELD_WIDTH;
+    std::array<char, 32> text{};
+    const int length = std::snprintf(text.data(), text.size(), "%14.3f", value);
+    if (length == static_cast<int>(OBS_VALUE_WIDTH))
+        {
+            record.replace(pos, OBS_VALUE_WIDTH, text.data());
+        }
+}
+
+
+void set_loss_of_lock(std::string& record, std::size_t field)
+{
+    const std::size_t pos = SAT_ID_WIDTH + field * OBS_FIELD_WIDTH + OBS_VALUE_WIDTH;
+    if (record.size() <= pos)
+        {
+            record.resize(pos + 1, ' ');
+        }
+    const int lli = record[pos] >= '0' && record[pos] <= '9' ? record[pos] - '0' : 0;
+    record[pos] = static_cast<char>('0' + (lli | 1));
+}
+
+
+std::vector<std::size_t> phase_fields(const std::map<char, std::vector<std::string>>& obs_types, char system)
+{
+    std::vector<std::size_t> fields;
+    const auto types = obs_types.find(system);
+    if (types != obs_types.cend())
+        {
+            for (std::size_t i = 0; i < types->second.size(); i++)
+                {
+                    if (types->second[i][0] == 'L')
+                        {
+                            fields.push_back(i);
+                        }
+                }
+        }
+    return fields;
+}
+
+
+bool read_text_file(const std::string& filename, std::vector<std::string>& lines)
+{
+    std::ifstream in(filename);
+    if (!in.is_open())
+        {
+            LOG(WARNING) << "Cannot open file " << filename;
+            return false;
+        }
+    std::string line;
+    while (std::getline(in, line))
+        {
+            lines.push_back(line);
+        }
+    return true;
+}
+
+
+bool write_text_file(const std::string& filename, const std::vector<std::string>& lines)
+{
+    std::ofstream out(filename, std::ios::out | std::ios::trunc);
+    if (!out.is_open())
+        {
+            LOG(WARNING) << "Cannot create file " << filename;
+            return false;
+        }
+    for (const auto& line : lines)
+        {
+            out << line << '\n';
+        }
+    return out.good();
+}
+
+
+// Time of a NMEA RMC sentence, from its UTC time (hhmmss.ss) and date (ddmmyy) fields
+bool parse_rmc_time(const std::string& sentence, double& time)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(sentence);
+    std::string field;
+    while (std::getline(ss, field, ','))
+        {
+            fields.push_back(field);
+        }
+    if (fields.size() < 10 || fields[1].size() < 6 || fields[9].size() < 6)
+        {
+            return false;
+        }
+    try
+        {
+            const int64_t hour = std::stoi(fields[1].substr(0, 2));
+            const int64_t minute = std::stoi(fields[1].substr(2, 2));
+            const double seconds = std::stod(fields[1].substr(4));
+            const int64_t day = std::stoi(fields[9].substr(0, 2));
+            const int64_t month = std::stoi(fields[9].substr(2, 2));
+            const int64_t year = 2000 + std::stoi(fields[9].substr(4, 2));
+            time = static_cast<double>(days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60) + seconds;
+        }
+    catch (const std::exception&)
+        {
+            return false;
+        }
+    return true;
+}
+}  // namespace
+
+
+Segment_Stitcher::Segment_Stitcher(double phase_tolerance_cycles, double epoch_tolerance_s)
+    : d_phase_tolerance_cycles(phase_tolerance_cycles),
+      d_epoch_tolerance_s(epoch_tolerance_s)
+{
+}
+
+
+bool Segment_Stitcher::stitch_rinex_obs(const std::vector<std::string>& segment_files, const std::string& output_file)
+{
+    d_continued_arcs = 0;
+    d_broken_arcs = 0;
+    Rinex_Obs_File merged;
+    bool have_header = false;
+    for (const auto& filename : segment_files)
+        {
+            Rinex_Obs_File next;
+            if (!read_rinex_obs(filename, next))
+                {
+                    return false;
+                }
+            if (next.epochs.empty())
+                {
+                    LOG(INFO) << "RINEX observation file " << filename << " has no epochs";
+                    continue;
+                }
+            if (!have_header)
+                {
+                    merged = std::move(next);
+                    have_header = true;
+                    continue;
+                }
+            if (next.obs_types != merged.obs_types)
+                {
+                    LOG(WARNING) << "The observation types in " << filename << " do not match those of the previous segments";
+                    return false;
+                }
+
+            const double last_time = merged.epochs.back().time;
+            std::set<std::string> tracked_at_boundary;
+            if (!merged.epochs.back().event)
+                {
+                    for (const auto& record : merged.epochs.back().records)
+                        {
+                            tracked_at_boundary.insert(record.substr(0, SAT_ID_WIDTH));
+                        }
+                }
+
+            // Differences of carrier phase between both segments over the common epochs
+            std::map<std::pair<std::string, std::size_t>, std::vector<double>> differences;
+            std::map<std::string, std::size_t> first_common_epoch;
+            std::size_t first_new_epoch = next.epochs.size();
+            for (std::size_t k = 0; k < next.epochs.size(); k++)
+                {
+                    const auto& epoch = next.epochs[k];
+                    if (epoch.time > last_time + d_epoch_tolerance_s)
+                        {
+                            first_new_epoch = k;
+                            break;
+                        }
+                    if (epoch.event)
+                        {
+                            continue;
+                        }
+                    auto previous = std::lower_bound(merged.epochs.cbegin(), merged.epochs.cend(), epoch.time - d_epoch_tolerance_s,
+                        [](const Obs_Epoch& e, double t) { return e.time < t; });
+                    while (previous != merged.epochs.cend() && previous->event && previous->time <= epoch.time + d_epoch_tolerance_s)
+                        {
+                            ++previous;
+                        }
+                    if (previous == merged.epochs.cend() || std::abs(previous->time - epoch.time) > d_epoch_tolerance_s)
+                        {
+                            continue;
+                        }
+                    std::map<std::string, const std::string*> previous_records;
+                    for (const auto& record : previous->records)
+                        {
+                            previous_records[record.substr(0, SAT_ID_WIDTH)] = &record;
+                        }
+                    for (const auto& record : epoch.records)
+                        {
+                            const std::string sat = record.substr(0, SAT_ID_WIDTH);
+                            const auto match = previous_records.find(sat);
+                            if (match == previous_records.cend())
+                                {
+                                    continue;
+                                }
+                            for (const auto field : phase_fields(merged.obs_types, sat[0]))
+                                {
+                                    double phase_next = 0.0;
+                                    double phase_previous = 0.0;
+                                    if (read_obs_value(record, field, phase_next) && read_obs_value(*match->second, field, phase_previous))
+                                        {
+                                            differences[{sat, field}].push_back(phase_next - phase_previous);
+                                            first_common_epoch.emplace(sat, k);
+                                        }
+                                }
+                        }
+                }
+
+            // Integer number of cycles to remove from the arcs that continue across the boundary
+            std::map<std::pair<std::string, std::size_t>, double> shifts;
+            for (const auto& d : differences)
+                {
+                    if (d.second.size() < MIN_COMMON_EPOCHS)
+                        {
+                            continue;
+                        }
+                    const auto minmax = std::minmax_element(d.second.cbegin(), d.second.cend());
+                    double mean = 0.0;
+                    for (const auto diff : d.second)
+                        {
+                            mean += diff;
+                        }
+                    mean /= static_cast<double>(d.second.size());
+                    if (*minmax.second - *minmax.first <= d_phase_tolerance_cycles && std::abs(mean - std::round(mean)) <= d_phase_tolerance_cycles)
+                        {
+                            shifts[d.first] = std::round(mean);
+                        }
+                }
+
+            // An arc ends when the satellite misses an epoch
+            std::map<std::string, bool> arc_alive;
+            for (const auto& f : first_common_epoch)
+                {
+                    arc_alive[f.first] = true;
+                }
+            std::set<std::string> seen_after_boundary;
+            for (std::size_t k = 0; k < next.epochs.size(); k++)
+                {
+                    auto& epoch = next.epochs[k];
+                    if (!epoch.event)
+                        {
+                            std::set<std::string> present;
+                            for (const auto& record : epoch.records)
+                                {
+                                    present.insert(record.substr(0, SAT_ID_WIDTH));
+                                }
+                            for (auto& arc : arc_alive)
+                                {
+                                    if (arc.second && k > first_common_epoch[arc.first] && present.count(arc.first) == 0)
+                                        {
+                                            arc.second = false;
+                                        }
+                                }
+                        }
+                    if (k < first_new_epoch)
+                        {
+                            continue;
+                        }
+                    if (!epoch.event)
+                        {
+                            for (auto& record : epoch.records)
+                                {
+                                    const std::string sat = record.substr(0, SAT_ID_WIDTH);
+                                    const bool first_after_boundary = seen_after_boundary.insert(sat).second;
+                                    const auto alive = arc_alive.find(sat);
+                                    for (const auto field : phase_fields(merged.obs_types, sat[0]))
+                                        {
+                                            const auto shift = shifts.find({sat, field});
+                                            double phase = 0.0;
+                                            if (alive != arc_alive.cend() && alive->second && shift != shifts.cend())
+                                                {
+                                                    if (read_obs_value(record, field, phase))
+                                                        {
+                                                            write_obs_value(record, field, phase - shift->second);
+                                                        }
+                                                    if (first_after_boundary)
+                                                        {
+                                                            d_continued_arcs++;
+                                                        }
+                                                }
+                                            else if (first_after_boundary && tracked_at_boundary.count(sat) != 0 && read_obs_value(record, field, phase))
+                                                {
+                                                    set_loss_of_lock(record, field);
+                                                    d_broken_arcs++;
+                                                }
+                                        }
+                                }
+                        }
+                    merged.epochs.push_back(std::move(epoch));
+                }
+        }
+
+    if (!have_header)
+        {
+            LOG(WARNING) << "No observations to write in " << output_file;
+            return false;
+        }
+    std::vector<std::string> lines = merged.header;
+    for (const auto& epoch : merged.epochs)
+        {
+            lines.push_back(epoch.line);
+            lines.insert(lines.end(), epoch.records.cbegin(), epoch.records.cend());
+        }
+    return write_text_file(output_file, lines);
+}
+
+
+bool Segment_Stitcher::stitch_rinex_nav(const std::vector<std::string>& segment_files, const std::string& output_file) const
+{
+    std::vector<std::string> header;
+    std::vector<std::string> records;
+    std::set<std::string> written_records;
+    for (const auto& filename : segment_files)
+        {
+            std::vector<std::string> lines;
+            if (!read_text_file(filename, lines))
+                {
+                    return false;
+                }
+            std::size_t first_record = 0;
+            while (first_record < lines.size() && header_label(lines[first_record]) != "END OF HEADER")
+                {
+                    first_record++;
+                }
+            if (first_record == lines.size())
+                {
+                    LOG(WARNING) << "File " << filename << " is not a RINEX navigation file";
+                    return false;
+                }
+            first_record++;
+            const std::vector<std::string> segment_header(lines.cbegin(), lines.cbegin() + first_record);
+            if (!is_rinex_3(segment_header))
+                {
+                    LOG(WARNING) << "File " << filename << " is not a RINEX 3 navigation file";
+                    return false;
+                }
+            if (header.empty())
+                {
+                    header = segment_header;
+                }
+
+            // Each record starts with the satellite identifier in the first column
+            std::string record;
+            for (std::size_t i = first_record; i <= lines.size(); i++)
+                {
+                    if (i == lines.size() || (!lines[i].empty() && lines[i][0] != ' '))
+                        {
+                            if (!record.empty() && written_records.insert(record).second)
+                                {
+                                    records.push_back(record);
+                                }
+                            record.clear();
+                        }
+                    if (i < lines.size() && !lines[i].empty())
+                        {
+                            record += lines[i] + '\n';
+                        }
+                }
+        }
+    if (header.empty())
+        {
+            LOG(WARNING) << "No navigation data to write in " << output_file;
+            return false;
+        }
+    std::ofstream out(output_file, std::ios::out | std::ios::trunc);
+    if (!out.is_open())
+        {
+            LOG(WARNING) << "Cannot create file " << output_file;
+            return false;
+        }
+    for (const auto& line : header)
+        {
+            out << line << '\n';
+        }
+    for (const auto& record : records)
+        {
+            out << record;
+        }
+    return out.good();
+}
+
+
+bool Segment_Stitcher::stitch_nmea(const std::vector<std::string>& segment_files, const std::string& output_file) const
+{
+    std::vector<std::string> output;
+    double last_time = -std::numeric_limits<double>::infinity();
+    bool first_file = true;
+    for (const auto& filename : segment_files)
+        {
+            std::vector<std::string> lines;
+            if (!read_text_file(filename, lines))
+                {
+                    return false;
+                }
+            // Sentences before the first RMC are only kept from the first segment
+            bool keep = first_file;
+            double segment_last_time = last_time;
+            for (const auto& line : lines)
+                {
+                    double time = 0.0;
+                    if (line.size() > 6 && line[0] == '$' && line.compare(3, 3, "RMC") == 0 && parse_rmc_time(line, time))
+                        {
+                            keep = time > last_time + d_epoch_tolerance_s;
+                            if (keep)
+                                {
+                                    segment_last_time = time;
+                                }
+                        }
+                    if (keep)
+                        {
+                            output.push_back(line);
+                        }
+                }
+            last_time = segment_last_time;
+            first_file = false;
+        }
+    return write_text_file(output_file, output);
+}
@@ -0,0 +1,94 @@
+/*!
+ * \file segment_stitcher.h
+ * \brief Interface of a class that joins the RINEX and NMEA outputs of
+ * receivers that processed consecutive, overlapping time segments of the
+ * same capture.
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_SEGMENT_STITCHER_H
+#define GNSS_SDR_SEGMENT_STITCHER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Joins the outputs of segments of a capture that were processed
+ * independently, given in chronological order. Each segment must start
+ * before the previous one ends, so the overlapping epochs can be used to
+ * hand over the carrier phase from one segment to the next.
+ *
+ * All the epochs of a segment are kept, and the next one only contributes
+ * the epochs after the last one already written. For each satellite and
+ * carrier phase observable tracked across the boundary, the difference
+ * between both segments over the common epochs must be stable and close to
+ * an integer number of cycles. If so, that integer is removed from the rest
+ * of the arc in the later segment, so the phase is continuous. If not, the
+ * first observation after the boundary is marked with the loss of lock
+ * indicator.
+ *
+ * Only RINEX 3 files are supported.
+ */
+class Segment_Stitcher
+{
+public:
+    /*!
+     * \brief Constructor. Differences of carrier phase between segments
+     * that spread more than phase_tolerance_cycles, or whose mean is
+     * further than that from an integer, break the continuity. Epochs are
+     * considered the same if their timestamps are closer than
+     * epoch_tolerance_s.
+     */
+    explicit Segment_Stitcher(double phase_tolerance_cycles = 0.15, double epoch_tolerance_s = 1e-4);
+
+    /*!
+     * \brief Joins RINEX 3 observation files. Returns false if a file
+     * cannot be read or written, or if the observation types of the
+     * segments do not match.
+     */
+    bool stitch_rinex_obs(const std::vector<std::string>& segment_files, const std::string& output_file);
+
+    /*!
+     * \brief Joins RINEX 3 navigation files, dropping repeated records.
+     */
+    bool stitch_rinex_nav(const std::vector<std::string>& segment_files, const std::string& output_file) const;
+
+    /*!
+     * \brief Joins NMEA files. Each fix starts with a RMC sentence, and the
+     * fixes of a segment that are not later than the last written one are
+     * dropped.
+     */
+    bool stitch_nmea(const std::vector<std::string>& segment_files, const std::string& output_file) const;
+
+    inline uint32_t continued_arcs() const { return d_continued_arcs; }  //!< Carrier phase arcs continued in the last call to stitch_rinex_obs
+    inline uint32_t broken_arcs() const { return d_broken_arcs; }        //!< Carrier phase arcs marked with loss of lock in the last call to stitch_rinex_obs
+
+private:
+    double d_phase_tolerance_cycles;
+    double d_epoch_tolerance_s;
+    uint32_t d_continued_arcs{0};
+    uint32_t d_broken_arcs{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SEGMENT_STITCHER_H
@@ -66,12 +66,6 @@ BeidouB3iPcpsAcquisition::BeidouB3iPcpsAcquisition(
     acquisition_ = pcps_make_acquisition(acq_parameters_);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
 
-    if (item_type_ == "cbyte")
-        {
-            cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
-            float_to_complex_ = gr::blocks::float_to_complex::make();
-        }
-
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -135,6 +129,11 @@ void BeidouB3iPcpsAcquisition::init()
 
 void BeidouB3iPcpsAcquisition::set_local_code()
 {
+    if (acquisition_->set_local_code_from_cache())
+        {
+            return;
+        }
+
     volk_gnsssdr::vector<std::complex<float>> code(code_length_);
 
     beidou_b3i_code_gen_complex_sampled(code, gnss_synchro_->PRN, fs_in_, 0);
@@ -161,20 +160,12 @@ void BeidouB3iPcpsAcquisition::set_state(int state)
 }
 
 
-void BeidouB3iPcpsAcquisition::connect(gr::top_block_sptr top_block)
+void BeidouB3iPcpsAcquisition::connect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to connect
         }
-    else if (item_type_ == "cbyte")
-        {
-            // Since a byte-based acq implementation is not available,
-            // we just convert cshorts to gr_complex
-            top_block->connect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->connect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -182,18 +173,12 @@ void BeidouB3iPcpsAcquisition::connect(gr::top_block_sptr top_block)
 }
 
 
-void BeidouB3iPcpsAcquisition::disconnect(gr::top_block_sptr top_block)
+void BeidouB3iPcpsAcquisition::disconnect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to disconnect
         }
-    else if (item_type_ == "cbyte")
-        {
-            top_block->disconnect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->disconnect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -203,19 +188,7 @@ void BeidouB3iPcpsAcquisition::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr BeidouB3iPcpsAcquisition::get_left_block()
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
-        {
-            return acquisition_;
-        }
-    if (item_type_ == "cbyte")
-        {
-            return cbyte_to_float_x2_;
-        }
-    else
-        {
-            LOG(WARNING) << item_type_ << " unknown acquisition item type";
-            return nullptr;
-        }
+    return acquisition_;
 }
 
 
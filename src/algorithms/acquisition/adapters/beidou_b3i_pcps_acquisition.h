@@ -20,10 +20,8 @@
 
 #include "acq_conf.h"
 #include "channel_fsm.h"
-#include "complex_byte_to_float_x2.h"
 #include "gnss_synchro.h"
 #include "pcps_acquisition.h"
-#include <gnuradio/blocks/float_to_complex.h>
 #include <gnuradio/blocks/stream_to_vector.h>
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>
 #include <cstdint>
@@ -154,8 +152,6 @@ private:
     pcps_acquisition_sptr acquisition_;
     volk_gnsssdr::vector<std::complex<float>> code_;
     std::weak_ptr<ChannelFsm> channel_fsm_;
-    gr::blocks::float_to_complex::sptr float_to_complex_;
-    complex_byte_to_float_x2_sptr cbyte_to_float_x2_;
     Gnss_Synchro* gnss_synchro_;
     Acq_Conf acq_parameters_;
     std::string item_type_;
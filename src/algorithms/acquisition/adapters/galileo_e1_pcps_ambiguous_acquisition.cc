@@ -71,12 +71,6 @@ GalileoE1PcpsAmbiguousAcquisition::GalileoE1PcpsAmbiguousAcquisition(
     acquisition_ = pcps_make_acquisition(acq_parameters_);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
 
-    if (item_type_ == "cbyte")
-        {
-            cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
-            float_to_complex_ = gr::blocks::float_to_complex::make();
-        }
-
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -151,6 +145,16 @@ void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
     bool cboc = configuration_->property(
         "Acquisition" + std::to_string(channel_) + ".cboc", false);
 
+    std::string code_options = (acquire_pilot_ ? std::string("1C") : std::string(gnss_synchro_->Signal, 2));
+    if (cboc)
+        {
+            code_options += ",cboc";
+        }
+    if (acquisition_->set_local_code_from_cache(code_options))
+        {
+            return;
+        }
+
     volk_gnsssdr::vector<std::complex<float>> code(code_length_);
 
     if (acquire_pilot_ == true)
@@ -192,7 +196,7 @@ void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
             std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
-    acquisition_->set_local_code(code_.data());
+    acquisition_->set_local_code(code_.data(), code_options);
 }
 
 
@@ -208,20 +212,12 @@ void GalileoE1PcpsAmbiguousAcquisition::set_state(int state)
 }
 
 
-void GalileoE1PcpsAmbiguousAcquisition::connect(gr::top_block_sptr top_block)
+void GalileoE1PcpsAmbiguousAcquisition::connect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to connect
         }
-    else if (item_type_ == "cbyte")
-        {
-            // Since a byte-based acq implementation is not available,
-            // we just convert cshorts to gr_complex
-            top_block->connect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->connect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -229,18 +225,12 @@ void GalileoE1PcpsAmbiguousAcquisition::connect(gr::top_block_sptr top_block)
 }
 
 
-void GalileoE1PcpsAmbiguousAcquisition::disconnect(gr::top_block_sptr top_block)
+void GalileoE1PcpsAmbiguousAcquisition::disconnect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to disconnect
         }
-    else if (item_type_ == "cbyte")
-        {
-            top_block->disconnect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->disconnect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -250,17 +240,7 @@ void GalileoE1PcpsAmbiguousAcquisition::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr GalileoE1PcpsAmbiguousAcquisition::get_left_block()
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
-        {
-            return acquisition_;
-        }
-    if (item_type_ == "cbyte")
-        {
-            return cbyte_to_float_x2_;
-        }
-
-    LOG(WARNING) << item_type_ << " unknown acquisition item type";
-    return nullptr;
+    return acquisition_;
 }
 
 
@@ -144,7 +144,6 @@ void GalileoE5aPcpsAcquisition::init()
 
 void GalileoE5aPcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
     std::array<char, 3> signal_{};
     signal_[0] = '5';
     signal_[2] = '\0';
@@ -162,6 +161,14 @@ void GalileoE5aPcpsAcquisition::set_local_code()
             signal_[1] = 'I';
         }
 
+    const std::string code_options(signal_.data());
+    if (acquisition_->set_local_code_from_cache(code_options))
+        {
+            return;
+        }
+
+    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
+
     if (acq_parameters_.use_automatic_resampler)
         {
             galileo_e5_a_code_gen_complex_sampled(code, gnss_synchro_->PRN, signal_, acq_parameters_.resampled_fs, 0);
@@ -176,7 +183,7 @@ void GalileoE5aPcpsAcquisition::set_local_code()
             std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
-    acquisition_->set_local_code(code_.data());
+    acquisition_->set_local_code(code_.data(), code_options);
 }
 
 
@@ -194,7 +201,7 @@ void GalileoE5aPcpsAcquisition::set_state(int state)
 
 void GalileoE5aPcpsAcquisition::connect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to connect
         }
@@ -207,7 +214,7 @@ void GalileoE5aPcpsAcquisition::connect(gr::top_block_sptr top_block __attribute
 
 void GalileoE5aPcpsAcquisition::disconnect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to disconnect
         }
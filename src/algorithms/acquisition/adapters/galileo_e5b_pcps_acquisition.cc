@@ -142,7 +142,6 @@ void GalileoE5bPcpsAcquisition::init()
 
 void GalileoE5bPcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
     std::array<char, 3> signal_{};
     signal_[0] = '7';
     signal_[2] = '\0';
@@ -160,6 +159,14 @@ void GalileoE5bPcpsAcquisition::set_local_code()
             signal_[1] = 'I';
         }
 
+    const std::string code_options(signal_.data());
+    if (acquisition_->set_local_code_from_cache(code_options))
+        {
+            return;
+        }
+
+    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
+
     if (acq_parameters_.use_automatic_resampler)
         {
             galileo_e5_b_code_gen_complex_sampled(code, gnss_synchro_->PRN, signal_, acq_parameters_.resampled_fs, 0);
@@ -174,7 +181,7 @@ void GalileoE5bPcpsAcquisition::set_local_code()
             std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
-    acquisition_->set_local_code(code_.data());
+    acquisition_->set_local_code(code_.data(), code_options);
 }
 
 
@@ -192,7 +199,7 @@ void GalileoE5bPcpsAcquisition::set_state(int state)
 
 void GalileoE5bPcpsAcquisition::connect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if ((item_type_ == "gr_complex") || (item_type_ == "cshort"))
+    if ((item_type_ == "gr_complex") || (item_type_ == "cshort") || (item_type_ == "cbyte"))
         {
             // nothing to connect
         }
@@ -205,7 +212,7 @@ void GalileoE5bPcpsAcquisition::connect(gr::top_block_sptr top_block __attribute
 
 void GalileoE5bPcpsAcquisition::disconnect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if ((item_type_ == "gr_complex") || (item_type_ == "cshort"))
+    if ((item_type_ == "gr_complex") || (item_type_ == "cshort") || (item_type_ == "cbyte"))
         {
             // nothing to disconnect
         }
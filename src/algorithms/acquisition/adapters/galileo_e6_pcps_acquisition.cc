@@ -70,12 +70,6 @@ GalileoE6PcpsAcquisition::GalileoE6PcpsAcquisition(
     acquisition_ = pcps_make_acquisition(acq_parameters_);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
 
-    if (item_type_ == "cbyte")
-        {
-            cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
-            float_to_complex_ = gr::blocks::float_to_complex::make();
-        }
-
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -147,6 +141,11 @@ void GalileoE6PcpsAcquisition::init()
 
 void GalileoE6PcpsAcquisition::set_local_code()
 {
+    if (acquisition_->set_local_code_from_cache())
+        {
+            return;
+        }
+
     volk_gnsssdr::vector<std::complex<float>> code(code_length_);
 
     if (acq_parameters_.use_automatic_resampler)
@@ -182,20 +181,12 @@ void GalileoE6PcpsAcquisition::set_state(int state)
 }
 
 
-void GalileoE6PcpsAcquisition::connect(gr::top_block_sptr top_block)
+void GalileoE6PcpsAcquisition::connect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to connect
         }
-    else if (item_type_ == "cbyte")
-        {
-            // Since a byte-based acq implementation is not available,
-            // we just convert cshorts to gr_complex
-            top_block->connect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->connect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -203,18 +194,12 @@ void GalileoE6PcpsAcquisition::connect(gr::top_block_sptr top_block)
 }
 
 
-void GalileoE6PcpsAcquisition::disconnect(gr::top_block_sptr top_block)
+void GalileoE6PcpsAcquisition::disconnect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to disconnect
         }
-    else if (item_type_ == "cbyte")
-        {
-            top_block->disconnect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->disconnect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -224,17 +209,7 @@ void GalileoE6PcpsAcquisition::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr GalileoE6PcpsAcquisition::get_left_block()
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
-        {
-            return acquisition_;
-        }
-    if (item_type_ == "cbyte")
-        {
-            return cbyte_to_float_x2_;
-        }
-
-    LOG(WARNING) << item_type_ << " unknown acquisition item type";
-    return nullptr;
+    return acquisition_;
 }
 
 
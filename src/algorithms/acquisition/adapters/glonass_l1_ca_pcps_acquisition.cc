@@ -70,12 +70,6 @@ GlonassL1CaPcpsAcquisition::GlonassL1CaPcpsAcquisition(
     acquisition_ = pcps_make_acquisition(acq_parameters_);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
 
-    if (item_type_ == "cbyte")
-        {
-            cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
-            float_to_complex_ = gr::blocks::float_to_complex::make();
-        }
-
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -141,6 +135,11 @@ void GlonassL1CaPcpsAcquisition::init()
 
 void GlonassL1CaPcpsAcquisition::set_local_code()
 {
+    if (acquisition_->set_local_code_from_cache())
+        {
+            return;
+        }
+
     volk_gnsssdr::vector<std::complex<float>> code(code_length_);
 
     glonass_l1_ca_code_gen_complex_sampled(code, fs_in_, 0);
@@ -167,18 +166,12 @@ void GlonassL1CaPcpsAcquisition::set_state(int state)
 }
 
 
-void GlonassL1CaPcpsAcquisition::connect(gr::top_block_sptr top_block)
+void GlonassL1CaPcpsAcquisition::connect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to connect
         }
-    else if (item_type_ == "cbyte")
-        {
-            top_block->connect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->connect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -186,20 +179,12 @@ void GlonassL1CaPcpsAcquisition::connect(gr::top_block_sptr top_block)
 }
 
 
-void GlonassL1CaPcpsAcquisition::disconnect(gr::top_block_sptr top_block)
+void GlonassL1CaPcpsAcquisition::disconnect(gr::top_block_sptr top_block __attribute__((unused)))
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to disconnect
         }
-    else if (item_type_ == "cbyte")
-        {
-            // Since a byte-based acq implementation is not available,
-            // we just convert cshorts to gr_complex
-            top_block->disconnect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->disconnect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -209,17 +194,7 @@ void GlonassL1CaPcpsAcquisition::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr GlonassL1CaPcpsAcquisition::get_left_block()
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
-        {
-            return acquisition_;
-        }
-    if (item_type_ == "cbyte")
-        {
-            return cbyte_to_float_x2_;
-        }
-
-    LOG(WARNING) << item_type_ << " unknown acquisition item type";
-    return nullptr;
+    return acquisition_;
 }
 
 
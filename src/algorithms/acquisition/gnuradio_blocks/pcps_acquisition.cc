@@ -71,6 +71,7 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_consumed_samples(conf_.sampled_ms * conf_.samples_per_ms * (conf_.bit_transition_flag ? 2.0 : 1.0)),
       d_num_doppler_bins(0U),
       d_num_doppler_bins_step2(conf_.num_doppler_bins_step2),
+      d_doppler_rotation_step_bins(0U),
       d_dump_channel(conf_.dump_channel),
       d_buffer_count(0U),
       d_active(false),
@@ -108,27 +109,28 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
     // }
 
     d_tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
-    d_fft_codes = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
+    d_fft_codes = std::make_shared<volk_gnsssdr::vector<std::complex<float>>>(d_fft_size);
     d_input_signal = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
-    d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
-    d_ifft = gnss_fft_rev_make_unique(d_fft_size);
+
+    if (d_acq_parameters.doppler_search_threads != 1)
+        {
+            d_worker_pool = Acq_Worker_Pool::get_shared(d_acq_parameters.doppler_search_threads);
+            d_search_tmp_buffers = std::vector<volk_gnsssdr::vector<float>>(d_worker_pool->size() - 1, volk_gnsssdr::vector<float>(d_fft_size));
+        }
 
     d_grid = arma::fmat();
     d_narrow_grid = arma::fmat();
 
-    if (conf_.it_size == sizeof(gr_complex))
+    // cshort and cbyte samples are stored as received, and converted to
+    // gr_complex once per dwell
+    if (d_acq_parameters.item_type == "gr_complex")
         {
-            d_cshort = false;
+            d_data_buffer = volk_gnsssdr::vector<std::complex<float>>(d_consumed_samples);
         }
     else
         {
-            d_cshort = true;
-        }
-
-    d_data_buffer = volk_gnsssdr::vector<std::complex<float>>(d_consumed_samples);
-    if (d_cshort)
-        {
-            d_data_buffer_sc = volk_gnsssdr::vector<lv_16sc_t>(d_consumed_samples);
+            d_input_converter = make_vector_converter(d_acq_parameters.item_type, "gr_complex");
+            d_data_buffer_raw = volk_gnsssdr::vector<uint8_t>(d_consumed_samples * d_acq_parameters.it_size);
         }
 
     if (d_dump)
@@ -162,6 +164,7 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
                     d_dump = false;
                 }
         }
+    d_counters = Block_Instrumentation::instance().register_block(this->name());
 }
 
 
@@ -172,7 +175,7 @@ void pcps_acquisition::set_resampler_latency(uint32_t latency_samples)
 }
 
 
-void pcps_acquisition::set_local_code(std::complex<float>* code)
+void pcps_acquisition::set_local_code(std::complex<float>* code, const std::string& code_options)
 {
     // This will check if it's fdma, if yes will update the intermediate frequency and the doppler grid
     if (is_fdma())
@@ -184,27 +187,64 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
     // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
     // where c_i is the local code and there are L zeros and L chips
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    Acq_Fft_Plans plans(d_fft_size);
+    gr_complex* padded_code = plans.fwd()->get_inbuf();
+    std::fill_n(padded_code, d_fft_size, gr_complex(0.0, 0.0));
     if (d_acq_parameters.bit_transition_flag)
         {
             const int32_t offset = d_fft_size / 2;
-            std::fill_n(d_fft_if->get_inbuf(), offset, gr_complex(0.0, 0.0));
-            std::copy(code, code + offset, d_fft_if->get_inbuf() + offset);
+            std::copy(code, code + offset, padded_code + offset);
         }
     else
         {
             if (d_acq_parameters.sampled_ms == d_acq_parameters.ms_per_code)
                 {
-                    std::copy(code, code + d_consumed_samples, d_fft_if->get_inbuf());
+                    std::copy(code, code + d_consumed_samples, padded_code);
                 }
             else
                 {
-                    std::fill_n(d_fft_if->get_inbuf(), d_fft_size - d_consumed_samples, gr_complex(0.0, 0.0));
-                    std::copy(code, code + d_consumed_samples, d_fft_if->get_inbuf() + d_consumed_samples);
+                    std::copy(code, code + d_consumed_samples, padded_code + (d_fft_size - d_consumed_samples));
                 }
         }
 
-    d_fft_if->execute();  // We need the FFT of local code
-    volk_32fc_conjugate_32fc(d_fft_codes.data(), d_fft_if->get_outbuf(), d_fft_size);
+    plans.fwd()->execute();  // We need the FFT of local code
+    auto fft_codes = std::make_shared<volk_gnsssdr::vector<std::complex<float>>>(d_fft_size);
+    volk_32fc_conjugate_32fc(fft_codes->data(), plans.fwd()->get_outbuf(), d_fft_size);
+    // The conjugated FFT of the local code is shared by all the channels
+    // acquiring the same replica
+    Acq_Fft_Cache::get_instance().store_code_spectrum(code_spectrum_key(code_options), fft_codes);
+    d_fft_codes = std::move(fft_codes);
+}
+
+
+bool pcps_acquisition::set_local_code_from_cache(const std::string& code_options)
+{
+    auto fft_codes = Acq_Fft_Cache::get_instance().find_code_spectrum(code_spectrum_key(code_options));
+    if (fft_codes == nullptr)
+        {
+            return false;
+        }
+    if (is_fdma())
+        {
+            update_grid_doppler_wipeoffs();
+        }
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    d_fft_codes = std::move(fft_codes);
+    return true;
+}
+
+
+Acq_Code_Spectrum_Key pcps_acquisition::code_spectrum_key(const std::string& code_options) const
+{
+    Acq_Code_Spectrum_Key key;
+    key.signal = std::string(1, d_gnss_synchro->System) + std::string(d_gnss_synchro->Signal, 2);
+    key.code_options = code_options;
+    key.prn = d_gnss_synchro->PRN;
+    key.fs = (d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    key.fft_size = d_fft_size;
+    key.sampled_ms = d_acq_parameters.sampled_ms;
+    key.bit_transition = d_acq_parameters.bit_transition_flag;
+    return key;
 }
 
 
@@ -260,10 +300,13 @@ void pcps_acquisition::init()
 
     d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(2 * d_acq_parameters.doppler_max) / static_cast<double>(d_doppler_step)));
 
-    // Create the carrier Doppler wipeoff signals
-    if (d_grid_doppler_wipeoffs.empty())
+    // Create the carrier Doppler wipeoff signals. With the FFT rotation
+    // search only the wipeoff of the first Doppler bin is needed
+    d_doppler_rotation_step_bins = doppler_rotation_step_bins();
+    const uint32_t num_wipeoffs = (d_doppler_rotation_step_bins > 0 ? 1U : d_num_doppler_bins);
+    if (d_grid_doppler_wipeoffs.size() != num_wipeoffs)
         {
-            d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
+            d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(num_wipeoffs, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
         }
     if (d_acq_parameters.make_2_steps && (d_grid_doppler_wipeoffs_step_two.empty()))
         {
@@ -292,9 +335,33 @@ void pcps_acquisition::init()
 }
 
 
+uint32_t pcps_acquisition::doppler_rotation_step_bins() const
+{
+    // A Doppler shift that is a multiple of the FFT resolution is a circular
+    // rotation of the input spectrum, so the grid can be searched with a
+    // single forward FFT if the Doppler step is a multiple of that resolution
+    if (!d_acq_parameters.doppler_fft_rotation)
+        {
+            return 0U;
+        }
+    const double fs = static_cast<double>(d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    const double step_bins = static_cast<double>(d_doppler_step) * static_cast<double>(d_fft_size) / fs;
+    const double rounded_step_bins = std::round(step_bins);
+    if (rounded_step_bins < 1.0 or std::abs(step_bins - rounded_step_bins) > 1e-6)
+        {
+            LOG(WARNING) << "Channel " << d_channel << ": doppler_step=" << d_doppler_step
+                         << " Hz is not a multiple of the FFT resolution (" << fs / static_cast<double>(d_fft_size)
+                         << " Hz). Using the per-bin FFT Doppler search.";
+            return 0U;
+        }
+    return static_cast<uint32_t>(rounded_step_bins);
+}
+
+
 void pcps_acquisition::update_grid_doppler_wipeoffs()
 {
-    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+    const uint32_t num_wipeoffs = (d_doppler_rotation_step_bins > 0 ? 1U : d_num_doppler_bins);
+    for (uint32_t doppler_index = 0; doppler_index < num_wipeoffs; doppler_index++)
         {
             const int32_t doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * doppler_index;
             update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
@@ -597,6 +664,96 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
 }
 
 
+void pcps_acquisition::doppler_search(const gr_complex* in,
+    const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+    uint32_t num_doppler_bins,
+    uint32_t rotation_step_bins,
+    arma::fmat& dump_grid)
+{
+    const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+    const bool dump_grid_results = d_dump and d_channel == d_dump_channel;
+
+    // Each worker processes a contiguous range of Doppler bins with its own
+    // FFT plans and scratch buffer, writing only to its own rows of the
+    // magnitude grid. The peak search is done afterwards over the whole grid,
+    // so the result does not depend on the number of workers.
+    // If rotation_step_bins > 0, the spectrum of the input wiped off with the
+    // first bin carrier is computed once and the Doppler bin i is obtained by
+    // rotating it i * rotation_step_bins positions.
+    std::vector<Acq_Fft_Plans> plans;
+    const uint32_t num_workers = (d_worker_pool ? d_worker_pool->size() : 1U);
+    plans.reserve(num_workers);
+    for (uint32_t worker = 0; worker < num_workers; worker++)
+        {
+            plans.emplace_back(d_fft_size);
+        }
+    if (rotation_step_bins > 0)
+        {
+            volk_32fc_x2_multiply_32fc(plans[0].fwd()->get_inbuf(), in, grid_doppler_wipeoffs[0].data(), d_fft_size);
+            plans[0].fwd()->execute();
+        }
+    const gr_complex* input_spectrum = plans[0].fwd()->get_outbuf();
+    const gr_complex* fft_codes = d_fft_codes->data();
+
+    const Acq_Worker_Pool::Task search_bins = [&, this](uint32_t worker, uint32_t bin_begin, uint32_t bin_end) {
+        gnss_fft_complex_fwd* fft_if = plans[worker].fwd();
+        gnss_fft_complex_rev* ifft = plans[worker].rev();
+        float* tmp_buffer = (worker == 0 ? d_tmp_buffer.data() : d_search_tmp_buffers[worker - 1].data());
+        for (uint32_t doppler_index = bin_begin; doppler_index < bin_end; doppler_index++)
+            {
+                if (rotation_step_bins > 0)
+                    {
+                        // Remove Doppler by rotating the input spectrum and multiply it with the local FFT'd code reference
+                        const auto shift = static_cast<uint32_t>((static_cast<uint64_t>(doppler_index) * rotation_step_bins) % d_fft_size);
+                        volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), input_spectrum + shift, fft_codes, d_fft_size - shift);
+                        volk_32fc_x2_multiply_32fc(ifft->get_inbuf() + (d_fft_size - shift), input_spectrum, fft_codes + (d_fft_size - shift), shift);
+                    }
+                else
+                    {
+                        // Remove Doppler
+                        volk_32fc_x2_multiply_32fc(fft_if->get_inbuf(), in, grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
+
+                        // Perform the FFT-based convolution  (parallel time search)
+                        // Compute the FFT of the carrier wiped--off incoming signal
+                        fft_if->execute();
+
+                        // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+                        volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), fft_if->get_outbuf(), fft_codes, d_fft_size);
+                    }
+
+                // Compute the inverse FFT
+                ifft->execute();
+
+                // Compute squared magnitude (and accumulate in case of non-coherent integration)
+                if (d_num_noncoherent_integrations_counter == 1)
+                    {
+                        volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), ifft->get_outbuf() + offset, effective_fft_size);
+                    }
+                else
+                    {
+                        volk_32fc_magnitude_squared_32f(tmp_buffer, ifft->get_outbuf() + offset, effective_fft_size);
+                        volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), tmp_buffer, effective_fft_size);
+                    }
+                // Record results to file if required
+                if (dump_grid_results)
+                    {
+                        std::copy(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data() + effective_fft_size, dump_grid.colptr(doppler_index));
+                    }
+            }
+    };
+
+    if (d_worker_pool)
+        {
+            d_worker_pool->run(num_doppler_bins, search_bins);
+        }
+    else
+        {
+            search_bins(0, 0, num_doppler_bins);
+        }
+}
+
+
 void pcps_acquisition::acquisition_core(uint64_t samp_count)
 {
     gr::thread::scoped_lock lk(d_setlock);
@@ -605,11 +762,14 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     int32_t doppler = 0;
     uint32_t indext = 0U;
     const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
-    if (d_cshort)
+    if (d_input_converter)
         {
-            volk_gnsssdr_16ic_convert_32fc(d_data_buffer.data(), d_data_buffer_sc.data(), d_consumed_samples);
+            d_input_converter(d_input_signal.data(), d_data_buffer_raw.data(), d_consumed_samples);
+        }
+    else
+        {
+            std::copy(d_data_buffer.data(), d_data_buffer.data() + d_consumed_samples, d_input_signal.data());
         }
-    std::copy(d_data_buffer.data(), d_data_buffer.data() + d_consumed_samples, d_input_signal.data());
     if (d_fft_size > d_consumed_samples)
         {
             for (uint32_t i = d_consumed_samples; i < d_fft_size; i++)
@@ -637,38 +797,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     // Doppler frequency grid loop
     if (!d_step_two)
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
-                {
-                    // Remove Doppler
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
-
-                    // Compute the inverse FFT
-                    d_ifft->execute();
-
-                    // Compute squared magnitude (and accumulate in case of non-coherent integration)
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
-                        {
-                            std::copy(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data() + effective_fft_size, d_grid.colptr(doppler_index));
-                        }
-                }
+            doppler_search(in, d_grid_doppler_wipeoffs, d_num_doppler_bins, d_doppler_rotation_step_bins, d_grid);
 
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
@@ -696,37 +825,8 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
     else
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
-                {
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs_step_two[doppler_index].data(), d_fft_size);
+            doppler_search(in, d_grid_doppler_wipeoffs_step_two, d_num_doppler_bins_step2, 0U, d_narrow_grid);
 
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal
-                    // with the local FFT'd code reference using SIMD operations with VOLK library
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
-
-                    // compute the inverse FFT
-                    d_ifft->execute();
-
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
-                        {
-                            std::copy(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data() + effective_fft_size, d_narrow_grid.colptr(doppler_index));
-                        }
-                }
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
                 {
@@ -912,6 +1012,7 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
      * 6. Declare positive or negative acquisition using a message port
      */
     gr::thread::scoped_lock lk(d_setlock);
+    Block_Work_Timer work_timer(d_counters.get(), ninput_items[0]);
     if (!d_active or d_worker_active)
         {
             // do not consume samples while performing a non-coherent integration
@@ -919,6 +1020,7 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
             if ((!d_acq_parameters.blocking_on_standby) && consume_samples)
                 {
                     d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
+                    work_timer.set_items(ninput_items[0]);
                     consume_each(ninput_items[0]);
                 }
             if (d_step_two)
@@ -944,6 +1046,7 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                 if (!d_acq_parameters.blocking_on_standby)
                     {
                         d_sample_counter += static_cast<uint64_t>(ninput_items[0]);  // sample counter
+                        work_timer.set_items(ninput_items[0]);
                         consume_each(ninput_items[0]);
                     }
                 break;
@@ -951,9 +1054,9 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
         case 1:
             {
                 uint32_t buff_increment;
-                if (d_cshort)
+                if (d_input_converter)
                     {
-                        const auto* in = reinterpret_cast<const lv_16sc_t*>(input_items[0]);  // Get the input samples pointer
+                        const auto* in = reinterpret_cast<const uint8_t*>(input_items[0]);  // Get the input samples pointer
                         if ((ninput_items[0] + d_buffer_count) <= d_consumed_samples)
                             {
                                 buff_increment = ninput_items[0];
@@ -962,7 +1065,7 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                             {
                                 buff_increment = d_consumed_samples - d_buffer_count;
                             }
-                        std::copy(in, in + buff_increment, d_data_buffer_sc.begin() + d_buffer_count);
+                        std::copy(in, in + buff_increment * d_acq_parameters.it_size, d_data_buffer_raw.begin() + d_buffer_count * d_acq_parameters.it_size);
                     }
                 else
                     {
@@ -985,6 +1088,7 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                     }
                 d_buffer_count += buff_increment;
                 d_sample_counter += static_cast<uint64_t>(buff_increment);
+                work_timer.set_items(buff_increment);
                 consume_each(buff_increment);
                 break;
             }
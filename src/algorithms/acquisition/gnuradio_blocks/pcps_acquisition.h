@@ -5,7 +5,7 @@
  *  Acquisition strategy (Kay Borre book + CFAR threshold).
  *  <ol>
  *  <li> Compute the input signal power estimation
- *  <li> Doppler serial search loop
+ *  <li> Doppler search loop, optionally split across a pool of worker threads
  *  <li> Perform the FFT-based circular convolution (parallel time search)
  *  <li> Record the maximum peak and the associated synchronization parameters
  *  <li> Compute the test statistics and compare to the threshold
@@ -43,15 +43,18 @@
 #endif
 
 #include "acq_conf.h"
+#include "acq_fft_cache.h"
+#include "acq_worker_pool.h"
+#include "block_instrumentation.h"
 #include "channel_fsm.h"
 #include "gnss_sdr_fft.h"
+#include "item_type_helpers.h"
 #include <armadillo>
 #include <glog/logging.h>
 #include <gnuradio/block.h>
 #include <gnuradio/gr_complex.h>              // for gr_complex
 #include <gnuradio/thread/thread.h>           // for scoped_lock
 #include <gnuradio/types.h>                   // for gr_vector_const_void_star
-#include <volk/volk_complex.h>                // for lv_16sc_t
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <complex>
 #include <cstdint>
@@ -59,6 +62,7 @@
 #include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 #if HAS_STD_SPAN
 #include <span>
@@ -111,10 +115,20 @@ public:
     }
 
     /*!
-     * \brief Sets local code for PCPS acquisition algorithm.
+     * \brief Sets local code for PCPS acquisition algorithm, and shares its
+     * spectrum with the channels that acquire the same replica.
      * \param code - Pointer to the PRN code.
+     * \param code_options - Adapter options that change the replica for the
+     * same signal and PRN (empty if there are none).
      */
-    void set_local_code(std::complex<float>* code);
+    void set_local_code(std::complex<float>* code, const std::string& code_options = std::string());
+
+    /*!
+     * \brief Sets the local code of the current PRN from the spectra already
+     * computed by any channel. Returns false if there is none, and then the
+     * code has to be generated and passed to set_local_code().
+     */
+    bool set_local_code_from_cache(const std::string& code_options = std::string());
 
     /*!
      * \brief If set to 1, ensures that acquisition starts at the
@@ -151,6 +165,7 @@ public:
     inline void set_channel(uint32_t channel)
     {
         d_channel = channel;
+        d_counters->set_channel(static_cast<int32_t>(channel));
     }
 
     /*!
@@ -221,11 +236,18 @@ private:
     void update_local_carrier(own::span<gr_complex> carrier_vector, float freq) const;
     void update_grid_doppler_wipeoffs();
     void update_grid_doppler_wipeoffs_step2();
+    uint32_t doppler_rotation_step_bins() const;
     void acquisition_core(uint64_t samp_count);
+    void doppler_search(const gr_complex* in,
+        const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& grid_doppler_wipeoffs,
+        uint32_t num_doppler_bins,
+        uint32_t rotation_step_bins,
+        arma::fmat& dump_grid);
     void send_negative_acquisition();
     void send_positive_acquisition();
     void dump_results(int32_t effective_fft_size);
     bool is_fdma();
+    Acq_Code_Spectrum_Key code_spectrum_key(const std::string& code_options) const;
     bool start() override;
     void calculate_threshold(void);
     float first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
@@ -236,13 +258,17 @@ private:
     volk_gnsssdr::vector<std::complex<float>> d_input_signal;
     volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs;
     volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs_step_two;
-    volk_gnsssdr::vector<std::complex<float>> d_fft_codes;
+    std::shared_ptr<const volk_gnsssdr::vector<std::complex<float>>> d_fft_codes;
     volk_gnsssdr::vector<std::complex<float>> d_data_buffer;
-    volk_gnsssdr::vector<lv_16sc_t> d_data_buffer_sc;
+    volk_gnsssdr::vector<uint8_t> d_data_buffer_raw;  // cshort and cbyte samples, as received
+    item_type_converter_t d_input_converter;
 
-    std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
-    std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    // Scratch buffers of the Doppler search chunks 1 to N - 1 of the worker
+    // pool. Chunk 0 uses d_tmp_buffer. FFT plans are taken from Acq_Fft_Cache.
+    std::vector<volk_gnsssdr::vector<float>> d_search_tmp_buffers;
+    std::shared_ptr<Acq_Worker_Pool> d_worker_pool;
     std::weak_ptr<ChannelFsm> d_channel_fsm;
+    std::shared_ptr<Block_Counters> d_counters;
 
     Acq_Conf d_acq_parameters;
     Gnss_Synchro* d_gnss_synchro;
@@ -273,12 +299,12 @@ private:
     uint32_t d_consumed_samples;
     uint32_t d_num_doppler_bins;
     uint32_t d_num_doppler_bins_step2;
+    uint32_t d_doppler_rotation_step_bins;
     uint32_t d_dump_channel;
     uint32_t d_buffer_count;
 
     bool d_active;
     bool d_worker_active;
-    bool d_cshort;
     bool d_step_two;
     bool d_use_CFAR_algorithm_flag;
     bool d_dump;
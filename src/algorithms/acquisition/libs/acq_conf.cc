@@ -44,6 +44,12 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     dump_filename = configuration->property(role + ".dump_filename", dump_filename);
 
     use_automatic_resampler = configuration->property("GNSS-SDR.use_acquisition_resampler", use_automatic_resampler);
+    if (use_automatic_resampler && item_type != "gr_complex")
+        {
+            // the acquisition resampler filters gr_complex samples
+            LOG(WARNING) << "GNSS-SDR.use_acquisition_resampler is only available with item_type=gr_complex. Disabling it for " << role;
+            use_automatic_resampler = false;
+        }
 
     if ((sampled_ms % ms_per_code) != 0)
         {
@@ -75,7 +81,9 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
             pfa2 = pfa;
         }
     make_2_steps = configuration->property(role + ".make_two_steps", make_2_steps);
+    doppler_fft_rotation = configuration->property(role + ".doppler_fft_rotation", doppler_fft_rotation);
     blocking_on_standby = configuration->property(role + ".blocking_on_standby", blocking_on_standby);
+    doppler_search_threads = configuration->property(role + ".doppler_search_threads", doppler_search_threads);
 
     if (pfa <= 0.0)
         {
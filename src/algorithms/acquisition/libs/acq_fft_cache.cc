@@ -0,0 +1,103 @@
+/*!
+ * \file acq_fft_cache.cc
+ * \brief Process-wide cache of FFT plans and local code spectra shared by
+ * the acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_fft_cache.h"
+#include <utility>
+
+
+Acq_Fft_Plans::Acq_Fft_Plans(uint32_t fft_size)
+    : d_fft_size(fft_size)
+{
+    Acq_Fft_Cache::get_instance().acquire_plans(d_fft_size, d_fwd, d_rev);
+}
+
+
+Acq_Fft_Plans::~Acq_Fft_Plans()
+{
+    if (d_fwd or d_rev)
+        {
+            Acq_Fft_Cache::get_instance().release_plans(d_fft_size, std::move(d_fwd), std::move(d_rev));
+        }
+}
+
+
+Acq_Fft_Cache& Acq_Fft_Cache::get_instance()
+{
+    static Acq_Fft_Cache instance;
+    return instance;
+}
+
+
+std::shared_ptr<const Acq_Fft_Cache::Code_Spectrum> Acq_Fft_Cache::find_code_spectrum(const Acq_Code_Spectrum_Key& key) const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_code_spectra.find(key);
+    if (it == d_code_spectra.cend())
+        {
+            return nullptr;
+        }
+    return it->second;
+}
+
+
+void Acq_Fft_Cache::store_code_spectrum(const Acq_Code_Spectrum_Key& key, std::shared_ptr<const Code_Spectrum> spectrum)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_code_spectra[key] = std::move(spectrum);
+}
+
+
+void Acq_Fft_Cache::acquire_plans(uint32_t fft_size, std::unique_ptr<gnss_fft_complex_fwd>& fwd, std::unique_ptr<gnss_fft_complex_rev>& rev)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        auto& idle_fwd = d_idle_fwd_plans[fft_size];
+        if (!idle_fwd.empty())
+            {
+                fwd = std::move(idle_fwd.back());
+                idle_fwd.pop_back();
+            }
+        auto& idle_rev = d_idle_rev_plans[fft_size];
+        if (!idle_rev.empty())
+            {
+                rev = std::move(idle_rev.back());
+                idle_rev.pop_back();
+            }
+    }
+    // Plans are created out of the lock, FFT planning can be slow
+    if (!fwd)
+        {
+            fwd = gnss_fft_fwd_make_unique(fft_size);
+        }
+    if (!rev)
+        {
+            rev = gnss_fft_rev_make_unique(fft_size);
+        }
+}
+
+
+void Acq_Fft_Cache::release_plans(uint32_t fft_size, std::unique_ptr<gnss_fft_complex_fwd> fwd, std::unique_ptr<gnss_fft_complex_rev> rev)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (fwd)
+        {
+            d_idle_fwd_plans[fft_size].push_back(std::move(fwd));
+        }
+    if (rev)
+        {
+            d_idle_rev_plans[fft_size].push_back(std::move(rev));
+        }
+}
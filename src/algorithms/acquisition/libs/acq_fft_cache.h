@@ -0,0 +1,131 @@
+/*!
+ * \file acq_fft_cache.h
+ * \brief Process-wide cache of FFT plans and local code spectra shared by
+ * the acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_FFT_CACHE_H
+#define GNSS_SDR_ACQ_FFT_CACHE_H
+
+#include "gnss_sdr_fft.h"
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Identifies the spectrum of a local replica: everything that changes
+ * the padded time-domain code the spectrum is computed from.
+ */
+struct Acq_Code_Spectrum_Key
+{
+    std::string signal;        // system letter + signal name, e.g. "G1C"
+    std::string code_options;  // adapter options that change the replica, e.g. "1C,cboc" for the Galileo E1 pilot with CBOC
+    uint32_t prn{0U};
+    int64_t fs{0LL};
+    uint32_t fft_size{0U};
+    uint32_t sampled_ms{0U};
+    bool bit_transition{false};
+
+    inline bool operator<(const Acq_Code_Spectrum_Key& other) const
+    {
+        return std::tie(signal, code_options, prn, fs, fft_size, sampled_ms, bit_transition) < std::tie(other.signal, other.code_options, other.prn, other.fs, other.fft_size, other.sampled_ms, other.bit_transition);
+    }
+};
+
+
+/*!
+ * \brief Forward and reverse FFT plans of a given size, taken from the
+ * registry of idle plans in Acq_Fft_Cache and given back on destruction.
+ */
+class Acq_Fft_Plans
+{
+public:
+    explicit Acq_Fft_Plans(uint32_t fft_size);
+    ~Acq_Fft_Plans();
+
+    Acq_Fft_Plans(Acq_Fft_Plans&&) = default;
+    Acq_Fft_Plans& operator=(Acq_Fft_Plans&&) = delete;
+    Acq_Fft_Plans(const Acq_Fft_Plans&) = delete;
+    Acq_Fft_Plans& operator=(const Acq_Fft_Plans&) = delete;
+
+    inline gnss_fft_complex_fwd* fwd() const
+    {
+        return d_fwd.get();
+    }
+
+    inline gnss_fft_complex_rev* rev() const
+    {
+        return d_rev.get();
+    }
+
+private:
+    std::unique_ptr<gnss_fft_complex_fwd> d_fwd;
+    std::unique_ptr<gnss_fft_complex_rev> d_rev;
+    uint32_t d_fft_size;
+};
+
+
+/*!
+ * \brief Thread-safe, process-wide cache shared by the acquisition blocks.
+ *
+ * It holds:
+ * - A registry of idle FFT plans, keyed by FFT size. Plans hold their own
+ *   buffers, so they are lent to one user at a time (see Acq_Fft_Plans), and
+ *   only as many plans as concurrent acquisitions are ever created.
+ * - The conjugated spectra of the local codes, so a channel reassigned to a
+ *   PRN already seen by any channel needs a lookup instead of generating the
+ *   code and computing its FFT. The adapter options that change the replica
+ *   (e.g. data or pilot component) are part of the key.
+ */
+class Acq_Fft_Cache
+{
+public:
+    using Code_Spectrum = volk_gnsssdr::vector<std::complex<float>>;
+
+    static Acq_Fft_Cache& get_instance();
+
+    std::shared_ptr<const Code_Spectrum> find_code_spectrum(const Acq_Code_Spectrum_Key& key) const;
+
+    void store_code_spectrum(const Acq_Code_Spectrum_Key& key, std::shared_ptr<const Code_Spectrum> spectrum);
+
+private:
+    friend class Acq_Fft_Plans;
+
+    Acq_Fft_Cache() = default;
+
+    void acquire_plans(uint32_t fft_size, std::unique_ptr<gnss_fft_complex_fwd>& fwd, std::unique_ptr<gnss_fft_complex_rev>& rev);
+    void release_plans(uint32_t fft_size, std::unique_ptr<gnss_fft_complex_fwd> fwd, std::unique_ptr<gnss_fft_complex_rev> rev);
+
+    std::map<Acq_Code_Spectrum_Key, std::shared_ptr<const Code_Spectrum>> d_code_spectra;
+    std::map<uint32_t, std::vector<std::unique_ptr<gnss_fft_complex_fwd>>> d_idle_fwd_plans;
+    std::map<uint32_t, std::vector<std::unique_ptr<gnss_fft_complex_rev>>> d_idle_rev_plans;
+    mutable std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_FFT_CACHE_H
@@ -0,0 +1,143 @@
+/*!
+ * \file acq_worker_pool.cc
+ * \brief Pool of worker threads that split the Doppler bins of an
+ * acquisition grid search.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_worker_pool.h"
+#include <algorithm>
+#include <map>
+
+
+std::shared_ptr<Acq_Worker_Pool> Acq_Worker_Pool::get_shared(uint32_t num_workers)
+{
+    if (num_workers == 0)
+        {
+            num_workers = std::max(1U, std::thread::hardware_concurrency());
+        }
+    static std::mutex registry_mutex;
+    static std::map<uint32_t, std::weak_ptr<Acq_Worker_Pool>> registry;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto pool = registry[num_workers].lock();
+    if (!pool)
+        {
+            pool = std::make_shared<Acq_Worker_Pool>(num_workers);
+            registry[num_workers] = pool;
+        }
+    return pool;
+}
+
+
+Acq_Worker_Pool::Acq_Worker_Pool(uint32_t num_workers)
+    : d_num_workers(std::max(1U, num_workers))
+{
+    d_threads.reserve(d_num_workers - 1);
+    for (uint32_t worker = 1; worker < d_num_workers; worker++)
+        {
+            d_threads.emplace_back(&Acq_Worker_Pool::worker_loop, this);
+        }
+}
+
+
+Acq_Worker_Pool::~Acq_Worker_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cv_start.notify_all();
+    for (auto& thread : d_threads)
+        {
+            if (thread.joinable())
+                {
+                    thread.join();
+                }
+        }
+}
+
+
+void Acq_Worker_Pool::run(uint32_t num_tasks, const Task& task)
+{
+    if (d_num_workers == 1 or num_tasks < 2)
+        {
+            task(0, 0, num_tasks);
+            return;
+        }
+    Run run{&task, num_tasks, 0, d_num_workers};
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_runs.push_back(&run);
+    d_cv_start.notify_all();
+
+    // the calling thread works on its own run until all the chunks are claimed
+    while (run.next_chunk < d_num_workers)
+        {
+            const uint32_t chunk = claim_chunk(&run);
+            lock.unlock();
+            run_chunk(&run, chunk);
+            lock.lock();
+            finish_chunk(&run);
+        }
+    d_cv_done.wait(lock, [&run] { return run.unfinished_chunks == 0; });
+}
+
+
+uint32_t Acq_Worker_Pool::claim_chunk(Run* run)
+{
+    const uint32_t chunk = run->next_chunk++;
+    if (run->next_chunk == d_num_workers)
+        {
+            d_runs.erase(std::find(d_runs.begin(), d_runs.end(), run));
+        }
+    return chunk;
+}
+
+
+void Acq_Worker_Pool::run_chunk(const Run* run, uint32_t chunk) const
+{
+    const uint64_t task_begin = static_cast<uint64_t>(run->num_tasks) * chunk / d_num_workers;
+    const uint64_t task_end = static_cast<uint64_t>(run->num_tasks) * (chunk + 1) / d_num_workers;
+    if (task_end > task_begin)
+        {
+            (*run->task)(chunk, static_cast<uint32_t>(task_begin), static_cast<uint32_t>(task_end));
+        }
+}
+
+
+void Acq_Worker_Pool::finish_chunk(Run* run)
+{
+    run->unfinished_chunks--;
+    if (run->unfinished_chunks == 0)
+        {
+            d_cv_done.notify_all();
+        }
+}
+
+
+void Acq_Worker_Pool::worker_loop()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cv_start.wait(lock, [this] { return d_stop or !d_runs.empty(); });
+            if (d_stop)
+                {
+                    return;
+                }
+            Run* run = d_runs.front();
+            const uint32_t chunk = claim_chunk(run);
+            lock.unlock();
+            run_chunk(run, chunk);
+            lock.lock();
+            finish_chunk(run);
+        }
+}
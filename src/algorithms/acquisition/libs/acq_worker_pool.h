@@ -0,0 +1,102 @@
+/*!
+ * \file acq_worker_pool.h
+ * \brief Pool of worker threads that split the Doppler bins of an
+ * acquisition grid search.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_WORKER_POOL_H
+#define GNSS_SDR_ACQ_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Fixed-size pool of threads running a range of tasks in parallel.
+ *
+ * A pool of size N owns N - 1 threads. The tasks of each run() are split in
+ * N contiguous chunks, chunk w always covering the same tasks for a given
+ * number of tasks and being passed to the task as its worker index, so the
+ * results written by each chunk do not depend on thread scheduling.
+ *
+ * Pools are shared by all the acquisition blocks requesting the same size.
+ * Concurrent calls to run() proceed in parallel: the calling thread works on
+ * the chunks of its own run, and the pool threads take the pending chunks of
+ * any run, in submission order.
+ */
+class Acq_Worker_Pool
+{
+public:
+    using Task = std::function<void(uint32_t worker, uint32_t task_begin, uint32_t task_end)>;
+
+    /*!
+     * \brief Returns the process-wide pool with num_workers workers. If
+     * num_workers is 0, the number of hardware threads is used.
+     */
+    static std::shared_ptr<Acq_Worker_Pool> get_shared(uint32_t num_workers);
+
+    explicit Acq_Worker_Pool(uint32_t num_workers);
+    ~Acq_Worker_Pool();
+
+    Acq_Worker_Pool(const Acq_Worker_Pool&) = delete;
+    Acq_Worker_Pool& operator=(const Acq_Worker_Pool&) = delete;
+
+    inline uint32_t size() const
+    {
+        return d_num_workers;
+    }
+
+    /*!
+     * \brief Runs task over [0, num_tasks) and returns when all the workers
+     * have finished their chunk.
+     */
+    void run(uint32_t num_tasks, const Task& task);
+
+private:
+    struct Run
+    {
+        const Task* task;
+        uint32_t num_tasks;
+        uint32_t next_chunk;
+        uint32_t unfinished_chunks;
+    };
+
+    void worker_loop();
+    uint32_t claim_chunk(Run* run);
+    void run_chunk(const Run* run, uint32_t chunk) const;
+    void finish_chunk(Run* run);
+
+    std::vector<std::thread> d_threads;
+    std::deque<Run*> d_runs;  // runs with unclaimed chunks
+    std::mutex d_mutex;
+    std::condition_variable d_cv_start;
+    std::condition_variable d_cv_done;
+    uint32_t d_num_workers;
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_WORKER_POOL_H
@@ -0,0 +1,191 @@
+/*!
+ * \file block_instrumentation.cc
+ * \brief Process-wide registry of per-block processing time, throughput,
+ * input buffer occupancy, dropped samples and sample-to-PVT latency
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "block_instrumentation.h"
+#include <algorithm>
+
+namespace
+{
+inline void atomic_max(std::atomic<uint64_t>& target, uint64_t value)
+{
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+}
+
+
+inline int64_t steady_clock_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+
+std::atomic<bool> Block_Instrumentation::s_enabled{false};
+
+
+void Block_Counters::record_work(uint64_t work_ns, uint64_t items, uint64_t input_items)
+{
+    d_calls.fetch_add(1, std::memory_order_relaxed);
+    d_items.fetch_add(items, std::memory_order_relaxed);
+    d_work_ns.fetch_add(work_ns, std::memory_order_relaxed);
+    d_input_items.fetch_add(input_items, std::memory_order_relaxed);
+    atomic_max(d_work_ns_max, work_ns);
+    atomic_max(d_input_items_max, input_items);
+}
+
+
+void Block_Counters::record_dropped_samples(uint64_t samples)
+{
+    if (Block_Instrumentation::enabled())
+        {
+            d_dropped_events.fetch_add(1, std::memory_order_relaxed);
+            d_dropped_samples.fetch_add(samples, std::memory_order_relaxed);
+        }
+}
+
+
+Block_Instrumentation& Block_Instrumentation::instance()
+{
+    static Block_Instrumentation registry;
+    return registry;
+}
+
+
+void Block_Instrumentation::set_enabled(bool enable)
+{
+    s_enabled.store(enable, std::memory_order_relaxed);
+}
+
+
+std::shared_ptr<Block_Counters> Block_Instrumentation::register_block(const std::string& block_name, int32_t channel)
+{
+    auto counters = std::make_shared<Block_Counters>(block_name, channel);
+    std::lock_guard<std::mutex> lock(d_blocks_mutex);
+    d_blocks.push_back(counters);
+    return counters;
+}
+
+
+void Block_Instrumentation::stamp_sample_counter(uint64_t sample_counter)
+{
+    if (!enabled())
+        {
+            return;
+        }
+    const int64_t now = steady_clock_ns();
+    std::lock_guard<std::mutex> lock(d_latency_mutex);
+    d_stamps[d_num_stamps & (STAMP_HISTORY - 1)] = std::make_pair(sample_counter, now);
+    d_num_stamps++;
+}
+
+
+void Block_Instrumentation::record_sample_to_pvt(uint64_t sample_counter)
+{
+    if (!enabled())
+        {
+            return;
+        }
+    const int64_t now = steady_clock_ns();
+    std::lock_guard<std::mutex> lock(d_latency_mutex);
+    if (d_num_stamps == 0)
+        {
+            return;
+        }
+
+    // The stamps are in increasing order of sample counter. Find the first
+    // one at or after the requested sample, that is, the time at which the
+    // receiver had that sample.
+    const uint64_t oldest = d_num_stamps > STAMP_HISTORY ? d_num_stamps - STAMP_HISTORY : 0;
+    if (d_stamps[oldest & (STAMP_HISTORY - 1)].first > sample_counter)
+        {
+            return;  // too old, no longer in the history
+        }
+    uint64_t lo = oldest;
+    uint64_t hi = d_num_stamps;
+    while (lo < hi)
+        {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            if (d_stamps[mid & (STAMP_HISTORY - 1)].first < sample_counter)
+                {
+                    lo = mid + 1;
+                }
+            else
+                {
+                    hi = mid;
+                }
+        }
+    if (lo == d_num_stamps)
+        {
+            lo = d_num_stamps - 1;  // the sample arrived after the last stamp
+        }
+    const double latency_ms = static_cast<double>(now - d_stamps[lo & (STAMP_HISTORY - 1)].second) * 1e-6;
+    if (d_latency.fixes == 0)
+        {
+            d_latency.min_ms = latency_ms;
+            d_latency.max_ms = latency_ms;
+        }
+    else
+        {
+            d_latency.min_ms = std::min(d_latency.min_ms, latency_ms);
+            d_latency.max_ms = std::max(d_latency.max_ms, latency_ms);
+        }
+    d_latency.fixes++;
+    d_latency.last_sample_counter = sample_counter;
+    d_latency_sum_ms += latency_ms;
+}
+
+
+std::vector<Block_Stats> Block_Instrumentation::take_snapshot(Latency_Stats& latency)
+{
+    std::vector<Block_Stats> stats;
+    {
+        std::lock_guard<std::mutex> lock(d_blocks_mutex);
+        // drop the counters of the blocks that no longer exist
+        d_blocks.erase(std::remove_if(d_blocks.begin(), d_blocks.end(),
+                           [](const std::shared_ptr<Block_Counters>& c) { return c.use_count() == 1; }),
+            d_blocks.end());
+        stats.reserve(d_blocks.size());
+        for (const auto& c : d_blocks)
+            {
+                Block_Stats s;
+                s.block = c->d_name;
+                s.channel = c->channel();
+                s.calls = c->d_calls.exchange(0, std::memory_order_relaxed);
+                s.items = c->d_items.exchange(0, std::memory_order_relaxed);
+                s.work_ns = c->d_work_ns.exchange(0, std::memory_order_relaxed);
+                s.work_ns_max = c->d_work_ns_max.exchange(0, std::memory_order_relaxed);
+                s.input_items = c->d_input_items.exchange(0, std::memory_order_relaxed);
+                s.input_items_max = c->d_input_items_max.exchange(0, std::memory_order_relaxed);
+                s.dropped_events = c->d_dropped_events.exchange(0, std::memory_order_relaxed);
+                s.dropped_samples = c->d_dropped_samples.exchange(0, std::memory_order_relaxed);
+                stats.push_back(std::move(s));
+            }
+    }
+
+    std::lock_guard<std::mutex> lock(d_latency_mutex);
+    latency = d_latency;
+    if (d_latency.fixes > 0)
+        {
+            latency.mean_ms = d_latency_sum_ms / static_cast<double>(d_latency.fixes);
+        }
+    const uint64_t last_sample_counter = d_latency.last_sample_counter;
+    d_latency = Latency_Stats();
+    d_latency.last_sample_counter = last_sample_counter;
+    d_latency_sum_ms = 0.0;
+    return stats;
+}
@@ -0,0 +1,214 @@
+/*!
+ * \file block_instrumentation.h
+ * \brief Process-wide registry of per-block processing time, throughput,
+ * input buffer occupancy, dropped samples and sample-to-PVT latency
+ *
+ * Processing blocks register a set of counters at construction time and
+ * update them from their general_work() through a Block_Work_Timer. The
+ * counters are plain relaxed atomics, and nothing is measured unless the
+ * instrumentation has been enabled, so the cost in the signal processing
+ * threads is a load and a branch when it is off. A monitor (see
+ * Instrumentation_Monitor in core_monitor) periodically takes a snapshot of
+ * all the registered counters, which resets them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BLOCK_INSTRUMENTATION_H
+#define GNSS_SDR_BLOCK_INSTRUMENTATION_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Counters of one processing block, accumulated since the last
+ * snapshot
+ */
+class Block_Counters
+{
+public:
+    Block_Counters(std::string block_name, int32_t channel)
+        : d_name(std::move(block_name)),
+          d_channel(channel)
+    {
+    }
+
+    inline void set_channel(int32_t channel) { d_channel.store(channel, std::memory_order_relaxed); }
+    inline int32_t channel() const { return d_channel.load(std::memory_order_relaxed); }
+    inline const std::string& name() const { return d_name; }
+
+    void record_work(uint64_t work_ns, uint64_t items, uint64_t input_items);  //!< Accounts for one call to general_work()
+    void record_dropped_samples(uint64_t samples);                             //!< Accounts for a gap in the input stream
+
+private:
+    friend class Block_Instrumentation;
+
+    std::string d_name;
+    std::atomic<int32_t> d_channel;
+    std::atomic<uint64_t> d_calls{0};
+    std::atomic<uint64_t> d_items{0};
+    std::atomic<uint64_t> d_work_ns{0};
+    std::atomic<uint64_t> d_work_ns_max{0};
+    std::atomic<uint64_t> d_input_items{0};
+    std::atomic<uint64_t> d_input_items_max{0};
+    std::atomic<uint64_t> d_dropped_events{0};
+    std::atomic<uint64_t> d_dropped_samples{0};
+};
+
+
+/*!
+ * \brief Values of the counters of one block over a reporting period
+ */
+struct Block_Stats
+{
+    std::string block;
+    int32_t channel{-1};
+    uint64_t calls{0};            // Calls to general_work()
+    uint64_t items{0};            // Items consumed from the main input
+    uint64_t work_ns{0};          // Total time spent in general_work(), in ns
+    uint64_t work_ns_max{0};      // Longest call to general_work(), in ns
+    uint64_t input_items{0};      // Sum over the calls of the items waiting at the main input
+    uint64_t input_items_max{0};  // Largest number of items waiting at the main input
+    uint64_t dropped_events{0};   // Gaps detected in the input stream
+    uint64_t dropped_samples{0};  // Samples lost in those gaps
+};
+
+
+/*!
+ * \brief Sample-to-PVT latency over a reporting period, in ms
+ */
+struct Latency_Stats
+{
+    uint64_t fixes{0};
+    uint64_t last_sample_counter{0};
+    double min_ms{0.0};
+    double mean_ms{0.0};
+    double max_ms{0.0};
+};
+
+
+/*!
+ * \brief Registry of the counters of all the processing blocks
+ */
+class Block_Instrumentation
+{
+public:
+    static Block_Instrumentation& instance();
+
+    static inline bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void set_enabled(bool enable);
+
+    /*!
+     * \brief Creates the counters of a block. The registry keeps them until
+     * the block releases its pointer.
+     */
+    std::shared_ptr<Block_Counters> register_block(const std::string& block_name, int32_t channel = -1);
+
+    /*!
+     * \brief Records the wall clock time at which the receiver got the
+     * sample with index sample_counter. Intended for the block that first
+     * sees the samples in the receiver time scale (the sample counter).
+     */
+    void stamp_sample_counter(uint64_t sample_counter);
+
+    /*!
+     * \brief Records the latency between the arrival of the sample with
+     * index sample_counter (Tracking_sample_counter of the observables) and
+     * now, when a PVT solution for it has been computed.
+     */
+    void record_sample_to_pvt(uint64_t sample_counter);
+
+    /*!
+     * \brief Returns the counters of all the registered blocks and the
+     * latency statistics accumulated since the previous call, and resets them.
+     */
+    std::vector<Block_Stats> take_snapshot(Latency_Stats& latency);
+
+private:
+    Block_Instrumentation() = default;
+
+    static constexpr std::size_t STAMP_HISTORY = 4096;  // must be a power of two
+    static std::atomic<bool> s_enabled;
+
+    std::mutex d_blocks_mutex;
+    std::vector<std::shared_ptr<Block_Counters>> d_blocks;
+
+    std::mutex d_latency_mutex;
+    std::array<std::pair<uint64_t, int64_t>, STAMP_HISTORY> d_stamps{};  // sample counter, steady clock in ns
+    uint64_t d_num_stamps{0};
+    Latency_Stats d_latency{};
+    double d_latency_sum_ms{0.0};
+};
+
+
+/*!
+ * \brief Measures one call to general_work() and adds it to the counters
+ * of the block when it goes out of scope. Does nothing if the
+ * instrumentation is disabled or the block has no counters.
+ *
+ * input_items is the number of items waiting at the main input of the
+ * block, the one that paces it: the sample stream for acquisition and
+ * tracking, the receiver clock for the observables.
+ */
+class Block_Work_Timer
+{
+public:
+    Block_Work_Timer(Block_Counters* counters, int input_items)
+        : d_counters(Block_Instrumentation::enabled() ? counters : nullptr),
+          d_input_items(input_items > 0 ? static_cast<uint64_t>(input_items) : 0)
+    {
+        if (d_counters)
+            {
+                d_start = std::chrono::steady_clock::now();
+            }
+    }
+
+    ~Block_Work_Timer()
+    {
+        if (d_counters)
+            {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - d_start);
+                d_counters->record_work(static_cast<uint64_t>(elapsed.count()), d_items, d_input_items);
+            }
+    }
+
+    Block_Work_Timer(const Block_Work_Timer&) = delete;
+    Block_Work_Timer& operator=(const Block_Work_Timer&) = delete;
+
+    inline void set_items(int n)  //!< Sets the number of items consumed from the main input in this call
+    {
+        d_items = n > 0 ? static_cast<uint64_t>(n) : 0;
+    }
+
+private:
+    Block_Counters* d_counters;
+    std::chrono::steady_clock::time_point d_start{};
+    uint64_t d_input_items;
+    uint64_t d_items{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_BLOCK_INSTRUMENTATION_H
@@ -0,0 +1,732 @@
+/*!
+ * \file gnss_dump_writer.cc
+ * \brief Asynchronous writer of fixed-layout binary dump records
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_dump_writer.h"
+#include <glog/logging.h>
+#include <matio.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#if HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace
+{
+constexpr std::array<char, 8> DUMP_MAGIC{'G', 'N', 'S', 'S', 'D', 'U', 'M', 'P'};
+constexpr std::array<char, 4> CHUNK_TAG{'C', 'H', 'N', 'K'};
+constexpr uint32_t DUMP_VERSION = 1;
+constexpr uint32_t CHUNK_FLAG_ZLIB = 1;
+constexpr std::size_t COLUMN_NAME_LENGTH = 32;
+constexpr std::size_t CHUNK_HEADER_SIZE = 24;
+
+
+inline std::size_t padded_size(std::size_t bytes)
+{
+    return (bytes + 7) & ~static_cast<std::size_t>(7);
+}
+
+
+template <std::size_t N>
+void gather_column(uint8_t* dst, const uint8_t* rows, std::size_t num_rows, std::size_t row_size)
+{
+    for (std::size_t r = 0; r < num_rows; r++)
+        {
+            std::memcpy(dst + r * N, rows + r * row_size, N);
+        }
+}
+
+
+// Copies the field at the start of each row into a contiguous array
+void gather_column(uint8_t* dst, const uint8_t* rows, std::size_t num_rows, std::size_t row_size, std::size_t size)
+{
+    switch (size)
+        {
+        case 1:
+            gather_column<1>(dst, rows, num_rows, row_size);
+            break;
+        case 2:
+            gather_column<2>(dst, rows, num_rows, row_size);
+            break;
+        case 4:
+            gather_column<4>(dst, rows, num_rows, row_size);
+            break;
+        default:
+            gather_column<8>(dst, rows, num_rows, row_size);
+        }
+}
+
+
+template <typename T>
+void put(std::vector<uint8_t>& buffer, T value)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+
+template <typename T>
+T get(const uint8_t* buffer)
+{
+    T value;
+    std::memcpy(&value, buffer, sizeof(T));
+    return value;
+}
+
+
+std::size_t next_power_of_two(std::size_t n)
+{
+    std::size_t p = 1;
+    while (p < n)
+        {
+            p <<= 1U;
+        }
+    return p;
+}
+}  // namespace
+
+
+/*
+ * Background thread shared by all the open writers. It wakes up periodically,
+ * or earlier when a producer fills half of its ring buffer, and moves the
+ * committed records of every writer to disk. The list of writers is only
+ * locked to take a copy of it, so the disk writes and the compression never
+ * delay the writers being opened or closed.
+ */
+class Gnss_Dump_Service
+{
+public:
+    static Gnss_Dump_Service& instance()
+    {
+        static Gnss_Dump_Service service;
+        return service;
+    }
+
+    void add(Gnss_Dump_Writer* writer)
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_writers.push_back(writer);
+        if (!d_thread.joinable())
+            {
+                d_thread = std::thread([this] { run(); });
+            }
+    }
+
+    // Returns once the background thread no longer uses the writer
+    void remove(Gnss_Dump_Writer* writer)
+    {
+        std::unique_lock<std::mutex> lock(d_mutex);
+        const auto it = std::find(d_writers.begin(), d_writers.end(), writer);
+        if (it != d_writers.end())
+            {
+                d_writers.erase(it);
+            }
+        if (std::find(d_pass.begin(), d_pass.end(), writer) != d_pass.end())
+            {
+                d_idle_cv.wait(lock, [this] { return d_pass.empty(); });
+            }
+    }
+
+    // Called from the DSP threads, so it does not take the mutex. A wake-up
+    // lost to that race only delays the drain until the next period.
+    void wake()
+    {
+        if (!d_wake.exchange(true, std::memory_order_acq_rel))
+            {
+                d_cv.notify_one();
+            }
+    }
+
+    Gnss_Dump_Service(const Gnss_Dump_Service&) = delete;
+    Gnss_Dump_Service& operator=(const Gnss_Dump_Service&) = delete;
+
+private:
+    Gnss_Dump_Service() = default;
+
+    ~Gnss_Dump_Service()
+    {
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_stop = true;
+        }
+        d_cv.notify_one();
+        if (d_thread.joinable())
+            {
+                d_thread.join();
+            }
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(d_mutex);
+        while (!d_stop)
+            {
+                d_cv.wait_for(lock, std::chrono::milliseconds(50), [this] { return d_stop || d_wake.load(std::memory_order_acquire); });
+                d_wake.store(false, std::memory_order_release);
+                d_pass = d_writers;
+                lock.unlock();
+                for (auto* writer : d_pass)
+                    {
+                        std::lock_guard<std::mutex> io_lock(writer->d_io_mutex);
+                        writer->drain();
+                    }
+                lock.lock();
+                d_pass.clear();
+                d_idle_cv.notify_all();
+            }
+    }
+
+    std::vector<Gnss_Dump_Writer*> d_writers;
+    std::vector<Gnss_Dump_Writer*> d_pass;  // writers being drained, read without the mutex by run()
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    std::condition_variable d_idle_cv;
+    std::thread d_thread;
+    std::atomic<bool> d_wake{false};
+    bool d_stop{false};
+};
+
+
+std::size_t dump_type_size(Dump_Type type)
+{
+    switch (type)
+        {
+        case Dump_Type::INT8:
+        case Dump_Type::UINT8:
+            return 1;
+        case Dump_Type::INT16:
+        case Dump_Type::UINT16:
+            return 2;
+        case Dump_Type::INT32:
+        case Dump_Type::UINT32:
+        case Dump_Type::FLOAT32:
+            return 4;
+        default:
+            return 8;
+        }
+}
+
+
+Dump_Format dump_format_from_string(const std::string& format)
+{
+    if (format == "columnar")
+        {
+            return Dump_Format::COLUMNAR;
+        }
+    if (format != "binary")
+        {
+            LOG(WARNING) << "Unknown dump format " << format << ", using binary";
+        }
+    return Dump_Format::BINARY;
+}
+
+
+Dump_Overflow dump_overflow_from_string(const std::string& overflow)
+{
+    if (overflow == "drop")
+        {
+            return Dump_Overflow::DROP;
+        }
+    if (overflow != "block")
+        {
+            LOG(WARNING) << "Unknown dump overflow policy " << overflow << ", using block";
+        }
+    return Dump_Overflow::BLOCK;
+}
+
+
+Gnss_Dump_Writer::Gnss_Dump_Writer(std::vector<Dump_Column> schema,
+    Dump_Format format,
+    bool compress,
+    std::size_t ring_records,
+    std::size_t chunk_records)
+    : d_schema(std::move(schema)),
+      d_record_size(0),
+      d_ring_mask(next_power_of_two(std::max<std::size_t>(ring_records, 2)) - 1),
+      d_chunk_records(std::max<std::size_t>(chunk_records, 1)),
+      d_format(format),
+      d_compress(compress)
+{
+    d_offsets.reserve(d_schema.size());
+    for (const auto& column : d_schema)
+        {
+            d_offsets.push_back(d_record_size);
+            d_record_size += dump_type_size(column.type);
+        }
+    d_ring.resize((d_ring_mask + 1) * d_record_size);
+    if (d_format == Dump_Format::COLUMNAR)
+        {
+            d_chunk.resize(d_chunk_records * d_record_size);
+        }
+#if !HAS_ZLIB
+    if (d_compress)
+        {
+            LOG(WARNING) << "GNSS-SDR was built without zlib, dump files will not be compressed";
+            d_compress = false;
+        }
+#endif
+}
+
+
+Gnss_Dump_Writer::~Gnss_Dump_Writer()
+{
+    try
+        {
+            close();
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Exception closing the dump file " << d_filename << ": " << e.what();
+        }
+}
+
+
+bool Gnss_Dump_Writer::open(const std::string& filename)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_io_mutex);
+        if (d_file.is_open())
+            {
+                return true;
+            }
+        d_file.open(filename.c_str(), std::ios::out | std::ios::binary);
+        if (!d_file.is_open())
+            {
+                LOG(WARNING) << "Unable to open the dump file " << filename;
+                return false;
+            }
+        d_filename = filename;
+        if (d_format == Dump_Format::COLUMNAR)
+            {
+                std::vector<uint8_t> header(DUMP_MAGIC.begin(), DUMP_MAGIC.end());
+                put<uint32_t>(header, DUMP_VERSION);
+                put<uint32_t>(header, static_cast<uint32_t>(d_schema.size()));
+                for (const auto& column : d_schema)
+                    {
+                        std::array<char, COLUMN_NAME_LENGTH> name{};
+                        column.name.copy(name.data(), COLUMN_NAME_LENGTH - 1);
+                        header.insert(header.end(), name.begin(), name.end());
+                        put<uint32_t>(header, static_cast<uint32_t>(column.type));
+                        put<uint32_t>(header, static_cast<uint32_t>(dump_type_size(column.type)));
+                    }
+                d_file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+            }
+    }
+    Gnss_Dump_Service::instance().add(this);
+    d_registered = true;
+    return true;
+}
+
+
+void Gnss_Dump_Writer::flush()
+{
+    std::lock_guard<std::mutex> lock(d_io_mutex);
+    drain();
+    if (d_chunk_count > 0)
+        {
+            write_chunk();
+        }
+    if (d_file.is_open())
+        {
+            d_file.flush();
+        }
+}
+
+
+void Gnss_Dump_Writer::close()
+{
+    if (d_registered)
+        {
+            Gnss_Dump_Service::instance().remove(this);
+            d_registered = false;
+        }
+    std::lock_guard<std::mutex> lock(d_io_mutex);
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    drain();
+    if (d_chunk_count > 0)
+        {
+            write_chunk();
+        }
+    d_file.close();
+    if (dropped_records() > 0)
+        {
+            LOG(WARNING) << dropped_records() << " records could not be written in time to the dump file " << d_filename;
+        }
+}
+
+
+bool Gnss_Dump_Writer::is_open() const
+{
+    return d_registered;
+}
+
+
+bool Gnss_Dump_Writer::reserve(std::size_t num_records)
+{
+    const std::size_t capacity = d_ring_mask + 1;
+    if (d_head_local + num_records - d_tail_cache > capacity)
+        {
+            d_tail_cache = d_tail.load(std::memory_order_acquire);
+            if (d_head_local + num_records - d_tail_cache > capacity)
+                {
+                    if (d_overflow == Dump_Overflow::DROP || num_records > capacity || !wait_for_room(num_records))
+                        {
+                            d_dropped.fetch_add(num_records, std::memory_order_relaxed);
+                            d_reserved = 0;
+                            return false;
+                        }
+                }
+        }
+    d_reserved = num_records;
+    return true;
+}
+
+
+// Returns false if the writer is closed, or was never opened, before there is room
+bool Gnss_Dump_Writer::wait_for_room(std::size_t num_records)
+{
+    const std::size_t capacity = d_ring_mask + 1;
+    std::unique_lock<std::mutex> lock(d_space_mutex);
+    d_waiting.store(true);
+    while (d_head_local + num_records - d_tail_cache > capacity)
+        {
+            if (!d_registered.load())
+                {
+                    d_waiting.store(false);
+                    return false;
+                }
+            // The timeout covers a wake-up of the service lost to a concurrent drain
+            Gnss_Dump_Service::instance().wake();
+            d_space_cv.wait_for(lock, std::chrono::milliseconds(10));
+            d_tail_cache = d_tail.load(std::memory_order_acquire);
+        }
+    d_waiting.store(false);
+    return true;
+}
+
+
+void Gnss_Dump_Writer::commit()
+{
+    d_head_local += d_reserved;
+    d_reserved = 0;
+    d_head.store(d_head_local, std::memory_order_release);
+    const std::size_t half_capacity = (d_ring_mask + 1) / 2;
+    if (d_head_local - d_tail_cache >= half_capacity)
+        {
+            d_tail_cache = d_tail.load(std::memory_order_acquire);
+            if (d_head_local - d_tail_cache >= half_capacity)
+                {
+                    Gnss_Dump_Service::instance().wake();
+                }
+        }
+}
+
+
+void Gnss_Dump_Writer::drain()
+{
+    const uint64_t head = d_head.load(std::memory_order_acquire);
+    uint64_t tail = d_tail.load(std::memory_order_relaxed);
+    const std::size_t capacity = d_ring_mask + 1;
+    while (tail != head)
+        {
+            const std::size_t start = tail & d_ring_mask;
+            const std::size_t n = std::min<std::size_t>(head - tail, capacity - start);
+            const uint8_t* rows = d_ring.data() + start * d_record_size;
+            if (d_file.is_open())
+                {
+                    if (d_format == Dump_Format::BINARY)
+                        {
+                            d_file.write(reinterpret_cast<const char*>(rows), static_cast<std::streamsize>(n * d_record_size));
+                            d_written += n;
+                        }
+                    else
+                        {
+                            std::size_t copied = 0;
+                            while (copied < n)
+                                {
+                                    const std::size_t m = std::min(n - copied, d_chunk_records - d_chunk_count);
+                                    std::memcpy(d_chunk.data() + d_chunk_count * d_record_size, rows + copied * d_record_size, m * d_record_size);
+                                    d_chunk_count += m;
+                                    copied += m;
+                                    if (d_chunk_count == d_chunk_records)
+                                        {
+                                            write_chunk();
+                                        }
+                                }
+                        }
+                }
+            tail += n;
+            d_tail.store(tail, std::memory_order_release);
+            if (d_waiting.load())
+                {
+                    std::lock_guard<std::mutex> lock(d_space_mutex);
+                    d_space_cv.notify_one();
+                }
+        }
+}
+
+
+void Gnss_Dump_Writer::write_chunk()
+{
+    std::size_t payload_size = 0;
+    for (const auto& column : d_schema)
+        {
+            payload_size += padded_size(d_chunk_count * dump_type_size(column.type));
+        }
+    d_columns.assign(payload_size, 0);
+    std::size_t column_offset = 0;
+    for (std::size_t c = 0; c < d_schema.size(); c++)
+        {
+            const std::size_t size = dump_type_size(d_schema[c].type);
+            gather_column(d_columns.data() + column_offset, d_chunk.data() + d_offsets[c], d_chunk_count, d_record_size, size);
+            column_offset += padded_size(d_chunk_count * size);
+        }
+
+    uint32_t flags = 0;
+    const uint8_t* payload = d_columns.data();
+    uint64_t stored_size = payload_size;
+#if HAS_ZLIB
+    if (d_compress)
+        {
+            auto compressed_size = compressBound(static_cast<uLong>(payload_size));
+            d_compressed.resize(compressed_size);
+            if (compress2(d_compressed.data(), &compressed_size, d_columns.data(), static_cast<uLong>(payload_size), Z_BEST_SPEED) == Z_OK && compressed_size < payload_size)
+                {
+                    flags |= CHUNK_FLAG_ZLIB;
+                    payload = d_compressed.data();
+                    stored_size = padded_size(compressed_size);
+                    d_compressed.resize(stored_size, 0);
+                }
+        }
+#endif
+    std::vector<uint8_t> header(CHUNK_TAG.begin(), CHUNK_TAG.end());
+    header.reserve(CHUNK_HEADER_SIZE);
+    put<uint32_t>(header, flags);
+    put<uint64_t>(header, static_cast<uint64_t>(d_chunk_count));
+    put<uint64_t>(header, stored_size);
+    d_file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    d_file.write(reinterpret_cast<const char*>(payload), static_cast<std::streamsize>(stored_size));
+    d_written += d_chunk_count;
+    d_chunk_count = 0;
+}
+
+
+bool read_dump_columns(const std::string& filename,
+    const std::vector<Dump_Column>& schema,
+    Dump_Format format,
+    std::vector<std::vector<uint8_t>>& columns,
+    uint64_t& num_records)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        {
+            std::cerr << "Problem opening dump file " << filename << '\n';
+            return false;
+        }
+    const auto file_size = static_cast<std::size_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+    std::vector<uint8_t> contents(file_size);
+    if (!file.read(reinterpret_cast<char*>(contents.data()), static_cast<std::streamsize>(file_size)))
+        {
+            std::cerr << "Problem reading dump file " << filename << '\n';
+            return false;
+        }
+
+    std::size_t record_size = 0;
+    std::vector<std::size_t> offsets;
+    for (const auto& column : schema)
+        {
+            offsets.push_back(record_size);
+            record_size += dump_type_size(column.type);
+        }
+    columns.assign(schema.size(), std::vector<uint8_t>());
+    num_records = 0;
+
+    if (format == Dump_Format::BINARY)
+        {
+            num_records = record_size == 0 ? 0 : file_size / record_size;
+            for (std::size_t c = 0; c < schema.size(); c++)
+                {
+                    const std::size_t size = dump_type_size(schema[c].type);
+                    columns[c].resize(num_records * size);
+                    gather_column(columns[c].data(), contents.data() + offsets[c], num_records, record_size, size);
+                }
+            return true;
+        }
+
+    // Columnar: check that the header describes the expected schema
+    const std::size_t header_size = DUMP_MAGIC.size() + 8 + schema.size() * (COLUMN_NAME_LENGTH + 8);
+    if (file_size < header_size || !std::equal(DUMP_MAGIC.begin(), DUMP_MAGIC.end(), contents.begin()) ||
+        get<uint32_t>(&contents[8]) != DUMP_VERSION || get<uint32_t>(&contents[12]) != schema.size())
+        {
+            std::cerr << "Dump file " << filename << " does not have the expected header\n";
+            return false;
+        }
+    std::size_t pos = 16;
+    for (const auto& column : schema)
+        {
+            const std::string name(reinterpret_cast<const char*>(&contents[pos]));
+            if (name != column.name.substr(0, COLUMN_NAME_LENGTH - 1) || get<uint32_t>(&contents[pos + COLUMN_NAME_LENGTH]) != static_cast<uint32_t>(column.type))
+                {
+                    std::cerr << "Dump file " << filename << " does not have the expected column " << column.name << '\n';
+                    return false;
+                }
+            pos += COLUMN_NAME_LENGTH + 8;
+        }
+
+    std::vector<uint8_t> inflated;
+    while (pos + CHUNK_HEADER_SIZE <= file_size)
+        {
+            if (!std::equal(CHUNK_TAG.begin(), CHUNK_TAG.end(), contents.begin() + pos))
+                {
+                    std::cerr << "Corrupted chunk in dump file " << filename << '\n';
+                    return false;
+                }
+            const auto flags = get<uint32_t>(&contents[pos + 4]);
+            const auto chunk_records = static_cast<std::size_t>(get<uint64_t>(&contents[pos + 8]));
+            const auto stored_size = static_cast<std::size_t>(get<uint64_t>(&contents[pos + 16]));
+            pos += CHUNK_HEADER_SIZE;
+            if (pos + stored_size > file_size)
+                {
+                    std::cerr << "Truncated chunk in dump file " << filename << '\n';
+                    break;
+                }
+            std::size_t payload_size = 0;
+            for (const auto& column : schema)
+                {
+                    payload_size += padded_size(chunk_records * dump_type_size(column.type));
+                }
+            const uint8_t* payload = &contents[pos];
+            if (flags & CHUNK_FLAG_ZLIB)
+                {
+#if HAS_ZLIB
+                    inflated.resize(payload_size);
+                    auto inflated_size = static_cast<uLongf>(payload_size);
+                    if (uncompress(inflated.data(), &inflated_size, payload, static_cast<uLong>(stored_size)) != Z_OK || inflated_size != payload_size)
+                        {
+                            std::cerr << "Cannot decompress chunk in dump file " << filename << '\n';
+                            return false;
+                        }
+                    payload = inflated.data();
+#else
+                    std::cerr << "Dump file " << filename << " is compressed, but GNSS-SDR was built without zlib\n";
+                    return false;
+#endif
+                }
+            else if (stored_size != payload_size)
+                {
+                    std::cerr << "Corrupted chunk in dump file " << filename << '\n';
+                    return false;
+                }
+            for (std::size_t c = 0; c < schema.size(); c++)
+                {
+                    const std::size_t bytes = chunk_records * dump_type_size(schema[c].type);
+                    columns[c].insert(columns[c].end(), payload, payload + bytes);
+                    payload += padded_size(bytes);
+                }
+            num_records += chunk_records;
+            pos += stored_size;
+        }
+    return true;
+}
+
+
+int32_t save_dump_matfile(const std::string& dump_filename,
+    const std::string& mat_filename,
+    const std::vector<Dump_Column>& schema,
+    Dump_Format format,
+    std::size_t rows)
+{
+    std::cout << "Generating .mat file for " << dump_filename << '\n';
+    std::vector<std::vector<uint8_t>> columns;
+    uint64_t num_records = 0;
+    if (!read_dump_columns(dump_filename, schema, format, columns, num_records))
+        {
+            return 1;
+        }
+    rows = std::max<std::size_t>(rows, 1);
+    const std::size_t cols = num_records / rows;
+    if (cols == 0)
+        {
+            return 1;
+        }
+
+    mat_t* matfp = Mat_CreateVer(mat_filename.c_str(), nullptr, MAT_FT_MAT73);
+    if (matfp == nullptr)
+        {
+            return 1;
+        }
+    std::array<size_t, 2> dims{rows, cols};
+    for (std::size_t c = 0; c < schema.size(); c++)
+        {
+            matio_classes class_type;
+            matio_types data_type;
+            switch (schema[c].type)
+                {
+                case Dump_Type::INT8:
+                    class_type = MAT_C_INT8;
+                    data_type = MAT_T_INT8;
+                    break;
+                case Dump_Type::UINT8:
+                    class_type = MAT_C_UINT8;
+                    data_type = MAT_T_UINT8;
+                    break;
+                case Dump_Type::INT16:
+                    class_type = MAT_C_INT16;
+                    data_type = MAT_T_INT16;
+                    break;
+                case Dump_Type::UINT16:
+                    class_type = MAT_C_UINT16;
+                    data_type = MAT_T_UINT16;
+                    break;
+                case Dump_Type::INT32:
+                    class_type = MAT_C_INT32;
+                    data_type = MAT_T_INT32;
+                    break;
+                case Dump_Type::UINT32:
+                    class_type = MAT_C_UINT32;
+                    data_type = MAT_T_UINT32;
+                    break;
+                case Dump_Type::INT64:
+                    class_type = MAT_C_INT64;
+                    data_type = MAT_T_INT64;
+                    break;
+                case Dump_Type::UINT64:
+                    class_type = MAT_C_UINT64;
+                    data_type = MAT_T_UINT64;
+                    break;
+                case Dump_Type::FLOAT32:
+                    class_type = MAT_C_SINGLE;
+                    data_type = MAT_T_SINGLE;
+                    break;
+                default:
+                    class_type = MAT_C_DOUBLE;
+                    data_type = MAT_T_DOUBLE;
+                }
+            matvar_t* matvar = Mat_VarCreate(schema[c].name.c_str(), class_type, data_type, 2, dims.data(), columns[c].data(), MAT_F_DONT_COPY_DATA);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+            Mat_VarFree(matvar);
+        }
+    Mat_Close(matfp);
+    return 0;
+}
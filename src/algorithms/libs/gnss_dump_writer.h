@@ -0,0 +1,274 @@
+/*!
+ * \file gnss_dump_writer.h
+ * \brief Asynchronous writer of fixed-layout binary dump records
+ *
+ * Processing blocks push their dump records into a lock-free ring buffer,
+ * and a background thread shared by all the writers of the process moves
+ * them to disk. The file can be written either in the legacy row layout
+ * (one record after the other, as the .dat files always were) or in a
+ * self-describing columnar layout:
+ *
+ *   Header:  "GNSSDUMP", uint32 version, uint32 number of columns, and for
+ *            each column a 32-byte name (NUL-padded), uint32 type and
+ *            uint32 size in bytes of one element.
+ *   Chunks:  "CHNK", uint32 flags (bit 0: zlib-compressed), uint64 number
+ *            of records, uint64 payload size in bytes, and the payload:
+ *            the array of each column, padded to a multiple of 8 bytes.
+ *
+ * All the integer and floating point values are stored in the byte order
+ * of the host. Uncompressed chunks keep every column array 8-byte aligned
+ * within the file, so they can be memory-mapped directly.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_DUMP_WRITER_H
+#define GNSS_SDR_GNSS_DUMP_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Type of the elements of a dump column
+ */
+enum class Dump_Type : uint32_t
+{
+    INT8 = 0,
+    UINT8 = 1,
+    INT16 = 2,
+    UINT16 = 3,
+    INT32 = 4,
+    UINT32 = 5,
+    INT64 = 6,
+    UINT64 = 7,
+    FLOAT32 = 8,
+    FLOAT64 = 9
+};
+
+
+/*!
+ * \brief Layout of the dump file
+ */
+enum class Dump_Format
+{
+    BINARY,   //!< Records one after the other, as the legacy .dat files
+    COLUMNAR  //!< Self-describing header followed by chunks of column arrays
+};
+
+
+/*!
+ * \brief What a writer does with a record when its ring buffer is full
+ */
+enum class Dump_Overflow
+{
+    BLOCK,  //!< Wait until the background thread makes room, so no record is lost
+    DROP    //!< Discard the record and count it, so the producer never waits
+};
+
+
+/*!
+ * \brief Name and type of one field of a dump record
+ */
+struct Dump_Column
+{
+    std::string name;
+    Dump_Type type;
+};
+
+
+std::size_t dump_type_size(Dump_Type type);  //!< Size in bytes of an element of the given type
+
+Dump_Format dump_format_from_string(const std::string& format);  //!< "binary" or "columnar"
+
+Dump_Overflow dump_overflow_from_string(const std::string& overflow);  //!< "block" or "drop"
+
+
+/*!
+ * \brief Writes records of a fixed layout to a dump file without blocking
+ * the thread that produces them.
+ *
+ * Records are built in place in a single-producer, single-consumer ring
+ * buffer. If the ring is full, the producer waits until the background
+ * thread makes room for the record, so the file always holds all of them.
+ * With Dump_Overflow::DROP the record is dropped and counted instead, and
+ * the producer never waits for the disk. Use it through Gnss_Dump_Record.
+ */
+class Gnss_Dump_Writer
+{
+public:
+    /*!
+     * \brief Constructor. The order of the columns in the schema is the
+     * order of the fields in each record.
+     */
+    explicit Gnss_Dump_Writer(std::vector<Dump_Column> schema,
+        Dump_Format format = Dump_Format::BINARY,
+        bool compress = false,
+        std::size_t ring_records = 8192,
+        std::size_t chunk_records = 4096);
+
+    ~Gnss_Dump_Writer();
+
+    Gnss_Dump_Writer(const Gnss_Dump_Writer&) = delete;
+    Gnss_Dump_Writer& operator=(const Gnss_Dump_Writer&) = delete;
+    Gnss_Dump_Writer(Gnss_Dump_Writer&&) = delete;
+    Gnss_Dump_Writer& operator=(Gnss_Dump_Writer&&) = delete;
+
+    bool open(const std::string& filename);  //!< Creates the file and hands the writer to the background thread
+    void flush();                            //!< Writes all the committed records to disk before returning
+    void close();                            //!< Flushes and closes the file
+    bool is_open() const;
+
+    inline void set_overflow_policy(Dump_Overflow overflow) { d_overflow = overflow; }  //!< Dump_Overflow::BLOCK by default
+
+    /*!
+     * \brief Reserves room for num_records consecutive records, waiting for
+     * the background thread if the ring buffer is full. Returns false, and
+     * counts them as dropped, if the policy is Dump_Overflow::DROP and the
+     * ring has no room, if they do not fit in the ring at all, or if the
+     * file is not open yet.
+     */
+    bool reserve(std::size_t num_records = 1);
+
+    /*!
+     * \brief Returns the storage of the k-th reserved record
+     */
+    inline uint8_t* slot(std::size_t k)
+    {
+        return d_ring.data() + ((d_head_local + k) & d_ring_mask) * d_record_size;
+    }
+
+    void commit();  //!< Makes the reserved records visible to the background thread
+
+    inline std::size_t record_size() const { return d_record_size; }
+    inline const std::vector<Dump_Column>& schema() const { return d_schema; }
+    inline Dump_Format format() const { return d_format; }
+    inline uint64_t dropped_records() const { return d_dropped.load(std::memory_order_relaxed); }
+    inline uint64_t written_records() const { return d_written; }
+
+private:
+    friend class Gnss_Dump_Service;
+
+    void drain();  // called with d_io_mutex held
+    bool wait_for_room(std::size_t num_records);
+    void write_chunk();
+
+    std::vector<Dump_Column> d_schema;
+    std::vector<std::size_t> d_offsets;
+    std::vector<uint8_t> d_ring;
+    std::vector<uint8_t> d_chunk;
+    std::vector<uint8_t> d_columns;
+    std::vector<uint8_t> d_compressed;
+    std::string d_filename;
+    std::ofstream d_file;
+    std::mutex d_io_mutex;
+    std::mutex d_space_mutex;
+    std::condition_variable d_space_cv;  // notified by drain() when a producer waits for room
+
+    alignas(64) std::atomic<uint64_t> d_head{0};
+    alignas(64) std::atomic<uint64_t> d_tail{0};
+    alignas(64) std::atomic<uint64_t> d_dropped{0};
+    std::atomic<bool> d_waiting{false};
+
+    uint64_t d_head_local{0};
+    uint64_t d_tail_cache{0};
+    uint64_t d_written{0};
+    std::size_t d_record_size;
+    std::size_t d_ring_mask;
+    std::size_t d_reserved{0};
+    std::size_t d_chunk_records;
+    std::size_t d_chunk_count{0};
+    Dump_Format d_format;
+    Dump_Overflow d_overflow{Dump_Overflow::BLOCK};
+    bool d_compress;
+    std::atomic<bool> d_registered{false};
+};
+
+
+/*!
+ * \brief Fills the fields of one or more consecutive records of a
+ * Gnss_Dump_Writer, in the order given by its schema. If the writer dropped
+ * them, the values are discarded.
+ */
+class Gnss_Dump_Record
+{
+public:
+    explicit Gnss_Dump_Record(Gnss_Dump_Writer& writer, std::size_t num_records = 1)
+        : d_writer(writer),
+          d_valid(writer.reserve(num_records))
+    {
+    }
+
+    template <typename T>
+    inline Gnss_Dump_Record& add(T value)
+    {
+        if (d_valid)
+            {
+                std::memcpy(d_writer.slot(d_offset / d_writer.record_size()) + d_offset % d_writer.record_size(), &value, sizeof(T));
+            }
+        d_offset += sizeof(T);
+        return *this;
+    }
+
+    inline void commit()
+    {
+        if (d_valid)
+            {
+                d_writer.commit();
+                d_valid = false;
+            }
+    }
+
+private:
+    Gnss_Dump_Writer& d_writer;
+    std::size_t d_offset{0};
+    bool d_valid;
+};
+
+
+/*!
+ * \brief Reads a whole dump file into one array per column of the schema.
+ * Returns false if the file cannot be read or does not match the schema.
+ */
+bool read_dump_columns(const std::string& filename,
+    const std::vector<Dump_Column>& schema,
+    Dump_Format format,
+    std::vector<std::vector<uint8_t>>& columns,
+    uint64_t& num_records);
+
+
+/*!
+ * \brief Converts a dump file into a MATLAB Level 7.3 file with one
+ * variable per column, shaped as rows x (number of records / rows).
+ * Returns 0 on success.
+ */
+int32_t save_dump_matfile(const std::string& dump_filename,
+    const std::string& mat_filename,
+    const std::vector<Dump_Column>& schema,
+    Dump_Format format,
+    std::size_t rows = 1);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_DUMP_WRITER_H
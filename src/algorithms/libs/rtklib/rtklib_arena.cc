@@ -0,0 +1,127 @@
+/*!
+ * \file rtklib_arena.cc
+ * \brief Scratch memory arena for the matrices of the RTKLIB estimation
+ * routines
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_arena.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+constexpr size_t ARENA_ALIGNMENT = 64;
+
+thread_local Rtklib_Arena* current_arena = nullptr;
+
+inline size_t align_up(size_t bytes)
+{
+    return (bytes + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+}  // namespace
+
+
+Rtklib_Arena::Rtklib_Arena(size_t capacity_bytes)
+    : d_capacity(align_up(std::max<size_t>(capacity_bytes, ARENA_ALIGNMENT)))
+{
+    d_blocks.push_back(new_block(d_capacity));
+}
+
+
+Rtklib_Arena::~Rtklib_Arena()
+{
+    for (auto& block : d_blocks)
+        {
+            free(block.raw);
+        }
+}
+
+
+Rtklib_Arena::Block Rtklib_Arena::new_block(size_t size) const
+{
+    Block block{};
+    block.raw = static_cast<char*>(malloc(size + ARENA_ALIGNMENT - 1));
+    if (block.raw == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+    block.begin = reinterpret_cast<char*>(align_up(reinterpret_cast<uintptr_t>(block.raw)));
+    block.size = size;
+    return block;
+}
+
+
+void* Rtklib_Arena::allocate(size_t bytes)
+{
+    const size_t size = align_up(std::max<size_t>(bytes, 1));
+    if (d_used + size > d_blocks.back().size)
+        {
+            // Overflow: keep the current blocks alive until the next reset
+            d_blocks.push_back(new_block(std::max(size, d_capacity)));
+            d_used = 0;
+            d_overflows++;
+        }
+    void* p = d_blocks.back().begin + d_used;
+    d_used += size;
+    d_total_used += size;
+    d_peak = std::max(d_peak, d_total_used);
+    return p;
+}
+
+
+bool Rtklib_Arena::owns(const void* p) const
+{
+    const auto* c = static_cast<const char*>(p);
+    return std::any_of(d_blocks.cbegin(), d_blocks.cend(),
+        [c](const Block& block) { return c >= block.begin && c < block.begin + block.size; });
+}
+
+
+void Rtklib_Arena::reset()
+{
+    if (d_blocks.size() > 1)
+        {
+            // Merge everything into a single block for the next epoch
+            for (auto& block : d_blocks)
+                {
+                    free(block.raw);
+                }
+            d_blocks.clear();
+            d_capacity = align_up(d_peak + d_peak / 4);
+            d_blocks.push_back(new_block(d_capacity));
+        }
+    d_used = 0;
+    d_total_used = 0;
+}
+
+
+Rtklib_Arena* Rtklib_Arena::current()
+{
+    return current_arena;
+}
+
+
+Rtklib_Arena_Scope::Rtklib_Arena_Scope(Rtklib_Arena& arena)
+    : d_arena(arena),
+      d_previous(current_arena)
+{
+    current_arena = &d_arena;
+}
+
+
+Rtklib_Arena_Scope::~Rtklib_Arena_Scope()
+{
+    current_arena = d_previous;
+    d_arena.reset();
+}
@@ -0,0 +1,102 @@
+/*!
+ * \file rtklib_arena.h
+ * \brief Scratch memory arena for the matrices of the RTKLIB estimation
+ * routines
+ *
+ * While an Rtklib_Arena_Scope is alive in a thread, mat(), imat(), zeros()
+ * and eye() take their memory from its arena instead of the heap, and
+ * matfree() ignores the pointers that belong to the arena. All that memory
+ * is released at once when the scope ends, so a solver that opens a scope
+ * for each epoch does not allocate once the arena has grown to the size that
+ * an epoch needs.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTKLIB_ARENA_H
+#define GNSS_SDR_RTKLIB_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup RTKLIB_Library
+ * \{ */
+
+
+/*!
+ * \brief Bump allocator made of one block of memory, plus overflow blocks
+ * when an epoch needs more. On reset(), the overflow blocks are merged into
+ * a single block big enough for the next epoch.
+ */
+class Rtklib_Arena
+{
+public:
+    explicit Rtklib_Arena(size_t capacity_bytes = 256 * 1024);
+    ~Rtklib_Arena();
+
+    Rtklib_Arena(const Rtklib_Arena&) = delete;
+    Rtklib_Arena& operator=(const Rtklib_Arena&) = delete;
+
+    void* allocate(size_t bytes);    //!< Returns memory aligned to 64 bytes
+    bool owns(const void* p) const;  //!< True if p was returned by allocate() since the last reset()
+    void reset();                    //!< Releases all the memory given by allocate()
+
+    inline size_t capacity() const { return d_capacity; }      //!< Size of the main block [bytes]
+    inline size_t peak() const { return d_peak; }              //!< Largest amount of memory used in an epoch [bytes]
+    inline uint64_t overflows() const { return d_overflows; }  //!< Number of overflow blocks allocated so far
+
+    static Rtklib_Arena* current();  //!< Arena of the scope open in this thread, or nullptr
+
+private:
+    struct Block
+    {
+        char* raw;
+        char* begin;
+        size_t size;
+    };
+
+    Block new_block(size_t size) const;
+
+    std::vector<Block> d_blocks;  // main block first
+    size_t d_capacity;
+    size_t d_used{0};        // used bytes in the last block
+    size_t d_total_used{0};  // used bytes in all blocks
+    size_t d_peak{0};
+    uint64_t d_overflows{0};
+};
+
+
+/*!
+ * \brief Makes mat(), imat(), zeros() and eye() allocate from an arena in
+ * this thread, and resets the arena when it goes out of scope. Scopes must
+ * not be nested on the same arena.
+ */
+class Rtklib_Arena_Scope
+{
+public:
+    explicit Rtklib_Arena_Scope(Rtklib_Arena& arena);
+    ~Rtklib_Arena_Scope();
+
+    Rtklib_Arena_Scope(const Rtklib_Arena_Scope&) = delete;
+    Rtklib_Arena_Scope& operator=(const Rtklib_Arena_Scope&) = delete;
+
+private:
+    Rtklib_Arena& d_arena;
+    Rtklib_Arena* d_previous;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RTKLIB_ARENA_H
@@ -69,7 +69,7 @@ int LD(int n, const double *Q, double *L, double *D)
                     L[i + j * n] /= L[i + i * n];
                 }
         }
-    free(A);
+    matfree(A);
     if (info)
         {
             fprintf(stderr, "%s : LD factorization error\n", __FILE__);
@@ -272,11 +272,11 @@ int search(int n, int m, const double *L, const double *D,
                         }
                 }
         }
-    free(S);
-    free(dist);
-    free(zb);
-    free(z);
-    free(step);
+    matfree(S);
+    matfree(dist);
+    matfree(zb);
+    matfree(z);
+    matfree(step);
 
     if (c >= LOOPMAX)
         {
@@ -332,11 +332,11 @@ int lambda(int n, int m, const double *a, const double *Q, double *F,
                     info = solve("T", Z, E, n, m, F); /* F=Z'\E */
                 }
         }
-    free(L);
-    free(D);
-    free(Z);
-    free(z);
-    free(E);
+    matfree(L);
+    matfree(D);
+    matfree(Z);
+    matfree(z);
+    matfree(E);
     return info;
 }
 
@@ -374,15 +374,15 @@ int lambda_reduction(int n, const double *Q, double *Z)
     /* LD factorization */
     if ((info = LD(n, Q, L, D)))
         {
-            free(L);
-            free(D);
+            matfree(L);
+            matfree(D);
             return info;
         }
     /* lambda reduction */
     reduction(n, L, D, Z);
 
-    free(L);
-    free(D);
+    matfree(L);
+    matfree(D);
     return 0;
 }
 
@@ -415,14 +415,14 @@ int lambda_search(int n, int m, const double *a, const double *Q,
     /* LD factorization */
     if ((info = LD(n, Q, L, D)))
         {
-            free(L);
-            free(D);
+            matfree(L);
+            matfree(D);
             return info;
         }
     /* mlambda search */
     info = search(n, m, L, D, a, F, s);
 
-    free(L);
-    free(D);
+    matfree(L);
+    matfree(D);
     return info;
 }
@@ -799,9 +799,9 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
                         {
                             sol->stat = opt->sateph == EPHOPT_SBAS ? SOLQ_SBAS : SOLQ_SINGLE;
                         }
-                    free(v);
-                    free(H);
-                    free(var);
+                    matfree(v);
+                    matfree(H);
+                    matfree(var);
                     msg = msg_aux;
                     return stat;
                 }
@@ -811,9 +811,9 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
             std::snprintf(msg_aux, sizeof(msg_aux), "iteration divergent i=%d", i);
         }
 
-    free(v);
-    free(H);
-    free(var);
+    matfree(v);
+    matfree(H);
+    matfree(var);
     msg = msg_aux;
 
     return 0;
@@ -931,13 +931,13 @@ int raim_fde(const obsd_t *obs, int n, const double *rs,
             trace(2, "%s: %s excluded by raim\n", tstr + 11, name.data());
         }
     free(obs_e);
-    free(rs_e);
-    free(dts_e);
-    free(vare_e);
-    free(azel_e);
-    free(svh_e);
-    free(vsat_e);
-    free(resp_e);
+    matfree(rs_e);
+    matfree(dts_e);
+    matfree(vare_e);
+    matfree(azel_e);
+    matfree(svh_e);
+    matfree(vsat_e);
+    matfree(resp_e);
 
     return stat;
 }
@@ -1064,8 +1064,8 @@ void estvel(const obsd_t *obs, int n, const double *rs, const double *dts,
                     break;
                 }
         }
-    free(v);
-    free(H);
+    matfree(v);
+    matfree(H);
 }
 
 
@@ -1173,10 +1173,10 @@ int pntpos(const obsd_t *obs, int n, const nav_t *nav,
                     ssat[obs[i].sat - 1].resp[0] = resp[i];
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
-    free(azel_);
-    free(resp);
+    matfree(rs);
+    matfree(dts);
+    matfree(var);
+    matfree(azel_);
+    matfree(resp);
     return stat;
 }
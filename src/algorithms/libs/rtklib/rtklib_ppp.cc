@@ -421,9 +421,9 @@ int fix_sol(rtk_t *rtk, const int *sat1, const int *sat2,
     if ((info = filter(rtk->x, rtk->P, H, v, R, rtk->nx, n)))
         {
             trace(1, "filter error (info=%d)\n", info);
-            free(v);
-            free(H);
-            free(R);
+            matfree(v);
+            matfree(H);
+            matfree(R);
             return 0;
         }
     /* set solution */
@@ -441,9 +441,9 @@ int fix_sol(rtk_t *rtk, const int *sat1, const int *sat2,
             rtk->ambc[sat1[i] - 1].flags[sat2[i] - 1] = 1;
             rtk->ambc[sat2[i] - 1].flags[sat1[i] - 1] = 1;
         }
-    free(v);
-    free(H);
-    free(R);
+    matfree(v);
+    matfree(H);
+    matfree(R);
     return 1;
 }
 
@@ -519,8 +519,8 @@ int fix_amb_ROUND(rtk_t *rtk, int *sat1, int *sat2, const int *NW, int n)
     /* fixed solution */
     stat = fix_sol(rtk, sat1, sat2, NC, m);
 
-    free(NC);
-    free(var);
+    matfree(NC);
+    matfree(var);
 
     return stat && m >= 3;
 }
@@ -594,12 +594,12 @@ int fix_amb_ILS(rtk_t *rtk, int *sat1, int *sat2, int *NW, int n)
         }
     if (m < 3)
         {
-            free(B1);
-            free(N1);
-            free(D);
-            free(E);
-            free(Q);
-            free(NC);
+            matfree(B1);
+            matfree(N1);
+            matfree(D);
+            matfree(E);
+            matfree(Q);
+            matfree(NC);
             return 0;
         }
 
@@ -611,22 +611,22 @@ int fix_amb_ILS(rtk_t *rtk, int *sat1, int *sat2, int *NW, int n)
     if ((info = lambda(m, 2, B1, Q, N1, s)))
         {
             trace(2, "lambda error: info=%d\n", info);
-            free(B1);
-            free(N1);
-            free(D);
-            free(E);
-            free(Q);
-            free(NC);
+            matfree(B1);
+            matfree(N1);
+            matfree(D);
+            matfree(E);
+            matfree(Q);
+            matfree(NC);
             return 0;
         }
     if (s[0] <= 0.0)
         {
-            free(B1);
-            free(N1);
-            free(D);
-            free(E);
-            free(Q);
-            free(NC);
+            matfree(B1);
+            matfree(N1);
+            matfree(D);
+            matfree(E);
+            matfree(Q);
+            matfree(NC);
             return 0;
         }
 
@@ -636,12 +636,12 @@ int fix_amb_ILS(rtk_t *rtk, int *sat1, int *sat2, int *NW, int n)
     if (rtk->opt.thresar[0] > 0.0 && rtk->sol.ratio < rtk->opt.thresar[0])
         {
             trace(2, "varidation error: n=%2d ratio=%8.3f\n", m, rtk->sol.ratio);
-            free(B1);
-            free(N1);
-            free(D);
-            free(E);
-            free(Q);
-            free(NC);
+            matfree(B1);
+            matfree(N1);
+            matfree(D);
+            matfree(E);
+            matfree(Q);
+            matfree(NC);
             return 0;
         }
     trace(2, "varidation ok: %s n=%2d ratio=%8.3f\n", time_str(rtk->sol.time, 0), m,
@@ -655,12 +655,12 @@ int fix_amb_ILS(rtk_t *rtk, int *sat1, int *sat2, int *NW, int n)
     /* fixed solution */
     stat = fix_sol(rtk, sat1, sat2, NC, m);
 
-    free(B1);
-    free(N1);
-    free(D);
-    free(E);
-    free(Q);
-    free(NC);
+    matfree(B1);
+    matfree(N1);
+    matfree(D);
+    matfree(E);
+    matfree(Q);
+    matfree(NC);
 
     return stat;
 }
@@ -728,9 +728,9 @@ int pppamb(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav,
         {
             stat = fix_amb_ILS(rtk, sat1, sat2, NW, m);
         }
-    free(sat1);
-    free(sat2);
-    free(NW);
+    matfree(sat1);
+    matfree(sat2);
+    matfree(NW);
 
     return stat;
 }
@@ -1893,13 +1893,13 @@ void pppos(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav)
                         }
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
-    free(azel);
-    free(xp);
-    free(Pp);
-    free(v);
-    free(H);
-    free(R);
+    matfree(rs);
+    matfree(dts);
+    matfree(var);
+    matfree(azel);
+    matfree(xp);
+    matfree(Pp);
+    matfree(v);
+    matfree(H);
+    matfree(R);
 }
@@ -30,6 +30,7 @@
  *----------------------------------------------------------------------------*/
 
 #include "rtklib_rtkcmn.h"
+#include "rtklib_arena.h"
 #include <glog/logging.h>
 #include <array>
 #include <cassert>
@@ -211,6 +212,10 @@ extern "C"
     extern void dgetrf_(int *, int *, double *, int *, int *, int *);
     extern void dgetri_(int *, double *, int *, int *, double *, int *, int *);
     extern void dgetrs_(char *, int *, int *, double *, int *, int *, double *, int *, int *);
+    extern void dpotrf_(char *, int *, double *, int *, int *);
+    extern void dpotri_(char *, int *, double *, int *, int *);
+    extern void dtrsm_(char *, char *, char *, char *, int *, int *, double *, double *, int *, double *, int *);
+    extern void dsyrk_(char *, char *, int *, int *, double *, double *, int *, double *, double *, int *);
 }
 
 
@@ -979,15 +984,22 @@ int decode_word(unsigned int word, unsigned char *data)
  * allocate memory of matrix
  * args   : int    n,m       I   number of rows and columns of matrix
  * return : matrix pointer (if n<=0 or m<=0, return NULL)
+ * notes  : the memory is taken from the scratch arena of the calling thread if
+ *          there is one (see rtklib_arena.h). release it with matfree()
  *-----------------------------------------------------------------------------*/
 double *mat(int n, int m)
 {
+    Rtklib_Arena *arena;
     double *p;
 
     if (n <= 0 || m <= 0)
         {
             return nullptr;
         }
+    if ((arena = Rtklib_Arena::current()))
+        {
+            return static_cast<double *>(arena->allocate(sizeof(double) * n * m));
+        }
     if (!(p = static_cast<double *>(malloc(sizeof(double) * n * m))))
         {
             fatalerr("matrix memory allocation error: n=%d,m=%d\n", n, m);
@@ -1003,12 +1015,17 @@ double *mat(int n, int m)
  *-----------------------------------------------------------------------------*/
 int *imat(int n, int m)
 {
+    Rtklib_Arena *arena;
     int *p;
 
     if (n <= 0 || m <= 0)
         {
             return nullptr;
         }
+    if ((arena = Rtklib_Arena::current()))
+        {
+            return static_cast<int *>(arena->allocate(sizeof(int) * n * m));
+        }
     if (!(p = static_cast<int *>(malloc(sizeof(int) * n * m))))
         {
             fatalerr("integer matrix memory allocation error: n=%d,m=%d\n", n, m);
@@ -1030,10 +1047,18 @@ double *zeros(int n, int m)
     if ((p = mat(n, m)))
         for (n = n * m - 1; n >= 0; n--) p[n] = 0.0;
 #else
+    Rtklib_Arena *arena;
+
     if (n <= 0 || m <= 0)
         {
             return nullptr;
         }
+    if ((arena = Rtklib_Arena::current()))
+        {
+            p = static_cast<double *>(arena->allocate(sizeof(double) * n * m));
+            memset(p, 0, sizeof(double) * n * m);
+            return p;
+        }
     if (!(p = static_cast<double *>(calloc(sizeof(double), n * m))))
         {
             fatalerr("matrix memory allocation error: n=%d,m=%d\n", n, m);
@@ -1064,6 +1089,24 @@ double *eye(int n)
 }
 
 
+/* free matrix -----------------------------------------------------------------
+ * free memory of matrix allocated by mat(), imat(), zeros() or eye()
+ * args   : void   *p        I   matrix pointer (NULL is allowed)
+ * return : none
+ * notes  : matrices taken from the scratch arena of the calling thread are not
+ *          freed here, but all at once when the arena scope ends
+ *-----------------------------------------------------------------------------*/
+void matfree(void *p)
+{
+    Rtklib_Arena *arena = Rtklib_Arena::current();
+
+    if (arena == nullptr || !arena->owns(p))
+        {
+            free(p);
+        }
+}
+
+
 /* inner product ---------------------------------------------------------------
  * inner product of vectors
  * args   : double *a,*b     I   vector a,b (n x 1)
@@ -1183,8 +1226,8 @@ int matinv(double *A, int n)
         {
             dgetri_(&n, A, &n, ipiv, work, &lwork, &info);
         }
-    free(ipiv);
-    free(work);
+    matfree(ipiv);
+    matfree(work);
     return info;
 }
 
@@ -1214,12 +1257,62 @@ int solve(const char *tr, const double *A, const double *Y, int n,
         {
             dgetrs_(const_cast<char *>(tr), &n, &m, B, &n, ipiv, X, &n, &info);
         }
-    free(ipiv);
-    free(B);
+    matfree(ipiv);
+    matfree(B);
     return info;
 }
 
 
+/* inverse of symmetric positive definite matrix -------------------------------
+ * inverse of symmetric positive definite matrix by cholesky decomposition
+ * (A=A^-1). if A is not positive definite, falls back to matinv()
+ * args   : double *A        IO  symmetric matrix (n x n)
+ *          int    n         I   size of matrix A
+ * return : status (0:ok,0>:error)
+ *-----------------------------------------------------------------------------*/
+static int matinv_sym(double *A, int n)
+{
+    char uplo = 'U';
+    double *d = mat(n, 1);
+    int i;
+    int j;
+    int info;
+
+    for (i = 0; i < n; i++)
+        {
+            d[i] = A[i + i * n];
+        }
+    dpotrf_(&uplo, &n, A, &n, &info); /* A=U'*U */
+    if (!info)
+        {
+            dpotri_(&uplo, &n, A, &n, &info); /* A=A^-1 (upper triangle) */
+        }
+    if (info)
+        {
+            /* restore A from its lower triangle, not touched by lapack */
+            for (i = 0; i < n; i++)
+                {
+                    A[i + i * n] = d[i];
+                    for (j = i + 1; j < n; j++)
+                        {
+                            A[i + j * n] = A[j + i * n];
+                        }
+                }
+            matfree(d);
+            return matinv(A, n);
+        }
+    for (j = 0; j < n; j++)
+        {
+            for (i = j + 1; i < n; i++)
+                {
+                    A[i + j * n] = A[j + i * n];
+                }
+        }
+    matfree(d);
+    return 0;
+}
+
+
 /* end of matrix routines ----------------------------------------------------*/
 
 /* least square estimation -----------------------------------------------------
@@ -1246,11 +1339,43 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
     Ay = mat(n, 1);
     matmul("NN", n, 1, m, 1.0, A, y, 0.0, Ay); /* Ay=A*y */
     matmul("NT", n, n, m, 1.0, A, A, 0.0, Q);  /* Q=A*A' */
-    if (!(info = matinv(Q, n)))
+    if (!(info = matinv_sym(Q, n)))
         {
             matmul("NN", n, 1, n, 1.0, Q, Ay, 0.0, x); /* x=Q^-1*Ay */
         }
-    free(Ay);
+    matfree(Ay);
+    return info;
+}
+
+
+/* kalman filter by lu decomposition -------------------------------------------
+ * kalman filter state update with dense matrices, see filter_()
+ *-----------------------------------------------------------------------------*/
+static int filter_lu(const double *x, const double *P, const double *H,
+    const double *v, const double *R, int n, int m,
+    double *xp, double *Pp)
+{
+    double *F = mat(n, m);
+    double *Q = mat(m, m);
+    double *K = mat(n, m);
+    double *I = eye(n);
+    int info;
+
+    matcpy(Q, R, m, m);
+    matcpy(xp, x, n, 1);
+    matmul("NN", n, m, n, 1.0, P, H, 0.0, F); /* Q=H'*P*H+R */
+    matmul("TN", m, m, n, 1.0, H, F, 1.0, Q);
+    if (!(info = matinv(Q, m)))
+        {
+            matmul("NN", n, m, m, 1.0, F, Q, 0.0, K);  /* K=P*H*Q^-1 */
+            matmul("NN", n, 1, m, 1.0, K, v, 1.0, xp); /* xp=x+K*v */
+            matmul("NT", n, n, m, -1.0, K, H, 1.0, I); /* Pp=(I-K*H')*P */
+            matmul("NN", n, n, n, 1.0, I, P, 0.0, Pp);
+        }
+    matfree(F);
+    matfree(Q);
+    matfree(K);
+    matfree(I);
     return info;
 }
 
@@ -1271,33 +1396,111 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
  * return : status (0:ok,<0:error)
  * notes  : matirix stored by column-major order (fortran convention)
  *          if state x[i]==0.0, not updates state x[i]/P[i+i*n]
+ *          with Q=H'*P*H+R=L*L' (cholesky) and W=P*H*L'^-1, the update is
+ *          computed as xp=x+W*(L^-1*v), Pp=P-W*W', which keeps Pp symmetric.
+ *          only the non-zero elements of H are used. if Q is not positive
+ *          definite, the update is computed by lu decomposition
  *-----------------------------------------------------------------------------*/
 int filter_(const double *x, const double *P, const double *H,
     const double *v, const double *R, int n, int m,
     double *xp, double *Pp)
 {
-    double *F = mat(n, m);
-    double *Q = mat(m, m);
-    double *K = mat(n, m);
-    double *I = eye(n);
+    char right = 'R';
+    char left = 'L';
+    char lower = 'L';
+    char upper = 'U';
+    char trans = 'T';
+    char notrans = 'N';
+    char nonunit = 'N';
+    double one = 1.0;
+    double minus_one = -1.0;
+    double *F;
+    double *Q;
+    double *w;
+    double h;
+    double q;
+    int *nz;
+    int *nnz;
+    int i;
+    int j;
+    int k;
+    int l;
+    int ncol = 1;
     int info;
 
-    matcpy(Q, R, m, m);
+    if (n <= 0 || m <= 0)
+        {
+            return filter_lu(x, P, H, v, R, n, m, xp, Pp);
+        }
+    nz = imat(n, m);
+    nnz = imat(m, 1);
+    for (j = 0; j < m; j++) /* non-zero elements of each column of H */
+        {
+            for (i = nnz[j] = 0; i < n; i++)
+                {
+                    if (H[i + j * n] != 0.0)
+                        {
+                            nz[nnz[j]++ + j * n] = i;
+                        }
+                }
+        }
+    F = zeros(n, m);
+    for (j = 0; j < m; j++) /* F=P*H */
+        {
+            for (l = 0; l < nnz[j]; l++)
+                {
+                    k = nz[l + j * n];
+                    h = H[k + j * n];
+                    for (i = 0; i < n; i++)
+                        {
+                            F[i + j * n] += h * P[i + k * n];
+                        }
+                }
+        }
+    Q = mat(m, m);
+    for (j = 0; j < m; j++) /* Q=H'*P*H+R (lower triangle) */
+        {
+            for (i = j; i < m; i++)
+                {
+                    q = R[i + j * m];
+                    for (l = 0; l < nnz[i]; l++)
+                        {
+                            k = nz[l + i * n];
+                            q += H[k + i * n] * F[k + j * n];
+                        }
+                    Q[i + j * m] = q;
+                }
+        }
+    dpotrf_(&lower, &m, Q, &m, &info); /* Q=L*L' */
+    if (info)
+        {
+            matfree(nz);
+            matfree(nnz);
+            matfree(F);
+            matfree(Q);
+            return filter_lu(x, P, H, v, R, n, m, xp, Pp);
+        }
+    dtrsm_(&right, &lower, &trans, &nonunit, &n, &m, &one, Q, &m, F, &n); /* W=P*H*L'^-1 */
+    w = mat(m, 1);
+    matcpy(w, v, m, 1);
+    dtrsm_(&left, &lower, &notrans, &nonunit, &m, &ncol, &one, Q, &m, w, &m); /* w=L^-1*v */
     matcpy(xp, x, n, 1);
-    matmul("NN", n, m, n, 1.0, P, H, 0.0, F); /* Q=H'*P*H+R */
-    matmul("TN", m, m, n, 1.0, H, F, 1.0, Q);
-    if (!(info = matinv(Q, m)))
+    matmul("NN", n, 1, m, 1.0, F, w, 1.0, xp); /* xp=x+W*w=x+K*v */
+    matcpy(Pp, P, n, n);
+    dsyrk_(&upper, &notrans, &n, &m, &minus_one, F, &n, &one, Pp, &n); /* Pp=P-W*W'=(I-K*H')*P */
+    for (j = 0; j < n; j++)
         {
-            matmul("NN", n, m, m, 1.0, F, Q, 0.0, K);  /* K=P*H*Q^-1 */
-            matmul("NN", n, 1, m, 1.0, K, v, 1.0, xp); /* xp=x+K*v */
-            matmul("NT", n, n, m, -1.0, K, H, 1.0, I); /* Pp=(I-K*H')*P */
-            matmul("NN", n, n, n, 1.0, I, P, 0.0, Pp);
+            for (i = j + 1; i < n; i++)
+                {
+                    Pp[i + j * n] = Pp[j + i * n];
+                }
         }
-    free(F);
-    free(Q);
-    free(K);
-    free(I);
-    return info;
+    matfree(nz);
+    matfree(nnz);
+    matfree(F);
+    matfree(Q);
+    matfree(w);
+    return 0;
 }
 
 
@@ -1356,12 +1559,12 @@ int filter(double *x, double *P, const double *H, const double *v,
                     P[ix[i] + ix[j] * n] = Pp_[i + j * k];
                 }
         }
-    free(ix);
-    free(x_);
-    free(xp_);
-    free(P_);
-    free(Pp_);
-    free(H_);
+    matfree(ix);
+    matfree(x_);
+    matfree(xp_);
+    matfree(P_);
+    matfree(Pp_);
+    matfree(H_);
     return info;
 }
 
@@ -1393,22 +1596,22 @@ int smoother(const double *xf, const double *Qf, const double *xb,
 
     matcpy(invQf, Qf, n, n);
     matcpy(invQb, Qb, n, n);
-    if (!matinv(invQf, n) && !matinv(invQb, n))
+    if (!matinv_sym(invQf, n) && !matinv_sym(invQb, n))
         {
             for (i = 0; i < n * n; i++)
                 {
                     Qs[i] = invQf[i] + invQb[i];
                 }
-            if (!(info = matinv(Qs, n)))
+            if (!(info = matinv_sym(Qs, n)))
                 {
                     matmul("NN", n, 1, n, 1.0, invQf, xf, 0.0, xx);
                     matmul("NN", n, 1, n, 1.0, invQb, xb, 1.0, xx);
                     matmul("NN", n, 1, n, 1.0, Qs, xx, 0.0, xs);
                 }
         }
-    free(invQf);
-    free(invQb);
-    free(xx);
+    matfree(invQf);
+    matfree(invQb);
+    matfree(xx);
     return info;
 }
 
@@ -139,6 +139,7 @@ double *mat(int n, int m);
 int *imat(int n, int m);
 double *zeros(int n, int m);
 double *eye(int n);
+void matfree(void *p);
 double dot(const double *a, const double *b, int n);
 double norm_rtk(const double *a, int n);
 void cross3(const double *a, const double *b, double *c);
@@ -757,9 +757,9 @@ void udpos(rtk_t *rtk, double tt)
                     rtk->P[i + 6 + (j + 6) * rtk->nx] += Qv[i + j * 3];
                 }
         }
-    free(F);
-    free(FP);
-    free(xp);
+    matfree(F);
+    matfree(FP);
+    matfree(xp);
 }
 
 
@@ -1185,7 +1185,7 @@ void udbias(rtk_t *rtk, double tt, const obsd_t *obs, const int *sat,
                         }
                     initx_rtk(rtk, bias[i], std::pow(rtk->opt.std[0], 2.0), IB_RTK(sat[i], f, &rtk->opt));
                 }
-            free(bias);
+            matfree(bias);
         }
 }
 
@@ -1854,13 +1854,13 @@ int ddres(rtk_t *rtk, const nav_t *nav, double dt, const double *x,
     /* double-differenced measurement error covariance */
     ddcov(nb, b, Ri, Rj, nv, R);
 
-    free(Ri);
-    free(Rj);
-    free(im);
-    free(tropu);
-    free(tropr);
-    free(dtdxu);
-    free(dtdxr);
+    matfree(Ri);
+    matfree(Rj);
+    matfree(im);
+    matfree(tropu);
+    matfree(tropr);
+    matfree(dtdxu);
+    matfree(dtdxr);
 
     return nv;
 }
@@ -2131,10 +2131,10 @@ void holdamb(rtk_t *rtk, const double *xa)
                 {
                     errmsg(rtk, "filter error (info=%d)\n", info);
                 }
-            free(R);
+            matfree(R);
         }
-    free(v);
-    free(H);
+    matfree(v);
+    matfree(H);
 }
 
 
@@ -2174,7 +2174,7 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     if ((nb = ddmat(rtk, D)) <= 0)
         {
             errmsg(rtk, "no valid double-difference\n");
-            free(D);
+            matfree(D);
             return 0;
         }
     ny = na + nb;
@@ -2273,15 +2273,15 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
         {
             errmsg(rtk, "lambda error (info=%d)\n", info);
         }
-    free(D);
-    free(y);
-    free(Qy);
-    free(DP);
-    free(b);
-    free(db);
-    free(Qb);
-    free(Qab);
-    free(QQ);
+    matfree(D);
+    matfree(y);
+    matfree(Qy);
+    matfree(DP);
+    matfree(b);
+    matfree(db);
+    matfree(Qb);
+    matfree(Qab);
+    matfree(QQ);
 
     return nb; /* number of ambiguities */
 }
@@ -2409,12 +2409,12 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
         {
             errmsg(rtk, "initial base station position error\n");
 
-            free(rs);
-            free(dts);
-            free(var);
-            free(y);
-            free(e);
-            free(azel);
+            matfree(rs);
+            matfree(dts);
+            matfree(var);
+            matfree(y);
+            matfree(e);
+            matfree(azel);
             return 0;
         }
     /* time-interpolation of residuals (for post-processing) */
@@ -2427,12 +2427,12 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
         {
             errmsg(rtk, "no common satellite\n");
 
-            free(rs);
-            free(dts);
-            free(var);
-            free(y);
-            free(e);
-            free(azel);
+            matfree(rs);
+            matfree(dts);
+            matfree(var);
+            matfree(y);
+            matfree(e);
+            matfree(azel);
             return 0;
         }
     /* temporal update of states */
@@ -2619,19 +2619,19 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
                         }
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
-    free(y);
-    free(e);
-    free(azel);
-    free(xp);
-    free(Pp);
-    free(xa);
-    free(v);
-    free(H);
-    free(R);
-    free(bias);
+    matfree(rs);
+    matfree(dts);
+    matfree(var);
+    matfree(y);
+    matfree(e);
+    matfree(azel);
+    matfree(xp);
+    matfree(Pp);
+    matfree(xa);
+    matfree(v);
+    matfree(H);
+    matfree(R);
+    matfree(bias);
 
     if (stat != SOLQ_NONE)
         {
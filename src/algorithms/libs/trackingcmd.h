@@ -25,17 +25,24 @@
 /** \addtogroup Algorithm_libs algorithms_libs
  * \{ */
 
+/*!
+ * \brief Vector Tracking Loop (VTL) command sent from the PVT block to the
+ * tracking channel identified by channel_id. The predictions are referred to
+ * the input sample sample_counter.
+ */
 class TrackingCmd
 {
 public:
-    TrackingCmd();
+    TrackingCmd() = default;
 
     bool enable_carrier_nco_cmd = false;
     bool enable_code_nco_cmd = false;
-    double code_freq_chips = 0.0;
-    double carrier_freq_hz = 0.0;
-    double carrier_freq_rate_hz_s = 0.0;
-    uint64_t sample_counter = 0UL;
+    double code_freq_chips = 0.0;         //!< Predicted code frequency [chips/s]
+    double carrier_freq_hz = 0.0;         //!< Predicted carrier Doppler [Hz]
+    double carrier_freq_rate_hz_s = 0.0;  //!< Predicted carrier Doppler rate [Hz/s]
+    uint64_t sample_counter = 0UL;        //!< Input sample at which the predictions are valid
+    int32_t channel_id = -1;              //!< Destination tracking channel
+    uint32_t PRN = 0U;                    //!< Satellite PRN the predictions refer to
 };
 
 /** \} */
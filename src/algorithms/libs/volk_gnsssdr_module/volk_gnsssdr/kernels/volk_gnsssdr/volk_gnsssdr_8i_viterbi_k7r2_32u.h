@@ -0,0 +1,350 @@
+/*!
+ * \file volk_gnsssdr_8i_viterbi_k7r2_32u.h
+ * \brief VOLK_GNSSSDR kernel: add-compare-select of a Viterbi decoder for
+ * K=7, rate 1/2 convolutional codes.
+ *
+ * VOLK_GNSSSDR kernel that runs the add-compare-select recursion of a Viterbi
+ * decoder over the 64-state trellis of a K=7, rate 1/2 convolutional code
+ * with 8-bit soft symbols, 16-bit saturating path metrics and bit-packed
+ * survivor decisions.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8i_viterbi_k7r2_32u
+ *
+ * \b Overview
+ *
+ * Runs \p num_steps trellis sections of the Viterbi algorithm for a K=7, rate
+ * 1/2 convolutional code. The encoder state is the last six input bits, the
+ * newest one in the most significant position, so the state \p j is reached
+ * from the states 2(j mod 32) and 2(j mod 32) + 1 with the input bit j / 32.
+ * Both generator polynomials must have their first and last taps set, so that
+ * each butterfly is described by the two code bits emitted from the even
+ * state with a 0 input.
+ *
+ * The branch metric is the correlation of the code bits (mapped to +1 for a
+ * 1 and -1 for a 0) with the soft symbols. Path metrics are normalized to the
+ * metric of the state 0 after each section.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8i_viterbi_k7r2_32u(uint32_t* decisions, int16_t* metrics, const int8_t* symbols, const uint8_t* branch_table, unsigned int num_steps)
+ * \endcode
+ *
+ * \b Inputs
+ * \li metrics: Path metrics of the 64 states before the first section.
+ * \li symbols: 2 * \p num_steps soft symbols, positive for a 1.
+ * \li branch_table: For each butterfly i = 0..31, the two code bits (first
+ * polynomial in bit 1, second polynomial in bit 0) emitted from the state 2i
+ * with a 0 input.
+ * \li num_steps: Number of trellis sections.
+ *
+ * \b Outputs
+ * \li decisions: 2 * \p num_steps words. Bit j mod 32 of the word 2t + j / 32
+ * is set if the survivor path of the state j at the section t comes from the
+ * odd predecessor.
+ * \li metrics: Path metrics of the 64 states after the last section.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8i_viterbi_k7r2_32u_H
+#define INCLUDED_volk_gnsssdr_8i_viterbi_k7r2_32u_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <inttypes.h>
+
+
+static inline int16_t volk_gnsssdr_viterbi_k7r2_saturate(int32_t value)
+{
+    if (value > 32767)
+        {
+            return 32767;
+        }
+    if (value < -32768)
+        {
+            return -32768;
+        }
+    return (int16_t)value;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_generic(uint32_t* decisions, int16_t* metrics, const int8_t* symbols, const uint8_t* branch_table, unsigned int num_steps)
+{
+    int16_t new_metrics[64];
+    unsigned int t;
+    int i;
+    for (t = 0; t < num_steps; t++)
+        {
+            const int32_t s0 = symbols[2 * t];
+            const int32_t s1 = symbols[2 * t + 1];
+            uint32_t decisions_low = 0;
+            uint32_t decisions_high = 0;
+            for (i = 0; i < 32; i++)
+                {
+                    const int32_t bm = ((branch_table[i] & 2) ? s0 : -s0) + ((branch_table[i] & 1) ? s1 : -s1);
+                    const int16_t m0 = volk_gnsssdr_viterbi_k7r2_saturate(metrics[2 * i] + bm);
+                    const int16_t m1 = volk_gnsssdr_viterbi_k7r2_saturate(metrics[2 * i + 1] - bm);
+                    const int16_t m2 = volk_gnsssdr_viterbi_k7r2_saturate(metrics[2 * i] - bm);
+                    const int16_t m3 = volk_gnsssdr_viterbi_k7r2_saturate(metrics[2 * i + 1] + bm);
+                    if (m1 > m0)
+                        {
+                            new_metrics[i] = m1;
+                            decisions_low |= (uint32_t)1 << i;
+                        }
+                    else
+                        {
+                            new_metrics[i] = m0;
+                        }
+                    if (m3 > m2)
+                        {
+                            new_metrics[i + 32] = m3;
+                            decisions_high |= (uint32_t)1 << i;
+                        }
+                    else
+                        {
+                            new_metrics[i + 32] = m2;
+                        }
+                }
+            for (i = 0; i < 64; i++)
+                {
+                    metrics[i] = volk_gnsssdr_viterbi_k7r2_saturate(new_metrics[i] - new_metrics[0]);
+                }
+            decisions[2 * t] = decisions_low;
+            decisions[2 * t + 1] = decisions_high;
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_u_sse2(uint32_t* decisions, int16_t* metrics, const int8_t* symbols, const uint8_t* branch_table, unsigned int num_steps)
+{
+    __m128i m[8];
+    __m128i negate0[4];
+    __m128i negate1[4];
+    unsigned int t;
+    int q;
+    int i;
+    for (q = 0; q < 8; q++)
+        {
+            m[q] = _mm_loadu_si128((const __m128i*)(metrics + 8 * q));
+        }
+    for (q = 0; q < 4; q++)
+        {
+            __VOLK_ATTR_ALIGNED(16)
+            int16_t mask0[8];
+            __VOLK_ATTR_ALIGNED(16)
+            int16_t mask1[8];
+            for (i = 0; i < 8; i++)
+                {
+                    mask0[i] = (branch_table[8 * q + i] & 2) ? 0 : -1;
+                    mask1[i] = (branch_table[8 * q + i] & 1) ? 0 : -1;
+                }
+            negate0[q] = _mm_load_si128((const __m128i*)mask0);
+            negate1[q] = _mm_load_si128((const __m128i*)mask1);
+        }
+
+    for (t = 0; t < num_steps; t++)
+        {
+            const __m128i s0 = _mm_set1_epi16(symbols[2 * t]);
+            const __m128i s1 = _mm_set1_epi16(symbols[2 * t + 1]);
+            __m128i new_m[8];
+            __m128i decision_low[4];
+            __m128i decision_high[4];
+            for (q = 0; q < 4; q++)
+                {
+                    // metrics of the even and odd predecessors of the butterflies 8q..8q+7
+                    const __m128i even = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(m[2 * q], 16), 16), _mm_srai_epi32(_mm_slli_epi32(m[2 * q + 1], 16), 16));
+                    const __m128i odd = _mm_packs_epi32(_mm_srai_epi32(m[2 * q], 16), _mm_srai_epi32(m[2 * q + 1], 16));
+                    // branch metrics, (x ^ mask) - mask negates x where mask is -1
+                    const __m128i bm = _mm_add_epi16(_mm_sub_epi16(_mm_xor_si128(s0, negate0[q]), negate0[q]),
+                        _mm_sub_epi16(_mm_xor_si128(s1, negate1[q]), negate1[q]));
+                    const __m128i m0 = _mm_adds_epi16(even, bm);
+                    const __m128i m1 = _mm_subs_epi16(odd, bm);
+                    const __m128i m2 = _mm_subs_epi16(even, bm);
+                    const __m128i m3 = _mm_adds_epi16(odd, bm);
+                    decision_low[q] = _mm_cmpgt_epi16(m1, m0);
+                    decision_high[q] = _mm_cmpgt_epi16(m3, m2);
+                    new_m[q] = _mm_max_epi16(m0, m1);
+                    new_m[q + 4] = _mm_max_epi16(m2, m3);
+                }
+            decisions[2 * t] = (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(decision_low[0], decision_low[1])) |
+                               ((uint32_t)_mm_movemask_epi8(_mm_packs_epi16(decision_low[2], decision_low[3])) << 16);
+            decisions[2 * t + 1] = (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(decision_high[0], decision_high[1])) |
+                                   ((uint32_t)_mm_movemask_epi8(_mm_packs_epi16(decision_high[2], decision_high[3])) << 16);
+
+            const __m128i norm = _mm_set1_epi16((int16_t)_mm_extract_epi16(new_m[0], 0));
+            for (q = 0; q < 8; q++)
+                {
+                    m[q] = _mm_subs_epi16(new_m[q], norm);
+                }
+        }
+
+    for (q = 0; q < 8; q++)
+        {
+            _mm_storeu_si128((__m128i*)(metrics + 8 * q), m[q]);
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_u_avx2(uint32_t* decisions, int16_t* metrics, const int8_t* symbols, const uint8_t* branch_table, unsigned int num_steps)
+{
+    __m256i m[4];
+    __m256i negate0[2];
+    __m256i negate1[2];
+    unsigned int t;
+    int q;
+    int i;
+    for (q = 0; q < 4; q++)
+        {
+            m[q] = _mm256_loadu_si256((const __m256i*)(metrics + 16 * q));
+        }
+    for (q = 0; q < 2; q++)
+        {
+            __VOLK_ATTR_ALIGNED(32)
+            int16_t mask0[16];
+            __VOLK_ATTR_ALIGNED(32)
+            int16_t mask1[16];
+            for (i = 0; i < 16; i++)
+                {
+                    mask0[i] = (branch_table[16 * q + i] & 2) ? 0 : -1;
+                    mask1[i] = (branch_table[16 * q + i] & 1) ? 0 : -1;
+                }
+            negate0[q] = _mm256_load_si256((const __m256i*)mask0);
+            negate1[q] = _mm256_load_si256((const __m256i*)mask1);
+        }
+
+    for (t = 0; t < num_steps; t++)
+        {
+            const __m256i s0 = _mm256_set1_epi16(symbols[2 * t]);
+            const __m256i s1 = _mm256_set1_epi16(symbols[2 * t + 1]);
+            __m256i new_m[4];
+            __m256i decision_low[2];
+            __m256i decision_high[2];
+            for (q = 0; q < 2; q++)
+                {
+                    // packs works within 128-bit lanes, the permutation restores the order of the 64-bit blocks
+                    const __m256i even = _mm256_permute4x64_epi64(_mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(m[2 * q], 16), 16), _mm256_srai_epi32(_mm256_slli_epi32(m[2 * q + 1], 16), 16)), 0xD8);
+                    const __m256i odd = _mm256_permute4x64_epi64(_mm256_packs_epi32(_mm256_srai_epi32(m[2 * q], 16), _mm256_srai_epi32(m[2 * q + 1], 16)), 0xD8);
+                    const __m256i bm = _mm256_add_epi16(_mm256_sub_epi16(_mm256_xor_si256(s0, negate0[q]), negate0[q]),
+                        _mm256_sub_epi16(_mm256_xor_si256(s1, negate1[q]), negate1[q]));
+                    const __m256i m0 = _mm256_adds_epi16(even, bm);
+                    const __m256i m1 = _mm256_subs_epi16(odd, bm);
+                    const __m256i m2 = _mm256_subs_epi16(even, bm);
+                    const __m256i m3 = _mm256_adds_epi16(odd, bm);
+                    decision_low[q] = _mm256_cmpgt_epi16(m1, m0);
+                    decision_high[q] = _mm256_cmpgt_epi16(m3, m2);
+                    new_m[q] = _mm256_max_epi16(m0, m1);
+                    new_m[q + 2] = _mm256_max_epi16(m2, m3);
+                }
+            decisions[2 * t] = (uint32_t)_mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(decision_low[0], decision_low[1]), 0xD8));
+            decisions[2 * t + 1] = (uint32_t)_mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(decision_high[0], decision_high[1]), 0xD8));
+
+            const __m256i norm = _mm256_set1_epi16((int16_t)_mm_extract_epi16(_mm256_castsi256_si128(new_m[0]), 0));
+            for (q = 0; q < 4; q++)
+                {
+                    m[q] = _mm256_subs_epi16(new_m[q], norm);
+                }
+        }
+
+    for (q = 0; q < 4; q++)
+        {
+            _mm256_storeu_si256((__m256i*)(metrics + 16 * q), m[q]);
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8i_viterbi_k7r2_32u_neon(uint32_t* decisions, int16_t* metrics, const int8_t* symbols, const uint8_t* branch_table, unsigned int num_steps)
+{
+    int16x8_t m[8];
+    int16x8_t sign0[4];
+    int16x8_t sign1[4];
+    const uint16_t bit_weights[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+    const uint16x8_t weights = vld1q_u16(bit_weights);
+    unsigned int t;
+    int q;
+    int i;
+    for (q = 0; q < 8; q++)
+        {
+            m[q] = vld1q_s16(metrics + 8 * q);
+        }
+    for (q = 0; q < 4; q++)
+        {
+            int16_t s0[8];
+            int16_t s1[8];
+            for (i = 0; i < 8; i++)
+                {
+                    s0[i] = (branch_table[8 * q + i] & 2) ? 1 : -1;
+                    s1[i] = (branch_table[8 * q + i] & 1) ? 1 : -1;
+                }
+            sign0[q] = vld1q_s16(s0);
+            sign1[q] = vld1q_s16(s1);
+        }
+
+    for (t = 0; t < num_steps; t++)
+        {
+            const int16x8_t s0 = vdupq_n_s16(symbols[2 * t]);
+            const int16x8_t s1 = vdupq_n_s16(symbols[2 * t + 1]);
+            int16x8_t new_m[8];
+            uint32_t decisions_low = 0;
+            uint32_t decisions_high = 0;
+            for (q = 0; q < 4; q++)
+                {
+                    const int16x8x2_t predecessors = vuzpq_s16(m[2 * q], m[2 * q + 1]);  // even, odd
+                    const int16x8_t bm = vmlaq_s16(vmulq_s16(s0, sign0[q]), s1, sign1[q]);
+                    const int16x8_t m0 = vqaddq_s16(predecessors.val[0], bm);
+                    const int16x8_t m1 = vqsubq_s16(predecessors.val[1], bm);
+                    const int16x8_t m2 = vqsubq_s16(predecessors.val[0], bm);
+                    const int16x8_t m3 = vqaddq_s16(predecessors.val[1], bm);
+                    // weight each decision with its bit and add them up
+                    const uint64x2_t low = vpaddlq_u32(vpaddlq_u16(vandq_u16(vcgtq_s16(m1, m0), weights)));
+                    const uint64x2_t high = vpaddlq_u32(vpaddlq_u16(vandq_u16(vcgtq_s16(m3, m2), weights)));
+                    decisions_low |= (uint32_t)(vgetq_lane_u64(low, 0) + vgetq_lane_u64(low, 1)) << (8 * q);
+                    decisions_high |= (uint32_t)(vgetq_lane_u64(high, 0) + vgetq_lane_u64(high, 1)) << (8 * q);
+                    new_m[q] = vmaxq_s16(m0, m1);
+                    new_m[q + 4] = vmaxq_s16(m2, m3);
+                }
+            decisions[2 * t] = decisions_low;
+            decisions[2 * t + 1] = decisions_high;
+
+            const int16x8_t norm = vdupq_n_s16(vgetq_lane_s16(new_m[0], 0));
+            for (q = 0; q < 8; q++)
+                {
+                    m[q] = vqsubq_s16(new_m[q], norm);
+                }
+        }
+
+    for (q = 0; q < 8; q++)
+        {
+            vst1q_s16(metrics + 8 * q, m[q]);
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8i_viterbi_k7r2_32u_H */
@@ -0,0 +1,106 @@
+/*!
+ * \file volk_gnsssdr_8i_viterbik7r2puppet_32u.h
+ * \brief VOLK_GNSSSDR puppet for the K=7, rate 1/2 Viterbi add-compare-select
+ * kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the Viterbi add-compare-select kernel
+ * into the test system. It uses the generator polynomials of the Galileo
+ * navigation messages (171, 133 in octal).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8i_viterbik7r2puppet_32u_H
+#define INCLUDED_volk_gnsssdr_8i_viterbik7r2puppet_32u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8i_viterbi_k7r2_32u.h"
+
+
+static inline void volk_gnsssdr_viterbik7r2puppet_init(int16_t* metrics, uint8_t* branch_table)
+{
+    const int32_t g[2] = {0171, 0133};
+    int32_t i;
+    int32_t k;
+    for (i = 0; i < 64; i++)
+        {
+            metrics[i] = (i == 0) ? 0 : -8192;
+        }
+    for (i = 0; i < 32; i++)
+        {
+            uint8_t out = 0;
+            for (k = 0; k < 2; k++)
+                {
+                    int32_t taps = g[k] & (2 * i);
+                    int32_t parity = 0;
+                    while (taps)
+                        {
+                            parity ^= taps & 1;
+                            taps >>= 1;
+                        }
+                    out = (uint8_t)((out << 1) | parity);
+                }
+            branch_table[i] = out;
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8i_viterbik7r2puppet_32u_generic(uint32_t* decisions, const int8_t* symbols, unsigned int num_points)
+{
+    int16_t metrics[64];
+    uint8_t branch_table[32];
+    volk_gnsssdr_viterbik7r2puppet_init(metrics, branch_table);
+    volk_gnsssdr_8i_viterbi_k7r2_32u_generic(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+static inline void volk_gnsssdr_8i_viterbik7r2puppet_32u_u_sse2(uint32_t* decisions, const int8_t* symbols, unsigned int num_points)
+{
+    int16_t metrics[64];
+    uint8_t branch_table[32];
+    volk_gnsssdr_viterbik7r2puppet_init(metrics, branch_table);
+    volk_gnsssdr_8i_viterbi_k7r2_32u_u_sse2(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+
+static inline void volk_gnsssdr_8i_viterbik7r2puppet_32u_u_avx2(uint32_t* decisions, const int8_t* symbols, unsigned int num_points)
+{
+    int16_t metrics[64];
+    uint8_t branch_table[32];
+    volk_gnsssdr_viterbik7r2puppet_init(metrics, branch_table);
+    volk_gnsssdr_8i_viterbi_k7r2_32u_u_avx2(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+
+static inline void volk_gnsssdr_8i_viterbik7r2puppet_32u_neon(uint32_t* decisions, const int8_t* symbols, unsigned int num_points)
+{
+    int16_t metrics[64];
+    uint8_t branch_table[32];
+    volk_gnsssdr_viterbik7r2puppet_init(metrics, branch_table);
+    volk_gnsssdr_8i_viterbi_k7r2_32u_neon(decisions, metrics, symbols, branch_table, num_points / 2);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8i_viterbik7r2puppet_32u_H */
@@ -0,0 +1,88 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack4bitpuppet_8i.h
+ * \brief VOLK_GNSSSDR puppet for the 4-bit sample unpacking kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the 4-bit sample unpacking kernel into
+ * the test system. The tables are filled with distinct, non-zero values, so
+ * that every lookup and the sum of both nibbles are checked.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack4bitpuppet_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack4bitpuppet_8i_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_unpack_4bit_8i.h"
+
+
+static inline void volk_gnsssdr_unpack4bitpuppet_init(int8_t* tables, int8_t* result, unsigned int num_points)
+{
+    unsigned int i;
+    for (i = 0; i < 64; i++)
+        {
+            tables[i] = (int8_t)(5 * i - 77);
+        }
+    // the kernel writes two values per byte
+    for (i = num_points & ~1U; i < num_points; i++)
+        {
+            result[i] = 0;
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack4bitpuppet_8i_generic(int8_t* result, const uint8_t* packed, unsigned int num_points)
+{
+    int8_t tables[64];
+    volk_gnsssdr_unpack4bitpuppet_init(tables, result, num_points);
+    volk_gnsssdr_8u_unpack_4bit_8i_generic(result, packed, tables, num_points / 2);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void volk_gnsssdr_8u_unpack4bitpuppet_8i_u_ssse3(int8_t* result, const uint8_t* packed, unsigned int num_points)
+{
+    int8_t tables[64];
+    volk_gnsssdr_unpack4bitpuppet_init(tables, result, num_points);
+    volk_gnsssdr_8u_unpack_4bit_8i_u_ssse3(result, packed, tables, num_points / 2);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+
+static inline void volk_gnsssdr_8u_unpack4bitpuppet_8i_u_avx2(int8_t* result, const uint8_t* packed, unsigned int num_points)
+{
+    int8_t tables[64];
+    volk_gnsssdr_unpack4bitpuppet_init(tables, result, num_points);
+    volk_gnsssdr_8u_unpack_4bit_8i_u_avx2(result, packed, tables, num_points / 2);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+
+static inline void volk_gnsssdr_8u_unpack4bitpuppet_8i_neon(int8_t* result, const uint8_t* packed, unsigned int num_points)
+{
+    int8_t tables[64];
+    volk_gnsssdr_unpack4bitpuppet_init(tables, result, num_points);
+    volk_gnsssdr_8u_unpack_4bit_8i_neon(result, packed, tables, num_points / 2);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack4bitpuppet_8i_H */
@@ -0,0 +1,230 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack_2bit_8i.h
+ * \brief VOLK_GNSSSDR kernel: unpacks four 2-bit samples from each byte.
+ *
+ * VOLK_GNSSSDR kernel that unpacks bytes holding four 2-bit samples into
+ * four signed char values, looking up the low and high nibbles of each byte
+ * in 16-entry tables.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_unpack_2bit_8i
+ *
+ * \b Overview
+ *
+ * Unpacks each byte of \p packed into four values of \p result. The k-th
+ * value of byte b is tables[16 * k + (b & 0x0F)] + tables[64 + 16 * k + (b >> 4)]
+ * (modulo 256), for k = 0..3. Each 2-bit sample lies entirely in one nibble,
+ * so the order of the samples in the output and the value given to each
+ * code (two's complement, 2 * x + 1, sign-magnitude, I/Q swap...) are only
+ * seen through the tables, which the caller builds once. Each table maps to
+ * a byte shuffle instruction.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_unpack_2bit_8i(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+ * \endcode
+ *
+ * \b Inputs
+ * \li packed: Bytes with four 2-bit samples each.
+ * \li tables: 128 bytes. Entries 16 * k + i give the contribution of low
+ * nibble i to the k-th output, and entries 64 + 16 * k + i the contribution
+ * of high nibble i, for k = 0..3 and i = 0..15.
+ * \li num_bytes: Number of bytes to unpack.
+ *
+ * \b Outputs
+ * \li result: 4 * num_bytes unpacked values.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack_2bit_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack_2bit_8i_H
+
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_generic(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+{
+    unsigned int i;
+    unsigned int k;
+    for (i = 0; i < num_bytes; i++)
+        {
+            const unsigned int low = packed[i] & 0x0F;
+            const unsigned int high = packed[i] >> 4;
+            for (k = 0; k < 4; k++)
+                {
+                    *result++ = (int8_t)(tables[16 * k + low] + tables[64 + 16 * k + high]);
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_u_ssse3(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+{
+    const unsigned int sse_iters = num_bytes / 16;
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    __m128i low_table[4];
+    __m128i high_table[4];
+    __m128i b, low, high, v0, v1, v2, v3, v01_lo, v01_hi, v23_lo, v23_hi;
+    unsigned int number;
+    unsigned int k;
+
+    for (k = 0; k < 4; k++)
+        {
+            low_table[k] = _mm_loadu_si128((const __m128i*)(tables + 16 * k));
+            high_table[k] = _mm_loadu_si128((const __m128i*)(tables + 64 + 16 * k));
+        }
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            b = _mm_loadu_si128((const __m128i*)packed);
+            low = _mm_and_si128(b, nibble_mask);
+            high = _mm_and_si128(_mm_srli_epi64(b, 4), nibble_mask);
+            v0 = _mm_add_epi8(_mm_shuffle_epi8(low_table[0], low), _mm_shuffle_epi8(high_table[0], high));
+            v1 = _mm_add_epi8(_mm_shuffle_epi8(low_table[1], low), _mm_shuffle_epi8(high_table[1], high));
+            v2 = _mm_add_epi8(_mm_shuffle_epi8(low_table[2], low), _mm_shuffle_epi8(high_table[2], high));
+            v3 = _mm_add_epi8(_mm_shuffle_epi8(low_table[3], low), _mm_shuffle_epi8(high_table[3], high));
+
+            // interleave the four outputs of each byte
+            v01_lo = _mm_unpacklo_epi8(v0, v1);
+            v01_hi = _mm_unpackhi_epi8(v0, v1);
+            v23_lo = _mm_unpacklo_epi8(v2, v3);
+            v23_hi = _mm_unpackhi_epi8(v2, v3);
+            _mm_storeu_si128((__m128i*)result, _mm_unpacklo_epi16(v01_lo, v23_lo));
+            _mm_storeu_si128((__m128i*)(result + 16), _mm_unpackhi_epi16(v01_lo, v23_lo));
+            _mm_storeu_si128((__m128i*)(result + 32), _mm_unpacklo_epi16(v01_hi, v23_hi));
+            _mm_storeu_si128((__m128i*)(result + 48), _mm_unpackhi_epi16(v01_hi, v23_hi));
+            packed += 16;
+            result += 64;
+        }
+
+    volk_gnsssdr_8u_unpack_2bit_8i_generic(result, packed, tables, num_bytes - sse_iters * 16);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_u_avx2(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+{
+    const unsigned int avx2_iters = num_bytes / 32;
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    __m256i low_table[4];
+    __m256i high_table[4];
+    __m256i b, low, high, v0, v1, v2, v3, v01_lo, v01_hi, v23_lo, v23_hi, r0, r1, r2, r3;
+    unsigned int number;
+    unsigned int k;
+
+    // vpshufb looks up within each 128-bit lane, so both lanes get the tables
+    for (k = 0; k < 4; k++)
+        {
+            low_table[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tables + 16 * k)));
+            high_table[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tables + 64 + 16 * k)));
+        }
+
+    for (number = 0; number < avx2_iters; number++)
+        {
+            b = _mm256_loadu_si256((const __m256i*)packed);
+            low = _mm256_and_si256(b, nibble_mask);
+            high = _mm256_and_si256(_mm256_srli_epi64(b, 4), nibble_mask);
+            v0 = _mm256_add_epi8(_mm256_shuffle_epi8(low_table[0], low), _mm256_shuffle_epi8(high_table[0], high));
+            v1 = _mm256_add_epi8(_mm256_shuffle_epi8(low_table[1], low), _mm256_shuffle_epi8(high_table[1], high));
+            v2 = _mm256_add_epi8(_mm256_shuffle_epi8(low_table[2], low), _mm256_shuffle_epi8(high_table[2], high));
+            v3 = _mm256_add_epi8(_mm256_shuffle_epi8(low_table[3], low), _mm256_shuffle_epi8(high_table[3], high));
+
+            // the unpacks also work within lanes: r0 holds the outputs of bytes
+            // 0-3 and 16-19, r1 of bytes 4-7 and 20-23, and so on
+            v01_lo = _mm256_unpacklo_epi8(v0, v1);
+            v01_hi = _mm256_unpackhi_epi8(v0, v1);
+            v23_lo = _mm256_unpacklo_epi8(v2, v3);
+            v23_hi = _mm256_unpackhi_epi8(v2, v3);
+            r0 = _mm256_unpacklo_epi16(v01_lo, v23_lo);
+            r1 = _mm256_unpackhi_epi16(v01_lo, v23_lo);
+            r2 = _mm256_unpacklo_epi16(v01_hi, v23_hi);
+            r3 = _mm256_unpackhi_epi16(v01_hi, v23_hi);
+            _mm256_storeu_si256((__m256i*)result, _mm256_permute2x128_si256(r0, r1, 0x20));
+            _mm256_storeu_si256((__m256i*)(result + 32), _mm256_permute2x128_si256(r2, r3, 0x20));
+            _mm256_storeu_si256((__m256i*)(result + 64), _mm256_permute2x128_si256(r0, r1, 0x31));
+            _mm256_storeu_si256((__m256i*)(result + 96), _mm256_permute2x128_si256(r2, r3, 0x31));
+            packed += 32;
+            result += 128;
+        }
+
+    volk_gnsssdr_8u_unpack_2bit_8i_generic(result, packed, tables, num_bytes - avx2_iters * 32);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_unpack_2bit_8i_neon(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+{
+    const unsigned int neon_iters = num_bytes / 8;
+    const uint8x8_t nibble_mask = vdup_n_u8(0x0F);
+    const uint8_t* utables = (const uint8_t*)tables;
+    uint8x8x2_t low_table[4];
+    uint8x8x2_t high_table[4];
+    uint8x8_t b, low, high, v0, v1, v2, v3;
+    uint8x8x2_t v01, v23;
+    uint16x4x2_t r0, r1;
+    unsigned int number;
+    unsigned int k;
+
+    for (k = 0; k < 4; k++)
+        {
+            low_table[k].val[0] = vld1_u8(utables + 16 * k);
+            low_table[k].val[1] = vld1_u8(utables + 16 * k + 8);
+            high_table[k].val[0] = vld1_u8(utables + 64 + 16 * k);
+            high_table[k].val[1] = vld1_u8(utables + 64 + 16 * k + 8);
+        }
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            b = vld1_u8(packed);
+            low = vand_u8(b, nibble_mask);
+            high = vshr_n_u8(b, 4);
+            v0 = vadd_u8(vtbl2_u8(low_table[0], low), vtbl2_u8(high_table[0], high));
+            v1 = vadd_u8(vtbl2_u8(low_table[1], low), vtbl2_u8(high_table[1], high));
+            v2 = vadd_u8(vtbl2_u8(low_table[2], low), vtbl2_u8(high_table[2], high));
+            v3 = vadd_u8(vtbl2_u8(low_table[3], low), vtbl2_u8(high_table[3], high));
+
+            // interleave the four outputs of each byte
+            v01 = vzip_u8(v0, v1);
+            v23 = vzip_u8(v2, v3);
+            r0 = vzip_u16(vreinterpret_u16_u8(v01.val[0]), vreinterpret_u16_u8(v23.val[0]));
+            r1 = vzip_u16(vreinterpret_u16_u8(v01.val[1]), vreinterpret_u16_u8(v23.val[1]));
+            vst1_u8((uint8_t*)result, vreinterpret_u8_u16(r0.val[0]));
+            vst1_u8((uint8_t*)(result + 8), vreinterpret_u8_u16(r0.val[1]));
+            vst1_u8((uint8_t*)(result + 16), vreinterpret_u8_u16(r1.val[0]));
+            vst1_u8((uint8_t*)(result + 24), vreinterpret_u8_u16(r1.val[1]));
+            packed += 8;
+            result += 32;
+        }
+
+    volk_gnsssdr_8u_unpack_2bit_8i_generic(result, packed, tables, num_bytes - neon_iters * 8);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack_2bit_8i_H */
@@ -0,0 +1,183 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack_4bit_8i.h
+ * \brief VOLK_GNSSSDR kernel: unpacks two 4-bit samples from each byte.
+ *
+ * VOLK_GNSSSDR kernel that unpacks bytes holding two 4-bit samples into two
+ * signed char values, looking up the low and high nibbles of each byte in
+ * 16-entry tables.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_unpack_4bit_8i
+ *
+ * \b Overview
+ *
+ * Unpacks each byte of \p packed into two values of \p result. The k-th
+ * value of byte b is tables[16 * k + (b & 0x0F)] + tables[32 + 16 * k + (b >> 4)]
+ * (modulo 256), for k = 0, 1. The order of the samples in the output and the
+ * value given to each code are only seen through the tables, which the
+ * caller builds once. Each table maps to a byte shuffle instruction.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_unpack_4bit_8i(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+ * \endcode
+ *
+ * \b Inputs
+ * \li packed: Bytes with two 4-bit samples each.
+ * \li tables: 64 bytes. Entries 16 * k + i give the contribution of low
+ * nibble i to the k-th output, and entries 32 + 16 * k + i the contribution
+ * of high nibble i, for k = 0, 1 and i = 0..15.
+ * \li num_bytes: Number of bytes to unpack.
+ *
+ * \b Outputs
+ * \li result: 2 * num_bytes unpacked values.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack_4bit_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack_4bit_8i_H
+
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack_4bit_8i_generic(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+{
+    unsigned int i;
+    for (i = 0; i < num_bytes; i++)
+        {
+            const unsigned int low = packed[i] & 0x0F;
+            const unsigned int high = packed[i] >> 4;
+            *result++ = (int8_t)(tables[low] + tables[32 + high]);
+            *result++ = (int8_t)(tables[16 + low] + tables[48 + high]);
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_4bit_8i_u_ssse3(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+{
+    const unsigned int sse_iters = num_bytes / 16;
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i low_table0 = _mm_loadu_si128((const __m128i*)tables);
+    const __m128i low_table1 = _mm_loadu_si128((const __m128i*)(tables + 16));
+    const __m128i high_table0 = _mm_loadu_si128((const __m128i*)(tables + 32));
+    const __m128i high_table1 = _mm_loadu_si128((const __m128i*)(tables + 48));
+    __m128i b, low, high, v0, v1;
+    unsigned int number;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            b = _mm_loadu_si128((const __m128i*)packed);
+            low = _mm_and_si128(b, nibble_mask);
+            high = _mm_and_si128(_mm_srli_epi64(b, 4), nibble_mask);
+            v0 = _mm_add_epi8(_mm_shuffle_epi8(low_table0, low), _mm_shuffle_epi8(high_table0, high));
+            v1 = _mm_add_epi8(_mm_shuffle_epi8(low_table1, low), _mm_shuffle_epi8(high_table1, high));
+            _mm_storeu_si128((__m128i*)result, _mm_unpacklo_epi8(v0, v1));
+            _mm_storeu_si128((__m128i*)(result + 16), _mm_unpackhi_epi8(v0, v1));
+            packed += 16;
+            result += 32;
+        }
+
+    volk_gnsssdr_8u_unpack_4bit_8i_generic(result, packed, tables, num_bytes - sse_iters * 16);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_4bit_8i_u_avx2(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+{
+    const unsigned int avx2_iters = num_bytes / 32;
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    // vpshufb looks up within each 128-bit lane, so both lanes get the tables
+    const __m256i low_table0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)tables));
+    const __m256i low_table1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tables + 16)));
+    const __m256i high_table0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tables + 32)));
+    const __m256i high_table1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tables + 48)));
+    __m256i b, low, high, v0, v1, r0, r1;
+    unsigned int number;
+
+    for (number = 0; number < avx2_iters; number++)
+        {
+            b = _mm256_loadu_si256((const __m256i*)packed);
+            low = _mm256_and_si256(b, nibble_mask);
+            high = _mm256_and_si256(_mm256_srli_epi64(b, 4), nibble_mask);
+            v0 = _mm256_add_epi8(_mm256_shuffle_epi8(low_table0, low), _mm256_shuffle_epi8(high_table0, high));
+            v1 = _mm256_add_epi8(_mm256_shuffle_epi8(low_table1, low), _mm256_shuffle_epi8(high_table1, high));
+
+            // r0 holds the outputs of bytes 0-7 and 16-23, r1 of bytes 8-15 and 24-31
+            r0 = _mm256_unpacklo_epi8(v0, v1);
+            r1 = _mm256_unpackhi_epi8(v0, v1);
+            _mm256_storeu_si256((__m256i*)result, _mm256_permute2x128_si256(r0, r1, 0x20));
+            _mm256_storeu_si256((__m256i*)(result + 32), _mm256_permute2x128_si256(r0, r1, 0x31));
+            packed += 32;
+            result += 64;
+        }
+
+    volk_gnsssdr_8u_unpack_4bit_8i_generic(result, packed, tables, num_bytes - avx2_iters * 32);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_unpack_4bit_8i_neon(int8_t* result, const uint8_t* packed, const int8_t* tables, unsigned int num_bytes)
+{
+    const unsigned int neon_iters = num_bytes / 8;
+    const uint8x8_t nibble_mask = vdup_n_u8(0x0F);
+    const uint8_t* utables = (const uint8_t*)tables;
+    uint8x8x2_t low_table0, low_table1, high_table0, high_table1;
+    uint8x8_t b, low, high, v0, v1;
+    uint8x8x2_t r;
+    unsigned int number;
+
+    low_table0.val[0] = vld1_u8(utables);
+    low_table0.val[1] = vld1_u8(utables + 8);
+    low_table1.val[0] = vld1_u8(utables + 16);
+    low_table1.val[1] = vld1_u8(utables + 24);
+    high_table0.val[0] = vld1_u8(utables + 32);
+    high_table0.val[1] = vld1_u8(utables + 40);
+    high_table1.val[0] = vld1_u8(utables + 48);
+    high_table1.val[1] = vld1_u8(utables + 56);
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            b = vld1_u8(packed);
+            low = vand_u8(b, nibble_mask);
+            high = vshr_n_u8(b, 4);
+            v0 = vadd_u8(vtbl2_u8(low_table0, low), vtbl2_u8(high_table0, high));
+            v1 = vadd_u8(vtbl2_u8(low_table1, low), vtbl2_u8(high_table1, high));
+            r = vzip_u8(v0, v1);
+            vst1_u8((uint8_t*)result, r.val[0]);
+            vst1_u8((uint8_t*)(result + 8), r.val[1]);
+            packed += 8;
+            result += 16;
+        }
+
+    volk_gnsssdr_8u_unpack_4bit_8i_generic(result, packed, tables, num_bytes - neon_iters * 8);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack_4bit_8i_H */
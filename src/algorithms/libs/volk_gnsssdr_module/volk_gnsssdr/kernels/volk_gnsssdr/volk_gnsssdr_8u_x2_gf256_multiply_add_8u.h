@@ -0,0 +1,182 @@
+/*!
+ * \file volk_gnsssdr_8u_x2_gf256_multiply_add_8u.h
+ * \brief VOLK_GNSSSDR kernel: multiplies a vector of GF(2^8) elements by a
+ * constant and adds the result to another vector.
+ *
+ * VOLK_GNSSSDR kernel that computes c = a + k * b over GF(2^8), with the
+ * product by the constant k looked up in two 16-entry tables indexed by the
+ * low and high nibbles of each element of b.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_x2_gf256_multiply_add_8u
+ *
+ * \b Overview
+ *
+ * Multiplies each element of \p bVector by a constant k of GF(2^8) and adds
+ * (XOR) the product to the corresponding element of \p aVector, storing the
+ * result in \p cVector. Since multiplication by a constant is linear over
+ * GF(2), k * b = k * (b & 0x0F) + k * (b & 0xF0), and both terms are read
+ * from a 16-entry table, which maps to a byte shuffle instruction. The
+ * constant and the field polynomial are only seen through the tables, which
+ * the caller builds once per constant. \p cVector can be the same as
+ * \p aVector.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_x2_gf256_multiply_add_8u(uint8_t* cVector, const uint8_t* aVector, const uint8_t* bVector, const uint8_t* tables, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li aVector: The vector to be added to.
+ * \li bVector: The vector to be multiplied by the constant.
+ * \li tables: 32 bytes. tables[i] = k * i and tables[16 + i] = k * (i << 4),
+ * for i = 0..15.
+ * \li num_points: The number of elements in the vectors.
+ *
+ * \b Outputs
+ * \li cVector: The vector where the result will be stored.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_x2_gf256_multiply_add_8u_H
+#define INCLUDED_volk_gnsssdr_8u_x2_gf256_multiply_add_8u_H
+
+#include <inttypes.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_x2_gf256_multiply_add_8u_generic(uint8_t* cVector, const uint8_t* aVector, const uint8_t* bVector, const uint8_t* tables, unsigned int num_points)
+{
+    unsigned int i;
+    for (i = 0; i < num_points; i++)
+        {
+            cVector[i] = aVector[i] ^ tables[bVector[i] & 0x0F] ^ tables[16 + (bVector[i] >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_x2_gf256_multiply_add_8u_u_ssse3(uint8_t* cVector, const uint8_t* aVector, const uint8_t* bVector, const uint8_t* tables, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 16;
+    const __m128i low_table = _mm_loadu_si128((const __m128i*)tables);
+    const __m128i high_table = _mm_loadu_si128((const __m128i*)(tables + 16));
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    unsigned int number;
+    unsigned int i;
+    __m128i a, b, low, high;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_loadu_si128((const __m128i*)aVector);
+            b = _mm_loadu_si128((const __m128i*)bVector);
+            low = _mm_shuffle_epi8(low_table, _mm_and_si128(b, nibble_mask));
+            high = _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi64(b, 4), nibble_mask));
+            _mm_storeu_si128((__m128i*)cVector, _mm_xor_si128(a, _mm_xor_si128(low, high)));
+            aVector += 16;
+            bVector += 16;
+            cVector += 16;
+        }
+
+    for (i = sse_iters * 16; i < num_points; i++)
+        {
+            *cVector++ = (*aVector++) ^ tables[*bVector & 0x0F] ^ tables[16 + (*bVector >> 4)];
+            bVector++;
+        }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_x2_gf256_multiply_add_8u_u_avx2(uint8_t* cVector, const uint8_t* aVector, const uint8_t* bVector, const uint8_t* tables, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 32;
+    // vpshufb looks up within each 128-bit lane, so both lanes get the tables
+    const __m256i low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)tables));
+    const __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tables + 16)));
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    unsigned int number;
+    unsigned int i;
+    __m256i a, b, low, high;
+
+    for (number = 0; number < avx2_iters; number++)
+        {
+            a = _mm256_loadu_si256((const __m256i*)aVector);
+            b = _mm256_loadu_si256((const __m256i*)bVector);
+            low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(b, nibble_mask));
+            high = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi64(b, 4), nibble_mask));
+            _mm256_storeu_si256((__m256i*)cVector, _mm256_xor_si256(a, _mm256_xor_si256(low, high)));
+            aVector += 32;
+            bVector += 32;
+            cVector += 32;
+        }
+
+    for (i = avx2_iters * 32; i < num_points; i++)
+        {
+            *cVector++ = (*aVector++) ^ tables[*bVector & 0x0F] ^ tables[16 + (*bVector >> 4)];
+            bVector++;
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_x2_gf256_multiply_add_8u_neon(uint8_t* cVector, const uint8_t* aVector, const uint8_t* bVector, const uint8_t* tables, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 8;
+    const uint8x8_t nibble_mask = vdup_n_u8(0x0F);
+    uint8x8x2_t low_table;
+    uint8x8x2_t high_table;
+    unsigned int number;
+    unsigned int i;
+    uint8x8_t a, b, low, high;
+
+    low_table.val[0] = vld1_u8(tables);
+    low_table.val[1] = vld1_u8(tables + 8);
+    high_table.val[0] = vld1_u8(tables + 16);
+    high_table.val[1] = vld1_u8(tables + 24);
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            a = vld1_u8(aVector);
+            b = vld1_u8(bVector);
+            low = vtbl2_u8(low_table, vand_u8(b, nibble_mask));
+            high = vtbl2_u8(high_table, vshr_n_u8(b, 4));
+            vst1_u8(cVector, veor_u8(a, veor_u8(low, high)));
+            aVector += 8;
+            bVector += 8;
+            cVector += 8;
+        }
+
+    for (i = neon_iters * 8; i < num_points; i++)
+        {
+            *cVector++ = (*aVector++) ^ tables[*bVector & 0x0F] ^ tables[16 + (*bVector >> 4)];
+            bVector++;
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_x2_gf256_multiply_add_8u_H */
@@ -0,0 +1,95 @@
+/*!
+ * \file volk_gnsssdr_8u_x2_gf256multiplyaddpuppet_8u.h
+ * \brief VOLK_GNSSSDR puppet for the GF(2^8) multiply-add kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the GF(2^8) multiply-add kernel into
+ * the test system. It multiplies by a fixed constant in the field of the
+ * Galileo Reed-Solomon codes (primitive polynomial x^8 + x^4 + x^3 + x^2 + 1).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_x2_gf256multiplyaddpuppet_8u_H
+#define INCLUDED_volk_gnsssdr_8u_x2_gf256multiplyaddpuppet_8u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_x2_gf256_multiply_add_8u.h"
+
+
+static inline void volk_gnsssdr_gf256multiplyaddpuppet_init(uint8_t* tables)
+{
+    int i;
+    for (i = 0; i < 32; i++)
+        {
+            uint8_t a = 0x8E;  // the constant
+            uint8_t b = (uint8_t)(i < 16 ? i : (i - 16) << 4);
+            uint8_t p = 0;
+            while (b)
+                {
+                    if (b & 1)
+                        {
+                            p ^= a;
+                        }
+                    a = (uint8_t)((a << 1) ^ ((a & 0x80) ? 0x1D : 0));
+                    b >>= 1;
+                }
+            tables[i] = p;
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_x2_gf256multiplyaddpuppet_8u_generic(uint8_t* cVector, const uint8_t* aVector, const uint8_t* bVector, unsigned int num_points)
+{
+    uint8_t tables[32];
+    volk_gnsssdr_gf256multiplyaddpuppet_init(tables);
+    volk_gnsssdr_8u_x2_gf256_multiply_add_8u_generic(cVector, aVector, bVector, tables, num_points);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void volk_gnsssdr_8u_x2_gf256multiplyaddpuppet_8u_u_ssse3(uint8_t* cVector, const uint8_t* aVector, const uint8_t* bVector, unsigned int num_points)
+{
+    uint8_t tables[32];
+    volk_gnsssdr_gf256multiplyaddpuppet_init(tables);
+    volk_gnsssdr_8u_x2_gf256_multiply_add_8u_u_ssse3(cVector, aVector, bVector, tables, num_points);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+
+static inline void volk_gnsssdr_8u_x2_gf256multiplyaddpuppet_8u_u_avx2(uint8_t* cVector, const uint8_t* aVector, const uint8_t* bVector, unsigned int num_points)
+{
+    uint8_t tables[32];
+    volk_gnsssdr_gf256multiplyaddpuppet_init(tables);
+    volk_gnsssdr_8u_x2_gf256_multiply_add_8u_u_avx2(cVector, aVector, bVector, tables, num_points);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+
+static inline void volk_gnsssdr_8u_x2_gf256multiplyaddpuppet_8u_neon(uint8_t* cVector, const uint8_t* aVector, const uint8_t* bVector, unsigned int num_points)
+{
+    uint8_t tables[32];
+    volk_gnsssdr_gf256multiplyaddpuppet_init(tables);
+    volk_gnsssdr_8u_x2_gf256_multiply_add_8u_neon(cVector, aVector, bVector, tables, num_points);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_x2_gf256multiplyaddpuppet_8u_H */
@@ -63,6 +63,10 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_x2_dot_prod_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_x2_multiply_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8u_x2_multiply_8u, test_params_more_iters))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_x2_gf256multiplyaddpuppet_8u, volk_gnsssdr_8u_x2_gf256_multiply_add_8u, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8i_viterbik7r2puppet_32u, volk_gnsssdr_8i_viterbi_k7r2_32u, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack2bitpuppet_8i, volk_gnsssdr_8u_unpack_2bit_8i, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack4bitpuppet_8i, volk_gnsssdr_8u_unpack_4bit_8i, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_64f_accumulator_64f, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32f_sincos_32fc, test_params_inacc))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32f_index_max_32u, test_params))
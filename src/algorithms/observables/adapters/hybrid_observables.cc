@@ -19,6 +19,7 @@
 #include "configuration_interface.h"
 #include "gnss_sdr_flags.h"
 #include "obs_conf.h"
+#include "obs_interpolation.h"
 #include <glog/logging.h>
 #include <ostream>  // for operator<<
 
@@ -38,12 +39,21 @@ HybridObservables::HybridObservables(const ConfigurationInterface* configuration
     conf.dump = dump_;
     conf.dump_mat = dump_mat_;
     conf.dump_filename = dump_filename_;
+    conf.dump_format = configuration->property(role + ".dump_format", conf.dump_format);
+    conf.dump_overflow = configuration->property(role + ".dump_overflow", conf.dump_overflow);
+    conf.dump_compression = configuration->property(role + ".dump_compression", conf.dump_compression);
     conf.nchannels_in = in_streams_;
     conf.nchannels_out = out_streams_;
     conf.observable_interval_ms = configuration->property("GNSS-SDR.observable_interval_ms", conf.observable_interval_ms);
     conf.enable_carrier_smoothing = configuration->property(role + ".enable_carrier_smoothing", conf.enable_carrier_smoothing);
     conf.always_output_gs = configuration->property("PVT.an_output_enabled", conf.always_output_gs) || configuration->property(role + ".always_output_gs", conf.always_output_gs);
     conf.enable_E6 = configuration->property("PVT.use_e6_for_pvt", conf.enable_E6);
+    conf.interpolation_order = configuration->property(role + ".interpolation_order", conf.interpolation_order);
+    if (conf.interpolation_order < 1 or conf.interpolation_order > OBS_MAX_INTERPOLATION_ORDER)
+        {
+            LOG(WARNING) << "Parameter " << role << ".interpolation_order should be between 1 and " << OBS_MAX_INTERPOLATION_ORDER << ". Setting it to 1";
+            conf.interpolation_order = 1;
+        }
 
     if (FLAGS_carrier_smoothing_factor == DEFAULT_CARRIER_SMOOTHING_FACTOR)
         {
@@ -23,9 +23,9 @@
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
+#include "obs_interpolation.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
-#include <matio.h>
 #include <pmt/pmt.h>
 #include <algorithm>  // for std::min
 #include <array>
@@ -50,6 +50,20 @@ namespace wht = std;
 #endif
 
 
+namespace
+{
+// Fields of each record of the dump file, one record per output channel and epoch
+const std::vector<Dump_Column> obs_dump_schema{
+    {"RX_time", Dump_Type::FLOAT64},
+    {"TOW_at_current_symbol_s", Dump_Type::FLOAT64},
+    {"Carrier_Doppler_hz", Dump_Type::FLOAT64},
+    {"Carrier_phase_cycles", Dump_Type::FLOAT64},
+    {"Pseudorange_m", Dump_Type::FLOAT64},
+    {"PRN", Dump_Type::FLOAT64},
+    {"Flag_valid_pseudorange", Dump_Type::FLOAT64}};
+}  // namespace
+
+
 hybrid_observables_gs_sptr hybrid_observables_gs_make(const Obs_Conf &conf_)
 {
     return hybrid_observables_gs_sptr(new hybrid_observables_gs(conf_));
@@ -136,36 +150,41 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
                     std::cerr << "GNSS-SDR cannot create dump file for the Observables block. Wrong permissions?\n";
                     d_dump = false;
                 }
-            d_dump_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-            try
-                {
-                    d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
-                    LOG(INFO) << "Observables dump enabled Log file: " << d_dump_filename.c_str();
-                }
-            catch (const std::ofstream::failure &e)
+            else
                 {
-                    LOG(WARNING) << "Exception opening observables dump file " << e.what();
-                    d_dump = false;
+                    // One record per output channel and epoch, so keep room for a few seconds of epochs
+                    d_dump_writer = std::make_unique<Gnss_Dump_Writer>(obs_dump_schema,
+                        dump_format_from_string(conf_.dump_format),
+                        conf_.dump_compression,
+                        std::max<size_t>(8192, 256 * static_cast<size_t>(d_nchannels_out)));
+                    d_dump_writer->set_overflow_policy(dump_overflow_from_string(conf_.dump_overflow));
+                    if (d_dump_writer->open(d_dump_filename))
+                        {
+                            LOG(INFO) << "Observables dump enabled Log file: " << d_dump_filename.c_str();
+                        }
+                    else
+                        {
+                            LOG(WARNING) << "Error opening observables dump file " << d_dump_filename;
+                            d_dump_writer.reset();
+                            d_dump = false;
+                        }
                 }
         }
+    d_counters = Block_Instrumentation::instance().register_block(this->name());
 }
 
 
 hybrid_observables_gs::~hybrid_observables_gs()
 {
     DLOG(INFO) << "Observables block destructor called.";
-    if (d_dump_file.is_open())
+    if (d_dump_writer)
         {
-            const auto pos = d_dump_file.tellp();
-            try
+            d_dump_writer->close();
+            if (d_dump_writer->dropped_records() > 0)
                 {
-                    d_dump_file.close();
+                    LOG(WARNING) << d_dump_writer->dropped_records() << " observables dump records were dropped";
                 }
-            catch (const std::exception &ex)
-                {
-                    LOG(WARNING) << "Exception in destructor closing the dump file " << ex.what();
-                }
-            if (pos == 0)
+            if (d_dump_writer->written_records() == 0)
                 {
                     errorlib::error_code ec;
                     if (!fs::remove(fs::path(d_dump_filename), ec))
@@ -189,6 +208,17 @@ hybrid_observables_gs::~hybrid_observables_gs()
 }
 
 
+bool hybrid_observables_gs::stop()
+{
+    // Records still in the ring buffer reach the file before the flowgraph is reported as stopped
+    if (d_dump_writer)
+        {
+            d_dump_writer->flush();
+        }
+    return true;
+}
+
+
 void hybrid_observables_gs::msg_handler_pvt_to_observables(const pmt::pmt_t &msg)
 {
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
@@ -242,138 +272,14 @@ void hybrid_observables_gs::msg_handler_pvt_to_observables(const pmt::pmt_t &msg
 
 int32_t hybrid_observables_gs::save_matfile() const
 {
-    // READ DUMP FILE
-    const std::string dump_filename = d_dump_filename;
-    std::ifstream::pos_type size;
-    const int32_t number_of_double_vars = 7;
-    const int32_t epoch_size_bytes = sizeof(double) * number_of_double_vars * d_nchannels_out;
-    std::ifstream dump_file;
-    std::cout << "Generating .mat file for " << dump_filename << '\n';
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-        {
-            dump_file.open(dump_filename.c_str(), std::ios::binary | std::ios::ate);
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem opening dump file:" << e.what() << '\n';
-            return 1;
-        }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0LL;
-    if (dump_file.is_open())
-        {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
-        }
-    else
-        {
-            return 1;
-        }
-
-    auto RX_time = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto TOW_at_current_symbol_s = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto Carrier_Doppler_hz = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto Carrier_phase_cycles = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto Pseudorange_m = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto PRN = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-    auto Flag_valid_pseudorange = std::vector<std::vector<double>>(d_nchannels_out, std::vector<double>(num_epoch));
-
-    try
-        {
-            if (dump_file.is_open())
-                {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            for (uint32_t chan = 0; chan < d_nchannels_out; chan++)
-                                {
-                                    dump_file.read(reinterpret_cast<char *>(&RX_time[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&TOW_at_current_symbol_s[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Carrier_Doppler_hz[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Carrier_phase_cycles[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Pseudorange_m[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&PRN[chan][i]), sizeof(double));
-                                    dump_file.read(reinterpret_cast<char *>(&Flag_valid_pseudorange[chan][i]), sizeof(double));
-                                }
-                        }
-                }
-            dump_file.close();
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem reading dump file:" << e.what() << '\n';
-            return 1;
-        }
-
-    auto RX_time_aux = std::vector<double>(d_nchannels_out * num_epoch);
-    auto TOW_at_current_symbol_s_aux = std::vector<double>(d_nchannels_out * num_epoch);
-    auto Carrier_Doppler_hz_aux = std::vector<double>(d_nchannels_out * num_epoch);
-    auto Carrier_phase_cycles_aux = std::vector<double>(d_nchannels_out * num_epoch);
-    auto Pseudorange_m_aux = std::vector<double>(d_nchannels_out * num_epoch);
-    auto PRN_aux = std::vector<double>(d_nchannels_out * num_epoch);
-    auto Flag_valid_pseudorange_aux = std::vector<double>(d_nchannels_out * num_epoch);
-
-    uint32_t k = 0U;
-    for (int64_t j = 0; j < num_epoch; j++)
-        {
-            for (uint32_t i = 0; i < d_nchannels_out; i++)
-                {
-                    RX_time_aux[k] = RX_time[i][j];
-                    TOW_at_current_symbol_s_aux[k] = TOW_at_current_symbol_s[i][j];
-                    Carrier_Doppler_hz_aux[k] = Carrier_Doppler_hz[i][j];
-                    Carrier_phase_cycles_aux[k] = Carrier_phase_cycles[i][j];
-                    Pseudorange_m_aux[k] = Pseudorange_m[i][j];
-                    PRN_aux[k] = PRN[i][j];
-                    Flag_valid_pseudorange_aux[k] = Flag_valid_pseudorange[i][j];
-                    k++;
-                }
-        }
-
-    // WRITE MAT FILE
-    mat_t *matfp;
-    matvar_t *matvar;
     std::string filename = d_dump_filename;
     if (filename.size() > 4)
         {
             filename.erase(filename.end() - 4, filename.end());
         }
     filename.append(".mat");
-    matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
-    if (reinterpret_cast<int64_t *>(matfp) != nullptr)
-        {
-            std::array<size_t, 2> dims{static_cast<size_t>(d_nchannels_out), static_cast<size_t>(num_epoch)};
-            matvar = Mat_VarCreate("RX_time", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), RX_time_aux.data(), MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("TOW_at_current_symbol_s", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), TOW_at_current_symbol_s_aux.data(), MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Carrier_Doppler_hz", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), Carrier_Doppler_hz_aux.data(), MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Carrier_phase_cycles", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), Carrier_phase_cycles_aux.data(), MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Pseudorange_m", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), Pseudorange_m_aux.data(), MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), PRN_aux.data(), MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Flag_valid_pseudorange", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), Flag_valid_pseudorange_aux.data(), MAT_F_DONT_COPY_DATA);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-        }
-    Mat_Close(matfp);
-
-    return 0;
+    // Each variable is a matrix of d_nchannels_out rows by number of epochs
+    return save_dump_matfile(d_dump_filename, filename, obs_dump_schema, d_dump_writer->format(), d_nchannels_out);
 }
 
 
@@ -385,16 +291,13 @@ double hybrid_observables_gs::compute_T_rx_s(const Gnss_Synchro &a) const
 
 bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint32_t ch, uint64_t rx_clock) const
 {
-    int32_t nearest_element = -1;
+    // The history of each channel is sorted by Tracking_sample_counter
+    const int32_t nearest_element = find_nearest_sample(d_gnss_synchro_history->size(ch), rx_clock,
+        [this, ch](uint32_t i) { return d_gnss_synchro_history->get(ch, i).Tracking_sample_counter; });
     int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
-    for (uint32_t i = 0; i < d_gnss_synchro_history->size(ch); i++)
+    if (nearest_element != -1)
         {
-            const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->get(ch, i).Tracking_sample_counter));
-            if (old_abs_diff > abs_diff)
-                {
-                    old_abs_diff = abs_diff;
-                    nearest_element = static_cast<int32_t>(i);
-                }
+            old_abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter));
         }
 
     if (nearest_element != -1 and nearest_element != static_cast<int32_t>(d_gnss_synchro_history->size(ch)))
@@ -459,6 +362,12 @@ bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint3
                                     interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms + 604800000) - static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
                                 }
 
+                            // Higher order interpolation over the neighbors of [t1, t2], if available
+                            if (d_conf.interpolation_order > 1)
+                                {
+                                    interp_trk_obs_lagrange(interpolated_obs, ch, t1_idx, T_rx_s);
+                                }
+
                             // LOG(INFO) << "Channel " << ch << " int idx: " << t1_idx << " TOW Int: " << interpolated_obs.interp_TOW_ms
                             //           << " TOW p1 : " << d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms
                             //           << " TOW p2: "
@@ -481,6 +390,48 @@ bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint3
 }
 
 
+void hybrid_observables_gs::interp_trk_obs_lagrange(Gnss_Synchro &interpolated_obs, uint32_t ch, int32_t t1_idx, double T_rx_s) const
+{
+    const auto n_points = static_cast<int32_t>(d_conf.interpolation_order + 1);
+    const auto history_size = static_cast<int32_t>(d_gnss_synchro_history->size(ch));
+    if (history_size < n_points)
+        {
+            return;
+        }
+    // Points centered around the [t1, t2] interval
+    const int32_t first = std::max(0, std::min(t1_idx - (n_points - 2) / 2, history_size - n_points));
+
+    std::array<double, OBS_MAX_INTERPOLATION_ORDER + 1> t{};
+    std::array<double, OBS_MAX_INTERPOLATION_ORDER + 1> weights{};
+    for (int32_t k = 0; k < n_points; k++)
+        {
+            t[k] = d_gnss_synchro_history->get(ch, first + k).RX_time - T_rx_s;
+        }
+    lagrange_weights(t.data(), static_cast<uint32_t>(n_points), 0.0, weights.data());
+
+    const uint32_t first_tow_ms = d_gnss_synchro_history->get(ch, first).TOW_at_current_symbol_ms;
+    double carrier_phase_rads = 0.0;
+    double carrier_doppler_hz = 0.0;
+    double tow_ms = 0.0;
+    for (int32_t k = 0; k < n_points; k++)
+        {
+            const Gnss_Synchro &obs = d_gnss_synchro_history->get(ch, first + k);
+            carrier_phase_rads += weights[k] * obs.Carrier_phase_rads;
+            carrier_doppler_hz += weights[k] * obs.Carrier_Doppler_hz;
+            // check TOW rollover
+            double obs_tow_ms = static_cast<double>(obs.TOW_at_current_symbol_ms);
+            if (obs.TOW_at_current_symbol_ms < first_tow_ms)
+                {
+                    obs_tow_ms += 604800000.0;
+                }
+            tow_ms += weights[k] * obs_tow_ms;
+        }
+    interpolated_obs.Carrier_phase_rads = carrier_phase_rads;
+    interpolated_obs.Carrier_Doppler_hz = carrier_doppler_hz;
+    interpolated_obs.interp_TOW_ms = tow_ms;
+}
+
+
 void hybrid_observables_gs::forecast(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items_required)
 {
     for (int32_t n = 0; n < static_cast<int32_t>(d_nchannels_in) - 1; n++)
@@ -654,6 +605,7 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
     gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
+    Block_Work_Timer work_timer(d_counters.get(), ninput_items[d_nchannels_in - 1]);
     const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
 
@@ -688,6 +640,7 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                 }
 
             // Consume one item from the clock channel (last of the input channels)
+            work_timer.set_items(1);
             consume(static_cast<int32_t>(d_nchannels_in) - 1, 1);
         }
 
@@ -815,32 +768,18 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
             if (d_dump)
                 {
                     // MULTIPLEXED FILE RECORDING - Record results to file
-                    try
+                    Gnss_Dump_Record record(*d_dump_writer, d_nchannels_out);
+                    for (uint32_t i = 0; i < d_nchannels_out; i++)
                         {
-                            double tmp_double;
-                            for (uint32_t i = 0; i < d_nchannels_out; i++)
-                                {
-                                    tmp_double = out[i][0].RX_time;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].interp_TOW_ms / 1000.0;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_Doppler_hz;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_phase_rads / TWO_PI;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Pseudorange_m;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].PRN);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].Flag_valid_pseudorange);
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                }
-                        }
-                    catch (const std::ofstream::failure &e)
-                        {
-                            LOG(WARNING) << "Exception writing observables dump file " << e.what();
-                            d_dump = false;
+                            record.add(out[i][0].RX_time)
+                                .add(out[i][0].interp_TOW_ms / 1000.0)
+                                .add(out[i][0].Carrier_Doppler_hz)
+                                .add(out[i][0].Carrier_phase_rads / TWO_PI)
+                                .add(out[i][0].Pseudorange_m)
+                                .add(static_cast<double>(out[i][0].PRN))
+                                .add(static_cast<double>(out[i][0].Flag_valid_pseudorange));
                         }
+                    record.commit();
                 }
 
             if (n_valid > 0)
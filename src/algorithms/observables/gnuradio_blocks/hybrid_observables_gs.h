@@ -20,7 +20,9 @@
 #ifndef GNSS_SDR_HYBRID_OBSERVABLES_GS_H
 #define GNSS_SDR_HYBRID_OBSERVABLES_GS_H
 
+#include "block_instrumentation.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
 #include "gnss_time.h"  // for timetags produced by Tracking
 #include "obs_conf.h"
 #include <boost/circular_buffer.hpp>  // for boost::circular_buffer
@@ -28,7 +30,6 @@
 #include <gnuradio/types.h>           // for gr_vector_int
 #include <cstddef>                    // for size_t
 #include <cstdint>                    // for int32_t
-#include <fstream>                    // for std::ofstream
 #include <memory>                     // for std::shared, std:unique_ptr
 #include <queue>                      // for std::queue
 #include <string>                     // for std::string
@@ -59,6 +60,7 @@ class hybrid_observables_gs : public gr::block
 {
 public:
     ~hybrid_observables_gs();
+    bool stop() override;
     void forecast(int noutput_items, gr_vector_int& ninput_items_required);
     int general_work(int noutput_items, gr_vector_int& ninput_items,
         gr_vector_const_void_star& input_items, gr_vector_void_star& output_items);
@@ -74,6 +76,7 @@ private:
     void msg_handler_pvt_to_observables(const pmt::pmt_t& msg);
     double compute_T_rx_s(const Gnss_Synchro& a) const;
     bool interp_trk_obs(Gnss_Synchro& interpolated_obs, uint32_t ch, uint64_t rx_clock) const;
+    void interp_trk_obs_lagrange(Gnss_Synchro& interpolated_obs, uint32_t ch, int32_t t1_idx, double T_rx_s) const;
     void update_TOW(const std::vector<Gnss_Synchro>& data);
     void compute_pranges(std::vector<Gnss_Synchro>& data) const;
     void smooth_pseudoranges(std::vector<Gnss_Synchro>& data);
@@ -96,7 +99,8 @@ private:
 
     std::string d_dump_filename;
 
-    std::ofstream d_dump_file;
+    std::unique_ptr<Gnss_Dump_Writer> d_dump_writer;
+    std::shared_ptr<Block_Counters> d_counters;
 
     double d_smooth_filter_M;
     double d_T_rx_step_s;
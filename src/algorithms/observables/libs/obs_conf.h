@@ -33,14 +33,18 @@ public:
     Obs_Conf();
 
     std::string dump_filename{"obs_dump.dat"};
+    std::string dump_format{"binary"};
+    std::string dump_overflow{"block"};
     int32_t smoothing_factor{0};
     uint32_t nchannels_in{0U};
     uint32_t nchannels_out{0U};
     uint32_t observable_interval_ms{20U};
+    uint32_t interpolation_order{1U};  // 1: linear, 2: quadratic, >2: Lagrange of that degree
     bool enable_carrier_smoothing{false};
     bool always_output_gs{false};
     bool dump{false};
     bool dump_mat{false};
+    bool dump_compression{false};
     bool enable_E6{false};
 };
 
@@ -0,0 +1,34 @@
+/*!
+ * \file obs_interpolation.cc
+ * \brief Helpers for the interpolation of the tracking observables at the
+ * receiver epochs
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_interpolation.h"
+
+
+void lagrange_weights(const double* t, uint32_t n_points, double t_interp, double* weights)
+{
+    for (uint32_t k = 0; k < n_points; k++)
+        {
+            double w = 1.0;
+            for (uint32_t j = 0; j < n_points; j++)
+                {
+                    if (j != k)
+                        {
+                            w *= (t_interp - t[j]) / (t[k] - t[j]);
+                        }
+                }
+            weights[k] = w;
+        }
+}
@@ -0,0 +1,92 @@
+/*!
+ * \file obs_interpolation.h
+ * \brief Helpers for the interpolation of the tracking observables at the
+ * receiver epochs
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_INTERPOLATION_H
+#define GNSS_SDR_OBS_INTERPOLATION_H
+
+#include <cstdint>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Maximum degree of the interpolating polynomial
+ */
+constexpr uint32_t OBS_MAX_INTERPOLATION_ORDER = 5U;
+
+
+/*!
+ * \brief Returns the index of the element whose sample counter is the
+ * nearest to rx_clock, or -1 if size is 0. On a tie, the lowest index is
+ * returned.
+ *
+ * sample_counter(i) must return the sample counter of the i-th element, and
+ * the counters must be non-decreasing with i, so a binary search is used.
+ */
+template <typename Sample_Counter>
+int32_t find_nearest_sample(uint32_t size, uint64_t rx_clock, Sample_Counter sample_counter)
+{
+    if (size == 0)
+        {
+            return -1;
+        }
+    // first element with sample_counter >= rx_clock
+    uint32_t low = 0;
+    uint32_t high = size;
+    while (low < high)
+        {
+            const uint32_t mid = low + (high - low) / 2;
+            if (sample_counter(mid) < rx_clock)
+                {
+                    low = mid + 1;
+                }
+            else
+                {
+                    high = mid;
+                }
+        }
+    uint32_t nearest = low;
+    if (low == size)
+        {
+            nearest = size - 1;
+        }
+    else if (low > 0 and (rx_clock - sample_counter(low - 1)) <= (sample_counter(low) - rx_clock))
+        {
+            nearest = low - 1;
+        }
+    // repeated sample counters are a tie too
+    while (nearest > 0 and sample_counter(nearest - 1) == sample_counter(nearest))
+        {
+            nearest--;
+        }
+    return static_cast<int32_t>(nearest);
+}
+
+
+/*!
+ * \brief Computes the weights of the Lagrange polynomial through the
+ * abscissae t[0], ..., t[n_points - 1], evaluated at t_interp, so that the
+ * interpolated value is sum(weights[k] * y[k]).
+ */
+void lagrange_weights(const double* t, uint32_t n_points, double t_interp, double* weights);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_INTERPOLATION_H
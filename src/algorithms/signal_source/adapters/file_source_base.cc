@@ -50,12 +50,15 @@ FileSourceBase::FileSourceBase(ConfigurationInterface const* configuration, std:
       item_size_(0),
       header_size_(configuration->property(role_ + ".header_size"s, uint64_t(0))),
       samples_(configuration->property(role_ + ".samples"s, uint64_t(0))),
+      mmap_prefetch_mb_(configuration->property(role_ + ".mmap_prefetch_mb"s, uint64_t(64))),
       sampling_frequency_(configuration->property(role_ + ".sampling_frequency"s, int64_t(0))),
       minimum_tail_s_(0.1),
       seconds_to_skip_(configuration->property(role_ + ".seconds_to_skip"s, 0.0)),
       is_complex_(false),
       repeat_(configuration->property(role_ + ".repeat"s, false)),
       enable_throttle_control_(configuration->property(role_ + ".enable_throttle_control"s, false)),
+      use_mmap_(configuration->property(role_ + ".use_mmap"s, false)),
+      mmap_huge_pages_(configuration->property(role_ + ".mmap_huge_pages"s, false)),
       dump_(configuration->property(role_ + ".dump"s, false))
 {
     minimum_tail_s_ = std::max(configuration->property("Acquisition_1C.coherent_integration_time_ms", 0.0) * 0.001 * 2.0, minimum_tail_s_);
@@ -135,6 +138,7 @@ void FileSourceBase::init()
     DLOG(INFO) << "Item type " << item_type_;
     DLOG(INFO) << "Item size " << item_size_;
     DLOG(INFO) << "Repeat " << repeat_;
+    DLOG(INFO) << "Memory-mapped " << (mmap_source_ != nullptr);
 
     DLOG(INFO) << "Dump " << dump_;
     DLOG(INFO) << "Dump filename " << dump_filename_;
@@ -459,13 +463,20 @@ bool FileSourceBase::is_complex() const { return is_complex_; }
 
 // Simple accessors
 gnss_shared_ptr<gr::block> FileSourceBase::source() const { return file_source(); }
-gnss_shared_ptr<gr::block> FileSourceBase::file_source() const { return file_source_; }
+gnss_shared_ptr<gr::block> FileSourceBase::file_source() const
+{
+    if (mmap_source_)
+        {
+            return mmap_source_;
+        }
+    return file_source_;
+}
 gnss_shared_ptr<gr::block> FileSourceBase::valve() const { return valve_; }
 gnss_shared_ptr<gr::block> FileSourceBase::throttle() const { return throttle_; }
 gnss_shared_ptr<gr::block> FileSourceBase::sink() const { return sink_; }
 
 
-gr::blocks::file_source::sptr FileSourceBase::create_file_source()
+gnss_shared_ptr<gr::block> FileSourceBase::create_file_source()
 {
     auto item_tuple = itemTypeToSize();
     item_size_ = std::get<0>(item_tuple);
@@ -476,9 +487,25 @@ gr::blocks::file_source::sptr FileSourceBase::create_file_source()
             // TODO: why are we manually seeking, instead of passing the samples_to_skip to the file_source factory?
             auto samples_to_skip = samplesToSkip();
 
-            file_source_ = gr::blocks::file_source::make(item_size(), filename().data(), repeat());
+            if (use_mmap_)
+                {
+                    try
+                        {
+                            // The mapping makes skipping samples a constant-time operation
+                            mmap_source_ = make_mmap_file_source(item_size(), filename(), repeat(), samples_to_skip, mmap_prefetch_mb_ * 1024 * 1024, mmap_huge_pages_);
+                            LOG(INFO) << "Reading " << filename() << " through a memory mapping, starting at item " << samples_to_skip;
+                        }
+                    catch (const std::exception& e)
+                        {
+                            LOG(WARNING) << e.what() << ". Falling back to the standard file source";
+                        }
+                }
+            if (!mmap_source_)
+                {
+                    file_source_ = gr::blocks::file_source::make(item_size(), filename().data(), repeat());
+                }
 
-            if (samples_to_skip > 0)
+            if (file_source_ && samples_to_skip > 0)
                 {
                     LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file";
                     if (!file_source_->seek(samples_to_skip, SEEK_SET))
@@ -506,12 +533,12 @@ gr::blocks::file_source::sptr FileSourceBase::create_file_source()
             throw;
         }
 
-    DLOG(INFO) << implementation() << "(" << file_source_->unique_id() << ")";
+    DLOG(INFO) << implementation() << "(" << file_source()->unique_id() << ")";
 
     // enable subclass hooks
     create_file_source_hook();
 
-    return file_source_;
+    return file_source();
 }
 
 
@@ -19,6 +19,7 @@
 #define GNSS_SDR_FILE_SOURCE_BASE_H
 
 #include "concurrent_queue.h"
+#include "mmap_file_source.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/file_sink.h>  // for dump
 #include <gnuradio/blocks/file_source.h>
@@ -58,6 +59,12 @@ class ConfigurationInterface;
 //!
 //!   .repeat   - whether to rewind and continue at end of file (default false)
 //!
+//!   .use_mmap - read the file through a memory mapping instead of read() calls (default false)
+//!
+//!   .mmap_prefetch_mb - if use_mmap, size of the read-ahead window, in MB (default 64)
+//!
+//!   .mmap_huge_pages - if use_mmap, request transparent huge pages for the mapping (default false)
+//!
 //! (probably abstracted to the base class)
 //!
 //!   .dump     - whether to archive input data
@@ -134,7 +141,7 @@ protected:
 
     // The methods create the various blocks, if enabled, and return access to them. The created
     // object is also held in this class
-    gr::blocks::file_source::sptr create_file_source();
+    gnss_shared_ptr<gr::block> create_file_source();
     gr::blocks::throttle::sptr create_throttle();
     gnss_shared_ptr<gr::block> create_valve();
     gr::blocks::file_sink::sptr create_sink();
@@ -153,6 +160,7 @@ protected:
 
 private:
     gr::blocks::file_source::sptr file_source_;
+    mmap_file_source_sptr mmap_source_;
     gr::blocks::throttle::sptr throttle_;
     gr::blocks::file_sink::sptr sink_;
 
@@ -172,12 +180,15 @@ private:
     size_t item_size_;
     size_t header_size_;  // length (in samples) of the header (if any)
     uint64_t samples_;
+    uint64_t mmap_prefetch_mb_;
     int64_t sampling_frequency_;  // why is this signed
     double minimum_tail_s_;
     double seconds_to_skip_;
     bool is_complex_;  // a misnomer; if I/Q are interleaved as integer values
     bool repeat_;
     bool enable_throttle_control_;
+    bool use_mmap_;
+    bool mmap_huge_pages_;
     bool dump_;
 };
 
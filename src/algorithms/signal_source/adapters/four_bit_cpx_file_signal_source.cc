@@ -31,6 +31,7 @@ FourBitCpxFileSignalSource::FourBitCpxFileSignalSource(
     Concurrent_Queue<pmt::pmt_t>* queue)
     : FileSourceBase(configuration, role, "Four_Bit_Cpx_File_Signal_Source"s, queue, "byte"s),
       sample_type_(configuration->property(role + ".sample_type", "iq"s)),
+      output_item_type_(configuration->property(role + ".output_item_type"s, "gr_complex"s)),
       timestamp_file_(configuration->property(role + ".timestamp_filename"s, ""s)),
       timestamp_clock_offset_ms_(configuration->property(role + ".timestamp_clock_offset_ms"s, 0.0))
 {
@@ -49,6 +50,12 @@ FourBitCpxFileSignalSource::FourBitCpxFileSignalSource(
             LOG(WARNING) << sample_type_ << " unrecognized sample type. Assuming: iq";
         }
 
+    if (output_item_type_ != "gr_complex" && output_item_type_ != "cbyte" && output_item_type_ != "cshort")
+        {
+            LOG(WARNING) << output_item_type_ << " unrecognized output item type. Using gr_complex.";
+            output_item_type_ = "gr_complex";
+        }
+
     if (in_streams > 0)
         {
             LOG(ERROR) << "A signal source does not have an input stream";
@@ -96,20 +103,35 @@ gnss_shared_ptr<gr::block> FourBitCpxFileSignalSource::source() const
         }
     else
         {
-            return inter_shorts_to_cpx_;
+            return unpacked_output();
         }
 }
 
 
+gnss_shared_ptr<gr::block> FourBitCpxFileSignalSource::unpacked_output() const
+{
+    if (inter_bytes_to_cpx_)
+        {
+            return inter_bytes_to_cpx_;
+        }
+    return unpack_byte_;
+}
+
+
 void FourBitCpxFileSignalSource::create_file_source_hook()
 {
-    unpack_byte_ = make_unpack_byte_4bit_samples();
-    DLOG(INFO) << "unpack_byte_2bit_cpx_samples(" << unpack_byte_->unique_id() << ")";
-    inter_shorts_to_cpx_ = gr::blocks::interleaved_short_to_complex::make(false, reverse_interleaving_);  // I/Q swap enabled
-    DLOG(INFO) << "interleaved_short_to_complex(" << inter_shorts_to_cpx_->unique_id() << ")";
+    // The unpacker delivers I/Q bytes that are converted to gr_complex, or
+    // the complex integer samples if requested
+    unpack_byte_ = make_unpack_byte_4bit_samples(output_item_type_ == "gr_complex" ? "ibyte"s : output_item_type_, reverse_interleaving_);
+    DLOG(INFO) << "unpack_byte_4bit_samples(" << unpack_byte_->unique_id() << ")";
+    if (output_item_type_ == "gr_complex")
+        {
+            inter_bytes_to_cpx_ = gr::blocks::interleaved_char_to_complex::make(false);
+            DLOG(INFO) << "interleaved_char_to_complex(" << inter_bytes_to_cpx_->unique_id() << ")";
+        }
     if (timestamp_file_.size() > 1)
         {
-            timestamp_block_ = gnss_sdr_make_Timestamp(sizeof(gr_complex),
+            timestamp_block_ = gnss_sdr_make_Timestamp(unpacked_output()->output_signature()->sizeof_stream_item(0),
                 timestamp_file_,
                 timestamp_clock_offset_ms_,
                 1);
@@ -121,11 +143,14 @@ void FourBitCpxFileSignalSource::create_file_source_hook()
 void FourBitCpxFileSignalSource::pre_connect_hook(gr::top_block_sptr top_block)
 {
     top_block->connect(file_source(), 0, unpack_byte_, 0);
-    top_block->connect(unpack_byte_, 0, inter_shorts_to_cpx_, 0);
+    if (inter_bytes_to_cpx_)
+        {
+            top_block->connect(unpack_byte_, 0, inter_bytes_to_cpx_, 0);
+        }
     DLOG(INFO) << "connected file_source to unpacker";
     if (timestamp_file_.size() > 1)
         {
-            top_block->connect(inter_shorts_to_cpx_, 0, timestamp_block_, 0);
+            top_block->connect(unpacked_output(), 0, timestamp_block_, 0);
             DLOG(INFO) << "connected file_source to timestamp_block_";
         }
 }
@@ -135,10 +160,13 @@ void FourBitCpxFileSignalSource::pre_disconnect_hook(gr::top_block_sptr top_bloc
 {
     if (timestamp_file_.size() > 1)
         {
-            top_block->disconnect(inter_shorts_to_cpx_, 0, timestamp_block_, 0);
+            top_block->disconnect(unpacked_output(), 0, timestamp_block_, 0);
             DLOG(INFO) << "disconnected file_source from timestamp_block_";
         }
     top_block->disconnect(file_source(), 0, unpack_byte_, 0);
-    top_block->disconnect(unpack_byte_, 0, inter_shorts_to_cpx_, 0);
+    if (inter_bytes_to_cpx_)
+        {
+            top_block->disconnect(unpack_byte_, 0, inter_bytes_to_cpx_, 0);
+        }
     DLOG(INFO) << "disconnected file_source from unpacker";
 }
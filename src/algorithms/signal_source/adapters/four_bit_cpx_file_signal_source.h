@@ -23,7 +23,7 @@
 #include "file_source_base.h"
 #include "gnss_sdr_timestamp.h"
 #include "unpack_byte_4bit_samples.h"
-#include <gnuradio/blocks/interleaved_short_to_complex.h>
+#include <gnuradio/blocks/interleaved_char_to_complex.h>
 #include <cstddef>
 #include <string>
 #include <tuple>
@@ -38,7 +38,10 @@ class ConfigurationInterface;
 
 /*!
  * \brief Class that reads signals samples from a file
- * and adapts it to a SignalSourceInterface
+ * and adapts it to a SignalSourceInterface.
+ *
+ * The output type is set by output_item_type: gr_complex (default), or
+ * cbyte / cshort to deliver the unpacked integers without conversion.
  */
 class FourBitCpxFileSignalSource : public FileSourceBase
 {
@@ -60,10 +63,13 @@ protected:
     void pre_disconnect_hook(gr::top_block_sptr top_block) override;
 
 private:
+    gnss_shared_ptr<gr::block> unpacked_output() const;
+
     unpack_byte_4bit_samples_sptr unpack_byte_;
-    gr::blocks::interleaved_short_to_complex::sptr inter_shorts_to_cpx_;
+    gr::blocks::interleaved_char_to_complex::sptr inter_bytes_to_cpx_;
     gnss_shared_ptr<Gnss_Sdr_Timestamp> timestamp_block_;
     std::string sample_type_;
+    std::string output_item_type_;
     std::string timestamp_file_;
     double timestamp_clock_offset_ms_;
     bool reverse_interleaving_;
@@ -20,6 +20,7 @@
 #include "configuration_interface.h"
 #include "gnss_sdr_string_literals.h"
 #include <glog/logging.h>
+#include <volk/volk.h>
 #include <exception>
 #include <fstream>
 #include <iomanip>
@@ -48,6 +49,14 @@ SpirGSS6450FileSignalSource::SpirGSS6450FileSignalSource(const ConfigurationInte
       enable_throttle_control_(configuration->property(role + ".enable_throttle_control", false)),
       endian_swap_(configuration->property(role + ".endian", false))
 {
+    // The samples can be delivered as lv_8sc_t, without conversion
+    const std::string output_item_type = configuration->property(role + ".output_item_type", "gr_complex"s);
+    if (output_item_type != "gr_complex" && output_item_type != "cbyte")
+        {
+            LOG(WARNING) << output_item_type << " unrecognized output item type. Using gr_complex.";
+        }
+    const bool cbyte_output = output_item_type == "cbyte";
+    const size_t output_item_size = cbyte_output ? sizeof(lv_8sc_t) : sizeof(gr_complex);
     const std::string default_filename("../data/my_capture.dat");
     const std::string default_dump_filename("../data/my_capture_dump.dat");
     filename_ = configuration->property(role + ".filename", default_filename);
@@ -64,8 +73,8 @@ SpirGSS6450FileSignalSource::SpirGSS6450FileSignalSource(const ConfigurationInte
         {
             for (int32_t i = 0; i < n_channels_; i++)
                 {
-                    null_sinks_.push_back(gr::blocks::null_sink::make(sizeof(gr_complex)));
-                    unpack_spir_vec_.push_back(make_unpack_spir_gss6450_samples(adc_bits_));
+                    null_sinks_.push_back(gr::blocks::null_sink::make(output_item_size));
+                    unpack_spir_vec_.push_back(make_unpack_spir_gss6450_samples(adc_bits_, cbyte_output ? "cbyte"s : "gr_complex"s));
                     if (endian_swap_)
                         {
                             endian_vec_.push_back(gr::blocks::endian_swap::make(item_size_));
@@ -143,15 +152,15 @@ SpirGSS6450FileSignalSource::SpirGSS6450FileSignalSource(const ConfigurationInte
 
     for (int32_t i = 0; i < n_channels_; i++)
         {
-            valve_vec_.emplace_back(gnss_sdr_make_valve(sizeof(gr_complex), samples_, queue));
+            valve_vec_.emplace_back(gnss_sdr_make_valve(output_item_size, samples_, queue));
             if (dump_)
                 {
                     std::string tmp_str = dump_filename_ + "_ch" + std::to_string(i);
-                    sink_vec_.push_back(gr::blocks::file_sink::make(sizeof(gr_complex), tmp_str.c_str()));
+                    sink_vec_.push_back(gr::blocks::file_sink::make(output_item_size, tmp_str.c_str()));
                 }
             if (enable_throttle_control_)
                 {
-                    throttle_vec_.push_back(gr::blocks::throttle::make(sizeof(gr_complex), sampling_frequency_));
+                    throttle_vec_.push_back(gr::blocks::throttle::make(output_item_size, sampling_frequency_));
                 }
         }
 
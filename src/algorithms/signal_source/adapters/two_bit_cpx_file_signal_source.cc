@@ -27,8 +27,14 @@ TwoBitCpxFileSignalSource::TwoBitCpxFileSignalSource(
     const std::string& role,
     unsigned int in_streams, unsigned int out_streams,
     Concurrent_Queue<pmt::pmt_t>* queue)
-    : FileSourceBase(configuration, role, "Two_Bit_Cpx_File_Signal_Source"s, queue, "byte"s)
+    : FileSourceBase(configuration, role, "Two_Bit_Cpx_File_Signal_Source"s, queue, "byte"s),
+      output_item_type_(configuration->property(role + ".output_item_type"s, "gr_complex"s))
 {
+    if (output_item_type_ != "gr_complex" && output_item_type_ != "cbyte" && output_item_type_ != "cshort")
+        {
+            LOG(WARNING) << output_item_type_ << " unrecognized output item type. Using gr_complex.";
+            output_item_type_ = "gr_complex";
+        }
     if (in_streams > 0)
         {
             LOG(ERROR) << "A signal source does not have an input stream";
@@ -59,27 +65,45 @@ std::tuple<size_t, bool> TwoBitCpxFileSignalSource::itemTypeToSize()
 
 // 1 byte -> 2 samples
 double TwoBitCpxFileSignalSource::packetsPerSample() const { return 2.0; }
-gnss_shared_ptr<gr::block> TwoBitCpxFileSignalSource::source() const { return inter_shorts_to_cpx_; }
+gnss_shared_ptr<gr::block> TwoBitCpxFileSignalSource::source() const
+{
+    if (inter_bytes_to_cpx_)
+        {
+            return inter_bytes_to_cpx_;
+        }
+    return unpack_byte_;
+}
 
 
 void TwoBitCpxFileSignalSource::create_file_source_hook()
 {
-    unpack_byte_ = make_unpack_byte_2bit_cpx_samples();
+    // The unpacker delivers I/Q bytes that are converted to gr_complex, or
+    // the complex integer samples if requested. I/Q swap enabled.
+    unpack_byte_ = make_unpack_byte_2bit_cpx_samples(output_item_type_ == "gr_complex" ? "ibyte"s : output_item_type_, true);
     DLOG(INFO) << "unpack_byte_2bit_cpx_samples(" << unpack_byte_->unique_id() << ")";
-    inter_shorts_to_cpx_ = gr::blocks::interleaved_short_to_complex::make(false, true);  // I/Q swap enabled
-    DLOG(INFO) << "interleaved_short_to_complex(" << inter_shorts_to_cpx_->unique_id() << ")";
+    if (output_item_type_ == "gr_complex")
+        {
+            inter_bytes_to_cpx_ = gr::blocks::interleaved_char_to_complex::make(false);
+            DLOG(INFO) << "interleaved_char_to_complex(" << inter_bytes_to_cpx_->unique_id() << ")";
+        }
 }
 
 void TwoBitCpxFileSignalSource::pre_connect_hook(gr::top_block_sptr top_block)
 {
     top_block->connect(file_source(), 0, unpack_byte_, 0);
-    top_block->connect(unpack_byte_, 0, inter_shorts_to_cpx_, 0);
+    if (inter_bytes_to_cpx_)
+        {
+            top_block->connect(unpack_byte_, 0, inter_bytes_to_cpx_, 0);
+        }
     DLOG(INFO) << "connected file_source to unpacker";
 }
 
 void TwoBitCpxFileSignalSource::pre_disconnect_hook(gr::top_block_sptr top_block)
 {
     top_block->disconnect(file_source(), 0, unpack_byte_, 0);
-    top_block->disconnect(unpack_byte_, 0, inter_shorts_to_cpx_, 0);
+    if (inter_bytes_to_cpx_)
+        {
+            top_block->disconnect(unpack_byte_, 0, inter_bytes_to_cpx_, 0);
+        }
     DLOG(INFO) << "disconnected file_source from unpacker";
 }
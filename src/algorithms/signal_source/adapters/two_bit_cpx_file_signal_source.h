@@ -22,7 +22,7 @@
 
 #include "file_source_base.h"
 #include "unpack_byte_2bit_cpx_samples.h"
-#include <gnuradio/blocks/interleaved_short_to_complex.h>
+#include <gnuradio/blocks/interleaved_char_to_complex.h>
 #include <cstddef>
 #include <string>
 #include <tuple>
@@ -37,7 +37,10 @@ class ConfigurationInterface;
 
 /*!
  * \brief Class that reads signals samples from a file
- * and adapts it to a SignalSourceInterface
+ * and adapts it to a SignalSourceInterface.
+ *
+ * The output type is set by output_item_type: gr_complex (default), or
+ * cbyte / cshort to deliver the unpacked integers without conversion.
  */
 class TwoBitCpxFileSignalSource : public FileSourceBase
 {
@@ -60,7 +63,8 @@ protected:
 
 private:
     unpack_byte_2bit_cpx_samples_sptr unpack_byte_;
-    gr::blocks::interleaved_short_to_complex::sptr inter_shorts_to_cpx_;
+    gr::blocks::interleaved_char_to_complex::sptr inter_bytes_to_cpx_;
+    std::string output_item_type_;
 };
 
 
@@ -33,6 +33,7 @@ TwoBitPackedFileSignalSource::TwoBitPackedFileSignalSource(
     : FileSourceBase(configuration, role, "Two_Bit_Packed_File_Signal_Source"s, queue, "byte"s), sample_type_(configuration->property(role + ".sample_type", "real"s)),  // options: "real", "iq", "qi"
       big_endian_items_(configuration->property(role + ".big_endian_items", true)),
       big_endian_bytes_(configuration->property(role + ".big_endian_bytes", false)),
+      output_item_type_(configuration->property(role + ".output_item_type", "gr_complex"s)),  // options: "gr_complex", "cbyte" (only for complex samples)
       reverse_interleaving_(false)
 {
     if (in_streams > 0)
@@ -112,14 +113,31 @@ double TwoBitPackedFileSignalSource::packetsPerSample() const
     return packets;
 }
 
-gnss_shared_ptr<gr::block> TwoBitPackedFileSignalSource::source() const { return char_to_float_; }
+gnss_shared_ptr<gr::block> TwoBitPackedFileSignalSource::source() const
+{
+    if (char_to_float_)
+        {
+            return char_to_float_;
+        }
+    return unpack_samples_;
+}
 
 void TwoBitPackedFileSignalSource::create_file_source_hook()
 {
+    // Complex samples can be delivered as lv_8sc_t, without conversion
+    const bool cbyte_output = is_complex() && output_item_type_ == "cbyte";
+    if (!cbyte_output && output_item_type_ != "gr_complex")
+        {
+            LOG(WARNING) << output_item_type_ << " unrecognized output item type for " << sample_type_ << " samples. Using gr_complex.";
+        }
     unpack_samples_ = make_unpack_2bit_samples(big_endian_bytes_, item_size(),
-        big_endian_items_, reverse_interleaving_);
+        big_endian_items_, reverse_interleaving_, cbyte_output);
     DLOG(INFO) << "unpack_byte_2bit_samples(" << unpack_samples_->unique_id() << ")";
 
+    if (cbyte_output)
+        {
+            return;
+        }
     if (is_complex())
         {
             char_to_float_ = gr::blocks::interleaved_char_to_complex::make(false);
@@ -136,14 +154,20 @@ void TwoBitPackedFileSignalSource::pre_connect_hook(gr::top_block_sptr top_block
 {
     top_block->connect(file_source(), 0, unpack_samples_, 0);
     DLOG(INFO) << "connected file source to unpack samples";
-    top_block->connect(unpack_samples_, 0, char_to_float_, 0);
-    DLOG(INFO) << "connected unpack samples to char to float";
+    if (char_to_float_)
+        {
+            top_block->connect(unpack_samples_, 0, char_to_float_, 0);
+            DLOG(INFO) << "connected unpack samples to char to float";
+        }
 }
 
 void TwoBitPackedFileSignalSource::pre_disconnect_hook(gr::top_block_sptr top_block)
 {
     top_block->disconnect(file_source(), 0, unpack_samples_, 0);
     DLOG(INFO) << "disconnected file source to unpack samples";
-    top_block->disconnect(unpack_samples_, 0, char_to_float_, 0);
-    DLOG(INFO) << "disconnected unpack samples to char to float";
+    if (char_to_float_)
+        {
+            top_block->disconnect(unpack_samples_, 0, char_to_float_, 0);
+            DLOG(INFO) << "disconnected unpack samples to char to float";
+        }
 }
@@ -79,6 +79,7 @@ private:
     std::string sample_type_;
     bool big_endian_items_;
     bool big_endian_bytes_;
+    std::string output_item_type_;
     bool reverse_interleaving_;
     unpack_2bit_samples_sptr unpack_samples_;
     gnss_shared_ptr<gr::block> char_to_float_;
@@ -0,0 +1,99 @@
+/*!
+ * \file mmap_file_source.cc
+ * \brief GNU Radio source block that reads samples from a memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "mmap_file_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <stdexcept>  // for std::runtime_error
+#include <string>     // for std::to_string
+
+
+mmap_file_source_sptr make_mmap_file_source(std::size_t item_size,
+    const std::string &filename,
+    bool repeat,
+    uint64_t items_to_skip,
+    std::size_t prefetch_bytes,
+    bool huge_pages)
+{
+    return mmap_file_source_sptr(new mmap_file_source(item_size, filename, repeat, items_to_skip, prefetch_bytes, huge_pages));
+}
+
+
+mmap_file_source::mmap_file_source(std::size_t item_size,
+    const std::string &filename,
+    bool repeat,
+    uint64_t items_to_skip,
+    std::size_t prefetch_bytes,
+    bool huge_pages)
+    : gr::sync_block("mmap_file_source",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(1, 1, item_size)),
+      d_first_item(items_to_skip),
+      d_repeat(repeat)
+{
+    if (!d_file.open(filename, item_size, prefetch_bytes, huge_pages))
+        {
+            throw std::runtime_error("mmap_file_source: cannot map file " + filename);
+        }
+    if (items_to_skip >= d_file.size_items())
+        {
+            throw std::runtime_error("mmap_file_source: cannot skip " + std::to_string(items_to_skip) + " items of file " + filename);
+        }
+    d_file.seek(items_to_skip);
+    d_sample_index.store(d_file.position(), std::memory_order_relaxed);
+}
+
+
+bool mmap_file_source::seek(uint64_t item)
+{
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    if (!d_file.seek(item))
+        {
+            LOG(WARNING) << "Cannot seek to item " << item << ", the file has " << d_file.size_items() << " items";
+            return false;
+        }
+    d_sample_index.store(d_file.position(), std::memory_order_relaxed);
+    return true;
+}
+
+
+int mmap_file_source::work(int noutput_items,
+    __attribute__((unused)) gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    gr::thread::scoped_lock lock(d_setlock);
+    auto *out = static_cast<uint8_t *>(output_items[0]);
+    const std::size_t item_size = output_signature()->sizeof_stream_item(0);
+    std::size_t produced = 0;
+    while (produced < static_cast<std::size_t>(noutput_items))
+        {
+            const std::size_t n = d_file.read(out + produced * item_size, noutput_items - produced);
+            produced += n;
+            if (n == 0)
+                {
+                    if (!d_repeat)
+                        {
+                            break;
+                        }
+                    d_file.seek(d_first_item);
+                }
+        }
+    d_sample_index.store(d_file.position(), std::memory_order_relaxed);
+    if (produced == 0)
+        {
+            return WORK_DONE;
+        }
+    return static_cast<int>(produced);
+}
@@ -0,0 +1,103 @@
+/*!
+ * \file mmap_file_source.h
+ * \brief GNU Radio source block that reads samples from a memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MMAP_FILE_SOURCE_H
+#define GNSS_SDR_MMAP_FILE_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sdr_mmap_file.h"
+#include <gnuradio/sync_block.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class mmap_file_source;
+
+using mmap_file_source_sptr = gnss_shared_ptr<mmap_file_source>;
+
+/*!
+ * \brief Creates a mmap_file_source. Throws std::runtime_error if the file
+ * cannot be mapped in memory.
+ */
+mmap_file_source_sptr make_mmap_file_source(
+    std::size_t item_size,
+    const std::string &filename,
+    bool repeat = false,
+    uint64_t items_to_skip = 0,
+    std::size_t prefetch_bytes = 64 * 1024 * 1024,
+    bool huge_pages = false);
+
+/*!
+ * \brief Drop-in replacement of gr::blocks::file_source for raw sample
+ * files. Items are copied straight from the page cache to the output
+ * buffer, without read() system calls, and the file can be repositioned at
+ * any time with a constant-time seek.
+ */
+class mmap_file_source : public gr::sync_block
+{
+public:
+    ~mmap_file_source() = default;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+    /*!
+     * \brief Moves the read position to the given item of the file. Can be
+     * called while the flowgraph is running.
+     */
+    bool seek(uint64_t item);
+
+    /*!
+     * \brief Index, counted from the start of the file, of the next item to
+     * be delivered
+     */
+    inline uint64_t sample_index() const { return d_sample_index.load(std::memory_order_relaxed); }
+
+    inline uint64_t size_items() const { return d_file.size_items(); }  //!< Number of items in the file
+
+private:
+    friend mmap_file_source_sptr make_mmap_file_source(
+        std::size_t item_size,
+        const std::string &filename,
+        bool repeat,
+        uint64_t items_to_skip,
+        std::size_t prefetch_bytes,
+        bool huge_pages);
+
+    mmap_file_source(std::size_t item_size,
+        const std::string &filename,
+        bool repeat,
+        uint64_t items_to_skip,
+        std::size_t prefetch_bytes,
+        bool huge_pages);
+
+    Gnss_Sdr_Mmap_File d_file;
+    std::atomic<uint64_t> d_sample_index{0};
+    uint64_t d_first_item;  // where reading starts again when repeating
+    bool d_repeat;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MMAP_FILE_SOURCE_H
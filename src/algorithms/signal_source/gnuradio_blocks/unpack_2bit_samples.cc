@@ -17,7 +17,9 @@
 
 
 #include "unpack_2bit_samples.h"
+#include "unpack_tables.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 
 struct byte_2bit_struct
 {
@@ -83,29 +85,33 @@ void swapEndianness(int8_t const *in, std::vector<int8_t> &out, size_t item_size
 unpack_2bit_samples_sptr make_unpack_2bit_samples(bool big_endian_bytes,
     size_t item_size,
     bool big_endian_items,
-    bool reverse_interleaving)
+    bool reverse_interleaving,
+    bool complex_output)
 {
     return unpack_2bit_samples_sptr(
         new unpack_2bit_samples(big_endian_bytes,
             item_size,
             big_endian_items,
-            reverse_interleaving));
+            reverse_interleaving,
+            complex_output));
 }
 
 
 unpack_2bit_samples::unpack_2bit_samples(bool big_endian_bytes,
     size_t item_size,
     bool big_endian_items,
-    bool reverse_interleaving)
+    bool reverse_interleaving,
+    bool complex_output)
     : sync_interpolator("unpack_2bit_samples",
           gr::io_signature::make(1, 1, item_size),
-          gr::io_signature::make(1, 1, sizeof(char)),
-          4 * item_size),  // we make 4 bytes out for every byte in
+          gr::io_signature::make(1, 1, complex_output ? 2 * sizeof(char) : sizeof(char)),
+          complex_output ? 2 * item_size : 4 * item_size),  // we make 4 bytes out for every byte in
       item_size_(item_size),
       big_endian_bytes_(big_endian_bytes),
       big_endian_items_(big_endian_items),
       swap_endian_items_(false),
-      reverse_interleaving_(reverse_interleaving)
+      reverse_interleaving_(reverse_interleaving),
+      values_per_item_(complex_output ? 2 : 1)
 {
     bool big_endian_system = systemIsBigEndian();
 
@@ -117,6 +123,19 @@ unpack_2bit_samples::unpack_2bit_samples(bool big_endian_bytes,
     bool big_endian_bytes_system = systemBytesAreBigEndian();
 
     swap_endian_bytes_ = (big_endian_bytes_system != big_endian_bytes_);
+
+    // Order of the 2-bit fields of each byte in the output, with field 0 in
+    // the least significant bits
+    std::array<int, 4> fields{0, 1, 2, 3};
+    if (reverse_interleaving_)
+        {
+            fields = swap_endian_bytes_ ? std::array<int, 4>{2, 3, 0, 1} : std::array<int, 4>{1, 0, 3, 2};
+        }
+    else if (swap_endian_bytes_)
+        {
+            fields = {3, 2, 1, 0};
+        }
+    tables_ = unpack_2bit_tables(fields, unpack_2bit_levels(true));
 }
 
 
@@ -127,84 +146,24 @@ int unpack_2bit_samples::work(int noutput_items,
     auto const *in = reinterpret_cast<signed char const *>(input_items[0]);
     auto *out = reinterpret_cast<int8_t *>(output_items[0]);
 
-    size_t ninput_bytes = noutput_items / 4;
+    size_t ninput_bytes = noutput_items * values_per_item_ / 4;
     size_t ninput_items = ninput_bytes / item_size_;
 
     // Handle endian swap if needed
     if (swap_endian_items_)
         {
-            work_buffer_ = std::vector<int8_t>(ninput_bytes);
+            if (work_buffer_.size() < ninput_bytes)
+                {
+                    work_buffer_.resize(ninput_bytes);
+                }
             swapEndianness(in, work_buffer_, item_size_, ninput_items);
 
             in = const_cast<signed char const *>(&work_buffer_[0]);
         }
 
     // Here the in pointer can be interpreted as a stream of bytes to be
-    // converted. But we now have two possibilities:
-    // 1) The samples in a byte are in big endian order
-    // 2) The samples in a byte are in little endian order
-
-    byte_and_samples raw_byte{};
-    int n = 0;
-
-    if (!reverse_interleaving_)
-        {
-            if (swap_endian_bytes_)
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                        }
-                }
-            else
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                        }
-                }
-        }
-    else
-        {
-            if (swap_endian_bytes_)
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                        }
-                }
-            else
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                        }
-                }
-        }
+    // converted. The order of the samples within a byte is in the tables.
+    volk_gnsssdr_8u_unpack_2bit_8i(out, reinterpret_cast<const uint8_t *>(in), tables_.data(), ninput_bytes);
 
     return noutput_items;
 }
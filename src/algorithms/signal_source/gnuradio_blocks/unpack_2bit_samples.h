@@ -57,6 +57,7 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_interpolator.h>
+#include <array>
 #include <cstdint>
 #include <vector>
 
@@ -74,12 +75,16 @@ unpack_2bit_samples_sptr make_unpack_2bit_samples(
     bool big_endian_bytes,
     size_t item_size,
     bool big_endian_items,
-    bool reverse_interleaving = false);
+    bool reverse_interleaving = false,
+    bool complex_output = false);
 
 /*!
  * \brief This class takes 2 bit samples that have been packed into bytes or
  * shorts as input and generates a byte for each sample. It generates eight
  * times as much data as is input (every two bits become 16 bits)
+ *
+ * If complex_output is true, each pair of output bytes is delivered as a
+ * single lv_8sc_t item.
  */
 class unpack_2bit_samples : public gr::sync_interpolator
 {
@@ -89,7 +94,8 @@ public:
     unpack_2bit_samples(bool big_endian_bytes,
         size_t item_size,
         bool big_endian_items,
-        bool reverse_interleaving);
+        bool reverse_interleaving,
+        bool complex_output);
 
     int work(int noutput_items,
         gr_vector_const_void_star &input_items,
@@ -100,8 +106,10 @@ private:
         bool big_endian_bytes,
         size_t item_size,
         bool big_endian_items,
-        bool reverse_interleaving);
+        bool reverse_interleaving,
+        bool complex_output);
 
+    std::array<int8_t, 128> tables_;
     std::vector<int8_t> work_buffer_;
     size_t item_size_;
     bool big_endian_bytes_;
@@ -109,6 +117,7 @@ private:
     bool swap_endian_items_;
     bool swap_endian_bytes_;
     bool reverse_interleaving_;
+    int values_per_item_;
 };
 
 
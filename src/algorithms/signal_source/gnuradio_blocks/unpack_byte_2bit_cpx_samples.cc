@@ -20,26 +20,33 @@
 
 
 #include "unpack_byte_2bit_cpx_samples.h"
+#include "unpack_tables.h"
 #include <gnuradio/io_signature.h>
-#include <cstdint>
-
-struct byte_2bit_struct
-{
-    signed two_bit_sample : 2;  // <- 2 bits wide only
-};
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 
 
-unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples()
+unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples(const std::string &output_item_type, bool swap_iq)
 {
-    return unpack_byte_2bit_cpx_samples_sptr(new unpack_byte_2bit_cpx_samples());
+    return unpack_byte_2bit_cpx_samples_sptr(new unpack_byte_2bit_cpx_samples(output_item_type, swap_iq));
 }
 
 
-unpack_byte_2bit_cpx_samples::unpack_byte_2bit_cpx_samples() : sync_interpolator("unpack_byte_2bit_cpx_samples",
-                                                                   gr::io_signature::make(1, 1, sizeof(int8_t)),
-                                                                   gr::io_signature::make(1, 1, sizeof(int16_t)),
-                                                                   4)
+unpack_byte_2bit_cpx_samples::unpack_byte_2bit_cpx_samples(const std::string &output_item_type, bool swap_iq)
+    : sync_interpolator("unpack_byte_2bit_cpx_samples",
+          gr::io_signature::make(1, 1, sizeof(int8_t)),
+          gr::io_signature::make(1, 1, unpack_value_size(output_item_type) * unpack_values_per_item(output_item_type)),
+          4 / unpack_values_per_item(output_item_type)),
+      value_size_(unpack_value_size(output_item_type)),
+      values_per_item_(unpack_values_per_item(output_item_type))
 {
+    // Packing Order
+    // Most Significant Nibble  - Sample n
+    // Least Significant Nibble - Sample n+1
+    // Packing order in Nibble Q1 Q0 I1 I0
+    // Output order: I[n], Q[n], I[n+1], Q[n+1], or Q before I if swap_iq
+    const std::array<int, 4> fields = swap_iq ? std::array<int, 4>{3, 2, 1, 0} : std::array<int, 4>{2, 3, 0, 1};
+    tables_ = unpack_2bit_tables(fields, unpack_2bit_levels(true));
 }
 
 
@@ -47,47 +54,20 @@ int unpack_byte_2bit_cpx_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const int8_t *>(input_items[0]);
-    auto *out = reinterpret_cast<int16_t *>(output_items[0]);
+    const auto *in = reinterpret_cast<const uint8_t *>(input_items[0]);
+    const int nvalues = noutput_items * values_per_item_;
 
-    byte_2bit_struct sample{};
-    int n = 0;
-    for (int i = 0; i < noutput_items / 4; i++)
+    if (value_size_ == sizeof(int8_t))
         {
-            // Read packed input sample (1 byte = 2 complex samples)
-            // *     Packing Order
-            // *     Most Significant Nibble  - Sample n
-            // *     Least Significant Nibble - Sample n+1
-            // *     Packing order in Nibble Q1 Q0 I1 I0
-            // normal
-            //  int8_t c = in[i];
-            //  //Q[n]
-            //  sample.two_bit_sample = (c>>6) & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-            //  //I[n]
-            //  sample.two_bit_sample = (c>>4) & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-            //  //Q[n+1]
-            //  sample.two_bit_sample = (c>>2) & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-            //  //I[n+1]
-            //  sample.two_bit_sample = c & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
+            volk_gnsssdr_8u_unpack_2bit_8i(reinterpret_cast<int8_t *>(output_items[0]), in, tables_.data(), nvalues / 4);
+            return noutput_items;
+        }
 
-            // I/Q swap
-            int8_t c = in[i];
-            // I[n]
-            sample.two_bit_sample = (c >> 4) & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-            // Q[n]
-            sample.two_bit_sample = (c >> 6) & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-            // I[n+1]
-            sample.two_bit_sample = c & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-            // Q[n+1]
-            sample.two_bit_sample = (c >> 2) & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
+    if (buffer_.size() < static_cast<size_t>(nvalues))
+        {
+            buffer_.resize(nvalues);
         }
+    volk_gnsssdr_8u_unpack_2bit_8i(buffer_.data(), in, tables_.data(), nvalues / 4);
+    std::copy(buffer_.cbegin(), buffer_.cbegin() + nvalues, reinterpret_cast<int16_t *>(output_items[0]));
     return noutput_items;
 }
@@ -24,6 +24,11 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_interpolator.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 /** \addtogroup Signal_Source
  * \{ */
@@ -35,23 +40,31 @@ class unpack_byte_2bit_cpx_samples;
 
 using unpack_byte_2bit_cpx_samples_sptr = gnss_shared_ptr<unpack_byte_2bit_cpx_samples>;
 
-unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples();
+unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples(const std::string &output_item_type = "ishort", bool swap_iq = false);
 
 /*!
  * \brief This class implements conversion between byte packet samples to 2bit_cpx samples
  *  1 byte = 2 x complex 2bit I, + 2bit Q samples
+ *
+ * The output is set by output_item_type: interleaved I and Q values as
+ * "ishort" (default) or "ibyte", or complex samples as "cshort" (lv_16sc_t)
+ * or "cbyte" (lv_8sc_t). If swap_iq is true, Q comes before I.
  */
 class unpack_byte_2bit_cpx_samples : public gr::sync_interpolator
 {
 public:
-    unpack_byte_2bit_cpx_samples();
+    unpack_byte_2bit_cpx_samples(const std::string &output_item_type, bool swap_iq);
     ~unpack_byte_2bit_cpx_samples() = default;
     int work(int noutput_items,
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items);
 
 private:
-    friend unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples_sptr();
+    friend unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples_sptr(const std::string &output_item_type, bool swap_iq);
+    std::array<int8_t, 128> tables_;
+    std::vector<int8_t> buffer_;
+    size_t value_size_;
+    int values_per_item_;
 };
 
 
@@ -16,12 +16,10 @@
 
 
 #include "unpack_byte_2bit_samples.h"
+#include "unpack_tables.h"
 #include <gnuradio/io_signature.h>
-
-struct byte_2bit_struct
-{
-    signed two_bit_sample : 2;  // <- 2 bits wide only
-};
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 
 
 unpack_byte_2bit_samples_sptr make_unpack_byte_2bit_samples()
@@ -33,7 +31,8 @@ unpack_byte_2bit_samples_sptr make_unpack_byte_2bit_samples()
 unpack_byte_2bit_samples::unpack_byte_2bit_samples() : sync_interpolator("unpack_byte_2bit_samples",
                                                            gr::io_signature::make(1, 1, sizeof(signed char)),
                                                            gr::io_signature::make(1, 1, sizeof(float)),
-                                                           4)
+                                                           4),
+                                                       tables_(unpack_2bit_tables({0, 1, 2, 3}, unpack_2bit_levels(false)))
 {
 }
 
@@ -42,26 +41,14 @@ int unpack_byte_2bit_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const signed char *>(input_items[0]);
+    const auto *in = reinterpret_cast<const uint8_t *>(input_items[0]);
     auto *out = reinterpret_cast<float *>(output_items[0]);
 
-    byte_2bit_struct sample{};
-    int n = 0;
-    for (int i = 0; i < noutput_items / 4; i++)
+    if (buffer_.size() < static_cast<size_t>(noutput_items))
         {
-            // Read packed input sample (1 byte = 4 samples)
-            signed char c = in[i];
-            sample.two_bit_sample = c & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 2) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 4) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 6) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
+            buffer_.resize(noutput_items);
         }
+    volk_gnsssdr_8u_unpack_2bit_8i(buffer_.data(), in, tables_.data(), noutput_items / 4);
+    volk_8i_s32f_convert_32f(out, buffer_.data(), 1.0F, noutput_items);
     return noutput_items;
 }
@@ -20,6 +20,9 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_interpolator.h>
+#include <array>
+#include <cstdint>
+#include <vector>
 
 
 /** \addtogroup Signal_Source
@@ -35,7 +38,7 @@ unpack_byte_2bit_samples_sptr make_unpack_byte_2bit_samples();
 
 /*!
  * \brief This class implements conversion between byte packet samples to 2bit samples
- *  1 byte = 4 2bit samples
+ *  1 byte = 4 2bit samples, least significant bits first
  */
 class unpack_byte_2bit_samples : public gr::sync_interpolator
 {
@@ -48,6 +51,8 @@ public:
 
 private:
     friend unpack_byte_2bit_samples_sptr make_unpack_byte_2bit_samples_sptr();
+    std::array<int8_t, 128> tables_;
+    std::vector<int8_t> buffer_;
 };
 
 
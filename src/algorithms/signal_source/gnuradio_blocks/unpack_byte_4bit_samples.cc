@@ -17,18 +17,25 @@
  */
 
 #include "unpack_byte_4bit_samples.h"
+#include "unpack_tables.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 
-unpack_byte_4bit_samples_sptr make_unpack_byte_4bit_samples()
+unpack_byte_4bit_samples_sptr make_unpack_byte_4bit_samples(const std::string &output_item_type, bool swap_iq)
 {
-    return unpack_byte_4bit_samples_sptr(new unpack_byte_4bit_samples());
+    return unpack_byte_4bit_samples_sptr(new unpack_byte_4bit_samples(output_item_type, swap_iq));
 }
 
 
-unpack_byte_4bit_samples::unpack_byte_4bit_samples() : sync_interpolator("unpack_byte_4bit_samples",
-                                                           gr::io_signature::make(1, 1, sizeof(int8_t)),
-                                                           gr::io_signature::make(1, 1, sizeof(int16_t)),
-                                                           2)
+unpack_byte_4bit_samples::unpack_byte_4bit_samples(const std::string &output_item_type, bool swap_iq)
+    : sync_interpolator("unpack_byte_4bit_samples",
+          gr::io_signature::make(1, 1, sizeof(int8_t)),
+          gr::io_signature::make(1, 1, unpack_value_size(output_item_type) * unpack_values_per_item(output_item_type)),
+          2 / unpack_values_per_item(output_item_type)),
+      tables_(unpack_4bit_tables(swap_iq ? std::array<int, 2>{1, 0} : std::array<int, 2>{0, 1}, unpack_4bit_levels(true))),
+      value_size_(unpack_value_size(output_item_type)),
+      values_per_item_(unpack_values_per_item(output_item_type))
 {
 }
 
@@ -37,31 +44,20 @@ int unpack_byte_4bit_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const int8_t *>(input_items[0]);
-    auto *out = reinterpret_cast<int16_t *>(output_items[0]);
-    int n = 0;
-    unsigned char tmp_char2;
-    for (int i = 0; i < noutput_items / 2; i++)
+    const auto *in = reinterpret_cast<const uint8_t *>(input_items[0]);
+    const int nvalues = noutput_items * values_per_item_;
+
+    if (value_size_ == sizeof(int8_t))
+        {
+            volk_gnsssdr_8u_unpack_4bit_8i(reinterpret_cast<int8_t *>(output_items[0]), in, tables_.data(), nvalues / 2);
+            return noutput_items;
+        }
+
+    if (buffer_.size() < static_cast<size_t>(nvalues))
         {
-            tmp_char2 = in[i] & 0x0F;
-            if (tmp_char2 >= 8)
-                {
-                    out[n++] = static_cast<int16_t>(2 * (tmp_char2 - 16) + 1);
-                }
-            else
-                {
-                    out[n++] = static_cast<int16_t>(2 * tmp_char2 + 1);
-                }
-            tmp_char2 = in[i] >> 4;
-            tmp_char2 = tmp_char2 & 0x0F;
-            if (tmp_char2 >= 8)
-                {
-                    out[n++] = static_cast<int16_t>(2 * (tmp_char2 - 16) + 1);
-                }
-            else
-                {
-                    out[n++] = static_cast<int16_t>(2 * tmp_char2 + 1);
-                }
+            buffer_.resize(nvalues);
         }
+    volk_gnsssdr_8u_unpack_4bit_8i(buffer_.data(), in, tables_.data(), nvalues / 2);
+    std::copy(buffer_.cbegin(), buffer_.cbegin() + nvalues, reinterpret_cast<int16_t *>(output_items[0]));
     return noutput_items;
 }
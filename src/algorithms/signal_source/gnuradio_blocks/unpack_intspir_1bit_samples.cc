@@ -40,29 +40,14 @@ int unpack_intspir_1bit_samples::work(int noutput_items,
     const auto *in = reinterpret_cast<const signed int *>(input_items[0]);
     auto *out = reinterpret_cast<float *>(output_items[0]);
 
-    int n = 0;
-    int channel = 1;
+    // Read packed input sample (1 int = 1 complex sample, in its two least
+    // significant bits). For historical reasons, values are float versions of
+    // short int limits (32767). The loop has no branches, so it vectorizes.
     for (int i = 0; i < noutput_items / 2; i++)
         {
-            // Read packed input sample (1 byte = 1 complex sample)
-            // For historical reasons, values are float versions of short int limits (32767)
-            signed int val = in[i];
-            if (((val >> ((channel - 1) * 2)) & 1) == 1)
-                {
-                    out[n++] = static_cast<float>(32767.0);
-                }
-            else
-                {
-                    out[n++] = static_cast<float>(-32767.0);
-                }
-            if (((val >> (2 * channel - 1)) & 1) == 1)
-                {
-                    out[n++] = static_cast<float>(32767.0);
-                }
-            else
-                {
-                    out[n++] = static_cast<float>(-32767.0);
-                }
+            const signed int val = in[i];
+            out[2 * i] = static_cast<float>((val & 1) * 65534 - 32767);
+            out[2 * i + 1] = static_cast<float>(((val >> 1) & 1) * 65534 - 32767);
         }
     return noutput_items;
 }
@@ -17,106 +17,89 @@
 
 
 #include "unpack_spir_gss6450_samples.h"
+#include "unpack_tables.h"
 #include <gnuradio/io_signature.h>
-#include <cmath>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 
-unpack_spir_gss6450_samples_sptr make_unpack_spir_gss6450_samples(int adc_nbit_)
+unpack_spir_gss6450_samples_sptr make_unpack_spir_gss6450_samples(int adc_nbit_, const std::string& output_item_type)
 {
-    return unpack_spir_gss6450_samples_sptr(new unpack_spir_gss6450_samples(adc_nbit_));
+    return unpack_spir_gss6450_samples_sptr(new unpack_spir_gss6450_samples(adc_nbit_, output_item_type));
 }
 
 
-unpack_spir_gss6450_samples::unpack_spir_gss6450_samples(int adc_nbit)
+unpack_spir_gss6450_samples::unpack_spir_gss6450_samples(int adc_nbit, const std::string& output_item_type)
     : gr::sync_interpolator("unpack_spir_gss6450_samples",
           gr::io_signature::make(1, 1, sizeof(int32_t)),
-          gr::io_signature::make(1, 1, sizeof(gr_complex)), 16 / adc_nbit),
+          gr::io_signature::make(1, 1, output_item_type == "cbyte" ? sizeof(lv_8sc_t) : sizeof(gr_complex)), 16 / adc_nbit),
+      float_output_(output_item_type != "cbyte"),
       adc_bits(adc_nbit),
       samples_per_int(16 / adc_bits)
 {
+    // Once the bytes of each word are reversed, the samples follow the order
+    // of the bytes, with the high nibble first if a byte holds two of them.
+    // I is in the least significant bits of each sample.
+    if (adc_bits == 2)
+        {
+            // four bits per complex sample (2 I + 2 Q), 8 samples per int32
+            tables_ = unpack_2bit_tables({2, 3, 0, 1}, unpack_2bit_levels(false));
+        }
+    else
+        {
+            // eight bits per complex sample (4 I + 4 Q), 4 samples per int32
+            const auto tables = unpack_4bit_tables({0, 1}, unpack_4bit_levels(false));
+            std::copy(tables.cbegin(), tables.cend(), tables_.begin());
+        }
 }
 
 
-void unpack_spir_gss6450_samples::decode_4bits_word(uint32_t input_uint32, gr_complex* out, int adc_bits_)
+int unpack_spir_gss6450_samples::work(int noutput_items,
+    gr_vector_const_void_star& input_items, gr_vector_void_star& output_items)
 {
-    int8_t tmp_char;
-    float Q;
-    float I;
-    switch (adc_bits_)
-        {
-        case 2:
-            // four bits per complex sample (2 I + 2 Q), 8 samples per int32[s0,s1,s2,s3,s4,s5,s6,s7]
-            for (int i = 0; i < 8; i++)
-                {
-                    tmp_char = input_uint32 & 3;
+    const auto* in = reinterpret_cast<const uint32_t*>(input_items[0]);
+    const size_t nwords = noutput_items / samples_per_int;
+    const size_t nvalues = 2 * static_cast<size_t>(noutput_items);
 
-                    if (tmp_char >= 2)
-                        {
-                            I = static_cast<float>(tmp_char - 4);
-                        }
-                    else
-                        {
-                            I = static_cast<float>(tmp_char);
-                        }
-                    input_uint32 = input_uint32 >> 2;
-                    tmp_char = input_uint32 & 3;
-                    if (tmp_char >= 2)
-                        {
-                            Q = static_cast<float>(tmp_char - 4);
-                        }
-                    else
-                        {
-                            Q = static_cast<float>(tmp_char);
-                        }
-                    input_uint32 = input_uint32 >> 2;
+    if (bytes_.size() < 4 * nwords)
+        {
+            bytes_.resize(4 * nwords);
+        }
+    for (size_t w = 0; w < nwords; w++)
+        {
+            const uint32_t word = in[w];
+            bytes_[4 * w] = static_cast<uint8_t>(word >> 24);
+            bytes_[4 * w + 1] = static_cast<uint8_t>(word >> 16);
+            bytes_[4 * w + 2] = static_cast<uint8_t>(word >> 8);
+            bytes_[4 * w + 3] = static_cast<uint8_t>(word);
+        }
 
-                    out[7 - i] = gr_complex(I, Q);
-                }
-            break;
-        case 4:
-            // eight bits per complex sample (4 I + 4 Q), 4 samples per int32= [s0,s1,s2,s3]
-            for (int i = 0; i < 4; i++)
+    int8_t* iq;
+    if (float_output_)
+        {
+            if (buffer_.size() < nvalues)
                 {
-                    tmp_char = input_uint32 & 0x0F;
-
-                    if (tmp_char >= 8)
-                        {
-                            I = static_cast<float>(tmp_char - 16);
-                        }
-                    else
-                        {
-                            I = static_cast<float>(tmp_char);
-                        }
-                    input_uint32 = input_uint32 >> 4;
-                    tmp_char = input_uint32 & 0x0F;
-                    if (tmp_char >= 8)
-                        {
-                            Q = static_cast<float>(tmp_char - 16);
-                        }
-                    else
-                        {
-                            Q = static_cast<float>(tmp_char);
-                        }
-                    input_uint32 = input_uint32 >> 4;
-
-                    out[3 - i] = gr_complex(I, Q);
+                    buffer_.resize(nvalues);
                 }
-            break;
+            iq = buffer_.data();
+        }
+    else
+        {
+            iq = reinterpret_cast<int8_t*>(output_items[0]);
         }
-}
 
-int unpack_spir_gss6450_samples::work(int noutput_items,
-    gr_vector_const_void_star& input_items, gr_vector_void_star& output_items)
-{
-    const auto* in = reinterpret_cast<const int32_t*>(input_items[0]);
-    auto* out = reinterpret_cast<gr_complex*>(output_items[0]);
-    int n_sample = 0;
-    int in_counter = 0;
-    do
+    if (adc_bits == 2)
+        {
+            volk_gnsssdr_8u_unpack_2bit_8i(iq, bytes_.data(), tables_.data(), 4 * nwords);
+        }
+    else
         {
-            decode_4bits_word(in[in_counter++], &out[n_sample], adc_bits);
-            n_sample += samples_per_int;
+            volk_gnsssdr_8u_unpack_4bit_8i(iq, bytes_.data(), tables_.data(), 4 * nwords);
         }
-    while (n_sample < noutput_items);
 
+    if (float_output_)
+        {
+            volk_8i_s32f_convert_32f(reinterpret_cast<float*>(output_items[0]), iq, 1.0F, nvalues);
+        }
     return noutput_items;
 }
@@ -20,6 +20,10 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_interpolator.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 /** \addtogroup Signal_Source
  * \{ */
@@ -31,20 +35,28 @@ class unpack_spir_gss6450_samples;
 
 using unpack_spir_gss6450_samples_sptr = gnss_shared_ptr<unpack_spir_gss6450_samples>;
 
-unpack_spir_gss6450_samples_sptr make_unpack_spir_gss6450_samples(int adc_nbit_);
-
+unpack_spir_gss6450_samples_sptr make_unpack_spir_gss6450_samples(int adc_nbit_, const std::string &output_item_type = "gr_complex");
 
+/*!
+ * \brief Unpacks the 32-bit words of the SPIR GSS6450 recorder into 8 (with
+ * 2-bit ADCs) or 4 (with 4-bit ADCs) complex samples, the first one in the
+ * most significant bits of the word. The output items are gr_complex, or
+ * lv_8sc_t if output_item_type is "cbyte".
+ */
 class unpack_spir_gss6450_samples : public gr::sync_interpolator
 {
 public:
-    explicit unpack_spir_gss6450_samples(int adc_nbit);
+    unpack_spir_gss6450_samples(int adc_nbit, const std::string &output_item_type);
     ~unpack_spir_gss6450_samples() = default;
-    void decode_4bits_word(uint32_t input_uint32, gr_complex *out, int adc_bits_);
     int work(int noutput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
 private:
-    friend unpack_spir_gss6450_samples_sptr make_unpack_spir_gss6450_samples_sptr(int adc_nbit);
+    friend unpack_spir_gss6450_samples_sptr make_unpack_spir_gss6450_samples_sptr(int adc_nbit, const std::string &output_item_type);
+    std::array<int8_t, 128> tables_{};
+    std::vector<uint8_t> bytes_;
+    std::vector<int8_t> buffer_;
+    bool float_output_;
     int adc_bits;
     int samples_per_int;
 };
@@ -0,0 +1,175 @@
+/*!
+ * \file gnss_sdr_mmap_file.cc
+ * \brief Read-only memory mapping of a file of samples, with read-ahead
+ * and release of already consumed pages.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_mmap_file.h"
+#include <glog/logging.h>
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, madvise, munmap
+#include <unistd.h>    // for close, lseek, sysconf
+#include <algorithm>   // for std::min, std::max
+#include <cstring>     // for memcpy
+#include <limits>      // for std::numeric_limits
+
+
+Gnss_Sdr_Mmap_File::~Gnss_Sdr_Mmap_File()
+{
+    close();
+}
+
+
+bool Gnss_Sdr_Mmap_File::open(const std::string& filename,
+    std::size_t item_size,
+    std::size_t prefetch_bytes,
+    bool huge_pages)
+{
+    close();
+    d_item_size = std::max<std::size_t>(item_size, 1);
+    const long page_size = sysconf(_SC_PAGESIZE);
+    d_page_size = page_size > 0 ? static_cast<std::size_t>(page_size) : 4096;
+    d_prefetch_bytes = (prefetch_bytes + d_page_size - 1) / d_page_size * d_page_size;
+
+    d_fd = ::open(filename.c_str(), O_RDONLY);
+    if (d_fd < 0)
+        {
+            LOG(WARNING) << "Cannot open file " << filename;
+            return false;
+        }
+    const off_t file_size = lseek(d_fd, 0, SEEK_END);
+    if (file_size < static_cast<off_t>(d_item_size))
+        {
+            LOG(WARNING) << "File " << filename << " is empty or cannot be accessed";
+            close();
+            return false;
+        }
+    if (static_cast<uint64_t>(file_size) > std::numeric_limits<std::size_t>::max())
+        {
+            LOG(WARNING) << "File " << filename << " is too large to be mapped in the address space of this process";
+            close();
+            return false;
+        }
+    d_mapped_bytes = static_cast<std::size_t>(file_size);
+    void* address = mmap(nullptr, d_mapped_bytes, PROT_READ, MAP_PRIVATE, d_fd, 0);
+    if (address == MAP_FAILED)
+        {
+            LOG(WARNING) << "Cannot map file " << filename << " in memory";
+            d_mapped_bytes = 0;
+            close();
+            return false;
+        }
+    d_data = static_cast<const uint8_t*>(address);
+    d_size_items = d_mapped_bytes / d_item_size;
+
+    // The kernel reads ahead more aggressively, and may drop pages behind, on sequential mappings
+    if (madvise(address, d_mapped_bytes, MADV_SEQUENTIAL) != 0)
+        {
+            DLOG(INFO) << "madvise(MADV_SEQUENTIAL) failed for " << filename;
+        }
+#ifdef MADV_HUGEPAGE
+    if (huge_pages && madvise(address, d_mapped_bytes, MADV_HUGEPAGE) != 0)
+        {
+            LOG(INFO) << "Huge pages are not available for the mapping of " << filename;
+        }
+#else
+    if (huge_pages)
+        {
+            LOG(INFO) << "Huge pages are not supported for file mappings in this system";
+        }
+#endif
+
+    d_position = 0;
+    d_prefetched_until = 0;
+    d_released_until = 0;
+    advise_window();
+    return true;
+}
+
+
+void Gnss_Sdr_Mmap_File::close()
+{
+    if (d_data != nullptr)
+        {
+            munmap(const_cast<uint8_t*>(d_data), d_mapped_bytes);
+            d_data = nullptr;
+        }
+    if (d_fd >= 0)
+        {
+            ::close(d_fd);
+            d_fd = -1;
+        }
+    d_mapped_bytes = 0;
+    d_size_items = 0;
+    d_position = 0;
+}
+
+
+bool Gnss_Sdr_Mmap_File::seek(uint64_t item)
+{
+    if (d_data == nullptr || item > d_size_items)
+        {
+            return false;
+        }
+    d_position = item;
+    const uint64_t position_bytes = item * d_item_size / d_page_size * d_page_size;
+    d_prefetched_until = position_bytes;
+    d_released_until = position_bytes;
+    advise_window();
+    return true;
+}
+
+
+std::size_t Gnss_Sdr_Mmap_File::read(void* dst, std::size_t num_items)
+{
+    if (d_data == nullptr || d_position >= d_size_items)
+        {
+            return 0;
+        }
+    const auto n = static_cast<std::size_t>(std::min<uint64_t>(num_items, d_size_items - d_position));
+    std::memcpy(dst, data(d_position), n * d_item_size);
+    d_position += n;
+    advise_window();
+    return n;
+}
+
+
+void Gnss_Sdr_Mmap_File::advise_window()
+{
+    if (d_prefetch_bytes == 0)
+        {
+            return;
+        }
+    auto* base = const_cast<uint8_t*>(d_data);
+    const uint64_t position_bytes = d_position * d_item_size;
+
+    // Request the next window once half of the previous one has been consumed
+    if (d_prefetched_until < d_mapped_bytes && position_bytes + d_prefetch_bytes / 2 >= d_prefetched_until)
+        {
+            const uint64_t start = std::max(d_prefetched_until, position_bytes / d_page_size * d_page_size);
+            const uint64_t end = std::min<uint64_t>(d_mapped_bytes, position_bytes + d_prefetch_bytes);
+            if (end > start)
+                {
+                    madvise(base + start, static_cast<std::size_t>(end - start), MADV_WILLNEED);
+                }
+            d_prefetched_until = end;
+        }
+
+    // Release the pages already consumed, keeping one window behind the read position
+    if (position_bytes >= d_released_until + 2 * d_prefetch_bytes)
+        {
+            const uint64_t end = (position_bytes - d_prefetch_bytes) / d_page_size * d_page_size;
+            madvise(base + d_released_until, static_cast<std::size_t>(end - d_released_until), MADV_DONTNEED);
+            d_released_until = end;
+        }
+}
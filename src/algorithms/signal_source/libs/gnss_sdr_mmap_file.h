@@ -0,0 +1,104 @@
+/*!
+ * \file gnss_sdr_mmap_file.h
+ * \brief Read-only memory mapping of a file of samples, with read-ahead
+ * and release of already consumed pages.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_MMAP_FILE_H
+#define GNSS_SDR_GNSS_SDR_MMAP_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Maps a whole file of fixed-size items in memory and copies them
+ * out sequentially.
+ *
+ * The kernel is told that the mapping will be read sequentially, the pages
+ * of the next prefetch window are requested in advance, and the pages that
+ * are more than one window behind the read position are released, so the
+ * resident memory stays bounded for files of any size. Seeking only moves
+ * the read position.
+ */
+class Gnss_Sdr_Mmap_File
+{
+public:
+    Gnss_Sdr_Mmap_File() = default;
+    ~Gnss_Sdr_Mmap_File();
+
+    Gnss_Sdr_Mmap_File(const Gnss_Sdr_Mmap_File&) = delete;
+    Gnss_Sdr_Mmap_File& operator=(const Gnss_Sdr_Mmap_File&) = delete;
+    Gnss_Sdr_Mmap_File(Gnss_Sdr_Mmap_File&&) = delete;
+    Gnss_Sdr_Mmap_File& operator=(Gnss_Sdr_Mmap_File&&) = delete;
+
+    /*!
+     * \brief Maps the file. Returns false if it cannot be opened or mapped,
+     * or if it does not contain a whole item. A trailing partial item is
+     * ignored. If huge_pages is true, the kernel is asked to back the mapping
+     * with transparent huge pages where it supports it for files.
+     */
+    bool open(const std::string& filename,
+        std::size_t item_size,
+        std::size_t prefetch_bytes = 64 * 1024 * 1024,
+        bool huge_pages = false);
+
+    void close();
+
+    inline bool is_open() const { return d_data != nullptr; }
+    inline uint64_t size_items() const { return d_size_items; }  //!< Number of whole items in the file
+    inline uint64_t position() const { return d_position; }      //!< Index of the next item to be read
+
+    /*!
+     * \brief Moves the read position to the given item. Returns false, and
+     * does not move, if it is beyond the end of the file.
+     */
+    bool seek(uint64_t item);
+
+    /*!
+     * \brief Copies up to num_items items from the read position into dst
+     * and advances it. Returns the number of items copied, 0 at the end of
+     * the file.
+     */
+    std::size_t read(void* dst, std::size_t num_items);
+
+    /*!
+     * \brief Direct access to the mapped item at the given index
+     */
+    inline const uint8_t* data(uint64_t item) const { return d_data + item * d_item_size; }
+
+private:
+    void advise_window();
+
+    const uint8_t* d_data{nullptr};
+    std::size_t d_mapped_bytes{0};
+    std::size_t d_item_size{1};
+    std::size_t d_page_size{4096};
+    std::size_t d_prefetch_bytes{0};
+    uint64_t d_size_items{0};
+    uint64_t d_position{0};
+    uint64_t d_prefetched_until{0};  // byte offsets
+    uint64_t d_released_until{0};
+    int d_fd{-1};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_MMAP_FILE_H
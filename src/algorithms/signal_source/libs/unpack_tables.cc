@@ -0,0 +1,93 @@
+/*!
+ * \file unpack_tables.cc
+ * \brief Lookup tables for the volk_gnsssdr kernels that unpack 2-bit and
+ * 4-bit samples packed into bytes.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "unpack_tables.h"
+
+
+std::array<int8_t, 4> unpack_2bit_levels(bool odd_levels)
+{
+    std::array<int8_t, 4> levels{};
+    for (int code = 0; code < 4; code++)
+        {
+            const int x = code < 2 ? code : code - 4;
+            levels[code] = static_cast<int8_t>(odd_levels ? 2 * x + 1 : x);
+        }
+    return levels;
+}
+
+
+std::array<int8_t, 16> unpack_4bit_levels(bool odd_levels)
+{
+    std::array<int8_t, 16> levels{};
+    for (int code = 0; code < 16; code++)
+        {
+            const int x = code < 8 ? code : code - 16;
+            levels[code] = static_cast<int8_t>(odd_levels ? 2 * x + 1 : x);
+        }
+    return levels;
+}
+
+
+std::array<int8_t, 128> unpack_2bit_tables(const std::array<int, 4>& fields, const std::array<int8_t, 4>& levels)
+{
+    std::array<int8_t, 128> tables{};
+    for (int k = 0; k < 4; k++)
+        {
+            // fields 0 and 1 are in the low nibble, 2 and 3 in the high one
+            const int offset = (fields[k] < 2 ? 0 : 64) + 16 * k;
+            const int shift = 2 * (fields[k] % 2);
+            for (int nibble = 0; nibble < 16; nibble++)
+                {
+                    tables[offset + nibble] = levels[(nibble >> shift) & 3];
+                }
+        }
+    return tables;
+}
+
+
+std::array<int8_t, 64> unpack_4bit_tables(const std::array<int, 2>& nibbles, const std::array<int8_t, 16>& levels)
+{
+    std::array<int8_t, 64> tables{};
+    for (int k = 0; k < 2; k++)
+        {
+            const int offset = (nibbles[k] == 0 ? 0 : 32) + 16 * k;
+            for (int nibble = 0; nibble < 16; nibble++)
+                {
+                    tables[offset + nibble] = levels[nibble];
+                }
+        }
+    return tables;
+}
+
+
+size_t unpack_value_size(const std::string& output_item_type)
+{
+    if (output_item_type == "ishort" || output_item_type == "cshort")
+        {
+            return sizeof(int16_t);
+        }
+    return sizeof(int8_t);
+}
+
+
+int unpack_values_per_item(const std::string& output_item_type)
+{
+    if (output_item_type == "cshort" || output_item_type == "cbyte")
+        {
+            return 2;
+        }
+    return 1;
+}
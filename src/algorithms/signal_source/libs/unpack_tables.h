@@ -0,0 +1,74 @@
+/*!
+ * \file unpack_tables.h
+ * \brief Lookup tables for the volk_gnsssdr kernels that unpack 2-bit and
+ * 4-bit samples packed into bytes.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_UNPACK_TABLES_H
+#define GNSS_SDR_UNPACK_TABLES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Values of the four 2-bit codes, read as two's complement integers
+ * x, or as 2 * x + 1 if odd_levels is true.
+ */
+std::array<int8_t, 4> unpack_2bit_levels(bool odd_levels);
+
+/*!
+ * \brief Values of the sixteen 4-bit codes, read as two's complement
+ * integers x, or as 2 * x + 1 if odd_levels is true.
+ */
+std::array<int8_t, 16> unpack_4bit_levels(bool odd_levels);
+
+/*!
+ * \brief Tables for volk_gnsssdr_8u_unpack_2bit_8i. The k-th output of each
+ * byte is levels[code], where code is the 2-bit field fields[k] of the byte,
+ * made of bits 2 * fields[k] and 2 * fields[k] + 1.
+ */
+std::array<int8_t, 128> unpack_2bit_tables(const std::array<int, 4>& fields, const std::array<int8_t, 4>& levels);
+
+/*!
+ * \brief Tables for volk_gnsssdr_8u_unpack_4bit_8i. The k-th output of each
+ * byte is levels[code], where code is the nibble nibbles[k] of the byte (0
+ * for the low nibble, 1 for the high one).
+ */
+std::array<int8_t, 64> unpack_4bit_tables(const std::array<int, 2>& nibbles, const std::array<int8_t, 16>& levels);
+
+/*!
+ * \brief Size of each unpacked integer for the output item types of the
+ * unpacking blocks: sizeof(int16_t) for "ishort" and "cshort", and
+ * sizeof(int8_t) for "ibyte" and "cbyte".
+ */
+size_t unpack_value_size(const std::string& output_item_type);
+
+/*!
+ * \brief Number of unpacked integers in each output item: 2 for the complex
+ * types "cshort" and "cbyte", 1 for the interleaved ones.
+ */
+int unpack_values_per_item(const std::string& output_item_type);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_UNPACK_TABLES_H
@@ -18,7 +18,9 @@
 #define GNSS_SDR_BEIDOU_B3I_TELEMETRY_DECODER_GS_H
 
 #include "beidou_dnav_navigation_message.h"
+#include "block_instrumentation.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
 #include "gnss_satellite.h"
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
@@ -28,7 +30,6 @@
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <array>
 #include <cstdint>
-#include <fstream>
 #include <memory>  // for std::unique_ptr
 #include <string>
 
@@ -66,6 +67,8 @@ public:
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items) override;
 
+    bool stop() override;
+
 private:
     friend beidou_b3i_telemetry_decoder_gs_sptr beidou_b3i_make_telemetry_decoder_gs(
         const Gnss_Satellite &satellite,
@@ -93,7 +96,8 @@ private:
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::unique_ptr<Gnss_Dump_Writer> d_dump_writer;
+    std::shared_ptr<Block_Counters> d_counters;
 
     uint64_t d_sample_counter;  // Sample counter as an index (1,2,3,..etc) indicating number of samples processed
     uint64_t d_preamble_index;  // Index of sample number where preamble was found
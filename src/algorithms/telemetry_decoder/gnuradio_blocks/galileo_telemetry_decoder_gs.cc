@@ -29,6 +29,7 @@
 #include "galileo_has_page.h"        // For Galileo_HAS_page
 #include "galileo_iono.h"            // for Galileo_Iono
 #include "galileo_utc_model.h"       // for Galileo_Utc_Model
+#include "gnss_packed_bits.h"        // for Gnss_Packed_Bits
 #include "gnss_sdr_make_unique.h"    // for std::make_unique in C++11
 #include "gnss_synchro.h"            // for Gnss_Synchro
 #include "tlm_crc_stats.h"           // for Tlm_CRC_Stats
@@ -109,6 +110,11 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                       d_there_are_e6_channels(conf.there_are_e6_channels),
                       d_use_ced(conf.use_ced)
 {
+    if (d_dump)
+        {
+            d_dump_writer = std::make_unique<Gnss_Dump_Writer>(tlm_dump_schema(), dump_format_from_string(conf.dump_format), conf.dump_compression);
+            d_dump_writer->set_overflow_policy(dump_overflow_from_string(conf.dump_overflow));
+        }
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
     // Ephemeris data port out
@@ -225,6 +231,8 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
         }
 
     d_page_part_symbols = std::vector<float>(d_frame_length_symbols);
+    d_page_symbols_soft_value = std::vector<float>(d_frame_length_symbols);
+    d_page_bits = std::vector<int32_t>(d_frame_length_symbols / 2);
 
     for (int32_t i = 0; i < d_bits_per_preamble; i++)
         {
@@ -269,19 +277,20 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
 
     // Instantiate the Viterbi decoder
     d_viterbi = std::make_unique<Viterbi_Decoder>(KK, nn, d_datalength, g_encoder);
+    d_counters = Block_Instrumentation::instance().register_block(this->name());
 }
 
 
 galileo_telemetry_decoder_gs::~galileo_telemetry_decoder_gs()
 {
     DLOG(INFO) << "Galileo Telemetry decoder block (channel " << d_channel << ") destructor called.";
-    size_t pos = 0;
-    if (d_dump_file.is_open() == true)
+    uint64_t pos = 0;
+    if (d_dump_writer && d_dump_writer->is_open())
         {
-            pos = d_dump_file.tellp();
             try
                 {
-                    d_dump_file.close();
+                    d_dump_writer->close();
+                    pos = d_dump_writer->written_records();
                 }
             catch (const std::exception &ex)
                 {
@@ -297,7 +306,7 @@ galileo_telemetry_decoder_gs::~galileo_telemetry_decoder_gs()
         }
     if (d_dump && (pos != 0) && d_dump_mat)
         {
-            save_tlm_matfile(d_dump_filename);
+            save_tlm_matfile(d_dump_filename, d_dump_writer->format());
             if (d_remove_dat)
                 {
                     if (!tlm_remove_file(d_dump_filename))
@@ -309,6 +318,16 @@ galileo_telemetry_decoder_gs::~galileo_telemetry_decoder_gs()
 }
 
 
+bool galileo_telemetry_decoder_gs::stop()
+{
+    if (d_dump_writer)
+        {
+            d_dump_writer->flush();
+        }
+    return true;
+}
+
+
 void galileo_telemetry_decoder_gs::msg_handler_read_galileo_tow_map(const pmt::pmt_t &msg)
 {
     if (d_frame_type == 3)
@@ -354,7 +373,7 @@ void galileo_telemetry_decoder_gs::deinterleaver(int32_t rows, int32_t cols, con
 void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, int32_t frame_length, double cn0)
 {
     // 1. De-interleave
-    std::vector<float> page_part_symbols_soft_value(frame_length);
+    std::vector<float>& page_part_symbols_soft_value = d_page_symbols_soft_value;
     deinterleaver(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, page_part_symbols, page_part_symbols_soft_value.data());
 
     // 2. Viterbi decoder
@@ -367,33 +386,22 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 }
         }
     const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_part_bits(decoded_length);
+    std::vector<int32_t>& page_part_bits = d_page_bits;
     d_viterbi->decode(page_part_bits, page_part_symbols_soft_value);
 
     // 3. Call the Galileo page decoder
-    std::string page_String;
-    page_String.reserve(decoded_length);
-    for (int32_t i = 0; i < decoded_length; i++)
-        {
-            if (page_part_bits[i] > 0)
-                {
-                    page_String.push_back('1');
-                }
-            else
-                {
-                    page_String.push_back('0');
-                }
-        }
+    Gnss_Packed_Bits<GALILEO_INAV_PAGE_PART_BITS> page_part;
+    page_part.assign(page_part_bits.data(), decoded_length);
 
     if (d_enable_navdata_monitor)
         {
-            d_nav_msg_packet.nav_message = page_String;
+            d_nav_msg_packet.nav_message = page_part.to_string();
         }
 
     if (page_part_bits[0] == 1)
         {
             // DECODE COMPLETE WORD (even + odd) and TEST CRC
-            d_inav_nav.split_page(std::move(page_String), d_flag_even_word_arrived);
+            d_inav_nav.split_page(page_part, d_flag_even_word_arrived);
             if (d_inav_nav.get_flag_CRC_test() == true)
                 {
                     if (d_band == '1')
@@ -421,7 +429,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
     else
         {
             // STORE HALF WORD (even page)
-            d_inav_nav.split_page(std::move(page_String), d_flag_even_word_arrived);
+            d_inav_nav.split_page(page_part, d_flag_even_word_arrived);
             d_flag_even_word_arrived = 1;
         }
 
@@ -581,7 +589,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
 void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t frame_length, double cn0)
 {
     // 1. De-interleave
-    std::vector<float> page_symbols_soft_value(frame_length);
+    std::vector<float>& page_symbols_soft_value = d_page_symbols_soft_value;
     deinterleaver(GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
 
     // 2. Viterbi decoder
@@ -595,31 +603,20 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
         }
 
     const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
+    std::vector<int32_t>& page_bits = d_page_bits;
     d_viterbi->decode(page_bits, page_symbols_soft_value);
 
     // 3. Call the Galileo page decoder
-    std::string page_String;
-    page_String.reserve(decoded_length);
-    for (int32_t i = 0; i < decoded_length; i++)
-        {
-            if (page_bits[i] > 0)
-                {
-                    page_String.push_back('1');
-                }
-            else
-                {
-                    page_String.push_back('0');
-                }
-        }
+    Gnss_Packed_Bits<GALILEO_FNAV_PAGE_BITS> page;
+    page.assign(page_bits.data(), decoded_length);
 
     if (d_enable_navdata_monitor)
         {
-            d_nav_msg_packet.nav_message = page_String;
+            d_nav_msg_packet.nav_message = page.to_string();
         }
 
     // DECODE COMPLETE WORD (even + odd) and TEST CRC
-    d_fnav_nav.split_page(page_String);
+    d_fnav_nav.split_page(page);
     if (d_fnav_nav.get_flag_CRC_test() == true)
         {
             DLOG(INFO) << "Galileo E5a CRC correct in channel " << d_channel << " from satellite " << d_satellite << " with CN0=" << cn0 << " dB-Hz";
@@ -680,7 +677,7 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
 void galileo_telemetry_decoder_gs::decode_CNAV_word(uint64_t time_stamp, float *page_symbols, int32_t page_length, double cn0)
 {
     // 1. De-interleave
-    std::vector<float> page_symbols_soft_value(page_length);
+    std::vector<float>& page_symbols_soft_value = d_page_symbols_soft_value;
     deinterleaver(GALILEO_CNAV_INTERLEAVER_ROWS, GALILEO_CNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
 
     // 2. Viterbi decoder
@@ -693,7 +690,7 @@ void galileo_telemetry_decoder_gs::decode_CNAV_word(uint64_t time_stamp, float *
                 }
         }
     const int32_t decoded_length = page_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
+    std::vector<int32_t>& page_bits = d_page_bits;
     d_viterbi->decode(page_bits, page_symbols_soft_value);
 
     // 3. Call the Galileo page decoder
@@ -823,23 +820,22 @@ void galileo_telemetry_decoder_gs::reset()
 void galileo_telemetry_decoder_gs::set_channel(int32_t channel)
 {
     d_channel = channel;
+    d_counters->set_channel(channel);
     DLOG(INFO) << "Navigation channel set to " << channel;
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump == true)
         {
-            if (d_dump_file.is_open() == false)
+            if (!d_dump_writer->is_open())
                 {
-                    try
+                    d_dump_filename.append(std::to_string(d_channel));
+                    d_dump_filename.append(".dat");
+                    if (d_dump_writer->open(d_dump_filename))
                         {
-                            d_dump_filename.append(std::to_string(d_channel));
-                            d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
                         }
-                    catch (const std::ofstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "channel " << d_channel << " Exception opening trk dump file " << e.what();
+                            LOG(WARNING) << "channel " << d_channel << " Error opening telemetry decoder dump file " << d_dump_filename;
                         }
                 }
         }
@@ -869,9 +865,10 @@ void galileo_telemetry_decoder_gs::check_tlm_separation()
 }
 
 
-int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
+int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
+    Block_Work_Timer work_timer(d_counters.get(), ninput_items[0]);
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
     const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
 
@@ -928,6 +925,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                 }
         }
 
+    work_timer.set_items(1);
     consume_each(1);
     d_flag_preamble = false;
 
@@ -1371,40 +1369,35 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
             if (d_dump == true)
                 {
                     // MULTIPLEXED FILE RECORDING - Record results to file
-                    try
-                        {
-                            double tmp_double;
-                            uint64_t tmp_ulong_int;
-                            int32_t tmp_int;
-                            tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                            tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                            tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                            switch (d_frame_type)
-                                {
-                                case 1:
-                                    tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
-                                    break;
-                                case 2:
-                                    tmp_int = (current_symbol.Prompt_Q > 0.0 ? 1 : -1);
-                                    break;
-                                case 3:
-                                    tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
-                                    break;
-                                default:
-                                    tmp_int = 0;
-                                    break;
-                                }
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                            tmp_int = static_cast<int32_t>(current_symbol.PRN);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                        }
-                    catch (const std::ofstream::failure &e)
+                    double tmp_double;
+                    uint64_t tmp_ulong_int;
+                    int32_t tmp_int;
+                    Gnss_Dump_Record record(*d_dump_writer);
+                    tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
+                    record.add(tmp_double);
+                    tmp_ulong_int = current_symbol.Tracking_sample_counter;
+                    record.add(tmp_ulong_int);
+                    tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
+                    record.add(tmp_double);
+                    switch (d_frame_type)
                         {
-                            LOG(WARNING) << "Exception writing navigation data dump file " << e.what();
+                        case 1:
+                            tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
+                            break;
+                        case 2:
+                            tmp_int = (current_symbol.Prompt_Q > 0.0 ? 1 : -1);
+                            break;
+                        case 3:
+                            tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
+                            break;
+                        default:
+                            tmp_int = 0;
+                            break;
                         }
+                    record.add(tmp_int);
+                    tmp_int = static_cast<int32_t>(current_symbol.PRN);
+                    record.add(tmp_int);
+                    record.commit();
                 }
             // 3. Make the output (move the object contents to the GNURadio reserved memory)
             *out[0] = std::move(current_symbol);
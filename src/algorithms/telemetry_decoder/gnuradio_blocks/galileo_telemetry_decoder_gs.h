@@ -21,10 +21,12 @@
 #ifndef GNSS_SDR_GALILEO_TELEMETRY_DECODER_GS_H
 #define GNSS_SDR_GALILEO_TELEMETRY_DECODER_GS_H
 
+#include "block_instrumentation.h"    // for Block_Counters
 #include "galileo_cnav_message.h"     // for Galileo_Cnav_Message
 #include "galileo_fnav_message.h"     // for Galileo_Fnav_Message
 #include "galileo_inav_message.h"     // for Galileo_Inav_Message
 #include "gnss_block_interface.h"     // for gnss_shared_ptr (adapts smart pointer type to GNU Radio version)
+#include "gnss_dump_writer.h"         // for Gnss_Dump_Writer
 #include "gnss_satellite.h"           // for Gnss_Satellite
 #include "gnss_time.h"                // for GnssTime
 #include "nav_message_packet.h"       // for Nav_Message_Packet
@@ -34,7 +36,6 @@
 #include <gnuradio/types.h>           // for gr_vector_const_void_star
 #include <pmt/pmt.h>                  // for pmt::pmt_t
 #include <cstdint>                    // for int32_t, uint32_t
-#include <fstream>                    // for std::ofstream
 #include <memory>                     // for std::unique_ptr
 #include <string>                     // for std::string
 #include <vector>                     // for std::vector
@@ -72,6 +73,8 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
 
+    bool stop() override;
+
 private:
     friend galileo_telemetry_decoder_gs_sptr galileo_make_telemetry_decoder_gs(
         const Gnss_Satellite &satellite,
@@ -90,9 +93,12 @@ private:
     std::unique_ptr<Viterbi_Decoder> d_viterbi;
     std::vector<int32_t> d_preamble_samples;
     std::vector<float> d_page_part_symbols;
+    std::vector<float> d_page_symbols_soft_value;  // de-interleaved symbols, reused from page to page
+    std::vector<int32_t> d_page_bits;               // decoded bits, reused from page to page
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::unique_ptr<Gnss_Dump_Writer> d_dump_writer;
+    std::shared_ptr<Block_Counters> d_counters;
 
     boost::circular_buffer<float> d_symbol_history;
 
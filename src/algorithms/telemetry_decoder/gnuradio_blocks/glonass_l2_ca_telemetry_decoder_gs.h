@@ -19,8 +19,10 @@
 
 
 #include "GLONASS_L1_L2_CA.h"
+#include "block_instrumentation.h"
 #include "glonass_gnav_navigation_message.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
 #include "gnss_satellite.h"
 #include "gnss_synchro.h"
 #include "nav_message_packet.h"
@@ -31,7 +33,6 @@
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <array>
 #include <cstdint>
-#include <fstream>
 #include <memory>  // for std::unique_ptr
 #include <string>
 
@@ -68,6 +69,8 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
 
+    bool stop() override;
+
 private:
     friend glonass_l2_ca_telemetry_decoder_gs_sptr glonass_l2_ca_make_telemetry_decoder_gs(
         const Gnss_Satellite &satellite,
@@ -94,7 +97,8 @@ private:
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::unique_ptr<Gnss_Dump_Writer> d_dump_writer;
+    std::shared_ptr<Block_Counters> d_counters;
 
     double d_preamble_time_samples;
     double d_TOW_at_current_symbol;
@@ -17,7 +17,9 @@
 #ifndef GNSS_SDR_GPS_L1_CA_TELEMETRY_DECODER_GS_H
 #define GNSS_SDR_GPS_L1_CA_TELEMETRY_DECODER_GS_H
 #include "GPS_L1_CA.h"
+#include "block_instrumentation.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
 #include "gnss_satellite.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"  // for timetags produced by Tracking
@@ -30,7 +32,6 @@
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <array>             // for array
 #include <cstdint>           // for int32_t
-#include <fstream>           // for ofstream
 #include <memory>            // for std::unique_ptr
 #include <string>            // for string
 
@@ -66,6 +67,8 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
 
+    bool stop() override;
+
 private:
     friend gps_l1_ca_telemetry_decoder_gs_sptr gps_l1_ca_make_telemetry_decoder_gs(
         const Gnss_Satellite &satellite,
@@ -87,7 +90,8 @@ private:
     std::array<int32_t, GPS_CA_PREAMBLE_LENGTH_BITS> d_preamble_samples{};
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::unique_ptr<Gnss_Dump_Writer> d_dump_writer;
+    std::shared_ptr<Block_Counters> d_counters;
 
     boost::circular_buffer<float> d_symbol_history;
 
@@ -65,6 +65,11 @@ gps_l2c_telemetry_decoder_gs::gps_l2c_telemetry_decoder_gs(
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
                             d_dump_crc_stats(conf.dump_crc_stats)
 {
+    if (d_dump)
+        {
+            d_dump_writer = std::make_unique<Gnss_Dump_Writer>(tlm_dump_schema(), dump_format_from_string(conf.dump_format), conf.dump_compression);
+            d_dump_writer->set_overflow_policy(dump_overflow_from_string(conf.dump_overflow));
+        }
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
     // Ephemeris data port out
@@ -98,19 +103,20 @@ gps_l2c_telemetry_decoder_gs::gps_l2c_telemetry_decoder_gs(
         {
             d_Tlm_CRC_Stats = nullptr;
         }
+    d_counters = Block_Instrumentation::instance().register_block(this->name());
 }
 
 
 gps_l2c_telemetry_decoder_gs::~gps_l2c_telemetry_decoder_gs()
 {
     DLOG(INFO) << "GPS L2C Telemetry decoder block (channel " << d_channel << ") destructor called.";
-    size_t pos = 0;
-    if (d_dump_file.is_open() == true)
+    uint64_t pos = 0;
+    if (d_dump_writer && d_dump_writer->is_open())
         {
-            pos = d_dump_file.tellp();
             try
                 {
-                    d_dump_file.close();
+                    d_dump_writer->close();
+                    pos = d_dump_writer->written_records();
                 }
             catch (const std::exception &ex)
                 {
@@ -126,7 +132,7 @@ gps_l2c_telemetry_decoder_gs::~gps_l2c_telemetry_decoder_gs()
         }
     if (d_dump && (pos != 0) && d_dump_mat)
         {
-            save_tlm_matfile(d_dump_filename);
+            save_tlm_matfile(d_dump_filename, d_dump_writer->format());
             if (d_remove_dat)
                 {
                     if (!tlm_remove_file(d_dump_filename))
@@ -138,6 +144,16 @@ gps_l2c_telemetry_decoder_gs::~gps_l2c_telemetry_decoder_gs()
 }
 
 
+bool gps_l2c_telemetry_decoder_gs::stop()
+{
+    if (d_dump_writer)
+        {
+            d_dump_writer->flush();
+        }
+    return true;
+}
+
+
 void gps_l2c_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satellite)
 {
     d_satellite = Gnss_Satellite(satellite.get_system(), satellite.get_PRN());
@@ -148,24 +164,22 @@ void gps_l2c_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satellite
 void gps_l2c_telemetry_decoder_gs::set_channel(int channel)
 {
     d_channel = channel;
+    d_counters->set_channel(channel);
     LOG(INFO) << "GPS L2C CNAV channel set to " << channel;
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump == true)
         {
-            if (d_dump_file.is_open() == false)
+            if (!d_dump_writer->is_open())
                 {
-                    try
+                    d_dump_filename.append(std::to_string(d_channel));
+                    d_dump_filename.append(".dat");
+                    if (d_dump_writer->open(d_dump_filename))
                         {
-                            d_dump_filename.append(std::to_string(d_channel));
-                            d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
-                            LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel
-                                      << " Log file: " << d_dump_filename.c_str();
+                            LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
                         }
-                    catch (const std::ofstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "channel " << d_channel << " Exception opening Telemetry GPS L2 dump file " << e.what();
+                            LOG(WARNING) << "channel " << d_channel << " Error opening telemetry decoder dump file " << d_dump_filename;
                         }
                 }
         }
@@ -186,9 +200,10 @@ void gps_l2c_telemetry_decoder_gs::reset()
 }
 
 
-int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
+int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
+    Block_Work_Timer work_timer(d_counters.get(), ninput_items[0]);
     // get pointers on in- and output gnss-synchro objects
     auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
     const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
@@ -208,6 +223,7 @@ int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
             d_cnav_decoder.part2.message_lock = false;
         }
 
+    work_timer.set_items(1);
     consume_each(1);  // one by one
 
     // check if there is a problem with the telemetry of the current satellite
@@ -346,26 +362,21 @@ int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
     if (d_dump == true)
         {
             // MULTIPLEXED FILE RECORDING - Record results to file
-            try
-                {
-                    double tmp_double;
-                    uint64_t tmp_ulong_int;
-                    int32_t tmp_int;
-                    tmp_double = d_TOW_at_current_symbol;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    tmp_ulong_int = current_synchro_data.Tracking_sample_counter;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
-                    tmp_double = d_TOW_at_Preamble;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    tmp_int = (current_synchro_data.Prompt_I > 0.0 ? 1 : -1);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                    tmp_int = static_cast<int32_t>(current_synchro_data.PRN);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
-                }
-            catch (const std::ofstream::failure &e)
-                {
-                    LOG(WARNING) << "Exception writing Telemetry GPS L2 dump file " << e.what();
-                }
+            double tmp_double;
+            uint64_t tmp_ulong_int;
+            int32_t tmp_int;
+            Gnss_Dump_Record record(*d_dump_writer);
+            tmp_double = d_TOW_at_current_symbol;
+            record.add(tmp_double);
+            tmp_ulong_int = current_synchro_data.Tracking_sample_counter;
+            record.add(tmp_ulong_int);
+            tmp_double = d_TOW_at_Preamble;
+            record.add(tmp_double);
+            tmp_int = (current_synchro_data.Prompt_I > 0.0 ? 1 : -1);
+            record.add(tmp_int);
+            tmp_int = static_cast<int32_t>(current_synchro_data.PRN);
+            record.add(tmp_int);
+            record.commit();
         }
 
     // 3. Make the output (copy the object contents to the GNURadio reserved memory)
@@ -18,7 +18,9 @@
 #define GNSS_SDR_GPS_L2C_TELEMETRY_DECODER_GS_H
 
 
+#include "block_instrumentation.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
 #include "gnss_satellite.h"
 #include "gps_cnav_navigation_message.h"
 #include "nav_message_packet.h"
@@ -27,7 +29,6 @@
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
-#include <fstream>
 #include <memory>  // for std::unique_ptr
 #include <string>
 
@@ -67,6 +68,8 @@ public:
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
 
+    bool stop() override;
+
 private:
     friend gps_l2c_telemetry_decoder_gs_sptr gps_l2c_make_telemetry_decoder_gs(
         const Gnss_Satellite &satellite,
@@ -84,7 +87,8 @@ private:
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    std::unique_ptr<Gnss_Dump_Writer> d_dump_writer;
+    std::shared_ptr<Block_Counters> d_counters;
 
     double d_TOW_at_current_symbol;
     double d_TOW_at_Preamble;
@@ -17,6 +17,7 @@
 #ifndef GNSS_SDR_SBAS_L1_TELEMETRY_DECODER_GS_H
 #define GNSS_SDR_SBAS_L1_TELEMETRY_DECODER_GS_H
 
+#include "block_instrumentation.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
 #include <boost/crc.hpp>  // for crc_optimal
@@ -81,6 +82,7 @@ private:
 
     bool d_dump;
     Gnss_Satellite d_satellite;
+    std::shared_ptr<Block_Counters> d_counters;
     int32_t d_channel;
 
     std::string d_dump_filename;
@@ -25,6 +25,9 @@ void Tlm_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     dump_filename = configuration->property(role + ".dump_filename", default_dumpname);
     dump = configuration->property(role + ".dump", false);
     dump_mat = configuration->property(role + ".dump_mat", dump);
+    dump_format = configuration->property(role + ".dump_format", dump_format);
+    dump_overflow = configuration->property(role + ".dump_overflow", dump_overflow);
+    dump_compression = configuration->property(role + ".dump_compression", false);
     remove_dat = configuration->property(role + ".remove_dat", false);
     dump_crc_stats = configuration->property(role + ".dump_crc_stats", false);
     const std::string default_crc_stats_dumpname("telemetry_crc_stats");
@@ -36,8 +36,11 @@ public:
 
     std::string dump_filename;
     std::string dump_crc_stats_filename;
+    std::string dump_format{"binary"};
+    std::string dump_overflow{"block"};
     bool dump{false};
     bool dump_mat{false};
+    bool dump_compression{false};
     bool remove_dat{false};
     bool enable_reed_solomon{false};  // for INAV message in Galileo E1B
     bool dump_crc_stats{false};       // telemetry CRC statistics
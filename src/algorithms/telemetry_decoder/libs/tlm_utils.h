@@ -17,14 +17,18 @@
 #ifndef GNSS_SDR_TLM_UTILS_H
 #define GNSS_SDR_TLM_UTILS_H
 
+#include "gnss_dump_writer.h"
 #include <string>
+#include <vector>
 
 /** \addtogroup Telemetry_Decoder
  * \{ */
 /** \addtogroup Telemetry_Decoder_libs
  * \{ */
 
-int save_tlm_matfile(const std::string &dumpfile);
+const std::vector<Dump_Column> &tlm_dump_schema();  //!< Fields of each record of the telemetry dump files
+
+int save_tlm_matfile(const std::string &dumpfile, Dump_Format format = Dump_Format::BINARY);
 
 bool tlm_remove_file(const std::string &file_to_remove);
 
@@ -15,8 +15,9 @@
  */
 
 #include "viterbi_decoder.h"
-#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_index_max_32u
-#include <algorithm>                    // for std::copy
+#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_index_max_32u, volk_gnsssdr_8i_viterbi_k7r2_32u
+#include <algorithm>                    // for std::copy, std::max
+#include <cmath>                        // for std::abs, std::lround
 
 Viterbi_Decoder::Viterbi_Decoder(int32_t KK,
     int32_t nn,
@@ -41,6 +42,18 @@ Viterbi_Decoder::Viterbi_Decoder(int32_t KK,
     d_state1 = std::vector<int32_t>(d_states);
     nsc_transit(d_out0, d_state0, 0);
     nsc_transit(d_out1, d_state1, 1);
+
+    // The butterflies of the kernel need the first and last taps of both polynomials
+    d_use_k7r2 = (d_KK == 7) && (d_nn == 2) && ((d_g[0] & d_g[1] & 0x41) == 0x41);
+    if (d_use_k7r2)
+        {
+            d_quantized_symbols = volk_gnsssdr::vector<int8_t>(d_nn * (d_LL + d_mm));
+            d_decisions = volk_gnsssdr::vector<uint32_t>(2 * (d_LL + d_mm));
+            for (int32_t i = 0; i < 32; i++)
+                {
+                    d_branch_table[i] = static_cast<uint8_t>(d_out0[2 * i]);
+                }
+        }
 }
 
 
@@ -53,12 +66,19 @@ void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vect
     float metric;
     float max_val;
 
+    if (d_use_k7r2)
+        {
+            decode_k7r2(output_u_int, input_c);
+            return;
+        }
+
+    std::fill(d_prev_section.begin(), d_prev_section.end(), -d_MAXLOG);
     d_prev_section[0] = 0.0;  //  start in all-zeros state
 
     // go through trellis
     for (t = 0; t < d_LL + d_mm; t++)
         {
-            std::copy(input_c.begin() + d_nn * t, input_c.begin() + d_nn * t + (d_nn - 1), d_rec_array.begin());
+            std::copy(input_c.begin() + d_nn * t, input_c.begin() + d_nn * (t + 1), d_rec_array.begin());
 
             // precompute all possible branch metrics
             for (i = 0; i < d_number_symbols; i++)
@@ -120,6 +140,42 @@ void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vect
 }
 
 
+void Viterbi_Decoder::decode_k7r2(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c)
+{
+    const int32_t num_steps = d_LL + d_mm;
+    const int32_t num_symbols = d_nn * num_steps;
+
+    // quantize the soft symbols to 8 bits. The decisions do not depend on the scale.
+    float max_abs = 0.0;
+    for (int32_t i = 0; i < num_symbols; i++)
+        {
+            max_abs = std::max(max_abs, std::abs(input_c[i]));
+        }
+    const float scale = max_abs > 0.0 ? 127.0F / max_abs : 0.0F;
+    for (int32_t i = 0; i < num_symbols; i++)
+        {
+            d_quantized_symbols[i] = static_cast<int8_t>(std::lround(input_c[i] * scale));
+        }
+
+    // start in all-zeros state
+    d_metrics.fill(-8192);
+    d_metrics[0] = 0;
+    volk_gnsssdr_8i_viterbi_k7r2_32u(d_decisions.data(), d_metrics.data(), d_quantized_symbols.data(), d_branch_table.data(), num_steps);
+
+    // trace-back operation from the all-zeros state, the tail is not output
+    int32_t state = 0;
+    for (int32_t t = num_steps - 1; t >= 0; t--)
+        {
+            const uint32_t bit = (d_decisions[2 * t + (state >> 5)] >> (state & 31)) & 1U;
+            if (t < d_LL)
+                {
+                    output_u_int[t] = state >> 5;
+                }
+            state = ((state & 31) << 1) | static_cast<int32_t>(bit);
+        }
+}
+
+
 void Viterbi_Decoder::reset()
 {
     d_out0 = std::vector<int32_t>(d_states);
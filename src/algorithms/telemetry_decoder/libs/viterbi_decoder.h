@@ -17,6 +17,7 @@
 #ifndef GNSS_SDR_VITERBI_DECODER_H
 #define GNSS_SDR_VITERBI_DECODER_H
 
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <array>
 #include <cstdint>
 #include <vector>
@@ -30,6 +31,14 @@
 
 /*!
  * \brief Class that implements a Viterbi decoder
+ *
+ * Codes with constraint length 7 and rate 1/2 whose generator polynomials
+ * have their first and last taps set, such as the one used by the Galileo
+ * navigation messages, are decoded with the
+ * volk_gnsssdr_8i_viterbi_k7r2_32u kernel, with the soft symbols quantized to
+ * 8 bits, 16-bit path metrics and bit-packed survivor decisions. Other codes
+ * use a generic floating-point implementation. All the buffers are allocated
+ * at construction.
  */
 class Viterbi_Decoder
 {
@@ -57,6 +66,11 @@ public:
     void reset();
 
 private:
+    /*
+     * Decoding with the volk_gnsssdr_8i_viterbi_k7r2_32u kernel
+     */
+    void decode_k7r2(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c);
+
     /*
      * Function that creates the transit and output vectors
      */
@@ -115,6 +129,11 @@ private:
     std::vector<int32_t> d_state0;
     std::vector<int32_t> d_state1;
 
+    volk_gnsssdr::vector<int8_t> d_quantized_symbols;
+    volk_gnsssdr::vector<uint32_t> d_decisions;
+    std::array<int16_t, 64> d_metrics{};
+    std::array<uint8_t, 32> d_branch_table{};
+
     float d_MAXLOG = 1e7;  // Define infinity
     int32_t d_KK{};
     int32_t d_nn{};
@@ -123,6 +142,7 @@ private:
     int32_t d_mm{};
     int32_t d_states{};
     int32_t d_number_symbols{};
+    bool d_use_k7r2{};
 };
 
 /** \} */
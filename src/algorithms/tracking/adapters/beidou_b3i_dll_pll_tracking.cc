@@ -26,6 +26,7 @@
 #include "display.h"
 #include "dll_pll_conf.h"
 #include "gnss_sdr_flags.h"
+#include "item_type_helpers.h"
 #include <glog/logging.h>
 #include <algorithm>
 #include <array>
@@ -63,8 +64,9 @@ BeidouB3iDllPllTracking::BeidouB3iDllPllTracking(
 
     // ################# Make a GNU Radio Tracking block object ################
     DLOG(INFO) << "role " << role_;
-    if (trk_params.item_type == "gr_complex")
+    if (trk_params.item_type == "gr_complex" or trk_params.item_type == "cshort" or trk_params.item_type == "cbyte")
         {
+            item_size_ = item_type_size(trk_params.item_type);
             tracking_sptr_ = dll_pll_veml_make_tracking(trk_params);
             DLOG(INFO) << "tracking(" << tracking_sptr_->unique_id() << ")";
         }
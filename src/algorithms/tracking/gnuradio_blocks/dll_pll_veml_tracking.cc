@@ -39,6 +39,7 @@
 #include "gnss_satellite.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
 #include "gps_l2c_signal_replica.h"
 #include "gps_l5_signal_replica.h"
@@ -48,7 +49,6 @@
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>   // for io_signature
 #include <gnuradio/thread/thread.h>  // for scoped_lock
-#include <matio.h>                   // for Mat_VarCreate
 #include <pmt/pmt_sugar.h>           // for mp
 #include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>  // for fill_n
@@ -74,6 +74,35 @@ namespace wht = boost;
 namespace wht = std;
 #endif
 
+namespace
+{
+// Layout of each record of the tracking dump files
+const std::vector<Dump_Column> tracking_dump_schema{
+    {"abs_VE", Dump_Type::FLOAT32},
+    {"abs_E", Dump_Type::FLOAT32},
+    {"abs_P", Dump_Type::FLOAT32},
+    {"abs_L", Dump_Type::FLOAT32},
+    {"abs_VL", Dump_Type::FLOAT32},
+    {"Prompt_I", Dump_Type::FLOAT32},
+    {"Prompt_Q", Dump_Type::FLOAT32},
+    {"PRN_start_sample_count", Dump_Type::UINT64},
+    {"acc_carrier_phase_rad", Dump_Type::FLOAT32},
+    {"carrier_doppler_hz", Dump_Type::FLOAT32},
+    {"carrier_doppler_rate_hz", Dump_Type::FLOAT32},
+    {"code_freq_chips", Dump_Type::FLOAT32},
+    {"code_freq_rate_chips", Dump_Type::FLOAT32},
+    {"carr_error_hz", Dump_Type::FLOAT32},
+    {"carr_error_filt_hz", Dump_Type::FLOAT32},
+    {"code_error_chips", Dump_Type::FLOAT32},
+    {"code_error_filt_chips", Dump_Type::FLOAT32},
+    {"CN0_SNV_dB_Hz", Dump_Type::FLOAT32},
+    {"carrier_lock_test", Dump_Type::FLOAT32},
+    {"aux1", Dump_Type::FLOAT32},
+    {"aux2", Dump_Type::FLOAT64},
+    {"PRN", Dump_Type::UINT32}};
+}  // namespace
+
+
 dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 {
     return dll_pll_veml_tracking_sptr(new dll_pll_veml_tracking(conf_));
@@ -81,7 +110,7 @@ dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 
 
 dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
-    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, item_type_size(conf_.item_type)),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
       d_trk_parameters(conf_),
       d_acquisition_gnss_synchro(nullptr),
@@ -512,6 +541,15 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
 
     d_multicorrelator_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps);
 
+    // cshort and cbyte samples are converted to gr_complex only for the
+    // samples read by each correlation step, so the stream between blocks
+    // keeps its smaller item size
+    if (d_trk_parameters.item_type != "gr_complex")
+        {
+            d_input_converter = make_vector_converter(d_trk_parameters.item_type, "gr_complex");
+            d_input_buffer = volk_gnsssdr::vector<gr_complex>(d_trk_parameters.vector_length);
+        }
+
     if (d_trk_parameters.extend_correlation_symbols > 1)
         {
             d_enable_extended_integration = true;
@@ -528,12 +566,15 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
             // Extra correlator for the data component
             d_correlator_data_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), 1);
             d_correlator_data_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+            // it runs right after the main correlator in the same thread, so
+            // it cannot be batched with the other channels
             d_data_code.resize(2 * d_code_length_chips, 0.0);
         }
 
     // --- Initializations ---
     d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
     d_multicorrelator_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+    d_multicorrelator_cpu.set_batch_engine(d_trk_parameters.batch_correlator);
 
     // CN0 estimation and lock detector buffers
     d_Prompt_buffer = volk_gnsssdr::vector<gr_complex>(d_trk_parameters.cn0_samples);
@@ -597,9 +638,17 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
                     std::cerr << "GNSS-SDR cannot create dump files for the tracking block. Wrong permissions?\n";
                     d_dump = false;
                 }
+            else
+                {
+                    d_dump_writer = std::make_unique<Gnss_Dump_Writer>(tracking_dump_schema,
+                        dump_format_from_string(d_trk_parameters.dump_format),
+                        d_trk_parameters.dump_compression);
+                    d_dump_writer->set_overflow_policy(dump_overflow_from_string(d_trk_parameters.dump_overflow));
+                }
         }
     d_last_timetag_samplecounter = 0;
     d_timetag_waiting = false;
+    d_counters = Block_Instrumentation::instance().register_block(this->name() + "_" + d_signal_type);
     set_tag_propagation_policy(TPP_DONT);  // no tag propagation, the time tag will be adjusted and regenerated in work()
 }
 
@@ -614,6 +663,17 @@ void dll_pll_veml_tracking::forecast(int noutput_items,
 }
 
 
+bool dll_pll_veml_tracking::stop()
+{
+    // Records still in the ring buffer reach the file before the flowgraph is reported as stopped
+    if (d_dump_writer)
+        {
+            d_dump_writer->flush();
+        }
+    return true;
+}
+
+
 void dll_pll_veml_tracking::msg_handler_telemetry_to_trk(const pmt::pmt_t &msg)
 {
     try
@@ -885,18 +945,18 @@ void dll_pll_veml_tracking::start_tracking()
 
 dll_pll_veml_tracking::~dll_pll_veml_tracking()
 {
-    if (d_dump_file.is_open())
+    if (d_dump_writer)
         {
             try
                 {
-                    d_dump_file.close();
+                    d_dump_writer->close();
                 }
             catch (const std::exception &ex)
                 {
                     LOG(WARNING) << "Exception in Tracking block destructor: " << ex.what();
                 }
         }
-    if (d_dump_mat)
+    if (d_dump_mat && d_dump_writer)
         {
             try
                 {
@@ -1034,8 +1094,15 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
 // - updated remnant code phase in samples (d_rem_code_phase_samples)
 // - d_code_freq_chips
 // - d_carrier_doppler_hz
-void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
+void dll_pll_veml_tracking::do_correlation_step(const void *input_items)
 {
+    const auto *input_samples = reinterpret_cast<const gr_complex *>(input_items);
+    if (d_input_converter)
+        {
+            d_input_converter(d_input_buffer.data(), input_items, d_trk_parameters.vector_length);
+            input_samples = d_input_buffer.data();
+        }
+
     // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
     // perform carrier wipe-off and compute Early, Prompt and Late correlation
     d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), input_samples);
@@ -1385,9 +1452,6 @@ void dll_pll_veml_tracking::log_data()
             float tmp_P;
             float tmp_L;
             float tmp_VL;
-            float tmp_float;
-            double tmp_double;
-            uint64_t tmp_long_int;
             if (d_trk_parameters.track_pilot)
                 {
                     prompt_I = d_Prompt_Data.data()->real();
@@ -1412,263 +1476,45 @@ void dll_pll_veml_tracking::log_data()
             tmp_P = std::abs<float>(d_P_accu);
             tmp_L = std::abs<float>(d_L_accu);
 
-            try
-                {
-                    // Dump correlators output
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VE), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_E), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_P), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_L), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VL), sizeof(float));
-                    // PROMPT I and Q (to analyze navigation symbols)
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
-                    // PRN start sample stamp
-                    tmp_long_int = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_long_int), sizeof(uint64_t));
-                    // accumulated carrier phase
-                    tmp_float = static_cast<float>(d_acc_carrier_phase_rad);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier and code frequency
-                    tmp_float = static_cast<float>(d_carrier_doppler_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier phase rate [Hz/s]
-                    tmp_float = static_cast<float>(d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_code_freq_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // code phase rate [chips/s^2]
-                    tmp_float = static_cast<float>(d_code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // PLL commands
-                    tmp_float = static_cast<float>(d_carr_phase_error_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_carr_error_filt_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // DLL commands
-                    tmp_float = static_cast<float>(d_code_error_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_code_error_filt_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // CN0 and carrier lock test
-                    tmp_float = static_cast<float>(d_CN0_SNV_dB_Hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_carrier_lock_test);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // AUX vars (for debug purposes)
-                    tmp_float = static_cast<float>(d_rem_code_phase_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_double = static_cast<double>(this->nitems_read(0) + d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    // PRN
-                    uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
-                    d_dump_file.write(reinterpret_cast<char *>(&prn_), sizeof(uint32_t));
-                }
-            catch (const std::ofstream::failure &e)
-                {
-                    LOG(WARNING) << "Exception writing trk dump file " << e.what();
-                }
+            Gnss_Dump_Record record(*d_dump_writer);
+            // Dump correlators output
+            record.add(tmp_VE).add(tmp_E).add(tmp_P).add(tmp_L).add(tmp_VL);
+            // PROMPT I and Q (to analyze navigation symbols)
+            record.add(prompt_I).add(prompt_Q);
+            // PRN start sample stamp
+            record.add(this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples));
+            // accumulated carrier phase
+            record.add(static_cast<float>(d_acc_carrier_phase_rad));
+            // carrier and code frequency
+            record.add(static_cast<float>(d_carrier_doppler_hz));
+            // carrier phase rate [Hz/s]
+            record.add(static_cast<float>(d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI));
+            record.add(static_cast<float>(d_code_freq_chips));
+            // code phase rate [chips/s^2]
+            record.add(static_cast<float>(d_code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in));
+            // PLL commands
+            record.add(static_cast<float>(d_carr_phase_error_hz)).add(static_cast<float>(d_carr_error_filt_hz));
+            // DLL commands
+            record.add(static_cast<float>(d_code_error_chips)).add(static_cast<float>(d_code_error_filt_chips));
+            // CN0 and carrier lock test
+            record.add(static_cast<float>(d_CN0_SNV_dB_Hz)).add(static_cast<float>(d_carrier_lock_test));
+            // AUX vars (for debug purposes)
+            record.add(static_cast<float>(d_rem_code_phase_samples));
+            record.add(static_cast<double>(this->nitems_read(0) + d_current_prn_length_samples));
+            // PRN
+            record.add(static_cast<uint32_t>(d_acquisition_gnss_synchro->PRN));
+            record.commit();
         }
 }
 
 
 int32_t dll_pll_veml_tracking::save_matfile() const
 {
-    // READ DUMP FILE
-    std::ifstream::pos_type size;
-    const int32_t number_of_double_vars = 1;
-    const int32_t number_of_float_vars = 19;
-    const int32_t epoch_size_bytes = sizeof(uint64_t) + sizeof(double) * number_of_double_vars +
-                                     sizeof(float) * number_of_float_vars + sizeof(uint32_t);
-    std::ifstream dump_file;
     std::string dump_filename_ = d_dump_filename;
     // add channel number to the filename
     dump_filename_.append(std::to_string(d_channel));
-    // add extension
-    dump_filename_.append(".dat");
-    std::cout << "Generating .mat file for " << dump_filename_ << '\n';
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-        {
-            dump_file.open(dump_filename_.c_str(), std::ios::binary | std::ios::ate);
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem opening dump file:" << e.what() << '\n';
-            return 1;
-        }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0;
-    if (dump_file.is_open())
-        {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
-        }
-    else
-        {
-            return 1;
-        }
-    auto abs_VE = std::vector<float>(num_epoch);
-    auto abs_E = std::vector<float>(num_epoch);
-    auto abs_P = std::vector<float>(num_epoch);
-    auto abs_L = std::vector<float>(num_epoch);
-    auto abs_VL = std::vector<float>(num_epoch);
-    auto Prompt_I = std::vector<float>(num_epoch);
-    auto Prompt_Q = std::vector<float>(num_epoch);
-    auto PRN_start_sample_count = std::vector<uint64_t>(num_epoch);
-    auto acc_carrier_phase_rad = std::vector<float>(num_epoch);
-    auto carrier_doppler_hz = std::vector<float>(num_epoch);
-    auto carrier_doppler_rate_hz = std::vector<float>(num_epoch);
-    auto code_freq_chips = std::vector<float>(num_epoch);
-    auto code_freq_rate_chips = std::vector<float>(num_epoch);
-    auto carr_error_hz = std::vector<float>(num_epoch);
-    auto carr_error_filt_hz = std::vector<float>(num_epoch);
-    auto code_error_chips = std::vector<float>(num_epoch);
-    auto code_error_filt_chips = std::vector<float>(num_epoch);
-    auto CN0_SNV_dB_Hz = std::vector<float>(num_epoch);
-    auto carrier_lock_test = std::vector<float>(num_epoch);
-    auto aux1 = std::vector<float>(num_epoch);
-    auto aux2 = std::vector<double>(num_epoch);
-    auto PRN = std::vector<uint32_t>(num_epoch);
-    try
-        {
-            if (dump_file.is_open())
-                {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            dump_file.read(reinterpret_cast<char *>(&abs_VE[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_E[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_P[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_L[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_VL[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_I[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_Q[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&PRN_start_sample_count[i]), sizeof(uint64_t));
-                            dump_file.read(reinterpret_cast<char *>(&acc_carrier_phase_rad[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_rate_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_rate_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_filt_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_filt_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&CN0_SNV_dB_Hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_lock_test[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux1[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux2[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&PRN[i]), sizeof(uint32_t));
-                        }
-                }
-            dump_file.close();
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem reading dump file:" << e.what() << '\n';
-            return 1;
-        }
-
-    // WRITE MAT FILE
-    mat_t *matfp;
-    matvar_t *matvar;
-    std::string filename = std::move(dump_filename_);
-    filename.erase(filename.length() - 4, 4);
-    filename.append(".mat");
-    matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
-    if (reinterpret_cast<int64_t *>(matfp) != nullptr)
-        {
-            std::array<size_t, 2> dims{1, static_cast<size_t>(num_epoch)};
-            matvar = Mat_VarCreate("abs_VE", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), abs_VE.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_E", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), abs_E.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_P", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), abs_P.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_L", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), abs_L.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("abs_VL", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), abs_VL.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Prompt_I", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), Prompt_I.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("Prompt_Q", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), Prompt_Q.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN_start_sample_count", MAT_C_UINT64, MAT_T_UINT64, 2, dims.data(), PRN_start_sample_count.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("acc_carrier_phase_rad", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), acc_carrier_phase_rad.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), carrier_doppler_hz.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_doppler_rate_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), carrier_doppler_rate_hz.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_freq_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), code_freq_chips.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_freq_rate_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), code_freq_rate_chips.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carr_error_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), carr_error_hz.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carr_error_filt_hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), carr_error_filt_hz.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_error_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), code_error_chips.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("code_error_filt_chips", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), code_error_filt_chips.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("CN0_SNV_dB_Hz", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), CN0_SNV_dB_Hz.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("carrier_lock_test", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), carrier_lock_test.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("aux1", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), aux1.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("aux2", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims.data(), aux2.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 2, dims.data(), PRN.data(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-        }
-    Mat_Close(matfp);
-    return 0;
+    return save_dump_matfile(dump_filename_ + ".dat", dump_filename_ + ".mat", tracking_dump_schema,
+        d_dump_writer->format());
 }
 
 
@@ -1676,6 +1522,7 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
 {
     gr::thread::scoped_lock l(d_setlock);
     d_channel = channel;
+    d_counters->set_channel(static_cast<int32_t>(channel));
     LOG(INFO) << "Tracking Channel set to " << d_channel;
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump)
@@ -1686,17 +1533,15 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
             // add extension
             dump_filename_.append(".dat");
 
-            if (!d_dump_file.is_open())
+            if (!d_dump_writer->is_open())
                 {
-                    try
+                    if (d_dump_writer->open(dump_filename_))
                         {
-                            d_dump_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-                            d_dump_file.open(dump_filename_.c_str(), std::ios::out | std::ios::binary);
                             LOG(INFO) << "Tracking dump enabled on channel " << d_channel << " Log file: " << dump_filename_.c_str();
                         }
-                    catch (const std::ofstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "channel " << d_channel << " Exception opening trk dump file " << e.what();
+                            LOG(WARNING) << "channel " << d_channel << " Error opening trk dump file " << dump_filename_;
                         }
                 }
         }
@@ -1729,7 +1574,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
     gr::thread::scoped_lock l(d_setlock);
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    Block_Work_Timer work_timer(d_counters.get(), ninput_items[0]);
+    const void *in = input_items[0];
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
     Gnss_Synchro current_synchro_data = Gnss_Synchro();
     current_synchro_data.Flag_valid_symbol_output = false;
@@ -1750,6 +1596,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
         case 0:  // Standby - Consume samples at full throttle, do nothing
             {
                 // d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
+                work_timer.set_items(ninput_items[0]);
                 consume_each(ninput_items[0]);
                 return 0;
                 break;
@@ -1783,6 +1630,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz
                            << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples;
 
+                work_timer.set_items(samples_offset);
                 consume_each(samples_offset);  // shift input to perform alignment with local replica
                 return 0;
             }
@@ -2058,6 +1906,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 }
         }
 
+    work_timer.set_items(d_current_prn_length_samples);
     consume_each(d_current_prn_length_samples);
     // d_sample_counter += static_cast<uint64_t>(d_current_prn_length_samples);
     if (current_synchro_data.Flag_valid_symbol_output || loss_of_lock)
@@ -18,11 +18,14 @@
 #ifndef GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 #define GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 
+#include "block_instrumentation.h"
 #include "cpu_multicorrelator_real_codes.h"
 #include "dll_pll_conf.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
 #include "gnss_time.h"                // for timetags produced by File_Timestamp_Signal_Source
+#include "item_type_helpers.h"        // for item_type_converter_t
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
 #include "tracking_loop_filter.h"     // for DLL filter
 #include <boost/circular_buffer.hpp>
@@ -33,7 +36,7 @@
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <cstddef>                            // for size_t
 #include <cstdint>                            // for int32_t
-#include <fstream>                            // for ofstream
+#include <memory>                             // for unique_ptr
 #include <string>                             // for string
 #include <typeinfo>                           // for typeid
 #include <utility>                            // for pair
@@ -70,12 +73,14 @@ public:
 
     void forecast(int noutput_items, gr_vector_int &ninput_items_required) override;
 
+    bool stop() override;
+
 private:
     friend dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_);
     explicit dll_pll_veml_tracking(const Dll_Pll_Conf &conf_);
 
     void msg_handler_telemetry_to_trk(const pmt::pmt_t &msg);
-    void do_correlation_step(const gr_complex *input_samples);
+    void do_correlation_step(const void *input_items);
     void run_dll_pll();
     void check_carrier_phase_coherent_initialization();
     void update_tracking_vars();
@@ -106,6 +111,9 @@ private:
     volk_gnsssdr::vector<gr_complex> d_correlator_outs;
     volk_gnsssdr::vector<gr_complex> d_Prompt_Data;
     volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;
+    volk_gnsssdr::vector<gr_complex> d_input_buffer;  // for cshort and cbyte inputs
+
+    item_type_converter_t d_input_converter;
 
     boost::circular_buffer<float> d_dll_filt_history;
     boost::circular_buffer<std::pair<double, double>> d_code_ph_history;
@@ -163,7 +171,8 @@ private:
     std::string d_signal_pretty_name;
     std::string d_dump_filename;
 
-    std::ofstream d_dump_file;
+    std::unique_ptr<Gnss_Dump_Writer> d_dump_writer;
+    std::shared_ptr<Block_Counters> d_counters;
 
     // uint64_t d_sample_counter;
     uint64_t d_acq_sample_stamp;
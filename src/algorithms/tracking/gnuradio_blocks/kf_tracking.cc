@@ -40,6 +40,7 @@
 #include "gps_l2c_signal_replica.h"
 #include "gps_l5_signal_replica.h"
 #include "gps_sdr_signal_replica.h"
+#include "kf_vtl.h"
 #include "lock_detectors.h"
 #include "tracking_discriminators.h"
 #include "trackingcmd.h"
@@ -129,7 +130,8 @@ kf_tracking::kf_tracking(const Kf_Conf &conf_)
       d_cloop(true),
       d_dump(d_trk_parameters.dump),
       d_dump_mat(d_trk_parameters.dump_mat && d_dump),
-      d_acc_carrier_phase_initialized(false)
+      d_acc_carrier_phase_initialized(false),
+      d_vtl_cmd_pending(false)
 {
 #if GNURADIO_GREATER_THAN_38
     this->set_relative_rate(1, static_cast<uint64_t>(d_trk_parameters.vector_length));
@@ -588,6 +590,7 @@ kf_tracking::kf_tracking(const Kf_Conf &conf_)
                     d_dump = false;
                 }
         }
+    d_counters = Block_Instrumentation::instance().register_block(this->name() + "_" + d_signal_type);
 }
 
 
@@ -630,8 +633,14 @@ void kf_tracking::msg_handler_pvt_to_trk(const pmt::pmt_t &msg)
             if (pmt::any_ref(msg).type().hash_code() == typeid(const std::shared_ptr<TrackingCmd>).hash_code())
                 {
                     const auto cmd = wht::any_cast<const std::shared_ptr<TrackingCmd>>(pmt::any_ref(msg));
-                    // std::cout << "RX pvt-to-trk cmd with delay: "
-                    //           << static_cast<double>(nitems_read(0) - cmd->sample_counter) / d_trk_parameters.fs_in << " [s]\n";
+                    gr::thread::scoped_lock lock(d_setlock);
+                    // PVT broadcasts the commands to all the channels, keep only ours
+                    if (cmd->channel_id == static_cast<int32_t>(d_channel) and d_state > 1 and
+                        d_acquisition_gnss_synchro != nullptr and cmd->PRN == d_acquisition_gnss_synchro->PRN)
+                        {
+                            d_vtl_cmd = *cmd;
+                            d_vtl_cmd_pending = true;
+                        }
                 }
             else
                 {
@@ -855,6 +864,7 @@ void kf_tracking::start_tracking()
     d_Prompt_circular_buffer.clear();
     d_corrected_doppler = false;
     d_acc_carrier_phase_initialized = false;
+    d_vtl_cmd_pending = false;
 }
 
 
@@ -1208,6 +1218,24 @@ void kf_tracking::run_Kf()
 }
 
 
+// Apply the carrier Doppler, Doppler rate and code frequency predicted by the
+// PVT block (Vector Tracking Loop) to the Kalman filter and the code NCO.
+void kf_tracking::run_vtl_update()
+{
+    d_vtl_cmd_pending = false;
+    if (kf_vtl_update(d_vtl_cmd, d_sample_counter, d_trk_parameters, d_code_chip_rate, d_signal_carrier_freq, d_x_old_old, d_P_old_old, d_code_freq_kf_chips_s))
+        {
+            d_carrier_doppler_kf_hz = d_x_old_old(2);
+            d_carrier_doppler_rate_kf_hz_s = d_x_old_old(3);
+        }
+    else
+        {
+            DLOG(INFO) << "VTL command discarded in channel " << d_channel << ": latency "
+                       << (static_cast<double>(d_sample_counter) - static_cast<double>(d_vtl_cmd.sample_counter)) / d_trk_parameters.fs_in << " [s]";
+        }
+}
+
+
 void kf_tracking::check_carrier_phase_coherent_initialization()
 {
     if (d_acc_carrier_phase_initialized == false)
@@ -1733,6 +1761,7 @@ void kf_tracking::set_channel(uint32_t channel)
 {
     gr::thread::scoped_lock l(d_setlock);
     d_channel = channel;
+    d_counters->set_channel(static_cast<int32_t>(channel));
     LOG(INFO) << "Tracking Channel set to " << d_channel;
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump)
@@ -1778,6 +1807,7 @@ int kf_tracking::general_work(int noutput_items __attribute__((unused)), gr_vect
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
     gr::thread::scoped_lock l(d_setlock);
+    Block_Work_Timer work_timer(d_counters.get(), ninput_items[0]);
     const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
     Gnss_Synchro current_synchro_data = Gnss_Synchro();
@@ -1797,6 +1827,7 @@ int kf_tracking::general_work(int noutput_items __attribute__((unused)), gr_vect
         case 0:  // Standby - Consume samples at full throttle, do nothing
             {
                 d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
+                work_timer.set_items(ninput_items[0]);
                 consume_each(ninput_items[0]);
                 return 0;
                 break;
@@ -1831,6 +1862,7 @@ int kf_tracking::general_work(int noutput_items __attribute__((unused)), gr_vect
                 DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_kf_hz
                            << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples;
 
+                work_timer.set_items(samples_offset);
                 consume_each(samples_offset);  // shift input to perform alignment with local replica
                 return 0;
             }
@@ -1871,6 +1903,10 @@ int kf_tracking::general_work(int noutput_items __attribute__((unused)), gr_vect
                         bool next_state = false;
                         // Perform DLL/PLL tracking loop computations. Costas Loop enabled
                         run_Kf();
+                        if (d_vtl_cmd_pending and !d_pull_in_transitory)
+                            {
+                                run_vtl_update();
+                            }
                         update_tracking_vars();
 
                         // enable write dump file this cycle (valid DLL/PLL cycle)
@@ -2028,6 +2064,10 @@ int kf_tracking::general_work(int noutput_items __attribute__((unused)), gr_vect
                     {
                         update_kf_cn0(d_CN0_SNV_dB_Hz);
                         run_Kf();
+                        if (d_vtl_cmd_pending)
+                            {
+                                run_vtl_update();
+                            }
                         update_tracking_vars();
                         check_carrier_phase_coherent_initialization();
                         if (d_current_data_symbol == 0)
@@ -2069,6 +2109,7 @@ int kf_tracking::general_work(int noutput_items __attribute__((unused)), gr_vect
                     }
             }
         }
+    work_timer.set_items(d_current_prn_length_samples);
     consume_each(d_current_prn_length_samples);
     d_sample_counter += static_cast<uint64_t>(d_current_prn_length_samples);
     if (current_synchro_data.Flag_valid_symbol_output)
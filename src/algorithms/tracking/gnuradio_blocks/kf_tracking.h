@@ -25,6 +25,7 @@
 #define ARMA_NO_DEBUG 1
 #endif
 
+#include "block_instrumentation.h"
 #include "cpu_multicorrelator_real_codes.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
@@ -32,6 +33,7 @@
 #include "kf_conf.h"
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
 #include "tracking_loop_filter.h"     // for DLL filter
+#include "trackingcmd.h"
 #include <armadillo>
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>                   // for block
@@ -80,6 +82,7 @@ private:
     void update_kf_narrow_integration_time();
     void update_kf_cn0(double current_cn0_dbhz);
     void run_Kf();
+    void run_vtl_update();
 
     void msg_handler_telemetry_to_trk(const pmt::pmt_t &msg);
     void msg_handler_pvt_to_trk(const pmt::pmt_t &msg);
@@ -99,6 +102,8 @@ private:
 
     Kf_Conf d_trk_parameters;
 
+    TrackingCmd d_vtl_cmd;  // last Vector Tracking Loop command received from PVT
+
     Exponential_Smoother d_cn0_smoother;
     Exponential_Smoother d_carrier_lock_test_smoother;
 
@@ -137,6 +142,7 @@ private:
     std::string d_dump_filename;
 
     std::ofstream d_dump_file;
+    std::shared_ptr<Block_Counters> d_counters;
 
     gr_complex *d_Very_Early;
     gr_complex *d_Early;
@@ -231,6 +237,7 @@ private:
     bool d_dump_mat;
     bool d_acc_carrier_phase_initialized;
     bool d_enable_extended_integration;
+    bool d_vtl_cmd_pending;
 };
 
 #endif  // GNSS_SDR_KF_TRACKING_H
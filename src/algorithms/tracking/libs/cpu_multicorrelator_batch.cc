@@ -0,0 +1,207 @@
+/*!
+ * \file cpu_multicorrelator_batch.cc
+ * \brief Shared multi-channel correlator engine that evaluates the carrier
+ * wipe-off and correlators of several tracking channels in a single,
+ * cache-resident pass over their input samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_batch.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+namespace
+{
+// channels that did not submit a job for this long are not waited for
+constexpr std::chrono::milliseconds IDLE_CHANNEL_TIMEOUT(10);
+}  // namespace
+
+
+Cpu_Multicorrelator_Batch::Cpu_Multicorrelator_Batch()
+    : d_gather_timeout(50),
+      d_executed_batches(0),
+      d_executed_jobs(0),
+      d_tile_length_samples(1024),
+      d_executing(false)
+{
+}
+
+
+Cpu_Multicorrelator_Batch& Cpu_Multicorrelator_Batch::get_instance()
+{
+    static Cpu_Multicorrelator_Batch instance;
+    return instance;
+}
+
+
+void Cpu_Multicorrelator_Batch::set_gather_timeout(std::chrono::microseconds gather_timeout)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_gather_timeout = std::max(std::chrono::microseconds(0), gather_timeout);
+}
+
+
+void Cpu_Multicorrelator_Batch::set_tile_length(int tile_length_samples)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_tile_length_samples = std::max(64, tile_length_samples);
+}
+
+
+uint64_t Cpu_Multicorrelator_Batch::executed_batches() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_executed_batches;
+}
+
+
+uint64_t Cpu_Multicorrelator_Batch::executed_jobs() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_executed_jobs;
+}
+
+
+size_t Cpu_Multicorrelator_Batch::active_channels(Clock::time_point now)
+{
+    for (auto it = d_last_submission.begin(); it != d_last_submission.end();)
+        {
+            if (now - it->second > IDLE_CHANNEL_TIMEOUT)
+                {
+                    it = d_last_submission.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+    return d_last_submission.size();
+}
+
+
+void Cpu_Multicorrelator_Batch::correlate(Multicorrelator_Batch_Job* job)
+{
+    thread_local std::vector<Multicorrelator_Batch_Job*> batch;
+    std::unique_lock<std::mutex> lock(d_mutex);
+    const Clock::time_point now = Clock::now();
+    d_last_submission[job] = now;
+    job->done = false;
+    d_pending_jobs.push_back(job);
+    if (d_pending_jobs.size() == 1)
+        {
+            d_gather_deadline = now + d_gather_timeout;
+        }
+    // the channels waiting for this batch may now have all the jobs
+    d_cv.notify_all();
+    while (!job->done)
+        {
+            if (d_executing)
+                {
+                    d_cv.wait(lock);
+                    continue;
+                }
+            const Clock::time_point current = Clock::now();
+            if (d_pending_jobs.size() < active_channels(current) and current < d_gather_deadline)
+                {
+                    d_cv.wait_until(lock, d_gather_deadline);
+                    continue;
+                }
+            // become the executor: take all the pending jobs, including
+            // the ones submitted by other channels in the meantime
+            d_executing = true;
+            batch.clear();
+            batch.swap(d_pending_jobs);
+            const int tile_length_samples = d_tile_length_samples;
+            lock.unlock();
+            execute(batch, tile_length_samples);
+            lock.lock();
+            for (auto* batch_job : batch)
+                {
+                    batch_job->done = true;
+                }
+            d_executed_batches++;
+            d_executed_jobs += batch.size();
+            d_executing = false;
+            if (!d_pending_jobs.empty())
+                {
+                    d_gather_deadline = Clock::now() + d_gather_timeout;
+                }
+            d_cv.notify_all();
+        }
+}
+
+
+void Cpu_Multicorrelator_Batch::execute(std::vector<Multicorrelator_Batch_Job*>& jobs, int tile_length_samples)
+{
+    const std::less<const std::complex<float>*> before;
+    std::sort(jobs.begin(), jobs.end(), [&before](const Multicorrelator_Batch_Job* a, const Multicorrelator_Batch_Job* b) { return before(a->sig_in, b->sig_in); });
+    for (auto* job : jobs)
+        {
+            std::fill_n(job->corr_out, job->n_correlators, std::complex<float>(0.0, 0.0));
+        }
+
+    size_t first = 0;
+    while (first < jobs.size())
+        {
+            // group the jobs whose input samples overlap
+            const std::complex<float>* base = jobs[first]->sig_in;
+            const std::complex<float>* group_end = base + jobs[first]->signal_length_samples;
+            size_t last = first + 1;
+            while (last < jobs.size() and before(jobs[last]->sig_in, group_end))
+                {
+                    const std::complex<float>* job_end = jobs[last]->sig_in + jobs[last]->signal_length_samples;
+                    if (before(group_end, job_end))
+                        {
+                            group_end = job_end;
+                        }
+                    last++;
+                }
+
+            // sweep the group in tiles, so each tile of input samples is
+            // brought to the cache once and used by all the channels
+            const std::ptrdiff_t group_length = group_end - base;
+            for (std::ptrdiff_t tile_start = 0; tile_start < group_length; tile_start += tile_length_samples)
+                {
+                    const std::ptrdiff_t tile_end = std::min<std::ptrdiff_t>(tile_start + tile_length_samples, group_length);
+                    for (size_t j = first; j < last; j++)
+                        {
+                            Multicorrelator_Batch_Job* job = jobs[j];
+                            const std::ptrdiff_t job_start = job->sig_in - base;
+                            const std::ptrdiff_t start = std::max(tile_start, job_start);
+                            const std::ptrdiff_t end = std::min(tile_end, job_start + job->signal_length_samples);
+                            if (start >= end)
+                                {
+                                    continue;
+                                }
+                            const std::ptrdiff_t offset = start - job_start;
+                            for (int n = 0; n < job->n_correlators; n++)
+                                {
+                                    job->local_codes_tile[n] = job->local_codes[n] + offset;
+                                }
+                            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(job->corr_out_tile,
+                                job->sig_in + offset,
+                                job->phase_step,
+                                &job->phase,
+                                job->local_codes_tile,
+                                job->n_correlators,
+                                static_cast<unsigned int>(end - start));
+                            for (int n = 0; n < job->n_correlators; n++)
+                                {
+                                    job->corr_out[n] += job->corr_out_tile[n];
+                                }
+                        }
+                }
+            first = last;
+        }
+}
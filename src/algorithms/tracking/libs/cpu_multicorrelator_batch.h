@@ -0,0 +1,120 @@
+/*!
+ * \file cpu_multicorrelator_batch.h
+ * \brief Shared multi-channel correlator engine that evaluates the carrier
+ * wipe-off and correlators of several tracking channels in a single,
+ * cache-resident pass over their input samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CPU_MULTICORRELATOR_BATCH_H
+#define GNSS_SDR_CPU_MULTICORRELATOR_BATCH_H
+
+#include <chrono>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Correlation request of a tracking channel for one integration period.
+ *
+ * local_codes holds the already resampled local code of each tap.
+ * phase is the initial carrier phasor, and it is updated with the final
+ * phasor once the job is executed. The scratch pointers are owned by the
+ * caller and must hold n_correlators elements.
+ */
+struct Multicorrelator_Batch_Job
+{
+    const std::complex<float>* sig_in{nullptr};
+    std::complex<float>* corr_out{nullptr};
+    const float* const* local_codes{nullptr};
+    const float** local_codes_tile{nullptr};    // scratch
+    std::complex<float>* corr_out_tile{nullptr};  // scratch
+    std::complex<float> phase_step{1.0, 0.0};
+    std::complex<float> phase{1.0, 0.0};
+    int n_correlators{0};
+    int signal_length_samples{0};
+    bool done{false};
+};
+
+
+/*!
+ * \brief Process-wide correlator engine shared by the tracking channels.
+ *
+ * The channels submit their jobs with correlate(). The jobs of an integration
+ * period are gathered until every active channel (one that submitted a job
+ * in the last few milliseconds) has submitted its own, or until the gather
+ * timeout expires, and then a single executor evaluates them together with
+ * execute(). It sweeps their (usually overlapping) input buffers in tiles of
+ * tile_length samples, so each tile of input samples is read from memory
+ * once and reused from the cache by all the channels. Each tile is processed
+ * with the volk_gnsssdr rotator dot product kernels.
+ */
+class Cpu_Multicorrelator_Batch
+{
+public:
+    static Cpu_Multicorrelator_Batch& get_instance();
+
+    /*!
+     * \brief Submits a job and blocks until it has been executed, either by
+     * the calling thread or as part of a batch run by another channel.
+     * The job object identifies the channel, so each channel must reuse
+     * the same one.
+     */
+    void correlate(Multicorrelator_Batch_Job* job);
+
+    /*!
+     * \brief Maximum time the first job of a batch waits for the jobs of the
+     * other active channels.
+     */
+    void set_gather_timeout(std::chrono::microseconds gather_timeout);
+
+    void set_tile_length(int tile_length_samples);
+
+    uint64_t executed_batches() const;
+    uint64_t executed_jobs() const;
+
+    /*!
+     * \brief Evaluates all the jobs in the calling thread.
+     */
+    static void execute(std::vector<Multicorrelator_Batch_Job*>& jobs, int tile_length_samples);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Cpu_Multicorrelator_Batch();
+    size_t active_channels(Clock::time_point now);
+
+    std::vector<Multicorrelator_Batch_Job*> d_pending_jobs;
+    std::map<const Multicorrelator_Batch_Job*, Clock::time_point> d_last_submission;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cv;
+    Clock::time_point d_gather_deadline;
+    std::chrono::microseconds d_gather_timeout;
+    uint64_t d_executed_batches;
+    uint64_t d_executed_jobs;
+    int d_tile_length_samples;
+    bool d_executing;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CPU_MULTICORRELATOR_BATCH_H
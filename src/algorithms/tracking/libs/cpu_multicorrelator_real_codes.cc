@@ -46,6 +46,8 @@ bool Cpu_Multicorrelator_Real_Codes::init(
             d_local_codes_resampled[n] = static_cast<float*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
         }
     d_n_correlators = n_correlators;
+    d_batch_local_codes_tile.resize(n_correlators);
+    d_batch_corr_out_tile.resize(n_correlators);
     return true;
 }
 
@@ -113,6 +115,11 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
+    if (d_use_batch_engine and phase_rate_step_rad == 0.0)
+        {
+            run_batch_engine(phase_offset_as_complex[0], phase_step_rad, signal_length_samples);
+            return true;
+        }
     // call VOLK_GNSSSDR kernel
     if (d_use_high_dynamics_resampler)
         {
@@ -138,12 +145,32 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
+    if (d_use_batch_engine)
+        {
+            run_batch_engine(phase_offset_as_complex[0], phase_step_rad, signal_length_samples);
+            return true;
+        }
     // call VOLK_GNSSSDR kernel
     volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
     return true;
 }
 
 
+void Cpu_Multicorrelator_Real_Codes::run_batch_engine(const std::complex<float>& phase_offset, float phase_step_rad, int signal_length_samples)
+{
+    d_batch_job.sig_in = d_sig_in;
+    d_batch_job.corr_out = d_corr_out;
+    d_batch_job.local_codes = d_local_codes_resampled;
+    d_batch_job.local_codes_tile = d_batch_local_codes_tile.data();
+    d_batch_job.corr_out_tile = d_batch_corr_out_tile.data();
+    d_batch_job.phase_step = std::exp(lv_32fc_t(0.0, -phase_step_rad));
+    d_batch_job.phase = phase_offset;
+    d_batch_job.n_correlators = d_n_correlators;
+    d_batch_job.signal_length_samples = signal_length_samples;
+    Cpu_Multicorrelator_Batch::get_instance().correlate(&d_batch_job);
+}
+
+
 bool Cpu_Multicorrelator_Real_Codes::free()
 {
     // Free memory
@@ -165,3 +192,9 @@ void Cpu_Multicorrelator_Real_Codes::set_high_dynamics_resampler(
 {
     d_use_high_dynamics_resampler = use_high_dynamics_resampler;
 }
+
+
+void Cpu_Multicorrelator_Real_Codes::set_batch_engine(bool use_batch_engine)
+{
+    d_use_batch_engine = use_batch_engine;
+}
@@ -23,7 +23,9 @@
 #define GNSS_SDR_CPU_MULTICORRELATOR_REAL_CODES_H
 
 
+#include "cpu_multicorrelator_batch.h"
 #include <complex>
+#include <vector>
 
 /** \addtogroup Tracking
  * \{ */
@@ -39,6 +41,7 @@ class Cpu_Multicorrelator_Real_Codes
 public:
     Cpu_Multicorrelator_Real_Codes() = default;
     void set_high_dynamics_resampler(bool use_high_dynamics_resampler);
+    void set_batch_engine(bool use_batch_engine);
     ~Cpu_Multicorrelator_Real_Codes();
     bool init(int max_signal_length_samples, int n_correlators);
     bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
@@ -49,6 +52,8 @@ public:
     bool free();
 
 private:
+    void run_batch_engine(const std::complex<float> &phase_offset, float phase_step_rad, int signal_length_samples);
+
     // Allocate the device input vectors
     const std::complex<float> *d_sig_in{nullptr};
     const float *d_local_code_in{nullptr};
@@ -58,6 +63,12 @@ private:
     int d_code_length_chips{0};
     int d_n_correlators{0};
     bool d_use_high_dynamics_resampler{true};
+
+    // Shared multi-channel correlator engine (see cpu_multicorrelator_batch.h)
+    Multicorrelator_Batch_Job d_batch_job{};
+    std::vector<const float *> d_batch_local_codes_tile;
+    std::vector<std::complex<float>> d_batch_corr_out_tile;
+    bool d_use_batch_engine{false};
 };
 
 
@@ -46,9 +46,13 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     double fs_in_deprecated = configuration->property("GNSS-SDR.internal_fs_hz", fs_in);
     fs_in = configuration->property("GNSS-SDR.internal_fs_sps", fs_in_deprecated);
     high_dyn = configuration->property(role + ".high_dyn", high_dyn);
+    batch_correlator = configuration->property(role + ".batch_correlator", batch_correlator);
     dump = configuration->property(role + ".dump", dump);
     dump_filename = configuration->property(role + ".dump_filename", dump_filename);
     dump_mat = configuration->property(role + ".dump_mat", dump_mat);
+    dump_format = configuration->property(role + ".dump_format", dump_format);
+    dump_overflow = configuration->property(role + ".dump_overflow", dump_overflow);
+    dump_compression = configuration->property(role + ".dump_compression", dump_compression);
     pll_bw_hz = configuration->property(role + ".pll_bw_hz", pll_bw_hz);
     if (FLAGS_pll_bw_hz != 0.0)
         {
@@ -38,6 +38,8 @@ public:
     /* DLL/PLL tracking configuration */
     std::string item_type{"gr_complex"};
     std::string dump_filename{"./dll_pll_dump.dat"};
+    std::string dump_format{"binary"};
+    std::string dump_overflow{"block"};
     double fs_in{2000000.0};
     double carrier_lock_th{0.0};
     float pll_pull_in_bw_hz{50.0};
@@ -78,8 +80,10 @@ public:
     bool enable_doppler_correction{false};
     bool carrier_aiding{true};
     bool high_dyn{false};
+    bool batch_correlator{false};
     bool dump{false};
     bool dump_mat{true};
+    bool dump_compression{false};
 };
 
 
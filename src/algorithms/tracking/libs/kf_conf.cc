@@ -38,6 +38,9 @@ Kf_Conf::Kf_Conf() : item_type("gr_complex"),
                      init_carrier_phase_sd_rad(0.7),
                      init_carrier_freq_sd_hz(5),
                      init_carrier_freq_rate_sd_hz_s(1),
+                     vtl_doppler_sd_hz(2.0),
+                     vtl_doppler_rate_sd_hz_s(1.0),
+                     vtl_max_latency_s(2.0),
                      early_late_space_chips(0.25),
                      very_early_late_space_chips(0.5),
                      early_late_space_narrow_chips(0.15),
@@ -131,4 +134,9 @@ void Kf_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     init_carrier_phase_sd_rad = configuration->property(role + ".init_carrier_phase_sd_rad", init_carrier_phase_sd_rad);
     init_carrier_freq_sd_hz = configuration->property(role + ".init_carrier_freq_sd_hz", init_carrier_freq_sd_hz);
     init_carrier_freq_rate_sd_hz_s = configuration->property(role + ".init_carrier_freq_rate_sd_hz_s", init_carrier_freq_rate_sd_hz_s);
+
+    // Vector Tracking Loop (VTL) aiding from the PVT block
+    vtl_doppler_sd_hz = configuration->property(role + ".vtl_doppler_sd_hz", vtl_doppler_sd_hz);
+    vtl_doppler_rate_sd_hz_s = configuration->property(role + ".vtl_doppler_rate_sd_hz_s", vtl_doppler_rate_sd_hz_s);
+    vtl_max_latency_s = configuration->property(role + ".vtl_max_latency_s", vtl_max_latency_s);
 }
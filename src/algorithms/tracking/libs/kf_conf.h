@@ -54,6 +54,11 @@ public:
     double init_carrier_freq_sd_hz;
     double init_carrier_freq_rate_sd_hz_s;
 
+    // Vector Tracking Loop (VTL) aiding measurement covariances and latency limit
+    double vtl_doppler_sd_hz;
+    double vtl_doppler_rate_sd_hz_s;
+    double vtl_max_latency_s;
+
     float early_late_space_chips;
     float very_early_late_space_chips;
     float early_late_space_narrow_chips;
@@ -0,0 +1,71 @@
+/*!
+ * \file kf_vtl.cc
+ * \brief Vector Tracking Loop (VTL) aiding of the Kalman filter based
+ * tracking loop with the predictions of the PVT block.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "kf_vtl.h"
+#include <cmath>
+
+
+bool kf_vtl_update(const TrackingCmd& cmd,
+    uint64_t sample_counter,
+    const Kf_Conf& conf,
+    double code_chip_rate_cps,
+    double signal_carrier_freq_hz,
+    arma::vec& x,
+    arma::mat& P,
+    double& code_freq_chips_s)
+{
+    if (!cmd.enable_carrier_nco_cmd and !cmd.enable_code_nco_cmd)
+        {
+            return false;
+        }
+    // commands that arrive late are propagated to the current sample
+    const double latency_s = (static_cast<double>(sample_counter) - static_cast<double>(cmd.sample_counter)) / conf.fs_in;
+    if (std::abs(latency_s) > conf.vtl_max_latency_s)
+        {
+            return false;
+        }
+
+    if (cmd.enable_carrier_nco_cmd)
+        {
+            const double predicted_doppler_hz = cmd.carrier_freq_hz + cmd.carrier_freq_rate_hz_s * latency_s;
+            const double predicted_doppler_rate_hz_s = cmd.carrier_freq_rate_hz_s;
+
+            // the predicted Doppler and Doppler rate are observations of the
+            // last two states, and the propagation error grows with the latency
+            const arma::mat H_vtl = {{0.0, 0.0, 1.0, 0.0},
+                {0.0, 0.0, 0.0, 1.0}};
+            const double sigma2_doppler = std::pow(conf.vtl_doppler_sd_hz, 2.0) + std::pow(conf.vtl_doppler_rate_sd_hz_s * latency_s, 2.0);
+            const arma::mat R_vtl = {{sigma2_doppler, 0.0},
+                {0.0, std::pow(conf.vtl_doppler_rate_sd_hz_s, 2.0)}};
+
+            const arma::vec z = {predicted_doppler_hz - x(2), predicted_doppler_rate_hz_s - x(3)};
+            const arma::mat K = P * H_vtl.t() * arma::inv(H_vtl * P * H_vtl.t() + R_vtl);
+
+            x = x + K * z;
+            P = (arma::eye(4, 4) - K * H_vtl) * P;
+        }
+
+    if (cmd.enable_code_nco_cmd)
+        {
+            // the code Doppler changes with the carrier Doppler rate during the latency
+            code_freq_chips_s = cmd.code_freq_chips + cmd.carrier_freq_rate_hz_s * latency_s * code_chip_rate_cps / signal_carrier_freq_hz;
+        }
+    else
+        {
+            code_freq_chips_s = code_chip_rate_cps + x(2) * code_chip_rate_cps / signal_carrier_freq_hz;
+        }
+    return true;
+}
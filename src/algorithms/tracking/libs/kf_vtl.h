@@ -0,0 +1,61 @@
+/*!
+ * \file kf_vtl.h
+ * \brief Vector Tracking Loop (VTL) aiding of the Kalman filter based
+ * tracking loop with the predictions of the PVT block.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_KF_VTL_H
+#define GNSS_SDR_KF_VTL_H
+
+#if ARMA_NO_BOUND_CHECKING
+#define ARMA_NO_DEBUG 1
+#endif
+
+#include "kf_conf.h"
+#include "trackingcmd.h"
+#include <armadillo>
+#include <cstdint>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Applies a VTL command to the state x = {code phase [chips], carrier
+ * phase [rad], carrier Doppler [Hz], carrier Doppler rate [Hz/s]} and the
+ * covariance P of the kf_tracking Kalman filter, and to its code NCO.
+ *
+ * The predictions are propagated from cmd.sample_counter to sample_counter.
+ * If cmd.enable_carrier_nco_cmd is set, the predicted carrier Doppler and
+ * Doppler rate are fused as an additional measurement of the filter. If
+ * cmd.enable_code_nco_cmd is set, code_freq_chips_s is set to the predicted
+ * code frequency; otherwise it follows the updated carrier Doppler.
+ *
+ * Returns false, leaving all the outputs unchanged, if the command is
+ * further than conf.vtl_max_latency_s from sample_counter or steers nothing.
+ */
+bool kf_vtl_update(const TrackingCmd& cmd,
+    uint64_t sample_counter,
+    const Kf_Conf& conf,
+    double code_chip_rate_cps,
+    double signal_carrier_freq_hz,
+    arma::vec& x,
+    arma::mat& P,
+    double& code_freq_chips_s);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_KF_VTL_H
@@ -25,7 +25,7 @@
 #include "reed_solomon.h"           // for ReedSolomon
 #include <glog/logging.h>           // for DLOG
 #include <gnuradio/io_signature.h>  // for gr::io_signature::make
-#include <algorithm>                // for std::find, std::count
+#include <algorithm>                // for std::find, std::count, std::sort
 #include <cmath>                    // for std::remainder
 #include <cstddef>                  // for size_t
 #include <iterator>                 // for std::back_inserter
@@ -300,28 +300,23 @@ void galileo_e6_has_msg_receiver::delete_outdated_data(const Galileo_HAS_page& h
 int galileo_e6_has_msg_receiver::decode_message_type1(uint8_t message_id, uint8_t message_size)
 {
     DLOG(INFO) << "Start decoding of a HAS message";
-    constexpr int32_t max_erasure_positions = GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK - GALILEO_CNAV_INFORMATION_VECTOR_LENGTH;  // 223 Maximum erasure positions ( = number of parity symbols in a block)
 
-    // Compute erasure positions
-    std::vector<int> erasure_positions;
-    erasure_positions.reserve(max_erasure_positions);
-
-    for (uint8_t i = 1; i < message_size + 1; i++)  // we know that from message_size to 32, the value is 0
-        {
-            if (std::find(d_received_pids[message_id].begin(), d_received_pids[message_id].end(), i) == d_received_pids[message_id].end())
-                {
-                    erasure_positions.push_back(i - 1);
-                }
-        }
-    for (int i = GALILEO_CNAV_INFORMATION_VECTOR_LENGTH + 1; i < GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK + 1; i++)  // from 33 to 255
+    // The pages are protected by a CRC, so the missing ones are erasures.
+    // The received PIDs from message_size + 1 to 32 would carry information
+    // symbols that are known to be 0, so they are not enough to decode.
+    std::vector<int> received_positions;
+    received_positions.reserve(d_received_pids[message_id].size());
+    bool decodable = true;
+    for (auto pid : d_received_pids[message_id])
         {
-            if (std::find(d_received_pids[message_id].begin(), d_received_pids[message_id].end(), static_cast<uint8_t>(i)) == d_received_pids[message_id].end())
+            if (pid == 0 || (pid > message_size && pid <= GALILEO_CNAV_INFORMATION_VECTOR_LENGTH))
                 {
-                    erasure_positions.push_back(i - 1);
+                    decodable = false;
                 }
+            received_positions.push_back(pid - 1);
         }
 
-    if (erasure_positions.size() > static_cast<size_t>(max_erasure_positions))
+    if (!decodable)
         {
             // This should not happen! Maybe message_size < PID < 33 ?
             // Don't even try to decode
@@ -339,39 +334,23 @@ int galileo_e6_has_msg_receiver::decode_message_type1(uint8_t message_id, uint8_
             return -1;
         }
 
+    // Sorted, so the same set of PIDs reuses the cached inverse matrix
+    std::sort(received_positions.begin(), received_positions.end());
+
     DLOG(INFO) << debug_print_vector("List of received PIDs", d_received_pids[message_id]);
-    DLOG(INFO) << debug_print_vector("erasure_positions", erasure_positions);
     DLOG(INFO) << debug_print_matrix("C_matrix", d_C_matrix[message_id]);
 
     // Reset HAS decoded message matrix
     d_M_matrix = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));
 
-    // Vertical decoding of d_C_matrix
-    for (int col = 0; col < GALILEO_CNAV_OCTETS_IN_SUBPAGE; col++)
+    // Vertical decoding of d_C_matrix: all the columns share the erasure
+    // pattern, so they are decoded at once
+    if (d_rs->decode_with_generator_matrix(received_positions, d_C_matrix[message_id], d_M_matrix) < 0)
         {
-            std::vector<uint8_t> C_column(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK);
-            for (auto pid : d_received_pids[message_id])
-                {
-                    C_column[pid - 1] = d_C_matrix[message_id][pid - 1][col];
-                }
-
-            int result = d_rs->decode(C_column, erasure_positions);
-
-            if (result < 0)
-                {
-                    DLOG(ERROR) << "Decoding of HAS page failed";
-                    return -1;
-                }
-
-            std::vector<uint8_t> M_column(C_column.begin(), C_column.begin() + GALILEO_CNAV_INFORMATION_VECTOR_LENGTH);
-            for (int i = 0; i < GALILEO_CNAV_INFORMATION_VECTOR_LENGTH; i++)
-                {
-                    d_M_matrix[i][col] = M_column[i];
-                }
-
-            DLOG(INFO) << debug_print_vector("C_column entering the decoder", C_column);
-            DLOG(INFO) << "Successful HAS page decoding";
+            DLOG(ERROR) << "Decoding of HAS page failed";
+            return -1;
         }
+    DLOG(INFO) << "Successful HAS page decoding";
 
     DLOG(INFO) << debug_print_matrix("M_matrix", d_M_matrix);
 
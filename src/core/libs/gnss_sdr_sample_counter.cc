@@ -18,10 +18,12 @@
 #include "gnss_sdr_sample_counter.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"
+#include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <pmt/pmt.h>        // for from_double
 #include <pmt/pmt_sugar.h>  // for mp
-#include <cmath>            // for round
+#include <chrono>
+#include <cmath>  // for round
 #include <iostream>         // for operator<<
 #include <memory>
 #include <string>  // for string
@@ -43,7 +45,13 @@ gnss_sdr_sample_counter::gnss_sdr_sample_counter(
           gr::io_signature::make(1, 1, _size),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
           static_cast<uint32_t>(std::round(_fs * static_cast<double>(_interval_ms) / 1e3))),
+      counters(Block_Instrumentation::instance().register_block("sample_counter")),
+      first_work_time_ns(-1),
+      samples_received(0),
+      samples_dropped(0),
       fs(_fs),
+      last_rx_time(0.0),
+      last_rx_time_offset(0),
       current_T_rx_ms(0),
       sample_counter(0),
       interval_ms(_interval_ms),
@@ -56,7 +64,8 @@ gnss_sdr_sample_counter::gnss_sdr_sample_counter(
       flag_m(false),
       flag_h(false),
       flag_days(false),
-      flag_enable_send_msg(false)  // enable it for reporting time with asynchronous message
+      flag_enable_send_msg(false),  // enable it for reporting time with asynchronous message
+      flag_rx_time(false)
 {
     message_port_register_out(pmt::mp("sample_counter"));
     set_max_noutput_items(1);
@@ -79,10 +88,60 @@ int64_t gnss_sdr_sample_counter::uint64diff(uint64_t first, uint64_t second)
 }
 
 
+/*
+ * Signal sources such as UHD tag the first sample of the stream, and the first
+ * sample after an overflow, with its time of arrival as measured by the front
+ * end ("rx_time"). Samples have been lost if that time is ahead of the time of
+ * the previous tag plus the number of samples since then.
+ */
+void gnss_sdr_sample_counter::check_rx_time_tags()
+{
+    std::vector<gr::tag_t> tags_vec;
+    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + samples_per_output, pmt::mp("rx_time"));
+    for (const auto &it : tags_vec)
+        {
+            if (!pmt::is_tuple(it.value) || pmt::length(it.value) != 2)
+                {
+                    continue;
+                }
+            const double rx_time = static_cast<double>(pmt::to_uint64(pmt::tuple_ref(it.value, 0))) + pmt::to_double(pmt::tuple_ref(it.value, 1));
+            if (flag_rx_time)
+                {
+                    const double expected_rx_time = last_rx_time + static_cast<double>(it.offset - last_rx_time_offset) / fs;
+                    const double lost_samples = std::round((rx_time - expected_rx_time) * fs);
+                    if (lost_samples > 0.0)
+                        {
+                            samples_dropped.fetch_add(static_cast<uint64_t>(lost_samples), std::memory_order_relaxed);
+                            counters->record_dropped_samples(static_cast<uint64_t>(lost_samples));
+                            LOG(WARNING) << "The signal source dropped " << lost_samples << " samples before sample " << it.offset;
+                        }
+                }
+            last_rx_time = rx_time;
+            last_rx_time_offset = it.offset;
+            flag_rx_time = true;
+        }
+}
+
+
+double gnss_sdr_sample_counter::real_time_lag_s() const
+{
+    const int64_t first_ns = first_work_time_ns.load(std::memory_order_relaxed);
+    if (first_ns < 0)
+        {
+            return 0.0;
+        }
+    const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    const double samples = static_cast<double>(samples_received.load(std::memory_order_relaxed) + samples_dropped.load(std::memory_order_relaxed));
+    return static_cast<double>(now_ns - first_ns) * 1e-9 - samples / fs;
+}
+
+
 int gnss_sdr_sample_counter::work(int noutput_items __attribute__((unused)),
     gr_vector_const_void_star &input_items __attribute__((unused)),
     gr_vector_void_star &output_items)
 {
+    Block_Work_Timer work_timer(counters.get(), static_cast<int>(samples_per_output));
+    work_timer.set_items(static_cast<int>(samples_per_output));
     auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);
     out[0] = Gnss_Synchro();
     out[0].Flag_valid_symbol_output = false;
@@ -147,8 +206,18 @@ int gnss_sdr_sample_counter::work(int noutput_items __attribute__((unused)),
                     message_port_pub(pmt::mp("receiver_time"), pmt::from_double(static_cast<double>(current_T_rx_ms) / 1000.0));
                 }
         }
+    if (first_work_time_ns.load(std::memory_order_relaxed) < 0)
+        {
+            first_work_time_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+        }
+    else
+        {
+            samples_received.fetch_add(samples_per_output, std::memory_order_relaxed);
+        }
     sample_counter += samples_per_output;
     out[0].Tracking_sample_counter = sample_counter;
+    Block_Instrumentation::instance().stamp_sample_counter(sample_counter);
+    check_rx_time_tags();
     current_T_rx_ms += interval_ms;
 
     // *************** time tags ****************
@@ -18,11 +18,14 @@
 #ifndef GNSS_SDR_GNSS_SDR_SAMPLE_COUNTER_H
 #define GNSS_SDR_GNSS_SDR_SAMPLE_COUNTER_H
 
+#include "block_instrumentation.h"
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_decimator.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
-#include <cstddef>           // for size_t
+#include <atomic>
+#include <cstddef>  // for size_t
 #include <cstdint>
+#include <memory>
 
 /** \addtogroup Core
  * \{ */
@@ -48,6 +51,23 @@ public:
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items);
 
+    /*!
+     * \brief Returns how far the processing lags behind the signal source, in
+     * s: the wall clock time elapsed since the first call to work() minus the
+     * time spanned by the samples received (and dropped) since then. It grows
+     * when the receiver does not keep up with a real-time signal source.
+     */
+    double real_time_lag_s() const;
+
+    /*!
+     * \brief Returns the number of samples dropped by the signal source, as
+     * reported by its rx_time tags
+     */
+    inline uint64_t dropped_samples() const
+    {
+        return samples_dropped.load(std::memory_order_relaxed);
+    }
+
 private:
     friend gnss_sdr_sample_counter_sptr gnss_sdr_make_sample_counter(
         double _fs,
@@ -59,8 +79,15 @@ private:
         size_t _size);
 
     int64_t uint64diff(uint64_t first, uint64_t second);
+    void check_rx_time_tags();
 
+    std::shared_ptr<Block_Counters> counters;
+    std::atomic<int64_t> first_work_time_ns;  // Wall clock time of the first call to work(), or -1
+    std::atomic<uint64_t> samples_received;   // Samples consumed since the first call to work()
+    std::atomic<uint64_t> samples_dropped;    // Samples lost according to the rx_time tags
     double fs;
+    double last_rx_time;      // Time of the last rx_time tag from the signal source, in s
+    uint64_t last_rx_time_offset;
     int64_t current_T_rx_ms;  // Receiver time in ms since the beginning of the run
     uint64_t sample_counter;
     int32_t interval_ms;
@@ -74,6 +101,7 @@ private:
     bool flag_h;            // True if the receiver has been running for at least 1 hour
     bool flag_days;         // True if the receiver has been running for at least 1 day
     bool flag_enable_send_msg;
+    bool flag_rx_time;  // True if an rx_time tag has already been received
 };
 
 
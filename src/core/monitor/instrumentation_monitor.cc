@@ -0,0 +1,102 @@
+/*!
+ * \file instrumentation_monitor.cc
+ * \brief Implementation of a class that periodically sends the block
+ * instrumentation reports over UDP to one or multiple endpoints
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "instrumentation_monitor.h"
+#include "block_instrumentation.h"
+#include <chrono>
+#include <iostream>
+
+
+Instrumentation_Monitor::Instrumentation_Monitor(const std::vector<std::string>& addresses,
+    const uint16_t& port,
+    int32_t period_ms)
+    : socket{io_context},
+      last_report(std::chrono::steady_clock::now()),
+      d_period_ms(period_ms > 0 ? period_ms : 1000)
+{
+    for (const auto& address : addresses)
+        {
+            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
+            endpoints.push_back(endpoint);
+        }
+    // Discard whatever the blocks accumulated before the first period
+    Latency_Stats latency;
+    Block_Instrumentation::instance().take_snapshot(latency);
+    Block_Instrumentation::set_enabled(true);
+    thread = std::thread(&Instrumentation_Monitor::run, this);
+}
+
+
+Instrumentation_Monitor::~Instrumentation_Monitor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        d_stop = true;
+    }
+    cv.notify_one();
+    if (thread.joinable())
+        {
+            thread.join();
+        }
+    write_report();  // last, possibly shorter, period
+    Block_Instrumentation::set_enabled(false);
+}
+
+
+void Instrumentation_Monitor::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!d_stop)
+        {
+            if (!cv.wait_for(lock, std::chrono::milliseconds(d_period_ms), [this] { return d_stop; }))
+                {
+                    lock.unlock();
+                    write_report();
+                    lock.lock();
+                }
+        }
+}
+
+
+bool Instrumentation_Monitor::write_report()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const double period_s = std::chrono::duration<double>(now - last_report).count();
+    last_report = now;
+
+    Latency_Stats latency;
+    const std::vector<Block_Stats> stats = Block_Instrumentation::instance().take_snapshot(latency);
+    const std::string outbound_data = serdes.createProtobuffer(stats, latency, period_s);
+
+    for (const auto& endpoint : endpoints)
+        {
+            socket.open(endpoint.protocol(), error);
+
+            try
+                {
+                    if (socket.send_to(boost::asio::buffer(outbound_data), endpoint) == 0)
+                        {
+                            std::cerr << "Instrumentation_Monitor sent 0 bytes\n";
+                        }
+                }
+            catch (boost::system::system_error const& e)
+                {
+                    std::cerr << e.what() << '\n';
+                    return false;
+                }
+        }
+    return true;
+}
@@ -0,0 +1,78 @@
+/*!
+ * \file instrumentation_monitor.h
+ * \brief Interface of a class that periodically sends the block
+ * instrumentation reports over UDP to one or multiple endpoints
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INSTRUMENTATION_MONITOR_H
+#define GNSS_SDR_INSTRUMENTATION_MONITOR_H
+
+#include "serdes_instrumentation.h"
+#include <boost/asio.hpp>
+#include <boost/system/error_code.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Gnss_Synchro_Monitor
+ * \{ */
+
+
+#if USE_BOOST_ASIO_IO_CONTEXT
+using b_io_context = boost::asio::io_context;
+#else
+using b_io_context = boost::asio::io_service;
+#endif
+
+/*!
+ * \brief This class enables the block instrumentation and, every period_ms
+ * milliseconds, sends the counters accumulated by all the processing blocks
+ * (see Block_Instrumentation) as a serialized Instrumentation message over
+ * UDP to one or multiple endpoints.
+ */
+class Instrumentation_Monitor
+{
+public:
+    Instrumentation_Monitor(const std::vector<std::string>& addresses, const uint16_t& port, int32_t period_ms);
+    ~Instrumentation_Monitor();
+
+    Instrumentation_Monitor(const Instrumentation_Monitor&) = delete;
+    Instrumentation_Monitor& operator=(const Instrumentation_Monitor&) = delete;
+
+private:
+    void run();
+    bool write_report();  // sends the counters accumulated since the previous report
+
+    b_io_context io_context;
+    boost::asio::ip::udp::socket socket;
+    boost::system::error_code error;
+    std::vector<boost::asio::ip::udp::endpoint> endpoints;
+    Serdes_Instrumentation serdes;
+    std::chrono::steady_clock::time_point last_report;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    int32_t d_period_ms;
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_INSTRUMENTATION_MONITOR_H
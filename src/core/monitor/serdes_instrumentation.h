@@ -0,0 +1,80 @@
+/*!
+ * \file serdes_instrumentation.h
+ * \brief Serialization of the block instrumentation reports using Protocol
+ * Buffers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SERDES_INSTRUMENTATION_H
+#define GNSS_SDR_SERDES_INSTRUMENTATION_H
+
+#include "block_instrumentation.h"
+#include "instrumentation.pb.h"  // file created by Protocol Buffers at compile time
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Gnss_Synchro_Monitor
+ * \{ */
+
+
+/*!
+ * \brief This class implements serialization of the block instrumentation
+ * reports using Protocol Buffers.
+ */
+class Serdes_Instrumentation
+{
+public:
+    Serdes_Instrumentation()
+    {
+        // Verify that the version of the library that we linked against is
+        // compatible with the version of the headers we compiled against.
+        GOOGLE_PROTOBUF_VERIFY_VERSION;
+    }
+
+    inline std::string createProtobuffer(const std::vector<Block_Stats>& stats, const Latency_Stats& latency, double period_s)  //!< Serialization into a string
+    {
+        report_.Clear();
+        std::string data;
+        report_.set_period_s(period_s);
+        report_.set_tracking_sample_counter(latency.last_sample_counter);
+        report_.set_pvt_fixes(latency.fixes);
+        report_.set_sample_to_pvt_min_ms(latency.min_ms);
+        report_.set_sample_to_pvt_mean_ms(latency.mean_ms);
+        report_.set_sample_to_pvt_max_ms(latency.max_ms);
+        for (const auto& s : stats)
+            {
+                gnss_sdr::BlockStats* b = report_.add_block();
+                b->set_block(s.block);
+                b->set_channel_id(s.channel);
+                b->set_calls(s.calls);
+                b->set_items(s.items);
+                b->set_work_time_ms(static_cast<double>(s.work_ns) * 1e-6);
+                b->set_work_time_max_us(static_cast<double>(s.work_ns_max) * 1e-3);
+                b->set_input_items_mean(s.calls > 0 ? static_cast<double>(s.input_items) / static_cast<double>(s.calls) : 0.0);
+                b->set_input_items_max(s.input_items_max);
+                b->set_dropped_events(s.dropped_events);
+                b->set_dropped_samples(s.dropped_samples);
+            }
+        report_.SerializeToString(&data);
+        return data;
+    }
+
+private:
+    gnss_sdr::Instrumentation report_{};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SERDES_INSTRUMENTATION_H
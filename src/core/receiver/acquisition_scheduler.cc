@@ -0,0 +1,117 @@
+/*!
+ * \file acquisition_scheduler.cc
+ * \brief Implementation of a class that ranks the satellites pending
+ * acquisition by their predicted elevation and Doppler shift
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acquisition_scheduler.h"
+#include "MATH_CONSTANTS.h"  // for D2R, R2D
+#include <algorithm>         // for std::stable_sort, std::min, std::max
+#include <cmath>             // for sin, cos, asin, sqrt
+#include <cstdint>           // for uint32_t
+#include <set>               // for set
+#include <string>            // for string
+#include <utility>           // for pair
+
+
+void Acquisition_Scheduler::set_receiver_state(double tow_s,
+    double lat_deg,
+    double lon_deg,
+    double height_m,
+    double ground_speed_m_s,
+    double course_over_ground_deg)
+{
+    const double RE_WGS84 = 6378137.0;              // earth semimajor axis (WGS84) (m)
+    const double FE_WGS84 = (1.0 / 298.257223563);  // earth flattening (WGS84)
+    const double sinp = std::sin(lat_deg * D2R);
+    const double cosp = std::cos(lat_deg * D2R);
+    const double sinl = std::sin(lon_deg * D2R);
+    const double cosl = std::cos(lon_deg * D2R);
+    const double e2 = FE_WGS84 * (2.0 - FE_WGS84);
+    const double v = RE_WGS84 / std::sqrt(1.0 - e2 * sinp * sinp);
+
+    d_rx_pos = {(v + height_m) * cosp * cosl, (v + height_m) * cosp * sinl, (v * (1.0 - e2) + height_m) * sinp};
+    d_up = {cosp * cosl, cosp * sinl, sinp};
+    d_tow_s = tow_s;
+    d_lat_deg = lat_deg;
+    d_lon_deg = lon_deg;
+    d_height_m = height_m;
+    d_ve = ground_speed_m_s * std::sin(course_over_ground_deg * D2R);
+    d_vn = ground_speed_m_s * std::cos(course_over_ground_deg * D2R);
+}
+
+
+double Acquisition_Scheduler::elevation_deg(const std::array<double, 3>& sat_pos) const
+{
+    const std::array<double, 3> los = {sat_pos[0] - d_rx_pos[0], sat_pos[1] - d_rx_pos[1], sat_pos[2] - d_rx_pos[2]};
+    const double range = std::sqrt(los[0] * los[0] + los[1] * los[1] + los[2] * los[2]);
+    if (range == 0.0)
+        {
+            return -90.0;
+        }
+    const double up = (los[0] * d_up[0] + los[1] * d_up[1] + los[2] * d_up[2]) / range;
+    return std::asin(std::max(-1.0, std::min(1.0, up))) * R2D;
+}
+
+
+std::vector<Satellite_Prediction> Acquisition_Scheduler::predict(const std::map<int, Gps_Ephemeris>& gps_ephemeris,
+    const std::map<int, Galileo_Ephemeris>& gal_ephemeris,
+    const std::map<int, Gps_Almanac>& gps_almanac,
+    const std::map<int, Galileo_Almanac>& gal_almanac) const
+{
+    std::vector<Satellite_Prediction> predictions;
+    std::set<std::pair<std::string, uint32_t>> from_ephemeris;
+
+    auto add_from_ephemeris = [&](const std::string& system, Gnss_Ephemeris& eph) {
+        eph.satellitePosition(d_tow_s);
+        const double el = elevation_deg({eph.satpos_X, eph.satpos_Y, eph.satpos_Z});
+        const double doppler = eph.predicted_doppler(d_tow_s, d_lat_deg, d_lon_deg, d_height_m, d_ve, d_vn, 0.0, 1);
+        predictions.push_back({Gnss_Satellite(system, eph.PRN), el, doppler, true});
+        from_ephemeris.emplace(system, eph.PRN);
+    };
+
+    auto add_from_almanac = [&](const std::string& system, const Gnss_Almanac& alm) {
+        if (from_ephemeris.count({system, alm.PRN}) > 0)
+            {
+                return;
+            }
+        std::array<double, 7> pos_vel{};
+        alm.satellitePosVelComputation(d_tow_s, pos_vel);
+        const double el = elevation_deg({pos_vel[0], pos_vel[1], pos_vel[2]});
+        const double doppler = alm.predicted_doppler(d_tow_s, d_lat_deg, d_lon_deg, d_height_m, d_ve, d_vn, 0.0, 1);
+        predictions.push_back({Gnss_Satellite(system, alm.PRN), el, doppler, false});
+    };
+
+    for (const auto& it : gps_ephemeris)
+        {
+            Gps_Ephemeris eph = it.second;  // satellitePosition() updates the object
+            add_from_ephemeris("GPS", eph);
+        }
+    for (const auto& it : gal_ephemeris)
+        {
+            Galileo_Ephemeris eph = it.second;
+            add_from_ephemeris("Galileo", eph);
+        }
+    for (const auto& alm : gps_almanac)
+        {
+            add_from_almanac("GPS", alm.second);
+        }
+    for (const auto& alm : gal_almanac)
+        {
+            add_from_almanac("Galileo", alm.second);
+        }
+
+    std::stable_sort(predictions.begin(), predictions.end(),
+        [](const Satellite_Prediction& a, const Satellite_Prediction& b) { return a.elevation_deg > b.elevation_deg; });
+    return predictions;
+}
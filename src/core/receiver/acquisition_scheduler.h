@@ -0,0 +1,99 @@
+/*!
+ * \file acquisition_scheduler.h
+ * \brief Interface of a class that ranks the satellites pending acquisition
+ * by their predicted elevation and Doppler shift
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQUISITION_SCHEDULER_H
+#define GNSS_SDR_ACQUISITION_SCHEDULER_H
+
+#include "galileo_almanac.h"
+#include "galileo_ephemeris.h"
+#include "gnss_satellite.h"
+#include "gps_almanac.h"
+#include "gps_ephemeris.h"
+#include <array>
+#include <map>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Predicted geometry of a satellite as seen from the receiver
+ */
+struct Satellite_Prediction
+{
+    Gnss_Satellite satellite;
+    double elevation_deg;  //!< Predicted elevation [deg]
+    double doppler_hz;     //!< Predicted Doppler shift in the primary band (L1 C/A, E1) [Hz]
+    bool from_ephemeris;   //!< True if computed from the broadcast ephemeris, false if from the almanac
+};
+
+
+/*!
+ * \brief Predicts the elevation and the Doppler shift of the GPS and Galileo
+ * satellites from the receiver position and velocity, using the broadcast
+ * ephemeris when available and the almanac otherwise.
+ */
+class Acquisition_Scheduler
+{
+public:
+    Acquisition_Scheduler() = default;
+
+    /*!
+     * \brief Sets the receiver position and velocity
+     *
+     * \param[in] tow_s GPS Time of Week [s]
+     * \param[in] lat_deg Latitude [deg]
+     * \param[in] lon_deg Longitude [deg]
+     * \param[in] height_m Height [m]
+     * \param[in] ground_speed_m_s Speed over ground [m/s]
+     * \param[in] course_over_ground_deg Course over ground, clockwise from North [deg]
+     */
+    void set_receiver_state(double tow_s,
+        double lat_deg,
+        double lon_deg,
+        double height_m,
+        double ground_speed_m_s = 0.0,
+        double course_over_ground_deg = 0.0);
+
+    /*!
+     * \brief Returns the predictions for all the satellites with ephemeris or
+     * almanac, ordered from the highest to the lowest elevation
+     */
+    std::vector<Satellite_Prediction> predict(const std::map<int, Gps_Ephemeris>& gps_ephemeris,
+        const std::map<int, Galileo_Ephemeris>& gal_ephemeris,
+        const std::map<int, Gps_Almanac>& gps_almanac,
+        const std::map<int, Galileo_Almanac>& gal_almanac) const;
+
+private:
+    double elevation_deg(const std::array<double, 3>& sat_pos) const;
+
+    std::array<double, 3> d_rx_pos{};  // ECEF [m]
+    std::array<double, 3> d_up{};      // local vertical, ECEF
+    double d_tow_s{};
+    double d_lat_deg{};
+    double d_lon_deg{};
+    double d_height_m{};
+    double d_ve{};
+    double d_vn{};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQUISITION_SCHEDULER_H
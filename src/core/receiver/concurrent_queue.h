@@ -1,6 +1,6 @@
 /*!
  * \file concurrent_queue.h
- * \brief Interface of a thread-safe std::queue
+ * \brief Interface of a thread-safe queue
  * \author Javier Arribas, 2011. jarribas(at)cttc.es
  *
  * -----------------------------------------------------------------------------
@@ -8,7 +8,7 @@
  * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
  * This file is part of GNSS-SDR.
  *
- * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
  * SPDX-License-Identifier: GPL-3.0-or-later
  *
  * -----------------------------------------------------------------------------
@@ -17,11 +17,17 @@
 #ifndef GNSS_SDR_CONCURRENT_QUEUE_H
 #define GNSS_SDR_CONCURRENT_QUEUE_H
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <utility>
+#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -32,84 +38,276 @@
 template <typename Data>
 
 /*!
- * \brief This class implements a thread-safe std::queue
+ * \brief This class implements a thread-safe queue
  *
- * Thread-safe object queue which uses the library
- * boost_thread to perform MUTEX based on the code available at
- * https://www.justsoftwaresolutions.co.uk/threading/implementing-a-thread-safe-queue-using-condition-variables.html
+ * Items are stored in a bounded ring of slots tagged with sequence numbers
+ * (D. Vyukov's bounded MPMC queue), so producers never take a lock. If the
+ * ring is full, items are kept in a mutex-protected overflow std::queue until
+ * the consumers drain it, so nothing is ever dropped and producers never
+ * block. FIFO order is kept for the items pushed by each producer.
+ *
+ * Consumers only sleep on the condition variable after announcing themselves
+ * in an atomic counter, and producers only touch the mutex and the condition
+ * variable when that counter is not zero.
  */
 class Concurrent_Queue
 {
 public:
+    /*!
+     * \brief Constructor. The capacity of the ring is rounded up to a power
+     * of two.
+     */
+    explicit Concurrent_Queue(size_t capacity = 1024)
+        : d_ring(ring_size(capacity)),
+          d_mask(d_ring.size() - 1)
+    {
+        for (size_t i = 0; i < d_ring.size(); i++)
+            {
+                d_ring[i].sequence.store(i, std::memory_order_relaxed);
+            }
+    }
+
     void push(Data const& data)
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        the_queue.push(data);
-        lock.unlock();
-        the_condition_variable.notify_one();
+        if (!d_overflow_active.load(std::memory_order_acquire) && ring_try_push(data))
+            {
+                notify();
+                return;
+            }
+        {
+            std::lock_guard<std::mutex> lock(d_overflow_mutex);
+            d_overflow.push(data);
+            d_overflow_active.store(true, std::memory_order_release);
+        }
+        notify();
+    }
+
+    /*!
+     * \brief Pushes the item only if there is room for it in the ring.
+     * Returns false, without touching the overflow queue, if it is full.
+     */
+    bool try_push(Data const& data)
+    {
+        if (d_overflow_active.load(std::memory_order_acquire) || !ring_try_push(data))
+            {
+                return false;
+            }
+        notify();
+        return true;
     }
 
     bool empty() const
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        return the_queue.empty();
+        return size() == 0;
     }
 
     size_t size() const
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        return the_queue.size();
+        // Approximate if there are concurrent push or pop operations
+        const size_t dequeue_pos = d_dequeue_pos.load(std::memory_order_acquire);
+        const size_t enqueue_pos = d_enqueue_pos.load(std::memory_order_acquire);
+        size_t n = enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+        if (d_overflow_active.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(d_overflow_mutex);
+                n += d_overflow.size();
+            }
+        return n;
     }
 
     void clear()
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        the_queue = std::queue<Data>();
+        Data discarded;
+        while (try_pop(discarded))
+            {
+            }
     }
 
     bool try_pop(Data& popped_value)
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        if (the_queue.empty())
+        if (ring_try_pop(popped_value))
+            {
+                return true;
+            }
+        if (!d_overflow_active.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+        std::lock_guard<std::mutex> lock(d_overflow_mutex);
+        // Items pushed to the ring before the overflow was activated are older
+        if (ring_try_pop(popped_value))
+            {
+                return true;
+            }
+        if (d_overflow.empty())
             {
                 return false;
             }
-        popped_value = the_queue.front();
-        the_queue.pop();
+        popped_value = std::move(d_overflow.front());
+        d_overflow.pop();
+        if (d_overflow.empty())
+            {
+                d_overflow_active.store(false, std::memory_order_release);
+            }
         return true;
     }
 
     void wait_and_pop(Data& popped_value)
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        while (the_queue.empty())
+        while (!try_pop(popped_value))
             {
-                the_condition_variable.wait(lock);
+                std::unique_lock<std::mutex> lock(d_wait_mutex);
+                if (announce_and_try_pop(popped_value))
+                    {
+                        return;
+                    }
+                d_condition_variable.wait(lock);
+                d_waiters.fetch_sub(1, std::memory_order_relaxed);
             }
-        popped_value = the_queue.front();
-        the_queue.pop();
     }
 
     bool timed_wait_and_pop(Data& popped_value, int wait_ms)
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        if (the_queue.empty())
+        if (try_pop(popped_value))
             {
-                the_condition_variable.wait_for(lock, std::chrono::milliseconds(wait_ms));
-                if (the_queue.empty())
+                return true;
+            }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_ms);
+        std::unique_lock<std::mutex> lock(d_wait_mutex);
+        while (true)
+            {
+                if (announce_and_try_pop(popped_value))
                     {
-                        return false;
+                        return true;
+                    }
+                const std::cv_status status = d_condition_variable.wait_until(lock, deadline);
+                d_waiters.fetch_sub(1, std::memory_order_relaxed);
+                if (status == std::cv_status::timeout)
+                    {
+                        return try_pop(popped_value);
                     }
             }
-        popped_value = the_queue.front();
-        the_queue.pop();
-        return true;
     }
 
 private:
-    std::queue<Data> the_queue;
-    mutable std::mutex the_mutex;
-    std::condition_variable the_condition_variable;
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        Data data;
+    };
+
+    static size_t ring_size(size_t capacity)
+    {
+        size_t n = 2;
+        while (n < capacity)
+            {
+                n <<= 1;
+            }
+        return n;
+    }
+
+    bool ring_try_push(Data const& data)
+    {
+        size_t pos = d_enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+            {
+                cell = &d_ring[pos & d_mask];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                    {
+                        if (d_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                    }
+                else if (diff < 0)
+                    {
+                        return false;  // full
+                    }
+                else
+                    {
+                        pos = d_enqueue_pos.load(std::memory_order_relaxed);
+                    }
+            }
+        cell->data = data;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool ring_try_pop(Data& popped_value)
+    {
+        size_t pos = d_dequeue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+            {
+                cell = &d_ring[pos & d_mask];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0)
+                    {
+                        if (d_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                    }
+                else if (diff < 0)
+                    {
+                        return false;  // empty
+                    }
+                else
+                    {
+                        pos = d_dequeue_pos.load(std::memory_order_relaxed);
+                    }
+            }
+        popped_value = std::move(cell->data);
+        cell->sequence.store(pos + d_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Called with d_wait_mutex held. If it returns false, the caller must wait
+    // on the condition variable and then decrement d_waiters.
+    bool announce_and_try_pop(Data& popped_value)
+    {
+        d_waiters.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (try_pop(popped_value))
+            {
+                d_waiters.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        return false;
+    }
+
+    void notify()
+    {
+        // Pairs with the fence in announce_and_try_pop(): either the producer
+        // sees the waiter, or the waiter sees the new item
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (d_waiters.load(std::memory_order_relaxed) > 0)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(d_wait_mutex);
+                }
+                d_condition_variable.notify_one();
+            }
+    }
+
+    std::vector<Cell> d_ring;
+    size_t d_mask;
+    std::atomic<size_t> d_enqueue_pos{0};
+    std::array<char, 64> d_pad0{};  // keep producer and consumer positions in different cache lines
+    std::atomic<size_t> d_dequeue_pos{0};
+    std::array<char, 64> d_pad1{};
+
+    std::queue<Data> d_overflow;
+    mutable std::mutex d_overflow_mutex;
+    std::atomic<bool> d_overflow_active{false};
+
+    std::mutex d_wait_mutex;
+    std::condition_variable d_condition_variable;
+    std::atomic<int32_t> d_waiters{0};
 };
 
 
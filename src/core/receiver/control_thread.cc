@@ -36,6 +36,7 @@
 #include "gnss_flowgraph.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_flags.h"
+#include "gnss_sdr_make_unique.h"
 #include "gps_acq_assist.h"        // for Gps_Acq_Assist
 #include "gps_almanac.h"           // for Gps_Almanac
 #include "gps_cnav_ephemeris.h"    // for Gps_CNAV_Ephemeris
@@ -156,6 +157,19 @@ void ControlThread::init()
     telecommand_enabled_ = configuration_->property("GNSS-SDR.telecommand_enabled", false);
     // OPTIONAL: specify a custom year to override the system time in order to postprocess old gnss records and avoid wrong week rollover
     pre_2009_file_ = configuration_->property("GNSS-SDR.pre_2009_file", false);
+    // OPTIONAL: reorder the satellites pending acquisition by predicted elevation, and center their Doppler search on the predicted Doppler shift
+    elevation_aware_acquisition_ = configuration_->property("GNSS-SDR.elevation_aware_acquisition", false);
+    acquisition_schedule_period_s_ = configuration_->property("GNSS-SDR.elevation_aware_acquisition_period_s", 5.0);
+    acquisition_elevation_mask_deg_ = configuration_->property("GNSS-SDR.elevation_aware_acquisition_mask_deg", 0.0);
+    // OPTIONAL: stop channels and limit the acquisition when the receiver does not keep up with a real-time signal source
+    if (configuration_->property("GNSS-SDR.load_governor", false))
+        {
+            load_governor_ = std::make_unique<Load_Governor>(configuration_->property("GNSS-SDR.load_governor_max_lag_growth_ms", 10.0) / 1e3,
+                configuration_->property("GNSS-SDR.load_governor_restore_hold_s", 10.0));
+        }
+    load_governor_period_s_ = configuration_->property("GNSS-SDR.load_governor_period_s", 1.0);
+    load_governor_min_channels_ = configuration_->property("GNSS-SDR.load_governor_min_channels", 4);
+    load_governor_limited_acquisition_ = false;
     // Instantiates a control queue, a GNSS flowgraph, and a control message factory
     control_queue_ = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
     cmd_interface_.set_msg_queue(control_queue_);  // set also the queue pointer for the telecommand thread
@@ -421,6 +435,9 @@ int ControlThread::run()
     fpga_helper_thread_ = boost::thread(&GNSSFlowgraph::start_acquisition_helper,
         flowgraph_);
 #endif
+    start_time_ = std::chrono::steady_clock::now();
+    last_acquisition_schedule_ = start_time_;
+    last_load_governor_update_ = start_time_;
     // Main loop to read and process the control messages
     pmt::pmt_t msg;
     while (flowgraph_->running() && !stop_)
@@ -429,6 +446,24 @@ int ControlThread::run()
             bool valid_event = control_queue_->timed_wait_and_pop(msg, 100);
             // call the new sat dispatcher and receiver controller
             event_dispatcher(valid_event, msg);
+            if (elevation_aware_acquisition_ && !receiver_on_standby_)
+                {
+                    const auto now = std::chrono::steady_clock::now();
+                    if (std::chrono::duration<double>(now - last_acquisition_schedule_).count() >= acquisition_schedule_period_s_)
+                        {
+                            last_acquisition_schedule_ = now;
+                            update_acquisition_schedule();
+                        }
+                }
+            if (load_governor_ && !receiver_on_standby_)
+                {
+                    const auto now = std::chrono::steady_clock::now();
+                    if (std::chrono::duration<double>(now - last_load_governor_update_).count() >= load_governor_period_s_)
+                        {
+                            last_load_governor_update_ = now;
+                            update_load_governor();
+                        }
+                }
         }
     std::cout << "Stopping GNSS-SDR, please wait!\n";
     flowgraph_->stop();
@@ -1156,6 +1191,113 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
 }
 
 
+void ControlThread::update_acquisition_schedule()
+{
+    const std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
+    double longitude_deg;
+    double latitude_deg;
+    double height_m;
+    double ground_speed_kmh;
+    double course_over_ground_deg;
+    time_t rx_utc_time;
+    if (!pvt_ptr->get_latest_PVT(&longitude_deg, &latitude_deg, &height_m, &ground_speed_kmh, &course_over_ground_deg, &rx_utc_time))
+        {
+            if (!agnss_ref_location_.valid || !agnss_ref_time_.valid)
+                {
+                    return;
+                }
+            // no fix yet, assume a static receiver at the reference location
+            longitude_deg = agnss_ref_location_.lon;
+            latitude_deg = agnss_ref_location_.lat;
+            height_m = 0.0;
+            ground_speed_kmh = 0.0;
+            course_over_ground_deg = 0.0;
+            rx_utc_time = agnss_ref_time_.seconds + static_cast<time_t>(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count());
+        }
+
+    gtime_t utc_gtime;
+    utc_gtime.time = rx_utc_time;
+    utc_gtime.sec = 0.0;
+    const double tow_s = time2gpst(utc2gpst(utc_gtime), nullptr);
+
+    acquisition_scheduler_.set_receiver_state(tow_s, latitude_deg, longitude_deg, height_m, ground_speed_kmh / 3.6, course_over_ground_deg);
+    const std::vector<Satellite_Prediction> predictions = acquisition_scheduler_.predict(pvt_ptr->get_gps_ephemeris(),
+        pvt_ptr->get_galileo_ephemeris(),
+        pvt_ptr->get_gps_almanac(),
+        pvt_ptr->get_galileo_almanac());
+    flowgraph_->set_acquisition_predictions(predictions, acquisition_elevation_mask_deg_);
+
+    for (const auto& prediction : predictions)
+        {
+            DLOG(INFO) << "Acquisition schedule: " << prediction.satellite
+                       << " elevation " << prediction.elevation_deg << " [deg], Doppler "
+                       << prediction.doppler_hz << " [Hz] (" << (prediction.from_ephemeris ? "ephemeris" : "almanac") << ")";
+        }
+}
+
+
+void ControlThread::update_load_governor()
+{
+    double lag_s = 0.0;
+    uint64_t dropped_samples = 0;
+    if (!flowgraph_->real_time_status(lag_s, dropped_samples))
+        {
+            return;
+        }
+    const double time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+
+    // The first step limits the acquisition, the next ones stop one channel each.
+    // Actions are sent through the control queue as channel control commands.
+    const int channel = load_governor_limited_acquisition_ ? flowgraph_->channel_to_stop(load_governor_min_channels_) : -1;
+    const bool can_shed = !load_governor_limited_acquisition_ || channel >= 0;
+    const Load_Action action = load_governor_->update(time_s, lag_s, dropped_samples, can_shed);
+    if (load_governor_->overloaded())
+        {
+            LOG(WARNING) << "Load governor: the receiver does not keep up with the signal source (lag grew "
+                         << 1e3 * load_governor_->lag_growth_s() << " ms, "
+                         << load_governor_->new_dropped_samples() << " samples dropped)";
+        }
+    switch (action)
+        {
+        case Load_Action::shed:
+            if (!load_governor_limited_acquisition_)
+                {
+                    load_governor_limited_acquisition_ = true;
+                    control_queue_->push(pmt::make_any(command_event_make(600, 30)));
+                    std::cout << "Load governor: limiting the acquisition to one channel at a time\n";
+                    LOG(WARNING) << "Load governor: limiting the acquisition to one channel at a time";
+                }
+            else
+                {
+                    load_governor_stopped_channels_.push_back(channel);
+                    control_queue_->push(pmt::make_any(command_event_make(400 + channel, 20)));
+                    std::cout << "Load governor: stopping channel " << channel << '\n';
+                    LOG(WARNING) << "Load governor: stopping channel " << channel;
+                }
+            break;
+        case Load_Action::restore:
+            if (!load_governor_stopped_channels_.empty())
+                {
+                    const int stopped_channel = load_governor_stopped_channels_.back();
+                    load_governor_stopped_channels_.pop_back();
+                    control_queue_->push(pmt::make_any(command_event_make(400 + stopped_channel, 21)));
+                    std::cout << "Load governor: starting channel " << stopped_channel << '\n';
+                    LOG(INFO) << "Load governor: starting channel " << stopped_channel;
+                }
+            else if (load_governor_limited_acquisition_)
+                {
+                    load_governor_limited_acquisition_ = false;
+                    control_queue_->push(pmt::make_any(command_event_make(600, 31)));
+                    std::cout << "Load governor: restoring the acquisition\n";
+                    LOG(INFO) << "Load governor: restoring the acquisition";
+                }
+            break;
+        default:
+            break;
+        }
+}
+
+
 void ControlThread::gps_acq_assist_data_collector() const
 {
     // ############ 1.bis READ EPHEMERIS/UTC_MODE/IONO QUEUE ####################
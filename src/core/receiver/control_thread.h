@@ -21,15 +21,18 @@
 #ifndef GNSS_SDR_CONTROL_THREAD_H
 #define GNSS_SDR_CONTROL_THREAD_H
 
+#include "acquisition_scheduler.h"  // for Acquisition_Scheduler
 #include "agnss_ref_location.h"    // for Agnss_Ref_Location
 #include "agnss_ref_time.h"        // for Agnss_Ref_Time
 #include "channel_event.h"         // for channel_event_sptr
 #include "command_event.h"         // for command_event_sptr
 #include "concurrent_queue.h"      // for Concurrent_Queue
 #include "gnss_sdr_supl_client.h"  // for Gnss_Sdr_Supl_Client
+#include "load_governor.h"         // for Load_Governor
 #include "tcp_cmd_interface.h"     // for TcpCmdInterface
 #include <pmt/pmt.h>
 #include <array>     // for array
+#include <chrono>    // for steady_clock
 #include <cstddef>   // for size_t
 #include <memory>    // for shared_ptr
 #include <string>    // for string
@@ -158,6 +161,20 @@ private:
      */
     void assist_GNSS();
 
+    /*
+     * Predict elevation and Doppler of the GPS and Galileo satellites from the
+     * latest PVT fix (or the AGNSS reference location and time if there is no
+     * fix yet) and reorder the signals pending acquisition accordingly
+     */
+    void update_acquisition_schedule();
+
+    /*
+     * Measure the lag of the processing with respect to the signal source and
+     * the samples dropped by it, and stop or start channels and limit or
+     * restore the acquisition as decided by the load governor
+     */
+    void update_load_governor();
+
     void telecommand_listener();
     void keyboard_listener();
     void sysv_queue_listener();
@@ -208,6 +225,19 @@ private:
     Agnss_Ref_Location agnss_ref_location_;
     Agnss_Ref_Time agnss_ref_time_;
 
+    Acquisition_Scheduler acquisition_scheduler_;
+    std::chrono::steady_clock::time_point last_acquisition_schedule_;
+    std::chrono::steady_clock::time_point start_time_;
+    double acquisition_schedule_period_s_;
+    double acquisition_elevation_mask_deg_;
+
+    std::unique_ptr<Load_Governor> load_governor_;  // nullptr if disabled
+    std::vector<int> load_governor_stopped_channels_;
+    std::chrono::steady_clock::time_point last_load_governor_update_;
+    double load_governor_period_s_;
+    int load_governor_min_channels_;
+    bool load_governor_limited_acquisition_;
+
     unsigned int processed_control_messages_;
     unsigned int applied_actions_;
     int msqid_;
@@ -222,6 +252,7 @@ private:
     bool stop_;
     bool restart_;
     bool telecommand_enabled_;
+    bool elevation_aware_acquisition_;
     bool pre_2009_file_;  // to override the system time to postprocess old gnss records and avoid wrong week rollover
 };
 
@@ -36,6 +36,7 @@
 #include "gnss_satellite.h"
 #include "gnss_sdr_make_unique.h"
 #include "gnss_synchro_monitor.h"
+#include "instrumentation_monitor.h"
 #include "nav_message_monitor.h"
 #include "signal_source_interface.h"
 #include <boost/lexical_cast.hpp>    // for boost::lexical_cast
@@ -57,6 +58,7 @@
 #include <sstream>                   // for std::stringstream
 #include <stdexcept>                 // for invalid_argument
 #include <thread>                    // for std::thread
+#include <tuple>                     // for std::tuple
 #include <utility>                   // for std::move
 
 #ifdef GR_GREATER_38
@@ -76,7 +78,8 @@ GNSSFlowgraph::GNSSFlowgraph(std::shared_ptr<ConfigurationInterface> configurati
       connected_(false),
       running_(false),
       multiband_(GNSSFlowgraph::is_multiband()),
-      enable_e6_has_rx_(false)
+      enable_e6_has_rx_(false),
+      acquisition_limited_(false)
 {
     enable_fpga_offloading_ = configuration_->property("GNSS-SDR.enable_FPGA", false);
     init();
@@ -271,6 +274,22 @@ void GNSSFlowgraph::init()
             udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
             NavDataMonitor_ = nav_message_monitor_make(udp_addr_vec, configuration_->property("NavDataMonitor.port", 1237));
         }
+
+    /*
+     * Instantiate the receiver instrumentation monitor, if required
+     */
+    enable_instrumentation_monitor_ = configuration_->property("InstrumentationMonitor.enable_monitor", false);
+    if (enable_instrumentation_monitor_)
+        {
+            // Retrieve monitor properties
+            std::string address_string = configuration_->property("InstrumentationMonitor.client_addresses", std::string("127.0.0.1"));
+            std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
+            std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
+            udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
+            InstrumentationMonitor_ = std::make_unique<Instrumentation_Monitor>(udp_addr_vec,
+                configuration_->property("InstrumentationMonitor.udp_port", 1238),
+                configuration_->property("InstrumentationMonitor.period_ms", 1000));
+        }
 }
 
 
@@ -319,6 +338,8 @@ void GNSSFlowgraph::stop()
             top_block_->wait();
         }
 
+    InstrumentationMonitor_.reset();  // sends the report of the last period
+
     running_ = false;
 }
 
@@ -1024,8 +1045,10 @@ int GNSSFlowgraph::connect_signal_conditioners_to_channels()
                 }
             try
                 {
-                    // Enable automatic resampler for the acquisition, if required
-                    if (use_acq_resampler == true)
+                    // Enable automatic resampler for the acquisition, if required.
+                    // It is only available for gr_complex samples.
+                    const size_t conditioner_item_size = sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block()->output_signature()->sizeof_stream_item(0);
+                    if (use_acq_resampler == true and conditioner_item_size == sizeof(gr_complex))
                         {
                             // create acquisition resamplers if required
                             double resampler_ratio = 1.0;
@@ -1179,7 +1202,7 @@ int GNSSFlowgraph::connect_observables_to_pvt()
                 {
                     top_block_->connect(observables_->get_right_block(), i, pvt_->get_left_block(), i);
                     top_block_->msg_connect(channels_.at(i)->get_right_block(), pmt::mp("telemetry"), pvt_->get_left_block(), pmt::mp("telemetry"));
-                    // experimental Vector Tracking Loop (VTL) messages from PVT to Tracking blocks
+                    // Vector Tracking Loop (VTL) messages from PVT to Tracking blocks
                     // not supported by all tracking algorithms
                     pmt::pmt_t ports_in = channels_.at(i)->get_left_block_trk()->message_ports_in();
                     for (size_t n = 0; n < pmt::length(ports_in); n++)
@@ -1379,7 +1402,7 @@ void GNSSFlowgraph::check_signal_conditioners()
         {
             if (signal_conditioner_connected_.at(n) == false)
                 {
-                    null_sinks_.push_back(gr::blocks::null_sink::make(sizeof(gr_complex)));
+                    null_sinks_.push_back(gr::blocks::null_sink::make(sig_conditioner_.at(n)->get_right_block()->output_signature()->sizeof_stream_item(0)));
                     top_block_->connect(sig_conditioner_.at(n)->get_right_block(), 0,
                         null_sinks_.back(), 0);
                     LOG(INFO) << "Null sink connected to signal conditioner " << n << " due to lack of connection to any channel\n";
@@ -1809,7 +1832,7 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
                 {
                     LOG(WARNING) << e.what();
                 }
-            if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[current_channel] == 0))
+            if ((acq_channels_count_ < acquisition_channels_limit()) && (channels_state_[current_channel] == 0))
                 {
                     bool is_primary_freq = true;
                     bool assistance_available = false;
@@ -1847,8 +1870,8 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
                                 }
                             else
                                 {
-                                    // set Doppler center to 0 Hz
-                                    channels_[current_channel]->assist_acquisition_doppler(0);
+                                    // set Doppler center to the predicted Doppler shift, if available, or to 0 Hz
+                                    channels_[current_channel]->assist_acquisition_doppler(predicted_doppler(channels_[current_channel]->get_signal()));
                                 }
 #if ENABLE_FPGA
                             if (enable_fpga_offloading_)
@@ -1886,7 +1909,8 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
  *  -> 0-199 are the channels IDs
  *  -> 200 is the control_thread dispatched by the control_thread apply_action
  *  -> 300 is the telecommand system (TC) for receiver control
- *  -> 400 - 599 is the TC channel control for channels 0-199
+ *  -> 400 - 599 is the TC channel control for channels 0-199 (also used by the load governor)
+ *  -> 600 is the load governor
  * \param[in] what  What is the action:
  * --- actions from channels ---
  * -> 0 acquisition failed
@@ -1900,6 +1924,14 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
  * --- actions from TC channel control ---
  * -> 20 stop channel
  * -> 21 start channel
+ * --- actions from the load governor ---
+ * -> 30 limit the acquisition to one channel at a time
+ * -> 31 restore the configured number of channels in acquisition
+ *
+ * A stopped channel keeps the state 3, and is not given new satellites
+ * until it is started again. The signal it was processing is kept out of the
+ * lists of available signals meanwhile, so no other channel acquires it, and
+ * it is queued again when the channel is started.
  */
 void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
 {
@@ -1918,6 +1950,11 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                 {
                     LOG(WARNING) << e.what();
                 }
+            if (what < 3 && channels_state_[who] == 3)
+                {
+                    DLOG(INFO) << "Channel " << who << " is stopped, event " << what << " ignored";
+                    return;
+                }
         }
     switch (what)
         {
@@ -1955,7 +1992,7 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
         case 2:
             gs = channels_[who]->get_signal();
             DLOG(INFO) << "Channel " << who << " TRK FAILED satellite " << gs.get_satellite();
-            if (acq_channels_count_ < max_acq_channels_)
+            if (acq_channels_count_ < acquisition_channels_limit())
                 {
                     // try to acquire the same satellite
                     channels_state_[who] = 1;
@@ -2003,6 +2040,54 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                 }
             acq_channels_count_ = 0;  // all channels are in standby now and no new acquisition should be started
             break;
+        case 20:  // stop channel
+            if (who >= 400 && who < 600 && static_cast<int>(who - 400) < channels_count_)
+                {
+                    const unsigned int ch = who - 400;
+                    if (channels_state_[ch] == 1 or channels_state_[ch] == 2)
+                        {
+                            gs = channels_[ch]->get_signal();
+                            channels_[ch]->stop_channel();
+                            if (channels_state_[ch] == 1 && acq_channels_count_ > 0)
+                                {
+                                    acq_channels_count_--;
+                                }
+                            if (configuration_->property("Channel" + std::to_string(ch) + ".satellite", 0) == 0)
+                                {
+                                    stopped_signals_[ch] = gs;
+                                }
+                            LOG(INFO) << "Channel " << ch << " stopped, satellite " << gs.get_satellite() << ", Signal " << gs.get_signal_str();
+                        }
+                    channels_state_[ch] = 3;
+                }
+            break;
+        case 21:  // start channel
+            if (who >= 400 && who < 600 && static_cast<int>(who - 400) < channels_count_)
+                {
+                    const unsigned int ch = who - 400;
+                    if (channels_state_[ch] == 3)
+                        {
+                            channels_state_[ch] = 0;
+                            const auto stopped = stopped_signals_.find(ch);
+                            if (stopped != stopped_signals_.end())
+                                {
+                                    push_back_signal(stopped->second);
+                                    stopped_signals_.erase(stopped);
+                                }
+                            LOG(INFO) << "Channel " << ch << " started";
+                            acquisition_manager(ch == 0 ? channels_count_ - 1 : ch - 1);  // starting by this channel
+                        }
+                }
+            break;
+        case 30:
+            acquisition_limited_ = true;
+            LOG(INFO) << "Acquisition limited to one channel at a time";
+            break;
+        case 31:
+            acquisition_limited_ = false;
+            LOG(INFO) << "Acquisition restored to " << max_acq_channels_ << " channels at a time";
+            acquisition_manager(0);
+            break;
         default:
             break;
         }
@@ -2011,74 +2096,149 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
 
 void GNSSFlowgraph::priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites)
 {
-    size_t old_size;
-    Gnss_Signal gs;
     for (const auto& visible_satellite : visible_satellites)
         {
-            if (visible_satellite.second.get_system() == "GPS")
-                {
-                    gs = Gnss_Signal(visible_satellite.second, "1C");
-                    old_size = available_GPS_1C_signals_.size();
-                    available_GPS_1C_signals_.remove(gs);
-                    if (old_size > available_GPS_1C_signals_.size())
-                        {
-                            available_GPS_1C_signals_.push_front(gs);
-                        }
+            move_satellite_signals(visible_satellite.second, true);
+        }
+}
 
-                    gs = Gnss_Signal(visible_satellite.second, "2S");
-                    old_size = available_GPS_2S_signals_.size();
-                    available_GPS_2S_signals_.remove(gs);
-                    if (old_size > available_GPS_2S_signals_.size())
-                        {
-                            available_GPS_2S_signals_.push_front(gs);
-                        }
 
-                    gs = Gnss_Signal(visible_satellite.second, "L5");
-                    old_size = available_GPS_L5_signals_.size();
-                    available_GPS_L5_signals_.remove(gs);
-                    if (old_size > available_GPS_L5_signals_.size())
-                        {
-                            available_GPS_L5_signals_.push_front(gs);
-                        }
+void GNSSFlowgraph::set_acquisition_predictions(const std::vector<Satellite_Prediction>& predictions, double elevation_mask_deg)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    predicted_doppler_hz_.clear();
+    predicted_elevation_deg_.clear();
+    // predictions are sorted by decreasing elevation. Visible satellites are
+    // moved to the front from the lowest to the highest, and the rest to the
+    // back from the highest to the lowest.
+    for (auto it = predictions.crbegin(); it != predictions.crend(); ++it)
+        {
+            predicted_elevation_deg_[std::make_pair(it->satellite.get_system(), it->satellite.get_PRN())] = it->elevation_deg;
+            if (it->elevation_deg >= elevation_mask_deg)
+                {
+                    move_satellite_signals(it->satellite, true);
+                    predicted_doppler_hz_[std::make_pair(it->satellite.get_system(), it->satellite.get_PRN())] = it->doppler_hz;
                 }
-            else if (visible_satellite.second.get_system() == "Galileo")
+        }
+    for (const auto& prediction : predictions)
+        {
+            if (prediction.elevation_deg < elevation_mask_deg)
                 {
-                    gs = Gnss_Signal(visible_satellite.second, "1B");
-                    old_size = available_GAL_1B_signals_.size();
-                    available_GAL_1B_signals_.remove(gs);
-                    if (old_size > available_GAL_1B_signals_.size())
-                        {
-                            available_GAL_1B_signals_.push_front(gs);
-                        }
+                    move_satellite_signals(prediction.satellite, false);
+                }
+        }
+}
 
-                    gs = Gnss_Signal(visible_satellite.second, "5X");
-                    old_size = available_GAL_5X_signals_.size();
-                    available_GAL_5X_signals_.remove(gs);
-                    if (old_size > available_GAL_5X_signals_.size())
-                        {
-                            available_GAL_5X_signals_.push_front(gs);
-                        }
 
-                    gs = Gnss_Signal(visible_satellite.second, "7X");
-                    old_size = available_GAL_7X_signals_.size();
-                    available_GAL_7X_signals_.remove(gs);
-                    if (old_size > available_GAL_7X_signals_.size())
+void GNSSFlowgraph::move_satellite_signals(const Gnss_Satellite& satellite, bool to_front)
+{
+    std::vector<std::pair<std::list<Gnss_Signal>*, std::string>> signal_lists;
+    if (satellite.get_system() == "GPS")
+        {
+            signal_lists = {{&available_GPS_1C_signals_, "1C"}, {&available_GPS_2S_signals_, "2S"}, {&available_GPS_L5_signals_, "L5"}};
+        }
+    else if (satellite.get_system() == "Galileo")
+        {
+            signal_lists = {{&available_GAL_1B_signals_, "1B"}, {&available_GAL_5X_signals_, "5X"}, {&available_GAL_7X_signals_, "7X"}, {&available_GAL_E6_signals_, "E6"}};
+        }
+    for (auto& signal_list : signal_lists)
+        {
+            // signals being acquired or tracked are not in the list, and are not added
+            const Gnss_Signal gs(satellite, signal_list.second);
+            const size_t old_size = signal_list.first->size();
+            signal_list.first->remove(gs);
+            if (old_size > signal_list.first->size())
+                {
+                    if (to_front)
                         {
-                            available_GAL_7X_signals_.push_front(gs);
+                            signal_list.first->push_front(gs);
                         }
-
-                    gs = Gnss_Signal(visible_satellite.second, "E6");
-                    old_size = available_GAL_E6_signals_.size();
-                    available_GAL_E6_signals_.remove(gs);
-                    if (old_size > available_GAL_E6_signals_.size())
+                    else
                         {
-                            available_GAL_E6_signals_.push_front(gs);
+                            signal_list.first->push_back(gs);
                         }
                 }
         }
 }
 
 
+double GNSSFlowgraph::predicted_doppler(const Gnss_Signal& gs)
+{
+    const auto it = predicted_doppler_hz_.find(std::make_pair(gs.get_satellite().get_system(), gs.get_satellite().get_PRN()));
+    if (it == predicted_doppler_hz_.cend())
+        {
+            return 0.0;
+        }
+    return project_doppler(gs.get_signal_str(), it->second);
+}
+
+
+int GNSSFlowgraph::acquisition_channels_limit() const
+{
+    if (acquisition_limited_)
+        {
+            return 1;
+        }
+    return max_acq_channels_;
+}
+
+
+bool GNSSFlowgraph::real_time_status(double& lag_s, uint64_t& dropped_samples) const
+{
+    if (ch_out_sample_counter_ == nullptr)
+        {
+            return false;
+        }
+    lag_s = ch_out_sample_counter_->real_time_lag_s();
+    dropped_samples = ch_out_sample_counter_->dropped_samples();
+    return true;
+}
+
+
+int GNSSFlowgraph::channel_to_stop(int min_tracking_channels)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    std::vector<int> tracking_channels;
+    std::map<std::pair<std::string, uint32_t>, int> channels_per_satellite;
+    for (int i = 0; i < channels_count_; i++)
+        {
+            if (channels_state_[i] == 2)
+                {
+                    const Gnss_Satellite sat = channels_[i]->get_signal().get_satellite();
+                    tracking_channels.push_back(i);
+                    channels_per_satellite[std::make_pair(sat.get_system(), sat.get_PRN())]++;
+                }
+        }
+    if (static_cast<int>(tracking_channels.size()) <= min_tracking_channels)
+        {
+            return -1;
+        }
+
+    // Sort key: satellites tracked in other bands first, then by predicted
+    // elevation (unknown counts as zenith), then by C/N0 (zero if the channel
+    // does not deliver observables yet)
+    const std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
+    int selected = -1;
+    std::tuple<bool, double, double> selected_key{};
+    for (const int ch : tracking_channels)
+        {
+            const Gnss_Satellite sat = channels_[ch]->get_signal().get_satellite();
+            const auto sat_key = std::make_pair(sat.get_system(), sat.get_PRN());
+            const auto elevation = predicted_elevation_deg_.find(sat_key);
+            const auto status = current_channels_status.find(ch);
+            const auto key = std::make_tuple(channels_per_satellite[sat_key] == 1,
+                elevation == predicted_elevation_deg_.cend() ? 90.0 : elevation->second,
+                status == current_channels_status.cend() ? 0.0 : status->second->CN0_dB_hz);
+            if (selected < 0 || key < selected_key)
+                {
+                    selected = ch;
+                    selected_key = key;
+                }
+        }
+    return selected;
+}
+
+
 void GNSSFlowgraph::set_configuration(const std::shared_ptr<ConfigurationInterface>& configuration)
 {
     if (running_)
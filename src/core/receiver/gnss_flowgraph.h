@@ -24,6 +24,7 @@
 #ifndef GNSS_SDR_GNSS_FLOWGRAPH_H
 #define GNSS_SDR_GNSS_FLOWGRAPH_H
 
+#include "acquisition_scheduler.h"
 #include "channel_status_msg_receiver.h"
 #include "concurrent_queue.h"
 #include "galileo_e6_has_msg_receiver.h"
@@ -55,6 +56,7 @@ class ChannelInterface;
 class ConfigurationInterface;
 class GNSSBlockInterface;
 class Gnss_Satellite;
+class Instrumentation_Monitor;
 class SignalSourceInterface;
 
 /*! \brief This class represents a GNSS flow graph.
@@ -156,6 +158,36 @@ public:
      */
     void priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites);
 
+    /*!
+     * \brief Reorders the signals pending acquisition according to the
+     * predicted elevation of their satellites: those above the elevation mask
+     * are moved to the front, highest first, and the rest to the back. The
+     * predicted Doppler shifts of the former are kept to center the Doppler
+     * search of their next acquisitions.
+     *
+     * \param[in] predictions  Predictions sorted by decreasing elevation
+     * \param[in] elevation_mask_deg  Elevation mask [deg]
+     */
+    void set_acquisition_predictions(const std::vector<Satellite_Prediction>& predictions, double elevation_mask_deg);
+
+    /*!
+     * \brief Gets how far the processing lags behind the signal source and
+     * the number of samples dropped by the source (see gnss_sdr_sample_counter)
+     *
+     * \return False if the flow graph has no sample counter
+     */
+    bool real_time_status(double& lag_s, uint64_t& dropped_samples) const;
+
+    /*!
+     * \brief Returns the tracking channel that should be stopped first to
+     * reduce the processing load: a channel whose satellite is also tracked in
+     * another band, if any, then the one with the lowest predicted elevation,
+     * then the one with the lowest C/N0 (channels that do not deliver
+     * observables yet come first). Returns -1 if no more than
+     * min_tracking_channels channels are tracking.
+     */
+    int channel_to_stop(int min_tracking_channels);
+
 #if ENABLE_FPGA
     void start_acquisition_helper();
 
@@ -204,6 +236,9 @@ private:
 
     void push_back_signal(const Gnss_Signal& gs);
     void remove_signal(const Gnss_Signal& gs);
+    void move_satellite_signals(const Gnss_Satellite& satellite, bool to_front);
+    double predicted_doppler(const Gnss_Signal& gs);  // 0 Hz if there is no prediction
+    int acquisition_channels_limit() const;           // 1 if the acquisition is limited by the load governor
     void print_help();
     void check_desktop_conf_in_fpga_env();
 
@@ -231,6 +266,7 @@ private:
     gr::basic_block_sptr GnssSynchroAcquisitionMonitor_;
     gr::basic_block_sptr GnssSynchroTrackingMonitor_;
     gr::basic_block_sptr NavDataMonitor_;
+    std::unique_ptr<Instrumentation_Monitor> InstrumentationMonitor_;
     channel_status_msg_receiver_sptr channels_status_;  // class that receives and stores the current status of the receiver channels
     galileo_e6_has_msg_receiver_sptr gal_e6_has_rx_;
     galileo_tow_map_sptr galileo_tow_map_;
@@ -254,6 +290,7 @@ private:
     std::list<Gnss_Signal> available_GLO_2G_signals_;
     std::list<Gnss_Signal> available_BDS_B1_signals_;
     std::list<Gnss_Signal> available_BDS_B3_signals_;
+    std::map<unsigned int, Gnss_Signal> stopped_signals_;  // signals of the stopped channels, by channel
 
     enum StringValue
     {
@@ -271,6 +308,8 @@ private:
         evBDS_B3
     };
     std::map<std::string, StringValue> mapStringValues_;
+    std::map<std::pair<std::string, uint32_t>, double> predicted_doppler_hz_;     // primary band Doppler, by system and PRN
+    std::map<std::pair<std::string, uint32_t>, double> predicted_elevation_deg_;  // by system and PRN
 
     std::string config_file_;
     std::string help_hint_;
@@ -289,8 +328,10 @@ private:
     bool enable_acquisition_monitor_;
     bool enable_tracking_monitor_;
     bool enable_navdata_monitor_;
+    bool enable_instrumentation_monitor_;
     bool enable_fpga_offloading_;
     bool enable_e6_has_rx_;
+    bool acquisition_limited_;
 };
 
 
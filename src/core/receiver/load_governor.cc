@@ -0,0 +1,80 @@
+/*!
+ * \file load_governor.cc
+ * \brief Implementation of a class that decides when the receiver has to shed
+ * processing load to keep up with a real-time signal source, and when it can
+ * take it back
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "load_governor.h"
+#include <algorithm>
+
+
+Load_Governor::Load_Governor(double max_lag_growth_s, double restore_hold_s)
+    : d_max_lag_growth_s(max_lag_growth_s),
+      d_restore_hold_s(restore_hold_s),
+      d_hold_s(restore_hold_s)
+{
+}
+
+
+Load_Action Load_Governor::update(double time_s, double lag_s, uint64_t dropped_samples, bool can_shed)
+{
+    if (!d_initialized)
+        {
+            d_initialized = true;
+            d_last_lag_s = lag_s;
+            d_last_dropped = dropped_samples;
+            d_last_change_s = time_s;
+            return Load_Action::none;
+        }
+
+    d_lag_growth_s = lag_s - d_last_lag_s;
+    d_new_drops = dropped_samples > d_last_dropped ? dropped_samples - d_last_dropped : 0;
+    d_last_lag_s = lag_s;
+    d_last_dropped = dropped_samples;
+    d_overloaded = (d_new_drops > 0) || (d_lag_growth_s > d_max_lag_growth_s);
+
+    if (d_overloaded)
+        {
+            if (time_s - d_last_restore_s < d_hold_s)
+                {
+                    // the last restore brought the overload back, wait longer next time
+                    d_hold_s = std::min(2.0 * d_hold_s, 8.0 * d_restore_hold_s);
+                }
+            d_restore_on_probation = false;
+            d_last_overload_s = time_s;
+            if (can_shed)
+                {
+                    d_level++;
+                    d_last_change_s = time_s;
+                    return Load_Action::shed;
+                }
+            return Load_Action::none;
+        }
+
+    if (d_restore_on_probation && (time_s - d_last_restore_s >= d_hold_s))
+        {
+            d_restore_on_probation = false;
+            d_hold_s = std::max(0.5 * d_hold_s, d_restore_hold_s);
+        }
+
+    if ((d_level > 0) && (time_s - d_last_overload_s >= d_hold_s) && (time_s - d_last_change_s >= d_hold_s))
+        {
+            d_level--;
+            d_last_change_s = time_s;
+            d_last_restore_s = time_s;
+            d_restore_on_probation = true;
+            return Load_Action::restore;
+        }
+    return Load_Action::none;
+}
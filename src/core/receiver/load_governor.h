@@ -0,0 +1,96 @@
+/*!
+ * \file load_governor.h
+ * \brief Interface of a class that decides when the receiver has to shed
+ * processing load to keep up with a real-time signal source, and when it can
+ * take it back
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_LOAD_GOVERNOR_H
+#define GNSS_SDR_LOAD_GOVERNOR_H
+
+#include <cstdint>
+#include <limits>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+enum class Load_Action
+{
+    none,
+    shed,    //!< Apply one more load shedding step
+    restore  //!< Undo the last load shedding step
+};
+
+
+/*!
+ * \brief Decides, from periodic measurements of the lag of the processing
+ * with respect to the signal source and of the samples dropped by the source,
+ * when the receiver has to shed processing load and when it can restore it.
+ *
+ * The receiver is overloaded in a period if the source dropped samples or if
+ * the lag grew by more than a threshold, and then one more shedding step is
+ * requested. Steps are restored one at a time, the last one first, once
+ * there has been no overload for a hold time. If an overload comes back
+ * within the hold time that follows a restore, the hold time is doubled (up
+ * to eight times its initial value); it is halved again after each restore
+ * that holds.
+ */
+class Load_Governor
+{
+public:
+    /*!
+     * \param[in] max_lag_growth_s Largest increase of the lag between two updates that is not an overload [s]
+     * \param[in] restore_hold_s Time without overloads before a step is restored [s]
+     */
+    Load_Governor(double max_lag_growth_s, double restore_hold_s);
+
+    /*!
+     * \brief Takes a new measurement and returns the action to apply
+     *
+     * \param[in] time_s Wall clock time of the measurement [s]
+     * \param[in] lag_s Lag of the processing with respect to the signal source [s]
+     * \param[in] dropped_samples Samples dropped by the signal source since the start
+     * \param[in] can_shed False if there is nothing left to shed
+     */
+    Load_Action update(double time_s, double lag_s, uint64_t dropped_samples, bool can_shed);
+
+    inline int level() const { return d_level; }                         //!< Number of shedding steps applied
+    inline bool overloaded() const { return d_overloaded; }              //!< True if the last update was an overload
+    inline double lag_growth_s() const { return d_lag_growth_s; }        //!< Lag growth in the last update [s]
+    inline uint64_t new_dropped_samples() const { return d_new_drops; }  //!< Samples dropped in the last update
+    inline double hold_s() const { return d_hold_s; }                    //!< Current hold time [s]
+
+private:
+    double d_max_lag_growth_s;
+    double d_restore_hold_s;
+    double d_hold_s;
+    double d_last_lag_s{0.0};
+    double d_lag_growth_s{0.0};
+    double d_last_change_s{0.0};
+    double d_last_overload_s{-std::numeric_limits<double>::infinity()};
+    double d_last_restore_s{-std::numeric_limits<double>::infinity()};
+    uint64_t d_last_dropped{0};
+    uint64_t d_new_drops{0};
+    int d_level{0};
+    bool d_initialized{false};
+    bool d_overloaded{false};
+    bool d_restore_on_probation{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_LOAD_GOVERNOR_H
@@ -30,11 +30,9 @@
 #include "galileo_ephemeris.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
-#include <bitset>
+#include "gnss_packed_bits.h"
 #include <cstdint>
 #include <string>
-#include <utility>
-#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -53,6 +51,7 @@ public:
     Galileo_Fnav_Message() = default;
 
     void split_page(const std::string& page_string);
+    void split_page(const Gnss_Packed_Bits<GALILEO_FNAV_PAGE_BITS>& page_bits);
     bool have_new_ephemeris();
     bool have_new_iono_and_GST();
     bool have_new_utc_model();
@@ -138,12 +137,12 @@ public:
     }
 
 private:
-    bool CRC_test(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, uint32_t checksum) const;
-    void decode_page(const std::string& data);
-    uint64_t read_navigation_unsigned(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    int64_t read_navigation_signed(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+    bool CRC_test(const Gnss_Packed_Bits<GALILEO_FNAV_PAGE_BITS>& bits, uint32_t checksum) const;
+    void decode_page(const Gnss_Packed_Bits<GALILEO_FNAV_PAGE_BITS>& data_bits);
+    uint64_t read_navigation_unsigned(const Gnss_Packed_Bits<GALILEO_FNAV_PAGE_BITS>& bits, const Gnss_Bit_Field& parameter) const;
+    int64_t read_navigation_signed(const Gnss_Packed_Bits<GALILEO_FNAV_PAGE_BITS>& bits, const Gnss_Bit_Field& parameter) const;
 
-    std::string omega0_1{};
+    uint32_t omega0_1{};  // 4 MSBs of Omega0 for SVID2, sent in page 5
     // std::string omega0_2{};
     // bool omega_flag{};
 
@@ -24,8 +24,8 @@
 #include "galileo_ephemeris.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
+#include "gnss_packed_bits.h"
 #include "gnss_sdr_make_unique.h"  // for std::unique_ptr in C++11
-#include <bitset>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -57,6 +57,11 @@ public:
      */
     void split_page(std::string page_string, int32_t flag_even_word);
 
+    /*
+     * \brief Same as above, taking the page part as packed bits
+     */
+    void split_page(const Gnss_Packed_Bits<GALILEO_INAV_PAGE_PART_BITS>& page_part, int32_t flag_even_word);
+
     /*
      * \brief Takes in input Data_jk (128 bit) and split it in ephemeris parameters according ICD 4.3.5
      *
@@ -64,6 +69,11 @@ public:
      */
     int32_t page_jk_decoder(const char* data_jk);
 
+    /*
+     * \brief Same as above, taking Data_jk as packed bits
+     */
+    int32_t page_jk_decoder(const Gnss_Packed_Bits<GALILEO_DATA_JK_BITS>& data_jk_bits);
+
     /*
      * \brief Returns true if new Ephemeris has arrived. The flag is set to false when the function is executed
      */
@@ -221,22 +231,21 @@ public:
     }
 
 private:
-    bool CRC_test(const std::bitset<GALILEO_DATA_FRAME_BITS>& bits, uint32_t checksum) const;
-    bool read_navigation_bool(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    uint64_t read_navigation_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    uint64_t read_page_type_unsigned(const std::bitset<GALILEO_PAGE_TYPE_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    int64_t read_navigation_signed(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    uint8_t read_octet_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    void read_page_1(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    void read_page_2(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    void read_page_3(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    void read_page_4(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_1(const std::vector<uint8_t>& decoded) const;
-    std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_2(const std::vector<uint8_t>& decoded) const;
-    std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_3(const std::vector<uint8_t>& decoded) const;
-    std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_4(const std::vector<uint8_t>& decoded) const;
-
-    std::string page_Even{};
+    bool CRC_test(const Gnss_Packed_Bits<GALILEO_INAV_PAGE_BITS>& page_bits, uint32_t checksum) const;
+    bool read_navigation_bool(const Gnss_Packed_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Bit_Field& parameter) const;
+    uint64_t read_navigation_unsigned(const Gnss_Packed_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Bit_Field& parameter) const;
+    int64_t read_navigation_signed(const Gnss_Packed_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Bit_Field& parameter) const;
+    uint8_t read_octet_unsigned(const Gnss_Packed_Bits<GALILEO_DATA_JK_BITS>& bits, const Gnss_Bit_Field& parameter) const;
+    void read_page_1(const Gnss_Packed_Bits<GALILEO_DATA_JK_BITS>& data_bits);
+    void read_page_2(const Gnss_Packed_Bits<GALILEO_DATA_JK_BITS>& data_bits);
+    void read_page_3(const Gnss_Packed_Bits<GALILEO_DATA_JK_BITS>& data_bits);
+    void read_page_4(const Gnss_Packed_Bits<GALILEO_DATA_JK_BITS>& data_bits);
+    Gnss_Packed_Bits<GALILEO_DATA_JK_BITS> regenerate_page_1(const std::vector<uint8_t>& decoded) const;
+    Gnss_Packed_Bits<GALILEO_DATA_JK_BITS> regenerate_page_2(const std::vector<uint8_t>& decoded) const;
+    Gnss_Packed_Bits<GALILEO_DATA_JK_BITS> regenerate_page_3(const std::vector<uint8_t>& decoded) const;
+    Gnss_Packed_Bits<GALILEO_DATA_JK_BITS> regenerate_page_4(const std::vector<uint8_t>& decoded) const;
+
+    Gnss_Packed_Bits<GALILEO_INAV_PAGE_BITS> page_INAV{};  // Even page part (without tail bits) followed by the odd page part
 
     std::vector<uint8_t> rs_buffer;   // Reed-Solomon buffer
     std::unique_ptr<ReedSolomon> rs;  // The Reed-Solomon decoder
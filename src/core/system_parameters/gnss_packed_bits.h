@@ -0,0 +1,202 @@
+/*!
+ * \file gnss_packed_bits.h
+ * \brief Container of navigation message bits packed in 64-bit words, with
+ * branch-free extraction of the message fields.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_PACKED_BITS_H
+#define GNSS_SDR_GNSS_PACKED_BITS_H
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Location of a field in a navigation message, as given in the ICD
+ * tables: \p first is the position (starting at 1) of its most significant
+ * bit, counted from the first transmitted bit, and \p length is its number of
+ * bits (from 1 to 64).
+ */
+struct Gnss_Bit_Field
+{
+    int32_t first;
+    int32_t length;
+};
+
+
+/*!
+ * \brief Fixed-size sequence of N bits, stored in transmission order (the
+ * first transmitted bit is the most significant bit of the first word).
+ *
+ * A field is read from a window of two consecutive words, so the extraction
+ * cost does not depend on the field length and it does not branch. The
+ * storage has an extra word at the end, always zero, so the window never goes
+ * out of bounds.
+ */
+template <size_t N>
+class Gnss_Packed_Bits
+{
+public:
+    Gnss_Packed_Bits() = default;
+
+    /*!
+     * \brief Packs a string of '0' and '1' characters. Characters beyond N
+     * are ignored.
+     */
+    explicit Gnss_Packed_Bits(const std::string& bits)
+    {
+        const size_t n = bits.size() < N ? bits.size() : N;
+        for (size_t i = 0; i < n; i++)
+            {
+                set(i, bits[i] == '1');
+            }
+    }
+
+    /*!
+     * \brief Packs a std::bitset, whose element N - 1 is the first
+     * transmitted bit (as returned by the std::bitset string constructor).
+     */
+    explicit Gnss_Packed_Bits(const std::bitset<N>& bits)
+    {
+        for (size_t i = 0; i < N; i++)
+            {
+                set(i, bits[N - 1 - i]);
+            }
+    }
+
+    /*!
+     * \brief Packs \p num_bits hard decisions, such as the output of the
+     * Viterbi decoder, starting at bit \p pos. Values greater than zero are
+     * taken as ones.
+     */
+    template <typename T>
+    void assign(const T* bits, size_t num_bits, size_t pos = 0)
+    {
+        for (size_t i = 0; i < num_bits; i++)
+            {
+                set(pos + i, bits[i] > 0);
+            }
+    }
+
+    static constexpr size_t size()
+    {
+        return N;
+    }
+
+    /*!
+     * \brief Returns bit \p pos, starting at 0 for the first transmitted bit
+     */
+    inline bool test(size_t pos) const
+    {
+        return ((d_words[pos >> 6U] >> (63U - (pos & 63U))) & 1U) != 0;
+    }
+
+    inline void set(size_t pos, bool value = true)
+    {
+        const uint64_t mask = 1ULL << (63U - (pos & 63U));
+        d_words[pos >> 6U] = (d_words[pos >> 6U] & ~mask) | (value ? mask : 0ULL);
+    }
+
+    inline uint64_t read_unsigned(const Gnss_Bit_Field& field) const
+    {
+        return window(field.first - 1) >> (64 - field.length);
+    }
+
+    inline int64_t read_signed(const Gnss_Bit_Field& field) const
+    {
+        // arithmetic shift extends the sign bit
+        return static_cast<int64_t>(window(field.first - 1)) >> (64 - field.length);
+    }
+
+    inline bool read_bool(const Gnss_Bit_Field& field) const
+    {
+        return test(static_cast<size_t>(field.first - 1));
+    }
+
+    /*!
+     * \brief Writes the \p field.length least significant bits of \p value
+     * into \p field
+     */
+    inline void write_unsigned(const Gnss_Bit_Field& field, uint64_t value)
+    {
+        const auto pos = static_cast<size_t>(field.first - 1);
+        const size_t w = pos >> 6U;
+        const uint32_t off = pos & 63U;
+        const uint32_t unused = 64U - static_cast<uint32_t>(field.length);
+        const uint64_t mask = ~0ULL << unused;
+        const uint64_t aligned = value << unused;
+        d_words[w] = (d_words[w] & ~(mask >> off)) | (aligned >> off);
+        if (off + field.length > 64)
+            {
+                d_words[w + 1] = (d_words[w + 1] & ~(mask << (64U - off))) | (aligned << (64U - off));
+            }
+    }
+
+    /*!
+     * \brief Copies \p length bits of \p src, starting at \p src_pos, to
+     * this sequence starting at \p pos
+     */
+    template <size_t M>
+    void copy(const Gnss_Packed_Bits<M>& src, size_t src_pos, size_t pos, size_t length)
+    {
+        while (length > 0)
+            {
+                const int32_t chunk = length < 64 ? static_cast<int32_t>(length) : 64;
+                write_unsigned({static_cast<int32_t>(pos + 1), chunk}, src.read_unsigned({static_cast<int32_t>(src_pos + 1), chunk}));
+                src_pos += chunk;
+                pos += chunk;
+                length -= chunk;
+            }
+    }
+
+    /*!
+     * \brief Returns the bits as a string of '0' and '1' characters
+     */
+    std::string to_string() const
+    {
+        std::string bits(N, '0');
+        for (size_t i = 0; i < N; i++)
+            {
+                if (test(i))
+                    {
+                        bits[i] = '1';
+                    }
+            }
+        return bits;
+    }
+
+private:
+    // 64 bits starting at bit pos, zero-padded beyond the end of the sequence
+    inline uint64_t window(int32_t pos) const
+    {
+        const auto w = static_cast<size_t>(pos) >> 6U;
+        const uint32_t off = static_cast<uint32_t>(pos) & 63U;
+        // the second shift is split in two so it is never a shift by 64
+        return (d_words[w] << off) | ((d_words[w + 1] >> 1U) >> (63U - off));
+    }
+
+    std::array<uint64_t, (N + 63) / 64 + 1> d_words{};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_PACKED_BITS_H
@@ -16,6 +16,7 @@
  */
 
 #include "reed_solomon.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>
 #include <cstring>
 #include <iostream>
@@ -482,6 +483,7 @@ ReedSolomon::ReedSolomon(const std::string& gnss_signal)
 
     init_log_tables();
     init_alpha_tables();
+    init_multiply_tables();
 }
 
 
@@ -571,6 +573,7 @@ ReedSolomon::ReedSolomon(int nroots,
 
     init_log_tables();
     init_alpha_tables();
+    init_multiply_tables();
 }
 
 
@@ -685,6 +688,43 @@ void ReedSolomon::init_alpha_tables()
 }
 
 
+void ReedSolomon::init_multiply_tables()
+{
+    // Products of each element k by all the possible values of the low and
+    // the high nibble of a symbol, so k * b = k * (b & 0x0F) + k * (b & 0xF0)
+    d_nibble_products = std::vector<uint8_t>(256 * 32);
+    for (int k = 0; k < 256; k++)
+        {
+            for (int i = 0; i < 16; i++)
+                {
+                    d_nibble_products[32 * k + i] = galois_mul(k, i);
+                    d_nibble_products[32 * k + 16 + i] = galois_mul(k, i << 4);
+                }
+        }
+
+    // The syndrome i evaluates data(x) at the root alpha^((fcr + i) * prim),
+    // so the symbol j is weighted by that root raised to n - 1 - j
+    const int n = d_symbols_per_block - d_pad;
+    d_syndrome_powers = std::vector<uint8_t>(n * d_nroots);
+    for (int j = 0; j < n; j++)
+        {
+            for (int i = 0; i < d_nroots; i++)
+                {
+                    d_syndrome_powers[j * d_nroots + i] = d_alpha_to[((d_fcr + i) * d_prim * (n - 1 - j)) % d_symbols_per_block];
+                }
+        }
+}
+
+
+void ReedSolomon::multiply_add(uint8_t* acc, const uint8_t* in, uint8_t k, size_t length) const
+{
+    if (length > 0)
+        {
+            volk_gnsssdr_8u_x2_gf256_multiply_add_8u(acc, acc, in, d_nibble_products.data() + 32 * k, static_cast<unsigned int>(length));
+        }
+}
+
+
 std::vector<uint8_t> ReedSolomon::encode_with_generator_matrix(const std::vector<uint8_t>& data_to_encode) const
 {
     std::vector<uint8_t> encoded_output(d_data_symbols_shortened, 0);
@@ -792,7 +832,7 @@ int ReedSolomon::decode(std::vector<uint8_t>& data_to_decode, const std::vector<
     else
         {
             // Create unshortened code vector
-            std::vector<uint8_t> unshortened_code_vector(d_symbols_per_block, 0);
+            std::array<uint8_t, d_symbols_per_block> unshortened_code_vector{};
             std::copy(data_to_decode.begin(), data_to_decode.begin() + d_info_symbols_shortened, unshortened_code_vector.begin());
             std::copy(data_to_decode.begin() + d_info_symbols_shortened, data_to_decode.begin() + d_data_symbols_shortened, unshortened_code_vector.begin() + d_data_in_block);
 
@@ -808,6 +848,131 @@ int ReedSolomon::decode(std::vector<uint8_t>& data_to_decode, const std::vector<
 }
 
 
+int ReedSolomon::decode_with_generator_matrix(const std::vector<int>& received_positions,
+    const std::vector<std::vector<uint8_t>>& codewords,
+    std::vector<std::vector<uint8_t>>& decoded)
+{
+    if (d_rows_G == 0)
+        {
+            std::cerr << "Reed Solomon usage problem: Generator matrix is not defined.\n";
+            return -1;
+        }
+    const size_t k = received_positions.size();
+    if (k == 0 || k > d_columns_G || codewords.size() != d_rows_G || decoded.size() < k)
+        {
+            std::cerr << "Reed Solomon usage error: wrong input size in decode_with_generator_matrix method.\n";
+            return -1;
+        }
+    const size_t width = decoded[0].size();
+    for (size_t i = 0; i < k; i++)
+        {
+            if (received_positions[i] < 0 || static_cast<size_t>(received_positions[i]) >= d_rows_G ||
+                codewords[received_positions[i]].size() != width || decoded[i].size() != width)
+                {
+                    std::cerr << "Reed Solomon usage error: wrong input size in decode_with_generator_matrix method.\n";
+                    return -1;
+                }
+        }
+
+    const std::vector<uint8_t>* inverse = nullptr;
+    for (const auto& entry : d_inverse_cache)
+        {
+            if (entry.first == received_positions)
+                {
+                    inverse = &entry.second;
+                    break;
+                }
+        }
+    if (inverse == nullptr)
+        {
+            std::vector<uint8_t> new_inverse;
+            if (!invert_generator_submatrix(received_positions, new_inverse))
+                {
+                    return -1;
+                }
+            if (d_inverse_cache.size() < d_inverse_cache_size)
+                {
+                    d_inverse_cache.emplace_back(received_positions, std::move(new_inverse));
+                    inverse = &d_inverse_cache.back().second;
+                }
+            else
+                {
+                    d_inverse_cache[d_inverse_cache_next] = {received_positions, std::move(new_inverse)};
+                    inverse = &d_inverse_cache[d_inverse_cache_next].second;
+                    d_inverse_cache_next = (d_inverse_cache_next + 1) % d_inverse_cache_size;
+                }
+        }
+
+    // Each row of information symbols is a combination of the received rows
+    for (size_t i = 0; i < k; i++)
+        {
+            std::fill(decoded[i].begin(), decoded[i].end(), 0);
+            for (size_t j = 0; j < k; j++)
+                {
+                    const uint8_t coeff = (*inverse)[i * k + j];
+                    if (coeff != 0)
+                        {
+                            multiply_add(decoded[i].data(), codewords[received_positions[j]].data(), coeff, width);
+                        }
+                }
+        }
+    return 0;
+}
+
+
+bool ReedSolomon::invert_generator_submatrix(const std::vector<int>& received_positions, std::vector<uint8_t>& inverse) const
+{
+    // Gauss-Jordan elimination of [A | I], where the rows of A are the first
+    // k elements of the rows of the generator matrix at the received positions
+    const size_t k = received_positions.size();
+    const size_t width = 2 * k;
+    std::vector<uint8_t> m(k * width, 0);
+    for (size_t r = 0; r < k; r++)
+        {
+            std::copy(d_genmatrix[received_positions[r]].begin(), d_genmatrix[received_positions[r]].begin() + k, m.begin() + r * width);
+            m[r * width + k + r] = 1;
+        }
+
+    std::vector<uint8_t> pivot_row(width);
+    for (size_t col = 0; col < k; col++)
+        {
+            size_t pivot = col;
+            while (pivot < k && m[pivot * width + col] == 0)
+                {
+                    pivot++;
+                }
+            if (pivot == k)
+                {
+                    // The received positions do not determine the information symbols
+                    return false;
+                }
+            std::fill(pivot_row.begin(), pivot_row.end(), 0);
+            const uint8_t pivot_inv = d_alpha_to[(d_symbols_per_block - d_index_of[m[pivot * width + col]]) % d_symbols_per_block];
+            multiply_add(pivot_row.data(), &m[pivot * width], pivot_inv, width);
+            if (pivot != col)
+                {
+                    std::copy(m.begin() + col * width, m.begin() + (col + 1) * width, m.begin() + pivot * width);
+                }
+            std::copy(pivot_row.begin(), pivot_row.end(), m.begin() + col * width);
+            for (size_t r = 0; r < k; r++)
+                {
+                    const uint8_t factor = m[r * width + col];
+                    if (r != col && factor != 0)
+                        {
+                            multiply_add(&m[r * width], pivot_row.data(), factor, width);
+                        }
+                }
+        }
+
+    inverse = std::vector<uint8_t>(k * k);
+    for (size_t r = 0; r < k; r++)
+        {
+            std::copy(m.begin() + r * width + k, m.begin() + (r + 1) * width, inverse.begin() + r * k);
+        }
+    return true;
+}
+
+
 int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) const
 {
     int deg_lambda;
@@ -828,34 +993,23 @@ int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) co
     uint8_t den;
     uint8_t discr_r;
 
-    std::vector<uint8_t> lambda(d_nroots + 1);  // Err+Eras Locator poly
-    std::vector<uint8_t> s(d_nroots);           // syndrome poly
-    std::vector<uint8_t> b(d_nroots + 1);
-    std::vector<uint8_t> t(d_nroots + 1);
-    std::vector<uint8_t> omega(d_nroots + 1);
-    std::vector<uint8_t> root(d_nroots);
-    std::vector<uint8_t> reg(d_nroots + 1);
-    std::vector<uint8_t> loc(d_nroots);
+    std::array<uint8_t, d_symbols_per_block + 1> lambda{};  // Err+Eras Locator poly
+    std::array<uint8_t, d_symbols_per_block + 1> s{};       // syndrome poly
+    std::array<uint8_t, d_symbols_per_block + 1> b{};
+    std::array<uint8_t, d_symbols_per_block + 1> t{};
+    std::array<uint8_t, d_symbols_per_block + 1> omega{};
+    std::array<uint8_t, d_symbols_per_block + 1> root{};
+    std::array<uint8_t, d_symbols_per_block + 1> reg{};
+    std::array<uint8_t, d_symbols_per_block + 1> loc{};
 
     // Syndrome computation
-    // form the syndromes; i.e., evaluate data(x) at roots of g(x)
-    for (i = 0; i < d_nroots; i++)
-        {
-            s[i] = data[0];
-        }
-
-    for (j = 1; j < d_symbols_per_block - d_pad; j++)
+    // form the syndromes; i.e., evaluate data(x) at roots of g(x). Each
+    // non-zero symbol adds its contribution to all the syndromes at once.
+    for (j = 0; j < d_symbols_per_block - d_pad; j++)
         {
-            for (i = 0; i < d_nroots; i++)
+            if (data[j] != 0)
                 {
-                    if (s[i] == 0)
-                        {
-                            s[i] = data[j];
-                        }
-                    else
-                        {
-                            s[i] = data[j] ^ d_alpha_to[mod255(d_index_of[s[i]] + (d_fcr + i) * d_prim)];
-                        }
+                    multiply_add(s.data(), d_syndrome_powers.data() + j * d_nroots, data[j], d_nroots);
                 }
         }
 
@@ -918,7 +1072,8 @@ int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) co
             if (discr_r == d_a0)
                 {
                     // line below: B(x) <-- x*B(x)
-                    b.insert(b.begin(), d_a0);
+                    memmove(&b[1], &b[0], d_nroots * sizeof(b[0]));
+                    b[0] = d_a0;
                 }
             else
                 {
@@ -947,7 +1102,8 @@ int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) co
                     else
                         {
                             // line below: B(x) <-- x*B(x)
-                            b.insert(b.begin(), d_a0);
+                            memmove(&b[1], &b[0], d_nroots * sizeof(b[0]));
+                            b[0] = d_a0;
                         }
                     memcpy(&lambda[0], t.data(), (d_nroots + 1) * sizeof(t[0]));
                 }
@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -101,6 +102,33 @@ public:
     int decode(std::vector<uint8_t>& data_to_decode,
         const std::vector<int>& erasure_positions = std::vector<int>{}) const;
 
+    /*!
+     * \brief Erasure-only decoding of several codewords received at the same
+     * positions, stored as the columns of a matrix. The information symbols
+     * are obtained by inverting the submatrix of the generator matrix given
+     * by the received positions, which must be defined.
+     *
+     * received_positions - positions (starting at 0) of the received
+     *  symbols. If there are k of them, they give the first k information
+     *  symbols, and the rest of them are known to be zero.
+     *
+     * codewords - matrix with a row for each symbol of the (shortened) code
+     *  and a column for each codeword. Only the rows in received_positions
+     *  are read.
+     *
+     * decoded - matrix with the same number of columns. Its first k rows
+     *  are overwritten with the decoded information symbols.
+     *
+     * The inverse matrices of the last sets of received positions are
+     * cached, so decoding again with the same positions only costs the
+     * matrix product.
+     *
+     * Returns 0 if decoding succeeded, or -1 if it failed.
+     */
+    int decode_with_generator_matrix(const std::vector<int>& received_positions,
+        const std::vector<std::vector<uint8_t>>& codewords,
+        std::vector<std::vector<uint8_t>>& decoded);
+
     /*!
      * \brief Encode data with the generator matrix (for testing purposes)
      *
@@ -118,8 +146,9 @@ public:
     std::vector<uint8_t> encode_with_generator_poly(const std::vector<uint8_t>& data_to_encode) const;
 
 private:
-    static const int d_symbols_per_block = 255;  // the total number of symbols in a RS block.
-    static const int d_symsize = 8;              // symbol size, in bits.
+    static const int d_symbols_per_block = 255;    // the total number of symbols in a RS block.
+    static const int d_symsize = 8;                // symbol size, in bits.
+    static const size_t d_inverse_cache_size = 8;  // number of cached inverse matrices
 
     int mod255(int x) const;
     int rs_min(int a, int b) const;
@@ -130,8 +159,11 @@ private:
     uint8_t galois_mul_table(uint8_t a, uint8_t b) const;
 
     void encode_rs_8(const uint8_t* data, uint8_t* parity) const;
-    void init_log_tables();    // initialize d_log_table and d_antilog
-    void init_alpha_tables();  // initialize d_alpha_to, d_index_of
+    void init_log_tables();       // initialize d_log_table and d_antilog
+    void init_alpha_tables();     // initialize d_alpha_to, d_index_of
+    void init_multiply_tables();  // initialize d_nibble_products, d_syndrome_powers
+    void multiply_add(uint8_t* acc, const uint8_t* in, uint8_t k, size_t length) const;  // acc += k * in
+    bool invert_generator_submatrix(const std::vector<int>& received_positions, std::vector<uint8_t>& inverse) const;
 
     std::array<uint8_t, 256> d_alpha_to{};   // used for decoding
     std::array<uint8_t, 256> d_index_of{};   // used for decoding
@@ -141,6 +173,11 @@ private:
     std::vector<std::vector<uint8_t>> d_genmatrix;  // used for encoding
     std::vector<uint8_t> d_genpoly_coeff;           // used for encoding
     std::vector<uint8_t> d_genpoly_index;           // used for encoding
+    std::vector<uint8_t> d_nibble_products;         // k * i and k * (i << 4), i = 0..15, for each k
+    std::vector<uint8_t> d_syndrome_powers;         // weight of each received symbol in each syndrome
+
+    std::vector<std::pair<std::vector<int>, std::vector<uint8_t>>> d_inverse_cache;  // received positions, inverse matrix
+    size_t d_inverse_cache_next{};                                                 // next cache entry to be replaced
 
     size_t d_data_in_block{};           // number of information symbols in a block
     size_t d_rows_G{};                  // number of rows of the generator matrix
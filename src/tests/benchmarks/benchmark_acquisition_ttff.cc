@@ -0,0 +1,151 @@
+/*!
+ * \file benchmark_acquisition_ttff.cc
+ * \brief Benchmark of the acquisition stage of a cold start: time to search
+ * the whole Doppler range of several satellites at once, for different
+ * numbers of Doppler search threads
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "acq_fft_cache.h"
+#include "acq_worker_pool.h"
+#include <benchmark/benchmark.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t fft_size = 4000;  // 1 ms at 4 Msps
+constexpr float fs_hz = 4e6;
+constexpr int doppler_max_hz = 10000;  // cold start, unknown receiver clock
+constexpr int doppler_step_hz = 250;
+constexpr int n_channels = 8;
+
+
+struct Acq_Channel
+{
+    volk_gnsssdr::vector<std::complex<float>> fft_code = volk_gnsssdr::vector<std::complex<float>>(fft_size);
+    volk_gnsssdr::vector<volk_gnsssdr::vector<float>> magnitude_grid;
+    uint32_t peak_doppler_index{0};
+    uint32_t peak_code_phase{0};
+};
+
+
+volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> make_doppler_wipeoffs(uint32_t num_doppler_bins)
+{
+    volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> wipeoffs(num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(fft_size));
+    for (uint32_t bin = 0; bin < num_doppler_bins; bin++)
+        {
+            const auto doppler_hz = static_cast<float>(-doppler_max_hz + static_cast<int>(bin) * doppler_step_hz);
+            const float phase_step_rad = -static_cast<float>(TWO_PI) * doppler_hz / fs_hz;
+            for (uint32_t n = 0; n < fft_size; n++)
+                {
+                    wipeoffs[bin][n] = std::polar(1.0F, phase_step_rad * static_cast<float>(n));
+                }
+        }
+    return wipeoffs;
+}
+
+
+// Same steps as pcps_acquisition::doppler_search() and the peak search that
+// follows it in acquisition_core()
+void search_satellite(Acq_Channel& channel,
+    const std::shared_ptr<Acq_Worker_Pool>& pool,
+    const std::complex<float>* in,
+    const volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>& wipeoffs)
+{
+    const auto num_doppler_bins = static_cast<uint32_t>(wipeoffs.size());
+    std::vector<Acq_Fft_Plans> plans;
+    plans.reserve(pool->size());
+    for (uint32_t worker = 0; worker < pool->size(); worker++)
+        {
+            plans.emplace_back(fft_size);
+        }
+    pool->run(num_doppler_bins, [&](uint32_t worker, uint32_t bin_begin, uint32_t bin_end) {
+        gnss_fft_complex_fwd* fft_if = plans[worker].fwd();
+        gnss_fft_complex_rev* ifft = plans[worker].rev();
+        for (uint32_t doppler_index = bin_begin; doppler_index < bin_end; doppler_index++)
+            {
+                volk_32fc_x2_multiply_32fc(fft_if->get_inbuf(), in, wipeoffs[doppler_index].data(), fft_size);
+                fft_if->execute();
+                volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), fft_if->get_outbuf(), channel.fft_code.data(), fft_size);
+                ifft->execute();
+                volk_32fc_magnitude_squared_32f(channel.magnitude_grid[doppler_index].data(), ifft->get_outbuf(), fft_size);
+            }
+    });
+
+    float peak = 0.0;
+    for (uint32_t doppler_index = 0; doppler_index < num_doppler_bins; doppler_index++)
+        {
+            uint32_t index = 0;
+            volk_gnsssdr_32f_index_max_32u(&index, channel.magnitude_grid[doppler_index].data(), fft_size);
+            if (channel.magnitude_grid[doppler_index][index] > peak)
+                {
+                    peak = channel.magnitude_grid[doppler_index][index];
+                    channel.peak_doppler_index = doppler_index;
+                    channel.peak_code_phase = index;
+                }
+        }
+}
+}  // namespace
+
+
+void bm_cold_start_acquisition(benchmark::State& state)
+{
+    // 0 means one Doppler search thread per hardware thread
+    const auto doppler_search_threads = static_cast<uint32_t>(state.range(0));
+    const auto pool = Acq_Worker_Pool::get_shared(doppler_search_threads);
+    const auto num_doppler_bins = static_cast<uint32_t>(2 * doppler_max_hz / doppler_step_hz + 1);
+    const auto wipeoffs = make_doppler_wipeoffs(num_doppler_bins);
+
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::normal_distribution<float> dist(0.0, 1.0);
+    volk_gnsssdr::vector<std::complex<float>> in(fft_size);
+    std::generate(in.begin(), in.end(), [&dist, &e2]() { return std::complex<float>(dist(e2), dist(e2)); });
+
+    std::vector<Acq_Channel> channels(n_channels);
+    for (auto& channel : channels)
+        {
+            std::generate(channel.fft_code.begin(), channel.fft_code.end(), [&dist, &e2]() { return std::complex<float>(dist(e2), dist(e2)); });
+            channel.magnitude_grid = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(num_doppler_bins, volk_gnsssdr::vector<float>(fft_size));
+        }
+
+    while (state.KeepRunning())
+        {
+            // all the channels start searching at the same time, each one in
+            // its own thread as in pcps_acquisition::general_work()
+            std::vector<std::thread> threads;
+            threads.reserve(n_channels);
+            for (auto& channel : channels)
+                {
+                    threads.emplace_back([&channel, &pool, &in, &wipeoffs]() { search_satellite(channel, pool, in.data(), wipeoffs); });
+                }
+            for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+        }
+    state.counters["doppler_search_threads"] = pool->size();
+}
+
+
+BENCHMARK(bm_cold_start_acquisition)->Arg(1)->Arg(2)->Arg(4)->Arg(0)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_MAIN();
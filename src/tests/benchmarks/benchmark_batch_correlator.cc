@@ -0,0 +1,142 @@
+/*!
+ * \file benchmark_batch_correlator.cc
+ * \brief Benchmark for per-channel vs. batched multi-channel correlation,
+ * with one thread per channel
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_batch.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int signal_length_samples = 4000;  // 1 ms at 4 Msps
+constexpr int code_length_chips = 1023;
+constexpr int n_correlators = 3;
+
+
+struct Channel_Data
+{
+    std::vector<float> local_code;
+    std::vector<float> shifts_chips;
+    std::vector<std::complex<float>> corr_out;
+    Cpu_Multicorrelator_Real_Codes correlator;
+    int offset;
+};
+
+
+std::vector<std::complex<float>> make_input(int n_channels)
+{
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::vector<std::complex<float>> sig_in(signal_length_samples + n_channels * 16);
+    std::generate(sig_in.begin(), sig_in.end(), [&dist, &e2]() { return std::complex<float>(dist(e2), dist(e2)); });
+    return sig_in;
+}
+
+
+std::vector<std::unique_ptr<Channel_Data>> make_channels(int n_channels, const std::vector<std::complex<float>>& sig_in, bool batch)
+{
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::uniform_int_distribution<int> bit(0, 1);
+    std::vector<std::unique_ptr<Channel_Data>> channels;
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            auto channel = std::make_unique<Channel_Data>();
+            channel->local_code.resize(code_length_chips);
+            std::generate(channel->local_code.begin(), channel->local_code.end(), [&bit, &e2]() { return bit(e2) ? 1.0F : -1.0F; });
+            channel->shifts_chips = {-0.5, 0.0, 0.5};
+            channel->corr_out.resize(n_correlators);
+            // every channel starts its integration at a slightly different sample
+            channel->offset = ch * 16;
+            channel->correlator.init(2 * signal_length_samples, n_correlators);
+            channel->correlator.set_high_dynamics_resampler(false);
+            channel->correlator.set_batch_engine(batch);
+            channel->correlator.set_local_code_and_taps(code_length_chips, channel->local_code.data(), channel->shifts_chips.data());
+            channel->correlator.set_input_output_vectors(channel->corr_out.data(), sig_in.data() + channel->offset);
+            channels.push_back(std::move(channel));
+        }
+    return channels;
+}
+}  // namespace
+
+
+// Each channel runs in its own thread, as the tracking blocks do, and
+// correlates integrations_per_iteration consecutive integration periods
+void run_channels(std::vector<std::unique_ptr<Channel_Data>>& channels)
+{
+    constexpr int integrations_per_iteration = 20;
+    const float code_phase_step_chips = static_cast<float>(code_length_chips) / static_cast<float>(signal_length_samples);
+    std::vector<std::thread> threads;
+    threads.reserve(channels.size());
+    for (auto& channel : channels)
+        {
+            Channel_Data* data = channel.get();
+            threads.emplace_back([data, code_phase_step_chips]() {
+                for (int i = 0; i < integrations_per_iteration; i++)
+                    {
+                        data->correlator.Carrier_wipeoff_multicorrelator_resampler(0.1, 0.01, 0.0, code_phase_step_chips, 0.0, signal_length_samples);
+                    }
+            });
+        }
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+}
+
+
+void bm_per_channel(benchmark::State& state)
+{
+    const int n_channels = state.range(0);
+    const auto sig_in = make_input(n_channels);
+    auto channels = make_channels(n_channels, sig_in, false);
+
+    while (state.KeepRunning())
+        {
+            run_channels(channels);
+        }
+}
+
+
+void bm_batched(benchmark::State& state)
+{
+    const int n_channels = state.range(0);
+    const auto sig_in = make_input(n_channels);
+    auto channels = make_channels(n_channels, sig_in, true);
+    const uint64_t batches = Cpu_Multicorrelator_Batch::get_instance().executed_batches();
+    const uint64_t jobs = Cpu_Multicorrelator_Batch::get_instance().executed_jobs();
+
+    while (state.KeepRunning())
+        {
+            run_channels(channels);
+        }
+
+    const auto executed_batches = static_cast<double>(Cpu_Multicorrelator_Batch::get_instance().executed_batches() - batches);
+    const auto executed_jobs = static_cast<double>(Cpu_Multicorrelator_Batch::get_instance().executed_jobs() - jobs);
+    state.counters["jobs_per_batch"] = executed_batches > 0 ? executed_jobs / executed_batches : 0.0;
+}
+
+
+BENCHMARK(bm_per_channel)->Arg(8)->Arg(32)->Arg(64)->UseRealTime();
+BENCHMARK(bm_batched)->Arg(8)->Arg(32)->Arg(64)->UseRealTime();
+BENCHMARK_MAIN();
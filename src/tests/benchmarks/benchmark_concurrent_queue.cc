@@ -0,0 +1,113 @@
+/*!
+ * \file benchmark_concurrent_queue.cc
+ * \brief Benchmark for the queue that carries the channel events to the
+ * control thread, with several producers and a single consumer
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_queue.h"
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int64_t items_per_producer = 20000;
+
+
+// Former implementation: std::queue protected by a mutex, with a
+// notification of the condition variable on every push
+template <typename Data>
+class Locked_Queue
+{
+public:
+    void push(Data const& data)
+    {
+        std::unique_lock<std::mutex> lock(the_mutex);
+        the_queue.push(data);
+        lock.unlock();
+        the_condition_variable.notify_one();
+    }
+
+    void wait_and_pop(Data& popped_value)
+    {
+        std::unique_lock<std::mutex> lock(the_mutex);
+        while (the_queue.empty())
+            {
+                the_condition_variable.wait(lock);
+            }
+        popped_value = the_queue.front();
+        the_queue.pop();
+    }
+
+private:
+    std::queue<Data> the_queue;
+    std::mutex the_mutex;
+    std::condition_variable the_condition_variable;
+};
+
+
+// Events are shared pointers, as the pmt::pmt_t objects sent by the channels
+template <typename Queue>
+void run_producers_and_consumer(benchmark::State& state)
+{
+    const auto n_producers = static_cast<int>(state.range(0));
+    const auto event = std::make_shared<int64_t>(1);
+    while (state.KeepRunning())
+        {
+            Queue queue;
+            std::vector<std::thread> producers;
+            for (int p = 0; p < n_producers; p++)
+                {
+                    producers.emplace_back([&queue, &event]() {
+                        for (int64_t i = 0; i < items_per_producer; i++)
+                            {
+                                queue.push(event);
+                            }
+                    });
+                }
+            std::shared_ptr<int64_t> popped;
+            for (int64_t i = 0; i < n_producers * items_per_producer; i++)
+                {
+                    queue.wait_and_pop(popped);
+                    benchmark::DoNotOptimize(popped);
+                }
+            for (auto& producer : producers)
+                {
+                    producer.join();
+                }
+        }
+    state.SetItemsProcessed(state.iterations() * n_producers * items_per_producer);
+}
+}  // namespace
+
+
+void bm_locked_queue(benchmark::State& state)
+{
+    run_producers_and_consumer<Locked_Queue<std::shared_ptr<int64_t>>>(state);
+}
+
+
+void bm_concurrent_queue(benchmark::State& state)
+{
+    run_producers_and_consumer<Concurrent_Queue<std::shared_ptr<int64_t>>>(state);
+}
+
+
+BENCHMARK(bm_locked_queue)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK(bm_concurrent_queue)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+/*!
+ * \file benchmark_file_source.cc
+ * \brief Benchmark for the replay of sample files with the standard GNU Radio
+ * file source and with the memory-mapped file source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "mmap_file_source.h"
+#include "unpack_2bit_samples.h"
+#include <benchmark/benchmark.h>
+#include <gnuradio/blocks/file_source.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/top_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Formats of the file, selected by the benchmark argument:
+// 0: 8-bit samples, 1: 16-bit samples, 2: 2-bit samples packed in bytes
+constexpr size_t file_size_bytes = 128 * 1024 * 1024;
+const std::string file_name("./benchmark_file_source.dat");
+
+
+void create_test_file()
+{
+    static bool created = false;
+    if (!created)
+        {
+            std::vector<uint8_t> buffer(1024 * 1024);
+            std::mt19937 gen(1234);
+            std::uniform_int_distribution<int> dist(0, 255);
+            for (auto& b : buffer)
+                {
+                    b = static_cast<uint8_t>(dist(gen));
+                }
+            std::ofstream file(file_name, std::ios::binary);
+            for (size_t written = 0; written < file_size_bytes; written += buffer.size())
+                {
+                    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+                }
+            created = true;
+        }
+}
+
+
+template <typename Source_Factory>
+void replay_file(benchmark::State& state, const Source_Factory& make_source)
+{
+    create_test_file();
+    const auto format = state.range(0);
+    const size_t item_size = format == 1 ? sizeof(int16_t) : sizeof(int8_t);
+    for (auto _ : state)
+        {
+            auto top_block = gr::make_top_block("benchmark_file_source");
+            auto source = make_source(item_size);
+            if (format == 2)
+                {
+                    auto unpacker = make_unpack_2bit_samples(false, item_size, false);
+                    auto sink = gr::blocks::null_sink::make(sizeof(int8_t));
+                    top_block->connect(source, 0, unpacker, 0);
+                    top_block->connect(unpacker, 0, sink, 0);
+                }
+            else
+                {
+                    auto sink = gr::blocks::null_sink::make(item_size);
+                    top_block->connect(source, 0, sink, 0);
+                }
+            top_block->run();
+        }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(file_size_bytes));
+}
+}  // namespace
+
+
+void bm_file_source(benchmark::State& state)
+{
+    replay_file(state, [](size_t item_size) {
+        return gr::blocks::file_source::make(item_size, file_name.c_str(), false);
+    });
+}
+
+
+void bm_mmap_file_source(benchmark::State& state)
+{
+    replay_file(state, [](size_t item_size) {
+        return make_mmap_file_source(item_size, file_name, false);
+    });
+}
+
+
+BENCHMARK(bm_file_source)->DenseRange(0, 2)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_mmap_file_source)->DenseRange(0, 2)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    std::remove(file_name.c_str());
+    return 0;
+}
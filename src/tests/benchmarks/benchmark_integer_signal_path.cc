@@ -0,0 +1,226 @@
+/*!
+ * \file benchmark_integer_signal_path.cc
+ * \brief Benchmark of the tracking correlators fed with gr_complex, cshort and
+ * cbyte sample streams, with their accuracy
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_real_codes.h"
+#include "item_type_helpers.h"
+#include "lock_detectors.h"
+#include <benchmark/benchmark.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr double fs_hz = 4e6;
+constexpr int samples_per_code = 4000;  // 1 ms at 4 Msps
+constexpr int code_length_chips = 1023;
+constexpr int n_correlators = 3;
+constexpr int stream_codes = 2000;  // 2 s, 64 MB of gr_complex samples
+constexpr double doppler_hz = 1250.0;
+constexpr double cn0_db_hz = 45.0;
+constexpr double two_pi = 6.283185307179586;
+
+
+// Streams as they would be delivered by the signal source: the same noisy
+// signal (unit noise variance per component) in floating point, in 16-bit
+// integers, in 8-bit integers and in 2-bit levels (+-1, +-3) stored in bytes.
+struct Test_Streams
+{
+    std::vector<float> code;
+    std::vector<std::complex<float>> fc;
+    std::vector<int16_t> sc;
+    std::vector<int8_t> bc;
+    std::vector<int8_t> bc_2bit;
+};
+
+
+const Test_Streams& get_streams()
+{
+    static const Test_Streams streams = []() {
+        Test_Streams s;
+        std::default_random_engine e2(1);
+        std::uniform_int_distribution<int> bit(0, 1);
+        std::normal_distribution<float> noise(0.0, 1.0);
+        s.code.resize(code_length_chips);
+        std::generate(s.code.begin(), s.code.end(), [&]() { return bit(e2) ? 1.0F : -1.0F; });
+
+        const double amplitude = std::sqrt(2.0 * std::pow(10.0, cn0_db_hz / 10.0) / fs_hz);
+        const size_t n = static_cast<size_t>(stream_codes) * samples_per_code;
+        s.fc.resize(n);
+        s.sc.resize(2 * n);
+        s.bc.resize(2 * n);
+        s.bc_2bit.resize(2 * n);
+        const auto quantize_2bit = [](float x) -> int8_t { return static_cast<int8_t>(x < 0.0F ? (x < -1.0F ? -3 : -1) : (x < 1.0F ? 1 : 3)); };
+        for (size_t i = 0; i < n; i++)
+            {
+                const auto chip = static_cast<size_t>(static_cast<double>(i % samples_per_code) * code_length_chips / samples_per_code);
+                const double phase = two_pi * doppler_hz * static_cast<double>(i) / fs_hz;
+                s.fc[i] = std::complex<float>(static_cast<float>(amplitude * s.code[chip] * std::cos(phase)) + noise(e2),
+                    static_cast<float>(amplitude * s.code[chip] * std::sin(phase)) + noise(e2));
+                for (int k = 0; k < 2; k++)
+                    {
+                        const float x = (k == 0 ? s.fc[i].real() : s.fc[i].imag());
+                        s.sc[2 * i + k] = static_cast<int16_t>(std::max(-32767.0F, std::min(32767.0F, std::round(x * 256.0F))));
+                        s.bc[2 * i + k] = static_cast<int8_t>(std::max(-127.0F, std::min(127.0F, std::round(x * 16.0F))));
+                        s.bc_2bit[2 * i + k] = quantize_2bit(x);
+                    }
+            }
+        return s;
+    }();
+    return streams;
+}
+
+
+// Correlates one code period of the stream, as the tracking block does: the
+// samples are converted to gr_complex first if the stream is not.
+class Correlation_Path
+{
+public:
+    Correlation_Path(const void* stream, const std::string& item_type)
+        : d_stream(reinterpret_cast<const uint8_t*>(stream)),
+          d_item_size(item_type_size(item_type)),
+          d_shifts_chips{-0.5, 0.0, 0.5},
+          d_corr_out(n_correlators)
+    {
+        if (item_type != "gr_complex")
+            {
+                d_converter = make_vector_converter(item_type, "gr_complex");
+                d_buffer.resize(samples_per_code);
+            }
+        d_correlator.init(2 * samples_per_code, n_correlators);
+        d_correlator.set_local_code_and_taps(code_length_chips, get_streams().code.data(), d_shifts_chips.data());
+    }
+
+    ~Correlation_Path()
+    {
+        d_correlator.free();
+    }
+
+    std::complex<float> prompt(int code_index)
+    {
+        const uint8_t* in = d_stream + static_cast<size_t>(code_index) * samples_per_code * d_item_size;
+        const auto* sig_in = reinterpret_cast<const std::complex<float>*>(in);
+        if (d_converter)
+            {
+                d_converter(d_buffer.data(), in, samples_per_code);
+                sig_in = d_buffer.data();
+            }
+        const double rem_carrier_phase = std::fmod(two_pi * doppler_hz * static_cast<double>(code_index) * samples_per_code / fs_hz, two_pi);
+        d_correlator.set_input_output_vectors(d_corr_out.data(), sig_in);
+        d_correlator.Carrier_wipeoff_multicorrelator_resampler(static_cast<float>(rem_carrier_phase),
+            static_cast<float>(two_pi * doppler_hz / fs_hz), 0.0,
+            0.0,
+            static_cast<float>(code_length_chips) / static_cast<float>(samples_per_code), 0.0,
+            samples_per_code);
+        return d_corr_out[1];
+    }
+
+    size_t item_size() const
+    {
+        return d_item_size;
+    }
+
+private:
+    Cpu_Multicorrelator_Real_Codes d_correlator;
+    const uint8_t* d_stream;
+    size_t d_item_size;
+    item_type_converter_t d_converter;
+    std::vector<float> d_shifts_chips;
+    volk_gnsssdr::vector<std::complex<float>> d_corr_out;
+    volk_gnsssdr::vector<std::complex<float>> d_buffer;
+};
+
+
+// Runs the correlators over the whole stream once, outside of the timed loop,
+// and reports the estimated C/N0 and the error of the Prompt correlator with
+// respect to the float path, once the gain of the quantizer is removed.
+void report_accuracy(benchmark::State& state, Correlation_Path& path)
+{
+    Correlation_Path reference(get_streams().fc.data(), "gr_complex");
+    std::vector<std::complex<float>> prompts(stream_codes);
+    std::vector<std::complex<float>> reference_prompts(stream_codes);
+    double cross = 0.0;
+    double power = 0.0;
+    for (int k = 0; k < stream_codes; k++)
+        {
+            prompts[k] = path.prompt(k);
+            reference_prompts[k] = reference.prompt(k);
+            cross += std::real(std::conj(prompts[k]) * reference_prompts[k]);
+            power += std::norm(prompts[k]);
+        }
+    const auto gain = static_cast<float>(cross / power);
+    double error_power = 0.0;
+    double reference_power = 0.0;
+    for (int k = 0; k < stream_codes; k++)
+        {
+            error_power += std::norm(gain * prompts[k] - reference_prompts[k]);
+            reference_power += std::norm(reference_prompts[k]);
+        }
+    state.counters["CN0_dB_Hz"] = cn0_svn_estimator(prompts.data(), stream_codes, 0.001);
+    state.counters["prompt_rel_err"] = std::sqrt(error_power / reference_power);
+}
+
+
+void run_path(benchmark::State& state, const void* stream, const std::string& item_type)
+{
+    Correlation_Path path(stream, item_type);
+    report_accuracy(state, path);
+    int k = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(path.prompt(k));
+            k = (k + 1) % stream_codes;
+        }
+    state.SetItemsProcessed(state.iterations() * samples_per_code);
+    state.SetBytesProcessed(state.iterations() * samples_per_code * path.item_size());
+}
+}  // namespace
+
+
+void bm_gr_complex(benchmark::State& state)
+{
+    run_path(state, get_streams().fc.data(), "gr_complex");
+}
+
+
+void bm_cshort(benchmark::State& state)
+{
+    run_path(state, get_streams().sc.data(), "cshort");
+}
+
+
+void bm_cbyte(benchmark::State& state)
+{
+    run_path(state, get_streams().bc.data(), "cbyte");
+}
+
+
+void bm_cbyte_2bit(benchmark::State& state)
+{
+    run_path(state, get_streams().bc_2bit.data(), "cbyte");
+}
+
+
+BENCHMARK(bm_gr_complex);
+BENCHMARK(bm_cshort);
+BENCHMARK(bm_cbyte);
+BENCHMARK(bm_cbyte_2bit);
+BENCHMARK_MAIN();
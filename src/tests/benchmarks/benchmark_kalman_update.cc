@@ -0,0 +1,129 @@
+/*!
+ * \file benchmark_kalman_update.cc
+ * \brief Benchmark for the Kalman filter update of the RTKLIB library, with
+ * the states and measurements of an RTK solution with many ambiguities
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_arena.h"
+#include "rtklib_rtkcmn.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int n_states = 200;  // position, velocity, acceleration and ambiguities
+constexpr int n_meas = 40;     // double-differenced carrier phases and pseudoranges
+
+struct Kalman_Problem
+{
+    std::vector<double> x = std::vector<double>(n_states);
+    std::vector<double> P = std::vector<double>(n_states * n_states, 0.0);
+    std::vector<double> H = std::vector<double>(n_states * n_meas, 0.0);
+    std::vector<double> v = std::vector<double>(n_meas);
+    std::vector<double> R = std::vector<double>(n_meas * n_meas, 0.0);
+};
+
+
+Kalman_Problem make_problem()
+{
+    std::default_random_engine e2(1);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    Kalman_Problem pb;
+    for (int i = 0; i < n_states; i++)
+        {
+            pb.x[i] = uniform(e2);
+            pb.P[i + i * n_states] = 1.0 + uniform(e2) * uniform(e2);
+        }
+    for (int j = 0; j < n_meas; j++)
+        {
+            // each measurement depends on the position and on two ambiguities
+            for (int i = 0; i < 3; i++)
+                {
+                    pb.H[i + j * n_states] = uniform(e2);
+                }
+            pb.H[9 + j + j * n_states] = 1.0;
+            pb.H[9 + n_meas + j + j * n_states] = -1.0;
+            pb.v[j] = uniform(e2);
+            pb.R[j + j * n_meas] = 0.01;
+        }
+    return pb;
+}
+}  // namespace
+
+
+void bm_dense_lu_update(benchmark::State& state)
+{
+    const Kalman_Problem pb = make_problem();
+    std::vector<double> xp(n_states);
+    std::vector<double> Pp(n_states * n_states);
+    std::vector<double> F(n_states * n_meas);
+    std::vector<double> Q(n_meas * n_meas);
+    std::vector<double> K(n_states * n_meas);
+    std::vector<double> I(n_states * n_states);
+    while (state.KeepRunning())
+        {
+            // K=P*H*(H'*P*H+R)^-1, xp=x+K*v, Pp=(I-K*H')*P
+            std::fill(I.begin(), I.end(), 0.0);
+            for (int i = 0; i < n_states; i++)
+                {
+                    I[i + i * n_states] = 1.0;
+                }
+            Q = pb.R;
+            xp = pb.x;
+            matmul("NN", n_states, n_meas, n_states, 1.0, pb.P.data(), pb.H.data(), 0.0, F.data());
+            matmul("TN", n_meas, n_meas, n_states, 1.0, pb.H.data(), F.data(), 1.0, Q.data());
+            matinv(Q.data(), n_meas);
+            matmul("NN", n_states, n_meas, n_meas, 1.0, F.data(), Q.data(), 0.0, K.data());
+            matmul("NN", n_states, 1, n_meas, 1.0, K.data(), pb.v.data(), 1.0, xp.data());
+            matmul("NT", n_states, n_states, n_meas, -1.0, K.data(), pb.H.data(), 1.0, I.data());
+            matmul("NN", n_states, n_states, n_states, 1.0, I.data(), pb.P.data(), 0.0, Pp.data());
+            benchmark::DoNotOptimize(Pp.data());
+        }
+}
+
+
+void bm_filter_update(benchmark::State& state)
+{
+    const Kalman_Problem pb = make_problem();
+    std::vector<double> xp(n_states);
+    std::vector<double> Pp(n_states * n_states);
+    while (state.KeepRunning())
+        {
+            filter_(pb.x.data(), pb.P.data(), pb.H.data(), pb.v.data(), pb.R.data(), n_states, n_meas, xp.data(), Pp.data());
+            benchmark::DoNotOptimize(Pp.data());
+        }
+}
+
+
+void bm_filter_update_arena(benchmark::State& state)
+{
+    const Kalman_Problem pb = make_problem();
+    std::vector<double> xp(n_states);
+    std::vector<double> Pp(n_states * n_states);
+    Rtklib_Arena arena;
+    while (state.KeepRunning())
+        {
+            Rtklib_Arena_Scope scope(arena);
+            filter_(pb.x.data(), pb.P.data(), pb.H.data(), pb.v.data(), pb.R.data(), n_states, n_meas, xp.data(), Pp.data());
+            benchmark::DoNotOptimize(Pp.data());
+        }
+}
+
+
+BENCHMARK(bm_dense_lu_update);
+BENCHMARK(bm_filter_update);
+BENCHMARK(bm_filter_update_arena);
+
+BENCHMARK_MAIN();
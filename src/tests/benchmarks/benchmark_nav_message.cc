@@ -0,0 +1,192 @@
+/*!
+ * \file benchmark_nav_message.cc
+ * \brief Benchmark for the parsing of Galileo I/NAV pages
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Galileo_INAV.h"
+#include "galileo_inav_message.h"
+#include "gnss_packed_bits.h"
+#include <benchmark/benchmark.h>
+#include <boost/crc.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using CRC_INAV_type = boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false>;
+
+// Fields of word type 3, as (first bit, length)
+const std::array<std::pair<int32_t, int32_t>, 8> word_3_fields{{{7, 10}, {17, 24}, {41, 16}, {57, 16}, {73, 16}, {89, 16}, {105, 16}, {121, 8}}};
+
+
+// Hard decisions of the even and odd page parts of a word type 3 page with a
+// valid CRC, as delivered by the Viterbi decoder
+std::pair<std::vector<int32_t>, std::vector<int32_t>> make_page_parts()
+{
+    std::mt19937 gen(1234);
+    std::string page = "00000011";  // even, nominal, word type 3
+    while (page.size() < GALILEO_INAV_EVEN_PART_BITS)
+        {
+            page.push_back((gen() & 1U) ? '1' : '0');
+        }
+    page += "10";  // odd, nominal
+    while (page.size() < GALILEO_DATA_FRAME_BITS)
+        {
+            page.push_back((gen() & 1U) ? '1' : '0');
+        }
+    const std::string padded = std::string(GALILEO_DATA_FRAME_BYTES * 8 - GALILEO_DATA_FRAME_BITS, '0') + page;
+    std::array<uint8_t, GALILEO_DATA_FRAME_BYTES> bytes{};
+    for (int32_t i = 0; i < GALILEO_DATA_FRAME_BYTES; i++)
+        {
+            bytes[i] = static_cast<uint8_t>(std::bitset<8>(padded.substr(8 * i, 8)).to_ulong());
+        }
+    CRC_INAV_type crc;
+    crc.process_bytes(bytes.data(), GALILEO_DATA_FRAME_BYTES);
+    page += std::bitset<24>(crc.checksum()).to_string() + std::string(14, '0');
+
+    std::vector<int32_t> even(GALILEO_INAV_PAGE_PART_BITS, -1);
+    std::vector<int32_t> odd(GALILEO_INAV_PAGE_PART_BITS, -1);
+    for (int32_t i = 0; i < GALILEO_INAV_PAGE_PART_BITS; i++)
+        {
+            even[i] = (i < GALILEO_INAV_EVEN_PART_BITS && page[i] == '1') ? 1 : -1;
+            odd[i] = page[GALILEO_INAV_EVEN_PART_BITS + i] == '1' ? 1 : -1;
+        }
+    return {even, odd};
+}
+
+
+std::string to_page_string(const std::vector<int32_t>& decisions)
+{
+    std::string page_string;
+    page_string.reserve(decisions.size());
+    for (const auto d : decisions)
+        {
+            page_string.push_back(d > 0 ? '1' : '0');
+        }
+    return page_string;
+}
+
+
+// Former implementation: pages as strings of '0' and '1', CRC through
+// boost::dynamic_bitset, and fields read bit by bit from a std::bitset
+int64_t parse_with_bitset(const std::vector<int32_t>& even, const std::vector<int32_t>& odd)
+{
+    const std::string page_even = to_page_string(even).substr(0, GALILEO_INAV_EVEN_PART_BITS);
+    const std::string page_INAV = page_even + to_page_string(odd);
+    const std::bitset<GALILEO_DATA_FRAME_BITS> frame(page_INAV.substr(0, GALILEO_DATA_FRAME_BITS));
+    const std::bitset<24> checksum(page_INAV.substr(196, 24));
+    boost::dynamic_bitset<unsigned char> frame_bits(frame.to_string());
+    std::vector<unsigned char> bytes;
+    boost::to_block_range(frame_bits, std::back_inserter(bytes));
+    std::reverse(bytes.begin(), bytes.end());
+    CRC_INAV_type crc;
+    crc.process_bytes(bytes.data(), GALILEO_DATA_FRAME_BYTES);
+    if (crc.checksum() != checksum.to_ulong())
+        {
+            return 0;
+        }
+    const std::bitset<GALILEO_DATA_JK_BITS> data_jk(page_INAV.substr(2, 112) + page_INAV.substr(116, 16));
+    int64_t sum = 0;
+    for (const auto& f : word_3_fields)
+        {
+            int64_t value = (data_jk[GALILEO_DATA_JK_BITS - f.first] == 1) ? -1LL : 0LL;
+            for (int32_t j = 0; j < f.second; j++)
+                {
+                    value = (value << 1) | static_cast<int64_t>(data_jk[GALILEO_DATA_JK_BITS - f.first - j]);
+                }
+            sum += value;
+        }
+    return sum;
+}
+
+
+int64_t parse_packed(const std::vector<int32_t>& even, const std::vector<int32_t>& odd)
+{
+    Gnss_Packed_Bits<GALILEO_INAV_PAGE_BITS> page;
+    page.assign(even.data(), GALILEO_INAV_EVEN_PART_BITS);
+    page.assign(odd.data(), GALILEO_INAV_PAGE_PART_BITS, GALILEO_INAV_EVEN_PART_BITS);
+    std::array<uint8_t, GALILEO_DATA_FRAME_BYTES> bytes{};
+    bytes[0] = static_cast<uint8_t>(page.read_unsigned({1, 4}));
+    for (int32_t i = 1; i < GALILEO_DATA_FRAME_BYTES; i++)
+        {
+            bytes[i] = static_cast<uint8_t>(page.read_unsigned({8 * i - 3, 8}));
+        }
+    CRC_INAV_type crc;
+    crc.process_bytes(bytes.data(), GALILEO_DATA_FRAME_BYTES);
+    if (crc.checksum() != page.read_unsigned({197, 24}))
+        {
+            return 0;
+        }
+    Gnss_Packed_Bits<GALILEO_DATA_JK_BITS> data_jk;
+    data_jk.copy(page, 2, 0, 112);
+    data_jk.copy(page, 116, 112, 16);
+    int64_t sum = 0;
+    for (const auto& f : word_3_fields)
+        {
+            sum += data_jk.read_signed({f.first, f.second});
+        }
+    return sum;
+}
+}  // namespace
+
+
+void bm_inav_page_bitset(benchmark::State& state)
+{
+    const auto parts = make_page_parts();
+    for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(parse_with_bitset(parts.first, parts.second));
+        }
+}
+
+
+void bm_inav_page_packed(benchmark::State& state)
+{
+    const auto parts = make_page_parts();
+    for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(parse_packed(parts.first, parts.second));
+        }
+}
+
+
+void bm_inav_message_split_page(benchmark::State& state)
+{
+    const auto parts = make_page_parts();
+    Galileo_Inav_Message inav;
+    for (auto _ : state)
+        {
+            Gnss_Packed_Bits<GALILEO_INAV_PAGE_PART_BITS> even;
+            even.assign(parts.first.data(), GALILEO_INAV_PAGE_PART_BITS);
+            inav.split_page(even, 0);
+            Gnss_Packed_Bits<GALILEO_INAV_PAGE_PART_BITS> odd;
+            odd.assign(parts.second.data(), GALILEO_INAV_PAGE_PART_BITS);
+            inav.split_page(odd, 1);
+            benchmark::DoNotOptimize(inav.get_flag_CRC_test());
+        }
+}
+
+
+BENCHMARK(bm_inav_page_bitset);
+BENCHMARK(bm_inav_page_packed);
+BENCHMARK(bm_inav_message_split_page);
+
+BENCHMARK_MAIN();
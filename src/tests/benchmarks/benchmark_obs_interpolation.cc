@@ -0,0 +1,126 @@
+/*!
+ * \file benchmark_obs_interpolation.cc
+ * \brief Benchmark for the search and interpolation of tracking observables
+ * at the receiver epochs
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_interpolation.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t n_channels = 64;
+constexpr uint32_t history_length = 1000;  // observables history depth per channel
+constexpr uint64_t fs = 4000000;
+constexpr uint64_t samples_per_epoch = fs / 100;  // 100 Hz output rate
+
+
+std::vector<std::vector<uint64_t>> make_history()
+{
+    // Tracking outputs at 1 ms with a small random offset per channel
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::uniform_int_distribution<uint64_t> offset(0, 3999);
+    std::vector<std::vector<uint64_t>> history(n_channels, std::vector<uint64_t>(history_length));
+    for (auto& channel : history)
+        {
+            const uint64_t channel_offset = offset(e2);
+            for (uint32_t i = 0; i < history_length; i++)
+                {
+                    channel[i] = channel_offset + i * (fs / 1000);
+                }
+        }
+    return history;
+}
+}  // namespace
+
+
+void bm_nearest_linear_scan(benchmark::State& state)
+{
+    const auto history = make_history();
+    uint64_t rx_clock = fs / 2;
+    while (state.KeepRunning())
+        {
+            for (const auto& channel : history)
+                {
+                    int32_t nearest_element = -1;
+                    int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
+                    for (uint32_t i = 0; i < channel.size(); i++)
+                        {
+                            const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(channel[i]));
+                            if (old_abs_diff > abs_diff)
+                                {
+                                    old_abs_diff = abs_diff;
+                                    nearest_element = static_cast<int32_t>(i);
+                                }
+                        }
+                    benchmark::DoNotOptimize(nearest_element);
+                }
+            rx_clock = (rx_clock + samples_per_epoch) % (history_length * (fs / 1000));
+        }
+}
+
+
+void bm_nearest_binary_search(benchmark::State& state)
+{
+    const auto history = make_history();
+    uint64_t rx_clock = fs / 2;
+    while (state.KeepRunning())
+        {
+            for (const auto& channel : history)
+                {
+                    const int32_t nearest_element = find_nearest_sample(channel.size(), rx_clock, [&channel](uint32_t i) { return channel[i]; });
+                    benchmark::DoNotOptimize(nearest_element);
+                }
+            rx_clock = (rx_clock + samples_per_epoch) % (history_length * (fs / 1000));
+        }
+}
+
+
+void bm_interpolation(benchmark::State& state)
+{
+    const auto order = static_cast<uint32_t>(state.range(0));
+    std::array<double, OBS_MAX_INTERPOLATION_ORDER + 1> t{};
+    std::array<double, OBS_MAX_INTERPOLATION_ORDER + 1> y{};
+    std::array<double, OBS_MAX_INTERPOLATION_ORDER + 1> weights{};
+    for (uint32_t k = 0; k <= order; k++)
+        {
+            t[k] = (static_cast<double>(k) - 0.3) * 0.001;
+            y[k] = 1.0e5 + 1.0e3 * t[k] + 5.0 * t[k] * t[k];
+        }
+    while (state.KeepRunning())
+        {
+            for (uint32_t ch = 0; ch < n_channels; ch++)
+                {
+                    lagrange_weights(t.data(), order + 1, 0.0, weights.data());
+                    double value = 0.0;
+                    for (uint32_t k = 0; k <= order; k++)
+                        {
+                            value += weights[k] * y[k];
+                        }
+                    benchmark::DoNotOptimize(value);
+                }
+        }
+}
+
+
+BENCHMARK(bm_nearest_linear_scan);
+BENCHMARK(bm_nearest_binary_search);
+BENCHMARK(bm_interpolation)->DenseRange(1, OBS_MAX_INTERPOLATION_ORDER);
+BENCHMARK_MAIN();
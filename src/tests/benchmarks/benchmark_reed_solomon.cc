@@ -18,7 +18,9 @@
 #include "gnss_sdr_make_unique.h"  // for std::unique_ptr in C++11
 #include "reed_solomon.h"
 #include <benchmark/benchmark.h>
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <vector>
 
 void bm_e1b_erasurecorrection_shortened(benchmark::State& state)
@@ -295,8 +297,112 @@ void bm_e6b_erasure(benchmark::State& state)
 }
 
 
+// A Galileo HAS message of 15 pages, received as the first 5 information
+// pages and 10 parity pages
+struct Has_Message_Block
+{
+    Has_Message_Block()
+    {
+        std::mt19937 gen(1234);
+        ReedSolomon rs;
+        for (int col = 0; col < 53; col++)
+            {
+                std::vector<uint8_t> input(32, 0);
+                for (int row = 0; row < 15; row++)
+                    {
+                        input[row] = static_cast<uint8_t>(gen());
+                    }
+                const std::vector<uint8_t> encoded = rs.encode_with_generator_matrix(input);
+                for (int row = 0; row < 255; row++)
+                    {
+                        codewords[row][col] = encoded[row];
+                    }
+            }
+        received_positions = {0, 1, 2, 3, 4, 40, 57, 63, 88, 101, 150, 170, 201, 230, 254};
+        for (int i = 0; i < 255; i++)
+            {
+                if ((i < 15 || i >= 32) && std::find(received_positions.begin(), received_positions.end(), i) == received_positions.end())
+                    {
+                        erasure_positions.push_back(i);
+                    }
+            }
+    }
+    std::vector<std::vector<uint8_t>> codewords = std::vector<std::vector<uint8_t>>(255, std::vector<uint8_t>(53));
+    std::vector<int> received_positions;
+    std::vector<int> erasure_positions;
+};
+
+
+void bm_has_message_column_by_column(benchmark::State& state)
+{
+    const Has_Message_Block block;
+    auto rs = std::make_unique<ReedSolomon>();
+    std::vector<std::vector<uint8_t>> decoded(32, std::vector<uint8_t>(53));
+    for (auto _ : state)
+        {
+            for (int col = 0; col < 53; col++)
+                {
+                    std::vector<uint8_t> column(255, 0);
+                    for (const auto pos : block.received_positions)
+                        {
+                            column[pos] = block.codewords[pos][col];
+                        }
+                    if (rs->decode(column, block.erasure_positions) < 0)
+                        {
+                            state.SkipWithError("Failed to decode data!");
+                            break;
+                        }
+                    for (int row = 0; row < 32; row++)
+                        {
+                            decoded[row][col] = column[row];
+                        }
+                }
+            benchmark::DoNotOptimize(decoded[0][0]);
+        }
+}
+
+
+void bm_has_message_generator_matrix(benchmark::State& state)
+{
+    const Has_Message_Block block;
+    auto rs = std::make_unique<ReedSolomon>();
+    std::vector<std::vector<uint8_t>> decoded(32, std::vector<uint8_t>(53));
+    for (auto _ : state)
+        {
+            if (rs->decode_with_generator_matrix(block.received_positions, block.codewords, decoded) < 0)
+                {
+                    state.SkipWithError("Failed to decode data!");
+                    break;
+                }
+            benchmark::DoNotOptimize(decoded[0][0]);
+        }
+}
+
+
+void bm_has_message_generator_matrix_not_cached(benchmark::State& state)
+{
+    const Has_Message_Block block;
+    std::vector<std::vector<uint8_t>> decoded(32, std::vector<uint8_t>(53));
+    for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto rs = std::make_unique<ReedSolomon>();
+            state.ResumeTiming();
+            if (rs->decode_with_generator_matrix(block.received_positions, block.codewords, decoded) < 0)
+                {
+                    state.SkipWithError("Failed to decode data!");
+                    break;
+                }
+            benchmark::DoNotOptimize(decoded[0][0]);
+        }
+}
+
+
 BENCHMARK(bm_e1b_erasurecorrection_shortened);
 BENCHMARK(bm_e1b_erasurecorrection_unshortened);
 BENCHMARK(bm_e6b_correction);
 BENCHMARK(bm_e6b_erasure);
+BENCHMARK(bm_has_message_column_by_column);
+BENCHMARK(bm_has_message_generator_matrix);
+BENCHMARK(bm_has_message_generator_matrix_not_cached);
 BENCHMARK_MAIN();
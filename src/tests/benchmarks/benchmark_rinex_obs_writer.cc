@@ -0,0 +1,161 @@
+/*!
+ * \file benchmark_rinex_obs_writer.cc
+ * \brief Benchmark for the writing of RINEX observation files in plain,
+ * Compact RINEX and gzip formats
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rinex_obs_writer.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int32_t n_sats = 12;
+constexpr int32_t n_epochs = 3600;  // one hour at 1 Hz
+const std::string filename("benchmark_rinex_obs_writer.tmp");
+
+
+// GPS L1 C/A records (C1C L1C D1C S1C), formatted as Rinex_Printer does
+std::vector<std::string> make_epochs()
+{
+    std::mt19937 gen(1234);
+    std::normal_distribution<double> noise(0.0, 0.3);
+    std::vector<std::string> epochs;
+    std::array<char, 128> line{};
+    for (int32_t e = 0; e < n_epochs; e++)
+        {
+            std::snprintf(line.data(), line.size(), "> 2019 04 07 %02d %02d %010.7f  0%3d", e / 3600, (e / 60) % 60, static_cast<double>(e % 60), n_sats);
+            std::string epoch(line.data());
+            epoch.resize(80, ' ');
+            epoch += '\n';
+            for (int32_t s = 0; s < n_sats; s++)
+                {
+                    const double t = e;
+                    const double doppler = -3000.0 + 500.0 * s + 0.05 * t;
+                    const double range = 2.0e7 + 4.0e5 * s - 0.19029367 * (doppler * t) + noise(gen);
+                    const double phase = range / 0.19029367 + 1.0e4 * s;
+                    const double cn0 = 40.0 + 5.0 * std::sin(0.01 * t + s) + noise(gen);
+                    const int32_t ssi = std::min(std::max(static_cast<int32_t>(cn0 / 6), 1), 9);
+                    std::snprintf(line.data(), line.size(), "G%02d%14.3f %d%14.3f %d%14.3f %d%14.3f", s + 1, range, ssi, phase, ssi, doppler, ssi, cn0);
+                    std::string record(line.data());
+                    record.resize(80, ' ');
+                    epoch += record + '\n';
+                }
+            epochs.push_back(epoch);
+        }
+    return epochs;
+}
+
+
+std::string obs_header()
+{
+    std::string header("     3.02           OBSERVATION DATA    G (GPS)             RINEX VERSION / TYPE\n");
+    header += "G    4 C1C L1C D1C S1C                                      SYS / # / OBS TYPES \n";
+    header += std::string(60, ' ') + "END OF HEADER       \n";
+    return header;
+}
+
+
+// Writes the records epoch by epoch, and reports the size of the file
+// relative to the plain RINEX records
+void write_obs_file(benchmark::State& state, bool compact, bool gzip)
+{
+    if (gzip && !Rinex_Obs_Writer::gzip_available())
+        {
+            state.SkipWithError("GNSS-SDR was built without zlib");
+            return;
+        }
+    const std::vector<std::string> epochs = make_epochs();
+    std::fstream file(filename, std::ios::out | std::ios::in | std::ios::trunc | std::ios::binary);
+    std::unique_ptr<Rinex_Obs_Writer> writer;
+    if (compact || gzip)
+        {
+            writer = std::make_unique<Rinex_Obs_Writer>(compact, gzip);
+            writer->start_file(file, "GNSS-SDR benchmark");
+        }
+    const std::string header = obs_header();
+    file << header;
+    if (writer)
+        {
+            writer->end_header(file, filename);
+        }
+
+    uint64_t rinex_bytes = 0;
+    size_t e = 0;
+    while (state.KeepRunning())
+        {
+            const std::string& epoch = epochs[e];
+            e = (e + 1) % epochs.size();
+            if (writer)
+                {
+                    writer->epoch_stream() << epoch;
+                    writer->write_epochs(file);
+                }
+            else
+                {
+                    file << epoch;
+                }
+            rinex_bytes += epoch.size();
+        }
+
+    if (writer)
+        {
+            writer->end_file(file);
+        }
+    const auto file_size = static_cast<double>(file.tellp());
+    file.close();
+    std::remove(filename.c_str());
+    state.SetBytesProcessed(static_cast<int64_t>(rinex_bytes));
+    state.counters["size_ratio"] = (file_size - header.size()) / static_cast<double>(rinex_bytes);
+}
+}  // namespace
+
+
+void bm_plain_rinex(benchmark::State& state)
+{
+    write_obs_file(state, false, false);
+}
+
+
+void bm_compact_rinex(benchmark::State& state)
+{
+    write_obs_file(state, true, false);
+}
+
+
+void bm_gzip_rinex(benchmark::State& state)
+{
+    write_obs_file(state, false, true);
+}
+
+
+void bm_gzip_compact_rinex(benchmark::State& state)
+{
+    write_obs_file(state, true, true);
+}
+
+
+BENCHMARK(bm_plain_rinex);
+BENCHMARK(bm_compact_rinex);
+BENCHMARK(bm_gzip_rinex);
+BENCHMARK(bm_gzip_compact_rinex);
+BENCHMARK_MAIN();
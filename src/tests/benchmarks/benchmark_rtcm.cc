@@ -0,0 +1,157 @@
+/*!
+ * \file benchmark_rtcm.cc
+ * \brief Benchmark for the assembly of RTCM 3 frames
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtcm.h"
+#include "rtcm_bit_writer.h"
+#include <benchmark/benchmark.h>
+#include <boost/crc.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t n_sats = 12;
+constexpr uint32_t n_cells = 2 * n_sats;  // GPS L1 C/A + L2C
+constexpr double obs_time = 2537.0;
+
+
+std::map<int32_t, Gnss_Synchro> make_observables()
+{
+    std::map<int32_t, Gnss_Synchro> observables;
+    int32_t ch = 0;
+    for (uint32_t prn = 1; prn <= n_sats; prn++)
+        {
+            for (const char* signal : {"1C", "2S"})
+                {
+                    Gnss_Synchro synchro{};
+                    synchro.System = 'G';
+                    std::memcpy(static_cast<void*>(synchro.Signal), signal, 3);
+                    synchro.PRN = prn;
+                    synchro.Pseudorange_m = 20000000.0 + 123456.789 * ch;
+                    synchro.Carrier_phase_rads = 1.0e5 + 2345.678 * ch;
+                    synchro.Carrier_Doppler_hz = -3000.0 + 456.7 * ch;
+                    synchro.CN0_dB_hz = 35.0 + 0.5 * ch;
+                    synchro.Flag_valid_pseudorange = true;
+                    observables[ch++] = synchro;
+                }
+        }
+    return observables;
+}
+}  // namespace
+
+
+// Former approach: fields concatenated as strings of '0' and '1' characters,
+// and then converted to bytes through a dynamic bitset to compute the CRC.
+// The field layout is the one of a MSM7 message with n_sats and n_cells.
+void bm_string_frame(benchmark::State& state)
+{
+    while (state.KeepRunning())
+        {
+            std::string data = std::bitset<64>(0x3ED7D30202980EDEULL).to_string() + std::bitset<64>(0).to_string() + std::bitset<41>(0).to_string();
+            for (uint32_t sat = 0; sat < n_sats; sat++)
+                {
+                    data += std::bitset<8>(sat).to_string() + std::bitset<4>(0).to_string() + std::bitset<10>(sat).to_string() + std::bitset<14>(sat).to_string();
+                }
+            for (uint32_t cell = 0; cell < n_cells; cell++)
+                {
+                    data += std::bitset<20>(cell).to_string() + std::bitset<24>(cell).to_string() + std::bitset<10>(cell).to_string() + std::bitset<1>(0).to_string() + std::bitset<10>(cell).to_string() + std::bitset<15>(cell).to_string();
+                }
+            const uint32_t msg_length_bytes = (data.length() + 7) / 8;
+            data += std::string(8 * msg_length_bytes - data.length(), '0');
+            const std::string msg_without_crc = std::bitset<8>(0xD3).to_string() + std::bitset<6>(0).to_string() + std::bitset<10>(msg_length_bytes).to_string() + data;
+
+            boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> crc_rtcm;
+            boost::dynamic_bitset<uint8_t> frame_bits(msg_without_crc);
+            std::vector<uint8_t> bytes;
+            boost::to_block_range(frame_bits, std::back_inserter(bytes));
+            std::reverse(bytes.begin(), bytes.end());
+            crc_rtcm.process_bytes(bytes.data(), bytes.size());
+            const std::string complete_message = msg_without_crc + std::bitset<24>(crc_rtcm.checksum()).to_string();
+            benchmark::DoNotOptimize(complete_message);
+        }
+}
+
+
+void bm_bit_writer_frame(benchmark::State& state)
+{
+    Rtcm_Bit_Writer writer;
+    while (state.KeepRunning())
+        {
+            writer.start_frame();
+            writer.put_bits(0x3ED7D30202980EDEULL, 64);
+            writer.put_bits(0, 64);
+            writer.put_bits(0, 41);
+            for (uint32_t sat = 0; sat < n_sats; sat++)
+                {
+                    writer.put_bits(sat, 8);
+                    writer.put_bits(0, 4);
+                    writer.put_bits(sat, 10);
+                    writer.put_bits(sat, 14);
+                }
+            for (uint32_t cell = 0; cell < n_cells; cell++)
+                {
+                    writer.put_bits(cell, 20);
+                    writer.put_bits(cell, 24);
+                    writer.put_bits(cell, 10);
+                    writer.put_bits(0, 1);
+                    writer.put_bits(cell, 10);
+                    writer.put_bits(cell, 15);
+                }
+            writer.finish_frame();
+            benchmark::DoNotOptimize(writer.data());
+        }
+}
+
+
+void bm_print_msm7(benchmark::State& state)
+{
+    Rtcm rtcm;
+    const auto observables = make_observables();
+    Gps_Ephemeris gps_eph = Gps_Ephemeris();
+    gps_eph.PRN = 1;
+    while (state.KeepRunning())
+        {
+            const std::string msm7 = rtcm.print_MSM_7(gps_eph, {}, {}, {}, obs_time, observables, 1234, 0, 0, 0, false, false);
+            benchmark::DoNotOptimize(msm7);
+        }
+}
+
+
+void bm_encode_msm7(benchmark::State& state)
+{
+    Rtcm rtcm;
+    const auto observables = make_observables();
+    Gps_Ephemeris gps_eph = Gps_Ephemeris();
+    gps_eph.PRN = 1;
+    while (state.KeepRunning())
+        {
+            const Rtcm_Bit_Writer& frame = rtcm.encode_MSM_7(gps_eph, {}, {}, {}, obs_time, observables, 1234, 0, 0, 0, false, false);
+            benchmark::DoNotOptimize(frame.data());
+        }
+}
+
+
+BENCHMARK(bm_string_frame);
+BENCHMARK(bm_bit_writer_frame);
+BENCHMARK(bm_print_msm7);
+BENCHMARK(bm_encode_msm7);
+BENCHMARK_MAIN();
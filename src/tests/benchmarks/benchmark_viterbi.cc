@@ -0,0 +1,187 @@
+/*!
+ * \file benchmark_viterbi.cc
+ * \brief Benchmark for the Viterbi decoder of the Galileo navigation messages
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Galileo_CNAV.h"
+#include "Galileo_INAV.h"
+#include "viterbi_decoder.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int32_t KK = 7;
+constexpr int32_t mm = KK - 1;
+const std::array<int32_t, 2> g_encoder{{121, 91}};
+
+
+// Former implementation: floating-point metrics, one state at a time, and one
+// int32_t per state and trellis section for the survivor paths
+class Float_Viterbi
+{
+public:
+    explicit Float_Viterbi(int32_t LL) : d_LL(LL)
+    {
+        for (int32_t state = 0; state < d_states; state++)
+            {
+                for (int32_t input = 0; input < 2; input++)
+                    {
+                        const int32_t word = (input << mm) ^ state;
+                        int32_t out = 0;
+                        for (const int32_t g : g_encoder)
+                            {
+                                int32_t taps = word & g;
+                                int32_t parity = 0;
+                                while (taps)
+                                    {
+                                        parity ^= taps & 1;
+                                        taps >>= 1;
+                                    }
+                                out = (out << 1) + parity;
+                            }
+                        d_out[input][state] = out;
+                        d_next[input][state] = word >> 1;
+                    }
+            }
+        d_prev_bit = std::vector<int32_t>(d_states * (d_LL + mm));
+        d_prev_state = std::vector<int32_t>(d_states * (d_LL + mm));
+    }
+
+    void decode(std::vector<int32_t>& output, const std::vector<float>& input)
+    {
+        std::array<float, d_states> prev_section{};
+        std::array<float, d_states> next_section{};
+        prev_section.fill(-1e7);
+        next_section.fill(-1e7);
+        prev_section[0] = 0.0;
+        for (int32_t t = 0; t < d_LL + mm; t++)
+            {
+                const std::array<float, 4> metric_c{{0.0F, input[2 * t + 1], input[2 * t], input[2 * t] + input[2 * t + 1]}};
+                for (int32_t state = 0; state < d_states; state++)
+                    {
+                        for (int32_t input_bit = 0; input_bit < 2; input_bit++)
+                            {
+                                const float metric = prev_section[state] + metric_c[d_out[input_bit][state]];
+                                const int32_t next = d_next[input_bit][state];
+                                if (metric > next_section[next])
+                                    {
+                                        next_section[next] = metric;
+                                        d_prev_state[t * d_states + next] = state;
+                                        d_prev_bit[t * d_states + next] = input_bit;
+                                    }
+                            }
+                    }
+                float max_val = next_section[0];
+                for (int32_t state = 1; state < d_states; state++)
+                    {
+                        max_val = std::max(max_val, next_section[state]);
+                    }
+                for (int32_t state = 0; state < d_states; state++)
+                    {
+                        prev_section[state] = next_section[state] - max_val;
+                        next_section[state] = -1e7;
+                    }
+            }
+        int32_t state = 0;
+        for (int32_t t = d_LL + mm - 1; t >= d_LL; t--)
+            {
+                state = d_prev_state[t * d_states + state];
+            }
+        for (int32_t t = d_LL - 1; t >= 0; t--)
+            {
+                output[t] = d_prev_bit[t * d_states + state];
+                state = d_prev_state[t * d_states + state];
+            }
+    }
+
+private:
+    static constexpr int32_t d_states = 1 << mm;
+    std::array<std::array<int32_t, d_states>, 2> d_out{};
+    std::array<std::array<int32_t, d_states>, 2> d_next{};
+    std::vector<int32_t> d_prev_bit;
+    std::vector<int32_t> d_prev_state;
+    int32_t d_LL;
+};
+
+
+std::vector<float> random_symbols(int32_t length)
+{
+    std::mt19937 gen(1234);
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::vector<float> symbols(length);
+    for (auto& symbol : symbols)
+        {
+            symbol = dist(gen);
+        }
+    return symbols;
+}
+
+
+template <typename Decoder>
+void run_decoder(benchmark::State& state, int32_t codelength)
+{
+    const int32_t LL = codelength / 2 - mm;
+    Decoder decoder(LL);
+    const std::vector<float> symbols = random_symbols(codelength);
+    std::vector<int32_t> bits(codelength / 2);
+    while (state.KeepRunning())
+        {
+            decoder.decode(bits, symbols);
+            benchmark::DoNotOptimize(bits.data());
+        }
+    state.SetItemsProcessed(state.iterations() * LL);
+}
+
+
+class Volk_Viterbi : public Viterbi_Decoder
+{
+public:
+    explicit Volk_Viterbi(int32_t LL) : Viterbi_Decoder(KK, 2, LL, g_encoder) {}
+};
+}  // namespace
+
+
+void bm_float_viterbi_inav(benchmark::State& state)
+{
+    run_decoder<Float_Viterbi>(state, GALILEO_INAV_INTERLEAVER_ROWS * GALILEO_INAV_INTERLEAVER_COLS);
+}
+
+
+void bm_viterbi_decoder_inav(benchmark::State& state)
+{
+    run_decoder<Volk_Viterbi>(state, GALILEO_INAV_INTERLEAVER_ROWS * GALILEO_INAV_INTERLEAVER_COLS);
+}
+
+
+void bm_float_viterbi_cnav(benchmark::State& state)
+{
+    run_decoder<Float_Viterbi>(state, GALILEO_CNAV_INTERLEAVER_ROWS * GALILEO_CNAV_INTERLEAVER_COLS);
+}
+
+
+void bm_viterbi_decoder_cnav(benchmark::State& state)
+{
+    run_decoder<Volk_Viterbi>(state, GALILEO_CNAV_INTERLEAVER_ROWS * GALILEO_CNAV_INTERLEAVER_COLS);
+}
+
+
+BENCHMARK(bm_float_viterbi_inav);
+BENCHMARK(bm_viterbi_decoder_inav);
+BENCHMARK(bm_float_viterbi_cnav);
+BENCHMARK(bm_viterbi_decoder_cnav);
+BENCHMARK_MAIN();
@@ -54,9 +54,14 @@ DECLARE_string(log_dir);
 #include "unit-tests/arithmetic/magnitude_squared_test.cc"
 #include "unit-tests/arithmetic/multiply_test.cc"
 #include "unit-tests/arithmetic/preamble_correlator_test.cc"
+#include "unit-tests/control-plane/acquisition_scheduler_test.cc"
+#include "unit-tests/control-plane/concurrent_queue_test.cc"
 #include "unit-tests/control-plane/in_memory_configuration_test.cc"
+#include "unit-tests/control-plane/load_governor_test.cc"
 #include "unit-tests/control-plane/protobuf_test.cc"
 #include "unit-tests/control-plane/string_converter_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_fft_cache_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_worker_pool_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_8ms_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_cccwsr_ambiguous_acquisition_gsoc2013_test.cc"
@@ -71,29 +76,44 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/acquisition/gps_l1_ca_pcps_tong_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/adapter/adapter_test.cc"
 #include "unit-tests/signal-processing-blocks/adapter/pass_through_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/block_instrumentation_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_dump_writer_test.cc"
 #include "unit-tests/signal-processing-blocks/libs/item_type_helpers_test.cc"
+#include "unit-tests/signal-processing-blocks/observables/obs_interpolation_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/geohash_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/nmea_printer_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/pvt_output_pipeline_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rinex_obs_writer_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rinex_printer_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_printer_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_filter_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_solver_eph_cache_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_solver_vtl_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/segment_stitcher_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/serdes_monitor_pvt_test.cc"
 #include "unit-tests/signal-processing-blocks/resampler/direct_resampler_conditioner_cc_test.cc"
 #include "unit-tests/signal-processing-blocks/resampler/mmse_resampler_test.cc"
 #include "unit-tests/signal-processing-blocks/sources/gnss_sdr_valve_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/mmap_file_source_test.cc"
 #include "unit-tests/signal-processing-blocks/sources/unpack_2bit_samples_test.cc"
 #include "unit-tests/signal-processing-blocks/telemetry_decoder/galileo_fnav_inav_decoder_test.cc"
+#include "unit-tests/signal-processing-blocks/telemetry_decoder/viterbi_decoder_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_batch_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_real_codes_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/discriminator_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/galileo_e5a_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/galileo_e5b_dll_pll_tracking_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/kf_vtl_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/tracking_loop_filter_test.cc"
 #include "unit-tests/system-parameters/galileo_e1b_reed_solomon_test.cc"
 #include "unit-tests/system-parameters/galileo_e6b_reed_solomon_test.cc"
+#include "unit-tests/system-parameters/galileo_nav_message_packed_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_crc_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_ephemeris_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_nav_message_test.cc"
+#include "unit-tests/system-parameters/gnss_packed_bits_test.cc"
 #include "unit-tests/system-parameters/has_decoding_test.cc"
 
 #ifndef EXCLUDE_TESTS_REQUIRING_BINARIES
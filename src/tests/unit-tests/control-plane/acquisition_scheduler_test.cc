@@ -0,0 +1,108 @@
+/*!
+ * \file acquisition_scheduler_test.cc
+ * \brief  This file implements unit tests for the Acquisition_Scheduler class.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acquisition_scheduler.h"
+#include <array>
+#include <cmath>
+#include <map>
+#include <vector>
+
+namespace
+{
+Gps_Almanac make_gps_almanac(uint32_t prn, double M_0)
+{
+    Gps_Almanac alm;
+    alm.PRN = prn;
+    alm.toa = 0;
+    alm.sqrtA = 5153.6;
+    alm.ecc = 0.01;
+    alm.delta_i = 0.0;
+    alm.OMEGA_0 = 0.5;
+    alm.omega = 0.1;
+    alm.M_0 = M_0;
+    return alm;
+}
+
+
+// Geocentric latitude and longitude of the point below the satellite
+std::array<double, 2> sub_satellite_point_deg(const Gps_Almanac& alm, double tow)
+{
+    std::array<double, 7> pos_vel{};
+    alm.satellitePosVelComputation(tow, pos_vel);
+    const double lon = std::atan2(pos_vel[1], pos_vel[0]);
+    const double lat = std::atan2(pos_vel[2], std::sqrt(pos_vel[0] * pos_vel[0] + pos_vel[1] * pos_vel[1]));
+    return {lat * 180.0 / M_PI, lon * 180.0 / M_PI};
+}
+}  // namespace
+
+
+TEST(AcquisitionSchedulerTest, RanksByElevation)
+{
+    const double tow = 1000.0;
+    std::map<int, Gps_Almanac> gps_almanac;
+    gps_almanac[1] = make_gps_almanac(1, 0.0);
+    gps_almanac[2] = make_gps_almanac(2, 0.05);
+    gps_almanac[3] = make_gps_almanac(3, 1.0);  // on the other side of the Earth
+
+    const std::array<double, 2> ssp = sub_satellite_point_deg(gps_almanac[2], tow);
+    Acquisition_Scheduler scheduler;
+    scheduler.set_receiver_state(tow, ssp[0], ssp[1], 0.0);
+    const std::vector<Satellite_Prediction> predictions = scheduler.predict({}, {}, gps_almanac, {});
+
+    ASSERT_EQ(3U, predictions.size());
+    EXPECT_EQ(2U, predictions[0].satellite.get_PRN());
+    EXPECT_EQ(1U, predictions[1].satellite.get_PRN());
+    EXPECT_EQ(3U, predictions[2].satellite.get_PRN());
+    EXPECT_GT(predictions[0].elevation_deg, 89.0);
+    EXPECT_LT(predictions[2].elevation_deg, 0.0);
+    for (const auto& prediction : predictions)
+        {
+            EXPECT_EQ("GPS", prediction.satellite.get_system());
+            EXPECT_EQ(false, prediction.from_ephemeris);
+            EXPECT_TRUE(std::isfinite(prediction.doppler_hz));
+        }
+    // Almost no radial velocity at the zenith
+    EXPECT_LT(std::abs(predictions[0].doppler_hz), 1000.0);
+    EXPECT_GT(std::abs(predictions[1].doppler_hz), std::abs(predictions[0].doppler_hz));
+}
+
+
+TEST(AcquisitionSchedulerTest, EphemerisTakesPrecedence)
+{
+    const double tow = 1000.0;
+    std::map<int, Gps_Almanac> gps_almanac;
+    gps_almanac[5] = make_gps_almanac(5, 0.0);
+
+    Gps_Ephemeris eph;
+    eph.PRN = 5;
+    eph.sqrtA = 5153.6;
+    eph.ecc = 0.01;
+    eph.i_0 = 0.3 * M_PI;
+    eph.OMEGA_0 = 0.5 * M_PI;
+    eph.omega = 0.1 * M_PI;
+    eph.M_0 = 0.0;
+    std::map<int, Gps_Ephemeris> gps_ephemeris;
+    gps_ephemeris[5] = eph;
+
+    Acquisition_Scheduler scheduler;
+    scheduler.set_receiver_state(tow, 41.27, 1.98, 10.0, 10.0, 90.0);
+    const std::vector<Satellite_Prediction> predictions = scheduler.predict(gps_ephemeris, {}, gps_almanac, {});
+
+    ASSERT_EQ(1U, predictions.size());
+    EXPECT_EQ(5U, predictions[0].satellite.get_PRN());
+    EXPECT_EQ(true, predictions[0].from_ephemeris);
+    EXPECT_TRUE(std::isfinite(predictions[0].elevation_deg));
+    EXPECT_TRUE(std::isfinite(predictions[0].doppler_hz));
+}
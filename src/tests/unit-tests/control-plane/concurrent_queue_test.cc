@@ -0,0 +1,141 @@
+/*!
+ * \file concurrent_queue_test.cc
+ * \brief  This file implements unit tests for the Concurrent_Queue class.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_queue.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+TEST(ConcurrentQueueTest, FifoOrderWithOverflow)
+{
+    Concurrent_Queue<int> queue(8);
+    int value = 0;
+    EXPECT_EQ(false, queue.try_pop(value));
+    EXPECT_EQ(true, queue.empty());
+
+    // More items than slots in the ring
+    for (int i = 0; i < 100; i++)
+        {
+            queue.push(i);
+        }
+    EXPECT_EQ(100U, queue.size());
+    for (int i = 0; i < 50; i++)
+        {
+            ASSERT_EQ(true, queue.try_pop(value));
+            EXPECT_EQ(i, value);
+        }
+    for (int i = 100; i < 120; i++)
+        {
+            queue.push(i);
+        }
+    for (int i = 50; i < 120; i++)
+        {
+            ASSERT_EQ(true, queue.try_pop(value));
+            EXPECT_EQ(i, value);
+        }
+    EXPECT_EQ(false, queue.try_pop(value));
+    EXPECT_EQ(true, queue.empty());
+
+    queue.push(7);
+    queue.push(8);
+    queue.clear();
+    EXPECT_EQ(0U, queue.size());
+}
+
+
+TEST(ConcurrentQueueTest, TryPushIsBounded)
+{
+    Concurrent_Queue<int> queue(8);
+    for (int i = 0; i < 8; i++)
+        {
+            EXPECT_EQ(true, queue.try_push(i));
+        }
+    EXPECT_EQ(false, queue.try_push(8));
+    EXPECT_EQ(8U, queue.size());
+
+    // try_push never goes ahead of the items waiting in the overflow queue
+    queue.push(8);
+    int value = 0;
+    ASSERT_EQ(true, queue.try_pop(value));
+    EXPECT_EQ(0, value);
+    EXPECT_EQ(false, queue.try_push(9));
+    for (int i = 1; i <= 8; i++)
+        {
+            ASSERT_EQ(true, queue.try_pop(value));
+            EXPECT_EQ(i, value);
+        }
+    EXPECT_EQ(true, queue.try_push(9));
+    ASSERT_EQ(true, queue.try_pop(value));
+    EXPECT_EQ(9, value);
+}
+
+
+TEST(ConcurrentQueueTest, TimedWait)
+{
+    Concurrent_Queue<std::string> queue;
+    std::string message;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(false, queue.timed_wait_and_pop(message, 20));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.push("Hello");
+    });
+    EXPECT_EQ(true, queue.timed_wait_and_pop(message, 5000));
+    EXPECT_EQ(0, message.compare("Hello"));
+    producer.join();
+}
+
+
+TEST(ConcurrentQueueTest, MultipleProducers)
+{
+    const int n_producers = 4;
+    const int n_items = 20000;
+    Concurrent_Queue<int> queue(64);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < n_producers; p++)
+        {
+            producers.emplace_back([&queue, p]() {
+                for (int i = 0; i < n_items; i++)
+                    {
+                        queue.push(p * n_items + i);
+                    }
+            });
+        }
+
+    // Items of each producer must arrive in order
+    std::vector<int> last(n_producers, -1);
+    int value = 0;
+    for (int k = 0; k < n_producers * n_items; k++)
+        {
+            queue.wait_and_pop(value);
+            const int p = value / n_items;
+            EXPECT_GT(value % n_items, last[p]);
+            last[p] = value % n_items;
+        }
+    for (auto& producer : producers)
+        {
+            producer.join();
+        }
+    EXPECT_EQ(true, queue.empty());
+    for (int p = 0; p < n_producers; p++)
+        {
+            EXPECT_EQ(n_items - 1, last[p]);
+        }
+}
@@ -0,0 +1,109 @@
+/*!
+ * \file load_governor_test.cc
+ * \brief  This file implements unit tests for the Load_Governor class.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "load_governor.h"
+
+
+TEST(LoadGovernorTest, ShedsWhileOverloadedAndRestoresAfterHold)
+{
+    Load_Governor governor(0.010, 5.0);
+    double lag_s = 0.2;
+    EXPECT_EQ(governor.update(0.0, lag_s, 0, true), Load_Action::none);  // first measurement
+
+    // keeping up: the lag does not grow
+    for (int t = 1; t <= 3; t++)
+        {
+            EXPECT_EQ(governor.update(t, lag_s, 0, true), Load_Action::none);
+        }
+
+    // falling behind by 100 ms per second: one step per period
+    for (int t = 4; t <= 6; t++)
+        {
+            lag_s += 0.1;
+            EXPECT_EQ(governor.update(t, lag_s, 0, true), Load_Action::shed);
+            EXPECT_TRUE(governor.overloaded());
+        }
+    EXPECT_EQ(governor.level(), 3);
+
+    // still overloaded, but nothing left to shed
+    lag_s += 0.1;
+    EXPECT_EQ(governor.update(7.0, lag_s, 0, false), Load_Action::none);
+    EXPECT_EQ(governor.level(), 3);
+
+    // keeping up again: one step is restored every hold time
+    int restores = 0;
+    double last_restore = 0.0;
+    for (int t = 8; t <= 30; t++)
+        {
+            const Load_Action action = governor.update(t, lag_s, 0, true);
+            EXPECT_NE(action, Load_Action::shed);
+            if (action == Load_Action::restore)
+                {
+                    if (restores > 0)
+                        {
+                            EXPECT_GE(t - last_restore, 5.0);
+                        }
+                    else
+                        {
+                            EXPECT_GE(t - 7.0, 5.0);
+                        }
+                    last_restore = t;
+                    restores++;
+                }
+        }
+    EXPECT_EQ(restores, 3);
+    EXPECT_EQ(governor.level(), 0);
+}
+
+
+TEST(LoadGovernorTest, DroppedSamplesAreAnOverload)
+{
+    Load_Governor governor(0.010, 5.0);
+    EXPECT_EQ(governor.update(0.0, 0.0, 0, true), Load_Action::none);
+    EXPECT_EQ(governor.update(1.0, 0.0, 0, true), Load_Action::none);
+    EXPECT_EQ(governor.update(2.0, 0.0, 4000, true), Load_Action::shed);
+    EXPECT_EQ(governor.new_dropped_samples(), 4000U);
+    EXPECT_EQ(governor.update(3.0, 0.0, 4000, true), Load_Action::none);
+
+    // a source running faster than real time (e.g. a file) is never an overload
+    Load_Governor file_governor(0.010, 5.0);
+    for (int t = 0; t < 20; t++)
+        {
+            EXPECT_EQ(file_governor.update(t, -2.0 * t, 0, true), Load_Action::none);
+        }
+}
+
+
+TEST(LoadGovernorTest, HoldTimeGrowsWhenRestoresFail)
+{
+    Load_Governor governor(0.010, 5.0);
+    double lag_s = 0.0;
+    governor.update(0.0, lag_s, 0, true);
+    lag_s += 0.1;
+    EXPECT_EQ(governor.update(1.0, lag_s, 0, true), Load_Action::shed);
+    EXPECT_EQ(governor.update(6.0, lag_s, 0, true), Load_Action::restore);
+
+    // the overload comes back right after the restore
+    lag_s += 0.1;
+    EXPECT_EQ(governor.update(7.0, lag_s, 0, true), Load_Action::shed);
+    EXPECT_DOUBLE_EQ(governor.hold_s(), 10.0);
+    EXPECT_EQ(governor.update(12.0, lag_s, 0, true), Load_Action::none);
+    EXPECT_EQ(governor.update(17.0, lag_s, 0, true), Load_Action::restore);
+
+    // this time the restore holds, and the hold time goes back down
+    EXPECT_EQ(governor.update(27.0, lag_s, 0, true), Load_Action::none);
+    EXPECT_DOUBLE_EQ(governor.hold_s(), 5.0);
+    EXPECT_EQ(governor.level(), 0);
+}
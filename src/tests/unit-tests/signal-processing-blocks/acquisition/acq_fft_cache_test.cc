@@ -0,0 +1,72 @@
+/*!
+ * \file acq_fft_cache_test.cc
+ * \brief Unit tests for the shared acquisition FFT plans and code spectra cache
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_fft_cache.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+
+TEST(AcqFftCacheTest, CodeSpectrumLookup)
+{
+    Acq_Code_Spectrum_Key key;
+    key.signal = "G1C";
+    key.prn = 7;
+    key.fs = 4000000;
+    key.fft_size = 4000;
+    key.sampled_ms = 1;
+
+    auto spectrum = std::make_shared<Acq_Fft_Cache::Code_Spectrum>(key.fft_size);
+    Acq_Fft_Cache::get_instance().store_code_spectrum(key, spectrum);
+
+    EXPECT_EQ(spectrum, Acq_Fft_Cache::get_instance().find_code_spectrum(key));
+
+    // A replica generated with different adapter options must not hit the cache
+    Acq_Code_Spectrum_Key other_key = key;
+    other_key.code_options = "1B";
+    EXPECT_EQ(nullptr, Acq_Fft_Cache::get_instance().find_code_spectrum(other_key));
+
+    // Neither must a replica padded for a different coherent integration time
+    other_key = key;
+    other_key.sampled_ms = 4;
+    EXPECT_EQ(nullptr, Acq_Fft_Cache::get_instance().find_code_spectrum(other_key));
+
+    // Nor a different PRN
+    other_key = key;
+    other_key.prn = 8;
+    EXPECT_EQ(nullptr, Acq_Fft_Cache::get_instance().find_code_spectrum(other_key));
+}
+
+
+TEST(AcqFftCacheTest, PlansAreReused)
+{
+    const gnss_fft_complex_fwd* fwd = nullptr;
+    const gnss_fft_complex_rev* rev = nullptr;
+    {
+        Acq_Fft_Plans plans(1024);
+        fwd = plans.fwd();
+        rev = plans.rev();
+        ASSERT_NE(nullptr, fwd);
+        ASSERT_NE(nullptr, rev);
+        // Plans in use are not lent twice
+        Acq_Fft_Plans other_plans(1024);
+        EXPECT_NE(fwd, other_plans.fwd());
+        EXPECT_NE(rev, other_plans.rev());
+    }
+    Acq_Fft_Plans plans(1024);
+    Acq_Fft_Plans plans2(1024);
+    // Both idle plans of size 1024 have been reused
+    EXPECT_TRUE((plans.fwd() == fwd) or (plans2.fwd() == fwd));
+    EXPECT_TRUE((plans.rev() == rev) or (plans2.rev() == rev));
+}
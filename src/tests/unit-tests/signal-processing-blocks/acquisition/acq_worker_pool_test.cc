@@ -0,0 +1,95 @@
+/*!
+ * \file acq_worker_pool_test.cc
+ * \brief Unit tests for the pool of worker threads of the acquisition
+ * Doppler search
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_worker_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+TEST(AcqWorkerPoolTest, ChunksCoverAllTasks)
+{
+    Acq_Worker_Pool pool(4);
+    for (uint32_t num_tasks : {1U, 2U, 3U, 4U, 41U, 81U})
+        {
+            std::vector<std::atomic<int>> runs(num_tasks);
+            std::vector<uint32_t> chunk_of_task(num_tasks, 0);
+            pool.run(num_tasks, [&runs, &chunk_of_task](uint32_t worker, uint32_t task_begin, uint32_t task_end) {
+                for (uint32_t task = task_begin; task < task_end; task++)
+                    {
+                        runs[task]++;
+                        chunk_of_task[task] = worker;
+                    }
+            });
+            for (uint32_t task = 0; task < num_tasks; task++)
+                {
+                    EXPECT_EQ(1, runs[task].load()) << "task " << task << " of " << num_tasks;
+                }
+            // contiguous chunks, so the split does not depend on scheduling
+            for (uint32_t task = 1; task < num_tasks; task++)
+                {
+                    EXPECT_LE(chunk_of_task[task - 1], chunk_of_task[task]);
+                }
+        }
+}
+
+
+TEST(AcqWorkerPoolTest, SharedBySize)
+{
+    auto pool = Acq_Worker_Pool::get_shared(3);
+    EXPECT_EQ(pool, Acq_Worker_Pool::get_shared(3));
+    EXPECT_NE(pool, Acq_Worker_Pool::get_shared(2));
+    EXPECT_EQ(3U, pool->size());
+    EXPECT_LE(1U, Acq_Worker_Pool::get_shared(0)->size());
+}
+
+
+TEST(AcqWorkerPoolTest, IndependentRunsProceedConcurrently)
+{
+    // The chunks of the first run wait until the second run has executed, so
+    // the test would time out if concurrent runs were serialized
+    Acq_Worker_Pool pool(2);
+    std::atomic<bool> second_run_done{false};
+    std::atomic<bool> timed_out{false};
+    std::thread first([&pool, &second_run_done, &timed_out]() {
+        pool.run(2, [&second_run_done, &timed_out](uint32_t /*worker*/, uint32_t /*task_begin*/, uint32_t /*task_end*/) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (!second_run_done)
+                {
+                    if (std::chrono::steady_clock::now() > deadline)
+                        {
+                            timed_out = true;
+                            return;
+                        }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+        });
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::atomic<int> tasks{0};
+    pool.run(8, [&tasks](uint32_t /*worker*/, uint32_t task_begin, uint32_t task_end) {
+        tasks += static_cast<int>(task_end - task_begin);
+    });
+    second_run_done = true;
+    first.join();
+
+    EXPECT_EQ(8, tasks.load());
+    EXPECT_FALSE(timed_out.load());
+}
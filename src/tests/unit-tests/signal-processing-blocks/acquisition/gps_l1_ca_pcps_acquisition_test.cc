@@ -37,6 +37,7 @@
 #include <pmt/pmt.h>
 #include <chrono>
 #include <memory>
+#include <string>
 #include <utility>
 
 #if HAS_GENERIC_LAMBDA
@@ -359,3 +360,103 @@ TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResults /*unused*/)
             plot_grid();
         }
 }
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResultsFftRotation /*unused*/)
+{
+    top_block = gr::make_top_block("Acquisition test");
+
+    double expected_delay_samples = 524;
+    double expected_doppler_hz = 1680;
+    // The Doppler step must be a multiple of the FFT resolution (4 MSps / 4000 samples)
+    doppler_step = 1000;
+
+    init();
+    config->set_property("Acquisition_1C.doppler_fft_rotation", "true");
+    config->set_property("Acquisition_1C.dump", "false");
+
+    auto acquisition = gnss_make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+    auto msg_rx = GpsL1CaPcpsAcquisitionTest_msg_rx_make();
+
+    ASSERT_NO_THROW({
+        acquisition->set_channel(1);
+        acquisition->set_gnss_synchro(&gnss_synchro);
+        acquisition->set_threshold(0.001);
+        acquisition->set_doppler_max(doppler_max);
+        acquisition->set_doppler_step(doppler_step);
+        acquisition->connect(top_block);
+    }) << "Failure setting up the acquisition block.";
+
+    ASSERT_NO_THROW({
+        std::string path = std::string(TEST_PATH);
+        std::string file = path + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat";
+        const char *file_name = file.c_str();
+        gr::blocks::file_source::sptr file_source = gr::blocks::file_source::make(sizeof(gr_complex), file_name, false);
+        top_block->connect(file_source, 0, acquisition->get_left_block(), 0);
+        top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+    }) << "Failure connecting the blocks of acquisition test.";
+
+    acquisition->set_local_code();
+    acquisition->set_state(1);  // Ensure that acquisition starts at the first sample
+    acquisition->init();
+
+    EXPECT_NO_THROW({
+        top_block->run();  // Start threads and wait
+    }) << "Failure running the top_block.";
+
+    ASSERT_EQ(1, msg_rx->rx_message) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+
+    double delay_error_samples = std::abs(expected_delay_samples - gnss_synchro.Acq_delay_samples);
+    auto delay_error_chips = static_cast<float>(delay_error_samples * 1023 / 4000);
+    double doppler_error_hz = std::abs(expected_doppler_hz - gnss_synchro.Acq_doppler_hz);
+
+    EXPECT_LE(doppler_error_hz, static_cast<double>(doppler_step) / 2.0) << "Doppler error exceeds half the Doppler step";
+    EXPECT_LT(delay_error_chips, 0.5) << "Delay error exceeds the expected value: 0.5 chips";
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ResultsDoNotDependOnDopplerSearchThreads /*unused*/)
+{
+    init();
+    config->set_property("Acquisition_1C.dump", "false");
+
+    // Runs the acquisition with the given number of Doppler search threads
+    // and returns the acquisition results
+    const auto acquire = [this](const std::string &doppler_search_threads) {
+        Gnss_Synchro synchro = gnss_synchro;
+        config->set_property("Acquisition_1C.doppler_search_threads", doppler_search_threads);
+        top_block = gr::make_top_block("Acquisition test");
+        auto acquisition = gnss_make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+        auto msg_rx = GpsL1CaPcpsAcquisitionTest_msg_rx_make();
+        EXPECT_NO_THROW({
+            acquisition->set_channel(1);
+            acquisition->set_gnss_synchro(&synchro);
+            acquisition->set_threshold(0.001);
+            acquisition->set_doppler_max(doppler_max);
+            acquisition->set_doppler_step(doppler_step);
+            acquisition->connect(top_block);
+            std::string file = std::string(TEST_PATH) + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat";
+            gr::blocks::file_source::sptr file_source = gr::blocks::file_source::make(sizeof(gr_complex), file.c_str(), false);
+            top_block->connect(file_source, 0, acquisition->get_left_block(), 0);
+            top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+        }) << "Failure setting up the acquisition block.";
+        acquisition->set_local_code();
+        acquisition->set_state(1);  // Ensure that acquisition starts at the first sample
+        acquisition->init();
+        EXPECT_NO_THROW({
+            top_block->run();  // Start threads and wait
+        }) << "Failure running the top_block.";
+        EXPECT_EQ(1, msg_rx->rx_message) << "Acquisition failure with " << doppler_search_threads << " Doppler search threads.";
+        return synchro;
+    };
+
+    const Gnss_Synchro serial = acquire("1");
+    // 0 means one thread per hardware thread
+    for (const char *threads : {"2", "3", "7", "0"})
+        {
+            const Gnss_Synchro parallel = acquire(threads);
+            EXPECT_EQ(serial.Acq_delay_samples, parallel.Acq_delay_samples) << "with " << threads << " Doppler search threads";
+            EXPECT_EQ(serial.Acq_doppler_hz, parallel.Acq_doppler_hz) << "with " << threads << " Doppler search threads";
+            EXPECT_EQ(serial.Acq_samplestamp_samples, parallel.Acq_samplestamp_samples) << "with " << threads << " Doppler search threads";
+        }
+}
@@ -0,0 +1,124 @@
+/*!
+ * \file block_instrumentation_test.cc
+ * \brief Tests for the registry of per-block instrumentation counters
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "block_instrumentation.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+const Block_Stats* find_block_stats(const std::vector<Block_Stats>& stats, const std::string& name)
+{
+    const auto it = std::find_if(stats.cbegin(), stats.cend(), [&name](const Block_Stats& s) { return s.block == name; });
+    return it == stats.cend() ? nullptr : &(*it);
+}
+}  // namespace
+
+
+TEST(BlockInstrumentationTest, CountersAreOnlyUpdatedWhenEnabled)
+{
+    auto& registry = Block_Instrumentation::instance();
+    auto counters = registry.register_block("block_instrumentation_test_a", 2);
+    Latency_Stats latency;
+    registry.take_snapshot(latency);
+
+    Block_Instrumentation::set_enabled(false);
+    {
+        Block_Work_Timer timer(counters.get(), 100);
+        timer.set_items(10);
+    }
+    counters->record_dropped_samples(5);
+    auto stats = registry.take_snapshot(latency);
+    const Block_Stats* s = find_block_stats(stats, "block_instrumentation_test_a");
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->calls, 0U);
+    EXPECT_EQ(s->dropped_events, 0U);
+
+    Block_Instrumentation::set_enabled(true);
+    for (int k = 1; k <= 3; k++)
+        {
+            Block_Work_Timer timer(counters.get(), 100 * k);
+            timer.set_items(10 * k);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    counters->set_channel(7);
+    counters->record_dropped_samples(5);
+    stats = registry.take_snapshot(latency);
+    Block_Instrumentation::set_enabled(false);
+
+    s = find_block_stats(stats, "block_instrumentation_test_a");
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->channel, 7);
+    EXPECT_EQ(s->calls, 3U);
+    EXPECT_EQ(s->items, 60U);
+    EXPECT_EQ(s->input_items, 600U);
+    EXPECT_EQ(s->input_items_max, 300U);
+    EXPECT_GE(s->work_ns, 300000U);
+    EXPECT_GE(s->work_ns_max, 100000U);
+    EXPECT_LE(s->work_ns_max, s->work_ns);
+    EXPECT_EQ(s->dropped_events, 1U);
+    EXPECT_EQ(s->dropped_samples, 5U);
+
+    // the snapshot resets the counters
+    stats = registry.take_snapshot(latency);
+    s = find_block_stats(stats, "block_instrumentation_test_a");
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->calls, 0U);
+    EXPECT_EQ(s->work_ns_max, 0U);
+
+    // and forgets the blocks that no longer exist
+    counters.reset();
+    stats = registry.take_snapshot(latency);
+    EXPECT_EQ(find_block_stats(stats, "block_instrumentation_test_a"), nullptr);
+}
+
+
+TEST(BlockInstrumentationTest, SampleToPvtLatency)
+{
+    auto& registry = Block_Instrumentation::instance();
+    Block_Instrumentation::set_enabled(true);
+    Latency_Stats latency;
+    registry.take_snapshot(latency);
+
+    // samples arriving in batches of 1000, every 2 ms
+    for (uint64_t counter = 1000; counter <= 20000; counter += 1000)
+        {
+            registry.stamp_sample_counter(counter);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    // a fix for a sample of the tenth batch is at least 20 ms later than its
+    // arrival, and a fix for the last batch at most a few ms later
+    registry.record_sample_to_pvt(9500);
+    registry.record_sample_to_pvt(20000);
+    registry.take_snapshot(latency);
+    Block_Instrumentation::set_enabled(false);
+
+    EXPECT_EQ(latency.fixes, 2U);
+    EXPECT_EQ(latency.last_sample_counter, 20000U);
+    EXPECT_GE(latency.max_ms, 20.0);
+    EXPECT_LT(latency.min_ms, latency.max_ms);
+    EXPECT_GE(latency.min_ms, 0.0);
+    EXPECT_NEAR(latency.mean_ms, (latency.min_ms + latency.max_ms) / 2.0, 1e-9);
+
+    registry.take_snapshot(latency);
+    EXPECT_EQ(latency.fixes, 0U);
+}
@@ -0,0 +1,216 @@
+/*!
+ * \file gnss_dump_writer_test.cc
+ * \brief Tests for the asynchronous writer of dump files
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_dump_writer.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+const std::vector<Dump_Column> test_dump_schema{
+    {"abs_P", Dump_Type::FLOAT32},
+    {"PRN_start_sample_count", Dump_Type::UINT64},
+    {"aux2", Dump_Type::FLOAT64},
+    {"nav_symbol", Dump_Type::INT32},
+    {"flag", Dump_Type::UINT8}};
+
+
+void write_test_records(Gnss_Dump_Writer& writer, uint32_t num_records)
+{
+    for (uint32_t i = 0; i < num_records; i++)
+        {
+            Gnss_Dump_Record record(writer);
+            record.add(static_cast<float>(i) * 0.5F)
+                .add(static_cast<uint64_t>(i) * 4000ULL + 12345678901ULL)
+                .add(static_cast<double>(i) / 3.0)
+                .add(static_cast<int32_t>(i % 2 == 0 ? 1 : -1))
+                .add(static_cast<uint8_t>(i & 0xFFU));
+            record.commit();
+            if (i % 1000 == 999)
+                {
+                    writer.flush();
+                }
+        }
+}
+
+
+void check_test_columns(const std::vector<std::vector<uint8_t>>& columns, uint64_t num_records)
+{
+    ASSERT_EQ(columns.size(), test_dump_schema.size());
+    ASSERT_EQ(columns[0].size(), num_records * sizeof(float));
+    ASSERT_EQ(columns[1].size(), num_records * sizeof(uint64_t));
+    ASSERT_EQ(columns[2].size(), num_records * sizeof(double));
+    ASSERT_EQ(columns[3].size(), num_records * sizeof(int32_t));
+    ASSERT_EQ(columns[4].size(), num_records * sizeof(uint8_t));
+    for (uint64_t i = 0; i < num_records; i++)
+        {
+            float abs_P;
+            uint64_t sample_count;
+            double aux2;
+            int32_t symbol;
+            std::memcpy(&abs_P, &columns[0][i * sizeof(float)], sizeof(float));
+            std::memcpy(&sample_count, &columns[1][i * sizeof(uint64_t)], sizeof(uint64_t));
+            std::memcpy(&aux2, &columns[2][i * sizeof(double)], sizeof(double));
+            std::memcpy(&symbol, &columns[3][i * sizeof(int32_t)], sizeof(int32_t));
+            ASSERT_EQ(abs_P, static_cast<float>(i) * 0.5F);
+            ASSERT_EQ(sample_count, i * 4000ULL + 12345678901ULL);
+            ASSERT_EQ(aux2, static_cast<double>(i) / 3.0);
+            ASSERT_EQ(symbol, i % 2 == 0 ? 1 : -1);
+            ASSERT_EQ(columns[4][i], static_cast<uint8_t>(i & 0xFFU));
+        }
+}
+}  // namespace
+
+
+TEST(GnssDumpWriterTest, BinaryKeepsRecordLayout)
+{
+    const std::string filename("./gnss_dump_writer_test_binary.dat");
+    const uint32_t num_records = 5000;
+    {
+        Gnss_Dump_Writer writer(test_dump_schema, Dump_Format::BINARY, false, 1024);
+        ASSERT_TRUE(writer.open(filename));
+        write_test_records(writer, num_records);
+        writer.close();
+        EXPECT_EQ(writer.dropped_records(), 0U);
+        EXPECT_EQ(writer.written_records(), num_records);
+        EXPECT_EQ(writer.record_size(), 25U);
+    }
+
+    // Check the first record field by field, as the legacy readers do
+    std::ifstream file(filename, std::ios::binary);
+    float abs_P = 1.0F;
+    uint64_t sample_count = 0;
+    double aux2 = 1.0;
+    int32_t symbol = 0;
+    uint8_t flag = 1;
+    file.read(reinterpret_cast<char*>(&abs_P), sizeof(float));
+    file.read(reinterpret_cast<char*>(&sample_count), sizeof(uint64_t));
+    file.read(reinterpret_cast<char*>(&aux2), sizeof(double));
+    file.read(reinterpret_cast<char*>(&symbol), sizeof(int32_t));
+    file.read(reinterpret_cast<char*>(&flag), sizeof(uint8_t));
+    EXPECT_EQ(abs_P, 0.0F);
+    EXPECT_EQ(sample_count, 12345678901ULL);
+    EXPECT_EQ(aux2, 0.0);
+    EXPECT_EQ(symbol, 1);
+    EXPECT_EQ(flag, 0);
+    file.close();
+
+    std::vector<std::vector<uint8_t>> columns;
+    uint64_t num_read = 0;
+    ASSERT_TRUE(read_dump_columns(filename, test_dump_schema, Dump_Format::BINARY, columns, num_read));
+    check_test_columns(columns, num_read);
+    std::remove(filename.c_str());
+}
+
+
+TEST(GnssDumpWriterTest, ColumnarRoundTrip)
+{
+    for (const bool compress : {false, true})
+        {
+            const std::string filename("./gnss_dump_writer_test_columnar.dat");
+            const uint32_t num_records = 10000;
+            {
+                Gnss_Dump_Writer writer(test_dump_schema, Dump_Format::COLUMNAR, compress, 16384, 3000);
+                ASSERT_TRUE(writer.open(filename));
+                write_test_records(writer, num_records);
+                writer.close();
+                EXPECT_EQ(writer.dropped_records(), 0U);
+                EXPECT_EQ(writer.written_records(), num_records);
+            }
+
+            std::ifstream file(filename, std::ios::binary);
+            std::string magic(8, ' ');
+            file.read(&magic[0], 8);
+            EXPECT_EQ(magic, "GNSSDUMP");
+            file.close();
+
+            std::vector<std::vector<uint8_t>> columns;
+            uint64_t num_read = 0;
+            ASSERT_TRUE(read_dump_columns(filename, test_dump_schema, Dump_Format::COLUMNAR, columns, num_read));
+            EXPECT_EQ(num_read, num_records);
+            check_test_columns(columns, num_read);
+
+            // A different schema must be rejected
+            auto other_schema = test_dump_schema;
+            other_schema[2].type = Dump_Type::FLOAT32;
+            EXPECT_FALSE(read_dump_columns(filename, other_schema, Dump_Format::COLUMNAR, columns, num_read));
+            std::remove(filename.c_str());
+        }
+}
+
+
+TEST(GnssDumpWriterTest, FullRingDropsRecords)
+{
+    const std::string filename("./gnss_dump_writer_test_drop.dat");
+    Gnss_Dump_Writer writer(test_dump_schema, Dump_Format::BINARY, false, 8);
+    writer.set_overflow_policy(Dump_Overflow::DROP);
+    // Not opened yet, so nothing drains the ring
+    for (int i = 0; i < 20; i++)
+        {
+            Gnss_Dump_Record record(writer);
+            record.add(1.0F).add(uint64_t(2)).add(3.0).add(int32_t(4)).add(uint8_t(5));
+            record.commit();
+        }
+    EXPECT_EQ(writer.dropped_records(), 12U);
+    EXPECT_FALSE(writer.reserve(9));
+    EXPECT_EQ(writer.dropped_records(), 21U);
+    ASSERT_TRUE(writer.open(filename));
+    writer.close();
+    EXPECT_EQ(writer.written_records(), 8U);
+    std::remove(filename.c_str());
+}
+
+
+TEST(GnssDumpWriterTest, FullRingBlocksByDefault)
+{
+    for (const auto format : {Dump_Format::BINARY, Dump_Format::COLUMNAR})
+        {
+            const std::string filename("./gnss_dump_writer_test_block.dat");
+            const uint32_t num_records = 5000;
+            {
+                // A ring much smaller than the records written, and no flush()
+                // from the producer, so it has to wait for the background thread
+                Gnss_Dump_Writer writer(test_dump_schema, format, false, 16, 100);
+                ASSERT_TRUE(writer.open(filename));
+                for (uint32_t i = 0; i < num_records; i++)
+                    {
+                        Gnss_Dump_Record record(writer);
+                        record.add(static_cast<float>(i) * 0.5F)
+                            .add(static_cast<uint64_t>(i) * 4000ULL + 12345678901ULL)
+                            .add(static_cast<double>(i) / 3.0)
+                            .add(static_cast<int32_t>(i % 2 == 0 ? 1 : -1))
+                            .add(static_cast<uint8_t>(i & 0xFFU));
+                        record.commit();
+                    }
+                writer.close();
+                EXPECT_EQ(writer.dropped_records(), 0U);
+                EXPECT_EQ(writer.written_records(), num_records);
+            }
+
+            std::vector<std::vector<uint8_t>> columns;
+            uint64_t num_read = 0;
+            ASSERT_TRUE(read_dump_columns(filename, test_dump_schema, format, columns, num_read));
+            EXPECT_EQ(num_read, num_records);
+            check_test_columns(columns, num_read);
+            std::remove(filename.c_str());
+        }
+}
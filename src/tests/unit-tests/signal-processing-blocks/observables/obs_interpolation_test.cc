@@ -0,0 +1,170 @@
+/*!
+ * \file obs_interpolation_test.cc
+ * \brief  This file implements unit tests for the helpers that interpolate
+ * the tracking observables at the receiver epochs.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_interpolation.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+// sample counters of a tracking history with a 1 ms period at 4 Msps
+std::vector<uint64_t> make_sample_counters(uint32_t size)
+{
+    std::vector<uint64_t> counters(size);
+    for (uint32_t i = 0; i < size; i++)
+        {
+            counters[i] = 1000000ULL + 4000ULL * i;
+        }
+    return counters;
+}
+
+
+int32_t find_nearest(const std::vector<uint64_t>& counters, uint64_t rx_clock)
+{
+    return find_nearest_sample(static_cast<uint32_t>(counters.size()), rx_clock, [&counters](uint32_t i) { return counters[i]; });
+}
+
+
+// Reference: linear search of the nearest sample, lowest index on a tie
+int32_t find_nearest_linear(const std::vector<uint64_t>& counters, uint64_t rx_clock)
+{
+    int32_t nearest = -1;
+    uint64_t nearest_distance = 0;
+    for (size_t i = 0; i < counters.size(); i++)
+        {
+            const uint64_t distance = (counters[i] > rx_clock ? counters[i] - rx_clock : rx_clock - counters[i]);
+            if (nearest < 0 or distance < nearest_distance)
+                {
+                    nearest = static_cast<int32_t>(i);
+                    nearest_distance = distance;
+                }
+        }
+    return nearest;
+}
+}  // namespace
+
+
+TEST(ObsInterpolationTest, NearestSampleOnTheEpoch)
+{
+    const auto counters = make_sample_counters(100);
+    for (int32_t i = 0; i < 100; i++)
+        {
+            EXPECT_EQ(i, find_nearest(counters, counters[i]));
+        }
+}
+
+
+TEST(ObsInterpolationTest, NearestSampleAtTheEdges)
+{
+    const auto counters = make_sample_counters(100);
+
+    // before and at the first sample
+    EXPECT_EQ(0, find_nearest(counters, 0));
+    EXPECT_EQ(0, find_nearest(counters, counters.front() - 1));
+    EXPECT_EQ(0, find_nearest(counters, counters.front()));
+    EXPECT_EQ(0, find_nearest(counters, counters.front() + 1999));
+    EXPECT_EQ(1, find_nearest(counters, counters.front() + 2001));
+
+    // at and after the last sample
+    EXPECT_EQ(99, find_nearest(counters, counters.back()));
+    EXPECT_EQ(99, find_nearest(counters, counters.back() + 1));
+    EXPECT_EQ(99, find_nearest(counters, counters.back() + 1000000));
+    EXPECT_EQ(98, find_nearest(counters, counters.back() - 2001));
+
+    // buffers of zero and one element
+    EXPECT_EQ(-1, find_nearest({}, counters.front()));
+    EXPECT_EQ(0, find_nearest({counters.front()}, 0));
+    EXPECT_EQ(0, find_nearest({counters.front()}, counters.back()));
+}
+
+
+TEST(ObsInterpolationTest, NearestSampleMatchesLinearSearch)
+{
+    auto counters = make_sample_counters(37);
+    // a repeated counter and an irregular gap
+    counters[10] = counters[9];
+    for (size_t i = 20; i < counters.size(); i++)
+        {
+            counters[i] += 1234;
+        }
+    for (uint64_t rx_clock = counters.front() - 5000; rx_clock < counters.back() + 5000; rx_clock += 250)
+        {
+            EXPECT_EQ(find_nearest_linear(counters, rx_clock), find_nearest(counters, rx_clock)) << "rx_clock " << rx_clock;
+        }
+    // on a tie, the lowest index
+    EXPECT_EQ(3, find_nearest(counters, counters[3] + 2000));
+}
+
+
+TEST(ObsInterpolationTest, LagrangeWeightsSumToOne)
+{
+    const std::array<double, 6> t{0.0, 0.001, 0.002, 0.0031, 0.004, 0.005};
+    std::array<double, 6> weights{};
+    for (uint32_t n_points = 1; n_points <= OBS_MAX_INTERPOLATION_ORDER + 1; n_points++)
+        {
+            for (double t_interp : {-0.0005, 0.0, 0.0012, 0.0025, 0.0049, 0.006})
+                {
+                    lagrange_weights(t.data(), n_points, t_interp, weights.data());
+                    double sum = 0.0;
+                    for (uint32_t k = 0; k < n_points; k++)
+                        {
+                            sum += weights[k];
+                        }
+                    EXPECT_NEAR(1.0, sum, 1e-9) << n_points << " points at " << t_interp;
+                }
+        }
+
+    // at a node, the weights select that node
+    lagrange_weights(t.data(), 6, t[3], weights.data());
+    for (uint32_t k = 0; k < 6; k++)
+        {
+            EXPECT_NEAR(k == 3 ? 1.0 : 0.0, weights[k], 1e-12);
+        }
+}
+
+
+TEST(ObsInterpolationTest, LagrangeWeightsReproducePolynomials)
+{
+    // relative abscissae in seconds, irregularly spaced as the tracking epochs
+    const std::array<double, 6> t{-0.0025, -0.0015, -0.0004, 0.0005, 0.0016, 0.0024};
+    // a polynomial of degree n_points - 1 is interpolated exactly
+    const auto polynomial = [](double x, uint32_t degree) {
+        const std::array<double, 6> coefficients{2.0e7, -650.0, 3.5e3, -1.2e5, 4.0e6, 7.5e8};
+        double value = 0.0;
+        for (int32_t d = static_cast<int32_t>(degree); d >= 0; d--)
+            {
+                value = value * x + coefficients[d];
+            }
+        return value;
+    };
+    std::array<double, 6> weights{};
+    for (uint32_t n_points = 1; n_points <= OBS_MAX_INTERPOLATION_ORDER + 1; n_points++)
+        {
+            const uint32_t degree = n_points - 1;
+            for (double t_interp : {-0.002, -0.0001, 0.0, 0.0011, 0.0023})
+                {
+                    lagrange_weights(t.data(), n_points, t_interp, weights.data());
+                    double interpolated = 0.0;
+                    for (uint32_t k = 0; k < n_points; k++)
+                        {
+                            interpolated += weights[k] * polynomial(t[k], degree);
+                        }
+                    EXPECT_NEAR(polynomial(t_interp, degree), interpolated, 1e-6) << "degree " << degree << " at " << t_interp;
+                }
+        }
+}
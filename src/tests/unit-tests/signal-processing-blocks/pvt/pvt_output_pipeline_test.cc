@@ -0,0 +1,201 @@
+/*!
+ * \file pvt_output_pipeline_test.cc
+ * \brief Implements Unit Tests for the Pvt_Output_Pipeline class.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_make_unique.h"
+#include "pvt_conf.h"
+#include "pvt_output_pipeline.h"
+#include "rtklib_solver.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+std::unique_ptr<Rtklib_Solver> make_output_solver()
+{
+    const rtk_t rtk{};
+    const Pvt_Conf conf;
+    return std::make_unique<Rtklib_Solver>(rtk, conf, "", 1, false, false);
+}
+
+
+std::shared_ptr<Pvt_Output_Epoch> make_output_epoch(double rx_time, uint32_t sinks)
+{
+    auto epoch = std::make_shared<Pvt_Output_Epoch>();
+    epoch->rx_time = rx_time;
+    epoch->sinks = sinks;
+    return epoch;
+}
+
+
+// Holds the writer thread in the first epoch until release() is called
+class Blocking_Sink
+{
+public:
+    void operator()(const Pvt_Output_Epoch& epoch)
+    {
+        written.push_back(epoch.rx_time);
+        started = true;
+        while (!released)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+    }
+
+    void wait_started() const
+    {
+        while (!started)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+    }
+
+    void release() { released = true; }
+
+    std::vector<double> written;
+
+private:
+    std::atomic<bool> started{false};
+    std::atomic<bool> released{false};
+};
+}  // namespace
+
+
+TEST(PvtOutputPipelineTest, SynchronousCopiesSnapshot)
+{
+    auto source = make_output_solver();
+    source->set_num_valid_observations(7);
+    source->set_valid_position(true);
+    Gps_Ephemeris eph;
+    eph.PRN = 3;
+    source->gps_ephemeris_map[3] = eph;
+
+    Pvt_Output_Pipeline pipeline(make_output_solver(), false, 8, Pvt_Overflow_Policy::block);
+    int calls = 0;
+    pipeline.set_sink(PVT_SINK_RINEX, [&calls](const Rtklib_Solver& solver, const Pvt_Output_Epoch& epoch) {
+        EXPECT_EQ(7, solver.get_num_valid_observations());
+        EXPECT_TRUE(solver.is_valid_position());
+        EXPECT_EQ(1U, solver.gps_ephemeris_map.count(3));
+        EXPECT_DOUBLE_EQ(10.0, epoch.rx_time);
+        calls++;
+    });
+
+    auto epoch = make_output_epoch(10.0, 1U << PVT_SINK_RINEX | 1U << PVT_SINK_KML);
+    epoch->solution = Pvt_Output_Solution(*source);
+    epoch->nav_data = std::make_shared<const Pvt_Output_Nav_Data>(*source);
+    pipeline.submit(epoch);
+
+    // Written before submit() returns, and later changes of the source are not seen
+    EXPECT_EQ(1, calls);
+    source->set_num_valid_observations(3);
+    pipeline.submit(epoch);
+    EXPECT_EQ(2, calls);
+    EXPECT_EQ(2U, pipeline.sink_stats(PVT_SINK_RINEX).epochs);
+    EXPECT_EQ(0U, pipeline.sink_stats(PVT_SINK_KML).epochs);  // no sink registered
+}
+
+
+TEST(PvtOutputPipelineTest, BlockKeepsEveryEpochInOrder)
+{
+    Pvt_Output_Pipeline pipeline(make_output_solver(), true, 4, Pvt_Overflow_Policy::block);
+    std::vector<double> written;
+    std::vector<int> tasks;
+    pipeline.set_sink(PVT_SINK_NMEA, [&written](const Rtklib_Solver& /*solver*/, const Pvt_Output_Epoch& epoch) {
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        written.push_back(epoch.rx_time);
+    });
+
+    for (int i = 0; i < 50; i++)
+        {
+            auto task = make_output_epoch(0.0, 0);
+            task->tasks.emplace_back([&tasks, i]() { tasks.push_back(i); });
+            pipeline.submit(task);
+            pipeline.submit(make_output_epoch(static_cast<double>(i), 1U << PVT_SINK_NMEA));
+        }
+    pipeline.stop();
+
+    ASSERT_EQ(50U, written.size());
+    ASSERT_EQ(50U, tasks.size());
+    for (int i = 0; i < 50; i++)
+        {
+            EXPECT_DOUBLE_EQ(static_cast<double>(i), written[i]);
+            EXPECT_EQ(i, tasks[i]);
+        }
+    EXPECT_EQ(0U, pipeline.dropped_epochs());
+    const Pvt_Sink_Stats stats = pipeline.sink_stats(PVT_SINK_NMEA);
+    EXPECT_EQ(50U, stats.epochs);
+    EXPECT_GE(stats.max_write_ms, 0.5);
+    EXPECT_GE(stats.max_latency_ms, stats.max_write_ms);
+}
+
+
+TEST(PvtOutputPipelineTest, DropOldestKeepsTasks)
+{
+    Pvt_Output_Pipeline pipeline(make_output_solver(), true, 2, Pvt_Overflow_Policy::drop_oldest);
+    Blocking_Sink sink;
+    std::atomic<int> tasks{0};
+    pipeline.set_sink(PVT_SINK_RTCM, [&sink](const Rtklib_Solver& /*solver*/, const Pvt_Output_Epoch& epoch) { sink(epoch); });
+
+    pipeline.submit(make_output_epoch(0.0, 1U << PVT_SINK_RTCM));
+    sink.wait_started();
+    for (int i = 1; i <= 10; i++)
+        {
+            auto epoch = make_output_epoch(static_cast<double>(i), 1U << PVT_SINK_RTCM);
+            epoch->tasks.emplace_back([&tasks]() { tasks++; });
+            pipeline.submit(epoch);
+        }
+    sink.release();
+    pipeline.stop();
+
+    // Only the two newest epochs fit in the queue
+    ASSERT_EQ(3U, sink.written.size());
+    EXPECT_DOUBLE_EQ(0.0, sink.written[0]);
+    EXPECT_DOUBLE_EQ(9.0, sink.written[1]);
+    EXPECT_DOUBLE_EQ(10.0, sink.written[2]);
+    EXPECT_EQ(8U, pipeline.dropped_epochs());
+    EXPECT_EQ(10, tasks.load());
+}
+
+
+TEST(PvtOutputPipelineTest, CoalesceMergesOutputs)
+{
+    Pvt_Output_Pipeline pipeline(make_output_solver(), true, 2, Pvt_Overflow_Policy::coalesce);
+    Blocking_Sink sink;
+    std::vector<double> kml;
+    pipeline.set_sink(PVT_SINK_RINEX, [&sink](const Rtklib_Solver& /*solver*/, const Pvt_Output_Epoch& epoch) { sink(epoch); });
+    pipeline.set_sink(PVT_SINK_KML, [&kml](const Rtklib_Solver& /*solver*/, const Pvt_Output_Epoch& epoch) { kml.push_back(epoch.rx_time); });
+
+    pipeline.submit(make_output_epoch(0.0, 1U << PVT_SINK_RINEX));
+    sink.wait_started();
+    for (int i = 1; i <= 10; i++)
+        {
+            const uint32_t sinks = (i == 3) ? (1U << PVT_SINK_KML) : (1U << PVT_SINK_RINEX);
+            pipeline.submit(make_output_epoch(static_cast<double>(i), sinks));
+        }
+    sink.release();
+    pipeline.stop();
+
+    // Epochs 3 to 10 are written once, with the solution of the last one
+    ASSERT_EQ(4U, sink.written.size());
+    EXPECT_DOUBLE_EQ(1.0, sink.written[1]);
+    EXPECT_DOUBLE_EQ(2.0, sink.written[2]);
+    EXPECT_DOUBLE_EQ(10.0, sink.written[3]);
+    ASSERT_EQ(1U, kml.size());
+    EXPECT_DOUBLE_EQ(10.0, kml[0]);
+    EXPECT_EQ(7U, pipeline.coalesced_epochs());
+    EXPECT_EQ(0U, pipeline.dropped_epochs());
+}
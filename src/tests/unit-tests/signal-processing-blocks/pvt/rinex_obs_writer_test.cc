@@ -0,0 +1,458 @@
+/*!
+ * \file rinex_obs_writer_test.cc
+ * \brief Implements Unit Tests for the Crinex_Encoder and Rinex_Obs_Writer
+ * classes.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_filesystem.h"
+#include "rinex_obs_writer.h"
+#include <boost/crc.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::string rtrimmed(const std::string& line)
+{
+    return line.substr(0, line.find_last_not_of(' ') + 1);
+}
+
+
+std::vector<std::string> split_lines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line))
+        {
+            lines.push_back(line);
+        }
+    return lines;
+}
+
+
+// Inverse of a text difference: ' ' keeps the previous character, '&' is a space
+void apply_text_diff(std::string& previous, const std::string& diff)
+{
+    if (previous.size() < diff.size())
+        {
+            previous.resize(diff.size(), ' ');
+        }
+    for (size_t i = 0; i < diff.size(); i++)
+        {
+            if (diff[i] == '&')
+                {
+                    previous[i] = ' ';
+                }
+            else if (diff[i] != ' ')
+                {
+                    previous[i] = diff[i];
+                }
+        }
+}
+
+
+struct Arc
+{
+    std::array<int64_t, 3> y{};
+    int order{-1};
+};
+
+
+// Inverse of the differences of a data field: "3&value" starts the arc again
+void decode_value(Arc& arc, const std::string& field)
+{
+    const size_t init = field.find('&');
+    if (init != std::string::npos)
+        {
+            arc.y = {std::stoll(field.substr(init + 1)), 0, 0};
+            arc.order = 0;
+            return;
+        }
+    const int64_t d = std::stoll(field);
+    arc.order = std::min(arc.order + 1, 3);
+    if (arc.order == 1)
+        {
+            arc.y[1] = d;
+        }
+    else if (arc.order == 2)
+        {
+            arc.y[2] = d;
+            arc.y[1] += arc.y[2];
+        }
+    else
+        {
+            arc.y[2] += d;
+            arc.y[1] += arc.y[2];
+        }
+    arc.y[0] += arc.y[1];
+}
+
+
+// Minimal CRX2RNX, for records with n_types observations per satellite.
+// Returns the RINEX records without trailing blanks.
+std::vector<std::string> decode_crinex(const std::string& crinex, size_t n_types)
+{
+    struct Sat
+    {
+        std::vector<Arc> arcs;
+        std::string flags;
+    };
+    std::vector<std::string> rinex;
+    std::map<std::string, Sat> previous_sats;
+    std::string epoch;
+    Arc clock;
+    const std::vector<std::string> lines = split_lines(crinex);
+    size_t l = 0;
+    while (l < lines.size())
+        {
+            if (lines[l][0] == '>')
+                {
+                    epoch = lines[l];
+                }
+            else
+                {
+                    apply_text_diff(epoch, lines[l]);
+                }
+            epoch = rtrimmed(epoch);
+            const int n_sats = std::stoi(epoch.substr(32, 3));
+            if (epoch[31] > '1')
+                {
+                    // Special event, followed by its records as they are
+                    rinex.insert(rinex.end(), lines.begin() + l, lines.begin() + l + 1 + n_sats);
+                    l += 1 + n_sats;
+                    epoch.clear();
+                    continue;
+                }
+            std::string record = epoch.substr(0, 41);
+            if (lines[l + 1].empty())
+                {
+                    clock.order = -1;
+                }
+            else
+                {
+                    decode_value(clock, lines[l + 1]);
+                    std::array<char, 32> value{};
+                    std::snprintf(value.data(), value.size(), "%15.12f", static_cast<double>(clock.y[0]) * 1e-12);
+                    record += value.data();
+                }
+            rinex.push_back(rtrimmed(record));
+            l += 2;
+            std::map<std::string, Sat> sats;
+            for (int s = 0; s < n_sats; s++, l++)
+                {
+                    const std::string id = epoch.substr(41 + 3 * s, 3);
+                    Sat sat = previous_sats.count(id) ? previous_sats[id] : Sat();
+                    sat.arcs.resize(n_types);
+                    const std::string& line = lines[l];
+                    record = id;
+                    size_t pos = 0;
+                    for (size_t f = 0; f < n_types; f++)
+                        {
+                            size_t end = (pos < line.size()) ? line.find(' ', pos) : std::string::npos;
+                            const std::string field = (pos < line.size()) ? line.substr(pos, end - pos) : std::string();
+                            pos = (end == std::string::npos) ? line.size() + 1 : end + 1;
+                            Arc& arc = sat.arcs[f];
+                            if (field.empty())
+                                {
+                                    arc.order = -1;
+                                    record += std::string(14, ' ');
+                                    continue;
+                                }
+                            decode_value(arc, field);
+                            std::array<char, 32> value{};
+                            std::snprintf(value.data(), value.size(), "%14.3f", static_cast<double>(arc.y[0]) / 1000.0);
+                            record += value.data();
+                        }
+                    apply_text_diff(sat.flags, (pos < line.size()) ? line.substr(pos) : std::string());
+                    sat.flags.resize(2 * n_types, ' ');
+                    // Put the flags after each value
+                    std::string with_flags = record.substr(0, 3);
+                    for (size_t f = 0; f < n_types; f++)
+                        {
+                            with_flags += record.substr(3 + 14 * f, 14) + sat.flags.substr(2 * f, 2);
+                        }
+                    rinex.push_back(rtrimmed(with_flags));
+                    sats[id] = sat;
+                }
+            previous_sats = sats;
+        }
+    return rinex;
+}
+
+
+std::string read_test_file(const std::string& name)
+{
+    std::ifstream file(std::string(TEST_PATH) + "data/crinex_test/" + name, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+
+std::string obs_record(const char* id, double c1c, double l1c, const char* flags)
+{
+    std::array<char, 81> line{};
+    std::snprintf(line.data(), line.size(), "%s%14.3f%c%c%14.3f%c%c", id, c1c, flags[0], flags[1], l1c, flags[2], flags[3]);
+    std::string record(line.data());
+    record.resize(80, ' ');
+    return record + '\n';
+}
+
+
+std::string obs_types_record(char system)
+{
+    std::string record = std::string(1, system) + "    2 C1C L1C";
+    record.resize(60, ' ');
+    return record + "SYS / # / OBS TYPES \n";
+}
+
+
+std::string epoch_record(int second, int n_sats)
+{
+    std::array<char, 81> line{};
+    std::snprintf(line.data(), line.size(), "> 2019 04 07 00 01 %02d.0000000  0%3d", second, n_sats);
+    std::string record(line.data());
+    record.resize(80, ' ');
+    return record + '\n';
+}
+}  // namespace
+
+
+TEST(RinexObsWriterTest, CrinexHeader)
+{
+    std::string header;
+    Crinex_Encoder::header(header, "GNSS-SDR 0.0.19");
+    const std::vector<std::string> lines = split_lines(header);
+    ASSERT_EQ(2U, lines.size());
+    EXPECT_EQ("3.0                 COMPACT RINEX FORMAT                    CRINEX VERS   / TYPE", lines[0]);
+    EXPECT_EQ(80U, lines[1].size());
+    EXPECT_EQ(0, lines[1].compare(0, 40, "GNSS-SDR 0.0.19                         "));
+    EXPECT_EQ(0, lines[1].compare(60, 20, "CRINEX PROG / DATE  "));
+}
+
+
+TEST(RinexObsWriterTest, EncodesArcsAndFlags)
+{
+    std::string rinex;
+    rinex += epoch_record(40, 2);
+    rinex += obs_record("G01", 22000000.000, 115611111.111, " 7 7");
+    rinex += obs_record("G05", 23000000.500, 120868000.250, " 6 6");
+    std::string text;
+    Crinex_Encoder encoder;
+    encoder.set_obs_types(obs_types_record('G'));
+    encoder.encode(rinex.data(), rinex.size(), text);
+
+    // The second L1C value of G05 is missing
+    rinex = epoch_record(41, 2);
+    rinex += obs_record("G01", 22000100.000, 115611636.611, " 7 7");
+    rinex += "G05  23000050.500 6" + std::string(61, ' ') + '\n';
+    encoder.encode(rinex.data(), rinex.size(), text);
+
+    // G05 is lost, and the SSI of the L1C value of G01 changes
+    rinex = epoch_record(42, 1);
+    rinex += obs_record("G01", 22000200.010, 115612162.121, " 7 6");
+    encoder.encode(rinex.data(), rinex.size(), text);
+
+    rinex = epoch_record(43, 2);
+    rinex += obs_record("G01", 22000300.030, 115612687.641, " 7 6");
+    rinex += obs_record("G05", 23000150.000, 120868800.000, " 6 6");
+    encoder.encode(rinex.data(), rinex.size(), text);
+
+    const std::vector<std::string> expected = {
+        "> 2019 04 07 00 01 40.0000000  0  2      G01G05",
+        "",
+        "3&22000000000 3&115611111111  7 7",
+        "3&23000000500 3&120868000250  6 6",
+        std::string(20, ' ') + "1",
+        "",
+        "100000 525500",  // first differences
+        "50000     &",    // missing value and SSI
+        std::string(20, ' ') + "2" + std::string(13, ' ') + "1" + std::string(9, ' ') + "&&&",
+        "",
+        "10 10    6",  // second differences
+        std::string(20, ' ') + "3" + std::string(13, ' ') + "2" + std::string(9, ' ') + "G05",
+        "",
+        "0 0",  // third differences
+        "3&23000150000 3&120868800000  6 6"};
+    EXPECT_EQ(expected, split_lines(text));
+}
+
+
+TEST(RinexObsWriterTest, RoundTrip)
+{
+    const std::vector<std::string> ids = {"G01", "G07", "G12", "E03", "E11", "R05", "C20", "C33"};
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+    std::uniform_int_distribution<int> dice(0, 99);
+
+    Crinex_Encoder encoder;
+    encoder.set_obs_types(obs_types_record('G') + obs_types_record('E') + obs_types_record('R') + obs_types_record('C'));
+    std::string rinex;
+    std::string crinex;
+    std::vector<std::string> expected;
+    for (int epoch = 0; epoch < 300; epoch++)
+        {
+            std::string records;
+            int n_sats = 0;
+            for (size_t s = 0; s < ids.size(); s++)
+                {
+                    if (dice(gen) < 8)
+                        {
+                            continue;  // satellite lost in this epoch
+                        }
+                    const double t = epoch;
+                    const double range = 2.0e7 + 1.0e6 * s + 650.0 * t + 0.013 * t * t + noise(gen);
+                    const double phase = range / 0.19029367 + 3.0e3 * s;
+                    const char ssi = static_cast<char>('5' + (dice(gen) < 10 ? 1 : 0));
+                    const char flags[] = {' ', ssi, dice(gen) < 3 ? '1' : ' ', ssi, '\0'};
+                    std::string record = obs_record(ids[s].c_str(), range, -phase, flags);
+                    if (dice(gen) < 5)
+                        {
+                            record.replace(3, 16, std::string(16, ' '));  // missing pseudorange
+                        }
+                    else if (dice(gen) < 5)
+                        {
+                            record.replace(19, 16, std::string(16, ' '));  // missing phase
+                        }
+                    records += record;
+                    expected.push_back(rtrimmed(record.substr(0, 80)));
+                    n_sats++;
+                }
+            const std::string epoch_line = epoch_record(epoch % 60, n_sats);
+            expected.insert(expected.end() - n_sats, rtrimmed(epoch_line.substr(0, 80)));
+            rinex = epoch_line + records;
+            encoder.encode(rinex.data(), rinex.size(), crinex);
+        }
+
+    EXPECT_EQ(expected, decode_crinex(crinex, 2));
+    EXPECT_LT(crinex.size() * 2, expected.size() * 81);
+}
+
+
+TEST(RinexObsWriterTest, MatchesCrinexFixture)
+{
+    // crinex_test.24D was derived by hand from crinex_test.24O following the
+    // Compact RINEX 3.0 format description. It covers the receiver clock
+    // offset, missing values, LLI/SSI changes, satellites lost and found
+    // again, a shorter epoch record and a special event.
+    const std::string rinex = read_test_file("crinex_test.24O");
+    const std::string expected = read_test_file("crinex_test.24D");
+    ASSERT_FALSE(rinex.empty());
+    ASSERT_FALSE(expected.empty());
+    const size_t header_size = rinex.find('\n', rinex.find("END OF HEADER")) + 1;
+    const std::string header = rinex.substr(0, header_size);
+    const std::string records = rinex.substr(header_size);
+
+    std::string crinex;
+    Crinex_Encoder::header(crinex, "GNSS-SDR");
+    crinex += header;
+    Crinex_Encoder encoder;
+    encoder.set_obs_types(header);
+    encoder.encode(records.data(), records.size(), crinex);
+
+    // Byte by byte, except the date of the CRINEX PROG / DATE record
+    ASSERT_GT(crinex.size(), 161U);
+    EXPECT_EQ(0, crinex.compare(141, 20, "CRINEX PROG / DATE  "));
+    crinex.replace(81, 80, expected, 81, 80);
+    EXPECT_EQ(expected, crinex);
+
+    // and back to the RINEX records
+    EXPECT_EQ(split_lines(records), decode_crinex(expected.substr(162 + header_size), 3));
+}
+
+
+TEST(RinexObsWriterTest, GzipHeaderUpdatedInPlace)
+{
+    if (!Rinex_Obs_Writer::gzip_available())
+        {
+            return;  // built without zlib
+        }
+    const std::string filename = "rinex_obs_writer_test.25D.gz";
+    const std::string header = std::string(60, ' ') + "COMMENT             \n" + std::string(60, ' ') + "END OF HEADER       \n";
+    std::string records = epoch_record(40, 1) + obs_record("G01", 22000000.000, 115611111.111, " 7 7");
+    records += epoch_record(41, 1) + obs_record("G01", 22000100.000, 115611636.611, " 7 7");
+
+    Rinex_Obs_Writer writer(true, true);
+    std::fstream file(filename, std::ios::out | std::ios::in | std::ios::trunc | std::ios::binary);
+    writer.start_file(file, "GNSS-SDR");
+    file << header;
+    writer.end_header(file, filename);
+    EXPECT_EQ(15, writer.header_offset());
+    writer.epoch_stream() << records;
+    writer.write_epochs(file);
+
+    // Read back the header, and replace the COMMENT line
+    std::string new_header;
+    file.flush();
+    file.seekg(writer.header_offset());
+    for (std::string line; std::getline(file, line);)
+        {
+            new_header += line + '\n';
+            if (line.find("END OF HEADER") != std::string::npos)
+                {
+                    break;
+                }
+        }
+    ASSERT_EQ(0, new_header.compare(0, 20, "3.0                 "));
+    new_header.replace(new_header.size() - 162, 7, "UPDATED");
+    EXPECT_TRUE(writer.update_header(filename, new_header));
+    EXPECT_FALSE(writer.update_header(filename, new_header + header));
+    writer.end_file(file);
+    file.close();
+
+    std::ifstream in(filename, std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const auto le32 = [&contents](size_t pos) {
+        uint32_t value = 0;
+        for (int i = 3; i >= 0; i--)
+            {
+                value = (value << 8) | static_cast<unsigned char>(contents[pos + i]);
+            }
+        return value;
+    };
+    const auto crc = [](const std::string& data) {
+        boost::crc_32_type result;
+        result.process_bytes(data.data(), data.size());
+        return result.checksum();
+    };
+
+    // First gzip member: the header in a single stored block
+    const size_t size = new_header.size();
+    ASSERT_GT(contents.size(), 23 + size);
+    EXPECT_EQ('\x1f', contents[0]);
+    EXPECT_EQ('\x8b', contents[1]);
+    EXPECT_EQ('\x01', contents[10]);
+    EXPECT_EQ(size, le32(11) & 0xFFFF);
+    EXPECT_EQ(size ^ 0xFFFF, le32(11) >> 16);
+    EXPECT_EQ(new_header, contents.substr(15, size));
+    EXPECT_EQ(crc(new_header), le32(15 + size));
+    EXPECT_EQ(size, le32(19 + size));
+
+    // Second gzip member: the deflated Compact RINEX records
+    std::string crinex;
+    Crinex_Encoder encoder;
+    encoder.encode(records.data(), records.size(), crinex);
+    EXPECT_EQ('\x1f', contents[23 + size]);
+    EXPECT_EQ('\x8b', contents[24 + size]);
+    EXPECT_EQ(crc(crinex), le32(contents.size() - 8));
+    EXPECT_EQ(crinex.size(), le32(contents.size() - 4));
+    fs::remove(filename);
+}
@@ -19,9 +19,11 @@
 #include "rinex_printer.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solver.h"
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 
 class RinexPrinterTest : public ::testing::Test
@@ -1033,3 +1035,220 @@ TEST_F(RinexPrinterTest, MixedObsLogGpsGlo)
     fs::remove(navfile);
     fs::remove(obsfile);
 }
+
+
+TEST_F(RinexPrinterTest, ObsHeaderUpdatedInPlace)
+{
+    Pvt_Conf conf;
+    auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, conf, "filename", 1, false, false);
+    auto eph = Gps_Ephemeris();
+    eph.PRN = 3;
+    pvt_solution->gps_ephemeris_map[3] = std::move(eph);
+
+    std::map<int, Gnss_Synchro> gnss_observables_map;
+    Gnss_Synchro gs{};
+    gs.System = 'G';
+    std::memcpy(static_cast<void*>(gs.Signal), "1C", 3);
+    gs.PRN = 3;
+    gs.Pseudorange_m = 22000000.0;
+    gnss_observables_map[1] = gs;
+
+    auto rp = std::make_shared<Rinex_Printer>();
+    rp->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 100.0, 1, true);
+
+    // UTC data arrives later, the LEAP SECONDS record takes a reserved line
+    pvt_solution->gps_utc_model.A0 = 1e-9;
+    pvt_solution->gps_utc_model.DeltaT_LS = 18;
+    rp->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 101.0, 1, true);
+
+    const std::string obsfile = rp->get_obsfilename();
+    const std::string navfile = rp->get_navfilename()[0];
+    rp = nullptr;  // close the RINEX files so we can inspect them
+
+    std::fstream fstr(obsfile.c_str(), std::fstream::in);
+    std::string line_str;
+    std::string time_of_last_obs;
+    int leap_seconds = 0;
+    int reserved_lines = 0;
+    int epochs = 0;
+    bool header = true;
+    while (std::getline(fstr, line_str))
+        {
+            if (header)
+                {
+                    if (line_str.find("TIME OF LAST OBS", 59) != std::string::npos)
+                        {
+                            time_of_last_obs = line_str;
+                        }
+                    if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                        {
+                            leap_seconds++;
+                        }
+                    if (line_str == std::string(60, ' ') + "COMMENT             ")
+                        {
+                            reserved_lines++;
+                        }
+                    header = (line_str.find("END OF HEADER", 59) == std::string::npos);
+                }
+            else if (line_str.compare(0, 2, "> ") == 0)
+                {
+                    epochs++;
+                }
+        }
+    fstr.close();
+
+    EXPECT_EQ(1, leap_seconds);
+    EXPECT_EQ(2, epochs);
+    EXPECT_EQ(0, reserved_lines);  // both are used
+    const std::string expected_str("  2019    04    07    00    01   41.0000000     GPS         TIME OF LAST OBS    ");
+    EXPECT_EQ(0, expected_str.compare(time_of_last_obs));
+
+    std::fstream fstr_nav(navfile.c_str(), std::fstream::in);
+    bool leap_seconds_updated = false;
+    while (std::getline(fstr_nav, line_str))
+        {
+            if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    leap_seconds_updated = (line_str.compare(0, 6, "    18") == 0);
+                }
+        }
+    fstr_nav.close();
+    EXPECT_TRUE(leap_seconds_updated);
+    fs::remove(obsfile);
+    fs::remove(navfile);
+}
+
+
+TEST_F(RinexPrinterTest, HourlyRotation)
+{
+    Pvt_Conf conf;
+    auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, conf, "filename", 1, false, false);
+    auto eph = Gps_Ephemeris();
+    eph.PRN = 3;
+    pvt_solution->gps_ephemeris_map[3] = std::move(eph);
+
+    std::map<int, Gnss_Synchro> gnss_observables_map;
+    Gnss_Synchro gs{};
+    gs.System = 'G';
+    std::memcpy(static_cast<void*>(gs.Signal), "1C", 3);
+    gs.PRN = 3;
+    gs.Pseudorange_m = 22000000.0;
+    gnss_observables_map[1] = gs;
+
+    auto rp = std::make_shared<Rinex_Printer>(3, ".", "rotation_test", "hourly");
+    rp->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 3590.0, 1, true);
+    rp->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 3599.0, 1, true);
+    const std::string first_obsfile = rp->get_obsfilename();
+    rp->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 3600.0, 1, true);
+    const std::string second_obsfile = rp->get_obsfilename();
+    const std::vector<std::string> navfiles = rp->get_navfilename();
+    rp = nullptr;  // close the RINEX files so we can inspect them
+
+    EXPECT_NE(first_obsfile, second_obsfile);
+    EXPECT_EQ(2U, navfiles.size());
+
+    const auto read_times = [](const std::string& filename, std::string& first, std::string& last) {
+        std::fstream fstr(filename.c_str(), std::fstream::in);
+        std::string line_str;
+        int epochs = 0;
+        while (std::getline(fstr, line_str))
+            {
+                if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
+                    {
+                        first = line_str.substr(0, 43);
+                    }
+                else if (line_str.find("TIME OF LAST OBS", 59) != std::string::npos)
+                    {
+                        last = line_str.substr(0, 43);
+                    }
+                else if (line_str.compare(0, 2, "> ") == 0)
+                    {
+                        epochs++;
+                    }
+            }
+        return epochs;
+    };
+
+    std::string first;
+    std::string last;
+    EXPECT_EQ(2, read_times(first_obsfile, first, last));
+    EXPECT_EQ(0, first.compare("  2019    04    07    00    59   50.0000000"));
+    EXPECT_EQ(0, last.compare("  2019    04    07    00    59   59.0000000"));
+    EXPECT_EQ(1, read_times(second_obsfile, first, last));
+    EXPECT_EQ(0, first.compare("  2019    04    07    01    00    0.0000000"));
+    EXPECT_EQ(0, last.compare("  2019    04    07    01    00    0.0000000"));
+
+    fs::remove(first_obsfile);
+    fs::remove(second_obsfile);
+    for (const auto& navfile : navfiles)
+        {
+            fs::remove(navfile);
+        }
+}
+
+
+TEST_F(RinexPrinterTest, CompactObsLog)
+{
+    Pvt_Conf conf;
+    auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, conf, "filename", 1, false, false);
+    auto eph = Gps_Ephemeris();
+    eph.PRN = 3;
+    pvt_solution->gps_ephemeris_map[3] = std::move(eph);
+
+    std::map<int, Gnss_Synchro> gnss_observables_map;
+    Gnss_Synchro gs{};
+    gs.System = 'G';
+    std::memcpy(static_cast<void*>(gs.Signal), "1C", 3);
+    gs.PRN = 3;
+    gs.Pseudorange_m = 22000000.0;
+    gnss_observables_map[1] = gs;
+
+    auto rp = std::make_shared<Rinex_Printer>(3, ".", "crinex_test", "none", true);
+    rp->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 100.0, 1, true);
+    pvt_solution->gps_utc_model.A0 = 1e-9;
+    pvt_solution->gps_utc_model.DeltaT_LS = 18;
+    gnss_observables_map[1].Pseudorange_m = 22000100.0;
+    rp->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 101.0, 1, true);
+
+    const std::string obsfile = rp->get_obsfilename();
+    const std::string navfile = rp->get_navfilename()[0];
+    rp = nullptr;  // close the RINEX files so we can inspect them
+    EXPECT_EQ('D', obsfile.back());
+
+    std::fstream fstr(obsfile.c_str(), std::fstream::in);
+    std::vector<std::string> lines;
+    std::string line_str;
+    bool header = true;
+    int leap_seconds = 0;
+    int time_of_last_obs = 0;
+    while (std::getline(fstr, line_str))
+        {
+            if (header)
+                {
+                    leap_seconds += (line_str.find("LEAP SECONDS", 59) != std::string::npos);
+                    time_of_last_obs += (line_str.find("TIME OF LAST OBS", 59) != std::string::npos);
+                    header = (line_str.find("END OF HEADER", 59) == std::string::npos);
+                }
+            lines.push_back(line_str);
+        }
+    fstr.close();
+
+    ASSERT_GT(lines.size(), 6U);
+    EXPECT_EQ(0, lines[0].compare(60, 20, "CRINEX VERS   / TYPE"));
+    EXPECT_EQ(0, lines[1].compare(60, 18, "CRINEX PROG / DATE"));
+    EXPECT_EQ(0, lines[2].compare(60, 20, "RINEX VERSION / TYPE"));
+    EXPECT_EQ(1, leap_seconds);
+    EXPECT_EQ(1, time_of_last_obs);
+
+    // Records after the header
+    const std::vector<std::string> records(lines.end() - 6, lines.end());
+    EXPECT_EQ("> 2019 04 07 00 01 40.0000000  0  1      G03", records[0]);
+    EXPECT_EQ("", records[1]);
+    EXPECT_EQ(0, records[2].compare(0, 25, "3&22000000000 3&0 3&0 3&0"));
+    EXPECT_EQ(std::string(20, ' ') + "1", records[3]);
+    EXPECT_EQ("", records[4]);
+    EXPECT_EQ("100000 0 0 0", records[5]);
+
+    fs::remove(obsfile);
+    fs::remove(navfile);
+}
@@ -593,6 +593,131 @@ TEST(RtcmTest, MSM1)
     EXPECT_EQ(psrng4_s, read_psrng4_s_2);
 }
 
+TEST(RtcmTest, BitWriter)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    Rtcm_Bit_Writer writer;
+    writer.start_frame();
+    writer.put_bits(0x3, 2);
+    writer.put(std::bitset<12>(1005));
+    writer.skip_bits(16);
+    writer.put_bits(0x1, 1);
+    EXPECT_EQ(31U, writer.bit_position());
+    writer.put_at(14, std::bitset<16>(0xABCD));
+    writer.finish_frame();
+    ASSERT_EQ(10U, writer.size());
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(writer.to_string())).compare("D30004CFB6AF368FD8D1"));
+    EXPECT_EQ(true, rtcm->check_CRC(writer.to_string()));
+
+    // The buffer is reused, no leftovers from the previous frame are expected
+    writer.start_frame();
+    writer.put_bits(0x1, 1);
+    writer.finish_frame();
+    EXPECT_EQ(0, rtcm->bin_to_hex(rtcm->binary_data_to_bin(writer.to_string())).substr(0, 8).compare("D3000180"));
+    EXPECT_EQ(true, rtcm->check_CRC(writer.to_string()));
+
+    const std::string check = "123456789";
+    EXPECT_EQ(0xCDE703U, Rtcm_Bit_Writer::crc24q(reinterpret_cast<const uint8_t*>(check.data()), check.size()));
+}
+
+
+TEST(RtcmTest, EncodedFrames)
+{
+    // Frames produced by the former string-based encoder for the same inputs
+    auto rtcm = std::make_shared<Rtcm>();
+    auto to_hex = [&rtcm](const std::string& message) { return rtcm->bin_to_hex(rtcm->binary_data_to_bin(message)); };
+    auto make_synchro = [](char system, const char* signal, uint32_t prn, double k) {
+        Gnss_Synchro synchro{};
+        synchro.System = system;
+        std::memcpy(static_cast<void*>(synchro.Signal), signal, 3);
+        synchro.PRN = prn;
+        synchro.Pseudorange_m = 20000000.0 + 123456.789 * k;
+        synchro.Carrier_phase_rads = 1.0e5 + 2345.678 * k;
+        synchro.Carrier_Doppler_hz = -3000.0 + 456.7 * k;
+        synchro.CN0_dB_hz = 35.0 + 1.25 * k;
+        synchro.Flag_valid_pseudorange = true;
+        return synchro;
+    };
+
+    Gps_Ephemeris gps_eph = Gps_Ephemeris();
+    gps_eph.PRN = 9;
+    gps_eph.WN = 2201;
+    gps_eph.toe = 345600;
+    gps_eph.toc = 345600;
+    gps_eph.sqrtA = 5153.65;
+    gps_eph.ecc = 0.0123;
+    gps_eph.M_0 = 0.4321;
+    gps_eph.OMEGA_0 = -1.2345;
+    gps_eph.omega = 0.987;
+    gps_eph.i_0 = 0.9613;
+    gps_eph.af0 = 2.5e-5;
+    gps_eph.af1 = -1.1e-12;
+    gps_eph.IODE_SF2 = 45;
+    gps_eph.IODC = 45;
+    gps_eph.Crs = 42.5;
+    gps_eph.Cuc = 1.5e-6;
+
+    Galileo_Ephemeris gal_eph = Galileo_Ephemeris();
+    gal_eph.PRN = 10;
+    gal_eph.WN = 1177;
+    gal_eph.toe = 345600;
+    gal_eph.sqrtA = 5440.6;
+    gal_eph.ecc = 0.0004;
+    gal_eph.IOD_nav = 78;
+    gal_eph.af0 = -3.5e-5;
+
+    const double obs_time = 2537.0;
+    std::map<int32_t, Gnss_Synchro> gps_obs;
+    std::map<int32_t, Gnss_Synchro> gal_obs;
+    double k = 0.0;
+    int32_t ch = 0;
+    for (uint32_t prn : {2U, 9U, 17U})
+        {
+            gps_obs[ch++] = make_synchro('G', "1C", prn, k++);
+            gps_obs[ch++] = make_synchro('G', "2S", prn, k++);
+        }
+    for (uint32_t prn : {3U, 10U})
+        {
+            gal_obs[ch++] = make_synchro('E', "1B", prn, k++);
+            gal_obs[ch++] = make_synchro('E', "5X", prn, k++);
+        }
+
+    EXPECT_EQ(0, to_hex(rtcm->print_MT1004(gps_eph, {}, obs_time, gps_obs, 1234)).compare("D300373EC4D2009AD8A030094613B33EF64010A30800200000048927AB1F16C8D700872C400100000026D1292D04916FC8044A0200080000014ABBE316"));
+    EXPECT_EQ(0, to_hex(rtcm->print_MT1019(gps_eph)).compare("D3003D3FB2499000002D546000FFF60346DC2D05500000119AF76C0325064C2F830000A10D333354600000CDB3B2AB0000272AB90300002836C88F00000000004A1F31"));
+    EXPECT_EQ(0, to_hex(rtcm->print_MT1045(gal_eph)).compare("D3003E415292644E0000000000000001FFDB4CC40000000000000000000000D1B7180002A8133335680000000000000000000000000000000000000000000000005C3988"));
+    EXPECT_EQ(0, to_hex(rtcm->print_MSM_4(gps_eph, {}, {}, {}, obs_time, gps_obs, 1234, 0, 0, 0, false, false)).compare("D300414324D2009AD8A000002040400000000000200100007E8486896D44AB8FB4FCF0E4EFBFFB6C2E30CC0003B7FFF65FFFDC80013FFFFD47FFFAE00000004724D3D14891027F"));
+    EXPECT_EQ(0, to_hex(rtcm->print_MSM_7({}, {}, gal_eph, {}, obs_time, gal_obs, 1234, 0, 0, 0, false, false)).compare("D300474494D2009AD8A000001020000000000000080000807A2A300178038063FC2049D6F0D521D0CE0944980007F7FFF6B7FFF050000C6800000000005515E5A172111FF249C5441420AA2CD1"));
+
+    // encode_* returns the same frame, without building a string
+    const std::string msm7 = rtcm->print_MSM_7({}, {}, gal_eph, {}, obs_time, gal_obs, 1234, 0, 0, 0, false, false);
+    const Rtcm_Bit_Writer& frame = rtcm->encode_MSM_7({}, {}, gal_eph, {}, obs_time, gal_obs, 1234, 0, 0, 0, false, false);
+    ASSERT_EQ(msm7.size(), frame.size());
+    EXPECT_EQ(0, std::memcmp(msm7.data(), frame.data(), frame.size()));
+
+    Galileo_HAS_data has_data = Galileo_HAS_data();
+    has_data.tow = 345678;
+    has_data.header.iod_set_id = 19;
+    has_data.Nsys = 1;
+    has_data.gnss_id_mask = {0};
+    has_data.satellite_mask = {(1ULL << 39) | (1ULL << 30) | (1ULL << 20)};
+    has_data.signal_mask = {static_cast<uint16_t>(0x8000 | 0x0400)};
+    has_data.validity_interval_index_orbit_corrections = 5;
+    has_data.gnss_iod = {30, 47, 64};
+    has_data.delta_radial = {-500, -387, -274};
+    has_data.delta_in_track = {700, 549, 398};
+    has_data.delta_cross_track = {-90, -53, -16};
+    has_data.delta_clock_correction = {333, 262, 191};
+    has_data.delta_clock_multiplier = {1};
+    has_data.code_bias = {{-40, 5}, {-30, 2}, {-20, -1}};
+
+    const std::vector<std::string> igm03 = rtcm->print_IGM03(has_data);
+    ASSERT_EQ(1U, igm03.size());
+    EXPECT_EQ(0, to_hex(igm03[0]).compare("D30052FEC02EA8C9CC4000000608F7F9E5806D61FF1F00000000000000000000000000000145FFED1A815727FDEE00000000000000000000000000000A207FCA7C03E31FFD80000000000000000000000000000000E5F7D8"));
+    const std::vector<std::string> igm05 = rtcm->print_IGM05(has_data);
+    ASSERT_EQ(1U, igm05.size());
+    EXPECT_EQ(0, to_hex(igm05[0]).compare("D30014FEC032A8C9CC4000000C10BFB1282FF1540BFD90AB6516"));
+}
+
 
 TEST(RtcmTest, InstantiateServer)
 {
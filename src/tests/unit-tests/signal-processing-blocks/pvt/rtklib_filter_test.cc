@@ -0,0 +1,200 @@
+/*!
+ * \file rtklib_filter_test.cc
+ * \brief  This file implements unit tests for the Kalman filter update and the
+ * scratch memory arena of the RTKLIB library.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_arena.h"
+#include "rtklib_rtkcmn.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+struct Kalman_Problem
+{
+    int n;
+    int m;
+    std::vector<double> x;
+    std::vector<double> P;
+    std::vector<double> H;
+    std::vector<double> v;
+    std::vector<double> R;
+};
+
+
+Kalman_Problem make_problem(int n, int m, double r, unsigned int seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    Kalman_Problem pb{n, m, std::vector<double>(n), std::vector<double>(n * n, 0.0), std::vector<double>(n * m, 0.0), std::vector<double>(m), std::vector<double>(m * m, 0.0)};
+
+    // P=A*A'+I is symmetric and positive definite
+    std::vector<double> A(n * n);
+    for (auto& a : A)
+        {
+            a = uniform(gen);
+        }
+    matmul("NT", n, n, n, 1.0, A.data(), A.data(), 0.0, pb.P.data());
+    for (int i = 0; i < n; i++)
+        {
+            pb.P[i + i * n] += 1.0;
+            pb.x[i] = 10.0 * uniform(gen);
+        }
+    // each measurement depends on a position state and two ambiguity states
+    for (int j = 0; j < m; j++)
+        {
+            pb.H[(j % 3) + j * n] = uniform(gen);
+            pb.H[3 + (j % (n - 3)) + j * n] = 1.0;
+            pb.H[3 + ((j + 1) % (n - 3)) + j * n] = -1.0;
+            pb.v[j] = uniform(gen);
+            pb.R[j + j * m] = r;
+        }
+    return pb;
+}
+
+
+// K=P*H*(H'*P*H+R)^-1, xp=x+K*v, Pp=(I-K*H')*P with explicit inversion
+int dense_update(const Kalman_Problem& pb, std::vector<double>& xp, std::vector<double>& Pp)
+{
+    const int n = pb.n;
+    const int m = pb.m;
+    std::vector<double> F(n * m);
+    std::vector<double> Q(pb.R);
+    std::vector<double> K(n * m);
+    std::vector<double> I(n * n, 0.0);
+    for (int i = 0; i < n; i++)
+        {
+            I[i + i * n] = 1.0;
+        }
+    xp = pb.x;
+    Pp.assign(n * n, 0.0);
+    matmul("NN", n, m, n, 1.0, pb.P.data(), pb.H.data(), 0.0, F.data());
+    matmul("TN", m, m, n, 1.0, pb.H.data(), F.data(), 1.0, Q.data());
+    const int info = matinv(Q.data(), m);
+    if (info == 0)
+        {
+            matmul("NN", n, m, m, 1.0, F.data(), Q.data(), 0.0, K.data());
+            matmul("NN", n, 1, m, 1.0, K.data(), pb.v.data(), 1.0, xp.data());
+            matmul("NT", n, n, m, -1.0, K.data(), pb.H.data(), 1.0, I.data());
+            matmul("NN", n, n, n, 1.0, I.data(), pb.P.data(), 0.0, Pp.data());
+        }
+    return info;
+}
+}  // namespace
+
+
+TEST(RtklibFilterTest, MatchesDenseUpdate)
+{
+    const Kalman_Problem pb = make_problem(40, 12, 0.01, 1);
+    std::vector<double> xp_ref;
+    std::vector<double> Pp_ref;
+    ASSERT_EQ(dense_update(pb, xp_ref, Pp_ref), 0);
+
+    std::vector<double> xp(pb.n);
+    std::vector<double> Pp(pb.n * pb.n);
+    ASSERT_EQ(filter_(pb.x.data(), pb.P.data(), pb.H.data(), pb.v.data(), pb.R.data(), pb.n, pb.m, xp.data(), Pp.data()), 0);
+    for (int i = 0; i < pb.n; i++)
+        {
+            EXPECT_NEAR(xp[i], xp_ref[i], 1e-9);
+            for (int j = 0; j < pb.n; j++)
+                {
+                    EXPECT_NEAR(Pp[i + j * pb.n], Pp_ref[i + j * pb.n], 1e-9);
+                    EXPECT_EQ(Pp[i + j * pb.n], Pp[j + i * pb.n]);
+                }
+        }
+}
+
+
+TEST(RtklibFilterTest, FallsBackWhenNotPositiveDefinite)
+{
+    // a negative measurement variance makes H'*P*H+R indefinite, but invertible
+    const Kalman_Problem pb = make_problem(10, 4, -50.0, 2);
+    std::vector<double> xp_ref;
+    std::vector<double> Pp_ref;
+    ASSERT_EQ(dense_update(pb, xp_ref, Pp_ref), 0);
+
+    std::vector<double> xp(pb.n);
+    std::vector<double> Pp(pb.n * pb.n);
+    ASSERT_EQ(filter_(pb.x.data(), pb.P.data(), pb.H.data(), pb.v.data(), pb.R.data(), pb.n, pb.m, xp.data(), Pp.data()), 0);
+    for (int i = 0; i < pb.n; i++)
+        {
+            EXPECT_NEAR(xp[i], xp_ref[i], 1e-9);
+            for (int j = 0; j < pb.n; j++)
+                {
+                    EXPECT_NEAR(Pp[i + j * pb.n], Pp_ref[i + j * pb.n], 1e-9);
+                }
+        }
+}
+
+
+TEST(RtklibFilterTest, SkipsInactiveStates)
+{
+    Kalman_Problem pb = make_problem(20, 6, 0.01, 3);
+    pb.x[5] = 0.0;  // inactive state
+    std::vector<double> x(pb.x);
+    std::vector<double> P(pb.P);
+    ASSERT_EQ(filter(x.data(), P.data(), pb.H.data(), pb.v.data(), pb.R.data(), pb.n, pb.m), 0);
+    EXPECT_EQ(x[5], 0.0);
+    for (int i = 0; i < pb.n; i++)
+        {
+            EXPECT_EQ(P[5 + i * pb.n], pb.P[5 + i * pb.n]);
+            EXPECT_EQ(P[i + 5 * pb.n], pb.P[i + 5 * pb.n]);
+        }
+    EXPECT_LT(P[0], pb.P[0]);
+}
+
+
+TEST(RtklibFilterTest, ArenaIsReusedAcrossEpochs)
+{
+    Rtklib_Arena arena(1024);
+    uint64_t first_epoch_overflows = 0;
+    EXPECT_EQ(Rtklib_Arena::current(), nullptr);
+    for (int epoch = 0; epoch < 3; epoch++)
+        {
+            Rtklib_Arena_Scope scope(arena);
+            EXPECT_EQ(Rtklib_Arena::current(), &arena);
+            double* A = zeros(20, 20);
+            int* ix = imat(20, 1);
+            double* I = eye(10);
+            EXPECT_TRUE(arena.owns(A));
+            EXPECT_TRUE(arena.owns(ix));
+            EXPECT_TRUE(arena.owns(I));
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(A) % 64, 0U);
+            for (int i = 0; i < 20 * 20; i++)
+                {
+                    EXPECT_EQ(A[i], 0.0);
+                }
+            EXPECT_EQ(I[0], 1.0);
+            EXPECT_EQ(I[1], 0.0);
+            matfree(A);
+            matfree(ix);
+            matfree(I);
+            if (epoch == 0)
+                {
+                    first_epoch_overflows = arena.overflows();
+                }
+        }
+    EXPECT_EQ(Rtklib_Arena::current(), nullptr);
+
+    // the first epoch did not fit in 1024 bytes, the next ones did
+    EXPECT_GT(first_epoch_overflows, 0U);
+    EXPECT_EQ(arena.overflows(), first_epoch_overflows);
+    EXPECT_GE(arena.capacity(), arena.peak());
+
+    // without a scope, matrices come from the heap
+    double* B = mat(4, 4);
+    EXPECT_FALSE(arena.owns(B));
+    matfree(B);
+}
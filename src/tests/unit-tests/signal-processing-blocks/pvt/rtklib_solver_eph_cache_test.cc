@@ -0,0 +1,135 @@
+/*!
+ * \file rtklib_solver_eph_cache_test.cc
+ * \brief  This file implements unit tests for the cache of RTKLIB ephemeris
+ * conversions kept by the PVT solver.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_conf.h"
+#include "rtklib_solver.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace
+{
+std::unique_ptr<Rtklib_Solver> make_eph_cache_test_solver()
+{
+    const rtk_t rtk{};
+    const Pvt_Conf conf;
+    return std::make_unique<Rtklib_Solver>(rtk, conf, "rtklib_solver_eph_cache_test", 1, false, false);
+}
+}  // namespace
+
+
+TEST(RtklibSolverEphCacheTest, GalileoSisaAndHealthInvalidate)
+{
+    auto solver = make_eph_cache_test_solver();
+    Galileo_Ephemeris gal_eph;
+    gal_eph.PRN = 11;
+    gal_eph.IOD_ephemeris = 42;
+    gal_eph.IOD_nav = 42;
+    gal_eph.toe = 345600;
+    gal_eph.toc = 345600;
+    gal_eph.WN = 1200;
+    gal_eph.SISA = 107;
+    gal_eph.af0 = 1.0e-4;
+    EXPECT_DOUBLE_EQ(1.0e-4, solver->get_rtklib_eph(gal_eph, false).f0);
+
+    // same issue of data, reference times, week, health and accuracy: the
+    // cached conversion is returned
+    gal_eph.af0 = 2.0e-4;
+    EXPECT_DOUBLE_EQ(1.0e-4, solver->get_rtklib_eph(gal_eph, false).f0);
+
+    // a new SISA with the same IOD and toe
+    gal_eph.SISA = 255;
+    EXPECT_DOUBLE_EQ(2.0e-4, solver->get_rtklib_eph(gal_eph, false).f0);
+
+    // a new signal health status with the same IOD and toe
+    gal_eph.af0 = 3.0e-4;
+    gal_eph.E1B_HS = 1;
+    EXPECT_DOUBLE_EQ(3.0e-4, solver->get_rtklib_eph(gal_eph, false).f0);
+
+    // a new data validity status with the same IOD and toe
+    gal_eph.af0 = 4.0e-4;
+    gal_eph.E5a_DVS = true;
+    EXPECT_DOUBLE_EQ(4.0e-4, solver->get_rtklib_eph(gal_eph, false).f0);
+}
+
+
+TEST(RtklibSolverEphCacheTest, GpsHealthAndAccuracyInvalidate)
+{
+    auto solver = make_eph_cache_test_solver();
+    Gps_Ephemeris gps_eph;
+    gps_eph.PRN = 5;
+    gps_eph.IODE_SF2 = 10;
+    gps_eph.IODE_SF3 = 10;
+    gps_eph.IODC = 10;
+    gps_eph.toe = 345600;
+    gps_eph.toc = 345600;
+    gps_eph.WN = 2000;
+    gps_eph.af0 = 1.0e-4;
+    EXPECT_DOUBLE_EQ(1.0e-4, solver->get_rtklib_eph(gps_eph).f0);
+
+    gps_eph.af0 = 2.0e-4;
+    EXPECT_DOUBLE_EQ(1.0e-4, solver->get_rtklib_eph(gps_eph).f0);
+
+    gps_eph.SV_health = 63;
+    EXPECT_DOUBLE_EQ(2.0e-4, solver->get_rtklib_eph(gps_eph).f0);
+
+    gps_eph.af0 = 3.0e-4;
+    gps_eph.SV_accuracy = 15;
+    EXPECT_DOUBLE_EQ(3.0e-4, solver->get_rtklib_eph(gps_eph).f0);
+
+    // other satellites have their own entry
+    Gps_Ephemeris other_eph = gps_eph;
+    other_eph.PRN = 6;
+    other_eph.af0 = 5.0e-4;
+    EXPECT_DOUBLE_EQ(5.0e-4, solver->get_rtklib_eph(other_eph).f0);
+    EXPECT_DOUBLE_EQ(3.0e-4, solver->get_rtklib_eph(gps_eph).f0);
+}
+
+
+TEST(RtklibSolverEphCacheTest, BeidouHealthInvalidates)
+{
+    auto solver = make_eph_cache_test_solver();
+    Beidou_Dnav_Ephemeris bei_eph;
+    bei_eph.PRN = 21;
+    bei_eph.AODE = 3;
+    bei_eph.AODC = 3;
+    bei_eph.toe = 345600;
+    bei_eph.toc = 345600;
+    bei_eph.WN = 800;
+    EXPECT_EQ(0, solver->get_rtklib_eph(bei_eph).svh);
+
+    bei_eph.SV_health = 1;
+    EXPECT_EQ(1, solver->get_rtklib_eph(bei_eph).svh);
+
+    bei_eph.SV_accuracy = 9;
+    EXPECT_EQ(9, solver->get_rtklib_eph(bei_eph).sva);
+}
+
+
+TEST(RtklibSolverEphCacheTest, GlonassHealthInvalidates)
+{
+    auto solver = make_eph_cache_test_solver();
+    Glonass_Gnav_Ephemeris glonass_gnav_eph;
+    glonass_gnav_eph.PRN = 7;
+    glonass_gnav_eph.d_t_b = 900;
+    glonass_gnav_eph.d_WN = 2000;
+    EXPECT_EQ(0, solver->get_rtklib_eph(glonass_gnav_eph).svh);
+
+    glonass_gnav_eph.d_l3rd_n = true;
+    EXPECT_EQ(1, solver->get_rtklib_eph(glonass_gnav_eph).svh);
+
+    glonass_gnav_eph.d_F_T = 4;
+    EXPECT_EQ(4, solver->get_rtklib_eph(glonass_gnav_eph).sva);
+}
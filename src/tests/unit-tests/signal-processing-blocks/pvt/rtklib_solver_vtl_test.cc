@@ -0,0 +1,157 @@
+/*!
+ * \file rtklib_solver_vtl_test.cc
+ * \brief  This file implements unit tests for the carrier Doppler predictions
+ * sent by the PVT block to the tracking channels (Vector Tracking Loop).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_solver.h"
+#include <array>
+#include <cmath>
+
+namespace
+{
+constexpr double L1_WAVELENGTH_M = SPEED_OF_LIGHT_M_S / 1575.42e6;
+
+
+// Navigation data with a single GPS broadcast ephemeris
+struct Vtl_Test_Nav
+{
+    Vtl_Test_Nav()
+    {
+        eph.sat = satno(SYS_GPS, 5);
+        eph.iode = 10;
+        eph.iodc = 10;
+        eph.week = 2000;
+        eph.toes = 345600.0;
+        eph.toe = gpst2time(eph.week, eph.toes);
+        eph.toc = eph.toe;
+        eph.A = 5153.65 * 5153.65;
+        eph.e = 0.0083;
+        eph.i0 = 0.9617;
+        eph.OMG0 = -2.1364;
+        eph.omg = 0.7852;
+        eph.M0 = 1.2340;
+        eph.deln = 4.5e-9;
+        eph.OMGd = -8.1e-9;
+        eph.idot = 2.1e-10;
+        eph.f0 = 1.2e-4;
+        eph.f1 = 3.4e-11;
+        nav.eph = &eph;
+        nav.n = 1;
+        nav.nmax = 1;
+    }
+
+    eph_t eph{};
+    nav_t nav{};
+};
+
+
+sol_t make_solution(const gtime_t& time)
+{
+    sol_t sol{};
+    sol.time = time;
+    // a receiver in the northern hemisphere, moving at 30 m/s
+    sol.rr[0] = 4787678.0;
+    sol.rr[1] = 183337.0;
+    sol.rr[2] = 4197020.0;
+    sol.rr[3] = 20.0;
+    sol.rr[4] = -15.0;
+    sol.rr[5] = 16.0;
+    return sol;
+}
+
+
+// Pseudorange model without the receiver clock: geometric range at the
+// signal transmission time (with the Sagnac correction) minus the satellite
+// clock bias
+double pseudorange_m(const Vtl_Test_Nav& data, const sol_t& sol, double t_s)
+{
+    std::array<double, 3> rr{};
+    for (int i = 0; i < 3; i++)
+        {
+            rr[i] = sol.rr[i] + sol.rr[i + 3] * t_s;
+        }
+    const gtime_t rx_time = timeadd(sol.time, t_s);
+    std::array<double, 6> rs{};
+    std::array<double, 2> dts{};
+    std::array<double, 3> e{};
+    double var = 0.0;
+    int svh = 0;
+    gtime_t tx_time = rx_time;
+    double range_m = 0.0;
+    for (int iter = 0; iter < 5; iter++)
+        {
+            satpos(tx_time, tx_time, data.eph.sat, EPHOPT_BRDC, &data.nav, rs.data(), dts.data(), &var, &svh);
+            range_m = geodist(rs.data(), rr.data(), e.data());
+            tx_time = timeadd(rx_time, -range_m / SPEED_OF_LIGHT_M_S);
+        }
+    return range_m - SPEED_OF_LIGHT_M_S * dts[0];
+}
+}  // namespace
+
+
+TEST(RtklibSolverVtlTest, DopplerMatchesPseudorangeRate)
+{
+    const Vtl_Test_Nav data;
+    for (double t_s = -3600.0; t_s <= 3600.0; t_s += 900.0)
+        {
+            const sol_t sol = make_solution(timeadd(data.eph.toe, t_s));
+            double doppler_hz = 0.0;
+            double doppler_rate_hz_s = 0.0;
+            ASSERT_TRUE(Rtklib_Solver::predict_carrier_doppler(&data.nav, EPHOPT_BRDC, sol, data.eph.sat, L1_WAVELENGTH_M, doppler_hz, doppler_rate_hz_s));
+
+            // -lam * D = d(pseudorange)/dt, by central differences
+            const double h_s = 0.5;
+            const double pseudorange_rate_m_s = (pseudorange_m(data, sol, h_s) - pseudorange_m(data, sol, -h_s)) / (2.0 * h_s);
+            EXPECT_NEAR(doppler_hz, -pseudorange_rate_m_s / L1_WAVELENGTH_M, 0.1) << "at toe + " << t_s << " s";
+
+            // the Doppler rate is the second derivative of the pseudorange
+            const double pseudorange_acc_m_s2 = pseudorange_m(data, sol, 1.0) - 2.0 * pseudorange_m(data, sol, 0.0) + pseudorange_m(data, sol, -1.0);
+            EXPECT_NEAR(doppler_rate_hz_s, -pseudorange_acc_m_s2 / L1_WAVELENGTH_M, 0.05) << "at toe + " << t_s << " s";
+        }
+}
+
+
+TEST(RtklibSolverVtlTest, ReceiverClockDriftShiftsDoppler)
+{
+    const Vtl_Test_Nav data;
+    sol_t sol = make_solution(timeadd(data.eph.toe, -300.0));
+    double doppler_hz = 0.0;
+    double doppler_rate_hz_s = 0.0;
+    ASSERT_TRUE(Rtklib_Solver::predict_carrier_doppler(&data.nav, EPHOPT_BRDC, sol, data.eph.sat, L1_WAVELENGTH_M, doppler_hz, doppler_rate_hz_s));
+
+    // 10 m/s of receiver clock drift
+    sol.dtr[5] = 10.0;
+    double drift_doppler_hz = 0.0;
+    double drift_doppler_rate_hz_s = 0.0;
+    ASSERT_TRUE(Rtklib_Solver::predict_carrier_doppler(&data.nav, EPHOPT_BRDC, sol, data.eph.sat, L1_WAVELENGTH_M, drift_doppler_hz, drift_doppler_rate_hz_s));
+    EXPECT_NEAR(drift_doppler_hz - doppler_hz, -10.0 / L1_WAVELENGTH_M, 1e-6);
+    EXPECT_NEAR(drift_doppler_rate_hz_s, doppler_rate_hz_s, 1e-6);
+}
+
+
+TEST(RtklibSolverVtlTest, NoPredictionWithoutEphemeris)
+{
+    const Vtl_Test_Nav data;
+    const sol_t sol = make_solution(data.eph.toe);
+    double doppler_hz = 0.0;
+    double doppler_rate_hz_s = 0.0;
+    EXPECT_FALSE(Rtklib_Solver::predict_carrier_doppler(&data.nav, EPHOPT_BRDC, sol, satno(SYS_GPS, 6), L1_WAVELENGTH_M, doppler_hz, doppler_rate_hz_s));
+
+    // ephemeris too old
+    const sol_t late_sol = make_solution(timeadd(data.eph.toe, 86400.0));
+    EXPECT_FALSE(Rtklib_Solver::predict_carrier_doppler(&data.nav, EPHOPT_BRDC, late_sol, data.eph.sat, L1_WAVELENGTH_M, doppler_hz, doppler_rate_hz_s));
+}
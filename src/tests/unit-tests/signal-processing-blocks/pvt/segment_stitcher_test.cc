@@ -0,0 +1,197 @@
+/*!
+ * \file segment_stitcher_test.cc
+ * \brief Implements Unit Tests for the Segment_Stitcher class.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include "segment_stitcher.h"
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+struct Test_Satellite
+{
+    std::string id;
+    int first_second;
+    int last_second;
+    double phase_offset;  // cycles added to the phase of this segment
+};
+
+
+std::string header_line(const std::string& content, const std::string& label)
+{
+    std::string line = content;
+    line.resize(60, ' ');
+    line += label;
+    line.resize(80, ' ');
+    return line;
+}
+
+
+double true_phase(const std::string& sat, int second)
+{
+    return (sat == "G01" ? 1000.25 : 2000.75) + 1234.5 * second;
+}
+
+
+// RINEX 3 observation file with GPS C1C L1C D1C S1C observables at 1 Hz
+void write_segment(const std::string& filename, int first_second, int last_second, const std::vector<Test_Satellite>& satellites)
+{
+    std::ofstream out(filename);
+    out << header_line("     3.02           OBSERVATION DATA    G (GPS)", "RINEX VERSION / TYPE") << '\n';
+    out << header_line("G    4 C1C L1C D1C S1C", "SYS / # / OBS TYPES") << '\n';
+    out << header_line("", "END OF HEADER") << '\n';
+    std::array<char, 128> buffer{};
+    for (int s = first_second; s <= last_second; s++)
+        {
+            std::vector<std::string> records;
+            for (const auto& sat : satellites)
+                {
+                    if (s >= sat.first_second && s <= sat.last_second)
+                        {
+                            std::snprintf(buffer.data(), buffer.size(), "%14.3f 7%14.3f 7%14.3f 7%14.3f 7", 2.2e7 + s, true_phase(sat.id, s) + sat.phase_offset, -1234.5, 45.0);
+                            records.push_back(sat.id + buffer.data());
+                        }
+                }
+            std::snprintf(buffer.data(), buffer.size(), "> 2024 03 01 10 %02d %010.7f  0%3d", s / 60, std::fmod(s, 60.0), static_cast<int>(records.size()));
+            out << buffer.data() << '\n';
+            for (const auto& record : records)
+                {
+                    out << record << '\n';
+                }
+        }
+}
+
+
+std::vector<std::string> read_lines(const std::string& filename)
+{
+    std::vector<std::string> lines;
+    std::ifstream in(filename);
+    std::string line;
+    while (std::getline(in, line))
+        {
+            lines.push_back(line);
+        }
+    return lines;
+}
+}  // namespace
+
+
+TEST(SegmentStitcherTest, CarrierPhaseHandover)
+{
+    const std::string first("./segment_stitcher_test_0.24O");
+    const std::string second("./segment_stitcher_test_1.24O");
+    const std::string output("./segment_stitcher_test.24O");
+
+    // G01 restarts with an integer ambiguity, and is continued. G02 restarts
+    // with half a cycle of difference, and is marked with loss of lock.
+    write_segment(first, 0, 59, {{"G01", 0, 59, 0.0}, {"G02", 0, 59, 0.0}});
+    write_segment(second, 40, 100, {{"G01", 40, 100, -37.0}, {"G02", 40, 100, 12.5}, {"G03", 70, 100, 0.0}});
+
+    Segment_Stitcher stitcher;
+    ASSERT_TRUE(stitcher.stitch_rinex_obs({first, second}, output));
+    EXPECT_EQ(stitcher.continued_arcs(), 1U);
+    EXPECT_EQ(stitcher.broken_arcs(), 1U);
+
+    const auto lines = read_lines(output);
+    int epochs = 0;
+    int last_second = -1;
+    bool ordered = true;
+    for (std::size_t i = 0; i < lines.size(); i++)
+        {
+            if (lines[i][0] != '>')
+                {
+                    continue;
+                }
+            const int second = std::stoi(lines[i].substr(16, 2)) * 60 + static_cast<int>(std::stod(lines[i].substr(18, 11)));
+            ordered = ordered && second == last_second + 1;
+            last_second = second;
+            epochs++;
+            for (std::size_t j = i + 1; j < lines.size() && lines[j][0] != '>'; j++)
+                {
+                    const std::string sat = lines[j].substr(0, 3);
+                    const double phase = std::strtod(lines[j].substr(19, 14).c_str(), nullptr);
+                    const char lli = lines[j][33];
+                    if (sat == "G01")
+                        {
+                            EXPECT_NEAR(phase, true_phase(sat, second), 1e-3);
+                            EXPECT_EQ(lli, ' ');
+                        }
+                    if (sat == "G02")
+                        {
+                            EXPECT_EQ(lli, second == 60 ? '1' : ' ');
+                        }
+                    if (sat == "G03")
+                        {
+                            EXPECT_EQ(lli, ' ');
+                        }
+                }
+        }
+    EXPECT_EQ(epochs, 101);
+    EXPECT_TRUE(ordered);
+
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+    std::remove(output.c_str());
+}
+
+
+TEST(SegmentStitcherTest, NmeaAndNavigation)
+{
+    const std::string nmea_first("./segment_stitcher_test_0.nmea");
+    const std::string nmea_second("./segment_stitcher_test_1.nmea");
+    const std::string nmea_output("./segment_stitcher_test.nmea");
+    {
+        std::ofstream out(nmea_first);
+        out << "$GPRMC,235958.00,A,4116.9,N,00201.6,E,0.0,0.0,290224,,*00\r\n$GPGGA,235958.00*00\r\n";
+        out << "$GPRMC,235959.00,A,4116.9,N,00201.6,E,0.0,0.0,290224,,*00\r\n$GPGGA,235959.00*00\r\n";
+    }
+    {
+        std::ofstream out(nmea_second);
+        out << "$GPGSA,A,1*00\r\n";
+        out << "$GPRMC,235959.00,A,4116.9,N,00201.6,E,0.0,0.0,290224,,*00\r\n$GPGGA,235959.00*00\r\n";
+        out << "$GPRMC,000000.00,A,4116.9,N,00201.6,E,0.0,0.0,010324,,*00\r\n$GPGGA,000000.00*00\r\n";
+    }
+    Segment_Stitcher stitcher;
+    ASSERT_TRUE(stitcher.stitch_nmea({nmea_first, nmea_second}, nmea_output));
+    const auto nmea = read_lines(nmea_output);
+    ASSERT_EQ(nmea.size(), 6U);
+    EXPECT_EQ(nmea[4].substr(0, 17), "$GPRMC,000000.00,");
+
+    const std::string nav_first("./segment_stitcher_test_0.24N");
+    const std::string nav_second("./segment_stitcher_test_1.24N");
+    const std::string nav_output("./segment_stitcher_test.24N");
+    const std::string nav_header = header_line("     3.02           N: GNSS NAV DATA    G: GPS", "RINEX VERSION / TYPE") + '\n' + header_line("", "END OF HEADER") + '\n';
+    {
+        std::ofstream out(nav_first);
+        out << nav_header << "G01 2024 03 01 10 00 00\n    record A\n";
+    }
+    {
+        std::ofstream out(nav_second);
+        out << nav_header << "G01 2024 03 01 10 00 00\n    record A\nG02 2024 03 01 10 00 00\n    record B\n";
+    }
+    ASSERT_TRUE(stitcher.stitch_rinex_nav({nav_first, nav_second}, nav_output));
+    EXPECT_EQ(read_lines(nav_output).size(), 6U);
+
+    for (const auto& f : {nmea_first, nmea_second, nmea_output, nav_first, nav_second, nav_output})
+        {
+            std::remove(f.c_str());
+        }
+}
@@ -0,0 +1,145 @@
+/*!
+ * \file mmap_file_source_test.cc
+ * \brief Tests for the memory-mapped file source
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_mmap_file.h"
+#include "mmap_file_source.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#else
+#include <gnuradio/blocks/vector_sink_s.h>
+#endif
+
+
+namespace
+{
+std::vector<int16_t> write_test_samples(const std::string& filename, size_t num_samples, size_t trailing_bytes = 0)
+{
+    std::vector<int16_t> samples(num_samples);
+    for (size_t i = 0; i < num_samples; i++)
+        {
+            samples[i] = static_cast<int16_t>((i * 7919) & 0x7FFF);
+        }
+    std::ofstream file(filename, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(samples.data()), static_cast<std::streamsize>(samples.size() * sizeof(int16_t)));
+    for (size_t i = 0; i < trailing_bytes; i++)
+        {
+            file.put('x');
+        }
+    return samples;
+}
+}  // namespace
+
+
+TEST(MmapFileSourceTest, ReadsAndSeeksMappedFile)
+{
+    const std::string filename("./mmap_file_source_test.dat");
+    const size_t num_samples = 300000;
+    const auto samples = write_test_samples(filename, num_samples, 1);
+
+    Gnss_Sdr_Mmap_File file;
+    EXPECT_FALSE(file.open("./i_dont_exist.dat", sizeof(int16_t)));
+    // A small prefetch window exercises the read-ahead and release of pages
+    ASSERT_TRUE(file.open(filename, sizeof(int16_t), 16384));
+    EXPECT_EQ(file.size_items(), num_samples);  // the trailing byte is ignored
+
+    std::vector<int16_t> buffer(num_samples + 100);
+    size_t total = 0;
+    while (true)
+        {
+            const size_t n = file.read(buffer.data() + total, 1000);
+            if (n == 0)
+                {
+                    break;
+                }
+            total += n;
+        }
+    ASSERT_EQ(total, num_samples);
+    buffer.resize(num_samples);
+    EXPECT_EQ(buffer, samples);
+
+    EXPECT_FALSE(file.seek(num_samples + 1));
+    ASSERT_TRUE(file.seek(123456));
+    EXPECT_EQ(file.position(), 123456U);
+    int16_t sample = 0;
+    EXPECT_EQ(file.read(&sample, 1), 1U);
+    EXPECT_EQ(sample, samples[123456]);
+    ASSERT_TRUE(file.seek(3));
+    EXPECT_EQ(file.read(&sample, 1), 1U);
+    EXPECT_EQ(sample, samples[3]);
+
+    file.close();
+    EXPECT_FALSE(file.is_open());
+    std::remove(filename.c_str());
+}
+
+
+TEST(MmapFileSourceTest, FlowgraphSkipsAndRepeats)
+{
+    const std::string filename("./mmap_file_source_test_flowgraph.dat");
+    const size_t num_samples = 100000;
+    const size_t to_skip = 2500;
+    const auto samples = write_test_samples(filename, num_samples);
+
+    // Without repeat, the block stops the flowgraph at the end of the file
+    {
+        auto top_block = gr::make_top_block("MmapFileSourceTest");
+        auto source = make_mmap_file_source(sizeof(int16_t), filename, false, to_skip, 4096);
+        EXPECT_EQ(source->sample_index(), to_skip);
+        auto sink = gr::blocks::vector_sink_s::make();
+        top_block->connect(source, 0, sink, 0);
+        top_block->run();
+        const auto data = sink->data();
+        ASSERT_EQ(data.size(), num_samples - to_skip);
+        for (size_t i = 0; i < data.size(); i++)
+            {
+                ASSERT_EQ(data[i], samples[i + to_skip]);
+            }
+        EXPECT_EQ(source->sample_index(), num_samples);
+    }
+
+    // With repeat, reading starts again after the skipped items
+    {
+        auto top_block = gr::make_top_block("MmapFileSourceTest");
+        auto source = make_mmap_file_source(sizeof(int16_t), filename, true, to_skip, 4096);
+        const size_t num_output = 3 * num_samples;
+        auto head = gr::blocks::head::make(sizeof(int16_t), num_output);
+        auto sink = gr::blocks::vector_sink_s::make();
+        top_block->connect(source, 0, head, 0);
+        top_block->connect(head, 0, sink, 0);
+        top_block->run();
+        const auto data = sink->data();
+        ASSERT_EQ(data.size(), num_output);
+        const size_t period = num_samples - to_skip;
+        for (size_t i = 0; i < data.size(); i++)
+            {
+                ASSERT_EQ(data[i], samples[to_skip + i % period]);
+            }
+    }
+
+    EXPECT_THROW(make_mmap_file_source(sizeof(int16_t), filename, false, num_samples), std::runtime_error);
+    EXPECT_THROW(make_mmap_file_source(sizeof(int16_t), "./i_dont_exist.dat"), std::runtime_error);
+    std::remove(filename.c_str());
+}
@@ -18,6 +18,7 @@
 
 #include "unpack_2bit_samples.h"
 #include <gnuradio/blocks/stream_to_vector.h>
+#include <gnuradio/io_signature.h>
 #include <gnuradio/top_block.h>
 #include <gtest/gtest.h>
 #include <cstddef>
@@ -283,3 +284,55 @@ TEST(Unpack2bitSamplesTest, CheckBigEndianShortLittleEndianByte)
             EXPECT_EQ(raw_data[i], static_cast<int8_t>(unpacked_data[i]));
         }
 }
+
+
+TEST(Unpack2bitSamplesTest, CheckComplexOutputReverseInterleaving)
+{
+    bool big_endian_bytes = false;
+    size_t item_size = 1;
+    bool big_endian_items = false;
+    bool reverse_interleaving = true;
+    bool complex_output = true;
+
+    std::vector<int8_t> raw_data = {-1, 3, 1, -1, -3, 1, 3, 1, 1, -3, -1, 3, 3, -3, -1, 1};
+    std::vector<uint8_t> packed_data = packData(raw_data, big_endian_bytes);
+    std::vector<uint8_t> unpacked_data;
+
+    gr::top_block_sptr top_block = gr::make_top_block("Unpack2bitSamplesTest");
+
+    gr::blocks::vector_source_b::sptr source =
+        gr::blocks::vector_source_b::make(packed_data);
+
+    auto unpacker =
+        make_unpack_2bit_samples(big_endian_bytes,
+            item_size,
+            big_endian_items,
+            reverse_interleaving,
+            complex_output);
+
+    // each output item holds an I/Q pair
+    EXPECT_EQ(unpacker->output_signature()->sizeof_stream_item(0), 2 * sizeof(int8_t));
+
+    gr::blocks::stream_to_vector::sptr stov =
+        gr::blocks::stream_to_vector::make(2, raw_data.size() / 2);
+
+    gr::blocks::vector_sink_b::sptr sink =
+        gr::blocks::vector_sink_b::make(raw_data.size());
+
+    top_block->connect(source, 0, unpacker, 0);
+    top_block->connect(unpacker, 0, stov, 0);
+    top_block->connect(stov, 0, sink, 0);
+
+    top_block->run();
+    top_block->stop();
+
+    unpacked_data = sink->data();
+
+    EXPECT_EQ(raw_data.size(), unpacked_data.size());
+
+    // the two samples of each pair come out swapped
+    for (size_t i = 0; i < raw_data.size(); ++i)
+        {
+            EXPECT_EQ(raw_data[i ^ 1], static_cast<int8_t>(unpacked_data[i]));
+        }
+}
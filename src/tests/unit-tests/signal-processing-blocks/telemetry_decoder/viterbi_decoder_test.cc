@@ -0,0 +1,107 @@
+/*!
+ * \file viterbi_decoder_test.cc
+ * \brief  This file implements unit tests for the Viterbi_Decoder class.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "viterbi_decoder.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Encodes data_bits followed by KK - 1 zero tail bits, with the same state
+// convention as Viterbi_Decoder. Symbols are +1 for a 1 and -1 for a 0.
+std::vector<float> encode(const std::vector<int32_t>& data_bits, int32_t KK, const std::array<int32_t, 2>& g)
+{
+    std::vector<float> symbols;
+    int32_t state = 0;
+    for (size_t i = 0; i < data_bits.size() + KK - 1; i++)
+        {
+            const int32_t bit = i < data_bits.size() ? data_bits[i] : 0;
+            state = (bit << (KK - 1)) | state;
+            for (const int32_t poly : g)
+                {
+                    int32_t taps = state & poly;
+                    int32_t parity = 0;
+                    while (taps)
+                        {
+                            parity ^= taps & 1;
+                            taps >>= 1;
+                        }
+                    symbols.push_back(parity ? 1.0F : -1.0F);
+                }
+            state >>= 1;
+        }
+    return symbols;
+}
+
+
+int32_t count_errors(int32_t KK, const std::array<int32_t, 2>& g, int32_t LL, float sigma, int32_t frames)
+{
+    std::mt19937 gen(1234);
+    std::bernoulli_distribution bit_dist(0.5);
+    std::normal_distribution<float> noise(0.0, sigma);
+    Viterbi_Decoder decoder(KK, 2, LL, g);
+    std::vector<int32_t> data_bits(LL);
+    std::vector<int32_t> decoded_bits(LL + KK - 1);
+    int32_t errors = 0;
+    for (int32_t f = 0; f < frames; f++)
+        {
+            for (auto& bit : data_bits)
+                {
+                    bit = bit_dist(gen) ? 1 : 0;
+                }
+            std::vector<float> symbols = encode(data_bits, KK, g);
+            for (auto& symbol : symbols)
+                {
+                    symbol = 3.0F * (symbol + (sigma > 0.0 ? noise(gen) : 0.0F));  // arbitrary scale
+                }
+            decoder.decode(decoded_bits, symbols);
+            for (int32_t i = 0; i < LL; i++)
+                {
+                    errors += decoded_bits[i] != data_bits[i];
+                }
+        }
+    return errors;
+}
+}  // namespace
+
+
+TEST(ViterbiDecoderTest, GalileoCodeNoiseless)
+{
+    const std::array<int32_t, 2> g{{121, 91}};
+    for (const int32_t LL : {114, 238, 486})  // INAV, FNAV and CNAV pages
+        {
+            EXPECT_EQ(0, count_errors(7, g, LL, 0.0, 20));
+        }
+}
+
+
+TEST(ViterbiDecoderTest, GalileoCodeNoisy)
+{
+    // Eb/N0 = 6 dB, where the bit error rate of this code is far below 1e-4
+    const std::array<int32_t, 2> g{{121, 91}};
+    EXPECT_EQ(0, count_errors(7, g, 114, 0.5, 200));
+}
+
+
+TEST(ViterbiDecoderTest, GenericCode)
+{
+    // K=5 code, decoded with the floating-point implementation
+    const std::array<int32_t, 2> g{{19, 29}};
+    EXPECT_EQ(0, count_errors(5, g, 100, 0.0, 20));
+    EXPECT_EQ(0, count_errors(5, g, 100, 0.4, 50));
+}
@@ -0,0 +1,212 @@
+/*!
+ * \file cpu_multicorrelator_batch_test.cc
+ * \brief  This file implements unit tests for the shared multi-channel
+ * correlator engine.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_batch.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int BATCH_TEST_SIGNAL_LENGTH = 4000;
+constexpr int BATCH_TEST_CODE_LENGTH = 1023;
+constexpr int BATCH_TEST_N_CORRELATORS = 3;
+constexpr int BATCH_TEST_INTEGRATIONS = 50;
+
+
+struct Batch_Test_Channel
+{
+    std::vector<float> local_code;
+    std::vector<float> shifts_chips{-0.5, 0.0, 0.5};
+    std::vector<std::complex<float>> corr_out = std::vector<std::complex<float>>(BATCH_TEST_N_CORRELATORS);
+    std::vector<std::complex<float>> reference_corr_out = std::vector<std::complex<float>>(BATCH_TEST_N_CORRELATORS);
+    std::vector<std::vector<std::complex<float>>> results;
+    std::vector<std::vector<std::complex<float>>> reference_results;
+    Cpu_Multicorrelator_Real_Codes correlator;
+    Cpu_Multicorrelator_Real_Codes reference_correlator;
+    float carrier_phase_rad{0.0};
+    float carrier_phase_step_rad{0.0};
+    float code_phase_chips{0.0};
+};
+
+
+std::vector<std::complex<float>> make_batch_test_input(size_t length)
+{
+    std::default_random_engine e2(1234);
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::vector<std::complex<float>> sig_in(length);
+    std::generate(sig_in.begin(), sig_in.end(), [&dist, &e2]() { return std::complex<float>(dist(e2), dist(e2)); });
+    return sig_in;
+}
+
+
+// Correlates all the integration periods of a channel with both the batch
+// engine and the per-channel correlator, on the same inputs
+void run_batch_test_channel(Batch_Test_Channel* channel, const std::vector<std::complex<float>>* sig_in, int offset)
+{
+    const float code_phase_step_chips = static_cast<float>(BATCH_TEST_CODE_LENGTH) / static_cast<float>(BATCH_TEST_SIGNAL_LENGTH);
+    for (int i = 0; i < BATCH_TEST_INTEGRATIONS; i++)
+        {
+            const std::complex<float>* input = sig_in->data() + offset + (i % 4) * BATCH_TEST_SIGNAL_LENGTH;
+            channel->correlator.set_input_output_vectors(channel->corr_out.data(), input);
+            channel->correlator.Carrier_wipeoff_multicorrelator_resampler(channel->carrier_phase_rad, channel->carrier_phase_step_rad, 0.0, channel->code_phase_chips, code_phase_step_chips, 0.0, BATCH_TEST_SIGNAL_LENGTH);
+            channel->results.push_back(channel->corr_out);
+
+            channel->reference_correlator.set_input_output_vectors(channel->reference_corr_out.data(), input);
+            channel->reference_correlator.Carrier_wipeoff_multicorrelator_resampler(channel->carrier_phase_rad, channel->carrier_phase_step_rad, 0.0, channel->code_phase_chips, code_phase_step_chips, 0.0, BATCH_TEST_SIGNAL_LENGTH);
+            channel->reference_results.push_back(channel->reference_corr_out);
+
+            channel->carrier_phase_rad = std::fmod(channel->carrier_phase_rad + channel->carrier_phase_step_rad * BATCH_TEST_SIGNAL_LENGTH, 6.2831853F);
+        }
+}
+
+
+void expect_near_results(const std::vector<std::complex<float>>& result, const std::vector<std::complex<float>>& reference)
+{
+    ASSERT_EQ(result.size(), reference.size());
+    for (size_t n = 0; n < result.size(); n++)
+        {
+            const float tolerance = 1e-4F * std::max(1.0F, std::abs(reference[n]));
+            EXPECT_NEAR(result[n].real(), reference[n].real(), tolerance);
+            EXPECT_NEAR(result[n].imag(), reference[n].imag(), tolerance);
+        }
+}
+}  // namespace
+
+
+TEST(CpuMulticorrelatorBatchTest, ConcurrentChannelsMatchRealCodesCorrelator)
+{
+    const int n_channels = 8;
+    const auto sig_in = make_batch_test_input(5 * BATCH_TEST_SIGNAL_LENGTH);
+    std::default_random_engine e2(4321);
+    std::uniform_int_distribution<int> bit(0, 1);
+    std::uniform_real_distribution<float> uniform(0.0, 1.0);
+
+    std::vector<std::unique_ptr<Batch_Test_Channel>> channels;
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            auto channel = std::make_unique<Batch_Test_Channel>();
+            channel->local_code.resize(BATCH_TEST_CODE_LENGTH);
+            std::generate(channel->local_code.begin(), channel->local_code.end(), [&bit, &e2]() { return bit(e2) ? 1.0F : -1.0F; });
+            channel->carrier_phase_rad = 6.2831853F * uniform(e2);
+            channel->carrier_phase_step_rad = 0.05F * (uniform(e2) - 0.5F);
+            channel->code_phase_chips = 100.0F * uniform(e2);
+            channel->correlator.init(2 * BATCH_TEST_SIGNAL_LENGTH, BATCH_TEST_N_CORRELATORS);
+            channel->correlator.set_high_dynamics_resampler(false);
+            channel->correlator.set_batch_engine(true);
+            channel->correlator.set_local_code_and_taps(BATCH_TEST_CODE_LENGTH, channel->local_code.data(), channel->shifts_chips.data());
+            channel->reference_correlator.init(2 * BATCH_TEST_SIGNAL_LENGTH, BATCH_TEST_N_CORRELATORS);
+            channel->reference_correlator.set_high_dynamics_resampler(false);
+            channel->reference_correlator.set_local_code_and_taps(BATCH_TEST_CODE_LENGTH, channel->local_code.data(), channel->shifts_chips.data());
+            channels.push_back(std::move(channel));
+        }
+
+    auto& engine = Cpu_Multicorrelator_Batch::get_instance();
+    // a generous gather window, so the batches do not depend on the
+    // scheduling of the test machine
+    engine.set_gather_timeout(std::chrono::microseconds(2000));
+    const uint64_t batches_before = engine.executed_batches();
+    const uint64_t jobs_before = engine.executed_jobs();
+
+    std::vector<std::thread> threads;
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            // overlapping input buffers, as the channels read the same stream
+            threads.emplace_back(run_batch_test_channel, channels[ch].get(), &sig_in, 37 * ch);
+        }
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    engine.set_gather_timeout(std::chrono::microseconds(50));
+
+    for (const auto& channel : channels)
+        {
+            ASSERT_EQ(channel->results.size(), static_cast<size_t>(BATCH_TEST_INTEGRATIONS));
+            for (int i = 0; i < BATCH_TEST_INTEGRATIONS; i++)
+                {
+                    expect_near_results(channel->results[i], channel->reference_results[i]);
+                }
+        }
+
+    // the jobs of the concurrent channels were correlated together
+    const uint64_t batches = engine.executed_batches() - batches_before;
+    const uint64_t jobs = engine.executed_jobs() - jobs_before;
+    EXPECT_EQ(jobs, static_cast<uint64_t>(n_channels * BATCH_TEST_INTEGRATIONS));
+    EXPECT_LT(batches, jobs / 2);
+}
+
+
+TEST(CpuMulticorrelatorBatchTest, ExecuteMatchesRotatorDotProduct)
+{
+    const auto sig_in = make_batch_test_input(4 * BATCH_TEST_SIGNAL_LENGTH);
+    std::default_random_engine e2(42);
+    std::uniform_real_distribution<float> uniform(-1.0, 1.0);
+
+    // three jobs on overlapping buffers and one on a disjoint buffer, with a
+    // length that is not a multiple of the tile length
+    const std::vector<int> offsets = {0, 11, 500, 3 * BATCH_TEST_SIGNAL_LENGTH};
+    const int length = BATCH_TEST_SIGNAL_LENGTH - 3;
+    const auto n_jobs = offsets.size();
+    std::vector<std::vector<float>> codes(n_jobs * BATCH_TEST_N_CORRELATORS, std::vector<float>(length));
+    std::vector<const float*> codes_ptr(n_jobs * BATCH_TEST_N_CORRELATORS);
+    std::vector<const float*> codes_tile(n_jobs * BATCH_TEST_N_CORRELATORS);
+    std::vector<std::complex<float>> corr_tile(n_jobs * BATCH_TEST_N_CORRELATORS);
+    std::vector<std::vector<std::complex<float>>> corr_out(n_jobs, std::vector<std::complex<float>>(BATCH_TEST_N_CORRELATORS));
+    std::vector<Multicorrelator_Batch_Job> jobs(n_jobs);
+    std::vector<Multicorrelator_Batch_Job*> batch;
+    for (size_t j = 0; j < n_jobs; j++)
+        {
+            for (int n = 0; n < BATCH_TEST_N_CORRELATORS; n++)
+                {
+                    auto& code = codes[j * BATCH_TEST_N_CORRELATORS + n];
+                    std::generate(code.begin(), code.end(), [&uniform, &e2]() { return uniform(e2); });
+                    codes_ptr[j * BATCH_TEST_N_CORRELATORS + n] = code.data();
+                }
+            jobs[j].sig_in = sig_in.data() + offsets[j];
+            jobs[j].corr_out = corr_out[j].data();
+            jobs[j].local_codes = &codes_ptr[j * BATCH_TEST_N_CORRELATORS];
+            jobs[j].local_codes_tile = &codes_tile[j * BATCH_TEST_N_CORRELATORS];
+            jobs[j].corr_out_tile = &corr_tile[j * BATCH_TEST_N_CORRELATORS];
+            jobs[j].phase_step = std::exp(std::complex<float>(0.0, -0.001F * static_cast<float>(j + 1)));
+            jobs[j].phase = std::exp(std::complex<float>(0.0, 0.3F * static_cast<float>(j)));
+            jobs[j].n_correlators = BATCH_TEST_N_CORRELATORS;
+            jobs[j].signal_length_samples = length;
+            batch.push_back(&jobs[j]);
+        }
+    // submission order must not matter
+    std::swap(batch[0], batch[2]);
+
+    Cpu_Multicorrelator_Batch::execute(batch, 256);
+
+    for (size_t j = 0; j < n_jobs; j++)
+        {
+            std::vector<std::complex<float>> reference(BATCH_TEST_N_CORRELATORS);
+            std::complex<float> phase = std::exp(std::complex<float>(0.0, 0.3F * static_cast<float>(j)));
+            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(reference.data(), sig_in.data() + offsets[j], jobs[j].phase_step, &phase, &codes_ptr[j * BATCH_TEST_N_CORRELATORS], BATCH_TEST_N_CORRELATORS, length);
+            expect_near_results(corr_out[j], reference);
+            // the final phasor is returned to the caller
+            EXPECT_NEAR(std::arg(jobs[j].phase / phase), 0.0, 1e-3);
+        }
+}
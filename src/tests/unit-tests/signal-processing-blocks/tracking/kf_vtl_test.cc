@@ -0,0 +1,129 @@
+/*!
+ * \file kf_vtl_test.cc
+ * \brief  This file implements unit tests for the Vector Tracking Loop (VTL)
+ * update of the Kalman filter based tracking loop.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "kf_vtl.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+
+namespace
+{
+constexpr uint64_t VTL_SAMPLE_COUNTER = 40000000ULL;
+
+
+class KfVtlTest : public ::testing::Test
+{
+protected:
+    KfVtlTest()
+    {
+        conf.fs_in = 4e6;
+        conf.vtl_doppler_sd_hz = 2.0;
+        conf.vtl_doppler_rate_sd_hz_s = 1.0;
+        conf.vtl_max_latency_s = 2.0;
+        x = {0.1, 0.2, 100.0, 0.0};
+        P = arma::diagmat(arma::vec({1.0, 1.0, 100.0, 10.0}));
+        cmd.enable_carrier_nco_cmd = true;
+        cmd.carrier_freq_hz = 120.0;
+        cmd.carrier_freq_rate_hz_s = 2.0;
+        cmd.sample_counter = VTL_SAMPLE_COUNTER;
+    }
+
+    double code_freq_from_doppler(double doppler_hz) const
+    {
+        return GPS_L1_CA_CODE_RATE_CPS + doppler_hz * GPS_L1_CA_CODE_RATE_CPS / GPS_L1_FREQ_HZ;
+    }
+
+    Kf_Conf conf;
+    TrackingCmd cmd;
+    arma::vec x;
+    arma::mat P;
+    double code_freq_chips_s = 0.0;
+};
+}  // namespace
+
+
+TEST_F(KfVtlTest, FusesPredictedDoppler)
+{
+    ASSERT_TRUE(kf_vtl_update(cmd, VTL_SAMPLE_COUNTER, conf, GPS_L1_CA_CODE_RATE_CPS, GPS_L1_FREQ_HZ, x, P, code_freq_chips_s));
+
+    // with uncorrelated states, each one is a scalar Kalman update
+    EXPECT_NEAR(x(2), 100.0 + 100.0 / (100.0 + 4.0) * 20.0, 1e-9);
+    EXPECT_NEAR(x(3), 10.0 / (10.0 + 1.0) * 2.0, 1e-9);
+    EXPECT_NEAR(P(2, 2), 100.0 * 4.0 / (100.0 + 4.0), 1e-9);
+    EXPECT_NEAR(P(3, 3), 10.0 * 1.0 / (10.0 + 1.0), 1e-9);
+
+    // code and carrier phases are not observed
+    EXPECT_DOUBLE_EQ(x(0), 0.1);
+    EXPECT_DOUBLE_EQ(x(1), 0.2);
+    EXPECT_DOUBLE_EQ(P(0, 0), 1.0);
+
+    // without code NCO command, the code frequency follows the carrier Doppler
+    EXPECT_NEAR(code_freq_chips_s, code_freq_from_doppler(x(2)), 1e-9);
+}
+
+
+TEST_F(KfVtlTest, CompensatesLatency)
+{
+    // the command refers to 0.5 s ago, when the Doppler was 120 Hz and
+    // growing 10 Hz/s
+    cmd.carrier_freq_rate_hz_s = 10.0;
+    cmd.sample_counter = VTL_SAMPLE_COUNTER - static_cast<uint64_t>(0.5 * conf.fs_in);
+    ASSERT_TRUE(kf_vtl_update(cmd, VTL_SAMPLE_COUNTER, conf, GPS_L1_CA_CODE_RATE_CPS, GPS_L1_FREQ_HZ, x, P, code_freq_chips_s));
+
+    // measurement of 125 Hz, with the propagation variance added
+    const double sigma2_doppler = 4.0 + 0.5 * 0.5;
+    EXPECT_NEAR(x(2), 100.0 + 100.0 / (100.0 + sigma2_doppler) * 25.0, 1e-9);
+    EXPECT_NEAR(P(2, 2), 100.0 * sigma2_doppler / (100.0 + sigma2_doppler), 1e-9);
+}
+
+
+TEST_F(KfVtlTest, DiscardsStaleCommands)
+{
+    const arma::vec x_before = x;
+    const arma::mat P_before = P;
+    code_freq_chips_s = 1.0;
+
+    cmd.sample_counter = VTL_SAMPLE_COUNTER - static_cast<uint64_t>(3.0 * conf.fs_in);
+    EXPECT_FALSE(kf_vtl_update(cmd, VTL_SAMPLE_COUNTER, conf, GPS_L1_CA_CODE_RATE_CPS, GPS_L1_FREQ_HZ, x, P, code_freq_chips_s));
+
+    // commands without any NCO enabled are ignored too
+    cmd.sample_counter = VTL_SAMPLE_COUNTER;
+    cmd.enable_carrier_nco_cmd = false;
+    EXPECT_FALSE(kf_vtl_update(cmd, VTL_SAMPLE_COUNTER, conf, GPS_L1_CA_CODE_RATE_CPS, GPS_L1_FREQ_HZ, x, P, code_freq_chips_s));
+
+    EXPECT_TRUE(arma::approx_equal(x, x_before, "absdiff", 0.0));
+    EXPECT_TRUE(arma::approx_equal(P, P_before, "absdiff", 0.0));
+    EXPECT_EQ(code_freq_chips_s, 1.0);
+}
+
+
+TEST_F(KfVtlTest, SteersCodeNco)
+{
+    cmd.enable_code_nco_cmd = true;
+    cmd.code_freq_chips = GPS_L1_CA_CODE_RATE_CPS + 0.05;
+    cmd.carrier_freq_rate_hz_s = 10.0;
+    cmd.sample_counter = VTL_SAMPLE_COUNTER - static_cast<uint64_t>(0.5 * conf.fs_in);
+    ASSERT_TRUE(kf_vtl_update(cmd, VTL_SAMPLE_COUNTER, conf, GPS_L1_CA_CODE_RATE_CPS, GPS_L1_FREQ_HZ, x, P, code_freq_chips_s));
+    EXPECT_NEAR(code_freq_chips_s, GPS_L1_CA_CODE_RATE_CPS + 0.05 + 10.0 * 0.5 * GPS_L1_CA_CODE_RATE_CPS / GPS_L1_FREQ_HZ, 1e-9);
+
+    // the code NCO is steered even if the carrier NCO is not
+    const arma::vec x_before = x;
+    cmd.enable_carrier_nco_cmd = false;
+    cmd.sample_counter = VTL_SAMPLE_COUNTER;
+    ASSERT_TRUE(kf_vtl_update(cmd, VTL_SAMPLE_COUNTER, conf, GPS_L1_CA_CODE_RATE_CPS, GPS_L1_FREQ_HZ, x, P, code_freq_chips_s));
+    EXPECT_NEAR(code_freq_chips_s, GPS_L1_CA_CODE_RATE_CPS + 0.05, 1e-9);
+    EXPECT_TRUE(arma::approx_equal(x, x_before, "absdiff", 0.0));
+}
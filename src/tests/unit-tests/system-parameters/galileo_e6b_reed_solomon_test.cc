@@ -18,6 +18,9 @@
 #include "gnss_sdr_make_unique.h"
 #include "reed_solomon.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
 
 
 TEST(ReedSolomonE6BTest, EncodeWithGenMatrix)
@@ -760,3 +763,85 @@ TEST(ReedSolomonE6BTest, DecodeErasure)
     std::vector<uint8_t> decoded(encoded_input.begin(), encoded_input.begin() + 32);
     EXPECT_TRUE(expected_output == decoded);
 }
+
+
+TEST(ReedSolomonE6BTest, DecodeWithGenMatrix)
+{
+    // HAS-like block: a message of 7 rows (the rest of the 32 information
+    // symbols are zero) of 53 octets, received in 7 pages
+    const size_t message_size = 7;
+    const size_t columns = 53;
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> octet(0, 255);
+    auto rs = std::make_unique<ReedSolomon>();
+
+    std::vector<int> candidates;
+    for (int i = 0; i < 255; i++)
+        {
+            if (i < static_cast<int>(message_size) || i >= 32)
+                {
+                    candidates.push_back(i);
+                }
+        }
+
+    for (int trial = 0; trial < 20; trial++)
+        {
+            std::vector<std::vector<uint8_t>> message(32, std::vector<uint8_t>(columns, 0));
+            std::vector<std::vector<uint8_t>> codewords(255, std::vector<uint8_t>(columns));
+            for (size_t col = 0; col < columns; col++)
+                {
+                    std::vector<uint8_t> input(32, 0);
+                    for (size_t row = 0; row < message_size; row++)
+                        {
+                            input[row] = static_cast<uint8_t>(octet(gen));
+                            message[row][col] = input[row];
+                        }
+                    const std::vector<uint8_t> encoded = rs->encode_with_generator_matrix(input);
+                    for (size_t row = 0; row < 255; row++)
+                        {
+                            codewords[row][col] = encoded[row];
+                        }
+                }
+
+            // the same positions are used twice, the second time from the cache
+            if (trial % 2 == 0)
+                {
+                    std::shuffle(candidates.begin(), candidates.end(), gen);
+                }
+            std::vector<int> received(candidates.begin(), candidates.begin() + message_size);
+            std::sort(received.begin(), received.end());
+
+            std::vector<std::vector<uint8_t>> decoded(32, std::vector<uint8_t>(columns, 0));
+            EXPECT_EQ(rs->decode_with_generator_matrix(received, codewords, decoded), 0);
+            EXPECT_TRUE(decoded == message);
+
+            // same result as the erasure decoding of the columns
+            std::vector<int> erasure_positions;
+            for (int i = 0; i < 255; i++)
+                {
+                    if ((i < static_cast<int>(message_size) || i >= 32) && std::find(received.begin(), received.end(), i) == received.end())
+                        {
+                            erasure_positions.push_back(i);
+                        }
+                }
+            for (size_t col = 0; col < 3; col++)
+                {
+                    std::vector<uint8_t> column(255, 0);
+                    for (const auto pos : received)
+                        {
+                            column[pos] = codewords[pos][col];
+                        }
+                    EXPECT_GE(rs->decode(column, erasure_positions), 0);
+                    for (size_t row = 0; row < 32; row++)
+                        {
+                            EXPECT_EQ(column[row], decoded[row][col]);
+                        }
+                }
+        }
+
+    // A page with a zero-padded information symbol does not help
+    std::vector<std::vector<uint8_t>> codewords(255, std::vector<uint8_t>(columns, 0));
+    std::vector<std::vector<uint8_t>> decoded(32, std::vector<uint8_t>(columns, 0));
+    const std::vector<int> received = {0, 1, 2, 3, 4, 5, 20};
+    EXPECT_EQ(rs->decode_with_generator_matrix(received, codewords, decoded), -1);
+}
@@ -0,0 +1,337 @@
+/*!
+ * \file galileo_nav_message_packed_test.cc
+ * \brief  This file implements unit tests checking that the Galileo I/NAV and
+ * F/NAV messages decoded from packed bits give the same ephemeris and almanac
+ * as the string entry points and the ICD field layout.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Galileo_FNAV.h"
+#include "Galileo_INAV.h"
+#include "galileo_fnav_message.h"
+#include "galileo_inav_message.h"
+#include "gnss_packed_bits.h"
+#include <boost/crc.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::string make_random_word(uint32_t type, size_t num_bits, std::mt19937& gen)
+{
+    std::string word;
+    for (size_t i = 0; i < num_bits; i++)
+        {
+            word.push_back((gen() & 1U) ? '1' : '0');
+        }
+    for (int32_t i = 0; i < 6; i++)
+        {
+            word[i] = ((type >> (5 - i)) & 1U) ? '1' : '0';
+        }
+    return word;
+}
+
+
+void write_field(std::string& word, int32_t first, int32_t length, uint64_t value)
+{
+    for (int32_t j = 0; j < length; j++)
+        {
+            word[first - 1 + j] = ((value >> (length - 1 - j)) & 1U) ? '1' : '0';
+        }
+}
+
+
+// Reference reads, bit by bit from the string as the former std::bitset
+// parsers did. first is the ICD position (starting at 1) of the MSB.
+uint64_t ref_unsigned(const std::string& word, int32_t first, int32_t length)
+{
+    uint64_t value = 0ULL;
+    for (int32_t j = 0; j < length; j++)
+        {
+            value = (value << 1U) | static_cast<uint64_t>(word[first - 1 + j] == '1');
+        }
+    return value;
+}
+
+
+int64_t ref_signed(const std::string& word, int32_t first, int32_t length)
+{
+    int64_t value = (word[first - 1] == '1') ? -1LL : 0LL;
+    for (int32_t j = 0; j < length; j++)
+        {
+            value = (value << 1) | static_cast<int64_t>(word[first - 1 + j] == '1');
+        }
+    return value;
+}
+
+
+// Hard decisions of the Viterbi decoder for the bits of a word
+template <size_t N>
+Gnss_Packed_Bits<N> pack_decisions(const std::string& word)
+{
+    std::vector<int32_t> decisions;
+    for (const char c : word)
+        {
+            decisions.push_back(c == '1' ? 1 : -1);
+        }
+    Gnss_Packed_Bits<N> bits;
+    bits.assign(decisions.data(), N);
+    return bits;
+}
+
+
+// F/NAV page: 214 data bits followed by their CRC-24Q
+std::string make_fnav_page(const std::string& word)
+{
+    constexpr int32_t pad_bits = GALILEO_FNAV_DATA_FRAME_BYTES * 8 - GALILEO_FNAV_DATA_FRAME_BITS;
+    const std::string padded = std::string(pad_bits, '0') + word;
+    std::array<uint8_t, GALILEO_FNAV_DATA_FRAME_BYTES> bytes{};
+    for (int32_t i = 0; i < GALILEO_FNAV_DATA_FRAME_BYTES; i++)
+        {
+            bytes[i] = static_cast<uint8_t>(ref_unsigned(padded, 8 * i + 1, 8));
+        }
+    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> crc;
+    crc.process_bytes(bytes.data(), bytes.size());
+    std::string page = word;
+    page.append(24, '0');
+    write_field(page, GALILEO_FNAV_DATA_FRAME_BITS + 1, 24, crc.checksum());
+    return page;
+}
+
+
+void expect_same_ephemeris(const Galileo_Ephemeris& a, const Galileo_Ephemeris& b)
+{
+    EXPECT_EQ(a.IOD_ephemeris, b.IOD_ephemeris);
+    EXPECT_EQ(a.IOD_nav, b.IOD_nav);
+    EXPECT_EQ(a.PRN, b.PRN);
+    EXPECT_EQ(a.M_0, b.M_0);
+    EXPECT_EQ(a.delta_n, b.delta_n);
+    EXPECT_EQ(a.ecc, b.ecc);
+    EXPECT_EQ(a.sqrtA, b.sqrtA);
+    EXPECT_EQ(a.OMEGA_0, b.OMEGA_0);
+    EXPECT_EQ(a.i_0, b.i_0);
+    EXPECT_EQ(a.omega, b.omega);
+    EXPECT_EQ(a.OMEGAdot, b.OMEGAdot);
+    EXPECT_EQ(a.idot, b.idot);
+    EXPECT_EQ(a.Cuc, b.Cuc);
+    EXPECT_EQ(a.Cus, b.Cus);
+    EXPECT_EQ(a.Crc, b.Crc);
+    EXPECT_EQ(a.Crs, b.Crs);
+    EXPECT_EQ(a.Cic, b.Cic);
+    EXPECT_EQ(a.Cis, b.Cis);
+    EXPECT_EQ(a.toe, b.toe);
+    EXPECT_EQ(a.toc, b.toc);
+    EXPECT_EQ(a.af0, b.af0);
+    EXPECT_EQ(a.af1, b.af1);
+    EXPECT_EQ(a.af2, b.af2);
+    EXPECT_EQ(a.WN, b.WN);
+    EXPECT_EQ(a.tow, b.tow);
+    EXPECT_EQ(a.SISA, b.SISA);
+    EXPECT_EQ(a.E5a_HS, b.E5a_HS);
+    EXPECT_EQ(a.E5b_HS, b.E5b_HS);
+    EXPECT_EQ(a.E1B_HS, b.E1B_HS);
+    EXPECT_EQ(a.E5a_DVS, b.E5a_DVS);
+    EXPECT_EQ(a.E5b_DVS, b.E5b_DVS);
+    EXPECT_EQ(a.E1B_DVS, b.E1B_DVS);
+    EXPECT_EQ(a.BGD_E1E5a, b.BGD_E1E5a);
+    EXPECT_EQ(a.BGD_E1E5b, b.BGD_E1E5b);
+}
+
+
+void expect_same_almanac(const Galileo_Almanac& a, const Galileo_Almanac& b)
+{
+    EXPECT_EQ(a.PRN, b.PRN);
+    EXPECT_EQ(a.toa, b.toa);
+    EXPECT_EQ(a.WNa, b.WNa);
+    EXPECT_EQ(a.IODa, b.IODa);
+    EXPECT_EQ(a.delta_i, b.delta_i);
+    EXPECT_EQ(a.M_0, b.M_0);
+    EXPECT_EQ(a.ecc, b.ecc);
+    EXPECT_EQ(a.sqrtA, b.sqrtA);
+    EXPECT_EQ(a.OMEGA_0, b.OMEGA_0);
+    EXPECT_EQ(a.omega, b.omega);
+    EXPECT_EQ(a.OMEGAdot, b.OMEGAdot);
+    EXPECT_EQ(a.af0, b.af0);
+    EXPECT_EQ(a.af1, b.af1);
+    EXPECT_EQ(a.E5a_HS, b.E5a_HS);
+    EXPECT_EQ(a.E5b_HS, b.E5b_HS);
+    EXPECT_EQ(a.E1B_HS, b.E1B_HS);
+}
+}  // namespace
+
+
+TEST(GalileoNavMessagePackedTest, InavEphemerisMatchesStringPath)
+{
+    std::mt19937 gen(2024);
+    for (int trial = 0; trial < 50; trial++)
+        {
+            Galileo_Inav_Message string_decoder;
+            Galileo_Inav_Message packed_decoder;
+            const uint32_t iod_nav = gen() & 0x3FFU;
+            std::array<std::string, 6> words;
+            for (uint32_t type = 1; type <= 5; type++)
+                {
+                    words[type] = make_random_word(type, GALILEO_DATA_JK_BITS, gen);
+                    if (type <= 4)
+                        {
+                            write_field(words[type], 7, 10, iod_nav);
+                        }
+                    string_decoder.page_jk_decoder(words[type].c_str());
+                    packed_decoder.page_jk_decoder(pack_decisions<GALILEO_DATA_JK_BITS>(words[type]));
+                }
+            ASSERT_TRUE(string_decoder.have_new_ephemeris());
+            ASSERT_TRUE(packed_decoder.have_new_ephemeris());
+            const Galileo_Ephemeris eph = packed_decoder.get_ephemeris();
+            expect_same_ephemeris(string_decoder.get_ephemeris(), eph);
+
+            // fields at their ICD positions, with the ICD scale factors
+            EXPECT_EQ(eph.IOD_nav, static_cast<int32_t>(iod_nav));
+            EXPECT_EQ(eph.toe, static_cast<int32_t>(ref_unsigned(words[1], 17, 14)) * T0E_1_LSB);
+            EXPECT_EQ(eph.M_0, static_cast<double>(ref_signed(words[1], 31, 32)) * M0_1_LSB);
+            EXPECT_EQ(eph.ecc, static_cast<double>(ref_unsigned(words[1], 63, 32)) * E_1_LSB);
+            EXPECT_EQ(eph.sqrtA, static_cast<double>(ref_unsigned(words[1], 95, 32)) * A_1_LSB_GAL);
+            EXPECT_EQ(eph.OMEGA_0, static_cast<double>(ref_signed(words[2], 17, 32)) * OMEGA_0_2_LSB);
+            EXPECT_EQ(eph.i_0, static_cast<double>(ref_signed(words[2], 49, 32)) * I_0_2_LSB);
+            EXPECT_EQ(eph.omega, static_cast<double>(ref_signed(words[2], 81, 32)) * OMEGA_2_LSB);
+            EXPECT_EQ(eph.idot, static_cast<double>(ref_signed(words[2], 113, 14)) * I_DOT_2_LSB);
+            EXPECT_EQ(eph.OMEGAdot, static_cast<double>(ref_signed(words[3], 17, 24)) * OMEGA_DOT_3_LSB);
+            EXPECT_EQ(eph.delta_n, static_cast<double>(ref_signed(words[3], 41, 16)) * DELTA_N_3_LSB);
+            EXPECT_EQ(eph.Cuc, static_cast<double>(ref_signed(words[3], 57, 16)) * C_UC_3_LSB);
+            EXPECT_EQ(eph.Cus, static_cast<double>(ref_signed(words[3], 73, 16)) * C_US_3_LSB);
+            EXPECT_EQ(eph.Crc, static_cast<double>(ref_signed(words[3], 89, 16)) * C_RC_3_LSB);
+            EXPECT_EQ(eph.Crs, static_cast<double>(ref_signed(words[3], 105, 16)) * C_RS_3_LSB);
+            EXPECT_EQ(eph.SISA, static_cast<int32_t>(ref_unsigned(words[3], 121, 8)));
+            EXPECT_EQ(eph.PRN, static_cast<uint32_t>(ref_unsigned(words[4], 17, 6)));
+            EXPECT_EQ(eph.Cic, static_cast<double>(ref_signed(words[4], 23, 16)) * C_IC_4_LSB);
+            EXPECT_EQ(eph.Cis, static_cast<double>(ref_signed(words[4], 39, 16)) * C_IS_4_LSB);
+            EXPECT_EQ(eph.toc, static_cast<int32_t>(ref_unsigned(words[4], 55, 14)) * T0C_4_LSB);
+            EXPECT_EQ(eph.af0, static_cast<double>(ref_signed(words[4], 69, 31)) * AF0_4_LSB);
+            EXPECT_EQ(eph.af1, static_cast<double>(ref_signed(words[4], 100, 21)) * AF1_4_LSB);
+            EXPECT_EQ(eph.af2, static_cast<double>(ref_signed(words[4], 121, 6)) * AF2_4_LSB);
+            EXPECT_EQ(eph.BGD_E1E5a, static_cast<double>(ref_signed(words[5], 48, 10)) * BGD_E1_E5A_5_LSB);
+            EXPECT_EQ(eph.BGD_E1E5b, static_cast<double>(ref_signed(words[5], 58, 10)) * BGD_E1_E5B_5_LSB);
+            EXPECT_EQ(eph.E5b_HS, static_cast<int32_t>(ref_unsigned(words[5], 68, 2)));
+            EXPECT_EQ(eph.E1B_HS, static_cast<int32_t>(ref_unsigned(words[5], 70, 2)));
+            EXPECT_EQ(eph.E5b_DVS, words[5][71] == '1');
+            EXPECT_EQ(eph.E1B_DVS, words[5][72] == '1');
+            EXPECT_EQ(eph.WN, static_cast<int32_t>(ref_unsigned(words[5], 74, 12)));
+            EXPECT_EQ(eph.tow, static_cast<int32_t>(ref_unsigned(words[5], 86, 20)));
+        }
+}
+
+
+TEST(GalileoNavMessagePackedTest, InavAlmanacMatchesStringPath)
+{
+    std::mt19937 gen(4202);
+    for (int trial = 0; trial < 50; trial++)
+        {
+            Galileo_Inav_Message string_decoder;
+            Galileo_Inav_Message packed_decoder;
+            std::array<std::string, 11> words;
+            for (uint32_t type = 7; type <= 10; type++)
+                {
+                    words[type] = make_random_word(type, GALILEO_DATA_JK_BITS, gen);
+                    string_decoder.page_jk_decoder(words[type].c_str());
+                    packed_decoder.page_jk_decoder(pack_decisions<GALILEO_DATA_JK_BITS>(words[type]));
+                }
+            ASSERT_TRUE(string_decoder.have_new_almanac());
+            ASSERT_TRUE(packed_decoder.have_new_almanac());
+            const Galileo_Almanac_Helper string_almanac = string_decoder.get_almanac();
+            const Galileo_Almanac_Helper packed_almanac = packed_decoder.get_almanac();
+            for (int i = 1; i <= 3; i++)
+                {
+                    expect_same_almanac(string_almanac.get_almanac(i), packed_almanac.get_almanac(i));
+                }
+
+            // SVID1 is sent in word types 7 and 8
+            const Galileo_Almanac alm = packed_almanac.get_almanac(1);
+            EXPECT_EQ(alm.IODa, static_cast<int32_t>(ref_unsigned(words[7], 7, 4)));
+            EXPECT_EQ(alm.WNa, static_cast<int32_t>(ref_unsigned(words[7], 11, 2)));
+            EXPECT_EQ(alm.toa, static_cast<int32_t>(ref_unsigned(words[7], 13, 10)) * T0A_7_LSB);
+            EXPECT_EQ(alm.PRN, static_cast<uint32_t>(ref_unsigned(words[7], 23, 6)));
+            EXPECT_EQ(alm.ecc, static_cast<double>(ref_unsigned(words[7], 42, 11)) * E_7_LSB);
+            EXPECT_EQ(alm.omega, static_cast<double>(ref_signed(words[7], 53, 16)) * OMEGA_7_LSB);
+            EXPECT_EQ(alm.delta_i, static_cast<double>(ref_signed(words[7], 69, 11)) * DELTA_I_7_LSB);
+            EXPECT_EQ(alm.OMEGA_0, static_cast<double>(ref_signed(words[7], 80, 16)) * OMEGA0_7_LSB);
+            EXPECT_EQ(alm.OMEGAdot, static_cast<double>(ref_signed(words[7], 96, 11)) * OMEGA_DOT_7_LSB);
+            EXPECT_EQ(alm.M_0, static_cast<double>(ref_signed(words[7], 107, 16)) * M0_7_LSB);
+            EXPECT_EQ(alm.af0, static_cast<double>(ref_signed(words[8], 11, 16)) * AF0_8_LSB);
+            EXPECT_EQ(alm.af1, static_cast<double>(ref_signed(words[8], 27, 13)) * AF1_8_LSB);
+            EXPECT_EQ(alm.E5b_HS, static_cast<int32_t>(ref_unsigned(words[8], 40, 2)));
+            EXPECT_EQ(alm.E1B_HS, static_cast<int32_t>(ref_unsigned(words[8], 42, 2)));
+            EXPECT_EQ(packed_almanac.get_almanac(2).PRN, static_cast<uint32_t>(ref_unsigned(words[8], 44, 6)));
+        }
+}
+
+
+TEST(GalileoNavMessagePackedTest, FnavEphemerisAndAlmanacMatchStringPath)
+{
+    std::mt19937 gen(1983);
+    for (int trial = 0; trial < 50; trial++)
+        {
+            Galileo_Fnav_Message string_decoder;
+            Galileo_Fnav_Message packed_decoder;
+            const uint32_t iod_nav = gen() & 0x3FFU;
+            std::array<std::string, 7> words;
+            for (uint32_t type = 1; type <= 6; type++)
+                {
+                    words[type] = make_random_word(type, GALILEO_FNAV_DATA_FRAME_BITS, gen);
+                    if (type <= 4)
+                        {
+                            write_field(words[type], type == 1 ? 13 : 7, 10, iod_nav);
+                        }
+                    const std::string page = make_fnav_page(words[type]);
+                    string_decoder.split_page(page);
+                    packed_decoder.split_page(pack_decisions<GALILEO_FNAV_PAGE_BITS>(page));
+                    ASSERT_TRUE(string_decoder.get_flag_CRC_test());
+                    ASSERT_TRUE(packed_decoder.get_flag_CRC_test());
+                }
+            ASSERT_TRUE(string_decoder.have_new_ephemeris());
+            ASSERT_TRUE(packed_decoder.have_new_ephemeris());
+            const Galileo_Ephemeris eph = packed_decoder.get_ephemeris();
+            expect_same_ephemeris(string_decoder.get_ephemeris(), eph);
+
+            EXPECT_EQ(eph.PRN, static_cast<uint32_t>(ref_unsigned(words[1], 7, 6)));
+            EXPECT_EQ(eph.IOD_ephemeris, static_cast<int32_t>(iod_nav));
+            EXPECT_EQ(eph.toc, static_cast<int32_t>(ref_unsigned(words[1], 23, 14)) * FNAV_T0C_1_LSB);
+            EXPECT_EQ(eph.af0, static_cast<double>(ref_signed(words[1], 37, 31)) * FNAV_AF0_1_LSB);
+            EXPECT_EQ(eph.af1, static_cast<double>(ref_signed(words[1], 68, 21)) * FNAV_AF1_1_LSB);
+            EXPECT_EQ(eph.M_0, static_cast<double>(ref_signed(words[2], 17, 32)) * FNAV_M0_2_LSB);
+            EXPECT_EQ(eph.ecc, static_cast<double>(ref_unsigned(words[2], 73, 32)) * FNAV_E_2_LSB);
+            EXPECT_EQ(eph.sqrtA, static_cast<double>(ref_unsigned(words[2], 105, 32)) * FNAV_A12_2_LSB);
+            EXPECT_EQ(eph.OMEGA_0, static_cast<double>(ref_signed(words[2], 137, 32)) * FNAV_OMEGA0_2_LSB);
+            EXPECT_EQ(eph.delta_n, static_cast<double>(ref_signed(words[3], 81, 16)) * FNAV_DELTAN_3_LSB);
+            EXPECT_EQ(eph.Crs, static_cast<double>(ref_signed(words[3], 145, 16)) * FNAV_CRS_3_LSB);
+            EXPECT_EQ(eph.toe, static_cast<int32_t>(ref_unsigned(words[3], 161, 14)) * FNAV_T0E_3_LSB);
+            EXPECT_EQ(eph.Cic, static_cast<double>(ref_signed(words[4], 17, 16)) * FNAV_CIC_4_LSB);
+            EXPECT_EQ(eph.Cis, static_cast<double>(ref_signed(words[4], 33, 16)) * FNAV_CIS_4_LSB);
+
+            ASSERT_TRUE(string_decoder.have_new_almanac());
+            ASSERT_TRUE(packed_decoder.have_new_almanac());
+            const Galileo_Almanac_Helper string_almanac = string_decoder.get_almanac();
+            const Galileo_Almanac_Helper packed_almanac = packed_decoder.get_almanac();
+            for (int i = 1; i <= 3; i++)
+                {
+                    expect_same_almanac(string_almanac.get_almanac(i), packed_almanac.get_almanac(i));
+                }
+
+            // the Omega0 of SVID2 is split between word types 5 (4 MSBs)
+            // and 6 (12 LSBs)
+            const auto omega0_2 = static_cast<int16_t>(static_cast<uint16_t>((ref_unsigned(words[5], 211, 4) << 12U) | ref_unsigned(words[6], 11, 12)));
+            EXPECT_EQ(packed_almanac.get_almanac(2).OMEGA_0, static_cast<double>(omega0_2) * FNAV_OMEGA0_5_LSB);
+            EXPECT_EQ(packed_almanac.get_almanac(1).OMEGA_0, static_cast<double>(ref_signed(words[5], 80, 16)) * FNAV_OMEGA0_5_LSB);
+        }
+}
@@ -0,0 +1,91 @@
+/*!
+ * \file gnss_packed_bits_test.cc
+ * \brief Tests for the packed navigation message bits container
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_packed_bits.h"
+#include <gtest/gtest.h>
+#include <bitset>
+#include <random>
+#include <string>
+#include <vector>
+
+
+TEST(GnssPackedBitsTest, ReadFieldsAcrossWordBoundaries)
+{
+    std::mt19937 gen(1234);
+    std::string page;
+    for (int i = 0; i < 234; i++)
+        {
+            page.push_back((gen() & 1U) ? '1' : '0');
+        }
+    const Gnss_Packed_Bits<234> bits(page);
+    EXPECT_EQ(bits.to_string(), page);
+
+    for (int32_t first = 1; first <= 234; first++)
+        {
+            for (int32_t length = 1; length <= 64 && first + length - 1 <= 234; length++)
+                {
+                    uint64_t expected = 0ULL;
+                    for (int32_t j = 0; j < length; j++)
+                        {
+                            expected = (expected << 1U) | static_cast<uint64_t>(page[first - 1 + j] == '1');
+                        }
+                    const int64_t expected_signed = (page[first - 1] == '1' && length < 64) ? static_cast<int64_t>(expected | (~0ULL << length)) : static_cast<int64_t>(expected);
+                    ASSERT_EQ(bits.read_unsigned({first, length}), expected) << "first = " << first << ", length = " << length;
+                    ASSERT_EQ(bits.read_signed({first, length}), expected_signed) << "first = " << first << ", length = " << length;
+                }
+            EXPECT_EQ(bits.read_bool({first, 1}), page[first - 1] == '1');
+        }
+}
+
+
+TEST(GnssPackedBitsTest, WriteAndCopy)
+{
+    Gnss_Packed_Bits<128> bits;
+    bits.write_unsigned({1, 6}, 0x3F);
+    bits.write_unsigned({58, 10}, 0x2A5);  // crosses the word boundary
+    bits.write_unsigned({68, 60}, 0x0123456789ABCDEULL);
+    EXPECT_EQ(bits.read_unsigned({1, 6}), 0x3FULL);
+    EXPECT_EQ(bits.read_unsigned({58, 10}), 0x2A5ULL);
+    EXPECT_EQ(bits.read_unsigned({68, 60}), 0x0123456789ABCDEULL);
+    EXPECT_FALSE(bits.test(6));
+    EXPECT_EQ(bits.read_unsigned({7, 51}), 0ULL);
+    EXPECT_FALSE(bits.test(127));
+
+    // Overwriting a field does not change its neighbours
+    bits.write_unsigned({58, 10}, 0);
+    EXPECT_EQ(bits.read_unsigned({58, 10}), 0ULL);
+    EXPECT_EQ(bits.read_unsigned({1, 6}), 0x3FULL);
+    EXPECT_EQ(bits.read_unsigned({68, 60}), 0x0123456789ABCDEULL);
+
+    Gnss_Packed_Bits<240> joined;
+    joined.copy(bits, 67, 100, 60);
+    joined.copy(bits, 0, 3, 6);
+    EXPECT_EQ(joined.read_unsigned({101, 60}), 0x0123456789ABCDEULL);
+    EXPECT_EQ(joined.read_unsigned({4, 6}), 0x3FULL);
+
+    // Conversion from std::bitset and from hard decisions
+    const std::string s("1011000111010001");
+    const Gnss_Packed_Bits<16> from_bitset(std::bitset<16>{s});
+    std::vector<int32_t> decisions;
+    for (const char c : s)
+        {
+            decisions.push_back(c == '1' ? 1 : -1);
+        }
+    Gnss_Packed_Bits<16> from_decisions;
+    from_decisions.assign(decisions.data(), decisions.size());
+    EXPECT_EQ(from_bitset.to_string(), s);
+    EXPECT_EQ(from_decisions.to_string(), s);
+}
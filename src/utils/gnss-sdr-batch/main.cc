@@ -0,0 +1,419 @@
+/*!
+ * \file main.cc
+ * \brief Processes a file of raw samples faster than real time by splitting
+ * it into overlapping time segments, running one receiver per segment in
+ * parallel and stitching their outputs.
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "INIReader.h"
+#include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_flags.h"
+#include "segment_stitcher.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <fcntl.h>     // for open
+#include <sys/wait.h>  // for waitpid
+#include <unistd.h>    // for fork, execvp, dup2, chdir
+#include <algorithm>   // for std::min, std::max
+#include <cctype>      // for std::isdigit, std::isupper
+#include <chrono>
+#include <cmath>       // for std::ceil
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(gnss_sdr, "gnss-sdr", "Path to the gnss-sdr executable.");
+DEFINE_double(segment_duration_s, 600.0, "Duration of each time segment of the capture, without the overlap [s].");
+DEFINE_double(overlap_s, 45.0, "Time each segment starts before the end of the previous one, so its receiver has a fix and tracked carrier phases at the boundary [s].");
+DEFINE_double(prepass_s, 60.0, "Duration of the initial pre-pass that gets the ephemeris used as assistance by all segments. If 0, no pre-pass is run [s].");
+DEFINE_string(assistance_dir, "", "Folder with XML assistance files (e.g., from rinex2assist or from a previous run). If set, no pre-pass is run.");
+DEFINE_int32(jobs, 0, "Maximum number of receivers running at the same time. If 0, the number of CPU cores.");
+DEFINE_string(work_dir, "./gnss-sdr-batch", "Folder for the configuration files, logs and outputs of each segment.");
+DEFINE_string(output_dir, ".", "Folder for the stitched RINEX and NMEA files.");
+
+
+namespace
+{
+struct Receiver_Run
+{
+    std::string name;
+    std::string dir;
+    double start_s{0.0};  // from the first sample to be processed
+    double duration_s{0.0};
+    uint64_t samples{0};  // 0 means until the end of the file
+    pid_t pid{-1};
+    bool ok{false};
+};
+
+
+std::string absolute_path(const std::string& path)
+{
+    errorlib::error_code ec;
+    const fs::path canonical = fs::canonical(fs::path(path), ec);
+    return ec ? fs::absolute(fs::path(path)).string() : canonical.string();
+}
+
+
+// Writes the configuration of a receiver: the original one, followed by
+// the properties that override it, since the last value of a key wins.
+bool write_config(const std::string& base_config, const std::string& filename, const std::vector<std::pair<std::string, std::string>>& overrides)
+{
+    std::ifstream in(base_config);
+    std::ofstream out(filename, std::ios::out | std::ios::trunc);
+    if (!in.is_open() || !out.is_open())
+        {
+            return false;
+        }
+    out << in.rdbuf() << '\n';
+    out << "\n;######### ADDED BY GNSS-SDR-BATCH ############\n[GNSS-SDR]\n";
+    for (const auto& property : overrides)
+        {
+            out << property.first << "=" << property.second << '\n';
+        }
+    return out.good();
+}
+
+
+pid_t launch_receiver(const Receiver_Run& run, const std::string& config_file)
+{
+    const std::vector<std::string> args = {FLAGS_gnss_sdr, "--config_file=" + config_file, "--log_dir=" + run.dir, "--keyboard=false"};
+    std::vector<char*> argv;
+    for (const auto& arg : args)
+        {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+    argv.push_back(nullptr);
+    const std::string log_file = run.dir + "/gnss-sdr.log";
+
+    const pid_t pid = fork();
+    if (pid == 0)
+        {
+            // Relative paths in the configuration (dumps, etc.) end up in the folder of the segment
+            const int log_fd = open(log_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            const int null_fd = open("/dev/null", O_RDONLY);
+            if (chdir(run.dir.c_str()) != 0 || log_fd < 0 || null_fd < 0)
+                {
+                    _exit(127);
+                }
+            dup2(null_fd, STDIN_FILENO);
+            dup2(log_fd, STDOUT_FILENO);
+            dup2(log_fd, STDERR_FILENO);
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+    return pid;
+}
+
+
+// Runs the receivers, at most max_jobs at the same time. Returns false if any of them failed.
+bool run_receivers(std::vector<Receiver_Run>& runs, const std::map<std::string, std::string>& configs, int max_jobs)
+{
+    std::size_t next = 0;
+    int running = 0;
+    bool all_ok = true;
+    const auto start = std::chrono::steady_clock::now();
+    while (next < runs.size() || running > 0)
+        {
+            while (next < runs.size() && running < max_jobs)
+                {
+                    auto& run = runs[next++];
+                    run.pid = launch_receiver(run, configs.at(run.name));
+                    if (run.pid < 0)
+                        {
+                            std::cerr << "Cannot launch the receiver of " << run.name << '\n';
+                            all_ok = false;
+                            continue;
+                        }
+                    running++;
+                    std::cout << "Processing " << run.name << ": " << run.duration_s << " s starting at " << run.start_s << " s\n";
+                }
+            int status = 0;
+            const pid_t pid = waitpid(-1, &status, 0);
+            if (pid < 0)
+                {
+                    break;
+                }
+            for (auto& run : runs)
+                {
+                    if (run.pid == pid)
+                        {
+                            running--;
+                            run.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+                            all_ok = all_ok && run.ok;
+                            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                            std::cout << (run.ok ? "Finished " : "FAILED ") << run.name << " after " << elapsed.count()
+                                      << " s (see " << run.dir << "/gnss-sdr.log)\n";
+                        }
+                }
+        }
+    return all_ok;
+}
+
+
+// RINEX observation (.yyO) and navigation (.yyN, .yyL, .yyG, ...) files, and NMEA files, in a folder
+std::map<std::string, std::string> find_outputs(const std::string& dir)
+{
+    std::map<std::string, std::string> outputs;
+    errorlib::error_code ec;
+    for (fs::directory_iterator it(fs::path(dir), ec), end; !ec && it != end; it.increment(ec))
+        {
+            const std::string extension = it->path().extension().string();
+            if (extension == ".nmea")
+                {
+                    outputs["nmea"] = it->path().string();
+                }
+            else if (extension.size() == 4 && std::isdigit(extension[1]) && std::isdigit(extension[2]) && std::isupper(extension[3]))
+                {
+                    outputs[extension.substr(3)] = it->path().string();
+                }
+        }
+    return outputs;
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n gnss-sdr-batch processes a file of raw samples faster than real time,\n") +
+        "splitting it into overlapping time segments that are processed in parallel\n" +
+        "by independent receivers, and stitching their RINEX and NMEA outputs.\n" +
+        "Copyright (C) 2010-2024 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License.\n \n" +
+        "Usage: \n" +
+        "   gnss-sdr-batch --config_file=<file> [--segment_duration_s=600] [--jobs=N]");
+
+    gflags::SetUsageMessage(intro_help);
+    gflags::SetVersionString("1.0");
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    const std::string config_file = absolute_path(FLAGS_c == "-" ? FLAGS_config_file : FLAGS_c);
+    INIReader ini(config_file);
+    if (ini.ParseError() != 0)
+        {
+            std::cerr << "Cannot read the configuration file " << config_file << '\n';
+            return 1;
+        }
+
+    // Only a single file source is supported, and its item size is needed to locate the segments
+    const std::string implementation = ini.Get("GNSS-SDR", "SignalSource.implementation", "");
+    if (implementation != "File_Signal_Source" && implementation != "File_Timestamp_Signal_Source")
+        {
+            std::cerr << "gnss-sdr-batch requires SignalSource.implementation=File_Signal_Source or File_Timestamp_Signal_Source\n";
+            return 1;
+        }
+    const std::map<std::string, std::pair<uint64_t, uint64_t>> item_types = {
+        // item type, {bytes per item, items per sample}
+        {"gr_complex", {8, 1}}, {"float", {4, 1}}, {"short", {2, 1}}, {"ishort", {2, 2}}, {"byte", {1, 1}}, {"ibyte", {1, 2}}};
+    const auto item_type = item_types.find(ini.Get("GNSS-SDR", "SignalSource.item_type", "short"));
+    if (item_type == item_types.cend())
+        {
+            std::cerr << "Unsupported SignalSource.item_type\n";
+            return 1;
+        }
+    const std::string filename = absolute_path(FLAGS_s != "-" ? FLAGS_s : (FLAGS_signal_source != "-" ? FLAGS_signal_source : ini.Get("GNSS-SDR", "SignalSource.filename", "")));
+    const double fs_in = static_cast<double>(ini.GetInteger("GNSS-SDR", "SignalSource.sampling_frequency", ini.GetInteger("GNSS-SDR", "GNSS-SDR.internal_fs_sps", 0)));
+    errorlib::error_code ec;
+    const auto file_size = fs::file_size(fs::path(filename), ec);
+    if (ec || fs_in <= 0.0)
+        {
+            std::cerr << "Cannot access " << filename << ", or SignalSource.sampling_frequency is not set\n";
+            return 1;
+        }
+    const double items_per_second = fs_in * static_cast<double>(item_type->second.second);
+    const double first_second = std::strtod(ini.Get("GNSS-SDR", "SignalSource.seconds_to_skip", "0").c_str(), nullptr);
+    const auto header_items = static_cast<uint64_t>(ini.GetInteger("GNSS-SDR", "SignalSource.header_size", 0));
+    const uint64_t file_items = file_size / item_type->second.first;
+    double duration_s = (static_cast<double>(file_items) - static_cast<double>(header_items)) / items_per_second - first_second;
+    const auto max_samples = ini.GetInteger("GNSS-SDR", "SignalSource.samples", 0);
+    if (max_samples > 0)
+        {
+            duration_s = std::min(duration_s, static_cast<double>(max_samples) / items_per_second);
+        }
+    if (duration_s <= FLAGS_overlap_s || FLAGS_segment_duration_s <= FLAGS_overlap_s)
+        {
+            std::cerr << "The capture (" << duration_s << " s) and each segment must be longer than the overlap (" << FLAGS_overlap_s << " s)\n";
+            return 1;
+        }
+
+    // The last segment takes the remainder if it is too short to have a fix before the boundary
+    auto num_segments = static_cast<std::size_t>(std::max(1.0, std::ceil(duration_s / FLAGS_segment_duration_s)));
+    if (num_segments > 1 && duration_s - static_cast<double>(num_segments - 1) * FLAGS_segment_duration_s < FLAGS_overlap_s)
+        {
+            num_segments--;
+        }
+    const int max_jobs = FLAGS_jobs > 0 ? FLAGS_jobs : static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+    fs::create_directories(fs::path(FLAGS_work_dir), ec);
+    const std::string work_dir = absolute_path(FLAGS_work_dir);
+    std::cout << "Processing " << duration_s << " s of " << filename << " in " << num_segments << " segments, up to " << max_jobs << " at the same time\n";
+
+    const std::vector<std::string> pvt_paths = {"output_path", "rinex_output_path", "gpx_output_path", "geojson_output_path", "kml_output_path",
+        "xml_output_path", "nmea_output_file_path", "rtcm_output_file_path", "has_output_file_path"};
+    auto receiver_overrides = [&](const Receiver_Run& run) {
+        std::vector<std::pair<std::string, std::string>> overrides = {
+            {"SignalSource.filename", filename},
+            {"SignalSource.repeat", "false"},
+            {"SignalSource.seconds_to_skip", std::to_string(first_second + run.start_s)},
+            {"SignalSource.samples", std::to_string(run.samples)},
+            {"PVT.rinex_version", "3"},
+            {"PVT.rinex_output_enabled", "true"},
+            {"PVT.nmea_output_file_enabled", "true"},
+            {"PVT.xml_output_enabled", "true"},
+            // Epochs of all the segments are aligned to GPS time, so they can be matched at the boundaries
+            {"PVT.enable_rx_clock_correction", "true"}};
+        for (const auto& path : pvt_paths)
+            {
+                overrides.emplace_back("PVT." + path, run.dir);
+            }
+        return overrides;
+    };
+    auto prepare = [&](std::vector<Receiver_Run>& runs, const std::vector<std::pair<std::string, std::string>>& extra, std::map<std::string, std::string>& configs) {
+        for (const auto& run : runs)
+            {
+                errorlib::error_code ec_dir;
+                fs::create_directories(fs::path(run.dir), ec_dir);
+                auto overrides = receiver_overrides(run);
+                overrides.insert(overrides.end(), extra.cbegin(), extra.cend());
+                const std::string run_config = run.dir + "/" + run.name + ".conf";
+                if (ec_dir || !write_config(config_file, run_config, overrides))
+                    {
+                        std::cerr << "Cannot write " << run_config << '\n';
+                        return false;
+                    }
+                configs[run.name] = run_config;
+            }
+        return true;
+    };
+    const auto start = std::chrono::steady_clock::now();
+
+    // Pre-pass: the ephemeris and models decoded at the beginning of the capture assist the receivers of all segments
+    std::string assistance_dir = FLAGS_assistance_dir.empty() ? std::string() : absolute_path(FLAGS_assistance_dir);
+    if (assistance_dir.empty() && FLAGS_prepass_s > 0.0)
+        {
+            std::vector<Receiver_Run> prepass(1);
+            prepass[0].name = "prepass";
+            prepass[0].dir = work_dir + "/prepass";
+            prepass[0].duration_s = std::min(FLAGS_prepass_s, duration_s);
+            prepass[0].samples = static_cast<uint64_t>(std::ceil(prepass[0].duration_s * items_per_second));
+            std::map<std::string, std::string> configs;
+            if (!prepare(prepass, {}, configs) || !run_receivers(prepass, configs, 1))
+                {
+                    std::cerr << "The pre-pass failed, segments will not be assisted\n";
+                }
+            else
+                {
+                    assistance_dir = prepass[0].dir;
+                }
+        }
+    std::vector<std::pair<std::string, std::string>> assistance;
+    if (!assistance_dir.empty())
+        {
+            const std::vector<std::pair<std::string, std::string>> assistance_files = {
+                {"AGNSS_gps_ephemeris_xml", "gps_ephemeris.xml"}, {"AGNSS_gps_utc_model_xml", "gps_utc_model.xml"},
+                {"AGNSS_gps_iono_xml", "gps_iono.xml"}, {"AGNSS_gps_almanac_xml", "gps_almanac.xml"},
+                {"AGNSS_gps_cnav_ephemeris_xml", "gps_cnav_ephemeris.xml"}, {"AGNSS_cnav_utc_model_xml", "gps_cnav_utc_model.xml"},
+                {"AGNSS_gal_ephemeris_xml", "gal_ephemeris.xml"}, {"AGNSS_gal_iono_xml", "gal_iono.xml"},
+                {"AGNSS_gal_utc_model_xml", "gal_utc_model.xml"}, {"AGNSS_gal_almanac_xml", "gal_almanac.xml"},
+                {"AGNSS_glo_ephemeris_xml", "glo_gnav_ephemeris.xml"}, {"AGNSS_glo_utc_model_xml", "glo_utc_model.xml"}};
+            for (const auto& file : assistance_files)
+                {
+                    const std::string path = assistance_dir + "/" + file.second;
+                    if (fs::exists(fs::path(path)))
+                        {
+                            assistance.emplace_back("GNSS-SDR." + file.first, path);
+                        }
+                }
+            if (!assistance.empty())
+                {
+                    assistance.emplace_back("GNSS-SDR.AGNSS_XML_enabled", "true");
+                    std::cout << "Segments assisted with the XML files in " << assistance_dir << '\n';
+                }
+        }
+
+    std::vector<Receiver_Run> segments(num_segments);
+    for (std::size_t k = 0; k < num_segments; k++)
+        {
+            auto& run = segments[k];
+            std::stringstream name;
+            name << "segment_" << k;
+            run.name = name.str();
+            run.dir = work_dir + "/" + run.name;
+            const double nominal_start = static_cast<double>(k) * FLAGS_segment_duration_s;
+            const double end = k + 1 == num_segments ? duration_s : nominal_start + FLAGS_segment_duration_s;
+            run.start_s = std::max(0.0, nominal_start - FLAGS_overlap_s);
+            run.duration_s = end - run.start_s;
+            run.samples = k + 1 == num_segments ? 0 : static_cast<uint64_t>(std::ceil(run.duration_s * items_per_second));
+        }
+    std::map<std::string, std::string> configs;
+    if (!prepare(segments, assistance, configs))
+        {
+            return 1;
+        }
+    const bool all_ok = run_receivers(segments, configs, max_jobs);
+
+    // Stitch the outputs, in chronological order
+    std::map<std::string, std::vector<std::string>> outputs;
+    for (const auto& run : segments)
+        {
+            for (const auto& output : find_outputs(run.dir))
+                {
+                    outputs[output.first].push_back(output.second);
+                }
+        }
+    fs::create_directories(fs::path(FLAGS_output_dir), ec);
+    Segment_Stitcher stitcher;
+    bool stitched = true;
+    for (const auto& output : outputs)
+        {
+            const std::string stitched_file = FLAGS_output_dir + "/" + fs::path(output.second.front()).filename().string();
+            bool ok = false;
+            if (output.first == "nmea")
+                {
+                    ok = stitcher.stitch_nmea(output.second, stitched_file);
+                }
+            else if (output.first == "O")
+                {
+                    ok = stitcher.stitch_rinex_obs(output.second, stitched_file);
+                    std::cout << "Carrier phase arcs continued across segments: " << stitcher.continued_arcs()
+                              << ", marked with loss of lock: " << stitcher.broken_arcs() << '\n';
+                }
+            else
+                {
+                    ok = stitcher.stitch_rinex_nav(output.second, stitched_file);
+                }
+            std::cout << (ok ? "Written " : "Cannot write ") << stitched_file << '\n';
+            stitched = stitched && ok;
+        }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Processed " << duration_s << " s of signal in " << elapsed.count() << " s\n";
+    gflags::ShutDownCommandLineFlags();
+    return all_ok && stitched && !outputs.empty() ? 0 : 1;
+}
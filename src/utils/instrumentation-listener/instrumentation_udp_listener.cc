@@ -0,0 +1,95 @@
+/*!
+ * \file instrumentation_udp_listener.cc
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "instrumentation_udp_listener.h"
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+Instrumentation_Udp_Listener::Instrumentation_Udp_Listener(unsigned short port)
+    : socket{io_service}, endpoint{boost::asio::ip::udp::v4(), port}
+{
+    socket.open(endpoint.protocol(), error);  // Open socket.
+    socket.bind(endpoint, error);             // Bind the socket to the given local endpoint.
+}
+
+/**
+ * !\brief blocking call to read an instrumentation report from UDP port
+ * \param[out] report instrumentation report class to contain parsed output
+ * \return true if message parsed succesfully, false ow
+ */
+bool Instrumentation_Udp_Listener::receive_and_parse_report(gnss_sdr::Instrumentation &report)
+{
+    std::vector<char> buff(65536);  // Buffer for storing the received data (up to a full UDP datagram).
+
+    // This call will block until one or more bytes of data has been received.
+    int bytes = socket.receive(boost::asio::buffer(buff));
+
+    std::string data(buff.data(), bytes);
+    // Deserialize the report from the binary string.
+    return report.ParseFromString(data);
+}
+
+/*
+ * !\brief prints the load of each block and the sample-to-PVT latency
+ * \param[in] report instrumentation report to be printed
+ */
+void Instrumentation_Udp_Listener::print_report(const gnss_sdr::Instrumentation &report) const
+{
+    const double period_s = report.period_s() > 0.0 ? report.period_s() : 1.0;
+
+    std::cout << "\nNew report received (" << std::fixed << std::setprecision(2) << period_s << " s):\n";
+    if (report.pvt_fixes() > 0)
+        {
+            std::cout << "Sample-to-PVT latency [ms]: min " << report.sample_to_pvt_min_ms()
+                      << ", mean " << report.sample_to_pvt_mean_ms()
+                      << ", max " << report.sample_to_pvt_max_ms()
+                      << " (" << report.pvt_fixes() << " fixes, last at sample " << report.tracking_sample_counter() << ")\n";
+        }
+    else
+        {
+            std::cout << "Sample-to-PVT latency [ms]: no PVT fixes\n";
+        }
+
+    std::cout << std::left << std::setw(34) << "Block" << std::right
+              << std::setw(5) << "Ch"
+              << std::setw(9) << "Calls"
+              << std::setw(14) << "Items/s"
+              << std::setw(8) << "Load%"
+              << std::setw(11) << "Mean[us]"
+              << std::setw(11) << "Max[us]"
+              << std::setw(11) << "InMean"
+              << std::setw(10) << "InMax"
+              << std::setw(10) << "Drops"
+              << std::setw(12) << "Dropped" << '\n';
+    for (const auto &b : report.block())
+        {
+            if (b.calls() == 0 && b.dropped_events() == 0)
+                {
+                    continue;  // idle
+                }
+            std::cout << std::left << std::setw(34) << b.block() << std::right
+                      << std::setw(5) << b.channel_id()
+                      << std::setw(9) << b.calls()
+                      << std::setw(14) << std::setprecision(0) << static_cast<double>(b.items()) / period_s
+                      << std::setw(8) << std::setprecision(1) << b.work_time_ms() / (10.0 * period_s)
+                      << std::setw(11) << (b.calls() > 0 ? 1000.0 * b.work_time_ms() / static_cast<double>(b.calls()) : 0.0)
+                      << std::setw(11) << b.work_time_max_us()
+                      << std::setw(11) << b.input_items_mean()
+                      << std::setw(10) << b.input_items_max()
+                      << std::setw(10) << b.dropped_events()
+                      << std::setw(12) << b.dropped_samples() << '\n';
+        }
+}
@@ -0,0 +1,35 @@
+/*!
+ * \file instrumentation_udp_listener.h
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INSTRUMENTATION_UDP_LISTENER_H
+#define GNSS_SDR_INSTRUMENTATION_UDP_LISTENER_H
+
+#include "instrumentation.pb.h"
+#include <boost/asio.hpp>
+
+class Instrumentation_Udp_Listener
+{
+public:
+    explicit Instrumentation_Udp_Listener(unsigned short port);
+    void print_report(const gnss_sdr::Instrumentation &report) const;
+    bool receive_and_parse_report(gnss_sdr::Instrumentation &report);
+
+private:
+    boost::asio::io_service io_service;
+    boost::asio::ip::udp::socket socket;
+    boost::system::error_code error;
+    boost::asio::ip::udp::endpoint endpoint;
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*!
+ * \file main.cc
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "instrumentation_udp_listener.h"
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+
+int main(int argc, char *argv[])
+{
+    try
+        {
+            // Check command line arguments.
+            if (argc != 2)
+                {
+                    // Print help.
+                    std::cerr << "Usage: instrumentation_listener <port>\n";
+                    return 1;
+                }
+
+            unsigned short port = boost::lexical_cast<unsigned short>(argv[1]);
+            Instrumentation_Udp_Listener udp_listener(port);
+
+            while (true)
+                {
+                    gnss_sdr::Instrumentation report;
+                    if (udp_listener.receive_and_parse_report(report))
+                        {
+                            udp_listener.print_report(report);
+                        }
+                    else
+                        {
+                            std::cout << "Error: the message cannot be parsed." << std::endl;
+                        }
+                }
+        }
+    catch (std::exception &e)
+        {
+            std::cerr << e.what() << '\n';
+        }
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+% Reads a GNSS-SDR dump file written with dump_format=columnar and returns
+% a structure with one field per column of the file. Compressed chunks
+% (dump_compression=true) are not supported, use the Python reader instead.
+%
+
+% -------------------------------------------------------------------------
+%
+% GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+% This file is part of GNSS-SDR.
+%
+% Copyright (C) 2010-2024  (see AUTHORS file for a list of contributors)
+% SPDX-License-Identifier: GPL-3.0-or-later
+%
+% -------------------------------------------------------------------------
+
+function [dump] = read_columnar_dump (filename)
+
+% Type codes of the columns, as in gnss_dump_writer.h
+column_types = {'int8', 'uint8', 'int16', 'uint16', 'int32', 'uint32', ...
+    'int64', 'uint64', 'float32', 'float64'};
+
+dump = struct();
+f = fopen (filename, 'rb');
+if (f < 0)
+    return;
+end
+magic = fread (f, 8, '*char')';
+if (~strcmp(magic, 'GNSSDUMP'))
+    fclose (f);
+    error ('%s is not a columnar dump file', filename);
+end
+version = fread (f, 1, 'uint32');
+ncols = fread (f, 1, 'uint32');
+if (version ~= 1)
+    fclose (f);
+    error ('Unsupported dump file version %d', version);
+end
+names = cell(1, ncols);
+types = cell(1, ncols);
+sizes = zeros(1, ncols);
+for n = 1:ncols
+    name = fread (f, 32, '*char')';
+    names{n} = name(1:find([name char(0)] == char(0), 1) - 1);
+    types{n} = column_types{fread(f, 1, 'uint32') + 1};
+    sizes(n) = fread (f, 1, 'uint32');
+    dump.(names{n}) = [];
+end
+while true
+    tag = fread (f, 4, '*char')';
+    if (length(tag) < 4)
+        break;
+    end
+    flags = fread (f, 1, 'uint32');
+    nrec = fread (f, 1, 'uint64');
+    payload_size = fread (f, 1, 'uint64');
+    if (bitand(flags, 1))
+        fclose (f);
+        error ('%s has compressed chunks', filename);
+    end
+    chunk_start = ftell (f);
+    for n = 1:ncols
+        values = fread (f, nrec, ['*' types{n}]);
+        dump.(names{n}) = [dump.(names{n}); values];
+        fseek (f, ceil(nrec * sizes(n) / 8) * 8 - nrec * sizes(n), 'cof');
+    end
+    fseek (f, chunk_start + payload_size, 'bof');
+end
+fclose (f);
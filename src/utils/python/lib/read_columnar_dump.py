@@ -0,0 +1,71 @@
+"""
+ read_columnar_dump.py
+
+   Reads a dump file written by GNSS-SDR with dump_format=columnar.
+
+ read_columnar_dump(filename)
+
+   Args:
+       filename        - path to the .dat file
+
+   Return:
+       A dictionary with one list per column of the file, in record order.
+
+ -----------------------------------------------------------------------------
+
+ GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ This file is part of GNSS-SDR.
+
+ Copyright (C) 2024  (see AUTHORS file for a list of contributors)
+ SPDX-License-Identifier: GPL-3.0-or-later
+
+ -----------------------------------------------------------------------------
+"""
+
+import struct
+import zlib
+
+# Type codes of the columns, as in gnss_dump_writer.h
+COLUMN_TYPES = {0: 'b', 1: 'B', 2: 'h', 3: 'H', 4: 'i', 5: 'I',
+                6: 'q', 7: 'Q', 8: 'f', 9: 'd'}
+
+
+def read_columnar_dump(filename):
+
+    with open(filename, 'rb') as f:
+        data = f.read()
+
+    if data[0:8] != b'GNSSDUMP':
+        raise ValueError(filename + ' is not a columnar dump file')
+    version, ncols = struct.unpack_from('=II', data, 8)
+    if version != 1:
+        raise ValueError('Unsupported dump file version ' + str(version))
+
+    offset = 16
+    names = []
+    types = []
+    sizes = []
+    for _ in range(ncols):
+        names.append(data[offset:offset + 32].split(b'\0', 1)[0].decode())
+        col_type, col_size = struct.unpack_from('=II', data, offset + 32)
+        types.append(COLUMN_TYPES[col_type])
+        sizes.append(col_size)
+        offset += 40
+
+    columns = {name: [] for name in names}
+    while offset + 24 <= len(data):
+        if data[offset:offset + 4] != b'CHNK':
+            raise ValueError('Corrupted chunk in ' + filename)
+        flags, nrec, payload_size = struct.unpack_from('=IQQ', data, offset + 4)
+        offset += 24
+        payload = data[offset:offset + payload_size]
+        offset += payload_size
+        if flags & 1:
+            payload = zlib.decompressobj().decompress(payload)
+        pos = 0
+        for name, col_type, col_size in zip(names, types, sizes):
+            columns[name].extend(
+                struct.unpack_from('=' + str(nrec) + col_type, payload, pos))
+            pos += (nrec * col_size + 7) // 8 * 8
+
+    return columns
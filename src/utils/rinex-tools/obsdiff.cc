@@ -24,12 +24,22 @@
 #include <matio.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -106,14 +116,192 @@ bool file_exist(const char* fileName)
 }
 
 
-std::map<int, arma::mat> ReadRinexObs(const std::string& rinex_file, char system, const std::string& signal)
+/*
+ * Output of a task run by run_in_order(). The text and the plots are kept, in
+ * the order they were produced, until they are replayed in the main thread.
+ * If not deferred, the text goes directly to std::cout and the plots are shown
+ * at once.
+ */
+class Obs_Report
+{
+public:
+    explicit Obs_Report(bool deferred) : d_deferred(deferred) {}
+
+    std::ostream& out()
+    {
+        if (d_deferred)
+            {
+                return d_text;
+            }
+        return std::cout;
+    }
+
+    void plot(std::function<void()> action)
+    {
+        if (!d_deferred)
+            {
+                action();
+                return;
+            }
+        d_steps.emplace_back(d_text.str(), std::move(action));
+        d_text.str("");
+    }
+
+    void replay()
+    {
+        for (auto& step : d_steps)
+            {
+                std::cout << step.first;
+                step.second();
+            }
+        std::cout << d_text.str();
+        d_steps.clear();
+        d_text.str("");
+    }
+
+private:
+    std::ostringstream d_text;
+    std::vector<std::pair<std::string, std::function<void()>>> d_steps;
+    bool d_deferred;
+};
+
+
+/*
+ * Runs task(0) ... task(n_tasks - 1) in a pool of FLAGS_threads threads. The
+ * reports of the tasks are replayed in order in the calling thread, each one as
+ * soon as it and all the previous ones are completed, so the output is the same
+ * as running the tasks one after the other.
+ */
+void run_in_order(std::size_t n_tasks, const std::function<void(std::size_t, Obs_Report&)>& task)
+{
+    std::size_t n_threads = FLAGS_threads > 0 ? FLAGS_threads : std::thread::hardware_concurrency();
+    n_threads = std::min(n_threads, n_tasks);
+    if (n_threads <= 1)
+        {
+            Obs_Report report(false);
+            for (std::size_t i = 0; i < n_tasks; i++)
+                {
+                    task(i, report);
+                }
+            return;
+        }
+
+    std::vector<std::unique_ptr<Obs_Report>> reports(n_tasks);
+    std::vector<std::exception_ptr> errors(n_tasks);
+    std::vector<bool> done(n_tasks, false);
+    std::atomic<std::size_t> next_task{0};
+    std::mutex mtx;
+    std::condition_variable cv;
+
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < n_threads; t++)
+        {
+            workers.emplace_back([&]() {
+                std::size_t i;
+                while ((i = next_task++) < n_tasks)
+                    {
+                        auto report = std::make_unique<Obs_Report>(true);
+                        std::exception_ptr error;
+                        try
+                            {
+                                task(i, *report);
+                            }
+                        catch (...)
+                            {
+                                error = std::current_exception();
+                            }
+                        std::lock_guard<std::mutex> lock(mtx);
+                        reports[i] = std::move(report);
+                        errors[i] = error;
+                        done[i] = true;
+                        cv.notify_all();
+                    }
+            });
+        }
+
+    std::exception_ptr error;
+    for (std::size_t i = 0; i < n_tasks and !error; i++)
+        {
+            std::unique_ptr<Obs_Report> report;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]() { return done[i]; });
+                report = std::move(reports[i]);
+                error = errors[i];
+            }
+            report->replay();
+        }
+    if (error)
+        {
+            next_task = n_tasks;  // do not start the remaining tasks
+        }
+    for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    if (error)
+        {
+            std::rethrow_exception(error);
+        }
+}
+
+
+/*
+ * Builds the observation matrices (time, pseudorange, Doppler, carrier phase)
+ * once all the epochs are read, instead of growing them epoch by epoch
+ */
+std::map<int, arma::mat> obs_matrices(std::map<int, std::vector<std::array<double, 4>>>& obs_rows)
 {
     std::map<int, arma::mat> obs_map;
+    for (auto& sat_rows : obs_rows)
+        {
+            arma::mat& obs_mat = obs_map[sat_rows.first];
+            obs_mat.set_size(sat_rows.second.size(), 4);
+            for (std::size_t r = 0; r < sat_rows.second.size(); r++)
+                {
+                    for (std::size_t c = 0; c < 4; c++)
+                        {
+                            obs_mat.at(r, c) = sat_rows.second[r][c];
+                        }
+                }
+            std::vector<std::array<double, 4>>().swap(sat_rows.second);
+        }
+    return obs_map;
+}
+
+
+std::map<int, arma::mat> ReadRinexObs(const std::string& rinex_file, char system, const std::string& signal)
+{
+    std::map<int, std::vector<std::array<double, 4>>> obs_rows;
     if (not file_exist(rinex_file.c_str()))
         {
             std::cout << "Warning: RINEX Obs file " << rinex_file << " does not exist\n";
-            return obs_map;
+            return {};
+        }
+
+    // RINEX codes of the pseudorange, Doppler and carrier phase of the requested signal
+    std::array<std::string, 3> obs_codes;
+    if (strcmp("1C\0", signal.c_str()) == 0)
+        {
+            obs_codes = {"C1C", "D1C", "L1C"};  // L1 C/A pseudorange, Carrier Doppler and Carrier Phase
+        }
+    else if (strcmp("1B\0", signal.c_str()) == 0)
+        {
+            obs_codes = {"C1B", "D1B", "L1B"};
+        }
+    else if (strcmp("2S\0", signal.c_str()) == 0)  // L2M
+        {
+            obs_codes = {"C2S", "D2S", "L2S"};
+        }
+    else if (strcmp("L5\0", signal.c_str()) == 0)
+        {
+            obs_codes = {"C5I", "D5I", "L5I"};
         }
+    else if (strcmp("5X\0", signal.c_str()) == 0)  // Simulator gives RINEX with E5a+E5b. Doppler and accumulated Carrier phase WILL differ
+        {
+            obs_codes = {"C8I", "D8I", "L8I"};
+        }
+
     // Open and read _baseerence RINEX observables file
     try
         {
@@ -174,73 +362,21 @@ std::map<int, arma::mat> ReadRinexObs(const std::string& rinex_file, char system
 
                             if (pointer != r_base_data.obs.end())
                                 {
-                                    // insert next column
-                                    try
-                                        {
-                                            obs_map.at(prn.id);
-                                        }
-                                    catch (const std::out_of_range& oor)
-                                        {
-                                            obs_map[prn.id] = arma::mat();
-                                        }
-
-                                    arma::mat& obs_mat = obs_map[prn.id];
-                                    obs_mat.insert_rows(obs_mat.n_rows, arma::zeros<arma::mat>(1, 4));
+                                    // insert next row
+                                    std::vector<std::array<double, 4>>& sat_rows = obs_rows[prn.id];
+                                    sat_rows.emplace_back();
+                                    std::array<double, 4>& row = sat_rows.back();
 
-                                    if (strcmp("1C\0", signal.c_str()) == 0)
+                                    if (obs_codes[0].empty())
                                         {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C1C", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;  // C1C P1 (psudorange L1)
-                                            dataobj = r_base_data.getObs(prn, "D1C", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;  // D1C Carrier Doppler
-                                            dataobj = r_base_data.getObs(prn, "L1C", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;  // L1C Carrier Phase
-                                        }
-                                    else if (strcmp("1B\0", signal.c_str()) == 0)
-                                        {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C1B", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "D1B", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "L1B", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else if (strcmp("2S\0", signal.c_str()) == 0)  // L2M
-                                        {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C2S", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "D2S", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "L2S", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else if (strcmp("L5\0", signal.c_str()) == 0)
-                                        {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C5I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "D5I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "L5I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
+                                            std::cout << "ReadRinexObs unknown signal requested: " << signal << '\n';
+                                            return obs_matrices(obs_rows);
                                         }
-                                    else if (strcmp("5X\0", signal.c_str()) == 0)  // Simulator gives RINEX with E5a+E5b. Doppler and accumulated Carrier phase WILL differ
+                                    row[0] = sow;
+                                    for (std::size_t n = 0; n < obs_codes.size(); n++)
                                         {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C8I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "D8I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "L8I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else
-                                        {
-                                            std::cout << "ReadRinexObs unknown signal requested: " << signal << '\n';
-                                            return obs_map;
+                                            dataobj = r_base_data.getObs(prn, obs_codes[n], r_base_header);
+                                            row[n + 1] = dataobj.data;
                                         }
                                 }
                         }
@@ -249,19 +385,20 @@ std::map<int, arma::mat> ReadRinexObs(const std::string& rinex_file, char system
     catch (const gnsstk::FFStreamError& e)
         {
             std::cout << e;
-            return obs_map;
+            return obs_matrices(obs_rows);
         }
     catch (const gnsstk::Exception& e)
         {
             std::cout << e;
-            return obs_map;
+            return obs_matrices(obs_rows);
         }
     catch (const std::exception& e)
         {
             std::cout << "Exception: " << e.what();
             std::cout << "unknown error.  I don't feel so well...\n";
-            return obs_map;
+            return obs_matrices(obs_rows);
         }
+    std::map<int, arma::mat> obs_map = obs_matrices(obs_rows);
     if (obs_map.empty())
         {
             std::cout << "Warning: file "
@@ -340,13 +477,41 @@ bool save_mat_x(std::vector<double>* x, std::string filename)
 }
 
 
+/*
+ * Saves the pseudorange, carrier phase and Doppler of each satellite in .mat
+ * files, each satellite in a task of run_in_order()
+ */
+void save_raw_obs(const std::map<int, arma::mat>& obs, const std::string& prefix)
+{
+    std::vector<std::map<int, arma::mat>::const_iterator> sats;
+    for (auto it = obs.cbegin(); it != obs.cend(); ++it)
+        {
+            sats.push_back(it);
+        }
+    run_in_order(sats.size(), [&](std::size_t i, Obs_Report& /* report */) {
+        const int sat_id = sats[i]->first;
+        const arma::mat& obs_mat = sats[i]->second;
+        std::vector<double> tmp_time_vec(obs_mat.colptr(0), obs_mat.colptr(0) + obs_mat.n_rows);
+        std::vector<double> tmp_vector(obs_mat.colptr(2), obs_mat.colptr(2) + obs_mat.n_rows);
+        save_mat_xy(tmp_time_vec, tmp_vector, prefix + "_doppler_sat" + std::to_string(sat_id));
+
+        std::vector<double> tmp_vector2(obs_mat.colptr(3), obs_mat.colptr(3) + obs_mat.n_rows);
+        save_mat_xy(tmp_time_vec, tmp_vector2, prefix + "_carrier_phase_sat" + std::to_string(sat_id));
+
+        std::vector<double> tmp_vector3(obs_mat.colptr(1), obs_mat.colptr(1) + obs_mat.n_rows);
+        save_mat_xy(tmp_time_vec, tmp_vector3, prefix + "_pseudorange_sat" + std::to_string(sat_id));
+    });
+}
+
+
 void carrier_phase_double_diff(
     arma::mat& true_ch0,
     arma::mat& true_ch1,
     arma::mat& measured_ch0,
     arma::mat& measured_ch1,
-    const std::string& data_title, double common_rx_clock_error_s)
+    const std::string& data_title, double common_rx_clock_error_s, Obs_Report& report)
 {
+    std::ostream& out = report.out();
     // 1. True value interpolation to match the measurement times
     arma::vec measurement_time = measured_ch0.col(0);
 
@@ -413,41 +578,43 @@ void carrier_phase_double_diff(
             double min_error = arma::min(err);
 
             // 5. report
-            std::streamsize ss = std::cout.precision();
-            std::cout << std::setprecision(10) << data_title << "Double diff Carrier Phase RMSE = "
-                      << rmse << ", mean = " << error_mean
-                      << ", stdev = " << sqrt(error_var)
-                      << " (max,min) = " << max_error
-                      << "," << min_error
-                      << " [Cycles]\n";
-            std::cout.precision(ss);
+            std::streamsize ss = out.precision();
+            out << std::setprecision(10) << data_title << "Double diff Carrier Phase RMSE = "
+                << rmse << ", mean = " << error_mean
+                << ", stdev = " << sqrt(error_var)
+                << " (max,min) = " << max_error
+                << "," << min_error
+                << " [Cycles]\n";
+            out.precision(ss);
 
             // plots
             if (FLAGS_show_plots)
                 {
-                    Gnuplot g3("linespoints");
-                    g3.set_title(data_title + "Double diff Carrier Phase error [Cycles]");
-                    g3.set_grid();
-                    g3.set_xlabel("Time [s]");
-                    g3.set_ylabel("Double diff Carrier Phase error [Cycles]");
-                    // conversion between arma::vec and std:vector
-                    std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
-                    g3.cmd("set key box opaque");
-                    g3.plot_xy(time_vector, range_error_m,
-                        "Double diff Carrier Phase error");
-                    g3.set_legend();
-                    std::string data_title_aux = data_title;
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
-                    g3.savetops(data_title_aux + "double_diff_carrier_phase_error");
-
-                    g3.showonscreen();  // window output
+                    report.plot([data_title, time_vector, err]() {
+                        Gnuplot g3("linespoints");
+                        g3.set_title(data_title + "Double diff Carrier Phase error [Cycles]");
+                        g3.set_grid();
+                        g3.set_xlabel("Time [s]");
+                        g3.set_ylabel("Double diff Carrier Phase error [Cycles]");
+                        // conversion between arma::vec and std:vector
+                        std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
+                        g3.cmd("set key box opaque");
+                        g3.plot_xy(time_vector, range_error_m,
+                            "Double diff Carrier Phase error");
+                        g3.set_legend();
+                        std::string data_title_aux = data_title;
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
+                        g3.savetops(data_title_aux + "double_diff_carrier_phase_error");
+
+                        g3.showonscreen();  // window output
+                    });
                 }
         }
     else
         {
-            std::cout << "No valid data\n";
+            out << "No valid data\n";
         }
 }
 
@@ -455,8 +622,9 @@ void carrier_phase_double_diff(
 void carrier_phase_single_diff(
     arma::mat& measured_ch0,
     arma::mat& measured_ch1,
-    const std::string& data_title)
+    const std::string& data_title, Obs_Report& report)
 {
+    std::ostream& out = report.out();
     // 1. True value interpolation to match the measurement times
     arma::vec measurement_time = measured_ch0.col(0);
 
@@ -497,41 +665,43 @@ void carrier_phase_single_diff(
             double min_error = arma::min(err);
 
             // 5. report
-            std::streamsize ss = std::cout.precision();
-            std::cout << std::setprecision(10) << data_title << "Single diff Carrier Phase RMSE = "
-                      << rmse << ", mean = " << error_mean
-                      << ", stdev = " << sqrt(error_var)
-                      << " (max,min) = " << max_error
-                      << "," << min_error
-                      << " [Cycles]\n";
-            std::cout.precision(ss);
+            std::streamsize ss = out.precision();
+            out << std::setprecision(10) << data_title << "Single diff Carrier Phase RMSE = "
+                << rmse << ", mean = " << error_mean
+                << ", stdev = " << sqrt(error_var)
+                << " (max,min) = " << max_error
+                << "," << min_error
+                << " [Cycles]\n";
+            out.precision(ss);
 
             // plots
             if (FLAGS_show_plots)
                 {
-                    Gnuplot g3("linespoints");
-                    g3.set_title(data_title + "Single diff Carrier Phase error [Cycles]");
-                    g3.set_grid();
-                    g3.set_xlabel("Time [s]");
-                    g3.set_ylabel("Single diff Carrier Phase error [Cycles]");
-                    // conversion between arma::vec and std:vector
-                    std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
-                    g3.cmd("set key box opaque");
-                    g3.plot_xy(time_vector, range_error_m,
-                        "Single diff Carrier Phase error");
-                    g3.set_legend();
-                    std::string data_title_aux = data_title;
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
-                    g3.savetops(data_title_aux + "single_diff_carrier_phase_error");
-
-                    g3.showonscreen();  // window output
+                    report.plot([data_title, time_vector, err]() {
+                        Gnuplot g3("linespoints");
+                        g3.set_title(data_title + "Single diff Carrier Phase error [Cycles]");
+                        g3.set_grid();
+                        g3.set_xlabel("Time [s]");
+                        g3.set_ylabel("Single diff Carrier Phase error [Cycles]");
+                        // conversion between arma::vec and std:vector
+                        std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
+                        g3.cmd("set key box opaque");
+                        g3.plot_xy(time_vector, range_error_m,
+                            "Single diff Carrier Phase error");
+                        g3.set_legend();
+                        std::string data_title_aux = data_title;
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
+                        g3.savetops(data_title_aux + "single_diff_carrier_phase_error");
+
+                        g3.showonscreen();  // window output
+                    });
                 }
         }
     else
         {
-            std::cout << "No valid data\n";
+            out << "No valid data\n";
         }
 }
 
@@ -541,8 +711,9 @@ void carrier_doppler_double_diff(
     arma::mat& true_ch1,
     arma::mat& measured_ch0,
     arma::mat& measured_ch1,
-    const std::string& data_title, double common_rx_clock_error_s)
+    const std::string& data_title, double common_rx_clock_error_s, Obs_Report& report)
 {
+    std::ostream& out = report.out();
     // 1. True value interpolation to match the measurement times
     arma::vec measurement_time = measured_ch0.col(0);
 
@@ -604,41 +775,43 @@ void carrier_doppler_double_diff(
             double min_error = arma::min(err);
 
             // 5. report
-            std::streamsize ss = std::cout.precision();
-            std::cout << std::setprecision(10) << data_title << "Double diff Carrier Doppler RMSE = "
-                      << rmse << ", mean = " << error_mean
-                      << ", stdev = " << sqrt(error_var)
-                      << " (max,min) = " << max_error
-                      << "," << min_error
-                      << " [Hz]\n";
-            std::cout.precision(ss);
+            std::streamsize ss = out.precision();
+            out << std::setprecision(10) << data_title << "Double diff Carrier Doppler RMSE = "
+                << rmse << ", mean = " << error_mean
+                << ", stdev = " << sqrt(error_var)
+                << " (max,min) = " << max_error
+                << "," << min_error
+                << " [Hz]\n";
+            out.precision(ss);
 
             // plots
             if (FLAGS_show_plots)
                 {
-                    Gnuplot g3("linespoints");
-                    g3.set_title(data_title + "Double diff Carrier Doppler error [Hz]");
-                    g3.set_grid();
-                    g3.set_xlabel("Time [s]");
-                    g3.set_ylabel("Double diff Carrier Doppler error [Hz]");
-                    // conversion between arma::vec and std:vector
-                    std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
-                    g3.cmd("set key box opaque");
-                    g3.plot_xy(time_vector, range_error_m,
-                        "Double diff Carrier Doppler error");
-                    g3.set_legend();
-                    std::string data_title_aux = data_title;
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
-                    g3.savetops(data_title_aux + "double_diff_carrier_doppler_error");
-
-                    g3.showonscreen();  // window output
+                    report.plot([data_title, time_vector, err]() {
+                        Gnuplot g3("linespoints");
+                        g3.set_title(data_title + "Double diff Carrier Doppler error [Hz]");
+                        g3.set_grid();
+                        g3.set_xlabel("Time [s]");
+                        g3.set_ylabel("Double diff Carrier Doppler error [Hz]");
+                        // conversion between arma::vec and std:vector
+                        std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
+                        g3.cmd("set key box opaque");
+                        g3.plot_xy(time_vector, range_error_m,
+                            "Double diff Carrier Doppler error");
+                        g3.set_legend();
+                        std::string data_title_aux = data_title;
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
+                        g3.savetops(data_title_aux + "double_diff_carrier_doppler_error");
+
+                        g3.showonscreen();  // window output
+                    });
                 }
         }
     else
         {
-            std::cout << "No valid data\n";
+            out << "No valid data\n";
         }
 }
 
@@ -646,8 +819,9 @@ void carrier_doppler_double_diff(
 void carrier_doppler_single_diff(
     arma::mat& measured_ch0,
     arma::mat& measured_ch1,
-    const std::string& data_title)
+    const std::string& data_title, Obs_Report& report)
 {
+    std::ostream& out = report.out();
     // 1. True value interpolation to match the measurement times
     arma::vec measurement_time = measured_ch0.col(0);
 
@@ -687,41 +861,43 @@ void carrier_doppler_single_diff(
             double min_error = arma::min(err);
 
             // 5. report
-            std::streamsize ss = std::cout.precision();
-            std::cout << std::setprecision(10) << data_title << "Single diff Carrier Doppler RMSE = "
-                      << rmse << ", mean = " << error_mean
-                      << ", stdev = " << sqrt(error_var)
-                      << " (max,min) = " << max_error
-                      << "," << min_error
-                      << " [Hz]\n";
-            std::cout.precision(ss);
+            std::streamsize ss = out.precision();
+            out << std::setprecision(10) << data_title << "Single diff Carrier Doppler RMSE = "
+                << rmse << ", mean = " << error_mean
+                << ", stdev = " << sqrt(error_var)
+                << " (max,min) = " << max_error
+                << "," << min_error
+                << " [Hz]\n";
+            out.precision(ss);
 
             // plots
             if (FLAGS_show_plots)
                 {
-                    Gnuplot g3("linespoints");
-                    g3.set_title(data_title + "Single diff Carrier Doppler error [Hz]");
-                    g3.set_grid();
-                    g3.set_xlabel("Time [s]");
-                    g3.set_ylabel("Single diff Carrier Doppler error [Hz]");
-                    // conversion between arma::vec and std:vector
-                    std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
-                    g3.cmd("set key box opaque");
-                    g3.plot_xy(time_vector, range_error_m,
-                        "Single diff Carrier Doppler error");
-                    g3.set_legend();
-                    std::string data_title_aux = data_title;
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
-                    g3.savetops(data_title_aux + "single_diff_carrier_doppler_error");
-
-                    g3.showonscreen();  // window output
+                    report.plot([data_title, time_vector, err]() {
+                        Gnuplot g3("linespoints");
+                        g3.set_title(data_title + "Single diff Carrier Doppler error [Hz]");
+                        g3.set_grid();
+                        g3.set_xlabel("Time [s]");
+                        g3.set_ylabel("Single diff Carrier Doppler error [Hz]");
+                        // conversion between arma::vec and std:vector
+                        std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
+                        g3.cmd("set key box opaque");
+                        g3.plot_xy(time_vector, range_error_m,
+                            "Single diff Carrier Doppler error");
+                        g3.set_legend();
+                        std::string data_title_aux = data_title;
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
+                        g3.savetops(data_title_aux + "single_diff_carrier_doppler_error");
+
+                        g3.showonscreen();  // window output
+                    });
                 }
         }
     else
         {
-            std::cout << "No valid data\n";
+            out << "No valid data\n";
         }
 }
 
@@ -731,8 +907,9 @@ void code_pseudorange_double_diff(
     arma::mat& true_ch1,
     arma::mat& measured_ch0,
     arma::mat& measured_ch1,
-    const std::string& data_title, double common_rx_clock_error_s)
+    const std::string& data_title, double common_rx_clock_error_s, Obs_Report& report)
 {
+    std::ostream& out = report.out();
     // 1. True value interpolation to match the measurement times
     arma::vec measurement_time = measured_ch0.col(0);
     arma::vec true_ch0_obs_interp;
@@ -795,41 +972,43 @@ void code_pseudorange_double_diff(
             double min_error = arma::min(err);
 
             // 5. report
-            std::streamsize ss = std::cout.precision();
-            std::cout << std::setprecision(10) << data_title << "Double diff Pseudorange RMSE = "
-                      << rmse << ", mean = " << error_mean
-                      << ", stdev = " << sqrt(error_var)
-                      << " (max,min) = " << max_error
-                      << "," << min_error
-                      << " [meters]\n";
-            std::cout.precision(ss);
+            std::streamsize ss = out.precision();
+            out << std::setprecision(10) << data_title << "Double diff Pseudorange RMSE = "
+                << rmse << ", mean = " << error_mean
+                << ", stdev = " << sqrt(error_var)
+                << " (max,min) = " << max_error
+                << "," << min_error
+                << " [meters]\n";
+            out.precision(ss);
 
             // plots
             if (FLAGS_show_plots)
                 {
-                    Gnuplot g3("linespoints");
-                    g3.set_title(data_title + "Double diff Pseudorange error [m]");
-                    g3.set_grid();
-                    g3.set_xlabel("Time [s]");
-                    g3.set_ylabel("Double diff Pseudorange error [m]");
-                    // conversion between arma::vec and std:vector
-                    std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
-                    g3.cmd("set key box opaque");
-                    g3.plot_xy(time_vector, range_error_m,
-                        "Double diff Pseudorange error");
-                    g3.set_legend();
-                    std::string data_title_aux = data_title;
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
-                    g3.savetops(data_title_aux + "double_diff_pseudorange_error");
-
-                    g3.showonscreen();  // window output
+                    report.plot([data_title, time_vector, err]() {
+                        Gnuplot g3("linespoints");
+                        g3.set_title(data_title + "Double diff Pseudorange error [m]");
+                        g3.set_grid();
+                        g3.set_xlabel("Time [s]");
+                        g3.set_ylabel("Double diff Pseudorange error [m]");
+                        // conversion between arma::vec and std:vector
+                        std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
+                        g3.cmd("set key box opaque");
+                        g3.plot_xy(time_vector, range_error_m,
+                            "Double diff Pseudorange error");
+                        g3.set_legend();
+                        std::string data_title_aux = data_title;
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
+                        g3.savetops(data_title_aux + "double_diff_pseudorange_error");
+
+                        g3.showonscreen();  // window output
+                    });
                 }
         }
     else
         {
-            std::cout << "No valid data\n";
+            out << "No valid data\n";
         }
 }
 
@@ -837,8 +1016,9 @@ void code_pseudorange_double_diff(
 void code_pseudorange_single_diff(
     arma::mat& measured_ch0,
     arma::mat& measured_ch1,
-    const std::string& data_title)
+    const std::string& data_title, Obs_Report& report)
 {
+    std::ostream& out = report.out();
     // 1. True value interpolation to match the measurement times
     arma::vec measurement_time = measured_ch0.col(0);
 
@@ -880,49 +1060,52 @@ void code_pseudorange_single_diff(
             double min_error = arma::min(err);
 
             // 5. report
-            std::streamsize ss = std::cout.precision();
-            std::cout << std::setprecision(10) << data_title << "Single diff Pseudorange RMSE = "
-                      << rmse << ", mean = " << error_mean
-                      << ", stdev = " << sqrt(error_var)
-                      << " (max,min) = " << max_error
-                      << "," << min_error
-                      << " [meters]\n";
-            std::cout.precision(ss);
+            std::streamsize ss = out.precision();
+            out << std::setprecision(10) << data_title << "Single diff Pseudorange RMSE = "
+                << rmse << ", mean = " << error_mean
+                << ", stdev = " << sqrt(error_var)
+                << " (max,min) = " << max_error
+                << "," << min_error
+                << " [meters]\n";
+            out.precision(ss);
 
             // plots
             if (FLAGS_show_plots)
                 {
-                    Gnuplot g3("linespoints");
-                    g3.set_title(data_title + "Single diff Pseudorange error [m]");
-                    g3.set_grid();
-                    g3.set_xlabel("Time [s]");
-                    g3.set_ylabel("Single diff Pseudorange error [m]");
-                    // conversion between arma::vec and std:vector
-                    std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
-                    g3.cmd("set key box opaque");
-                    g3.plot_xy(time_vector, range_error_m,
-                        "Single diff Pseudorange error");
-                    g3.set_legend();
-                    std::string data_title_aux = data_title;
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
-                    g3.savetops(data_title_aux + "single_diff_pseudorange_error");
-
-                    g3.showonscreen();  // window output
+                    report.plot([data_title, time_vector, err]() {
+                        Gnuplot g3("linespoints");
+                        g3.set_title(data_title + "Single diff Pseudorange error [m]");
+                        g3.set_grid();
+                        g3.set_xlabel("Time [s]");
+                        g3.set_ylabel("Single diff Pseudorange error [m]");
+                        // conversion between arma::vec and std:vector
+                        std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
+                        g3.cmd("set key box opaque");
+                        g3.plot_xy(time_vector, range_error_m,
+                            "Single diff Pseudorange error");
+                        g3.set_legend();
+                        std::string data_title_aux = data_title;
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
+                        g3.savetops(data_title_aux + "single_diff_pseudorange_error");
+
+                        g3.showonscreen();  // window output
+                    });
                 }
         }
     else
         {
-            std::cout << "No valid data\n";
+            out << "No valid data\n";
         }
 }
 
 
 void coderate_phaserate_consistence(
     arma::mat& measured_ch0,
-    const std::string& data_title)
+    const std::string& data_title, Obs_Report& report)
 {
+    std::ostream& out = report.out();
     arma::vec measurement_time = measured_ch0.col(0);
     arma::vec delta_time = measurement_time.subvec(1, measurement_time.n_elem - 1) - measurement_time.subvec(0, measurement_time.n_elem - 2);
 
@@ -939,13 +1122,13 @@ void coderate_phaserate_consistence(
     arma::uvec idx = arma::find(prange < mincodeval);
     if (idx.n_elem > 0)
         {
-            std::cout << "Warning: Pseudorange measurement is less than minimum acceptable value of " << mincodeval << " meters.\n";
+            out << "Warning: Pseudorange measurement is less than minimum acceptable value of " << mincodeval << " meters.\n";
         }
 
     idx = arma::find(prange > maxcodeval);
     if (idx.n_elem > 0)
         {
-            std::cout << "Warning: Pseudorange measurement is above than maximum acceptable value of " << maxcodeval << " meters.\n";
+            out << "Warning: Pseudorange measurement is above than maximum acceptable value of " << maxcodeval << " meters.\n";
         }
 
     // 2) It checks that the pseduorange rate is within a certain threshold
@@ -957,7 +1140,7 @@ void coderate_phaserate_consistence(
 
     if (NaN_in_measured_data.n_elem > 0)
         {
-            std::cout << "Warning: Pseudorange rate have NaN values. \n";
+            out << "Warning: Pseudorange rate have NaN values. \n";
         }
 
     double mincoderate = 0.001;
@@ -966,7 +1149,7 @@ void coderate_phaserate_consistence(
     idx = arma::find(coderate > maxcoderate and coderate < mincoderate);
     if (idx.n_elem > 0)
         {
-            std::cout << "Warning: bad code rate \n";
+            out << "Warning: bad code rate \n";
         }
 
     // 3) It checks that the phase rate is within a certain threshold
@@ -977,7 +1160,7 @@ void coderate_phaserate_consistence(
 
     if (NaN_in_measured_data.n_elem > 0)
         {
-            std::cout << "Warning: Carrier phase rate have NaN values. \n";
+            out << "Warning: Carrier phase rate have NaN values. \n";
         }
 
     double minphaserate = 0.001;
@@ -986,7 +1169,7 @@ void coderate_phaserate_consistence(
     idx = arma::find(phaserate > maxphaserate and phaserate < minphaserate);
     if (idx.n_elem > 0)
         {
-            std::cout << "Warning: bad phase rate \n";
+            out << "Warning: bad phase rate \n";
         }
 
     // 4) It checks the difference between code and phase rates
@@ -1007,7 +1190,7 @@ void coderate_phaserate_consistence(
     idx = arma::find(ratediff > maxratediff);
     if (idx.n_elem > 0)
         {
-            std::cout << "Warning: bad code and phase rate difference \n";
+            out << "Warning: bad code and phase rate difference \n";
         }
 
     std::vector<double>
@@ -1029,36 +1212,38 @@ void coderate_phaserate_consistence(
     double min_error = arma::min(err);
 
     // 5. report
-    std::streamsize ss = std::cout.precision();
-    std::cout << std::setprecision(10) << data_title << " RMSE = "
-              << rmse << ", mean = " << error_mean
-              << ", stdev = " << sqrt(error_var)
-              << " (max,min) = " << max_error
-              << "," << min_error
-              << " [m/s]\n";
-    std::cout.precision(ss);
+    std::streamsize ss = out.precision();
+    out << std::setprecision(10) << data_title << " RMSE = "
+        << rmse << ", mean = " << error_mean
+        << ", stdev = " << sqrt(error_var)
+        << " (max,min) = " << max_error
+        << "," << min_error
+        << " [m/s]\n";
+    out.precision(ss);
 
     // plots
     if (FLAGS_show_plots)
         {
-            Gnuplot g3("linespoints");
-            g3.set_title(data_title + "Code rate - phase rate [m/s]");
-            g3.set_grid();
-            g3.set_xlabel("Time [s]");
-            g3.set_ylabel("Code rate - phase rate [m/s]");
-            // conversion between arma::vec and std:vector
-            std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
-            g3.cmd("set key box opaque");
-            g3.plot_xy(time_vector, range_error_m,
-                "Code rate - phase rate");
-            g3.set_legend();
-            std::string data_title_aux = data_title;
-            std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
-            std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
-            std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
-            g3.savetops(data_title_aux + "Code_rate_minus_phase_rate");
-
-            g3.showonscreen();  // window output
+            report.plot([data_title, time_vector, err]() {
+                Gnuplot g3("linespoints");
+                g3.set_title(data_title + "Code rate - phase rate [m/s]");
+                g3.set_grid();
+                g3.set_xlabel("Time [s]");
+                g3.set_ylabel("Code rate - phase rate [m/s]");
+                // conversion between arma::vec and std:vector
+                std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
+                g3.cmd("set key box opaque");
+                g3.plot_xy(time_vector, range_error_m,
+                    "Code rate - phase rate");
+                g3.set_legend();
+                std::string data_title_aux = data_title;
+                std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
+                std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
+                std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
+                g3.savetops(data_title_aux + "Code_rate_minus_phase_rate");
+
+                g3.showonscreen();  // window output
+            });
         }
 }
 
@@ -1066,8 +1251,9 @@ void coderate_phaserate_consistence(
 void code_phase_diff(
     arma::mat& measured_ch0,
     arma::mat& measured_ch1,
-    const std::string& data_title)
+    const std::string& data_title, Obs_Report& report)
 {
+    std::ostream& out = report.out();
     // 1. True value interpolation to match the measurement times
     arma::vec measurement_time = measured_ch0.col(0);
 
@@ -1113,41 +1299,43 @@ void code_phase_diff(
             double min_error = arma::min(err);
 
             // 5. report
-            std::streamsize ss = std::cout.precision();
-            std::cout << std::setprecision(10) << data_title << " RMSE = "
-                      << rmse << ", mean = " << error_mean
-                      << ", stdev = " << sqrt(error_var)
-                      << " (max,min) = " << max_error
-                      << "," << min_error
-                      << " [meters]\n";
-            std::cout.precision(ss);
+            std::streamsize ss = out.precision();
+            out << std::setprecision(10) << data_title << " RMSE = "
+                << rmse << ", mean = " << error_mean
+                << ", stdev = " << sqrt(error_var)
+                << " (max,min) = " << max_error
+                << "," << min_error
+                << " [meters]\n";
+            out.precision(ss);
 
             // plots
             if (FLAGS_show_plots)
                 {
-                    Gnuplot g3("linespoints");
-                    g3.set_title(data_title + "Code range - Carrier phase range [m]");
-                    g3.set_grid();
-                    g3.set_xlabel("Time [s]");
-                    g3.set_ylabel("Code range - Carrier phase range [m]");
-                    // conversion between arma::vec and std:vector
-                    std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
-                    g3.cmd("set key box opaque");
-                    g3.plot_xy(time_vector, range_error_m,
-                        "Code range - Carrier phase range");
-                    g3.set_legend();
-                    std::string data_title_aux = data_title;
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
-                    std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
-                    g3.savetops(data_title_aux + "Code_range_Carrier_phase_range");
-
-                    g3.showonscreen();  // window output
+                    report.plot([data_title, time_vector, err]() {
+                        Gnuplot g3("linespoints");
+                        g3.set_title(data_title + "Code range - Carrier phase range [m]");
+                        g3.set_grid();
+                        g3.set_xlabel("Time [s]");
+                        g3.set_ylabel("Code range - Carrier phase range [m]");
+                        // conversion between arma::vec and std:vector
+                        std::vector<double> range_error_m(err.colptr(0), err.colptr(0) + err.n_rows);
+                        g3.cmd("set key box opaque");
+                        g3.plot_xy(time_vector, range_error_m,
+                            "Code range - Carrier phase range");
+                        g3.set_legend();
+                        std::string data_title_aux = data_title;
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ' ', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), '(', '_');
+                        std::replace(data_title_aux.begin(), data_title_aux.end(), ')', '_');
+                        g3.savetops(data_title_aux + "Code_range_Carrier_phase_range");
+
+                        g3.showonscreen();  // window output
+                    });
                 }
         }
     else
         {
-            std::cout << "No valid data\n";
+            out << "No valid data\n";
         }
 }
 
@@ -1432,6 +1620,7 @@ void RINEX_doublediff_dupli_sat()
         }
     else
         {
+            Obs_Report report(false);
             for (unsigned int n = 0; n < prn_pairs.size(); n = n + 2)
                 {
                     // compute double differences
@@ -1442,15 +1631,15 @@ void RINEX_doublediff_dupli_sat()
 
                             code_pseudorange_single_diff(rover_obs.at(prn_pairs.at(n)),
                                 rover_obs.at(prn_pairs.at(n + 1)),
-                                "SD = OBS(SV" + std::to_string(prn_pairs.at(n)) + ") - OBS(SV" + std::to_string(prn_pairs.at(n + 1)) + ") ");
+                                "SD = OBS(SV" + std::to_string(prn_pairs.at(n)) + ") - OBS(SV" + std::to_string(prn_pairs.at(n + 1)) + ") ", report);
 
                             carrier_phase_single_diff(rover_obs.at(prn_pairs.at(n)),
                                 rover_obs.at(prn_pairs.at(n + 1)),
-                                "SD = OBS(SV" + std::to_string(prn_pairs.at(n)) + ") - OBS(SV" + std::to_string(prn_pairs.at(n + 1)) + ") ");
+                                "SD = OBS(SV" + std::to_string(prn_pairs.at(n)) + ") - OBS(SV" + std::to_string(prn_pairs.at(n + 1)) + ") ", report);
 
                             carrier_doppler_single_diff(rover_obs.at(prn_pairs.at(n)),
                                 rover_obs.at(prn_pairs.at(n + 1)),
-                                "SD = OBS(SV" + std::to_string(prn_pairs.at(n)) + ") - OBS(SV" + std::to_string(prn_pairs.at(n + 1)) + ") ");
+                                "SD = OBS(SV" + std::to_string(prn_pairs.at(n)) + ") - OBS(SV" + std::to_string(prn_pairs.at(n + 1)) + ") ", report);
                         }
                     else
                         {
@@ -1463,9 +1652,10 @@ void RINEX_doublediff_dupli_sat()
 
 void RINEX_doublediff(bool remove_rx_clock_error)
 {
-    // read rinex base observations
+    // read rinex base and receiver-under-test (rover) observations. GNSSTk
+    // streams are not known to be thread-safe, so the files are read one
+    // after the other
     std::map<int, arma::mat> base_obs = ReadRinexObs(FLAGS_base_rinex_obs, FLAGS_system.c_str()[0], FLAGS_signal);
-    // read rinex receiver-under-test (rover) observations
     std::map<int, arma::mat> rover_obs = ReadRinexObs(FLAGS_rover_rinex_obs, FLAGS_system.c_str()[0], FLAGS_signal);
 
     if (base_obs.empty() or rover_obs.empty())
@@ -1556,42 +1746,8 @@ void RINEX_doublediff(bool remove_rx_clock_error)
 
     // Save observations in .mat files
     std::cout << "Saving RAW observables inputs to .mat files...\n";
-    for (auto& base_ob : base_obs)
-        {
-            // std::cout << it->first << " => " << it->second.n_rows << '\n';
-            // std::cout << it->first << " has NaN values: " << it->second.has_nan() << '\n';
-            std::vector<double> tmp_time_vec(base_ob.second.col(0).colptr(0),
-                base_ob.second.col(0).colptr(0) + base_ob.second.n_rows);
-            std::vector<double> tmp_vector(base_ob.second.col(2).colptr(0),
-                base_ob.second.col(2).colptr(0) + base_ob.second.n_rows);
-            save_mat_xy(tmp_time_vec, tmp_vector, std::string("base_doppler_sat" + std::to_string(base_ob.first)));
-
-            std::vector<double> tmp_vector2(base_ob.second.col(3).colptr(0),
-                base_ob.second.col(3).colptr(0) + base_ob.second.n_rows);
-            save_mat_xy(tmp_time_vec, tmp_vector2, std::string("base_carrier_phase_sat" + std::to_string(base_ob.first)));
-
-            std::vector<double> tmp_vector3(base_ob.second.col(1).colptr(0),
-                base_ob.second.col(1).colptr(0) + base_ob.second.n_rows);
-            save_mat_xy(tmp_time_vec, tmp_vector3, std::string("base_pseudorange_sat" + std::to_string(base_ob.first)));
-        }
-    for (auto& rover_ob : rover_obs)
-        {
-            // std::cout << it->first << " => " << it->second.n_rows << '\n';
-            // std::cout << it->first << " has NaN values: " << it->second.has_nan() << '\n';
-            std::vector<double> tmp_time_vec(rover_ob.second.col(0).colptr(0),
-                rover_ob.second.col(0).colptr(0) + rover_ob.second.n_rows);
-            std::vector<double> tmp_vector(rover_ob.second.col(2).colptr(0),
-                rover_ob.second.col(2).colptr(0) + rover_ob.second.n_rows);
-            save_mat_xy(tmp_time_vec, tmp_vector, std::string("measured_doppler_sat" + std::to_string(rover_ob.first)));
-
-            std::vector<double> tmp_vector2(rover_ob.second.col(3).colptr(0),
-                rover_ob.second.col(3).colptr(0) + rover_ob.second.n_rows);
-            save_mat_xy(tmp_time_vec, tmp_vector2, std::string("measured_carrier_phase_sat" + std::to_string(rover_ob.first)));
-
-            std::vector<double> tmp_vector3(rover_ob.second.col(1).colptr(0),
-                rover_ob.second.col(1).colptr(0) + rover_ob.second.n_rows);
-            save_mat_xy(tmp_time_vec, tmp_vector3, std::string("measured_pseudorange_sat" + std::to_string(rover_ob.first)));
-        }
+    save_raw_obs(base_obs, "base");
+    save_raw_obs(rover_obs, "measured");
 
     // select reference satellite
     std::set<int> PRN_set = available_gps_prn;
@@ -1613,36 +1769,41 @@ void RINEX_doublediff(bool remove_rx_clock_error)
     if (base_obs.find(reference_sat_id) != base_obs.end() and rover_obs.find(reference_sat_id) != rover_obs.end())
         {
             std::cout << "Using reference satellite SV " << reference_sat_id << " with minimum range of " << min_range << " [meters]\n";
+            std::vector<int> sat_ids;
             for (const auto& current_sat_id : PRN_set)
                 {
                     if (current_sat_id != reference_sat_id)
                         {
                             if (base_obs.find(current_sat_id) != base_obs.end() and rover_obs.find(current_sat_id) != rover_obs.end())
                                 {
-                                    std::cout << "Computing double difference observables for SV " << current_sat_id << '\n';
-                                    std::cout << "DD = (OBS_ROVER(SV" << current_sat_id << ") - OBS_ROVER(SV" << reference_sat_id << "))"
-                                              << " - (OBS_BASE(SV" << current_sat_id << ") - OBS_BASE(SV" << reference_sat_id << "))\n";
-
-                                    code_pseudorange_double_diff(base_obs.at(reference_sat_id),
-                                        base_obs.at(current_sat_id),
-                                        rover_obs.at(reference_sat_id),
-                                        rover_obs.at(current_sat_id),
-                                        "PRN " + std::to_string(current_sat_id) + " ", common_clock_error_s);
-
-                                    carrier_phase_double_diff(base_obs.at(reference_sat_id),
-                                        base_obs.at(current_sat_id),
-                                        rover_obs.at(reference_sat_id),
-                                        rover_obs.at(current_sat_id),
-                                        "PRN " + std::to_string(current_sat_id) + " ", common_clock_error_s);
-
-                                    carrier_doppler_double_diff(base_obs.at(reference_sat_id),
-                                        base_obs.at(current_sat_id),
-                                        rover_obs.at(reference_sat_id),
-                                        rover_obs.at(current_sat_id),
-                                        "PRN " + std::to_string(current_sat_id) + " ", common_clock_error_s);
+                                    sat_ids.push_back(current_sat_id);
                                 }
                         }
                 }
+            run_in_order(sat_ids.size(), [&](std::size_t i, Obs_Report& report) {
+                const int current_sat_id = sat_ids[i];
+                report.out() << "Computing double difference observables for SV " << current_sat_id << '\n';
+                report.out() << "DD = (OBS_ROVER(SV" << current_sat_id << ") - OBS_ROVER(SV" << reference_sat_id << "))"
+                             << " - (OBS_BASE(SV" << current_sat_id << ") - OBS_BASE(SV" << reference_sat_id << "))\n";
+
+                code_pseudorange_double_diff(base_obs.at(reference_sat_id),
+                    base_obs.at(current_sat_id),
+                    rover_obs.at(reference_sat_id),
+                    rover_obs.at(current_sat_id),
+                    "PRN " + std::to_string(current_sat_id) + " ", common_clock_error_s, report);
+
+                carrier_phase_double_diff(base_obs.at(reference_sat_id),
+                    base_obs.at(current_sat_id),
+                    rover_obs.at(reference_sat_id),
+                    rover_obs.at(current_sat_id),
+                    "PRN " + std::to_string(current_sat_id) + " ", common_clock_error_s, report);
+
+                carrier_doppler_double_diff(base_obs.at(reference_sat_id),
+                    base_obs.at(current_sat_id),
+                    rover_obs.at(reference_sat_id),
+                    rover_obs.at(current_sat_id),
+                    "PRN " + std::to_string(current_sat_id) + " ", common_clock_error_s, report);
+            });
         }
     else
         {
@@ -1690,37 +1851,24 @@ void RINEX_singlediff()
 
     // Save observations in .mat files
     std::cout << "Saving RAW observables inputs to .mat files...\n";
-
-    for (auto& rover_ob : rover_obs)
-        {
-            // std::cout << it->first << " => " << it->second.n_rows << '\n';
-            // std::cout << it->first << " has NaN values: " << it->second.has_nan() << '\n';
-            std::vector<double> tmp_time_vec(rover_ob.second.col(0).colptr(0),
-                rover_ob.second.col(0).colptr(0) + rover_ob.second.n_rows);
-            std::vector<double> tmp_vector(rover_ob.second.col(2).colptr(0),
-                rover_ob.second.col(2).colptr(0) + rover_ob.second.n_rows);
-            save_mat_xy(tmp_time_vec, tmp_vector, std::string("measured_doppler_sat" + std::to_string(rover_ob.first)));
-
-            std::vector<double> tmp_vector2(rover_ob.second.col(3).colptr(0),
-                rover_ob.second.col(3).colptr(0) + rover_ob.second.n_rows);
-            save_mat_xy(tmp_time_vec, tmp_vector2, std::string("measured_carrier_phase_sat" + std::to_string(rover_ob.first)));
-
-            std::vector<double> tmp_vector3(rover_ob.second.col(1).colptr(0),
-                rover_ob.second.col(1).colptr(0) + rover_ob.second.n_rows);
-            save_mat_xy(tmp_time_vec, tmp_vector3, std::string("measured_pseudorange_sat" + std::to_string(rover_ob.first)));
-        }
+    save_raw_obs(rover_obs, "measured");
 
     // compute single differences
     std::set<int> PRN_set = available_gps_prn;
     std::cout << "Computing Code Pseudorange rate vs. Carrier phase rate difference...\n";
+    std::vector<int> sat_ids;
     for (const auto& current_sat_id : PRN_set)
         {
             if (rover_obs.find(current_sat_id) != rover_obs.end())
                 {
-                    std::cout << "RateError = PR_rate(SV" << current_sat_id << ") - Phase_rate(SV" << current_sat_id << ")\n";
-                    coderate_phaserate_consistence(rover_obs.at(current_sat_id), "PRN " + std::to_string(current_sat_id) + " ");
+                    sat_ids.push_back(current_sat_id);
                 }
         }
+    run_in_order(sat_ids.size(), [&](std::size_t i, Obs_Report& report) {
+        const int current_sat_id = sat_ids[i];
+        report.out() << "RateError = PR_rate(SV" << current_sat_id << ") - Phase_rate(SV" << current_sat_id << ")\n";
+        coderate_phaserate_consistence(rover_obs.at(current_sat_id), "PRN " + std::to_string(current_sat_id) + " ", report);
+    });
 }
 
 
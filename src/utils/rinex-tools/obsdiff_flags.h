@@ -33,5 +33,6 @@ DEFINE_string(rover_rinex_obs, "base.obs", "Filename of test RINEX observation f
 DEFINE_string(system, "G", "GNSS satellite system: G for GPS, E for Galileo");
 DEFINE_string(signal, "1C", "GNSS signal: 1C for GPS L1 CA, 1B for Galileo E1");
 DEFINE_bool(remove_rx_clock_error, false, "Compute and remove the receivers clock error prior to compute observable differences (requires a valid RINEX nav file for both receivers)");
+DEFINE_int32(threads, 0, "Number of threads used to compute the differences of each satellite (0: one per CPU core, 1: sequential)");
 
 #endif